@@ -16,6 +16,10 @@
 #include "Core/ConfigManager.h"
 #include "VideoCommon/PerformanceMetrics.h"
 
+#ifdef _M_X86_64
+#include <emmintrin.h>
+#endif
+
 static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 {
   switch (quality)
@@ -31,6 +35,69 @@ static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
   }
 }
 
+// The Catmull-Rom weights of four consecutive frames, for a position t between the second and the
+// third of them
+static std::array<float, 4> CubicWeights(float t)
+{
+  static constexpr std::array<float, 4> A = {-0.5f, 1.5f, -1.5f, 0.5f};
+  static constexpr std::array<float, 4> B = {1.0f, -2.5f, 2.0f, -0.5f};
+  static constexpr std::array<float, 4> C = {-0.5f, 0.0f, 0.5f, 0.0f};
+  static constexpr std::array<float, 4> D = {0.0f, 1.0f, 0.0f, 0.0f};
+
+  std::array<float, 4> weights;
+  for (size_t i = 0; i < weights.size(); ++i)
+    weights[i] = ((A[i] * t + B[i]) * t + C[i]) * t + D[i];
+  return weights;
+}
+
+// Interpolates four stereo frames with the weights, scales the channels by the volumes and adds
+// them to the output frame. The channels are swapped in the output like everywhere in the mixer.
+static void MixCubicFrame(const s16* frames, bool swap, const std::array<float, 4>& weights,
+                          float lvolume, float rvolume, short* output)
+{
+#ifdef _M_X86_64
+  __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames));
+  if (swap)
+    values = _mm_or_si128(_mm_slli_epi16(values, 8), _mm_srli_epi16(values, 8));
+  const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+  const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16));
+
+  const __m128 w = _mm_loadu_ps(weights.data());
+  __m128 sum =
+      _mm_add_ps(_mm_mul_ps(lo, _mm_unpacklo_ps(w, w)), _mm_mul_ps(hi, _mm_unpackhi_ps(w, w)));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_mul_ps(_mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 1, 0, 1)),
+                   _mm_setr_ps(rvolume, lvolume, 0.0f, 0.0f));
+
+  s32 output_frame;
+  std::memcpy(&output_frame, output, sizeof(output_frame));
+  __m128i previous = _mm_cvtsi32_si128(output_frame);
+  previous = _mm_srai_epi32(_mm_unpacklo_epi16(previous, previous), 16);
+  const __m128i mixed = _mm_add_epi32(_mm_cvtps_epi32(sum), previous);
+  output_frame = _mm_cvtsi128_si32(
+      _mm_max_epi16(_mm_packs_epi32(mixed, mixed), _mm_set1_epi16(-32767)));
+  std::memcpy(output, &output_frame, sizeof(output_frame));
+#else
+  std::array<float, 2> sum;
+  for (size_t channel = 0; channel < 2; ++channel)
+  {
+    std::array<float, 4> values;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      const s16 value = frames[i * 2 + channel];
+      values[i] = swap ? static_cast<s16>(Common::swap16(value)) : value;
+    }
+    sum[channel] = (values[0] * weights[0] + values[2] * weights[2]) +
+                   (values[1] * weights[1] + values[3] * weights[3]);
+  }
+
+  const long sample_r = std::lrint(sum[1] * rvolume) + output[0];
+  const long sample_l = std::lrint(sum[0] * lvolume) + output[1];
+  output[0] = static_cast<short>(std::clamp<long>(sample_r, -32767, 32767));
+  output[1] = static_cast<short>(std::clamp<long>(sample_l, -32767, 32767));
+#endif
+}
+
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
       m_surround_decoder(BackendSampleRate,
@@ -60,7 +127,7 @@ void Mixer::DoState(PointerWrap& p)
 // Executed from sound stream thread
 unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
-                                   int timing_variance)
+                                   int buffer_depth_ms)
 {
   unsigned int currentSample = 0;
 
@@ -71,8 +138,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // so we will just ignore new written data while interpolating.
   // Without this cache, the compiler wouldn't be allowed to optimize the
   // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -80,16 +147,24 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   float aid_sample_rate =
       FIXED_SAMPLE_RATE_DIVIDEND / static_cast<float>(m_input_sample_rate_divisor);
+
+  // The buffer depth the sample rate is adjusted towards: the configured one, plus what
+  // underruns added to it
+  const float target_ms = buffer_depth_ms + m_extra_depth_ms;
+  const u32 low_watermark =
+      std::min(static_cast<u32>(target_ms * aid_sample_rate / 1000.0f), MAX_SAMPLES / 2);
+  m_target_depth_ms.store(static_cast<u32>(low_watermark * 1000.0f / aid_sample_rate),
+                          std::memory_order_relaxed);
+
+  const float played_seconds = numSamples / static_cast<float>(m_mixer->m_sampleRate);
   if (consider_framelimit && emulationspeed > 0.0f)
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
-    u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * timing_variance) /
-                        (static_cast<u64>(m_input_sample_rate_divisor) * 1000);
-    low_watermark = std::min(low_watermark, MAX_SAMPLES / 2);
-
     m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
-    float offset = (m_numLeftI - low_watermark) * CONTROL_FACTOR;
+    m_rate_correction += (m_numLeftI - low_watermark) * CONTROL_INTEGRAL * played_seconds;
+    m_rate_correction = std::clamp<float>(m_rate_correction, -MAX_FREQ_SHIFT, MAX_FREQ_SHIFT);
+    float offset = (m_numLeftI - low_watermark) * CONTROL_FACTOR + m_rate_correction;
     if (offset > MAX_FREQ_SHIFT)
       offset = MAX_FREQ_SHIFT;
     if (offset < -MAX_FREQ_SHIFT)
@@ -102,29 +177,28 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   s32 lvolume = m_LVolume.load();
   s32 rvolume = m_RVolume.load();
+  const float lvolume_scale = lvolume / 256.0f;
+  const float rvolume_scale = rvolume / 256.0f;
 
   const auto read_buffer = [this](auto index) {
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Cubic interpolation between the second and the third of the four frames at indexR
+  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 6; currentSample += 2)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
+    const u32 start = indexR & INDEX_MASK;
+    const s16* frames = &m_buffer[start];
+    std::array<s16, 8> wrapped_frames;
+    if (start + wrapped_frames.size() > m_buffer.size())
+    {
+      for (u32 i = 0; i < wrapped_frames.size(); ++i)
+        wrapped_frames[i] = m_buffer[(indexR + i) & INDEX_MASK];
+      frames = wrapped_frames.data();
+    }
+
+    MixCubicFrame(frames, !m_little_endian, CubicWeights(m_frac / 65536.0f), lvolume_scale,
+                  rvolume_scale, &samples[currentSample]);
 
     m_frac += ratio;
     indexR += 2 * (u16)(m_frac >> 16);
@@ -150,7 +224,21 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   }
 
   // Flush cached variable
-  m_indexR.store(indexR);
+  m_indexR.store(indexR, std::memory_order_release);
+
+  if (actual_sample_count < numSamples && m_pushed.exchange(false, std::memory_order_relaxed))
+  {
+    // The stream ran dry while it was being played, so a deeper buffer is needed to cover the
+    // timing of the emulated audio
+    m_underruns.fetch_add(1, std::memory_order_relaxed);
+    if (consider_framelimit)
+      m_extra_depth_ms = std::min(m_extra_depth_ms + UNDERRUN_DEPTH_STEP_MS, MAX_EXTRA_DEPTH_MS);
+  }
+  else if (consider_framelimit)
+  {
+    m_extra_depth_ms =
+        std::max(m_extra_depth_ms - DEPTH_DECAY_MS_PER_SECOND * played_seconds, 0.0f);
+  }
 
   return actual_sample_count;
 }
@@ -165,7 +253,7 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
+  const int buffer_depth = m_config_buffer_depth;
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -179,17 +267,17 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
     m_scratch_buffer.fill(0);
 
     m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
+                    buffer_depth);
     m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
+                          buffer_depth);
     m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
+                                buffer_depth);
     m_skylander_portal_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                 timing_variance);
+                                 buffer_depth);
     for (auto& mixer : m_gba_mixers)
     {
       mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
+                buffer_depth);
     }
 
     if (!m_is_stretching)
@@ -202,12 +290,12 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, buffer_depth);
+    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, buffer_depth);
+    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, buffer_depth);
+    m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, buffer_depth);
     for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+      mixer.Mix(samples, num_samples, true, emulation_speed, buffer_depth);
     m_is_stretching = false;
   }
 
@@ -248,12 +336,16 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
   // Cache access in non-volatile variable
   // indexR isn't allowed to cache in the audio throttling loop as it
   // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  if (num_samples * 2 + ((indexW - m_indexR.load(std::memory_order_acquire)) & INDEX_MASK) >=
+      MAX_SAMPLES * 2)
+  {
+    m_overruns.fetch_add(1, std::memory_order_relaxed);
     return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
@@ -269,11 +361,15 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
     memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
   }
 
-  m_indexW.fetch_add(num_samples * 2);
+  m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
+  m_pushed.store(true, std::memory_order_relaxed);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
 {
+  if (m_suppressed)
+    return;
+
   m_dma_mixer.PushSamples(samples, num_samples);
   if (m_log_dsp_audio)
   {
@@ -286,6 +382,9 @@ void Mixer::PushSamples(const short* samples, unsigned int num_samples)
 
 void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
 {
+  if (m_suppressed)
+    return;
+
   m_streaming_mixer.PushSamples(samples, num_samples);
   if (m_log_dtk_audio)
   {
@@ -346,9 +445,17 @@ void Mixer::PushSkylanderPortalSamples(const u8* samples, unsigned int num_sampl
 
 void Mixer::PushGBASamples(int device_number, const short* samples, unsigned int num_samples)
 {
+  if (m_suppressed)
+    return;
+
   m_gba_mixers[device_number].PushSamples(samples, num_samples);
 }
 
+Mixer::FifoStatistics Mixer::GetDMAStatistics() const
+{
+  return m_dma_mixer.GetStatistics();
+}
+
 void Mixer::SetDMAInputSampleRateDivisor(unsigned int rate_divisor)
 {
   m_dma_mixer.SetInputSampleRateDivisor(rate_divisor);
@@ -456,7 +563,7 @@ void Mixer::StopLogDSPAudio()
 void Mixer::RefreshConfig()
 {
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
-  m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
+  m_config_buffer_depth = Config::Get(Config::MAIN_AUDIO_BUFFER_DEPTH);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
 }
 
@@ -491,8 +598,17 @@ std::pair<s32, s32> Mixer::MixerFifo::GetVolume() const
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
   unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
-  if (samples_in_fifo <= 1)
-    return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
-  return (samples_in_fifo - 1) * static_cast<u64>(m_mixer->m_sampleRate) *
+  if (samples_in_fifo <= 3)
+    return 0;  // Mixer::MixerFifo::Mix always keeps three samples in the buffer.
+  return (samples_in_fifo - 3) * static_cast<u64>(m_mixer->m_sampleRate) *
          m_input_sample_rate_divisor / FIXED_SAMPLE_RATE_DIVIDEND;
 }
+
+Mixer::FifoStatistics Mixer::MixerFifo::GetStatistics() const
+{
+  const u32 samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
+  return {m_underruns.load(std::memory_order_relaxed), m_overruns.load(std::memory_order_relaxed),
+          static_cast<u32>(samples_in_fifo * u64{1000} * m_input_sample_rate_divisor /
+                           FIXED_SAMPLE_RATE_DIVIDEND),
+          m_target_depth_ms.load(std::memory_order_relaxed)};
+}
@@ -50,6 +50,23 @@ public:
   void StartLogDSPAudio(const std::string& filename);
   void StopLogDSPAudio();
 
+  // Drops the samples pushed by the emulated console while set. Used while NetPlay rollback
+  // simulates frames again whose audio was already played.
+  void SetSuppressed(bool suppressed) { m_suppressed = suppressed; }
+
+  struct FifoStatistics
+  {
+    // Times the stream ran dry while playing, and pushes dropped because the buffer was full
+    u64 underruns;
+    u64 overruns;
+    // How much audio is buffered, and how much the latency controller aims for
+    u32 buffered_ms;
+    u32 target_ms;
+  };
+
+  // Of the DMA stream, which carries the audio mixed by the game. Called from any thread.
+  FifoStatistics GetDMAStatistics() const;
+
   // 54000000 doesn't work here as it doesn't evenly divide with 32000, but 108000000 does
   static constexpr u64 FIXED_SAMPLE_RATE_DIVIDEND = 54000000 * 2;
 
@@ -59,6 +76,14 @@ private:
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  // In freq_shift per FIFO size offset and second. Cancels out the clock drift between the
+  // emulated console and the audio device, which would otherwise offset the buffer depth.
+  static constexpr float CONTROL_INTEGRAL = 0.02f;
+  // After an underrun the buffer depth grows by a step, and shrinks back to the configured depth
+  // while the stream plays without underruns
+  static constexpr float UNDERRUN_DEPTH_STEP_MS = 5.0f;
+  static constexpr float MAX_EXTRA_DEPTH_MS = 40.0f;
+  static constexpr float DEPTH_DECAY_MS_PER_SECOND = 1.0f;
 
   const unsigned int SURROUND_CHANNELS = 6;
 
@@ -73,12 +98,13 @@ private:
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
     unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit,
-                     float emulationspeed, int timing_variance);
+                     float emulationspeed, int buffer_depth_ms);
     void SetInputSampleRateDivisor(unsigned int rate_divisor);
     unsigned int GetInputSampleRateDivisor() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     std::pair<s32, s32> GetVolume() const;
     unsigned int AvailableSamples() const;
+    FifoStatistics GetStatistics() const;
 
   private:
     Mixer* m_mixer;
@@ -91,7 +117,15 @@ private:
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
+    float m_rate_correction = 0.0f;
     u32 m_frac = 0;
+
+    // Set when samples are pushed, so Mix can tell a stream which ran dry from an idle one
+    std::atomic<bool> m_pushed{false};
+    std::atomic<u64> m_underruns{0};
+    std::atomic<u64> m_overruns{0};
+    float m_extra_depth_ms = 0.0f;
+    std::atomic<u32> m_target_depth_ms{0};
   };
 
   void RefreshConfig();
@@ -116,9 +150,10 @@ private:
 
   bool m_log_dtk_audio = false;
   bool m_log_dsp_audio = false;
+  bool m_suppressed = false;
 
   float m_config_emulation_speed;
-  int m_config_timing_variance;
+  int m_config_buffer_depth;
   bool m_config_audio_stretch;
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstring>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <optional>
@@ -29,6 +30,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/DirtyPageBitmap.h"
 #include "Common/EnumMap.h"
 #include "Common/Flag.h"
 #include "Common/Inline.h"
@@ -46,10 +48,15 @@ public:
     Verify,
   };
 
+  // Receives the blocks passed to DoMemoryBlock instead of the buffer.
+  using MemoryBlockHandler =
+      std::function<void(u8* data, u32 size, Common::DirtyPageBitmap* dirty_pages)>;
+
 private:
   u8** m_ptr_current;
   u8* m_ptr_end;
   Mode m_mode;
+  MemoryBlockHandler m_memory_block_handler;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
@@ -57,6 +64,12 @@ public:
   {
   }
 
+  PointerWrap(u8** ptr, size_t size, Mode mode, MemoryBlockHandler memory_block_handler)
+      : m_ptr_current(ptr), m_ptr_end(*ptr + size), m_mode(mode),
+        m_memory_block_handler(std::move(memory_block_handler))
+  {
+  }
+
   void SetMeasureMode() { m_mode = Mode::Measure; }
   void SetVerifyMode() { m_mode = Mode::Verify; }
   bool IsReadMode() const { return m_mode == Mode::Read; }
@@ -201,6 +214,23 @@ public:
     DoVoid(x, count * sizeof(T));
   }
 
+  // For the emulated memories, which make up most of a savestate. They are stored like DoArray,
+  // unless a MemoryBlockHandler takes them; in measure mode they then take no space. dirty_pages,
+  // if the owner tracks them, tells the handler which pages were written since it last looked.
+  void DoMemoryBlock(u8* data, u32 size, Common::DirtyPageBitmap* dirty_pages = nullptr)
+  {
+    if (m_memory_block_handler)
+    {
+      if (IsReadMode() || IsWriteMode())
+        m_memory_block_handler(data, size, dirty_pages);
+      return;
+    }
+
+    DoArray(data, size);
+    if (IsReadMode() && dirty_pages)
+      dirty_pages->MarkAllDirty();
+  }
+
   template <typename T, typename std::enable_if_t<!std::is_trivially_copyable_v<T>, int> = 0>
   void DoArray(T* x, u32 count)
   {
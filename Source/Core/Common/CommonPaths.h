@@ -87,6 +87,7 @@
 #define RESOURCES_DIR "Resources"
 #define THEMES_DIR "Themes"
 #define TEXTUREPACKS_DIR "TexturePacks"
+#define PIPELINE_UID_CACHE_DIR "PipelineUIDCache"
 #define STYLES_DIR "Styles"
 #define GBASAVES_DIR "Saves"
 #define ANAGLYPH_DIR "Anaglyph"
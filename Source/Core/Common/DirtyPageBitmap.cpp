@@ -0,0 +1,79 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/DirtyPageBitmap.h"
+
+#include <utility>
+
+namespace Common
+{
+DirtyPageBitmap::DirtyPageBitmap() = default;
+
+DirtyPageBitmap::~DirtyPageBitmap() = default;
+
+void DirtyPageBitmap::Init(u32 size, ProtectFunction protect)
+{
+  StopTracking();
+  m_size = size;
+  m_page_count = (size + PAGE_SIZE - 1) >> PAGE_SHIFT;
+  m_word_count = (m_page_count + 63) / 64;
+  m_dirty = std::make_unique<std::atomic<u64>[]>(m_word_count);
+  m_protect = std::move(protect);
+}
+
+void DirtyPageBitmap::Shutdown()
+{
+  StopTracking();
+  m_dirty.reset();
+  m_size = 0;
+  m_page_count = 0;
+  m_word_count = 0;
+  m_protect = {};
+}
+
+void DirtyPageBitmap::StartTracking()
+{
+  if (m_page_count == 0)
+    return;
+
+  for (u32 i = 0; i < m_word_count; ++i)
+    m_dirty[i].store(0, std::memory_order_relaxed);
+  ++m_generation;
+  m_tracking.store(true, std::memory_order_relaxed);
+  Protect(0, m_page_count, true);
+}
+
+void DirtyPageBitmap::StopTracking()
+{
+  if (!IsTracking())
+    return;
+
+  m_tracking.store(false, std::memory_order_relaxed);
+  Protect(0, m_page_count, false);
+}
+
+void DirtyPageBitmap::MarkAllDirty()
+{
+  if (IsTracking())
+    MarkDirty(0, m_size);
+}
+
+bool DirtyPageBitmap::OnWriteFault(u32 offset)
+{
+  if (!IsTracking() || !m_protect || offset >= m_size)
+    return false;
+
+  // Pages are protected again when they are taken, so a page with writes let through is always
+  // dirty, even if it was marked before the write faulted.
+  const u32 page = offset >> PAGE_SHIFT;
+  MarkDirty(page << PAGE_SHIFT, 1);
+  Protect(page, 1, false);
+  return true;
+}
+
+void DirtyPageBitmap::Protect(u32 first_page, u32 page_count, bool protect)
+{
+  if (m_protect)
+    m_protect(first_page, page_count, protect);
+}
+}  // namespace Common
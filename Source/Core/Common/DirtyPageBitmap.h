@@ -0,0 +1,120 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Remembers which pages of a block of emulated memory were written since they were last taken,
+// so that a snapshot only has to copy those.
+//
+// Code that writes the block through a host pointer calls MarkDirty. Writes that can't do that
+// (JIT stores through fastmem) are caught by write protecting the clean pages through the
+// ProtectFunction, and the fault handler reports them with OnWriteFault. Marking may happen on
+// any thread; everything else belongs to the CPU thread.
+class DirtyPageBitmap
+{
+public:
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 PAGE_SIZE = 1 << PAGE_SHIFT;
+
+  // Write protects the pages, or lifts the protection. Only needed when some writes bypass
+  // MarkDirty.
+  using ProtectFunction = std::function<void(u32 first_page, u32 page_count, bool protect)>;
+
+  DirtyPageBitmap();
+  ~DirtyPageBitmap();
+
+  DirtyPageBitmap(const DirtyPageBitmap&) = delete;
+  DirtyPageBitmap& operator=(const DirtyPageBitmap&) = delete;
+
+  void Init(u32 size, ProtectFunction protect = {});
+  void Shutdown();
+
+  u32 GetSize() const { return m_size; }
+  u32 GetPageCount() const { return m_page_count; }
+
+  bool IsTracking() const { return m_tracking.load(std::memory_order_relaxed); }
+  // Changes every time tracking starts, so a reader can tell that it missed writes
+  u64 GetGeneration() const { return m_generation; }
+
+  // Starts tracking with every page clean
+  void StartTracking();
+  void StopTracking();
+
+  void MarkDirty(u32 offset, size_t size)
+  {
+    if (!IsTracking() || size == 0 || offset >= m_size)
+      return;
+
+    const u32 first = offset >> PAGE_SHIFT;
+    const size_t end = std::min<size_t>(m_size, size_t(offset) + size);
+    const u32 last = static_cast<u32>(end - 1) >> PAGE_SHIFT;
+    for (u32 page = first; page <= last; ++page)
+    {
+      std::atomic<u64>& word = m_dirty[page / 64];
+      const u64 bit = u64(1) << (page % 64);
+      // Pages written over and over (the GPU FIFO, audio buffers) are mostly dirty already
+      if (!(word.load(std::memory_order_relaxed) & bit))
+        word.fetch_or(bit, std::memory_order_relaxed);
+    }
+  }
+
+  void MarkAllDirty();
+
+  // Called by the fault handler for a write to a protected page. Marks the page and lets writes
+  // to it through until it is taken. Returns false if the block isn't being tracked.
+  bool OnWriteFault(u32 offset);
+
+  // Calls function(page) for each page written since it was last taken, clears it and protects
+  // it again.
+  template <typename Function>
+  void TakeDirtyPages(Function function)
+  {
+    u32 run_start = 0;
+    u32 run_length = 0;
+    for (u32 i = 0; i < m_word_count; ++i)
+    {
+      u64 bits = m_dirty[i].exchange(0, std::memory_order_relaxed);
+      while (bits)
+      {
+        const u32 page = i * 64 + std::countr_zero(bits);
+        bits &= bits - 1;
+        function(page);
+
+        if (run_length != 0 && run_start + run_length == page)
+        {
+          ++run_length;
+          continue;
+        }
+        if (run_length != 0)
+          Protect(run_start, run_length, true);
+        run_start = page;
+        run_length = 1;
+      }
+    }
+    if (run_length != 0)
+      Protect(run_start, run_length, true);
+  }
+
+private:
+  void Protect(u32 first_page, u32 page_count, bool protect);
+
+  std::unique_ptr<std::atomic<u64>[]> m_dirty;
+  u32 m_size = 0;
+  u32 m_page_count = 0;
+  u32 m_word_count = 0;
+  std::atomic<bool> m_tracking{false};
+  u64 m_generation = 0;
+  ProtectFunction m_protect;
+};
+}  // namespace Common
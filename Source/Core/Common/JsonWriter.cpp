@@ -0,0 +1,194 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/JsonWriter.h"
+
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+#include "Common/Assert.h"
+
+namespace Common
+{
+JsonWriter::JsonWriter(size_t reserve)
+{
+  m_buffer.reserve(reserve);
+}
+
+void JsonWriter::Reset()
+{
+  m_buffer.clear();
+  m_container_empty.clear();
+  m_after_key = false;
+}
+
+std::string JsonWriter::TakeString()
+{
+  std::string result = std::move(m_buffer);
+  Reset();
+  return result;
+}
+
+void JsonWriter::BeginObject()
+{
+  BeginContainer('{');
+}
+
+void JsonWriter::BeginObject(std::string_view key)
+{
+  Key(key);
+  BeginContainer('{');
+}
+
+void JsonWriter::EndObject()
+{
+  EndContainer('}');
+}
+
+void JsonWriter::BeginArray()
+{
+  BeginContainer('[');
+}
+
+void JsonWriter::BeginArray(std::string_view key)
+{
+  Key(key);
+  BeginContainer('[');
+}
+
+void JsonWriter::EndArray()
+{
+  EndContainer(']');
+}
+
+void JsonWriter::Key(std::string_view key)
+{
+  DEBUG_ASSERT(!m_after_key);
+  BeginValue();
+  WriteEscaped(key);
+  m_buffer += ": ";
+  m_after_key = true;
+}
+
+void JsonWriter::Value(std::string_view value)
+{
+  BeginValue();
+  WriteEscaped(value);
+}
+
+void JsonWriter::Value(bool value)
+{
+  BeginValue();
+  m_buffer += value ? "true" : "false";
+}
+
+void JsonWriter::Value(float value)
+{
+  if (!std::isfinite(value))
+    return Null();
+
+  BeginValue();
+  fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+}
+
+void JsonWriter::Value(double value)
+{
+  if (!std::isfinite(value))
+    return Null();
+
+  BeginValue();
+  fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+}
+
+void JsonWriter::Null()
+{
+  BeginValue();
+  m_buffer += "null";
+}
+
+void JsonWriter::RawValue(std::string_view json)
+{
+  BeginValue();
+  m_buffer += json;
+}
+
+void JsonWriter::BeginValue()
+{
+  // A value directly following its key stays on the key's line.
+  if (m_after_key)
+  {
+    m_after_key = false;
+    return;
+  }
+
+  if (m_container_empty.empty())
+    return;
+
+  if (!m_container_empty.back())
+    m_buffer += ',';
+  m_container_empty.back() = false;
+  WriteNewLineAndIndent();
+}
+
+void JsonWriter::BeginContainer(char open)
+{
+  BeginValue();
+  m_buffer += open;
+  m_container_empty.push_back(true);
+}
+
+void JsonWriter::EndContainer(char close)
+{
+  DEBUG_ASSERT(!m_container_empty.empty() && !m_after_key);
+  const bool empty = m_container_empty.back();
+  m_container_empty.pop_back();
+
+  if (!empty)
+    WriteNewLineAndIndent();
+  m_buffer += close;
+
+  // Terminate the document the same way the hand-written files always have been.
+  if (m_container_empty.empty())
+    m_buffer += '\n';
+}
+
+void JsonWriter::WriteNewLineAndIndent()
+{
+  m_buffer += '\n';
+  m_buffer.append(m_container_empty.size() * 2, ' ');
+}
+
+void JsonWriter::WriteEscaped(std::string_view str)
+{
+  m_buffer += '"';
+  for (const char c : str)
+  {
+    switch (c)
+    {
+    case '"':
+      m_buffer += "\\\"";
+      break;
+    case '\\':
+      m_buffer += "\\\\";
+      break;
+    case '\n':
+      m_buffer += "\\n";
+      break;
+    case '\r':
+      m_buffer += "\\r";
+      break;
+    case '\t':
+      m_buffer += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        fmt::format_to(std::back_inserter(m_buffer), "\\u{:04x}", static_cast<unsigned char>(c));
+      else
+        m_buffer += c;
+      break;
+    }
+  }
+  m_buffer += '"';
+}
+}  // namespace Common
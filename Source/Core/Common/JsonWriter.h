@@ -0,0 +1,89 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace Common
+{
+// Streaming writer for pretty-printed JSON documents.
+//
+// Output is appended to a single buffer that keeps its capacity across Reset(), so documents that
+// are rebuilt repeatedly do not allocate once the buffer has grown. Separators and indentation are
+// handled by the writer, callers only describe the structure.
+class JsonWriter
+{
+public:
+  explicit JsonWriter(size_t reserve = 0);
+
+  // Clears the document while keeping the buffer's capacity.
+  void Reset();
+  void Reserve(size_t size) { m_buffer.reserve(size); }
+
+  const std::string& GetString() const { return m_buffer; }
+  std::string TakeString();
+
+  void BeginObject();
+  void BeginObject(std::string_view key);
+  void EndObject();
+
+  void BeginArray();
+  void BeginArray(std::string_view key);
+  void EndArray();
+
+  void Key(std::string_view key);
+
+  void Value(std::string_view value);
+  void Value(const char* value) { Value(std::string_view(value)); }
+  void Value(const std::string& value) { Value(std::string_view(value)); }
+  void Value(bool value);
+  // Non-finite values are written as null, since JSON has no representation for them.
+  void Value(float value);
+  void Value(double value);
+  void Null();
+
+  template <std::integral T>
+  void Value(T value)
+  {
+    BeginValue();
+    // Promote so that u8/s8 are written as numbers rather than characters.
+    fmt::format_to(std::back_inserter(m_buffer), "{}", +value);
+  }
+
+  // Writes an already encoded JSON token as a value.
+  void RawValue(std::string_view json);
+
+  template <typename T>
+  void Field(std::string_view key, const T& value)
+  {
+    Key(key);
+    Value(value);
+  }
+
+  void RawField(std::string_view key, std::string_view json)
+  {
+    Key(key);
+    RawValue(json);
+  }
+
+private:
+  void BeginValue();
+  void BeginContainer(char open);
+  void EndContainer(char close);
+  void WriteNewLineAndIndent();
+  void WriteEscaped(std::string_view str);
+
+  std::string m_buffer;
+  // One entry per open container, true while it has no elements yet.
+  std::vector<bool> m_container_empty;
+  bool m_after_key = false;
+};
+}  // namespace Common
@@ -0,0 +1,103 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& path)
+{
+  Close();
+
+  const HANDLE file = CreateFileW(UTF8ToWString(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The mapping keeps the file open on its own
+  m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!m_mapping)
+    return false;
+
+  m_data = static_cast<const u8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!m_data)
+  {
+    Close();
+    return false;
+  }
+  m_size = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping)
+    CloseHandle(m_mapping);
+  m_data = nullptr;
+  m_mapping = nullptr;
+  m_size = 0;
+}
+#else
+bool MappedFile::Open(const std::string& path)
+{
+  Close();
+
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0 || file_info.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // The mapping keeps the file open on its own
+  void* const data =
+      mmap(nullptr, static_cast<size_t>(file_info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  m_data = static_cast<const u8*>(data);
+  m_size = static_cast<size_t>(file_info.st_size);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (m_data)
+    munmap(const_cast<u8*>(m_data), m_size);
+  m_data = nullptr;
+  m_size = 0;
+}
+#endif
+}  // namespace Common
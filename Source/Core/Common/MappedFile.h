@@ -0,0 +1,38 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Maps a whole file into memory for reading. The data stays valid until the file is closed.
+class MappedFile final
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  bool Open(const std::string& path);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_mapping = nullptr;
+#endif
+};
+}  // namespace Common
@@ -0,0 +1,129 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// An allocator for many objects of one type which are created and destroyed often. The objects
+// are carved out of larger slabs, and freed objects are reused before the slabs grow. Not thread
+// safe.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+class SlabPool
+{
+public:
+  explicit SlabPool(size_t blocks_per_slab = 256) : m_blocks_per_slab(blocks_per_slab) {}
+  SlabPool(const SlabPool&) = delete;
+  SlabPool& operator=(const SlabPool&) = delete;
+
+  // All blocks of a pool have the size of the first allocation. Other sizes return nullptr.
+  void* Allocate(size_t size)
+  {
+    if (m_block_size == 0)
+      m_block_size = std::max(RoundUp(size), sizeof(FreeBlock));
+    else if (RoundUp(size) > m_block_size)
+      return nullptr;
+
+    if (!m_free_list)
+      AddSlab();
+
+    FreeBlock* block = m_free_list;
+    m_free_list = block->next;
+    return block;
+  }
+
+  void Free(void* ptr)
+  {
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = m_free_list;
+    m_free_list = block;
+  }
+
+  // Whether Allocate gives blocks of this size
+  bool Fits(size_t size) const { return m_block_size != 0 && RoundUp(size) <= m_block_size; }
+
+  size_t GetSlabCount() const { return m_slabs.size(); }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  static constexpr size_t ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  static constexpr size_t RoundUp(size_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+  void AddSlab()
+  {
+    m_slabs.push_back(std::make_unique<u8[]>(m_block_size * m_blocks_per_slab));
+    u8* slab = m_slabs.back().get();
+
+    // Hand out the blocks in address order
+    for (size_t i = m_blocks_per_slab; i-- > 0;)
+      Free(slab + i * m_block_size);
+  }
+
+  size_t m_blocks_per_slab;
+  size_t m_block_size = 0;
+  FreeBlock* m_free_list = nullptr;
+  std::vector<std::unique_ptr<u8[]>> m_slabs;
+};
+
+// Allocates single objects from a shared SlabPool, and everything else from the heap. Copies
+// keep the pool alive, so objects made with std::allocate_shared may outlive the owner of the
+// allocator.
+template <typename T>
+class SlabAllocator
+{
+public:
+  using value_type = T;
+
+  SlabAllocator() : m_pool(std::make_shared<SlabPool>()) {}
+  template <typename U>
+  SlabAllocator(const SlabAllocator<U>& other) : m_pool(other.m_pool)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    if (n == 1)
+    {
+      if (void* ptr = m_pool->Allocate(sizeof(T)))
+        return static_cast<T*>(ptr);
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n)
+  {
+    if (n == 1 && m_pool->Fits(sizeof(T)))
+      m_pool->Free(ptr);
+    else
+      ::operator delete(ptr);
+  }
+
+  const std::shared_ptr<SlabPool>& GetPool() const { return m_pool; }
+
+  template <typename U>
+  bool operator==(const SlabAllocator<U>& other) const
+  {
+    return m_pool == other.m_pool;
+  }
+
+private:
+  template <typename U>
+  friend class SlabAllocator;
+
+  std::shared_ptr<SlabPool> m_pool;
+};
+}  // namespace Common
@@ -63,6 +63,7 @@ extern const Info<std::string> GFX_TEXTURE_PACK;
 extern const Info<bool> GFX_CACHE_HIRES_TEXTURES;
 extern const Info<bool> GFX_DUMP_EFB_TARGET;
 extern const Info<bool> GFX_DUMP_XFB_TARGET;
+extern const Info<bool> GFX_DUMP_TEXTURE_CACHE_TRACE;
 extern const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES;
 extern const Info<bool> GFX_USE_FFV1;
 extern const Info<std::string> GFX_DUMP_FORMAT;
@@ -103,6 +104,7 @@ extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
 extern const Info<bool> GFX_SW_DUMP_OBJECTS;
 extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
 
 extern const Info<bool> GFX_PREFER_GLES;
 
@@ -55,6 +55,9 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_RECORD_BLOCK_PROFILE;
+extern const Info<bool> MAIN_JIT_USE_BLOCK_PROFILE;
+extern const Info<bool> MAIN_JIT_PRECOMPILE_CACHE;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
 extern const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP;
@@ -72,6 +75,8 @@ extern const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS;
 extern const Info<bool> MAIN_DPL2_DECODER;
 extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
+// How much emulated audio the mixer keeps buffered, in milliseconds
+extern const Info<int> MAIN_AUDIO_BUFFER_DEPTH;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
@@ -153,6 +158,12 @@ extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
 extern const Info<std::string> MAIN_WII_NUS_SHOP_URL;
 extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
+// Whether StatTracker also writes the JSON stat files next to the binary stat log.
+extern const Info<bool> MAIN_STAT_JSON_FILES;
+// Whether StatTracker writes decoded.hud.json for stream overlays.
+extern const Info<bool> MAIN_HUD_FILE;
+// Localhost UDP port StatTracker sends HUD deltas to. 0 disables the deltas.
+extern const Info<int> MAIN_HUD_DELTA_PORT;
 
 // Main.DSP
 
@@ -61,6 +61,17 @@ const Info<bool> NETPLAY_HIDE_REMOTE_GBAS{{System::Main, "NetPlay", "HideRemoteG
 //const Info<bool> NETPLAY_NIGHT_STADIUM{{System::Main, "NetPlay", "Night Stadium"}, false};
 const Info<bool> NETPLAY_DISABLE_MUSIC{{System::Main, "NetPlay", "Disable Music"}, false};
 const Info<bool> NETPLAY_HIGHLIGHT_BALL_SHADOW{{System::Main, "NetPlay", "Highlight Ball Shadow"}, false};
+const Info<bool> NETPLAY_DESYNC_DETECTION{{System::Main, "NetPlay", "DesyncDetection"}, true};
+// "name:address:size" entries separated by ';'. Empty uses the defaults for the game.
+const Info<std::string> NETPLAY_DESYNC_REGIONS{{System::Main, "NetPlay", "DesyncRegions"}, ""};
+const Info<bool> NETPLAY_DESYNC_DUMPS{{System::Main, "NetPlay", "DesyncDumps"}, true};
+// How many frames the "rollback" network mode may run ahead of the remote inputs
+const Info<u32> NETPLAY_ROLLBACK_MAX_FRAMES{{System::Main, "NetPlay", "RollbackMaxFrames"}, 8};
+// Seconds between the savestates the host sends to spectator relays for late joiners. 0 disables.
+const Info<u32> NETPLAY_RELAY_KEYFRAME_INTERVAL{{System::Main, "NetPlay", "RelayKeyframeInterval"},
+                                                60};
+// Spectator relays have to present this to the host. Relays are refused while it is empty.
+const Info<std::string> NETPLAY_RELAY_TOKEN{{System::Main, "NetPlay", "RelayToken"}, ""};
 //const Info<bool> NETPLAY_NEVER_CULL{{System::Main, "NetPlay", "Never Cull"}, false};
 
 int ONLINE_COUNT = 0;
@@ -54,6 +54,12 @@ extern const Info<bool> NETPLAY_HIDE_REMOTE_GBAS;
 //extern const Info<bool> NETPLAY_NIGHT_STADIUM;
 extern const Info<bool> NETPLAY_DISABLE_MUSIC;
 extern const Info<bool> NETPLAY_HIGHLIGHT_BALL_SHADOW;
+extern const Info<bool> NETPLAY_DESYNC_DETECTION;
+extern const Info<std::string> NETPLAY_DESYNC_REGIONS;
+extern const Info<bool> NETPLAY_DESYNC_DUMPS;
+extern const Info<u32> NETPLAY_ROLLBACK_MAX_FRAMES;
+extern const Info<u32> NETPLAY_RELAY_KEYFRAME_INTERVAL;
+extern const Info<std::string> NETPLAY_RELAY_TOKEN;
 //extern const Info<bool> NETPLAY_NEVER_CULL;
 
 std::vector<std::string> LobbyNameVector(const std::string& name);
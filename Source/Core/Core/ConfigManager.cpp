@@ -49,6 +49,7 @@
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -215,6 +216,9 @@ void SConfig::OnNewTitleLoad(const Core::CPUThreadGuard& guard)
   }
   CBoot::LoadMapFromFilename(guard);
   auto& system = Core::System::GetInstance();
+  const SConfig& config = GetInstance();
+  system.GetJitInterface().LoadBlockProfile(config.GetGameID(), config.GetRevision());
+  system.GetJitInterface().LoadPrecompileCache(config.GetGameID(), config.GetRevision());
   HLE::Reload(system);
   PatchEngine::Reload();
   HiresTexture::Update();
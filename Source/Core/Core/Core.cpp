@@ -51,6 +51,7 @@
 #include "Core/DSPEmulator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/FrameSnapshot.h"
 #include "Core/FreeLookManager.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
@@ -218,47 +219,72 @@ void FrameUpdateOnCPUThread()
   }
 }
 
+// Ranges read every frame by the Rio functions below and by the StatTracker. Reads outside these
+// ranges still work, they are just served from MEM1 instead of the snapshot.
+static Core::FrameSnapshot& GetRioFrameSnapshot()
+{
+  static Core::FrameSnapshot snapshot = [] {
+    Core::FrameSnapshot s;
+    StatTracker::watchMemory(s);
+
+    // Mario Superstar Baseball
+    s.Watch(aSceneId, 1);
+    s.Watch(aWhoPaused, 1);
+    s.Watch(aIsInGame, 1);
+    s.Watch(aIsField, 1);
+    s.Watch(aMinigameID, 1);
+
+    // Mario Golf: Toadstool Tour
+    s.Watch(aIsGolfMatch, 1);
+    s.Watch(aDistanceRemainingToHole, 4);
+    s.Watch(aPlayer1Port, aCurrentGolfer + 1 - aPlayer1Port);
+    s.Watch(aShotAccuracy, aActiveShotHorizontalAdjustment + 4 - aShotAccuracy);
+    return s;
+  }();
+  return snapshot;
+}
+
 // this function is called from PatchEngine.cpp (ApplyFramePatches()) safely
 // we can do memory reads/writes without worrying
 // anything that needs to read or write to memory should be getting run from here
 void RunRioFunctions(const Core::CPUThreadGuard& guard)
 {
   auto& system = Core::System::GetInstance();
-  u64 frame = system.GetMovie().GetCurrentFrame();
+  u64 frame_num = system.GetMovie().GetCurrentFrame();
+
+  // Read all the memory the Rio functions need in one go, so they see a consistent frame
+  Core::FrameSnapshot& frame = GetRioFrameSnapshot();
+  frame.Capture(guard);
 
   if (mGameBeingPlayed == GameName::MarioBaseball)
   {
-    s_stat_tracker->Run(guard);
+    // Frames simulated again after a NetPlay rollback were already tracked
+    if (!NetPlay::NetPlayClient::IsResimulating())
+      s_stat_tracker->Run(frame);
 
-    if (PowerPC::MMU::HostRead_U32(guard, aGameId) == 0)
+    if (frame.Read_U32(aGameId) == 0)
     {
       runNetplayGameFunctions = true;
     }
 
     if (NetPlay::IsNetPlayRunning())
     {
-      // send checksum for desync detection
-      if (frame % 60)
-      {
-        u8 checksumId = (frame / 60) & 0xF;
-        u32 checksum = PowerPC::MMU::HostRead_U32(guard, 0x802EBFB8);
-        NetPlay::NetPlayClient::SendChecksum(checksumId, frame, checksum);
-      }
+      NetPlay::NetPlayClient::RunDesyncDetector(guard, frame_num);
       if (runNetplayGameFunctions)
       {
         SetNetplayerUserInfo();
-        NetPlay::NetPlayClient::SendGameID(PowerPC::MMU::HostRead_U32(guard, aGameId));
+        NetPlay::NetPlayClient::SendGameID(frame.Read_U32(aGameId));
         runNetplayGameFunctions = false;
       }
     }
-    SetAvgPing(guard);
-    if (frame % 60 == 0) // if it's the 1st frame of second
-      RunDraftTimer(guard);
+    SetAvgPing(frame);
+    if (frame_num % 60 == 0) // if it's the 1st frame of second
+      RunDraftTimer(frame);
   }
 
-  DisplayPlayerNames(guard);
-  AutoGolfMode(guard);
-  TrainingMode(guard);
+  DisplayPlayerNames(frame);
+  AutoGolfMode(frame);
+  TrainingMode(frame);
 }
 
 void OnFrameEnd()
@@ -274,42 +300,42 @@ void OnFrameEnd()
 #endif
 }
 
-void AutoGolfMode(const Core::CPUThreadGuard& guard)
+void AutoGolfMode(const Core::FrameSnapshot& frame)
 {
   switch (mGameBeingPlayed) {
   case GameName::MarioBaseball:
-    MSSBCalculateNextGolfer(guard, nextGolferID);
+    MSSBCalculateNextGolfer(frame, nextGolferID);
     break;
   case GameName::ToadstoolTour:
-    MGTTCalculateNextGolfer(guard, nextGolferID);
+    MGTTCalculateNextGolfer(frame, nextGolferID);
     break;
   }
 }
 
-void MSSBCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer)
+void MSSBCalculateNextGolfer(const Core::FrameSnapshot& frame, int& nextGolfer)
 {
-  u8 BatterPort = PowerPC::MMU::HostRead_U8(guard, aBatterPort);
-  u8 FielderPort = PowerPC::MMU::HostRead_U8(guard, aFielderPort);
-  bool isField = PowerPC::MMU::HostRead_U8(guard, aIsField) == 1;
+  u8 BatterPort = frame.Read_U8(aBatterPort);
+  u8 FielderPort = frame.Read_U8(aFielderPort);
+  bool isField = frame.Read_U8(aIsField) == 1;
 
   // means game hasn't started yet
   if (BatterPort == 0)
     return;
 
   // makes the player who paused the golfer
-  if (PowerPC::MMU::HostRead_U8(guard, aWhoPaused) == 2)
+  if (frame.Read_U8(aWhoPaused) == 2)
     isField = true;
 
   // add minigame functionality
-  int minigameId = PowerPC::MMU::HostRead_U8(guard, aMinigameID);
+  int minigameId = frame.Read_U8(aMinigameID);
   if (minigameId == 3 || minigameId == 1)
   {
-    BatterPort = PowerPC::MMU::HostRead_U8(guard, aBarrelBatterPort) + 1;
+    BatterPort = frame.Read_U8(aBarrelBatterPort) + 1;
     isField = false;
   }
   else if (minigameId == 2)
   {
-    FielderPort = PowerPC::MMU::HostRead_U8(guard, aWallBallPort) + 1;
+    FielderPort = frame.Read_U8(aWallBallPort) + 1;
     isField = true;
   }
 
@@ -317,21 +343,21 @@ void MSSBCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer)
   nextGolfer = isField ? FielderPort - 1 : BatterPort - 1;  // subtract 1 since m_pad_map uses 0->3 instead of 1->4
 }
 
-void MGTTCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer)
+void MGTTCalculateNextGolfer(const Core::FrameSnapshot& frame, int& nextGolfer)
 {
-  u8 golferIndex = PowerPC::MMU::HostRead_U8(guard, aCurrentGolfer);
+  u8 golferIndex = frame.Read_U8(aCurrentGolfer);
   switch(golferIndex) {
     case 0:
-      nextGolfer = PowerPC::MMU::HostRead_U8(guard, aPlayer1Port);
+      nextGolfer = frame.Read_U8(aPlayer1Port);
       break;
     case 1: 
-      nextGolfer = PowerPC::MMU::HostRead_U8(guard, aPlayer2Port);
+      nextGolfer = frame.Read_U8(aPlayer2Port);
       break;
     case 2:
-      nextGolfer = PowerPC::MMU::HostRead_U8(guard, aPlayer3Port);
+      nextGolfer = frame.Read_U8(aPlayer3Port);
       break;
     case 3:
-      nextGolfer = PowerPC::MMU::HostRead_U8(guard, aPlayer4Port);
+      nextGolfer = frame.Read_U8(aPlayer4Port);
       break;
     default:
       break;
@@ -348,7 +374,7 @@ bool IsGolfMode()
 }
 
 // TODO: add stats for the following: base runner coordinates; ball coords frame before being caught, character coords after diving/jumping/wall jumping
-void TrainingMode(const Core::CPUThreadGuard& guard)
+void TrainingMode(const Core::FrameSnapshot& frame)
 {
   // if training mode config is on and not ranked netplay
   // using this feature on ranked can be considered an unfair advantage
@@ -358,37 +384,37 @@ void TrainingMode(const Core::CPUThreadGuard& guard)
   if (mGameBeingPlayed == GameName::MarioBaseball)
   {
     // bool isPitchThrown = PowerPC::MMU::HostRead_U8(0x80895D6C) == 1 ? true : false;
-    bool isField = PowerPC::MMU::HostRead_U8(guard, aIsField) == 1 ? true : false;
-    bool isInGame = PowerPC::MMU::HostRead_U8(guard, aIsInGame) == 1 ? true : false;
-    bool ContactMade = PowerPC::MMU::HostRead_U8(guard, aContactMade) == 1 ? true : false;
+    bool isField = frame.Read_U8(aIsField) == 1 ? true : false;
+    bool isInGame = frame.Read_U8(aIsInGame) == 1 ? true : false;
+    bool ContactMade = frame.Read_U8(aContactMade) == 1 ? true : false;
 
     // Batting Training Mode stats
     if (ContactMade && !previousContactMade)
     {
-      u8 BatterPort = PowerPC::MMU::HostRead_U8(guard, aBatterPort);
+      u8 BatterPort = frame.Read_U8(aBatterPort);
       if (BatterPort > 0)
         BatterPort--;
       u32 stickDirectionAddr = 0x8089392D + (0x10 * BatterPort);
-      float contactQuality = PowerPC::MMU::HostRead_F32(guard, aAB_ContactQuality);
-      u16 contactFrame = PowerPC::MMU::HostRead_U16(guard, aContactFrame);
-      u8 typeOfContact_Value = PowerPC::MMU::HostRead_U8(guard, aTypeOfContact);
+      float contactQuality = frame.Read_F32(aAB_ContactQuality);
+      u16 contactFrame = frame.Read_U16(aContactFrame);
+      u8 typeOfContact_Value = frame.Read_U8(aTypeOfContact);
       std::string typeOfContact;
-      u8 inputDirection_Value = PowerPC::MMU::HostRead_U8(guard, stickDirectionAddr) & 0xF;
+      u8 inputDirection_Value = frame.Read_U8(stickDirectionAddr) & 0xF;
       std::string inputDirection;
       int chargeUp =
-          static_cast<int>(roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aChargeUp)) * 100));
+          static_cast<int>(roundf(u32ToFloat(frame.Read_U32(aChargeUp)) * 100));
       int chargeDown = static_cast<int>(
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aChargeDown)) * 100));
+          roundf(u32ToFloat(frame.Read_U32(aChargeDown)) * 100));
 
-      float angle = roundf((float)PowerPC::MMU::HostRead_U16(guard, aBallAngle) * 36000 / 4096) /
+      float angle = roundf((float)frame.Read_U16(aBallAngle) * 36000 / 4096) /
                     100;  // 0x400 == 90°, 0x800 == 180°, 0x1000 == 360°
       float xVelocity =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallVelocity_X)) * 6000) /
+          roundf(u32ToFloat(frame.Read_U32(aBallVelocity_X)) * 6000) /
           100;  // * 60 cause default units are meters per frame
       float yVelocity =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallVelocity_Y)) * 6000) / 100;
+          roundf(u32ToFloat(frame.Read_U32(aBallVelocity_Y)) * 6000) / 100;
       float zVelocity =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallVelocity_Z)) * 6000) / 100;
+          roundf(u32ToFloat(frame.Read_U32(aBallVelocity_Z)) * 6000) / 100;
       float netVelocity = vectorMagnitude(xVelocity, yVelocity, zVelocity);
 
       // convert type of contact to string
@@ -456,45 +482,44 @@ void TrainingMode(const Core::CPUThreadGuard& guard)
     if (isInGame)
     {
       float BallPos_X =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallPosition_X)) * 100) / 100;
+          roundf(u32ToFloat(frame.Read_U32(aBallPosition_X)) * 100) / 100;
       float BallPos_Y =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallPosition_Y)) * 100) / 100;
+          roundf(u32ToFloat(frame.Read_U32(aBallPosition_Y)) * 100) / 100;
       float BallPos_Z =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallPosition_Z)) * 100) / 100;
+          roundf(u32ToFloat(frame.Read_U32(aBallPosition_Z)) * 100) / 100;
       float BallVel_X =
           isField ?
-              roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallVelocity_X)) * 6000) / 100 :
-              roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aPitchedBallVelocity_X)) * 6000) /
+              roundf(u32ToFloat(frame.Read_U32(aBallVelocity_X)) * 6000) / 100 :
+              roundf(u32ToFloat(frame.Read_U32(aPitchedBallVelocity_X)) * 6000) /
                   100;
       float BallVel_Y =
-          isField ? RoundZ(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallVelocity_Y)) * 6000) /
+          isField ? RoundZ(u32ToFloat(frame.Read_U32(aBallVelocity_Y)) * 6000) /
                         100 :  // floor small decimal to prevent weirdness
-              RoundZ(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aPitchedBallVelocity_Y)) * 6000) /
+              RoundZ(u32ToFloat(frame.Read_U32(aPitchedBallVelocity_Y)) * 6000) /
                   100;
       float BallVel_Z =
           isField ?
-              roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aBallVelocity_Z)) * 6000) / 100 :
-              roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, aPitchedBallVelocity_Z)) * 6000) /
+              roundf(u32ToFloat(frame.Read_U32(aBallVelocity_Z)) * 6000) / 100 :
+              roundf(u32ToFloat(frame.Read_U32(aPitchedBallVelocity_Z)) * 6000) /
                   100;
       float BallVel_Net = roundf(vectorMagnitude(BallVel_X, BallVel_Y, BallVel_Z) * 100) / 100;
 
-      int baseOffset = 0x268 * PowerPC::MMU::HostRead_U8(
-                                   guard, 0x80892801);  // used to get offsed for baseFielderAddr
+      int baseOffset = 0x268 * frame.Read_U8(0x80892801);  // used to get offsed for baseFielderAddr
       u32 baseFielderAddr = 0x8088F368 + baseOffset;    // 0x0 == x; 0x8 == y; 0xc == z
 
       float FielderPos_X =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, baseFielderAddr)) * 100) / 100;
+          roundf(u32ToFloat(frame.Read_U32(baseFielderAddr)) * 100) / 100;
       float FielderPos_Y =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, baseFielderAddr + 0xc)) * 100) / 100;
+          roundf(u32ToFloat(frame.Read_U32(baseFielderAddr + 0xc)) * 100) / 100;
       float FielderPos_Z =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, baseFielderAddr + 0x8)) * 100) / 100;
+          roundf(u32ToFloat(frame.Read_U32(baseFielderAddr + 0x8)) * 100) / 100;
       float FielderVel_X =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, baseFielderAddr + 0x30)) * 6000) /
+          roundf(u32ToFloat(frame.Read_U32(baseFielderAddr + 0x30)) * 6000) /
           100;
       // float FielderVel_Y = roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(baseFielderAddr + 0x15C))
       // * 6000) / 100; // this addr is wrong
       float FielderVel_Z =
-          roundf(u32ToFloat(PowerPC::MMU::HostRead_U32(guard, baseFielderAddr + 0x34)) * 6000) /
+          roundf(u32ToFloat(frame.Read_U32(baseFielderAddr + 0x34)) * 6000) /
           100;
       float FielderVel_Net =
           roundf(vectorMagnitude(FielderVel_X, 0 /*FielderVel_Y*/, FielderVel_Z) * 100) / 100;
@@ -537,20 +562,20 @@ void TrainingMode(const Core::CPUThreadGuard& guard)
   }
   else if (mGameBeingPlayed == GameName::ToadstoolTour)
   {
-    float DistanceRemainingToHole = PowerPC::MMU::HostRead_F32(guard, aDistanceRemainingToHole);
-    int ShotAccuracy = PowerPC::MMU::HostRead_U32(guard, aShotAccuracy);
-    u32 PowerMeterDistance = PowerPC::MMU::HostRead_U32(guard, aPowerMeterDistance);
-    float CurrentShotAimAngle = PowerPC::MMU::HostRead_F32(guard, aCurrentShotAimAngle);
-    float SimLineEndpointX = PowerPC::MMU::HostRead_F32(guard, aSimLineEndpointX);
-    float SimLineEndpointZ = PowerPC::MMU::HostRead_F32(guard, aSimLineEndpointZ);
-    float SimLineEndpointY = PowerPC::MMU::HostRead_F32(guard, aSimLineEndpointY);
-    int PreShotVerticalAdjustment = PowerPC::MMU::HostRead_U32(guard, aPreShotVerticalAdjustment);
+    float DistanceRemainingToHole = frame.Read_F32(aDistanceRemainingToHole);
+    int ShotAccuracy = frame.Read_U32(aShotAccuracy);
+    u32 PowerMeterDistance = frame.Read_U32(aPowerMeterDistance);
+    float CurrentShotAimAngle = frame.Read_F32(aCurrentShotAimAngle);
+    float SimLineEndpointX = frame.Read_F32(aSimLineEndpointX);
+    float SimLineEndpointZ = frame.Read_F32(aSimLineEndpointZ);
+    float SimLineEndpointY = frame.Read_F32(aSimLineEndpointY);
+    int PreShotVerticalAdjustment = frame.Read_U32(aPreShotVerticalAdjustment);
     int PreShotHorizontalAdjustment =
-        PowerPC::MMU::HostRead_U32(guard, aPreShotHorizontalAdjustment);
+        frame.Read_U32(aPreShotHorizontalAdjustment);
     int ActiveShotVerticalAdjustment =
-        PowerPC::MMU::HostRead_U32(guard, aActiveShotVerticalAdjustment);
+        frame.Read_U32(aActiveShotVerticalAdjustment);
     int ActiveShotHorizontalAdjustment =
-        PowerPC::MMU::HostRead_U32(guard, aActiveShotHorizontalAdjustment);
+        frame.Read_U32(aActiveShotHorizontalAdjustment);
 
     OSD::AddTypedMessage(OSD::MessageType::TrainingModeGolfing,
                          fmt::format("Golf Training Mode:                    \n"
@@ -572,7 +597,7 @@ void TrainingMode(const Core::CPUThreadGuard& guard)
   }
 }
 
-void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
+void DisplayPlayerNames(const Core::FrameSnapshot& frame)
 {
   if (!g_ActiveConfig.bShowPlayerNames)
     return;
@@ -589,8 +614,8 @@ void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
   {
   case GameName::MarioBaseball:
   {
-    u8 BatterPort = PowerPC::MMU::HostRead_U8(guard, aBatterPort);
-    u8 FielderPort = PowerPC::MMU::HostRead_U8(guard, aFielderPort);
+    u8 BatterPort = frame.Read_U8(aBatterPort);
+    u8 FielderPort = frame.Read_U8(aFielderPort);
     if (BatterPort == 0 || FielderPort == 0)  // game hasn't started yet; do not continue func
       break;
 
@@ -635,23 +660,23 @@ void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
   }
   case GameName::ToadstoolTour:
   {
-    if (PowerPC::MMU::HostRead_U8(guard, aIsGolfMatch) == 0)
+    if (frame.Read_U8(aIsGolfMatch) == 0)
       break;
 
-    u8 GolferPort = PowerPC::MMU::HostRead_U8(guard, aCurrentGolfer);
+    u8 GolferPort = frame.Read_U8(aCurrentGolfer);
     switch (GolferPort)
     {
     case 0:
-      GolferPort = PowerPC::MMU::HostRead_U8(guard, aPlayer1Port);
+      GolferPort = frame.Read_U8(aPlayer1Port);
       break;
     case 1:
-      GolferPort = PowerPC::MMU::HostRead_U8(guard, aPlayer2Port);
+      GolferPort = frame.Read_U8(aPlayer2Port);
       break;
     case 2:
-      GolferPort = PowerPC::MMU::HostRead_U8(guard, aPlayer3Port);
+      GolferPort = frame.Read_U8(aPlayer3Port);
       break;
     case 3:
-      GolferPort = PowerPC::MMU::HostRead_U8(guard, aPlayer4Port);
+      GolferPort = frame.Read_U8(aPlayer4Port);
       break;
     default:
       break;
@@ -678,9 +703,9 @@ void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
   }
 }
 
-void RunDraftTimer(const Core::CPUThreadGuard& guard)
+void RunDraftTimer(const Core::FrameSnapshot& frame)
 {
-  u8 scene = PowerPC::MMU::HostRead_U8(guard, aSceneId);
+  u8 scene = frame.Read_U8(aSceneId);
 
   if (scene < 0x9)
     draftTimer = 0;
@@ -736,13 +761,13 @@ float RoundZ(float num)
   return roundf(num);
 }
 
-void SetAvgPing(const Core::CPUThreadGuard& guard)
+void SetAvgPing(const Core::FrameSnapshot& frame)
 {
   if (!NetPlay::IsNetPlayRunning())
     return;
 
   // checks if GameID is set and that the end game flag hasn't been hit yet
-  bool inGame = PowerPC::MMU::HostRead_U32(guard, aGameId) != 0 /*&& PowerPC::MMU::HostRead_U8(aEndOfGameFlag) == 0*/ ?
+  bool inGame = frame.Read_U32(aGameId) != 0 /*&& PowerPC::MMU::HostRead_U8(aEndOfGameFlag) == 0*/ ?
                     true :
                     false;
   if (!inGame) {
@@ -941,8 +966,10 @@ void Stop()  // - Hammertime!
   if (mGameBeingPlayed == GameName::MarioBaseball)
   {
     Core::CPUThreadGuard guard(system);
+    Core::FrameSnapshot& frame = GetRioFrameSnapshot();
+    frame.Capture(guard);
 
-    s_stat_tracker->dumpGame(guard);
+    s_stat_tracker->dumpGame(frame);
     std::cout << "Emulation stopped. Dumping game." << std::endl;
     s_stat_tracker->init();
   }
@@ -31,6 +31,7 @@ namespace Tag {
 
 namespace Core
 {
+class FrameSnapshot;
 class System;
 
 bool GetIsThrottlerTempDisabled();
@@ -226,15 +227,15 @@ float u32ToFloat(u32 value);
 float ms_to_mph(float MetersPerSecond);
 float vectorMagnitude(float x, float y, float z);
 float RoundZ(float num);
-void MSSBCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer);
-void MGTTCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer);
+void MSSBCalculateNextGolfer(const Core::FrameSnapshot& frame, int& nextGolfer);
+void MGTTCalculateNextGolfer(const Core::FrameSnapshot& frame, int& nextGolfer);
 
-void AutoGolfMode(const Core::CPUThreadGuard& guard);
-void TrainingMode(const Core::CPUThreadGuard& guard);
-void DisplayPlayerNames(const Core::CPUThreadGuard& guard);
-void SetAvgPing(const Core::CPUThreadGuard& guard);
+void AutoGolfMode(const Core::FrameSnapshot& frame);
+void TrainingMode(const Core::FrameSnapshot& frame);
+void DisplayPlayerNames(const Core::FrameSnapshot& frame);
+void SetAvgPing(const Core::FrameSnapshot& frame);
 void SetNetplayerUserInfo();
-void RunDraftTimer(const Core::CPUThreadGuard& guard);
+void RunDraftTimer(const Core::FrameSnapshot& frame);
 int GetNextGolferID();
 
 //enum class GameMode
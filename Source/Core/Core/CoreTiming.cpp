@@ -4,9 +4,12 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -19,8 +22,10 @@
 #include "Core/AchievementManager.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
@@ -33,10 +38,6 @@
 namespace CoreTiming
 {
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
@@ -44,6 +45,232 @@ static bool operator<(const Event& left, const Event& right)
 
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
+// The event counters are only written on the CPU thread, so they don't need a locked add
+static void AddToCounter(std::atomic<u64>& counter, u64 value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+EventQueue::EventQueue()
+{
+  for (auto& level : m_slots)
+    level.fill(INVALID_NODE);
+}
+
+void EventQueue::Clear()
+{
+  for (const Node& node : m_nodes)
+  {
+    if (node.in_use)
+      node.event.type->last_queued_event = INVALID_NODE;
+  }
+
+  m_nodes.clear();
+  m_free_nodes = INVALID_NODE;
+  m_size = 0;
+  for (auto& level : m_slots)
+    level.fill(INVALID_NODE);
+  m_occupied_slots.fill(0);
+  m_overflow = INVALID_NODE;
+  m_wheel_time = 0;
+  m_front = INVALID_NODE;
+}
+
+void EventQueue::Push(const Event& event)
+{
+  const u32 index = AllocateNode();
+  Node& node = m_nodes[index];
+  node.event = event;
+  node.in_use = true;
+  Link(index);
+
+  EventType* type = event.type;
+  node.type_prev = type->last_queued_event;
+  node.type_next = INVALID_NODE;
+  if (type->last_queued_event != INVALID_NODE)
+    m_nodes[type->last_queued_event].type_next = index;
+  type->last_queued_event = index;
+
+  ++m_size;
+  if (m_front != INVALID_NODE && event < m_nodes[m_front].event)
+    m_front = index;
+}
+
+const Event& EventQueue::Front()
+{
+  if (m_front == INVALID_NODE)
+    FindFront();
+  return m_nodes[m_front].event;
+}
+
+void EventQueue::PopFront()
+{
+  if (m_front == INVALID_NODE)
+    FindFront();
+  const u32 index = m_front;
+  Unlink(index);
+  FreeNode(index);
+}
+
+size_t EventQueue::RemoveAll(EventType* type)
+{
+  size_t count = 0;
+  for (u32 index = type->last_queued_event; index != INVALID_NODE; ++count)
+  {
+    const u32 prev = m_nodes[index].type_prev;
+    Unlink(index);
+    FreeNode(index);
+    index = prev;
+  }
+  return count;
+}
+
+std::vector<Event> EventQueue::GetSortedEvents() const
+{
+  std::vector<Event> events;
+  events.reserve(m_size);
+  for (const Node& node : m_nodes)
+  {
+    if (node.in_use)
+      events.push_back(node.event);
+  }
+  std::sort(events.begin(), events.end());
+  return events;
+}
+
+u32& EventQueue::GetListHead(u32 level, u32 slot)
+{
+  return level == OVERFLOW_LEVEL ? m_overflow : m_slots[level][slot];
+}
+
+u32 EventQueue::AllocateNode()
+{
+  if (m_free_nodes == INVALID_NODE)
+  {
+    m_nodes.emplace_back();
+    return static_cast<u32>(m_nodes.size() - 1);
+  }
+
+  const u32 index = m_free_nodes;
+  m_free_nodes = m_nodes[index].next;
+  return index;
+}
+
+void EventQueue::FreeNode(u32 index)
+{
+  Node& node = m_nodes[index];
+  if (node.type_prev != INVALID_NODE)
+    m_nodes[node.type_prev].type_next = node.type_next;
+  if (node.type_next != INVALID_NODE)
+    m_nodes[node.type_next].type_prev = node.type_prev;
+  else
+    node.event.type->last_queued_event = node.type_prev;
+
+  node.in_use = false;
+  node.next = m_free_nodes;
+  m_free_nodes = index;
+  --m_size;
+  if (m_front == index)
+    m_front = INVALID_NODE;
+}
+
+void EventQueue::Link(u32 index)
+{
+  Node& node = m_nodes[index];
+
+  // Events which are already due go into the slot of the wheel time, where they are found first
+  const u64 key = std::max(GetKey(node.event), m_wheel_time);
+  const u64 difference = key ^ m_wheel_time;
+  const u32 level = difference == 0 ? 0 : (63 - std::countl_zero(difference)) / SLOT_BITS;
+  if (level >= LEVEL_COUNT)
+  {
+    node.level = OVERFLOW_LEVEL;
+    node.slot = 0;
+  }
+  else
+  {
+    node.level = static_cast<u8>(level);
+    node.slot = static_cast<u8>((key >> (level * SLOT_BITS)) & (SLOT_COUNT - 1));
+    m_occupied_slots[level] |= 1ULL << node.slot;
+  }
+
+  u32& head = GetListHead(node.level, node.slot);
+  node.prev = INVALID_NODE;
+  node.next = head;
+  if (head != INVALID_NODE)
+    m_nodes[head].prev = index;
+  head = index;
+}
+
+void EventQueue::Unlink(u32 index)
+{
+  const Node& node = m_nodes[index];
+  u32& head = GetListHead(node.level, node.slot);
+  if (node.prev != INVALID_NODE)
+    m_nodes[node.prev].next = node.next;
+  else
+    head = node.next;
+  if (node.next != INVALID_NODE)
+    m_nodes[node.next].prev = node.prev;
+
+  if (head == INVALID_NODE && node.level != OVERFLOW_LEVEL)
+    m_occupied_slots[node.level] &= ~(1ULL << node.slot);
+}
+
+void EventQueue::Cascade(u32 head)
+{
+  for (u32 index = head; index != INVALID_NODE;)
+  {
+    const u32 next = m_nodes[index].next;
+    Link(index);
+    index = next;
+  }
+}
+
+void EventQueue::FindFront()
+{
+  while (true)
+  {
+    u32 level = 0;
+    while (level < LEVEL_COUNT && m_occupied_slots[level] == 0)
+      ++level;
+
+    if (level == 0)
+    {
+      // Every event in a level 0 slot has the same time, except for those which were already due
+      const u32 slot = std::countr_zero(m_occupied_slots[0]);
+      u32 front = m_slots[0][slot];
+      for (u32 index = m_nodes[front].next; index != INVALID_NODE; index = m_nodes[index].next)
+      {
+        if (m_nodes[index].event < m_nodes[front].event)
+          front = index;
+      }
+      m_front = front;
+      return;
+    }
+
+    u32 head;
+    if (level == LEVEL_COUNT)
+    {
+      u64 earliest = UINT64_MAX;
+      for (u32 index = m_overflow; index != INVALID_NODE; index = m_nodes[index].next)
+        earliest = std::min(earliest, GetKey(m_nodes[index].event));
+      m_wheel_time = earliest;
+      head = std::exchange(m_overflow, INVALID_NODE);
+    }
+    else
+    {
+      const u32 slot = std::countr_zero(m_occupied_slots[level]);
+      const u32 shift = level * SLOT_BITS;
+      const u64 lower_mask = (1ULL << (shift + SLOT_BITS)) - 1;
+      m_wheel_time = (m_wheel_time & ~lower_mask) | (u64{slot} << shift);
+      head = std::exchange(m_slots[level][slot], INVALID_NODE);
+      m_occupied_slots[level] &= ~(1ULL << slot);
+    }
+    Cascade(head);
+  }
+}
+
 static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
 }
@@ -78,15 +305,18 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
              "during Init to avoid breaking save states.",
              name);
 
-  auto info = m_event_types.emplace(name, EventType{callback, nullptr});
+  std::lock_guard lk(m_event_types_lock);
+  auto info = m_event_types.try_emplace(name);
   EventType* event_type = &info.first->second;
+  event_type->callback = callback;
   event_type->name = &info.first->first;
   return event_type;
 }
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, m_event_queue.IsEmpty(), "Cannot unregister events with events pending");
+  std::lock_guard lk(m_event_types_lock);
   m_event_types.clear();
 }
 
@@ -111,6 +341,7 @@ void CoreTimingManager::Init()
 
   // Reset data used by the throttling system
   ResetThrottle(0);
+  m_catching_up = false;
 
   m_event_fifo_id = 0;
   m_ev_lost = RegisterEvent("_lost_event", &EmptyTimedCallback);
@@ -123,6 +354,7 @@ void CoreTimingManager::Shutdown()
   ClearPendingEvents();
   UnregisterAllEvents();
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
+  m_slice_end_callback = nullptr;
 }
 
 void CoreTimingManager::RefreshConfig()
@@ -131,6 +363,7 @@ void CoreTimingManager::RefreshConfig()
       Config::Get(Config::MAIN_OVERCLOCK_ENABLE) ? Config::Get(Config::MAIN_OVERCLOCK) : 1.0f;
   m_config_oc_inv_factor = 1.0f / m_config_oc_factor;
   m_config_sync_on_skip_idle = Config::Get(Config::MAIN_SYNC_ON_SKIP_IDLE);
+  m_config_time_callbacks = Config::Get(Config::GFX_OVERLAY_STATS);
 
   // A maximum fallback is used to prevent the system from sleeping for
   // too long or going full speed in an attempt to catch up to timings.
@@ -169,7 +402,8 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events = m_event_queue.GetSortedEvents();
+  p.DoEachElement(events, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -204,10 +438,10 @@ void CoreTimingManager::DoState(PointerWrap& p)
 
   if (p.IsReadMode())
   {
-    // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    // Older save states stored the events in heap order, so don't rely on any order here
+    m_event_queue.Clear();
+    for (const Event& ev : events)
+      m_event_queue.Push(ev);
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -235,7 +469,7 @@ u64 CoreTimingManager::GetIdleTicks() const
 
 void CoreTimingManager::ClearPendingEvents()
 {
-  m_event_queue.clear();
+  m_event_queue.Clear();
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -264,8 +498,8 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Push(Event{timeout, m_event_fifo_id++, userdata, event_type});
+    AddToCounter(event_type->schedule_count, 1);
   }
   else
   {
@@ -284,15 +518,9 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
-  {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  const size_t removed = m_event_queue.RemoveAll(event_type);
+  if (removed != 0)
+    AddToCounter(event_type->remove_count, removed);
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -319,8 +547,8 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Push(ev);
+    AddToCounter(ev.type->schedule_count, 1);
   }
 }
 
@@ -341,23 +569,34 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (!m_event_queue.IsEmpty() && m_event_queue.Front().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-    m_event_queue.pop_back();
+    const Event evt = m_event_queue.Front();
+    m_event_queue.PopFront();
 
     Throttle(evt.time);
-    evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
+    if (m_config_time_callbacks)
+    {
+      const TimePoint start = Clock::now();
+      evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
+      const DT duration = Clock::now() - start;
+      const auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+      AddToCounter(evt.type->callback_ns, duration_ns.count());
+    }
+    else
+    {
+      evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
+    }
+    AddToCounter(evt.type->callback_count, 1);
   }
 
   m_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (!m_event_queue.IsEmpty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue.Front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -367,6 +606,14 @@ void CoreTimingManager::Advance()
   // until the next slice:
   //        Pokemon Box refuses to boot if the first exception from the audio DMA is received late
   power_pc.CheckExternalExceptions();
+
+  if (m_slice_end_callback)
+    m_slice_end_callback();
+}
+
+void CoreTimingManager::SetSliceEndCallback(std::function<void()> callback)
+{
+  m_slice_end_callback = std::move(callback);
 }
 
 void CoreTimingManager::Throttle(const s64 target_cycle)
@@ -380,7 +627,8 @@ void CoreTimingManager::Throttle(const s64 target_cycle)
 
   m_throttle_last_cycle = target_cycle;
 
-  const double speed = Core::GetIsThrottlerTempDisabled() ? 0.0 : m_emulation_speed;
+  const double speed =
+      Core::GetIsThrottlerTempDisabled() || m_catching_up ? 0.0 : m_emulation_speed;
 
   if (0.0 < speed)
     m_throttle_deadline +=
@@ -410,11 +658,15 @@ void CoreTimingManager::Throttle(const s64 target_cycle)
   // Only sleep if we are behind the deadline
   if (time < m_throttle_deadline)
   {
+    // Use the time to compile code the game is likely to run soon
+    m_system.GetJitInterface().PrecompileCachedBlocks(m_throttle_deadline);
+
+    const TimePoint time_before_sleep = Clock::now();
     std::this_thread::sleep_until(m_throttle_deadline);
 
     // Count amount of time sleeping for analytics
     const TimePoint time_after_sleep = Clock::now();
-    g_perf_metrics.CountThrottleSleep(time_after_sleep - time);
+    g_perf_metrics.CountThrottleSleep(time_after_sleep - time_before_sleep);
   }
 }
 
@@ -442,25 +694,61 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue.GetSortedEvents())
   {
     INFO_LOG_FMT(POWERPC, "PENDING: Now: {} Pending: {} Type: {}", m_globals.global_timer, ev.time,
                  *ev.type->name);
   }
 }
 
+std::vector<EventStatistics> CoreTimingManager::SampleEventStatistics()
+{
+  std::vector<EventStatistics> statistics;
+  {
+    std::lock_guard lk(m_event_types_lock);
+    for (auto& [name, type] : m_event_types)
+    {
+      const u64 schedule_count = type.schedule_count.load(std::memory_order_relaxed);
+      const u64 remove_count = type.remove_count.load(std::memory_order_relaxed);
+      const u64 callback_count = type.callback_count.load(std::memory_order_relaxed);
+      const u64 callback_ns = type.callback_ns.load(std::memory_order_relaxed);
+      if (schedule_count != type.sampled_schedule_count ||
+          remove_count != type.sampled_remove_count ||
+          callback_count != type.sampled_callback_count)
+      {
+        statistics.push_back({name, schedule_count - type.sampled_schedule_count,
+                              remove_count - type.sampled_remove_count,
+                              callback_count - type.sampled_callback_count,
+                              callback_ns - type.sampled_callback_ns});
+      }
+      type.sampled_schedule_count = schedule_count;
+      type.sampled_remove_count = remove_count;
+      type.sampled_callback_count = callback_count;
+      type.sampled_callback_ns = callback_ns;
+    }
+  }
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const EventStatistics& a, const EventStatistics& b) {
+              return std::tie(a.callback_ns, a.callback_count, a.schedule_count) >
+                     std::tie(b.callback_ns, b.callback_count, b.schedule_count);
+            });
+  return statistics;
+}
+
 // Should only be called from the CPU thread after the PPC clock has changed
 void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
 {
   m_throttle_clock_per_sec = new_ppc_clock;
   m_throttle_min_clock_per_sleep = new_ppc_clock / 1200;
 
-  for (Event& ev : m_event_queue)
+  std::vector<Event> events = m_event_queue.GetSortedEvents();
+  m_event_queue.Clear();
+  for (Event& ev : events)
   {
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
+    m_event_queue.Push(ev);
   }
 }
 
@@ -485,9 +773,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue.GetSortedEvents())
   {
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
@@ -16,6 +16,9 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
+#include <array>
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -49,8 +52,23 @@ typedef void (*TimedCallback)(Core::System& system, u64 userdata, s64 cyclesLate
 
 struct EventType
 {
-  TimedCallback callback;
-  const std::string* name;
+  TimedCallback callback = nullptr;
+  const std::string* name = nullptr;
+
+  // The most recently queued event of this type, maintained by EventQueue
+  u32 last_queued_event = UINT32_MAX;
+
+  // Only written on the CPU thread, read by SampleEventStatistics
+  std::atomic<u64> schedule_count = 0;
+  std::atomic<u64> remove_count = 0;
+  std::atomic<u64> callback_count = 0;
+  std::atomic<u64> callback_ns = 0;
+
+  // The counts at the previous SampleEventStatistics call
+  u64 sampled_schedule_count = 0;
+  u64 sampled_remove_count = 0;
+  u64 sampled_callback_count = 0;
+  u64 sampled_callback_ns = 0;
 };
 
 struct Event
@@ -61,6 +79,88 @@ struct Event
   EventType* type;
 };
 
+struct EventStatistics
+{
+  std::string name;
+  u64 schedule_count;
+  u64 remove_count;
+  u64 callback_count;
+  u64 callback_ns;
+};
+
+// Orders the pending events by time, and by the order they were added in for equal times, like a
+// min-heap would, but adds and removes events in constant time. This is a hierarchical timer wheel:
+// level N has 64 slots of 64^N cycles each, counted from the wheel time. An event goes into the
+// level of the highest base-64 digit in which its time differs from the wheel time, so the lowest
+// occupied slot of the lowest occupied level always holds the earliest events. When that slot is
+// on a higher level, the wheel time moves to the start of the slot and its events are spread over
+// the levels below. Events too far ahead for the wheel wait in an overflow list.
+class EventQueue
+{
+public:
+  EventQueue();
+
+  bool IsEmpty() const { return m_size == 0; }
+  size_t Size() const { return m_size; }
+
+  void Clear();
+  void Push(const Event& event);
+
+  // The earliest event. The queue must not be empty.
+  const Event& Front();
+  void PopFront();
+
+  // Returns how many events were removed
+  size_t RemoveAll(EventType* type);
+
+  // In order of time, then of fifo_order
+  std::vector<Event> GetSortedEvents() const;
+
+private:
+  static constexpr u32 SLOT_BITS = 6;
+  static constexpr u32 SLOT_COUNT = 1 << SLOT_BITS;
+  static constexpr u32 LEVEL_COUNT = 6;
+  static constexpr u32 OVERFLOW_LEVEL = LEVEL_COUNT;
+  static constexpr u32 INVALID_NODE = UINT32_MAX;
+
+  struct Node
+  {
+    Event event;
+    // The events in the same slot, or the next free node
+    u32 prev;
+    u32 next;
+    // The events of the same type
+    u32 type_prev;
+    u32 type_next;
+    u8 level;
+    u8 slot;
+    bool in_use;
+  };
+
+  // The time as an unsigned value with the same order
+  static u64 GetKey(const Event& event) { return static_cast<u64>(event.time) ^ (1ULL << 63); }
+
+  u32& GetListHead(u32 level, u32 slot);
+  u32 AllocateNode();
+  void FreeNode(u32 index);
+  void Link(u32 index);
+  void Unlink(u32 index);
+  void Cascade(u32 head);
+  void FindFront();
+
+  std::vector<Node> m_nodes;
+  u32 m_free_nodes = INVALID_NODE;
+  size_t m_size = 0;
+
+  std::array<std::array<u32, SLOT_COUNT>, LEVEL_COUNT> m_slots;
+  std::array<u64, LEVEL_COUNT> m_occupied_slots{};
+  u32 m_overflow = INVALID_NODE;
+  u64 m_wheel_time = 0;
+
+  // The earliest event, or INVALID_NODE if it has to be looked up again
+  u32 m_front = INVALID_NODE;
+};
+
 enum class FromThread
 {
   CPU,
@@ -118,6 +218,11 @@ public:
   void Advance();
   void MoveEvents();
 
+  // Called on the CPU thread at the end of every Advance(), once the events that were due ran and
+  // rescheduled themselves. No event is in flight there, so the emulated machine can be saved or
+  // loaded. Only change it while the CPU thread is not running; Shutdown() removes it.
+  void SetSliceEndCallback(std::function<void()> callback);
+
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
 
@@ -126,6 +231,11 @@ public:
 
   void LogPendingEvents() const;
 
+  // Returns how often each event type was scheduled, removed and ran, and how long its callbacks
+  // took, since the previous call. Busiest event types first. Callbacks are only timed while the
+  // statistics overlay is shown. Can be called from any thread.
+  std::vector<EventStatistics> SampleEventStatistics();
+
   std::string GetScheduledEventsSummary() const;
 
   void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock);
@@ -149,6 +259,10 @@ public:
   // in order to allow custom throttling implementations to be tested.
   void Throttle(const s64 target_cycle);
 
+  // Runs unthrottled while set, like the temporary throttle hotkey. Only changed on the CPU thread,
+  // while NetPlay rollback catches up with frames it simulates again.
+  void SetCatchingUp(bool catching_up) { m_catching_up = catching_up; }
+
   TimePoint GetCPUTimePoint(s64 cyclesLate) const;  // Used by Dolphin Analytics
   bool GetVISkip() const;                           // Used By VideoInterface
 
@@ -162,13 +276,11 @@ private:
   // unordered_map stores each element separately as a linked list node so pointers to elements
   // remain stable regardless of rehashes/resizing.
   std::unordered_map<std::string, EventType> m_event_types;
+  // Guards m_event_types against SampleEventStatistics
+  std::mutex m_event_types_lock;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
-  std::vector<Event> m_event_queue;
+  EventQueue m_event_queue;
   u64 m_event_fifo_id = 0;
   std::mutex m_ts_write_lock;
   Common::SPSCQueue<Event, false> m_ts_queue;
@@ -182,18 +294,22 @@ private:
   // Are we in a function that has been called from Advance()
   bool m_is_global_timer_sane = false;
 
+  std::function<void()> m_slice_end_callback;
+
   EventType* m_ev_lost = nullptr;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_registered_config_callback_id;
   float m_config_oc_factor = 0.0f;
   float m_config_oc_inv_factor = 0.0f;
   bool m_config_sync_on_skip_idle = false;
+  bool m_config_time_callbacks = false;
 
   s64 m_throttle_last_cycle = 0;
   TimePoint m_throttle_deadline = Clock::now();
   s64 m_throttle_clock_per_sec = 0;
   s64 m_throttle_min_clock_per_sleep = 0;
   bool m_throttle_disable_vi_int = false;
+  bool m_catching_up = false;
 
   DT m_max_fallback = {};
   DT m_max_variance = {};
@@ -501,6 +501,7 @@ void FifoPlayer::WriteMemory(const MemoryUpdate& memUpdate)
     mem = &memory.GetRAM()[memUpdate.address & memory.GetRamMask()];
 
   std::copy(memUpdate.data.begin(), memUpdate.data.end(), mem);
+  memory.MarkDirty(mem, memUpdate.data.size());
 }
 
 void FifoPlayer::WriteFifo(const u8* data, u32 start, u32 end)
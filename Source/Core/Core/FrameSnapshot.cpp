@@ -0,0 +1,122 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/FrameSnapshot.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+
+namespace Core
+{
+namespace
+{
+// Ranges closer than this are copied as one, which is cheaper than tracking them separately.
+constexpr u32 MERGE_GAP = 64;
+
+u32 ToPhysical(u32 address)
+{
+  return address & 0x3FFFFFFF;
+}
+}  // namespace
+
+void FrameSnapshot::Watch(u32 address, u32 size)
+{
+  if (size == 0)
+    return;
+  m_watched.push_back({address, size, 0});
+  m_ranges_dirty = true;
+}
+
+void FrameSnapshot::MergeRanges()
+{
+  std::vector<Range> sorted = m_watched;
+  std::sort(sorted.begin(), sorted.end(), [](const Range& a, const Range& b) {
+    return ToPhysical(a.address) < ToPhysical(b.address);
+  });
+
+  m_ranges.clear();
+  u32 total_size = 0;
+  for (const Range& range : sorted)
+  {
+    const u32 start = ToPhysical(range.address);
+    const u32 end = start + range.size;
+    if (!m_ranges.empty() && start <= m_ranges.back().address + m_ranges.back().size + MERGE_GAP)
+    {
+      Range& last = m_ranges.back();
+      const u32 new_end = std::max(last.address + last.size, end);
+      total_size += new_end - (last.address + last.size);
+      last.size = new_end - last.address;
+      continue;
+    }
+    m_ranges.push_back({start, range.size, total_size});
+    total_size += range.size;
+  }
+
+  m_data.resize(total_size);
+  m_ranges_dirty = false;
+}
+
+void FrameSnapshot::Capture(const CPUThreadGuard& guard)
+{
+  if (m_ranges_dirty)
+    MergeRanges();
+
+  auto& memory = guard.GetSystem().GetMemory();
+  m_ram = memory.GetRAM();
+  m_ram_size = memory.GetRamSizeReal();
+
+  for (const Range& range : m_ranges)
+  {
+    if (range.address + range.size > m_ram_size)
+    {
+      // Outside MEM1. Reads of this range fall back to MEM1 lookups and return 0.
+      std::memset(m_data.data() + range.offset, 0, range.size);
+      continue;
+    }
+    std::memcpy(m_data.data() + range.offset, m_ram + range.address, range.size);
+  }
+}
+
+template <typename T>
+T FrameSnapshot::Read(u32 address) const
+{
+  const u32 physical = ToPhysical(address);
+
+  // Find the last range starting at or before the address.
+  const auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), physical,
+                                   [](u32 value, const Range& range) { return value < range.address; });
+
+  T value;
+  if (it != m_ranges.begin() && physical + sizeof(T) <= std::prev(it)->address + std::prev(it)->size)
+  {
+    const Range& range = *std::prev(it);
+    std::memcpy(&value, m_data.data() + range.offset + (physical - range.address), sizeof(T));
+  }
+  else if (m_ram && physical + sizeof(T) <= m_ram_size)
+  {
+    std::memcpy(&value, m_ram + physical, sizeof(T));
+  }
+  else
+  {
+    WARN_LOG_FMT(CORE, "FrameSnapshot: read of {:#010x} is outside MEM1", address);
+    return 0;
+  }
+  return Common::FromBigEndian(value);
+}
+
+float FrameSnapshot::Read_F32(u32 address) const
+{
+  return std::bit_cast<float>(Read<u32>(address));
+}
+
+template u8 FrameSnapshot::Read<u8>(u32) const;
+template u16 FrameSnapshot::Read<u16>(u32) const;
+template u32 FrameSnapshot::Read<u32>(u32) const;
+}  // namespace Core
@@ -0,0 +1,59 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+
+// Once-per-frame copy of the guest memory ranges read by the Rio frame functions.
+//
+// Modules register the ranges they read every frame with Watch(). Capture() then copies all of
+// them from MEM1 in a few bulk copies, and the Read functions serve values from that copy, so the
+// frame logic sees one consistent view of memory and does not go through MMU translation for every
+// value. Reads outside the watched ranges are served directly from MEM1.
+//
+// Addresses are effective addresses in the cached or uncached MEM1 mirrors (0x80000000 and
+// 0xC0000000), which is all the Rio frame logic reads.
+class FrameSnapshot
+{
+public:
+  // Adds [address, address + size) to the ranges copied by Capture().
+  void Watch(u32 address, u32 size);
+
+  void Capture(const CPUThreadGuard& guard);
+
+  u8 Read_U8(u32 address) const { return Read<u8>(address); }
+  u16 Read_U16(u32 address) const { return Read<u16>(address); }
+  u32 Read_U32(u32 address) const { return Read<u32>(address); }
+  float Read_F32(u32 address) const;
+
+private:
+  struct Range
+  {
+    u32 address;
+    u32 size;
+    // Position of the range in m_data.
+    u32 offset;
+  };
+
+  template <typename T>
+  T Read(u32 address) const;
+
+  void MergeRanges();
+
+  std::vector<Range> m_watched;
+  // m_watched sorted and merged, so a read is a binary search over a handful of ranges.
+  std::vector<Range> m_ranges;
+  bool m_ranges_dirty = false;
+  std::vector<u8> m_data;
+
+  const u8* m_ram = nullptr;
+  u32 m_ram_size = 0;
+};
+}  // namespace Core
@@ -107,6 +107,13 @@ void CPUManager::Run()
       power_pc.RunLoop();
 
       state_lock.lock();
+      if (m_state_leaving_run_loop)
+      {
+        m_state_leaving_run_loop = false;
+        m_state = State::Running;
+        // Still marked active, so nothing can pause the CPU Thread before the jobs ran
+        ExecutePendingJobs(state_lock);
+      }
       m_state_cpu_thread_active = false;
       m_state_cpu_idle_cvar.notify_all();
       break;
@@ -188,6 +195,7 @@ void CPUManager::Stop()
   // will stick permanently.
   std::unique_lock state_lock(m_state_change_lock);
   m_state = State::PowerDown;
+  m_state_leaving_run_loop = false;
   m_state_cpu_cvar.notify_one();
 
   while (m_state_cpu_thread_active)
@@ -201,7 +209,7 @@ void CPUManager::Stop()
 
 bool CPUManager::IsStepping() const
 {
-  return m_state == State::Stepping;
+  return m_state == State::Stepping && !m_state_leaving_run_loop;
 }
 
 State CPUManager::GetState() const
@@ -244,6 +252,7 @@ bool CPUManager::SetStateLocked(State s)
   if (m_state == State::PowerDown)
     return false;
   m_state = s;
+  m_state_leaving_run_loop = false;
   return true;
 }
 
@@ -307,7 +316,7 @@ bool CPUManager::PauseAndLock(bool do_lock, bool unpause_on_unlock, bool control
     std::unique_lock state_lock(m_state_change_lock);
     m_state_paused_and_locked = true;
 
-    was_unpaused = m_state == State::Running;
+    was_unpaused = m_state == State::Running || m_state_leaving_run_loop;
     SetStateLocked(State::Stepping);
 
     while (m_state_cpu_thread_active)
@@ -363,4 +372,18 @@ void CPUManager::AddCPUThreadJob(std::function<void()> function)
   m_pending_jobs.push(std::move(function));
 }
 
+void CPUManager::AddCPUThreadJobAndLeaveRunLoop(std::function<void()> function)
+{
+  std::lock_guard state_lock(m_state_change_lock);
+  m_pending_jobs.push(std::move(function));
+
+  // The run loop checks the state at the end of every slice. Otherwise the jobs run anyway before
+  // the CPU Thread steps or runs again.
+  if (m_state == State::Running)
+  {
+    m_state = State::Stepping;
+    m_state_leaving_run_loop = true;
+  }
+}
+
 }  // namespace CPU
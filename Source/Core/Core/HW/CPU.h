@@ -73,7 +73,8 @@ public:
   // This should only be called from the CPU thread
   void Continue();
 
-  // Shorthand for GetState() == State::Stepping.
+  // Shorthand for GetState() == State::Stepping, except while the CPU Thread only leaves the run
+  // loop for AddCPUThreadJobAndLeaveRunLoop.
   // WARNING: State::PowerDown will return false, not just State::Running.
   bool IsStepping() const;
 
@@ -99,6 +100,11 @@ public:
   // PauseAndLock(), as while the CPU is in the run loop, it won't execute the function.
   void AddCPUThreadJob(std::function<void()> function);
 
+  // Adds a job and makes the CPU Thread leave the run loop at the end of the current slice to
+  // execute it, like between two runs of a paused CPU, before it continues running.
+  // Only for the CPU Thread.
+  void AddCPUThreadJobAndLeaveRunLoop(std::function<void()> function);
+
 private:
   void FlushStepSyncEventLocked();
   void ExecutePendingJobs(std::unique_lock<std::mutex>& state_lock);
@@ -130,6 +136,9 @@ private:
   bool m_state_cpu_thread_active = false;
   bool m_state_paused_and_locked = false;
   bool m_state_system_request_stepping = false;
+  // m_state is only State::Stepping to leave the run loop for AddCPUThreadJobAndLeaveRunLoop.
+  // Cleared by any other state change.
+  bool m_state_leaving_run_loop = false;
   bool m_state_cpu_step_instruction = false;
   Common::Event* m_state_cpu_step_instruction_sync = nullptr;
   std::queue<std::function<void()>> m_pending_jobs;
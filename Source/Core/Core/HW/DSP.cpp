@@ -79,7 +79,7 @@ constexpr int DSP_MAIL_SLICE = 72;
 void DSPManager::DoState(PointerWrap& p)
 {
   if (!m_aram.wii_mode)
-    p.DoArray(m_aram.ptr, m_aram.size);
+    p.DoMemoryBlock(m_aram.ptr, m_aram.size, &m_aram_dirty_pages);
   p.Do(m_dsp_control);
   p.Do(m_audio_dma);
   p.Do(m_aram_dma);
@@ -128,6 +128,7 @@ void DSPManager::Reinit(bool hle)
     m_aram.size = memory.GetExRamSizeReal();
     m_aram.mask = memory.GetExRamMask();
     m_aram.ptr = memory.GetEXRAM();
+    m_aram_dirty_pages.Shutdown();
   }
   else
   {
@@ -136,6 +137,7 @@ void DSPManager::Reinit(bool hle)
     m_aram.size = ARAM_SIZE;
     m_aram.mask = ARAM_MASK;
     m_aram.ptr = static_cast<u8*>(Common::AllocateMemoryPages(m_aram.size));
+    m_aram_dirty_pages.Init(m_aram.size);
   }
 
   m_audio_dma = {};
@@ -155,6 +157,7 @@ void DSPManager::Shutdown()
   {
     Common::FreeMemoryPages(m_aram.ptr, m_aram.size);
     m_aram.ptr = nullptr;
+    m_aram_dirty_pages.Shutdown();
   }
 
   m_dsp_emulator->Shutdown();
@@ -540,6 +543,7 @@ void DSPManager::Do_ARAM_DMA()
           {
             *(u64*)&m_aram.ptr[(m_aram_dma.ARAddr + 0x400000) & m_aram.mask] =
                 Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
+            m_aram_dirty_pages.MarkDirty((m_aram_dma.ARAddr + 0x400000) & m_aram.mask, 8);
           }
           *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
               Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
@@ -549,6 +553,7 @@ void DSPManager::Do_ARAM_DMA()
           *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
               Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
         }
+        m_aram_dirty_pages.MarkDirty(m_aram_dma.ARAddr & m_aram.mask, 8);
 
         m_aram_dma.MMAddr += 8;
         m_aram_dma.ARAddr += 8;
@@ -596,6 +601,7 @@ void DSPManager::WriteARAM(u8 value, u32 address)
 {
   // TODO: verify this on Wii
   m_aram.ptr[address & m_aram.mask] = value;
+  m_aram_dirty_pages.MarkDirty(address & m_aram.mask, 1);
 }
 
 u8* DSPManager::GetARAMPtr() const
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/DirtyPageBitmap.h"
 
 class PointerWrap;
 class DSPEmulator;
@@ -169,6 +170,8 @@ private:
   };
 
   ARAMInfo m_aram;
+  // Only tracked on the GameCube, where ARAM isn't EXRAM
+  Common::DirtyPageBitmap m_aram_dirty_pages;
   AudioDMA m_audio_dma;
   ARAM_DMA m_aram_dma;
   UDSPControl m_dsp_control;
@@ -470,6 +470,7 @@ void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
   if (write_addr)
   {
     int* ptr = (int*)HLEMemory_Get_Pointer(memory, write_addr);
+    memory.MarkDirty(reinterpret_cast<u8*>(ptr), sizeof(int) * 3 * 5 * 32);
     for (auto& buffer : buffers)
       for (u32 j = 0; j < 5 * 32; ++j)
         *ptr++ = Common::swap32(buffer[j]);
@@ -496,8 +497,10 @@ void AXUCode::UploadLRS(u32 dst_addr)
     buffers[1][i] = Common::swap32(m_samples_main_right[i]);
     buffers[2][i] = Common::swap32(m_samples_main_surround[i]);
   }
-  memcpy(HLEMemory_Get_Pointer(m_dsphle->GetSystem().GetMemory(), dst_addr), buffers,
-         sizeof(buffers));
+  auto& memory = m_dsphle->GetSystem().GetMemory();
+  u8* const dst = static_cast<u8*>(HLEMemory_Get_Pointer(memory, dst_addr));
+  memcpy(dst, buffers, sizeof(buffers));
+  memory.MarkDirty(dst, sizeof(buffers));
 }
 
 void AXUCode::SetMainLR(u32 src_addr)
@@ -566,7 +569,9 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
   for (u32 i = 0; i < 5 * 32; ++i)
     surround_buffer[i] = Common::swap32(m_samples_main_surround[i]);
   auto& memory = m_dsphle->GetSystem().GetMemory();
-  memcpy(HLEMemory_Get_Pointer(memory, surround_addr), surround_buffer, sizeof(surround_buffer));
+  u8* const surround_dst = static_cast<u8*>(HLEMemory_Get_Pointer(memory, surround_addr));
+  memcpy(surround_dst, surround_buffer, sizeof(surround_buffer));
+  memory.MarkDirty(surround_dst, sizeof(surround_buffer));
 
   // 32 samples per ms, 5 ms, 2 channels
   short buffer[5 * 32 * 2];
@@ -581,7 +586,9 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
     buffer[2 * i + 1] = Common::swap16(left);
   }
 
-  memcpy(HLEMemory_Get_Pointer(memory, lr_addr), buffer, sizeof(buffer));
+  u8* const lr_dst = static_cast<u8*>(HLEMemory_Get_Pointer(memory, lr_addr));
+  memcpy(lr_dst, buffer, sizeof(buffer));
+  memory.MarkDirty(lr_dst, sizeof(buffer));
 }
 
 void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
@@ -589,6 +596,7 @@ void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
   // Upload AUXB L/R
   auto& memory = m_dsphle->GetSystem().GetMemory();
   int* ptr = (int*)HLEMemory_Get_Pointer(memory, ul_addr);
+  memory.MarkDirty(reinterpret_cast<u8*>(ptr), sizeof(int) * 2 * 5 * 32);
   for (auto& sample : m_samples_auxB_left)
     *ptr++ = Common::swap32(sample);
   for (auto& sample : m_samples_auxB_right)
@@ -636,6 +644,7 @@ void AXUCode::SendAUXAndMix(u32 auxa_lrs_up, u32 auxb_s_up, u32 main_l_dl, u32 m
   // Upload AUXA LRS
   auto& memory = m_dsphle->GetSystem().GetMemory();
   int* ptr = (int*)HLEMemory_Get_Pointer(memory, auxa_lrs_up);
+  memory.MarkDirty(reinterpret_cast<u8*>(ptr), sizeof(int) * up_buffers.size() * 32 * 5);
   for (const auto& up_buffer : up_buffers)
   {
     for (u32 j = 0; j < 32 * 5; ++j)
@@ -644,6 +653,7 @@ void AXUCode::SendAUXAndMix(u32 auxa_lrs_up, u32 auxb_s_up, u32 main_l_dl, u32 m
 
   // Upload AUXB S
   ptr = (int*)HLEMemory_Get_Pointer(memory, auxb_s_up);
+  memory.MarkDirty(reinterpret_cast<u8*>(ptr), sizeof(m_samples_auxB_surround));
   for (auto& sample : m_samples_auxB_surround)
     *ptr++ = Common::swap32(sample);
 
@@ -0,0 +1,65 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMixer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/CPUDetect.h"
+#include "Common/Inline.h"
+#include "Common/MathUtil.h"
+
+#if defined(_M_X86) || defined(_M_X86_64)
+#define USE_SSE
+#include <immintrin.h>
+#endif
+
+#define NO_SIMD
+#include "Core/HW/DSPHLE/UCodes/AXMixerImpl.h"
+#undef NO_SIMD
+#ifdef USE_SSE
+#define USE_SSE41
+#include "Core/HW/DSPHLE/UCodes/AXMixerImpl.h"
+#endif
+
+namespace DSP::HLE::AXMixer
+{
+bool IsSupported(InstructionSet set)
+{
+  switch (set)
+  {
+  case InstructionSet::Scalar:
+    return true;
+#ifdef USE_SSE
+  case InstructionSet::SSE41:
+    return cpu_info.bSSE4_1;
+#endif
+  default:
+    return false;
+  }
+}
+
+const Functions& GetFunctions(InstructionSet set)
+{
+  switch (set)
+  {
+#ifdef USE_SSE
+  case InstructionSet::SSE41:
+    return AXMixer_SSE41::FUNCTIONS;
+#endif
+  default:
+    return AXMixer_Scalar::FUNCTIONS;
+  }
+}
+
+const Functions& GetFunctions()
+{
+  static const Functions& functions = []() -> const Functions& {
+    if (IsSupported(InstructionSet::SSE41))
+      return GetFunctions(InstructionSet::SSE41);
+    return GetFunctions(InstructionSet::Scalar);
+  }();
+  return functions;
+}
+}  // namespace DSP::HLE::AXMixer
@@ -0,0 +1,104 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+
+// The per-sample arithmetic of AX voices: resampling, the volume envelope and mixing into the
+// output buffers. The SIMD versions are picked at runtime and give the same results as the scalar
+// one, bit for bit.
+namespace DSP::HLE::AXMixer
+{
+// The most output samples a voice produces per call, which is 3ms for AX Wii
+constexpr u32 MAX_OUTPUT_SAMPLES = 96;
+
+// Computes count output samples. Output sample i is filtered from the four input samples starting
+// at input[positions[i]], at fracs[i] / 65536 between the first two of them. coeffs is the
+// polyphase coefficient table and is ignored by the linear filter.
+using ResampleFunction = void (*)(const s16* input, const u16* positions, const u16* fracs,
+                                  s16* output, u32 count, const s16* coeffs);
+// Multiplies the samples by the volume, which changes by volume_delta after each sample. The
+// volume is signed on GameCube and unsigned on Wii. Returns the volume after the last sample.
+using VolumeFunction = u16 (*)(s16* samples, u32 count, u16 volume, u16 volume_delta,
+                               bool signed_volume);
+// Adds the samples multiplied by the volume to out, like VolumeFunction, and stores the last of
+// them in dpop
+using MixFunction = void (*)(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                             s16* dpop);
+
+struct Functions
+{
+  ResampleFunction resample_polyphase;
+  ResampleFunction resample_linear;
+  VolumeFunction apply_volume;
+  MixFunction mix_add;
+};
+
+enum class InstructionSet
+{
+  Scalar,
+  SSE41,
+};
+
+bool IsSupported(InstructionSet set);
+const Functions& GetFunctions(InstructionSet set);
+
+// The functions for the best instruction set of the CPU
+const Functions& GetFunctions();
+
+// Reads samples from the input callback and resamples them to count samples, with the polyphase
+// filter if coeffs is set or the linear one otherwise. last_samples are the four most recent
+// input samples of the previous call and are updated. curr_pos is the position between input
+// samples and ratio the input to output ratio, both with 16 bits of fraction. Returns the new
+// position.
+//
+// All the input samples are read first, so the filter can work on many output samples at once.
+template <typename InputCallback>
+u32 Resample(const Functions& functions, InputCallback input_callback, s16* output, u32 count,
+             s16* last_samples, u32 curr_pos, u32 ratio, const s16* coeffs)
+{
+  ASSERT(count <= MAX_OUTPUT_SAMPLES);
+  const ResampleFunction filter =
+      coeffs ? functions.resample_polyphase : functions.resample_linear;
+
+  // Enough for ratios up to 4 without flushing
+  std::array<s16, 4 + MAX_OUTPUT_SAMPLES * 4> input;
+  std::array<u16, MAX_OUTPUT_SAMPLES> positions;
+  std::array<u16, MAX_OUTPUT_SAMPLES> fracs;
+  std::copy_n(last_samples, 4, input.begin());
+
+  u32 input_size = 4;
+  u32 first_output = 0;
+  u32 read_samples_count = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    while (curr_pos >= 0x10000)
+    {
+      if (input_size == input.size())
+      {
+        // Filter what was read so far and keep the four samples the next output could use
+        filter(input.data(), &positions[first_output], &fracs[first_output], &output[first_output],
+               i - first_output, coeffs);
+        first_output = i;
+        std::copy(input.end() - 4, input.end(), input.begin());
+        input_size = 4;
+      }
+      input[input_size++] = input_callback(read_samples_count++);
+      curr_pos -= 0x10000;
+    }
+    positions[i] = static_cast<u16>(input_size - 4);
+    fracs[i] = static_cast<u16>(curr_pos);
+  }
+
+  filter(input.data(), &positions[first_output], &fracs[first_output], &output[first_output],
+         count - first_output, coeffs);
+  std::copy_n(&input[input_size - 4], 4, last_samples);
+  return curr_pos;
+}
+}  // namespace DSP::HLE::AXMixer
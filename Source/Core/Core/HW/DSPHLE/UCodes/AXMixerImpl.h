@@ -0,0 +1,218 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#if defined(USE_SSE41)
+#define VECTOR_NAMESPACE AXMixer_SSE41
+#elif defined(NO_SIMD)
+#define VECTOR_NAMESPACE AXMixer_Scalar
+#else
+#error This file is meant to be used by AXMixer.cpp only!
+#endif
+
+#if defined(__GNUC__) && defined(USE_SSE41) && !defined(__SSE4_1__)
+#define ATTR_TARGET __attribute__((target("sse4.1")))
+#else
+#define ATTR_TARGET
+#endif
+
+namespace VECTOR_NAMESPACE
+{
+#if defined(USE_SSE41)
+// The volumes of four consecutive samples, starting at volume
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i RampVolumes(u16 volume, u16 volume_delta)
+{
+  const __m128i steps = _mm_setr_epi32(0, 1, 2, 3);
+  const __m128i volumes = _mm_add_epi32(_mm_set1_epi32(volume),
+                                        _mm_mullo_epi32(steps, _mm_set1_epi32(volume_delta)));
+  return _mm_and_si128(volumes, _mm_set1_epi32(0xFFFF));
+}
+
+// (sample * volume) >> 15, clamped like the scalar code. Neither product nor shift can overflow.
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i ScaleSamples(__m128i samples, __m128i volumes)
+{
+  const __m128i scaled = _mm_srai_epi32(_mm_mullo_epi32(samples, volumes), 15);
+  return _mm_max_epi32(_mm_min_epi32(scaled, _mm_set1_epi32(32767)), _mm_set1_epi32(-32767));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i LoadSamples(const s16* samples)
+{
+  return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(samples)));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void StoreSamples(s16* samples, __m128i values)
+{
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(samples), _mm_packs_epi32(values, values));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i LoadFour(const s16* values)
+{
+  return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values));
+}
+
+// The pair sums of the taps and coefficients of two polyphase output samples
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i PolyphasePairs(const s16* input,
+                                                               const u16* positions,
+                                                               const u16* fracs,
+                                                               const s16* coeffs)
+{
+  const __m128i taps =
+      _mm_unpacklo_epi64(LoadFour(&input[positions[0]]), LoadFour(&input[positions[1]]));
+  const __m128i c = _mm_unpacklo_epi64(LoadFour(&coeffs[(fracs[0] >> 9) << 2]),
+                                       LoadFour(&coeffs[(fracs[1] >> 9) << 2]));
+  return _mm_madd_epi16(taps, c);
+}
+
+// The pair sums shifted right by 15. A pair sum only overflows when both products are
+// (-32768)^2, which turns 2^31 into INT_MIN; that is the only way to get INT_MIN.
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i HighHalves(__m128i sums)
+{
+  const __m128i overflow = _mm_cmpeq_epi32(sums, _mm_set1_epi32(INT32_MIN));
+  return _mm_add_epi32(_mm_srai_epi32(sums, 15), _mm_and_si128(overflow, _mm_set1_epi32(1 << 17)));
+}
+#endif
+
+ATTR_TARGET static void ResamplePolyphase(const s16* input, const u16* positions, const u16* fracs,
+                                          s16* output, u32 count, const s16* coeffs)
+{
+  u32 i = 0;
+#if defined(USE_SSE41)
+  // The sum of four products needs 33 bits, so each pair sum from _mm_madd_epi16 is split at bit
+  // 15 and the halves are added separately
+  const __m128i low_mask = _mm_set1_epi32(0x7FFF);
+
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i sums01 = PolyphasePairs(input, &positions[i], &fracs[i], coeffs);
+    const __m128i sums23 = PolyphasePairs(input, &positions[i + 2], &fracs[i + 2], coeffs);
+    const __m128i high = _mm_hadd_epi32(HighHalves(sums01), HighHalves(sums23));
+    const __m128i low =
+        _mm_hadd_epi32(_mm_and_si128(sums01, low_mask), _mm_and_si128(sums23, low_mask));
+    StoreSamples(&output[i], _mm_add_epi32(high, _mm_srli_epi32(low, 15)));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16* t = &input[positions[i]];
+    const s16* c = &coeffs[(fracs[i] >> 9) << 2];
+    const s64 sample = (s64{t[0]} * c[0] + s64{t[1]} * c[1] + s64{t[2]} * c[2] +
+                        s64{t[3]} * c[3]) >>
+                       15;
+    output[i] = MathUtil::SaturatingCast<s16>(sample);
+  }
+}
+
+ATTR_TARGET static void ResampleLinear(const s16* input, const u16* positions, const u16* fracs,
+                                       s16* output, u32 count, const s16* coeffs)
+{
+  u32 i = 0;
+#if defined(USE_SSE41)
+  for (; i + 4 <= count; i += 4)
+  {
+    // The first two taps of each output sample, in the low and high half of a lane
+    u32 pairs[4];
+    for (u32 j = 0; j < 4; ++j)
+      std::memcpy(&pairs[j], &input[positions[i + j]], sizeof(u32));
+    const __m128i taps = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs));
+    const __m128i s0 = _mm_srai_epi32(_mm_slli_epi32(taps, 16), 16);
+    const __m128i s1 = _mm_srai_epi32(taps, 16);
+
+    const __m128i frac =
+        _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&fracs[i])));
+    const __m128i inv_frac =
+        _mm_and_si128(_mm_sub_epi32(_mm_setzero_si128(), frac), _mm_set1_epi32(0xFFFF));
+
+    // The weights add up to 65536, so the sum fits in 32 bits
+    const __m128i sum = _mm_add_epi32(_mm_mullo_epi32(s0, inv_frac), _mm_mullo_epi32(s1, frac));
+    const __m128i sample = _mm_blendv_epi8(_mm_srai_epi32(sum, 16), s0,
+                                           _mm_cmpeq_epi32(frac, _mm_setzero_si128()));
+    StoreSamples(&output[i], sample);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16* t = &input[positions[i]];
+    const u16 curr_frac = fracs[i];
+    const u16 inv_curr_frac = -curr_frac;
+
+    // Interpolate! If curr_frac is 0, we can simply take the first sample without any
+    // multiplying.
+    if (curr_frac)
+      output[i] = static_cast<s16>((t[0] * inv_curr_frac + t[1] * curr_frac) >> 16);
+    else
+      output[i] = t[0];
+  }
+}
+
+ATTR_TARGET static u16 ApplyVolume(s16* samples, u32 count, u16 volume, u16 volume_delta,
+                                   bool signed_volume)
+{
+  u32 i = 0;
+#if defined(USE_SSE41)
+  __m128i volumes = RampVolumes(volume, volume_delta);
+  const __m128i step = _mm_set1_epi32(volume_delta * 4);
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i lane_volumes =
+        signed_volume ? _mm_srai_epi32(_mm_slli_epi32(volumes, 16), 16) : volumes;
+    StoreSamples(&samples[i], ScaleSamples(LoadSamples(&samples[i]), lane_volumes));
+    volumes = _mm_and_si128(_mm_add_epi32(volumes, step), _mm_set1_epi32(0xFFFF));
+  }
+  volume += static_cast<u16>(volume_delta * i);
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 lane_volume = signed_volume ? s32{static_cast<s16>(volume)} : s32{volume};
+    const s32 sample = (s32{samples[i]} * lane_volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+  return volume;
+}
+
+ATTR_TARGET static void MixAdd(int* out, const s16* input, u32 count, u16* volume_ptr,
+                               u16 volume_delta, s16* dpop)
+{
+  u16 volume = *volume_ptr;
+  u32 i = 0;
+#if defined(USE_SSE41)
+  if (count >= 4)
+  {
+    __m128i volumes = RampVolumes(volume, volume_delta);
+    const __m128i step = _mm_set1_epi32(volume_delta * 4);
+    __m128i samples;
+    for (; i + 4 <= count; i += 4)
+    {
+      samples = ScaleSamples(LoadSamples(&input[i]), volumes);
+      __m128i* dest = reinterpret_cast<__m128i*>(&out[i]);
+      _mm_storeu_si128(dest, _mm_add_epi32(_mm_loadu_si128(dest), samples));
+      volumes = _mm_and_si128(_mm_add_epi32(volumes, step), _mm_set1_epi32(0xFFFF));
+    }
+    volume += static_cast<u16>(volume_delta * i);
+    *dpop = static_cast<s16>(_mm_extract_epi32(samples, 3));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+  *volume_ptr = volume;
+}
+
+static constexpr DSP::HLE::AXMixer::Functions FUNCTIONS = {ResamplePolyphase, ResampleLinear,
+                                                           ApplyVolume, MixAdd};
+}  // namespace VECTOR_NAMESPACE
+
+#undef ATTR_TARGET
+#undef VECTOR_NAMESPACE
@@ -12,7 +12,6 @@
 #endif
 
 #include <algorithm>
-#include <functional>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -20,6 +19,7 @@
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixer.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -238,114 +238,24 @@ u16 AcceleratorGetSample(HLEAccelerator* accelerator)
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
-  int read_samples_count = 0;
-
-  // If DSP DROM coefficients are available, support polyphase resampling.
-  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
   {
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
-      const s16* c = &coeffs[curr_pos_frac];
-
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
-    }
-
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
+    // The linear and polyphase filters, which keep the four most recent input samples in
+    // last_samples, are in AXMixer.
+    return AXMixer::Resample(AXMixer::GetFunctions(), input_callback, output, count, last_samples,
+                             curr_pos, ratio, srctype == SRCTYPE_POLYPHASE ? coeffs : nullptr);
   }
-  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
-  {
-    // This is the circular buffer containing samples to use for the
-    // interpolation. It is initialized with the values from the PB, and it
-    // will be stored back to the PB at the end.
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-
-      // While our current position is >= 1.0, push new samples to the
-      // circular buffer.
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
-
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
-      {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
 
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
-      }
-      else
-      {
-        sample = temp[idx++ & 3];
-        idx += 3;
-      }
-
-      output[i] = sample;
-    }
-
-    // Update the four last_samples values.
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else  // SRCTYPE_NEAREST
-  {
-    // No sample rate conversion here: simply read samples from the
-    // accelerator to the output buffer.
-    for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
+  // SRCTYPE_NEAREST: No sample rate conversion here: simply read samples from the
+  // accelerator to the output buffer.
+  for (u32 i = 0; i < count; ++i)
+    output[i] = input_callback(i);
 
-    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
-  }
+  memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
 
   return curr_pos;
 }
@@ -375,27 +285,12 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
-
   // If volume ramping is disabled, set volume_delta to 0. That way, the
   // mixing loop can avoid testing if volume ramping is enabled at each step,
   // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  AXMixer::GetFunctions().mix_add(out, input, count, &vd->volume, volume_delta, dpop);
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -421,19 +316,16 @@ void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buf
   GetInputSamples(accelerator, pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
 #ifdef AX_GC
-    // signed on GameCube
-    const s32 volume = (s16)pb.vol_env.cur_volume;
+  // signed on GameCube
+  constexpr bool signed_volume = true;
 #else
-    // unsigned on Wii
-    const s32 volume = (u16)pb.vol_env.cur_volume;
+  // unsigned on Wii
+  constexpr bool signed_volume = false;
 #endif
-    const s32 sample = ((s32)samples[i] * volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = static_cast<s16>(AXMixer::GetFunctions().apply_volume(
+      samples, count, static_cast<u16>(pb.vol_env.cur_volume),
+      static_cast<u16>(pb.vol_env.cur_volume_delta), signed_volume));
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
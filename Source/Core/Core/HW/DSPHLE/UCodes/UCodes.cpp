@@ -49,10 +49,9 @@ u8 HLEMemory_Read_U8(Memory::MemoryManager& memory, u32 address)
 
 void HLEMemory_Write_U8(Memory::MemoryManager& memory, u32 address, u8 value)
 {
-  if (ExramRead(address))
-    memory.GetEXRAM()[address & memory.GetExRamMask()] = value;
-  else
-    memory.GetRAM()[address & memory.GetRamMask()] = value;
+  u8* const pointer = static_cast<u8*>(HLEMemory_Get_Pointer(memory, address));
+  *pointer = value;
+  memory.MarkDirty(pointer, sizeof(u8));
 }
 
 u16 HLEMemory_Read_U16LE(Memory::MemoryManager& memory, u32 address)
@@ -74,10 +73,9 @@ u16 HLEMemory_Read_U16(Memory::MemoryManager& memory, u32 address)
 
 void HLEMemory_Write_U16LE(Memory::MemoryManager& memory, u32 address, u16 value)
 {
-  if (ExramRead(address))
-    std::memcpy(&memory.GetEXRAM()[address & memory.GetExRamMask()], &value, sizeof(u16));
-  else
-    std::memcpy(&memory.GetRAM()[address & memory.GetRamMask()], &value, sizeof(u16));
+  u8* const pointer = static_cast<u8*>(HLEMemory_Get_Pointer(memory, address));
+  std::memcpy(pointer, &value, sizeof(u16));
+  memory.MarkDirty(pointer, sizeof(u16));
 }
 
 void HLEMemory_Write_U16(Memory::MemoryManager& memory, u32 address, u16 value)
@@ -104,10 +102,9 @@ u32 HLEMemory_Read_U32(Memory::MemoryManager& memory, u32 address)
 
 void HLEMemory_Write_U32LE(Memory::MemoryManager& memory, u32 address, u32 value)
 {
-  if (ExramRead(address))
-    std::memcpy(&memory.GetEXRAM()[address & memory.GetExRamMask()], &value, sizeof(u32));
-  else
-    std::memcpy(&memory.GetRAM()[address & memory.GetRamMask()], &value, sizeof(u32));
+  u8* const pointer = static_cast<u8*>(HLEMemory_Get_Pointer(memory, address));
+  std::memcpy(pointer, &value, sizeof(u32));
+  memory.MarkDirty(pointer, sizeof(u32));
 }
 
 void HLEMemory_Write_U32(Memory::MemoryManager& memory, u32 address, u32 value)
@@ -16,6 +16,7 @@
 #include "Core/HW/DSPHLE/MailHandler.h"
 #include "Core/HW/DSPHLE/UCodes/GBA.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
+#include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 namespace DSP::HLE
@@ -1129,6 +1130,7 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
       MixingBuffer* buffer = reverb_buffers[rpb_idx];
 
       // Upload the reverb data to RAM.
+      memory.MarkDirty(reinterpret_cast<u8*>(mram_ptr), sizeof(s16) * buffer->size());
       for (auto sample : *buffer)
         *mram_ptr++ = Common::swap16(sample);
 
@@ -1332,6 +1334,9 @@ void ZeldaAudioRenderer::FinalizeFrame()
     ram_left_buffer[i] = Common::swap16(m_buf_front_left[i]);
     ram_right_buffer[i] = Common::swap16(m_buf_front_right[i]);
   }
+  memory.MarkDirty(reinterpret_cast<u8*>(ram_left_buffer), sizeof(u16) * m_buf_front_left.size());
+  memory.MarkDirty(reinterpret_cast<u8*>(ram_right_buffer),
+                   sizeof(u16) * m_buf_front_right.size());
   m_output_lbuf_addr += sizeof(u16) * (u32)m_buf_front_left.size();
   m_output_rbuf_addr += sizeof(u16) * (u32)m_buf_front_right.size();
 
@@ -1376,6 +1381,7 @@ void ZeldaAudioRenderer::StoreVPB(u16 voice_id, VPB* vpb)
   // Only the first 0x80 words are transferred back - the rest is read-only.
   for (size_t i = 0; i < vpb_size - 0x40; ++i)
     ram_vpbs[base_idx + i] = Common::swap16(vpb_words[i]);
+  memory.MarkDirty(reinterpret_cast<u8*>(&ram_vpbs[base_idx]), sizeof(u16) * (vpb_size - 0x40));
 }
 
 void ZeldaAudioRenderer::LoadInputSamples(MixingBuffer* buffer, VPB* vpb)
@@ -525,7 +525,9 @@ void CEXIMemoryCard::DoState(PointerWrap& p)
 void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 {
   auto& memory = m_system.GetMemory();
-  m_memory_card->Read(m_address, size, memory.GetPointer(addr));
+  u8* const pointer = memory.GetPointer(addr);
+  m_memory_card->Read(m_address, size, pointer);
+  memory.MarkDirty(pointer, size);
 
   if ((m_address + size) % Memcard::BLOCK_SIZE == 0)
   {
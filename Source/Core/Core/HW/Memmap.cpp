@@ -12,12 +12,18 @@
 #include <array>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <tuple>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -94,13 +100,15 @@ void MemoryManager::Init()
   m_exram_mask = GetExRamSize() - 1;
 
   m_physical_regions[0] = PhysicalMemoryRegion{
-      &m_ram, 0x00000000, GetRamSize(), PhysicalMemoryRegion::ALWAYS, 0, false};
+      &m_ram, 0x00000000, GetRamSize(), PhysicalMemoryRegion::ALWAYS, 0, false, &m_ram_dirty_pages};
   m_physical_regions[1] = PhysicalMemoryRegion{
-      &m_l1_cache, 0xE0000000, GetL1CacheSize(), PhysicalMemoryRegion::ALWAYS, 0, false};
+      &m_l1_cache, 0xE0000000, GetL1CacheSize(), PhysicalMemoryRegion::ALWAYS, 0, false, nullptr};
   m_physical_regions[2] = PhysicalMemoryRegion{
-      &m_fake_vmem, 0x7E000000, GetFakeVMemSize(), PhysicalMemoryRegion::FAKE_VMEM, 0, false};
+      &m_fake_vmem, 0x7E000000, GetFakeVMemSize(), PhysicalMemoryRegion::FAKE_VMEM, 0, false,
+      &m_fake_vmem_dirty_pages};
   m_physical_regions[3] = PhysicalMemoryRegion{
-      &m_exram, 0x10000000, GetExRamSize(), PhysicalMemoryRegion::WII_ONLY, 0, false};
+      &m_exram, 0x10000000, GetExRamSize(), PhysicalMemoryRegion::WII_ONLY, 0, false,
+      &m_exram_dirty_pages};
 
   const bool wii = m_system.IsWii();
   const bool mmu = m_system.IsMMUMode();
@@ -145,6 +153,15 @@ void MemoryManager::Init()
       const size_t index = (i + region.physical_address) >> PowerPC::BAT_INDEX_SHIFT;
       m_physical_page_mappings[index] = *region.out_pointer + i;
     }
+
+    if (region.dirty_pages)
+    {
+      region.dirty_pages->Init(region.size, [this, &region](u32 first_page, u32 page_count,
+                                                            bool protect) {
+        ProtectPages(region, first_page << Common::DirtyPageBitmap::PAGE_SHIFT,
+                     page_count << Common::DirtyPageBitmap::PAGE_SHIFT, protect);
+      });
+    }
   }
 
   m_physical_page_mappings_base = reinterpret_cast<u8*>(m_physical_page_mappings.data());
@@ -225,6 +242,7 @@ bool MemoryManager::InitFastmemArena()
                     region.physical_address, region.size);
       return false;
     }
+    ProtectView(view, region.physical_address, region.size);
   }
 
   m_is_fastmem_arena_initialized = true;
@@ -278,7 +296,8 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
+            ProtectView(static_cast<u8*>(mapped_pointer), intersection_start, mapped_size);
           }
 
           m_logical_page_mappings[i] =
@@ -327,19 +346,25 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
-  p.DoArray(m_ram, current_ram_size);
+  p.DoMemoryBlock(m_ram, current_ram_size, GetDirtyPages(m_ram_dirty_pages));
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
   if (current_have_fake_vmem)
-    p.DoArray(m_fake_vmem, current_fake_vmem_size);
+    p.DoMemoryBlock(m_fake_vmem, current_fake_vmem_size, GetDirtyPages(m_fake_vmem_dirty_pages));
   p.DoMarker("Memory FakeVMEM");
   if (current_have_exram)
-    p.DoArray(m_exram, current_exram_size);
+    p.DoMemoryBlock(m_exram, current_exram_size, GetDirtyPages(m_exram_dirty_pages));
   p.DoMarker("Memory EXRAM");
 }
 
 void MemoryManager::Shutdown()
 {
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (region.dirty_pages)
+      region.dirty_pages->Shutdown();
+  }
+
   ShutdownFastmemArena();
 
   m_is_initialized = false;
@@ -396,6 +421,12 @@ void MemoryManager::Clear()
     memset(m_fake_vmem, 0, GetFakeVMemSize());
   if (m_exram)
     memset(m_exram, 0, GetExRamSize());
+
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (region.dirty_pages)
+      region.dirty_pages->MarkAllDirty();
+  }
 }
 
 u8* MemoryManager::GetPointerForRange(u32 address, size_t size) const
@@ -444,6 +475,7 @@ void MemoryManager::CopyToEmu(u32 address, const void* data, size_t size)
     return;
   }
   memcpy(pointer, data, size);
+  MarkDirty(static_cast<u8*>(pointer), size);
 }
 
 void MemoryManager::Memset(u32 address, u8 value, size_t size)
@@ -458,6 +490,7 @@ void MemoryManager::Memset(u32 address, u8 value, size_t size)
     return;
   }
   memset(pointer, value, size);
+  MarkDirty(static_cast<u8*>(pointer), size);
 }
 
 std::string MemoryManager::GetString(u32 em_address, size_t size)
@@ -558,4 +591,121 @@ void MemoryManager::Write_U64_Swap(u64 value, u32 address)
   CopyToEmu(address, &value, sizeof(value));
 }
 
+void MemoryManager::MarkDirty(const u8* pointer, size_t size)
+{
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    const u8* base = *region.out_pointer;
+    if (region.dirty_pages && base && pointer >= base && pointer < base + region.size)
+    {
+      region.dirty_pages->MarkDirty(static_cast<u32>(pointer - base), size);
+      return;
+    }
+  }
+}
+
+bool MemoryManager::HandleDirtyPageFault(uintptr_t fault_address)
+{
+  if (!m_is_fastmem_arena_initialized)
+    return false;
+
+  const u8* address = reinterpret_cast<const u8*>(fault_address);
+  std::optional<u32> physical_address;
+  if (address >= m_physical_base && address < m_physical_base + 0x1'0000'0000)
+  {
+    physical_address = static_cast<u32>(address - m_physical_base);
+  }
+  else
+  {
+    for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+    {
+      const u8* view = static_cast<const u8*>(entry.mapped_pointer);
+      if (address >= view && address < view + entry.mapped_size)
+      {
+        physical_address = entry.physical_address + static_cast<u32>(address - view);
+        break;
+      }
+    }
+  }
+  if (!physical_address)
+    return false;
+
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    const u32 offset = *physical_address - region.physical_address;
+    if (region.active && region.dirty_pages && offset < region.size)
+      return region.dirty_pages->OnWriteFault(offset);
+  }
+  return false;
+}
+
+// Returns the dirty pages to pass to DoMemoryBlock, or null if every write can't be tracked
+Common::DirtyPageBitmap*
+MemoryManager::GetDirtyPages(Common::DirtyPageBitmap& dirty_pages) const
+{
+  // IOS writes MEM1 and MEM2 through pointers all over the place
+  if (m_system.IsWii())
+    return nullptr;
+
+  if (m_is_fastmem_arena_initialized)
+  {
+#if defined(_M_ARM_64) && defined(__APPLE__)
+    // Common::WriteProtectMemory can't protect the fastmem views here
+    return nullptr;
+#elif !defined(_WIN32)
+    // The tracked pages must be host pages for the fastmem views to be write protected
+    if (sysconf(_SC_PAGESIZE) != Common::DirtyPageBitmap::PAGE_SIZE)
+      return nullptr;
+#endif
+  }
+
+  return &dirty_pages;
+}
+
+// Changes the write protection of the fastmem views of a range of a physical memory region
+void MemoryManager::ProtectPages(const PhysicalMemoryRegion& region, u32 offset, u32 size,
+                                 bool protect)
+{
+  if (!m_is_fastmem_arena_initialized)
+    return;
+
+  const auto apply = [protect](u8* pointer, u32 length) {
+    if (protect)
+      Common::WriteProtectMemory(pointer, length);
+    else
+      Common::UnWriteProtectMemory(pointer, length);
+  };
+
+  const u32 start = region.physical_address + offset;
+  const u32 end = start + size;
+  apply(m_physical_base + start, size);
+
+  for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+  {
+    const u32 intersection_start = std::max(start, entry.physical_address);
+    const u32 intersection_end = std::min(end, entry.physical_address + entry.mapped_size);
+    if (intersection_start < intersection_end)
+    {
+      apply(static_cast<u8*>(entry.mapped_pointer) + intersection_start - entry.physical_address,
+            intersection_end - intersection_start);
+    }
+  }
+}
+
+// Fastmem views mapped while the pages are tracked must start out write protected. Dirty pages
+// then fault once more, which is harmless.
+void MemoryManager::ProtectView(u8* view, u32 physical_address, u32 size)
+{
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    const u32 offset = physical_address - region.physical_address;
+    if (region.active && region.dirty_pages && region.dirty_pages->IsTracking() &&
+        offset < region.size)
+    {
+      Common::WriteProtectMemory(view, size);
+      return;
+    }
+  }
+}
+
 }  // namespace Memory
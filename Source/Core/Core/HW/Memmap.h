@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/DirtyPageBitmap.h"
 #include "Common/MathUtil.h"
 #include "Common/MemArena.h"
 #include "Common/Swap.h"
@@ -47,12 +48,15 @@ struct PhysicalMemoryRegion
   } flags;
   u32 shm_position;
   bool active;
+  // Null for memory that isn't saved with DoMemoryBlock
+  Common::DirtyPageBitmap* dirty_pages;
 };
 
 struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 class MemoryManager
@@ -121,6 +125,13 @@ public:
   void Write_U32_Swap(u32 var, u32 address);
   void Write_U64_Swap(u64 var, u32 address);
 
+  // Dirty page tracking for incremental snapshots (see State::SnapshotRing). Hardware that writes
+  // RAM through a pointer from GetPointer and the like must report what it wrote with MarkDirty;
+  // the accessors above do it themselves. JIT stores through fastmem are caught by write
+  // protecting the fastmem views, and HandleDirtyPageFault must see those faults first.
+  void MarkDirty(const u8* pointer, size_t size);
+  bool HandleDirtyPageFault(uintptr_t fault_address);
+
   // Templated functions for byteswapped copies.
   template <typename T>
   void CopyFromEmuSwapped(T* data, u32 address, size_t size) const
@@ -144,6 +155,7 @@ public:
 
     for (size_t i = 0; i < size / sizeof(T); i++)
       dest[i] = Common::FromBigEndian(data[i]);
+    MarkDirty(reinterpret_cast<u8*>(dest), size);
   }
 
 private:
@@ -187,6 +199,10 @@ private:
 
   bool m_is_fastmem_arena_initialized = false;
 
+  Common::DirtyPageBitmap m_ram_dirty_pages;
+  Common::DirtyPageBitmap m_exram_dirty_pages;
+  Common::DirtyPageBitmap m_fake_vmem_dirty_pages;
+
   // STATE_TO_SAVE
   // Save the Init(), Shutdown() state
   bool m_is_initialized = false;
@@ -246,5 +262,9 @@ private:
   Core::System& m_system;
 
   void InitMMIO(bool is_wii);
+
+  Common::DirtyPageBitmap* GetDirtyPages(Common::DirtyPageBitmap& dirty_pages) const;
+  void ProtectPages(const PhysicalMemoryRegion& region, u32 offset, u32 size, bool protect);
+  void ProtectView(u8* view, u32 physical_address, u32 size);
 };
 }  // namespace Memory
@@ -396,6 +396,10 @@ public:
   // Create a fake VI mode for a fifolog
   void FakeVIUpdate(u32 xfb_address, u32 fb_width, u32 fb_stride, u32 fb_height);
 
+  // Fields are still emulated but not presented while output is suppressed. Used while NetPlay
+  // rollback simulates frames again that were already shown.
+  void SetOutputSuppressed(bool suppressed) { m_output_suppressed = suppressed; }
+
 private:
   u32 GetHalfLinesPerEvenField() const;
   u32 GetHalfLinesPerOddField() const;
@@ -447,6 +451,9 @@ private:
   u32 m_even_field_last_hl = 0;   // index last halfline of the even field
   u32 m_odd_field_last_hl = 0;    // index last halfline of the odd field
 
+  // Not part of the savestate, only changed on the CPU thread
+  bool m_output_suppressed = false;
+
   Core::System& m_system;
 };
 }  // namespace VideoInterface
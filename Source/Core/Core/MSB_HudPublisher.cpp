@@ -0,0 +1,109 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MSB_HudPublisher.h"
+
+#include <utility>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+
+namespace
+{
+constexpr char HUD_FILE_NAME[] = "decoded.hud.json";
+
+// A keyframe is sent after this many deltas. Two HUD updates are published per pitch.
+constexpr u32 DELTAS_PER_KEYFRAME = 16;
+}  // namespace
+
+HudPublisher::HudPublisher() : m_delta_writer(1024)
+{
+  m_socket.setBlocking(false);
+  m_file_worker.Reset("HUD Writer", [this](FileJob job) { WriteFile(job); });
+  Reset();
+}
+
+HudPublisher::~HudPublisher()
+{
+  m_file_worker.Shutdown();
+}
+
+void HudPublisher::Reset()
+{
+  m_file_enabled = Config::Get(Config::MAIN_HUD_FILE);
+  m_file_path = File::GetUserPath(D_HUDFILES_IDX) + HUD_FILE_NAME;
+
+  const int port = Config::Get(Config::MAIN_HUD_DELTA_PORT);
+  m_delta_port = (port > 0 && port <= 0xFFFF) ? static_cast<u16>(port) : 0;
+  m_force_keyframe = true;
+}
+
+void HudPublisher::PublishFile(std::string json)
+{
+  const u64 generation = m_file_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+  m_file_worker.Push(FileJob{generation, m_file_path, std::move(json)});
+}
+
+void HudPublisher::WriteFile(const FileJob& job)
+{
+  // A newer document is already queued, so this one would be overwritten immediately.
+  if (job.generation != m_file_generation.load(std::memory_order_relaxed))
+    return;
+
+  const std::string temp_path = job.path + ".tmp";
+  if (!File::WriteStringToFile(temp_path, job.json) || !File::Rename(temp_path, job.path))
+    WARN_LOG_FMT(CORE, "Failed to write HUD file {}", job.path);
+}
+
+void HudPublisher::PublishDelta(const HudState& state)
+{
+  const bool keyframe = m_force_keyframe || m_deltas_since_keyframe >= DELTAS_PER_KEYFRAME;
+
+  m_delta_writer.Reset();
+  m_delta_writer.BeginObject();
+  m_delta_writer.Field("Seq", ++m_seq);
+  m_delta_writer.Field("Event Num", state.event_num);
+  m_delta_writer.Field("Keyframe", keyframe);
+
+  bool changed = false;
+  if (keyframe || state.away_player != m_last_state.away_player)
+  {
+    m_delta_writer.Field("Away Player", state.away_player);
+    changed = true;
+  }
+  if (keyframe || state.home_player != m_last_state.home_player)
+  {
+    m_delta_writer.Field("Home Player", state.home_player);
+    changed = true;
+  }
+  for (size_t i = 0; i < HudState::NUM_FIELDS; ++i)
+  {
+    if (!keyframe && state.values[i] == m_last_state.values[i])
+      continue;
+    m_delta_writer.Field(HudState::FIELD_NAMES[i], state.values[i]);
+    changed = true;
+  }
+  m_delta_writer.EndObject();
+
+  // Nothing to tell the overlay if only the event number moved on.
+  if (!changed && state.event_num == m_last_state.event_num)
+  {
+    --m_seq;
+    return;
+  }
+
+  const std::string& datagram = m_delta_writer.GetString();
+  if (m_socket.send(datagram.data(), datagram.size(), sf::IpAddress::LocalHost, m_delta_port) ==
+      sf::Socket::Error)
+  {
+    // Nobody may be listening yet. Keep the state and resend everything next time.
+    m_force_keyframe = true;
+    return;
+  }
+
+  m_last_state = state;
+  m_force_keyframe = false;
+  m_deltas_since_keyframe = keyframe ? 0 : m_deltas_since_keyframe + 1;
+}
@@ -0,0 +1,159 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include <SFML/Network.hpp>
+
+#include "Common/CommonTypes.h"
+#include "Common/JsonWriter.h"
+#include "Common/WorkQueueThread.h"
+
+// The HUD values overlays care about, flattened so consecutive states can be diffed cheaply.
+struct HudState
+{
+  enum Field : u8
+  {
+    INNING,
+    HALF_INNING,
+    AWAY_SCORE,
+    HOME_SCORE,
+    BALLS,
+    STRIKES,
+    OUTS,
+    STAR_CHANCE,
+    AWAY_STARS,
+    HOME_STARS,
+    CHEMISTRY_LINKS_ON_BASE,
+    NUM_OUTS_DURING_PLAY,
+
+    // Runners are the runner's roster location, or -1 if the base is empty
+    RUNNER_1B,
+    RUNNER_2B,
+    RUNNER_3B,
+
+    BATTER_ROSTER_LOC,
+    BATTER_CHAR_ID,
+    BATTER_AT_BATS,
+    BATTER_HITS,
+    BATTER_HOMERUNS,
+    BATTER_RBI,
+    BATTER_STRIKEOUTS,
+
+    PITCHER_ROSTER_LOC,
+    PITCHER_CHAR_ID,
+    PITCHER_STAMINA,
+    PITCHER_PITCHES_THROWN,
+    PITCHER_BATTERS_FACED,
+    PITCHER_STRIKEOUTS,
+    PITCHER_RUNS_ALLOWED,
+
+    // -1 on the first event of the game
+    PREVIOUS_RBI,
+    PREVIOUS_RESULT_OF_AB,
+
+    NUM_FIELDS
+  };
+
+  // Keys match the full HUD JSON where the value exists there.
+  static constexpr std::array<std::string_view, NUM_FIELDS> FIELD_NAMES = {
+      "Inning",
+      "Half Inning",
+      "Away Score",
+      "Home Score",
+      "Balls",
+      "Strikes",
+      "Outs",
+      "Star Chance",
+      "Away Stars",
+      "Home Stars",
+      "Chemistry Links on Base",
+      "Num Outs During Play",
+      "Runner 1B",
+      "Runner 2B",
+      "Runner 3B",
+      "Batter Roster Loc",
+      "Batter Char Id",
+      "Batter At Bats",
+      "Batter Hits",
+      "Batter Homeruns",
+      "Batter RBI",
+      "Batter Strikeouts",
+      "Pitcher Roster Loc",
+      "Pitcher Char Id",
+      "Pitcher Stamina",
+      "Pitcher Pitches Thrown",
+      "Pitcher Batters Faced",
+      "Pitcher Strikeouts",
+      "Pitcher Runs Allowed",
+      "Previous RBI",
+      "Previous Result of AB",
+  };
+
+  std::string event_num;
+  std::string away_player;
+  std::string home_player;
+  std::array<s32, NUM_FIELDS> values{};
+};
+
+// Publishes the StatTracker HUD for stream overlays.
+//
+// Two outputs are available and can be used together:
+// - decoded.hud.json, the full HUD document. It is written on a worker thread to a temporary file
+//   that is then renamed over the old one, so readers never see a partially written file. If the
+//   worker falls behind, only the newest document is written.
+// - HUD deltas, sent as one JSON object per UDP datagram to a port on localhost. Each datagram
+//   only holds the fields that changed since the previous one, plus "Seq" and "Event Num".
+//   Datagrams with "Keyframe": true hold every field; one is sent at the start of every game and
+//   periodically after that, so a listener that joins late or drops a datagram resynchronizes.
+class HudPublisher
+{
+public:
+  HudPublisher();
+  ~HudPublisher();
+
+  HudPublisher(const HudPublisher&) = delete;
+  HudPublisher& operator=(const HudPublisher&) = delete;
+
+  // Rereads the output settings and makes the next delta a keyframe. Called at the start of a game.
+  void Reset();
+
+  bool IsFileEnabled() const { return m_file_enabled; }
+  bool IsDeltaEnabled() const { return m_delta_port != 0; }
+
+  void PublishFile(std::string json);
+  void PublishDelta(const HudState& state);
+
+private:
+  // Carries its own path, so the worker never reads settings that Reset changes
+  struct FileJob
+  {
+    u64 generation;
+    std::string path;
+    std::string json;
+  };
+
+  void WriteFile(const FileJob& job);
+
+  // Only used on the thread calling Reset and Publish*
+  bool m_file_enabled = true;
+  std::string m_file_path;
+  std::atomic<u64> m_file_generation{0};
+
+  u16 m_delta_port = 0;
+  sf::UdpSocket m_socket;
+  HudState m_last_state;
+  u32 m_seq = 0;
+  u32 m_deltas_since_keyframe = 0;
+  bool m_force_keyframe = true;
+  // Reused between deltas so publishing does not allocate.
+  Common::JsonWriter m_delta_writer;
+
+  // Must be last so the worker is stopped before the members it uses are destroyed.
+  Common::WorkQueueThread<FileJob> m_file_worker;
+};
@@ -0,0 +1,1261 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MSB_StatLog.h"
+
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/Crypto/SHA1.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Core/MSB_StatTracker.h"
+
+namespace StatLog
+{
+namespace
+{
+constexpr u32 FILE_MAGIC = 0x4C545352;  // "RSTL"
+
+enum class BlockId : u32
+{
+  Game = 1,
+  Strings = 2,
+  Characters = 3,
+  PositionCounts = 4,
+  Events = 5,
+  Runners = 6,
+  Pitches = 7,
+  PitchCurves = 8,
+  Contacts = 9,
+  Fielders = 10,
+};
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_blocks;
+};
+
+struct BlockHeader
+{
+  BlockId id;
+  u32 num_rows;
+  u32 num_columns;
+  // Size of the block's data following this header, so unknown blocks can be skipped.
+  u32 size;
+};
+
+// Each row type lists its columns once in ForEachColumn. Columns must only ever be appended.
+
+struct GameRow
+{
+  u32 game_id;
+  u8 team0_port;
+  u8 team1_port;
+  u8 away_port;
+  u8 home_port;
+  u8 team0_captain_roster_loc;
+  u8 team1_captain_roster_loc;
+  s32 avg_ping;
+  s32 lag_spikes;
+  u16 away_score;
+  u16 home_score;
+  u8 stadium;
+  u8 innings_selected;
+  u8 innings_played;
+  u8 netplay;
+  u8 has_tag_set_id;
+  s32 tag_set_id;
+  u8 quitter_team;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&GameRow::game_id);
+    f(&GameRow::team0_port);
+    f(&GameRow::team1_port);
+    f(&GameRow::away_port);
+    f(&GameRow::home_port);
+    f(&GameRow::team0_captain_roster_loc);
+    f(&GameRow::team1_captain_roster_loc);
+    f(&GameRow::avg_ping);
+    f(&GameRow::lag_spikes);
+    f(&GameRow::away_score);
+    f(&GameRow::home_score);
+    f(&GameRow::stadium);
+    f(&GameRow::innings_selected);
+    f(&GameRow::innings_played);
+    f(&GameRow::netplay);
+    f(&GameRow::has_tag_set_id);
+    f(&GameRow::tag_set_id);
+    f(&GameRow::quitter_team);
+  }
+};
+
+// Order of the entries in the Strings block.
+enum StringIndex : u32
+{
+  START_LOCAL_DATE_TIME,
+  START_UNIX_DATE_TIME,
+  END_LOCAL_DATE_TIME,
+  END_UNIX_DATE_TIME,
+  TEAM0_USERNAME,
+  TEAM0_USERID_HASH,
+  TEAM1_USERNAME,
+  TEAM1_USERID_HASH,
+  NETPLAY_OPPONENT_ALIAS,
+  VERSION,
+  NUM_STRINGS
+};
+
+struct CharacterRow
+{
+  u8 team;
+  u8 roster;
+  u8 char_id;
+  u8 is_starred;
+  u8 fielding_hand;
+  u8 batting_hand;
+
+  u8 batters_faced;
+  u16 runs_allowed;
+  u16 earned_runs;
+  u16 batters_walked;
+  u16 batters_hit;
+  u16 hits_allowed;
+  u16 homeruns_allowed;
+  u16 pitches_thrown;
+  u16 stamina;
+  u8 was_pitcher;
+  u8 outs_pitched;
+  u8 batter_outs;
+  u8 strike_outs;
+  u8 star_pitches_thrown;
+  u8 big_plays;
+
+  u8 at_bats;
+  u8 hits;
+  u8 singles;
+  u8 doubles;
+  u8 triples;
+  u8 homeruns;
+  u8 sac_flys;
+  u8 successful_bunts;
+  u8 strikouts;
+  u8 walks_4balls;
+  u8 walks_hit;
+  u8 rbi;
+  u8 bases_stolen;
+  u8 star_hits;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&CharacterRow::team);
+    f(&CharacterRow::roster);
+    f(&CharacterRow::char_id);
+    f(&CharacterRow::is_starred);
+    f(&CharacterRow::fielding_hand);
+    f(&CharacterRow::batting_hand);
+    f(&CharacterRow::batters_faced);
+    f(&CharacterRow::runs_allowed);
+    f(&CharacterRow::earned_runs);
+    f(&CharacterRow::batters_walked);
+    f(&CharacterRow::batters_hit);
+    f(&CharacterRow::hits_allowed);
+    f(&CharacterRow::homeruns_allowed);
+    f(&CharacterRow::pitches_thrown);
+    f(&CharacterRow::stamina);
+    f(&CharacterRow::was_pitcher);
+    f(&CharacterRow::outs_pitched);
+    f(&CharacterRow::batter_outs);
+    f(&CharacterRow::strike_outs);
+    f(&CharacterRow::star_pitches_thrown);
+    f(&CharacterRow::big_plays);
+    f(&CharacterRow::at_bats);
+    f(&CharacterRow::hits);
+    f(&CharacterRow::singles);
+    f(&CharacterRow::doubles);
+    f(&CharacterRow::triples);
+    f(&CharacterRow::homeruns);
+    f(&CharacterRow::sac_flys);
+    f(&CharacterRow::successful_bunts);
+    f(&CharacterRow::strikouts);
+    f(&CharacterRow::walks_4balls);
+    f(&CharacterRow::walks_hit);
+    f(&CharacterRow::rbi);
+    f(&CharacterRow::bases_stolen);
+    f(&CharacterRow::star_hits);
+  }
+};
+
+// Only positions with a non-zero count are stored.
+struct PositionCountRow
+{
+  u8 team;
+  u8 roster;
+  u8 position;
+  s32 batters;
+  s32 batter_outs;
+  s32 outs;
+  s32 pitches;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&PositionCountRow::team);
+    f(&PositionCountRow::roster);
+    f(&PositionCountRow::position);
+    f(&PositionCountRow::batters);
+    f(&PositionCountRow::batter_outs);
+    f(&PositionCountRow::outs);
+    f(&PositionCountRow::pitches);
+  }
+};
+
+struct EventRow
+{
+  u16 event_num;
+  u8 inning;
+  u8 half_inning;
+  u16 away_score;
+  u16 home_score;
+  u8 is_star_chance;
+  u8 away_stars;
+  u8 home_stars;
+  u8 chem_links_ob;
+  u16 pitcher_stamina;
+  u8 pitcher_roster_loc;
+  u8 batter_roster_loc;
+  u8 catcher_roster_loc;
+  u8 balls;
+  u8 strikes;
+  u8 outs;
+  u8 num_outs_during_play;
+  u8 rbi;
+  u8 result_of_atbat;
+  u8 pick_off_attempt;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&EventRow::event_num);
+    f(&EventRow::inning);
+    f(&EventRow::half_inning);
+    f(&EventRow::away_score);
+    f(&EventRow::home_score);
+    f(&EventRow::is_star_chance);
+    f(&EventRow::away_stars);
+    f(&EventRow::home_stars);
+    f(&EventRow::chem_links_ob);
+    f(&EventRow::pitcher_stamina);
+    f(&EventRow::pitcher_roster_loc);
+    f(&EventRow::batter_roster_loc);
+    f(&EventRow::catcher_roster_loc);
+    f(&EventRow::balls);
+    f(&EventRow::strikes);
+    f(&EventRow::outs);
+    f(&EventRow::num_outs_during_play);
+    f(&EventRow::rbi);
+    f(&EventRow::result_of_atbat);
+    f(&EventRow::pick_off_attempt);
+  }
+};
+
+enum RunnerSlot : u8
+{
+  RUNNER_BATTER,
+  RUNNER_1B,
+  RUNNER_2B,
+  RUNNER_3B,
+};
+
+struct RunnerRow
+{
+  u16 event_num;
+  u8 slot;
+  u8 roster_loc;
+  u8 char_id;
+  u8 initial_base;
+  u8 out_type;
+  u8 out_location;
+  u8 result_base;
+  u8 steal;
+  u32 basepath_location;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&RunnerRow::event_num);
+    f(&RunnerRow::slot);
+    f(&RunnerRow::roster_loc);
+    f(&RunnerRow::char_id);
+    f(&RunnerRow::initial_base);
+    f(&RunnerRow::out_type);
+    f(&RunnerRow::out_location);
+    f(&RunnerRow::result_base);
+    f(&RunnerRow::steal);
+    f(&RunnerRow::basepath_location);
+  }
+};
+
+struct PitchRow
+{
+  u16 event_num;
+  u8 logged;
+  u8 pitcher_team_id;
+  u8 pitcher_char_id;
+  u8 pitch_type;
+  u8 charge_type;
+  u32 charge_up;
+  u8 star_pitch;
+  u8 pitch_speed;
+  u8 batter_roster_loc;
+  u8 batter_id;
+  u32 ball_z_strike_vs_ball;
+  u8 ball_in_strikezone;
+  u32 pitch_target_x_pos;
+  u32 pitch_release_x_pos;
+  u32 pitch_release_y_pos;
+  u32 pitch_release_z_pos;
+  u32 bat_contact_x_pos;
+  u32 bat_contact_z_pos;
+  u8 db;
+  u8 potential_db;
+  u8 pitch_result;
+  u8 type_of_swing;
+  // Number of consecutive rows this pitch owns in the PitchCurves block.
+  u32 num_curve_frames;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&PitchRow::event_num);
+    f(&PitchRow::logged);
+    f(&PitchRow::pitcher_team_id);
+    f(&PitchRow::pitcher_char_id);
+    f(&PitchRow::pitch_type);
+    f(&PitchRow::charge_type);
+    f(&PitchRow::charge_up);
+    f(&PitchRow::star_pitch);
+    f(&PitchRow::pitch_speed);
+    f(&PitchRow::batter_roster_loc);
+    f(&PitchRow::batter_id);
+    f(&PitchRow::ball_z_strike_vs_ball);
+    f(&PitchRow::ball_in_strikezone);
+    f(&PitchRow::pitch_target_x_pos);
+    f(&PitchRow::pitch_release_x_pos);
+    f(&PitchRow::pitch_release_y_pos);
+    f(&PitchRow::pitch_release_z_pos);
+    f(&PitchRow::bat_contact_x_pos);
+    f(&PitchRow::bat_contact_z_pos);
+    f(&PitchRow::db);
+    f(&PitchRow::potential_db);
+    f(&PitchRow::pitch_result);
+    f(&PitchRow::type_of_swing);
+    f(&PitchRow::num_curve_frames);
+  }
+};
+
+struct PitchCurveRow
+{
+  u32 curve_velocity;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&PitchCurveRow::curve_velocity);
+  }
+};
+
+struct ContactRow
+{
+  u16 event_num;
+  u16 power;
+  u16 vert_angle;
+  u16 horiz_angle;
+  u32 ball_x_velo;
+  u32 ball_y_velo;
+  u32 ball_z_velo;
+  u32 ball_contact_x_pos;
+  u32 ball_contact_z_pos;
+  u32 contact_absolute;
+  u32 contact_quality;
+  u16 rng1;
+  u16 rng2;
+  u16 rng3;
+  u8 type_of_contact;
+  u8 moon_shot;
+  u32 charge_power_up;
+  u32 charge_power_down;
+  u8 input_direction_stick;
+  u8 input_direction_push_pull;
+  u16 frame_of_swing;
+  u32 ball_x_pos;
+  u32 ball_y_pos;
+  u32 ball_z_pos;
+  u32 ball_max_height;
+  u16 ball_hang_time;
+  u8 primary_contact_result;
+  u8 secondary_contact_result;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&ContactRow::event_num);
+    f(&ContactRow::power);
+    f(&ContactRow::vert_angle);
+    f(&ContactRow::horiz_angle);
+    f(&ContactRow::ball_x_velo);
+    f(&ContactRow::ball_y_velo);
+    f(&ContactRow::ball_z_velo);
+    f(&ContactRow::ball_contact_x_pos);
+    f(&ContactRow::ball_contact_z_pos);
+    f(&ContactRow::contact_absolute);
+    f(&ContactRow::contact_quality);
+    f(&ContactRow::rng1);
+    f(&ContactRow::rng2);
+    f(&ContactRow::rng3);
+    f(&ContactRow::type_of_contact);
+    f(&ContactRow::moon_shot);
+    f(&ContactRow::charge_power_up);
+    f(&ContactRow::charge_power_down);
+    f(&ContactRow::input_direction_stick);
+    f(&ContactRow::input_direction_push_pull);
+    f(&ContactRow::frame_of_swing);
+    f(&ContactRow::ball_x_pos);
+    f(&ContactRow::ball_y_pos);
+    f(&ContactRow::ball_z_pos);
+    f(&ContactRow::ball_max_height);
+    f(&ContactRow::ball_hang_time);
+    f(&ContactRow::primary_contact_result);
+    f(&ContactRow::secondary_contact_result);
+  }
+};
+
+enum FielderRole : u8
+{
+  FIELDER_FIRST,
+  FIELDER_COLLECT,
+};
+
+struct FielderRow
+{
+  u16 event_num;
+  u8 role;
+  u8 fielder_roster_loc;
+  u8 fielder_pos;
+  u8 fielder_char_id;
+  u8 fielder_swapped_for_batter;
+  u8 fielder_action;
+  u8 fielder_jump;
+  u8 fielder_manual_select_arg;
+  u32 fielder_x_pos;
+  u32 fielder_y_pos;
+  u32 fielder_z_pos;
+  u8 bobble;
+
+  template <typename F>
+  static void ForEachColumn(F&& f)
+  {
+    f(&FielderRow::event_num);
+    f(&FielderRow::role);
+    f(&FielderRow::fielder_roster_loc);
+    f(&FielderRow::fielder_pos);
+    f(&FielderRow::fielder_char_id);
+    f(&FielderRow::fielder_swapped_for_batter);
+    f(&FielderRow::fielder_action);
+    f(&FielderRow::fielder_jump);
+    f(&FielderRow::fielder_manual_select_arg);
+    f(&FielderRow::fielder_x_pos);
+    f(&FielderRow::fielder_y_pos);
+    f(&FielderRow::fielder_z_pos);
+    f(&FielderRow::bobble);
+  }
+};
+
+template <typename T>
+T GetTracked(const TrackerValue<T>& tracked)
+{
+  return tracked.value.value_or(tracked.default_value);
+}
+
+template <typename T>
+void AppendValue(std::vector<u8>& out, T value)
+{
+  // Dolphin only runs on little-endian hosts, so values are stored as they are in memory.
+  const size_t offset = out.size();
+  out.resize(offset + sizeof(T));
+  std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+class BlockWriter
+{
+public:
+  template <typename Row>
+  void AddTable(BlockId id, const std::vector<Row>& rows)
+  {
+    std::vector<u8> data;
+    u32 num_columns = 0;
+    Row::ForEachColumn([&](auto member) {
+      ++num_columns;
+      for (const Row& row : rows)
+        AppendValue(data, row.*member);
+    });
+    AddBlock(id, static_cast<u32>(rows.size()), num_columns, data);
+  }
+
+  void AddStrings(const std::vector<std::string>& strings)
+  {
+    std::vector<u8> data;
+    for (const std::string& str : strings)
+    {
+      AppendValue(data, static_cast<u32>(str.size()));
+      data.insert(data.end(), str.begin(), str.end());
+    }
+    AddBlock(BlockId::Strings, static_cast<u32>(strings.size()), 1, data);
+  }
+
+  bool WriteTo(const std::string& path) const
+  {
+    std::vector<u8> header;
+    AppendValue(header, FILE_MAGIC);
+    AppendValue(header, FORMAT_VERSION);
+    AppendValue(header, m_num_blocks);
+
+    File::IOFile file(path, "wb");
+    return file.WriteBytes(header.data(), header.size()) &&
+           file.WriteBytes(m_data.data(), m_data.size());
+  }
+
+private:
+  void AddBlock(BlockId id, u32 num_rows, u32 num_columns, const std::vector<u8>& data)
+  {
+    AppendValue(m_data, static_cast<u32>(id));
+    AppendValue(m_data, num_rows);
+    AppendValue(m_data, num_columns);
+    AppendValue(m_data, static_cast<u32>(data.size()));
+    m_data.insert(m_data.end(), data.begin(), data.end());
+    ++m_num_blocks;
+  }
+
+  std::vector<u8> m_data;
+  u32 m_num_blocks = 0;
+};
+
+class BlockReader
+{
+public:
+  explicit BlockReader(std::vector<u8> data) : m_data(std::move(data)) {}
+
+  template <typename T>
+  bool Read(T* value)
+  {
+    if (m_data.size() - m_offset < sizeof(T))
+      return false;
+    std::memcpy(value, m_data.data() + m_offset, sizeof(T));
+    m_offset += sizeof(T);
+    return true;
+  }
+
+  bool ReadBlockHeader(BlockHeader* header)
+  {
+    u32 id;
+    if (!Read(&id) || !Read(&header->num_rows) || !Read(&header->num_columns) ||
+        !Read(&header->size) || m_data.size() - m_offset < header->size)
+    {
+      return false;
+    }
+    header->id = static_cast<BlockId>(id);
+    return true;
+  }
+
+  void Skip(u32 size) { m_offset += size; }
+
+  template <typename Row>
+  bool ReadTable(const BlockHeader& header, std::vector<Row>* rows)
+  {
+    const size_t block_end = m_offset + header.size;
+
+    // Every stored column takes at least a byte per row, so the row count can be checked against
+    // the block size before anything is allocated
+    u64 row_size = 0;
+    u32 known_columns = 0;
+    Row::ForEachColumn([&](auto member) {
+      if (known_columns++ < header.num_columns)
+        row_size += sizeof(std::declval<Row>().*member);
+    });
+    if (header.num_columns > known_columns)
+      row_size += header.num_columns - known_columns;
+    if (header.num_rows != 0 && (row_size == 0 || u64{header.num_rows} * row_size > header.size))
+      return false;
+
+    rows->assign(header.num_rows, Row{});
+
+    u32 column = 0;
+    bool ok = true;
+    Row::ForEachColumn([&](auto member) {
+      // Older logs may not have the newest columns; leave them zeroed.
+      if (!ok || column++ >= header.num_columns)
+        return;
+      for (Row& row : *rows)
+        ok &= Read(&(row.*member));
+    });
+
+    // Skip columns added by newer versions.
+    if (!ok || m_offset > block_end)
+      return false;
+    m_offset = block_end;
+    return true;
+  }
+
+  bool ReadStrings(const BlockHeader& header, std::vector<std::string>* strings)
+  {
+    const size_t block_end = m_offset + header.size;
+    strings->clear();
+    for (u32 i = 0; i < header.num_rows; ++i)
+    {
+      u32 size;
+      if (!Read(&size) || m_offset > block_end || block_end - m_offset < size)
+        return false;
+      strings->emplace_back(reinterpret_cast<const char*>(m_data.data() + m_offset), size);
+      m_offset += size;
+    }
+    m_offset = block_end;
+    return true;
+  }
+
+private:
+  std::vector<u8> m_data;
+  size_t m_offset = 0;
+};
+
+// The user id is the player's rio key, which authenticates their submissions, so logs only keep a
+// one-way hash of it. That still tells players apart across logs. "CPU" marks computer teams and
+// is kept as is.
+std::string HashUserID(const std::string& userid)
+{
+  if (userid.empty() || userid == "CPU")
+    return userid;
+  return Common::BytesToHexString(Common::SHA1::CalculateDigest(userid));
+}
+
+RunnerRow MakeRunnerRow(u16 event_num, RunnerSlot slot, const StatTracker::Runner& runner)
+{
+  return {event_num,           slot,         runner.roster_loc,  runner.char_id,
+          runner.initial_base, runner.out_type, runner.out_location, runner.result_base,
+          runner.steal,        runner.basepath_location};
+}
+
+FielderRow MakeFielderRow(u16 event_num, FielderRole role, const StatTracker::Fielder& fielder)
+{
+  return {event_num,
+          role,
+          fielder.fielder_roster_loc,
+          fielder.fielder_pos,
+          fielder.fielder_char_id,
+          fielder.fielder_swapped_for_batter,
+          fielder.fielder_action,
+          fielder.fielder_jump,
+          fielder.fielder_manual_select_arg,
+          fielder.fielder_x_pos,
+          fielder.fielder_y_pos,
+          fielder.fielder_z_pos,
+          fielder.bobble};
+}
+
+StatTracker::Fielder ToFielder(const FielderRow& row)
+{
+  StatTracker::Fielder fielder;
+  fielder.fielder_roster_loc = row.fielder_roster_loc;
+  fielder.fielder_pos = row.fielder_pos;
+  fielder.fielder_char_id = row.fielder_char_id;
+  fielder.fielder_swapped_for_batter = row.fielder_swapped_for_batter;
+  fielder.fielder_action = row.fielder_action;
+  fielder.fielder_jump = row.fielder_jump;
+  fielder.fielder_manual_select_arg = row.fielder_manual_select_arg;
+  fielder.fielder_x_pos = row.fielder_x_pos;
+  fielder.fielder_y_pos = row.fielder_y_pos;
+  fielder.fielder_z_pos = row.fielder_z_pos;
+  fielder.bobble = row.bobble;
+  return fielder;
+}
+}  // namespace
+
+bool Write(const std::string& path, const StatTracker& tracker)
+{
+  const StatTracker::GameInfo& info = tracker.m_game_info;
+  BlockWriter writer;
+
+  const GameRow game{info.game_id,
+                     info.team0_port,
+                     info.team1_port,
+                     info.away_port,
+                     info.home_port,
+                     info.team0_captain_roster_loc,
+                     info.team1_captain_roster_loc,
+                     info.avg_ping,
+                     info.lag_spikes,
+                     info.away_score,
+                     info.home_score,
+                     info.stadium,
+                     info.innings_selected,
+                     info.innings_played,
+                     info.netplay,
+                     info.tag_set_id.has_value(),
+                     info.tag_set_id.value_or(0),
+                     info.quitter_team};
+  writer.AddTable(BlockId::Game, std::vector<GameRow>{game});
+
+  std::vector<std::string> strings(NUM_STRINGS);
+  strings[START_LOCAL_DATE_TIME] = info.start_local_date_time;
+  strings[START_UNIX_DATE_TIME] = info.start_unix_date_time;
+  strings[END_LOCAL_DATE_TIME] = info.end_local_date_time;
+  strings[END_UNIX_DATE_TIME] = info.end_unix_date_time;
+  strings[TEAM0_USERNAME] = info.team0_player.username;
+  strings[TEAM0_USERID_HASH] = HashUserID(info.team0_player.userid);
+  strings[TEAM1_USERNAME] = info.team1_player.username;
+  strings[TEAM1_USERID_HASH] = HashUserID(info.team1_player.userid);
+  strings[NETPLAY_OPPONENT_ALIAS] = info.netplay_opponent_alias;
+  strings[VERSION] = info.version;
+  writer.AddStrings(strings);
+
+  std::vector<CharacterRow> characters;
+  std::vector<PositionCountRow> position_counts;
+  for (u8 team = 0; team < cNumOfTeams; ++team)
+  {
+    for (u8 roster = 0; roster < cRosterSize; ++roster)
+    {
+      const StatTracker::CharacterSummary& summary = info.character_summaries[team][roster];
+      const auto& def = summary.end_game_defensive_stats;
+      const auto& off = summary.end_game_offensive_stats;
+      characters.push_back({team,
+                            roster,
+                            summary.char_id,
+                            summary.is_starred,
+                            summary.fielding_hand,
+                            summary.batting_hand,
+                            def.batters_faced,
+                            def.runs_allowed,
+                            def.earned_runs,
+                            def.batters_walked,
+                            def.batters_hit,
+                            def.hits_allowed,
+                            def.homeruns_allowed,
+                            def.pitches_thrown,
+                            def.stamina,
+                            def.was_pitcher,
+                            def.outs_pitched,
+                            def.batter_outs,
+                            def.strike_outs,
+                            def.star_pitches_thrown,
+                            def.big_plays,
+                            off.at_bats,
+                            off.hits,
+                            off.singles,
+                            off.doubles,
+                            off.triples,
+                            off.homeruns,
+                            off.sac_flys,
+                            off.successful_bunts,
+                            off.strikouts,
+                            off.walks_4balls,
+                            off.walks_hit,
+                            off.rbi,
+                            off.bases_stolen,
+                            off.star_hits});
+
+      const auto fielder_info = tracker.m_fielder_tracker[team].fielder_map.find(roster);
+      if (fielder_info == tracker.m_fielder_tracker[team].fielder_map.end())
+        continue;
+      const StatTracker::FielderInfo& counts = fielder_info->second;
+      for (u8 pos = 0; pos < cNumOfPositions; ++pos)
+      {
+        if (counts.batter_count_by_position[pos] == 0 && counts.batter_outs_by_position[pos] == 0 &&
+            counts.out_count_by_position[pos] == 0 && counts.pitch_count_by_position[pos] == 0)
+        {
+          continue;
+        }
+        position_counts.push_back({team, roster, pos, counts.batter_count_by_position[pos],
+                                   counts.batter_outs_by_position[pos],
+                                   counts.out_count_by_position[pos],
+                                   counts.pitch_count_by_position[pos]});
+      }
+    }
+  }
+  writer.AddTable(BlockId::Characters, characters);
+  writer.AddTable(BlockId::PositionCounts, position_counts);
+
+  std::vector<EventRow> events;
+  std::vector<RunnerRow> runners;
+  std::vector<PitchRow> pitches;
+  std::vector<PitchCurveRow> pitch_curves;
+  std::vector<ContactRow> contacts;
+  std::vector<FielderRow> fielders;
+  events.reserve(info.events.size());
+  pitches.reserve(info.events.size());
+
+  for (const auto& [event_num, event] : info.events)
+  {
+    events.push_back({event_num,
+                      event.inning,
+                      event.half_inning,
+                      event.away_score,
+                      event.home_score,
+                      event.is_star_chance,
+                      event.away_stars,
+                      event.home_stars,
+                      event.chem_links_ob,
+                      event.pitcher_stamina,
+                      event.pitcher_roster_loc,
+                      event.batter_roster_loc,
+                      event.catcher_roster_loc,
+                      event.balls,
+                      event.strikes,
+                      event.outs,
+                      GetTracked(event.num_outs_during_play),
+                      event.rbi,
+                      event.result_of_atbat,
+                      event.pick_off_attempt});
+
+    if (event.runner_batter)
+      runners.push_back(MakeRunnerRow(event_num, RUNNER_BATTER, *event.runner_batter));
+    if (event.runner_1)
+      runners.push_back(MakeRunnerRow(event_num, RUNNER_1B, *event.runner_1));
+    if (event.runner_2)
+      runners.push_back(MakeRunnerRow(event_num, RUNNER_2B, *event.runner_2));
+    if (event.runner_3)
+      runners.push_back(MakeRunnerRow(event_num, RUNNER_3B, *event.runner_3));
+
+    if (!event.pitch)
+      continue;
+
+    const StatTracker::Pitch& pitch = *event.pitch;
+    pitches.push_back({event_num,
+                       pitch.logged,
+                       pitch.pitcher_team_id,
+                       pitch.pitcher_char_id,
+                       pitch.pitch_type,
+                       pitch.charge_type,
+                       GetTracked(pitch.charge_up),
+                       pitch.star_pitch,
+                       pitch.pitch_speed,
+                       pitch.batter_roster_loc,
+                       pitch.batter_id,
+                       pitch.ball_z_strike_vs_ball,
+                       pitch.ball_in_strikezone,
+                       GetTracked(pitch.pitch_target_x_pos),
+                       GetTracked(pitch.pitch_release_x_pos),
+                       GetTracked(pitch.pitch_release_y_pos),
+                       GetTracked(pitch.pitch_release_z_pos),
+                       GetTracked(pitch.bat_contact_x_pos),
+                       GetTracked(pitch.bat_contact_z_pos),
+                       pitch.db,
+                       pitch.potential_db,
+                       pitch.pitch_result,
+                       pitch.type_of_swing,
+                       static_cast<u32>(pitch.pitch_curve.size())});
+    for (const StatTracker::PitchCurve& curve : pitch.pitch_curve)
+      pitch_curves.push_back({curve.curve_velocity});
+
+    if (!pitch.contact)
+      continue;
+
+    const StatTracker::Contact& contact = *pitch.contact;
+    contacts.push_back({event_num,
+                        GetTracked(contact.power),
+                        GetTracked(contact.vert_angle),
+                        GetTracked(contact.horiz_angle),
+                        GetTracked(contact.ball_x_velo),
+                        GetTracked(contact.ball_y_velo),
+                        GetTracked(contact.ball_z_velo),
+                        GetTracked(contact.ball_contact_x_pos),
+                        GetTracked(contact.ball_contact_z_pos),
+                        GetTracked(contact.contact_absolute),
+                        GetTracked(contact.contact_quality),
+                        GetTracked(contact.rng1),
+                        GetTracked(contact.rng2),
+                        GetTracked(contact.rng3),
+                        GetTracked(contact.type_of_contact),
+                        GetTracked(contact.moon_shot),
+                        GetTracked(contact.charge_power_up),
+                        GetTracked(contact.charge_power_down),
+                        GetTracked(contact.input_direction_stick),
+                        GetTracked(contact.input_direction_push_pull),
+                        GetTracked(contact.frame_of_swing),
+                        GetTracked(contact.ball_x_pos),
+                        GetTracked(contact.ball_y_pos),
+                        GetTracked(contact.ball_z_pos),
+                        GetTracked(contact.ball_max_height),
+                        GetTracked(contact.ball_hang_time),
+                        contact.primary_contact_result,
+                        contact.secondary_contact_result});
+
+    if (contact.first_fielder)
+      fielders.push_back(MakeFielderRow(event_num, FIELDER_FIRST, *contact.first_fielder));
+    if (contact.collect_fielder)
+      fielders.push_back(MakeFielderRow(event_num, FIELDER_COLLECT, *contact.collect_fielder));
+  }
+
+  writer.AddTable(BlockId::Events, events);
+  writer.AddTable(BlockId::Runners, runners);
+  writer.AddTable(BlockId::Pitches, pitches);
+  writer.AddTable(BlockId::PitchCurves, pitch_curves);
+  writer.AddTable(BlockId::Contacts, contacts);
+  writer.AddTable(BlockId::Fielders, fielders);
+
+  if (!writer.WriteTo(path))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write stat log {}", path);
+    return false;
+  }
+  return true;
+}
+
+bool Read(const std::string& path, StatTracker& tracker)
+{
+  std::vector<u8> data;
+  {
+    File::IOFile file(path, "rb");
+    data.resize(file.GetSize());
+    if (!file || !file.ReadBytes(data.data(), data.size()))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to read stat log {}", path);
+      return false;
+    }
+  }
+
+  BlockReader reader(std::move(data));
+  FileHeader header;
+  if (!reader.Read(&header.magic) || !reader.Read(&header.version) ||
+      !reader.Read(&header.num_blocks) || header.magic != FILE_MAGIC)
+  {
+    ERROR_LOG_FMT(CORE, "{} is not a stat log", path);
+    return false;
+  }
+  if (header.version > FORMAT_VERSION)
+  {
+    WARN_LOG_FMT(CORE, "Stat log {} has version {}, newer than {}. Unknown data is skipped.", path,
+                 header.version, FORMAT_VERSION);
+  }
+
+  std::vector<GameRow> game;
+  std::vector<std::string> strings;
+  std::vector<CharacterRow> characters;
+  std::vector<PositionCountRow> position_counts;
+  std::vector<EventRow> events;
+  std::vector<RunnerRow> runners;
+  std::vector<PitchRow> pitches;
+  std::vector<PitchCurveRow> pitch_curves;
+  std::vector<ContactRow> contacts;
+  std::vector<FielderRow> fielders;
+
+  for (u32 i = 0; i < header.num_blocks; ++i)
+  {
+    BlockHeader block;
+    if (!reader.ReadBlockHeader(&block))
+      return false;
+
+    bool ok = true;
+    switch (block.id)
+    {
+    case BlockId::Game:
+      ok = reader.ReadTable(block, &game);
+      break;
+    case BlockId::Strings:
+      ok = reader.ReadStrings(block, &strings);
+      break;
+    case BlockId::Characters:
+      ok = reader.ReadTable(block, &characters);
+      break;
+    case BlockId::PositionCounts:
+      ok = reader.ReadTable(block, &position_counts);
+      break;
+    case BlockId::Events:
+      ok = reader.ReadTable(block, &events);
+      break;
+    case BlockId::Runners:
+      ok = reader.ReadTable(block, &runners);
+      break;
+    case BlockId::Pitches:
+      ok = reader.ReadTable(block, &pitches);
+      break;
+    case BlockId::PitchCurves:
+      ok = reader.ReadTable(block, &pitch_curves);
+      break;
+    case BlockId::Contacts:
+      ok = reader.ReadTable(block, &contacts);
+      break;
+    case BlockId::Fielders:
+      ok = reader.ReadTable(block, &fielders);
+      break;
+    default:
+      reader.Skip(block.size);
+      break;
+    }
+
+    if (!ok)
+    {
+      ERROR_LOG_FMT(CORE, "Stat log {} is corrupt (block {})", path, static_cast<u32>(block.id));
+      return false;
+    }
+  }
+
+  if (game.size() != 1)
+  {
+    ERROR_LOG_FMT(CORE, "Stat log {} has no game info", path);
+    return false;
+  }
+  strings.resize(NUM_STRINGS);
+
+  // Not init(), which would also start the uploader
+  tracker.m_game_info = StatTracker::GameInfo();
+  tracker.m_fielder_tracker = {};
+  StatTracker::GameInfo& info = tracker.m_game_info;
+  const GameRow& game_row = game.front();
+  info.game_id = game_row.game_id;
+  info.team0_port = game_row.team0_port;
+  info.team1_port = game_row.team1_port;
+  info.away_port = game_row.away_port;
+  info.home_port = game_row.home_port;
+  info.team0_captain_roster_loc = game_row.team0_captain_roster_loc;
+  info.team1_captain_roster_loc = game_row.team1_captain_roster_loc;
+  info.avg_ping = game_row.avg_ping;
+  info.lag_spikes = game_row.lag_spikes;
+  info.away_score = game_row.away_score;
+  info.home_score = game_row.home_score;
+  info.stadium = game_row.stadium;
+  info.innings_selected = game_row.innings_selected;
+  info.innings_played = game_row.innings_played;
+  info.netplay = game_row.netplay != 0;
+  if (game_row.has_tag_set_id)
+    info.tag_set_id = game_row.tag_set_id;
+  info.quitter_team = game_row.quitter_team;
+
+  info.start_local_date_time = strings[START_LOCAL_DATE_TIME];
+  info.start_unix_date_time = strings[START_UNIX_DATE_TIME];
+  info.end_local_date_time = strings[END_LOCAL_DATE_TIME];
+  info.end_unix_date_time = strings[END_UNIX_DATE_TIME];
+  info.team0_player.username = strings[TEAM0_USERNAME];
+  info.team0_player.userid = strings[TEAM0_USERID_HASH];
+  info.team1_player.username = strings[TEAM1_USERNAME];
+  info.team1_player.userid = strings[TEAM1_USERID_HASH];
+  info.netplay_opponent_alias = strings[NETPLAY_OPPONENT_ALIAS];
+  info.version = strings[VERSION];
+
+  for (const CharacterRow& row : characters)
+  {
+    if (row.team >= cNumOfTeams || row.roster >= cRosterSize)
+      continue;
+    StatTracker::CharacterSummary& summary = info.character_summaries[row.team][row.roster];
+    summary.team_id = row.team;
+    summary.roster_id = row.roster;
+    summary.char_id = row.char_id;
+    summary.is_starred = row.is_starred;
+    summary.fielding_hand = row.fielding_hand;
+    summary.batting_hand = row.batting_hand;
+
+    auto& def = summary.end_game_defensive_stats;
+    def.batters_faced = row.batters_faced;
+    def.runs_allowed = row.runs_allowed;
+    def.earned_runs = row.earned_runs;
+    def.batters_walked = row.batters_walked;
+    def.batters_hit = row.batters_hit;
+    def.hits_allowed = row.hits_allowed;
+    def.homeruns_allowed = row.homeruns_allowed;
+    def.pitches_thrown = row.pitches_thrown;
+    def.stamina = row.stamina;
+    def.was_pitcher = row.was_pitcher;
+    def.outs_pitched = row.outs_pitched;
+    def.batter_outs = row.batter_outs;
+    def.strike_outs = row.strike_outs;
+    def.star_pitches_thrown = row.star_pitches_thrown;
+    def.big_plays = row.big_plays;
+
+    auto& off = summary.end_game_offensive_stats;
+    off.at_bats = row.at_bats;
+    off.hits = row.hits;
+    off.singles = row.singles;
+    off.doubles = row.doubles;
+    off.triples = row.triples;
+    off.homeruns = row.homeruns;
+    off.sac_flys = row.sac_flys;
+    off.successful_bunts = row.successful_bunts;
+    off.strikouts = row.strikouts;
+    off.walks_4balls = row.walks_4balls;
+    off.walks_hit = row.walks_hit;
+    off.rbi = row.rbi;
+    off.bases_stolen = row.bases_stolen;
+    off.star_hits = row.star_hits;
+  }
+
+  for (const PositionCountRow& row : position_counts)
+  {
+    if (row.team >= cNumOfTeams || row.position >= cNumOfPositions)
+      continue;
+    StatTracker::FielderInfo& counts = tracker.m_fielder_tracker[row.team].fielder_map[row.roster];
+    counts.batter_count_by_position[row.position] = row.batters;
+    counts.batter_outs_by_position[row.position] = row.batter_outs;
+    counts.out_count_by_position[row.position] = row.outs;
+    counts.pitch_count_by_position[row.position] = row.pitches;
+  }
+
+  for (const EventRow& row : events)
+  {
+    StatTracker::Event& event = info.events[row.event_num];
+    event.event_num = row.event_num;
+    event.inning = row.inning;
+    event.half_inning = row.half_inning;
+    event.away_score = row.away_score;
+    event.home_score = row.home_score;
+    event.is_star_chance = row.is_star_chance;
+    event.away_stars = row.away_stars;
+    event.home_stars = row.home_stars;
+    event.chem_links_ob = row.chem_links_ob;
+    event.pitcher_stamina = row.pitcher_stamina;
+    event.pitcher_roster_loc = row.pitcher_roster_loc;
+    event.batter_roster_loc = row.batter_roster_loc;
+    event.catcher_roster_loc = row.catcher_roster_loc;
+    event.balls = row.balls;
+    event.strikes = row.strikes;
+    event.outs = row.outs;
+    event.num_outs_during_play.set_value(row.num_outs_during_play);
+    event.rbi = row.rbi;
+    event.result_of_atbat = row.result_of_atbat;
+    event.pick_off_attempt = row.pick_off_attempt != 0;
+  }
+
+  for (const RunnerRow& row : runners)
+  {
+    const auto event = info.events.find(row.event_num);
+    if (event == info.events.end())
+      continue;
+
+    StatTracker::Runner runner;
+    runner.roster_loc = row.roster_loc;
+    runner.char_id = row.char_id;
+    runner.initial_base = row.initial_base;
+    runner.out_type = row.out_type;
+    runner.out_location = row.out_location;
+    runner.result_base = row.result_base;
+    runner.steal = row.steal;
+    runner.basepath_location = row.basepath_location;
+
+    switch (row.slot)
+    {
+    case RUNNER_BATTER:
+      event->second.runner_batter = runner;
+      break;
+    case RUNNER_1B:
+      event->second.runner_1 = runner;
+      break;
+    case RUNNER_2B:
+      event->second.runner_2 = runner;
+      break;
+    case RUNNER_3B:
+      event->second.runner_3 = runner;
+      break;
+    }
+  }
+
+  size_t curve_offset = 0;
+  for (const PitchRow& row : pitches)
+  {
+    const size_t curve_end = curve_offset + row.num_curve_frames;
+    if (curve_end > pitch_curves.size())
+      return false;
+
+    const auto event = info.events.find(row.event_num);
+    if (event == info.events.end())
+    {
+      curve_offset = curve_end;
+      continue;
+    }
+
+    StatTracker::Pitch& pitch = event->second.pitch.emplace();
+    pitch.logged = row.logged != 0;
+    pitch.pitcher_team_id = row.pitcher_team_id;
+    pitch.pitcher_char_id = row.pitcher_char_id;
+    pitch.pitch_type = row.pitch_type;
+    pitch.charge_type = row.charge_type;
+    pitch.charge_up.set_value(row.charge_up);
+    pitch.star_pitch = row.star_pitch;
+    pitch.pitch_speed = row.pitch_speed;
+    pitch.batter_roster_loc = row.batter_roster_loc;
+    pitch.batter_id = row.batter_id;
+    pitch.ball_z_strike_vs_ball = row.ball_z_strike_vs_ball;
+    pitch.ball_in_strikezone = row.ball_in_strikezone;
+    pitch.pitch_target_x_pos.set_value(row.pitch_target_x_pos);
+    pitch.pitch_release_x_pos.set_value(row.pitch_release_x_pos);
+    pitch.pitch_release_y_pos.set_value(row.pitch_release_y_pos);
+    pitch.pitch_release_z_pos.set_value(row.pitch_release_z_pos);
+    pitch.bat_contact_x_pos.set_value(row.bat_contact_x_pos);
+    pitch.bat_contact_z_pos.set_value(row.bat_contact_z_pos);
+    pitch.db = row.db;
+    pitch.potential_db = row.potential_db != 0;
+    pitch.pitch_result = row.pitch_result;
+    pitch.type_of_swing = row.type_of_swing;
+
+    pitch.pitch_curve.reserve(row.num_curve_frames);
+    for (; curve_offset < curve_end; ++curve_offset)
+      pitch.pitch_curve.push_back({pitch_curves[curve_offset].curve_velocity});
+  }
+
+  for (const ContactRow& row : contacts)
+  {
+    const auto event = info.events.find(row.event_num);
+    if (event == info.events.end() || !event->second.pitch)
+      continue;
+
+    StatTracker::Contact& contact = event->second.pitch->contact.emplace();
+    contact.power.set_value(row.power);
+    contact.vert_angle.set_value(row.vert_angle);
+    contact.horiz_angle.set_value(row.horiz_angle);
+    contact.ball_x_velo.set_value(row.ball_x_velo);
+    contact.ball_y_velo.set_value(row.ball_y_velo);
+    contact.ball_z_velo.set_value(row.ball_z_velo);
+    contact.ball_contact_x_pos.set_value(row.ball_contact_x_pos);
+    contact.ball_contact_z_pos.set_value(row.ball_contact_z_pos);
+    contact.contact_absolute.set_value(row.contact_absolute);
+    contact.contact_quality.set_value(row.contact_quality);
+    contact.rng1.set_value(row.rng1);
+    contact.rng2.set_value(row.rng2);
+    contact.rng3.set_value(row.rng3);
+    contact.type_of_contact.set_value(row.type_of_contact);
+    contact.moon_shot.set_value(row.moon_shot);
+    contact.charge_power_up.set_value(row.charge_power_up);
+    contact.charge_power_down.set_value(row.charge_power_down);
+    contact.input_direction_stick.set_value(row.input_direction_stick);
+    contact.input_direction_push_pull.set_value(row.input_direction_push_pull);
+    contact.frame_of_swing.set_value(row.frame_of_swing);
+    contact.ball_x_pos.set_value(row.ball_x_pos);
+    contact.ball_y_pos.set_value(row.ball_y_pos);
+    contact.ball_z_pos.set_value(row.ball_z_pos);
+    contact.ball_max_height.set_value(row.ball_max_height);
+    contact.ball_hang_time.set_value(row.ball_hang_time);
+    contact.primary_contact_result = row.primary_contact_result;
+    contact.secondary_contact_result = row.secondary_contact_result;
+  }
+
+  for (const FielderRow& row : fielders)
+  {
+    const auto event = info.events.find(row.event_num);
+    if (event == info.events.end() || !event->second.pitch || !event->second.pitch->contact)
+      continue;
+
+    StatTracker::Contact& contact = *event->second.pitch->contact;
+    if (row.role == FIELDER_FIRST)
+      contact.first_fielder = ToFielder(row);
+    else if (row.role == FIELDER_COLLECT)
+      contact.collect_fielder = ToFielder(row);
+  }
+
+  return true;
+}
+}  // namespace StatLog
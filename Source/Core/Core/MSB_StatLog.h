@@ -0,0 +1,32 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+class StatTracker;
+
+// Compact binary log of a StatTracker game.
+//
+// A log is a small header followed by a sequence of blocks. Each block is a table stored column
+// by column (events, pitches, pitch curves, contacts, fielders, runners, ...), so archives can be
+// scanned one column at a time without parsing whole games. All values are little-endian.
+//
+// Versioning: blocks carry their id, row count and column count. Readers skip unknown blocks, and
+// columns are only ever appended to a table, so newer logs stay readable by older exporters and
+// missing trailing columns in older logs keep their default values.
+namespace StatLog
+{
+constexpr char FILE_EXTENSION[] = ".riostat";
+constexpr u32 FORMAT_VERSION = 1;
+
+// Writes the tracker's current game to path.
+bool Write(const std::string& path, const StatTracker& tracker);
+
+// Restores a game written by Write into tracker, so it can be exported through the regular
+// StatTracker JSON writers.
+bool Read(const std::string& path, StatTracker& tracker);
+}  // namespace StatLog
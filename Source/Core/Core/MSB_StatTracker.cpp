@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <fstream>
 #include <ctime>
+#include <span>
 
 //For LocalPLayers
 #include "Common/CommonPaths.h"
@@ -11,6 +12,7 @@
 #include "Core/LocalPlayersConfig.h"
 #include "Common/Version.h"
 
+#include "Common/JsonWriter.h"
 #include "Common/Swap.h"
 
 // Package for rendering info on screen
@@ -20,24 +22,43 @@
 
 #include <iostream>
 #include "Config/MainSettings.h"
+#include "Core/MSB_StatLog.h"
 
 #include "Common/TagSet.h"
 
-void StatTracker::Run(const Core::CPUThreadGuard& guard)
+void StatTracker::watchMemory(Core::FrameSnapshot& frame)
 {
-    lookForTriggerEvents(guard);
+    // Stadium, ports
+    frame.Watch(0x800E8700, 0x50);
+    // Game id, quitter, ports
+    frame.Watch(0x802EBF80, 0xA0);
+    // Captains, per-character stat and attribute tables
+    frame.Watch(aTeam0_Captain, aInGame_CharAttributes_BattingHand + (2 * cRosterSize * c_roster_table_offset) - aTeam0_Captain);
+    frame.Watch(aAB_GameIsLive, 1);
+    frame.Watch(aAB_IsReplay, 1);
+    frame.Watch(aAB_PitchThrown, 1);
+    // Runners, fielders, pitch, contact and ball state
+    frame.Watch(0x8088EE00, 0x80890E70 - 0x8088EE00);
+    // Inning, score, count and at-bat state
+    frame.Watch(0x80892500, 0x80892B00 - 0x80892500);
+    frame.Watch(0x80893890, aAB_FinalResult + 1 - 0x80893890);
 }
 
-void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
+void StatTracker::Run(const Core::FrameSnapshot& frame)
+{
+    lookForTriggerEvents(frame);
+}
+
+void StatTracker::lookForTriggerEvents(const Core::FrameSnapshot& frame)
 {
     // if (m_game_state != m_game_state_prev) {
-    //     state_logger.writeToFile(c_game_state[m_game_state]);
+    //     state_logger.writeToFile(toString(m_game_state));
     //     m_game_state_prev = m_game_state;
     // }
 
     if (m_event_state != m_event_state_prev) {
         // Write state on every change
-        //state_logger.writeToFile(c_event_state[m_event_state]);
+        //state_logger.writeToFile(toString(m_event_state));
         if (m_game_info.currentEventVld()){
             // Add state of current event to event.history for logging purposes
             m_game_info.getCurrentEvent().history.push_back(m_event_state);
@@ -53,13 +74,13 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     "Batter: {}\n"
                     "Pitcher: {}\n"
                     "Event History: \n{}\n",
-                    c_game_state[m_game_state],
-                    c_event_state[m_event_state],
+                    toString(m_game_state),
+                    toString(m_event_state),
                     m_game_info.getCurrentEvent().event_num,
                     m_game_info.getCurrentEvent().inning,
                     m_game_info.getCurrentEvent().half_inning,
-                    (m_game_info.getCurrentEvent().runner_batter) ? cCharIdToCharName.at(m_game_info.getCurrentEvent().runner_batter->char_id) : "None",
-                    (m_game_info.getCurrentEvent().pitch) ? cCharIdToCharName.at(m_game_info.getCurrentEvent().pitch->pitcher_char_id) : "Pitch Not Thrown Yet",
+                    (m_game_info.getCurrentEvent().runner_batter) ? cCharIdToCharName[m_game_info.getCurrentEvent().runner_batter->char_id] : "None",
+                    (m_game_info.getCurrentEvent().pitch) ? cCharIdToCharName[m_game_info.getCurrentEvent().pitch->pitcher_char_id] : "Pitch Not Thrown Yet",
                     m_game_info.getCurrentEvent().stringifyHistory()
                 ));
             
@@ -70,8 +91,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     u8 batter_char_id = m_game_info.character_summaries[half_inning][m_game_info.getCurrentEvent().batter_roster_loc].char_id;
                     u8 pitcher_char_id = m_game_info.character_summaries[!half_inning][m_game_info.getCurrentEvent().pitcher_roster_loc].char_id;
 
-                    std::string batter_name = cCharIdToCharName.at(batter_char_id);
-                    std::string pitcher_name = cCharIdToCharName.at(pitcher_char_id);
+                    std::string_view batter_name = cCharIdToCharName[batter_char_id];
+                    std::string_view pitcher_name = cCharIdToCharName[pitcher_char_id];
 
                     if (Config::Get(Config::MAIN_ENABLE_DEBUGGING))
                     {
@@ -103,12 +124,10 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                               m_game_info.getCurrentEvent().inning,
                               m_game_info.getCurrentEvent().half_inning,
                               (m_game_info.getCurrentEvent().runner_batter) ?
-                                  cCharIdToCharName.at(
-                                      m_game_info.getCurrentEvent().runner_batter->char_id) :
+                                  cCharIdToCharName[m_game_info.getCurrentEvent().runner_batter->char_id] :
                                   "None",
                               (m_game_info.getCurrentEvent().pitch) ?
-                                  cCharIdToCharName.at(
-                                      m_game_info.getCurrentEvent().pitch->pitcher_char_id) :
+                                  cCharIdToCharName[m_game_info.getCurrentEvent().pitch->pitcher_char_id] :
                                   "Pitch Not Thrown Yet",
                               m_game_info.getCurrentEvent().stringifyHistory()),
                           10000, OSD::Color::BLUE);
@@ -136,14 +155,14 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     "Batter: {}\n"
                     "Pitcher: {}\n"
                     "Event History: \n{}\n",
-                    c_game_state[m_game_state], c_event_state[m_event_state],
+                    toString(m_game_state), toString(m_event_state),
                     m_game_info.getCurrentEvent().event_num, m_game_info.getCurrentEvent().inning,
                     m_game_info.getCurrentEvent().half_inning,
                     (m_game_info.getCurrentEvent().runner_batter) ?
-                        cCharIdToCharName.at(m_game_info.getCurrentEvent().runner_batter->char_id) :
+                        cCharIdToCharName[m_game_info.getCurrentEvent().runner_batter->char_id] :
                         "None",
                     (m_game_info.getCurrentEvent().pitch) ?
-                        cCharIdToCharName.at(m_game_info.getCurrentEvent().pitch->pitcher_char_id) :
+                        cCharIdToCharName[m_game_info.getCurrentEvent().pitch->pitcher_char_id] :
                         "Pitch Not Thrown Yet",
                     m_game_info.getCurrentEvent().stringifyHistory()),
                 3000, OSD::Color::CYAN);
@@ -155,8 +174,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
         OSD::AddTypedMessage(OSD::MessageType::GameStateInfo, fmt::format(
             "Game State: {}\n"
             "Event State: {}\n",
-            c_game_state[m_game_state],
-            c_event_state[m_event_state]            
+            toString(m_game_state),
+            toString(m_event_state)            
         ), 200, OSD::Color::CYAN);
         }
     }
@@ -168,39 +187,39 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //Create new event, collect runner data
 
                 //Capture the rising edge of the AtBat Scene
-        if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x1 &&
-            PowerPC::MMU::HostRead_U8(guard, aGameControlStatePrev) != 0x1)
+        if (frame.Read_U8(aGameControlStateCurr) == 0x1 &&
+            frame.Read_U8(aGameControlStatePrev) != 0x1)
         {
 
                     m_game_info.events[m_game_info.event_num] = Event();
                     m_game_info.getCurrentEvent().event_num = m_game_info.event_num;
 
-                    logEventState(guard, m_game_info.getCurrentEvent());
-                    logGameInfo(guard);
+                    logEventState(frame, m_game_info.getCurrentEvent());
+                    logGameInfo(frame);
 
                     //Get users and captains
                     //POST OngoingGame
                     if (m_game_info.init_game == true) {
                         m_game_info.init_game = false;
-                        initPlayerInfo(guard);
+                        initPlayerInfo(frame);
                     }
 
-                    m_game_info.getCurrentEvent().runner_batter = logRunnerInfo(guard, 0);
-                    m_game_info.getCurrentEvent().runner_1 = logRunnerInfo(guard, 1);
-                    m_game_info.getCurrentEvent().runner_2 = logRunnerInfo(guard, 2);
-                    m_game_info.getCurrentEvent().runner_3 = logRunnerInfo(guard, 3);
+                    m_game_info.getCurrentEvent().runner_batter = logRunnerInfo(frame, 0);
+                    m_game_info.getCurrentEvent().runner_1 = logRunnerInfo(frame, 1);
+                    m_game_info.getCurrentEvent().runner_2 = logRunnerInfo(frame, 2);
+                    m_game_info.getCurrentEvent().runner_3 = logRunnerInfo(frame, 3);
 
                     if (!m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].initialized){
                         std::cout << " Initializing fielders for team: " << std::to_string(!m_game_info.getCurrentEvent().half_inning) << "\n";
-                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].initTracker(guard, !m_game_info.getCurrentEvent().half_inning);
+                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].initTracker(frame, !m_game_info.getCurrentEvent().half_inning);
                     }
 
                     m_event_state = EVENT_STATE::WAITING_FOR_EVENT;
 
                     std::cout << "Init event " << std::to_string(m_game_info.event_num) << "\n";
                 }
-                else if (PowerPC::MMU::HostRead_U32(guard, aGameId) == 0){
-                    onGameQuit(guard);
+                else if (frame.Read_U32(aGameId) == 0){
+                    onGameQuit(frame);
 
                     //Remove current event, wasn't finished
                     auto it = m_game_info.events.find(m_game_info.event_num);
@@ -212,8 +231,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
             //Look for Pitch
             case (EVENT_STATE::WAITING_FOR_EVENT):
                 //Handle quit to main menu
-                if (PowerPC::MMU::HostRead_U32(guard, aGameId) == 0){
-                    onGameQuit(guard);
+                if (frame.Read_U32(aGameId) == 0){
+                    onGameQuit(frame);
 
                     //Remove current event, wasn't finished
                     auto it = m_game_info.events.find(m_game_info.event_num);
@@ -233,37 +252,34 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //1. Are runners stealing and pitcher stepped off the mound
                 //2. Has pitch started?
                 //3. Has game been paused, reinit 
-                if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0xb){
+                if (frame.Read_U8(aGameControlStateCurr) == 0xb){
                     std::cout << "Game paused, need to re-init event " << std::to_string(m_game_info.event_num) << "\n";
-                    logGameInfo(guard);
+                    logGameInfo(frame);
                     updateOngoingGame(m_game_info.getCurrentEvent());
                     m_event_state = EVENT_STATE::INIT_EVENT;
                 }
                 //Watch for Runners Stealing
-                if (PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown) || PowerPC::MMU::HostRead_U8(guard, aAB_PickoffAttempt)){
+                if (frame.Read_U8(aAB_PitchThrown) || frame.Read_U8(aAB_PickoffAttempt)){
                     //If HUD not produced for this event, produce HUD JSON
-                    logGameInfo(guard);
+                    logGameInfo(frame);
 
                     if (m_game_info.getCurrentEvent().write_hud_ab.first) {
-                        std::string hud_file_path = File::GetUserPath(D_HUDFILES_IDX) + "decoded.hud.json";
-                        std::string json = getHUDJSON(std::to_string(m_game_info.event_num) + "a", m_game_info.getCurrentEvent(), m_game_info.previous_state, true);
-                        File::Delete(hud_file_path);
-                        File::WriteStringToFile(hud_file_path, json);
+                        publishHUD(std::to_string(m_game_info.event_num) + "a");
                         //No longer need to write HUD B
                         m_game_info.getCurrentEvent().write_hud_ab.first = false;
                     }
 
-                    if(PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)){
+                    if(frame.Read_U8(aAB_PitchThrown)){
                         std::cout << "Pitch detected!\n";
 
                         //Check for fielder swaps
                         std::cout << " Evaluating fielders for team: " << std::to_string(!m_game_info.getCurrentEvent().half_inning) << "\n";
-                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].evaluateFielders(guard);
+                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].evaluateFielders(frame);
 
                         m_game_info.getCurrentEvent().pitch = std::make_optional(Pitch());
 
                         //Check if pitcher was at center of mound, if so this is a potential DB
-                        if (PowerPC::MMU::HostRead_U8(guard, aFielder_Pos_X) == 0){
+                        if (frame.Read_U8(aFielder_Pos_X) == 0){
                             m_game_info.getCurrentEvent().pitch->potential_db = true;
                             std::cout << "Potential DB!\n";
                         }
@@ -271,7 +287,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                         //Pitch has started
                         m_event_state = EVENT_STATE::PITCH_RESULT;
                     }
-                    else if(PowerPC::MMU::HostRead_U8(guard, aAB_PickoffAttempt)) {
+                    else if(frame.Read_U8(aAB_PickoffAttempt)) {
                         std::cout << "Pick of attempt detected!\n";
                         m_event_state = EVENT_STATE::MONITOR_RUNNERS;
                         m_game_info.getCurrentEvent().pick_off_attempt = true;
@@ -284,8 +300,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //DBs
                 //If the pitcher started in the center of the mound this is a potential DB
                 //If the ball curves at any point it is no longer a DB
-                if (m_game_info.getCurrentEvent().pitch->potential_db && (PowerPC::MMU::HostRead_U8(guard, aAB_PitcherHasCtrlofPitch) == 1)) {
-                    if (floatConverter(PowerPC::MMU::HostRead_U32(guard, aAB_PitchCurveInput)) != 0) {
+                if (m_game_info.getCurrentEvent().pitch->potential_db && (frame.Read_U8(aAB_PitcherHasCtrlofPitch) == 1)) {
+                    if (floatConverter(frame.Read_U32(aAB_PitchCurveInput)) != 0) {
                         std::cout << "No longer potential DB!\n";
                         m_game_info.getCurrentEvent().pitch->potential_db = false;
                     }
@@ -293,46 +309,46 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //While pitch is in flight, record runner activity and track curve
                 //Log if runners are stealing
                 if (m_game_info.getCurrentEvent().runner_1) {
-                    logRunnerEvents(guard, & m_game_info.getCurrentEvent().runner_1.value());
+                    logRunnerEvents(frame, & m_game_info.getCurrentEvent().runner_1.value());
                 }
                 if (m_game_info.getCurrentEvent().runner_2) {
-                    logRunnerEvents(guard, & m_game_info.getCurrentEvent().runner_2.value());
+                    logRunnerEvents(frame, & m_game_info.getCurrentEvent().runner_2.value());
                 }
                 if (m_game_info.getCurrentEvent().runner_3) {
-                    logRunnerEvents(guard, &m_game_info.getCurrentEvent().runner_3.value());
+                    logRunnerEvents(frame, &m_game_info.getCurrentEvent().runner_3.value());
                 }
 
-                logPitchCurve(guard, m_game_info.getCurrentEvent());
+                logPitchCurve(frame, m_game_info.getCurrentEvent());
 
                 // === Transition ===
 
                 //Conditions to leave the state: Contact, Ball beyond batter, HBP
                 //Contact
-                if (PowerPC::MMU::HostRead_U8(guard, aAB_ContactMade)){
-                    logPitch(guard, m_game_info.getCurrentEvent());
-                    logContact(guard, m_game_info.getCurrentEvent());
+                if (frame.Read_U8(aAB_ContactMade)){
+                    logPitch(frame, m_game_info.getCurrentEvent());
+                    logContact(frame, m_game_info.getCurrentEvent());
                     m_event_state = EVENT_STATE::CONTACT_RESULT;
                 }
                 //If the ball gets behind the batter while mid pitch OR play flag is false (safety incase we miss the first cond), record miss
-                else if (PowerPC::MMU::HostRead_U8(guard, aAB_MissedBall)){
-                    logPitch(guard, m_game_info.getCurrentEvent());
+                else if (frame.Read_U8(aAB_MissedBall)){
+                    logPitch(frame, m_game_info.getCurrentEvent());
                     m_event_state = EVENT_STATE::MONITOR_RUNNERS;
                 }
-                else if (PowerPC::MMU::HostRead_U8(guard, aAB_HitByPitch) == 1){
+                else if (frame.Read_U8(aAB_HitByPitch) == 1){
                     //Log HBP
-                    logPitch(guard, m_game_info.getCurrentEvent());
-                    if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)) {
-                        m_game_info.getCurrentEvent().result_of_atbat = PowerPC::MMU::HostRead_U8(guard, aAB_FinalResult);
+                    logPitch(frame, m_game_info.getCurrentEvent());
+                    if (!frame.Read_U8(aAB_PitchThrown)) {
+                        m_game_info.getCurrentEvent().result_of_atbat = frame.Read_U8(aAB_FinalResult);
                         m_event_state = EVENT_STATE::PLAY_OVER;
                     }
                 }
 
                 break;
             case (EVENT_STATE::CONTACT_RESULT):                
-                if (PowerPC::MMU::HostRead_U8(guard, aAB_ContactResult) != 0){
+                if (frame.Read_U8(aAB_ContactResult) != 0){
                     //Indicate that pitch resulted in contact and log contact details
                     m_game_info.getCurrentEvent().pitch->pitch_result = 6;
-                    logContactResult(guard, &m_game_info.getCurrentEvent().pitch->contact.value()); //Land vs Caught vs Foul, Landing POS.
+                    logContactResult(frame, &m_game_info.getCurrentEvent().pitch->contact.value()); //Land vs Caught vs Foul, Landing POS.
                     if(m_event_state != EVENT_STATE::LOG_FIELDER) { //If we don't need to scan for which fielder fields the ball
                         m_event_state = EVENT_STATE::MONITOR_RUNNERS;
                     }
@@ -345,9 +361,9 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 else{
                     Contact* contact = &m_game_info.getCurrentEvent().pitch->contact.value();
                     //Final Result Ball
-                    contact->ball_x_pos.read_value(guard);
-                    contact->ball_y_pos.read_value(guard);
-                    contact->ball_z_pos.read_value(guard);
+                    contact->ball_x_pos.read_value(frame);
+                    contact->ball_y_pos.read_value(frame);
+                    contact->ball_z_pos.read_value(frame);
                 }
                 //Could bobble before the ball hits the ground.
                 //Search for bobble if we haven't recorded one yet and the ball hasn't been collected yet
@@ -355,7 +371,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                  && !m_game_info.getCurrentEvent().pitch->contact->collect_fielder.has_value()){
                      
                     //Returns a fielder that has bobbled if any exist. Otherwise optional is nullptr
-                    m_game_info.getCurrentEvent().pitch->contact->first_fielder = logFielderBobble(guard);
+                    m_game_info.getCurrentEvent().pitch->contact->first_fielder = logFielderBobble(frame);
                 }
 
                 break;
@@ -365,12 +381,12 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                  && !m_game_info.getCurrentEvent().pitch->contact->collect_fielder.has_value()){
                     
                     //Returns a fielder that has bobbled if any exist. Otherwise optional is nullptr
-                    m_game_info.getCurrentEvent().pitch->contact->first_fielder = logFielderBobble(guard);
+                    m_game_info.getCurrentEvent().pitch->contact->first_fielder = logFielderBobble(frame);
                 }
                 
                 if (!m_game_info.getCurrentEvent().pitch->contact->collect_fielder.has_value()){
                     //Returns fielder that is holding the ball. Otherwise nullptr
-                    m_game_info.getCurrentEvent().pitch->contact->collect_fielder = logFielderWithBall(guard);
+                    m_game_info.getCurrentEvent().pitch->contact->collect_fielder = logFielderWithBall(frame);
                     if (m_game_info.getCurrentEvent().pitch->contact->collect_fielder.has_value()){
                         //Start watching runners for outs when the ball has finally been collected
                         m_event_state = EVENT_STATE::MONITOR_RUNNERS;
@@ -378,35 +394,35 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 }
 
                 //Break out if play ends without fielding the ball (HR or other play ending hit)
-                if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)) {
-                    m_game_info.getCurrentEvent().result_of_atbat = PowerPC::MMU::HostRead_U8(guard, aAB_FinalResult);
+                if (!frame.Read_U8(aAB_PitchThrown)) {
+                    m_game_info.getCurrentEvent().result_of_atbat = frame.Read_U8(aAB_FinalResult);
                     m_event_state = EVENT_STATE::PLAY_OVER;
                 }
                 break;
             case (EVENT_STATE::MONITOR_RUNNERS):
-                if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown) && !PowerPC::MMU::HostRead_U8(guard, aAB_PickoffAttempt)){
-                    m_game_info.getCurrentEvent().result_of_atbat = PowerPC::MMU::HostRead_U8(guard, aAB_FinalResult);
+                if (!frame.Read_U8(aAB_PitchThrown) && !frame.Read_U8(aAB_PickoffAttempt)){
+                    m_game_info.getCurrentEvent().result_of_atbat = frame.Read_U8(aAB_FinalResult);
                     m_event_state = EVENT_STATE::PLAY_OVER;
                 }
                 else {
-                    logRunnerEvents(guard, & m_game_info.getCurrentEvent().runner_batter.value());
+                    logRunnerEvents(frame, & m_game_info.getCurrentEvent().runner_batter.value());
                     if (m_game_info.getCurrentEvent().runner_1) {
-                        logRunnerEvents(guard, &m_game_info.getCurrentEvent().runner_1.value());
+                        logRunnerEvents(frame, &m_game_info.getCurrentEvent().runner_1.value());
                     }
                     if (m_game_info.getCurrentEvent().runner_2) {
-                        logRunnerEvents(guard, &m_game_info.getCurrentEvent().runner_2.value());
+                        logRunnerEvents(frame, &m_game_info.getCurrentEvent().runner_2.value());
                     }
                     if (m_game_info.getCurrentEvent().runner_3) {
-                        logRunnerEvents(guard, &m_game_info.getCurrentEvent().runner_3.value());
+                        logRunnerEvents(frame, &m_game_info.getCurrentEvent().runner_3.value());
                     }
                 }
                 break;
             case (EVENT_STATE::PLAY_OVER):
-                if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)){
-                    m_game_info.getCurrentEvent().rbi = PowerPC::MMU::HostRead_U8(guard, aAB_RBI);
+                if (!frame.Read_U8(aAB_PitchThrown)){
+                    m_game_info.getCurrentEvent().rbi = frame.Read_U8(aAB_RBI);
 
                     //runner_batter out, contact_secondary
-                    logFinalResults(guard, m_game_info.getCurrentEvent());
+                    logFinalResults(frame, m_game_info.getCurrentEvent());
 
                     //Determine if this was pitch was a DB
                     if (m_game_info.getCurrentEvent().pitch->potential_db){
@@ -428,7 +444,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 if (m_game_info.getCurrentEvent().write_hud_ab.second){
 
                     //Fill in current state for HUD
-                    logGameInfo(guard);
+                    logGameInfo(frame);
 
                     if (m_game_info.post_ongoing_game == true) {
                         m_game_info.post_ongoing_game = false;
@@ -438,10 +454,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     //Store current state as previous state
                     m_game_info.previous_state = m_game_info.getCurrentEvent();
 
-                    std::string hud_file_path = File::GetUserPath(D_HUDFILES_IDX) + "decoded.hud.json";
-                    std::string json = getHUDJSON(std::to_string(m_game_info.event_num) + "b", m_game_info.getCurrentEvent(), m_game_info.previous_state, true);
-                    File::Delete(hud_file_path);
-                    File::WriteStringToFile(hud_file_path, json);
+                    publishHUD(std::to_string(m_game_info.event_num) + "b");
 
                     //No longer need to write HUD B
                     m_game_info.getCurrentEvent().write_hud_ab.second = false;
@@ -449,7 +462,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
 
                 // === Transitions ===
 
-                if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x7){
+                if (frame.Read_U8(aGameControlStateCurr) == 0x7){
                     //Increment event count
                     ++m_game_info.event_num;
                     //Save position as prev position
@@ -460,13 +473,13 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     m_game_info.update_ongoing_game = true;
                     std::cout << "Logging Final Result\n" << "Starting next AB\n\n";
                 }
-                else if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x1 && !m_game_info.previous_state.value().pitch.has_value()){
+                else if (frame.Read_U8(aGameControlStateCurr) == 0x1 && !m_game_info.previous_state.value().pitch.has_value()){
                     //Increment event count
                     ++m_game_info.event_num;
                     m_event_state = EVENT_STATE::INIT_EVENT;
                     std::cout << "Logging Final Result\n" << "Pickoff over\n\n";
                 }
-                else if ((PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0xE) || (PowerPC::MMU::HostRead_U8(guard, aEndOfGameFlag) == 1)){ //MVP screen
+                else if ((frame.Read_U8(aGameControlStateCurr) == 0xE) || (frame.Read_U8(aEndOfGameFlag) == 1)){ //MVP screen
                     //Increment event count
                     m_event_state = EVENT_STATE::GAME_OVER;
                     std::cout << "Logging Final Result\n" << "Game Over\n\n";
@@ -495,9 +508,9 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
     switch (m_game_state){ // crashed here in debugging "Access violation reading location 0xFFFFFFFFFFFFFFFF"
         case (GAME_STATE::PREGAME):
             //Start recording when GameId is set AND record button is pressed AND game has started
-            //std::cout << std::hex << "GameId=" << PowerPC::MMU::HostRead_U32(guard, aGameId) << "GameState=" <<  PowerPC::MMU::HostRead_U8(aGameControlStateCurr) << '\n';
-            if ((PowerPC::MMU::HostRead_U32(guard, aGameId) != 0) && (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x5) ) {
-                m_game_info.game_id = PowerPC::MMU::HostRead_U32(guard, aGameId);
+            //std::cout << std::hex << "GameId=" << frame.Read_U32(aGameId) << "GameState=" <<  PowerPC::MMU::HostRead_U8(aGameControlStateCurr) << '\n';
+            if ((frame.Read_U32(aGameId) != 0) && (frame.Read_U8(aGameControlStateCurr) == 0x5) ) {
+                m_game_info.game_id = frame.Read_U32(aGameId);
                 //Sample settings
                 m_game_info.netplay = m_state.m_netplay_session;
                 m_game_info.netplay_opponent_alias = m_state.m_netplay_opponent_alias;
@@ -517,44 +530,25 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
             break;
         case (GAME_STATE::INGAME):
             if (m_event_state == EVENT_STATE::GAME_OVER){
-                logGameInfo(guard);
+                logGameInfo(frame);
                 std::cout << "Logging Character Stats\n";
 
-                std::string jsonPath = getStatJsonPath("decoded.");
-                std::string json = getStatJSON(true);
-                    
-                File::WriteStringToFile(jsonPath, json);
-
-                jsonPath = getStatJsonPath("");
-                json = getStatJSON(false, true);
                 //TODO: See if user has signed up for beta test features in future
-                File::WriteStringToFile(jsonPath, json);
+                std::optional<StatJSONs> jsons = writeStatFiles("", "decoded.");
 
-                //File::WriteStringToFile(jsonPath, json);
                 //https://api.projectrio.app/populate_db
-
-                //Print server warning message
-                OSD::AddTypedMessage(OSD::MessageType::GameStateInfo, fmt::format(
-                    "Submitting game to server \n",
-                    "DO NOT LEAVE THE GAME OR CLOSE RIO"           
-                ), 500, OSD::Color::RED);
-                
-                json = getStatJSON(false, false);
                 if (shouldSubmitGame()) {
-                    const Common::HttpRequest::Response response =
-                    m_http.Post("https://api.projectrio.app/populate_db/", json,
-                        {
-                            {"Content-Type", "application/json"},
-                        }
-                    );
+                    //Hand the game off to the uploader. It is spooled to disk and sent from the
+                    //uploader thread so the CPU thread never waits on the server.
+                    if (!jsons)
+                        jsons = getStatJSONs();
+                    m_uploader->SubmitGame(jsons->full, m_game_info.game_id);
 
-                    // Print server warning message
                     OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
-                                         fmt::format("Done submitting game \n", "SAFE TO QUIT"),
-                                         5000, OSD::Color::GREEN);
+                                         "Submitting game to server", 5000, OSD::Color::YELLOW);
                 }
 
-                std::cout << "Logging to " << jsonPath << "\n";
+                std::cout << "Logging to " << getStatJsonPath("", StatLog::FILE_EXTENSION) << "\n";
                 std::cout << "INGAME->ENDGAME\n";
 
 
@@ -577,7 +571,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
     }
 }
 
-void StatTracker::logGameInfo(const Core::CPUThreadGuard& guard){
+void StatTracker::logGameInfo(const Core::FrameSnapshot& frame){
 
     std::time_t unix_time = std::time(nullptr);
 
@@ -585,10 +579,10 @@ void StatTracker::logGameInfo(const Core::CPUThreadGuard& guard){
     m_game_info.end_local_date_time = std::asctime(std::localtime(&unix_time));
     m_game_info.end_local_date_time.pop_back();
 
-    m_game_info.stadium = PowerPC::MMU::HostRead_U8(guard, aStadiumId);
+    m_game_info.stadium = frame.Read_U8(aStadiumId);
 
-    m_game_info.innings_selected = PowerPC::MMU::HostRead_U8(guard, aInningsSelected);
-    m_game_info.innings_played = PowerPC::MMU::HostRead_U8(guard, aAB_Inning);
+    m_game_info.innings_selected = frame.Read_U8(aInningsSelected);
+    m_game_info.innings_played = frame.Read_U8(aAB_Inning);
 
     ////Captains
     //if (m_game_info.away_port == m_game_info.team0_port){
@@ -600,18 +594,18 @@ void StatTracker::logGameInfo(const Core::CPUThreadGuard& guard){
     //    m_game_info.home_captain = PowerPC::MMU::HostRead_U8(aTeam0_Captain);
     //}
 
-    m_game_info.away_score = PowerPC::MMU::HostRead_U16(guard, aAwayTeam_Score);
-    m_game_info.home_score = PowerPC::MMU::HostRead_U16(guard, aHomeTeam_Score);
+    m_game_info.away_score = frame.Read_U16(aAwayTeam_Score);
+    m_game_info.home_score = frame.Read_U16(aHomeTeam_Score);
 
     for (int team=0; team < cNumOfTeams; ++team){
         for (int roster=0; roster < cRosterSize; ++roster){
-            logDefensiveStats(guard, team, roster);
-            logOffensiveStats(guard, team, roster);
+            logDefensiveStats(frame, team, roster);
+            logOffensiveStats(frame, team, roster);
         }
     }
 }
 
-void StatTracker::logDefensiveStats(const Core::CPUThreadGuard& guard, int in_team_id, int roster_id)
+void StatTracker::logDefensiveStats(const Core::FrameSnapshot& frame, int in_team_id, int roster_id)
 {
     u32 offset = (in_team_id * cRosterSize * c_defensive_stat_offset) + (roster_id * c_defensive_stat_offset);
 
@@ -623,31 +617,31 @@ void StatTracker::logDefensiveStats(const Core::CPUThreadGuard& guard, int in_te
     
     auto& stat = m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats;
 
-    m_game_info.character_summaries[idx][roster_id].is_starred = PowerPC::MMU::HostRead_U8(guard, aPitcher_IsStarred + is_starred_offset);
-
-    stat.batters_faced       = PowerPC::MMU::HostRead_U8(guard, aPitcher_BattersFaced + offset);
-    stat.runs_allowed        = PowerPC::MMU::HostRead_U16(guard, aPitcher_RunsAllowed + offset);
-    stat.earned_runs         = PowerPC::MMU::HostRead_U16(guard, aPitcher_RunsAllowed + offset);
-    stat.batters_walked      = PowerPC::MMU::HostRead_U16(guard, aPitcher_BattersWalked + offset);
-    stat.batters_hit         = PowerPC::MMU::HostRead_U16(guard, aPitcher_BattersHit + offset);
-    stat.hits_allowed        = PowerPC::MMU::HostRead_U16(guard, aPitcher_HitsAllowed + offset);
-    stat.homeruns_allowed    = PowerPC::MMU::HostRead_U16(guard, aPitcher_HRsAllowed + offset);
-    stat.pitches_thrown      = PowerPC::MMU::HostRead_U16(guard, aPitcher_PitchesThrown + offset);
-    stat.stamina             = PowerPC::MMU::HostRead_U16(guard, aPitcher_Stamina + offset);
-    stat.was_pitcher         = PowerPC::MMU::HostRead_U8(guard, aPitcher_WasPitcher + offset);
-    stat.batter_outs         = PowerPC::MMU::HostRead_U8(guard, aPitcher_BatterOuts + offset);
-    stat.outs_pitched        = PowerPC::MMU::HostRead_U8(guard, aPitcher_OutsPitched + offset);
-    stat.strike_outs         = PowerPC::MMU::HostRead_U8(guard, aPitcher_StrikeOuts + offset);
-    stat.star_pitches_thrown = PowerPC::MMU::HostRead_U8(guard, aPitcher_StarPitchesThrown + offset);
+    m_game_info.character_summaries[idx][roster_id].is_starred = frame.Read_U8(aPitcher_IsStarred + is_starred_offset);
+
+    stat.batters_faced       = frame.Read_U8(aPitcher_BattersFaced + offset);
+    stat.runs_allowed        = frame.Read_U16(aPitcher_RunsAllowed + offset);
+    stat.earned_runs         = frame.Read_U16(aPitcher_RunsAllowed + offset);
+    stat.batters_walked      = frame.Read_U16(aPitcher_BattersWalked + offset);
+    stat.batters_hit         = frame.Read_U16(aPitcher_BattersHit + offset);
+    stat.hits_allowed        = frame.Read_U16(aPitcher_HitsAllowed + offset);
+    stat.homeruns_allowed    = frame.Read_U16(aPitcher_HRsAllowed + offset);
+    stat.pitches_thrown      = frame.Read_U16(aPitcher_PitchesThrown + offset);
+    stat.stamina             = frame.Read_U16(aPitcher_Stamina + offset);
+    stat.was_pitcher         = frame.Read_U8(aPitcher_WasPitcher + offset);
+    stat.batter_outs         = frame.Read_U8(aPitcher_BatterOuts + offset);
+    stat.outs_pitched        = frame.Read_U8(aPitcher_OutsPitched + offset);
+    stat.strike_outs         = frame.Read_U8(aPitcher_StrikeOuts + offset);
+    stat.star_pitches_thrown = frame.Read_U8(aPitcher_StarPitchesThrown + offset);
 
     //Get inherent values. Doesn't strictly belong here but we need the adjusted_team_id
-    m_game_info.character_summaries[idx][roster_id].char_id = PowerPC::MMU::HostRead_U8(guard, aInGame_CharAttributes_CharId + ingame_attribute_table_offset);
-    m_game_info.character_summaries[idx][roster_id].fielding_hand = PowerPC::MMU::HostRead_U8(guard, aInGame_CharAttributes_FieldingHand + ingame_attribute_table_offset);
-    m_game_info.character_summaries[idx][roster_id].batting_hand = PowerPC::MMU::HostRead_U8(guard, aInGame_CharAttributes_BattingHand + ingame_attribute_table_offset);
+    m_game_info.character_summaries[idx][roster_id].char_id = frame.Read_U8(aInGame_CharAttributes_CharId + ingame_attribute_table_offset);
+    m_game_info.character_summaries[idx][roster_id].fielding_hand = frame.Read_U8(aInGame_CharAttributes_FieldingHand + ingame_attribute_table_offset);
+    m_game_info.character_summaries[idx][roster_id].batting_hand = frame.Read_U8(aInGame_CharAttributes_BattingHand + ingame_attribute_table_offset);
 
 }
 
-void StatTracker::logOffensiveStats(const Core::CPUThreadGuard& guard, int in_team_id, int roster_id){
+void StatTracker::logOffensiveStats(const Core::FrameSnapshot& frame, int in_team_id, int roster_id){
     u32 offset = ((in_team_id * cRosterSize * c_offensive_stat_offset)) + (roster_id * c_offensive_stat_offset);
 
     u8 team_id_port = (in_team_id == 0) ? m_game_info.team0_port : m_game_info.team1_port;
@@ -655,65 +649,65 @@ void StatTracker::logOffensiveStats(const Core::CPUThreadGuard& guard, int in_te
 
     auto& stat = m_game_info.character_summaries[idx][roster_id].end_game_offensive_stats;
 
-    stat.at_bats          = PowerPC::MMU::HostRead_U8(guard, aBatter_AtBats + offset);
-    stat.hits             = PowerPC::MMU::HostRead_U8(guard, aBatter_Hits + offset);
-    stat.singles          = PowerPC::MMU::HostRead_U8(guard, aBatter_Singles + offset);
-    stat.doubles          = PowerPC::MMU::HostRead_U8(guard, aBatter_Doubles + offset);
-    stat.triples          = PowerPC::MMU::HostRead_U8(guard, aBatter_Triples + offset);
-    stat.homeruns         = PowerPC::MMU::HostRead_U8(guard, aBatter_Homeruns + offset);
-    stat.successful_bunts = PowerPC::MMU::HostRead_U8(guard, aBatter_BuntSuccess + offset);
-    stat.sac_flys         = PowerPC::MMU::HostRead_U8(guard, aBatter_SacFlys + offset);
-    stat.strikouts        = PowerPC::MMU::HostRead_U8(guard, aBatter_Strikeouts + offset);
-    stat.walks_4balls     = PowerPC::MMU::HostRead_U8(guard, aBatter_Walks_4Balls + offset);
-    stat.walks_hit        = PowerPC::MMU::HostRead_U8(guard, aBatter_Walks_Hit + offset);
-    stat.rbi              = PowerPC::MMU::HostRead_U8(guard, aBatter_RBI + offset);
-    stat.bases_stolen     = PowerPC::MMU::HostRead_U8(guard, aBatter_BasesStolen + offset);
-    stat.star_hits        = PowerPC::MMU::HostRead_U8(guard, aBatter_StarHits + offset);
-
-    m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats.big_plays = PowerPC::MMU::HostRead_U8(guard, aBatter_BigPlays + offset);
+    stat.at_bats          = frame.Read_U8(aBatter_AtBats + offset);
+    stat.hits             = frame.Read_U8(aBatter_Hits + offset);
+    stat.singles          = frame.Read_U8(aBatter_Singles + offset);
+    stat.doubles          = frame.Read_U8(aBatter_Doubles + offset);
+    stat.triples          = frame.Read_U8(aBatter_Triples + offset);
+    stat.homeruns         = frame.Read_U8(aBatter_Homeruns + offset);
+    stat.successful_bunts = frame.Read_U8(aBatter_BuntSuccess + offset);
+    stat.sac_flys         = frame.Read_U8(aBatter_SacFlys + offset);
+    stat.strikouts        = frame.Read_U8(aBatter_Strikeouts + offset);
+    stat.walks_4balls     = frame.Read_U8(aBatter_Walks_4Balls + offset);
+    stat.walks_hit        = frame.Read_U8(aBatter_Walks_Hit + offset);
+    stat.rbi              = frame.Read_U8(aBatter_RBI + offset);
+    stat.bases_stolen     = frame.Read_U8(aBatter_BasesStolen + offset);
+    stat.star_hits        = frame.Read_U8(aBatter_StarHits + offset);
+
+    m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats.big_plays = frame.Read_U8(aBatter_BigPlays + offset);
 }
 
-void StatTracker::logEventState(const Core::CPUThreadGuard& guard, Event& in_event){
-    in_event.inning          = PowerPC::MMU::HostRead_U8(guard, aAB_Inning);
-    in_event.half_inning     = PowerPC::MMU::HostRead_U8(guard, aAB_HalfInning);
+void StatTracker::logEventState(const Core::FrameSnapshot& frame, Event& in_event){
+    in_event.inning          = frame.Read_U8(aAB_Inning);
+    in_event.half_inning     = frame.Read_U8(aAB_HalfInning);
 
     //Figure out scores
-    in_event.away_score = PowerPC::MMU::HostRead_U16(guard, aAwayTeam_Score);
-    in_event.home_score = PowerPC::MMU::HostRead_U16(guard, aHomeTeam_Score);
+    in_event.away_score = frame.Read_U16(aAwayTeam_Score);
+    in_event.home_score = frame.Read_U16(aHomeTeam_Score);
 
-    in_event.balls           = PowerPC::MMU::HostRead_U8(guard, aAB_Balls);
-    in_event.strikes         = PowerPC::MMU::HostRead_U8(guard, aAB_Strikes);
-    in_event.outs            = PowerPC::MMU::HostRead_U8(guard, aAB_Outs);
+    in_event.balls           = frame.Read_U8(aAB_Balls);
+    in_event.strikes         = frame.Read_U8(aAB_Strikes);
+    in_event.outs            = frame.Read_U8(aAB_Outs);
     
     //Figure out star ownership
     if (m_game_info.team0_port == m_game_info.away_port){
-        in_event.away_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P1_Stars);
-        in_event.home_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P2_Stars);
+        in_event.away_stars = frame.Read_U8(aAB_P1_Stars);
+        in_event.home_stars = frame.Read_U8(aAB_P2_Stars);
     }
     else {
-        in_event.away_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P2_Stars);
-        in_event.home_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P1_Stars);
+        in_event.away_stars = frame.Read_U8(aAB_P2_Stars);
+        in_event.home_stars = frame.Read_U8(aAB_P1_Stars);
     }
     
-    in_event.is_star_chance  = PowerPC::MMU::HostRead_U8(guard, aAB_IsStarChance);
-    in_event.chem_links_ob   = PowerPC::MMU::HostRead_U8(guard, aAB_ChemLinksOnBase);
+    in_event.is_star_chance  = frame.Read_U8(aAB_IsStarChance);
+    in_event.chem_links_ob   = frame.Read_U8(aAB_ChemLinksOnBase);
 
     //The following stamina lookup requires team_id to be in teams of team0 or team1
 
-    auto batter_fielder_ports = getBatterFielderPorts(guard);
+    auto batter_fielder_ports = getBatterFielderPorts(frame);
     u8 pitching_team = (batter_fielder_ports.second == m_game_info.team1_port); //1 if the pitching team is team1
-    u8 pitcher_roster_loc = PowerPC::MMU::HostRead_U8(guard, aAB_PitcherRosterID);
+    u8 pitcher_roster_loc = frame.Read_U8(aAB_PitcherRosterID);
     
     //Calc the pitcher stamina offset and add it to the base stamina addr - TODO move to EventSummary
     u32 pitcherStaminaOffset = ((pitching_team * cRosterSize * c_defensive_stat_offset) + (pitcher_roster_loc * c_defensive_stat_offset));
-    in_event.pitcher_stamina = PowerPC::MMU::HostRead_U16(guard, aPitcher_Stamina + pitcherStaminaOffset);
+    in_event.pitcher_stamina = frame.Read_U16(aPitcher_Stamina + pitcherStaminaOffset);
 
-    in_event.pitcher_roster_loc = PowerPC::MMU::HostRead_U8(guard, aAB_PitcherRosterID);
-    in_event.batter_roster_loc  = PowerPC::MMU::HostRead_U8(guard, aAB_BatterRosterID);
-    in_event.catcher_roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielder_RosterLoc + (1 * cFielder_Offset));
+    in_event.pitcher_roster_loc = frame.Read_U8(aAB_PitcherRosterID);
+    in_event.batter_roster_loc  = frame.Read_U8(aAB_BatterRosterID);
+    in_event.catcher_roster_loc = frame.Read_U8(aFielder_RosterLoc + (1 * cFielder_Offset));
 }
 
-void StatTracker::logContact(const Core::CPUThreadGuard& guard, Event& in_event){
+void StatTracker::logContact(const Core::FrameSnapshot& frame, Event& in_event){
     std::cout << "Logging Contact\n";
 
     Pitch* pitch = &in_event.pitch.value();
@@ -722,69 +716,69 @@ void StatTracker::logContact(const Core::CPUThreadGuard& guard, Event& in_event)
     std::cout << "  Pitch Type: " << std::to_string(in_event.pitch->pitch_type) << "\n";
     Contact* contact = &in_event.pitch->contact.value();
 
-    contact->power.read_value(guard);
-    contact->vert_angle.read_value(guard);
-    contact->horiz_angle.read_value(guard);
-    contact->ball_x_velo.read_value(guard);
-    contact->ball_y_velo.read_value(guard);
-    contact->ball_z_velo.read_value(guard);
-    contact->ball_contact_x_pos.read_value(guard);
-    contact->ball_contact_z_pos.read_value(guard);
-    contact->contact_absolute.read_value(guard);
-    contact->contact_quality.read_value(guard);
-    contact->rng1.read_value(guard);
-    contact->rng2.read_value(guard);
-    contact->rng3.read_value(guard);
-    contact->type_of_contact.read_value(guard);
-    contact->moon_shot.read_value(guard);
-    contact->charge_power_up.read_value(guard);
-    contact->charge_power_down.read_value(guard);
-    contact->input_direction_push_pull.read_value(guard);
-    contact->frame_of_swing.read_value(guard);
+    contact->power.read_value(frame);
+    contact->vert_angle.read_value(frame);
+    contact->horiz_angle.read_value(frame);
+    contact->ball_x_velo.read_value(frame);
+    contact->ball_y_velo.read_value(frame);
+    contact->ball_z_velo.read_value(frame);
+    contact->ball_contact_x_pos.read_value(frame);
+    contact->ball_contact_z_pos.read_value(frame);
+    contact->contact_absolute.read_value(frame);
+    contact->contact_quality.read_value(frame);
+    contact->rng1.read_value(frame);
+    contact->rng2.read_value(frame);
+    contact->rng3.read_value(frame);
+    contact->type_of_contact.read_value(frame);
+    contact->moon_shot.read_value(frame);
+    contact->charge_power_up.read_value(frame);
+    contact->charge_power_down.read_value(frame);
+    contact->input_direction_push_pull.read_value(frame);
+    contact->frame_of_swing.read_value(frame);
 
     //More ball flight info
-    contact->ball_max_height.read_value(guard);
-    contact->ball_hang_time.read_value(guard);
+    contact->ball_max_height.read_value(frame);
+    contact->ball_hang_time.read_value(frame);
 
-    u32 aStickInput = aAB_ControlStickInput + (getBatterFielderPorts(guard).first * cControl_Offset);
-    //std::cout << "Batter Port=" << std::to_string(getBatterFielderPorts().first) << " Stick Addr=" << std::hex << aStickInput << " Stick Value=" << (PowerPC::MMU::HostRead_U16(guard, aStickInput) & 0xF) << "\n";
-    contact->input_direction_stick.set_value(PowerPC::MMU::HostRead_U16(guard, aStickInput) & 0xF); //Mask off the lower 4 bits which are the control stick directions
-    //std::cout << "  Stick Value Decoded=" << decode("StickVec", contact->input_direction_stick.get_value(), true) << "\n";
+    u32 aStickInput = aAB_ControlStickInput + (getBatterFielderPorts(frame).first * cControl_Offset);
+    //std::cout << "Batter Port=" << std::to_string(getBatterFielderPorts().first) << " Stick Addr=" << std::hex << aStickInput << " Stick Value=" << (frame.Read_U16(aStickInput) & 0xF) << "\n";
+    contact->input_direction_stick.set_value(frame.Read_U16(aStickInput) & 0xF); //Mask off the lower 4 bits which are the control stick directions
+    //std::cout << "  Stick Value Decoded=" << decode(DecodeType::StickVec, contact->input_direction_stick.get_value(), true) << "\n";
     std::cout << "SWING: " << contact->frame_of_swing.get_key_value_string().first << "=" << contact->frame_of_swing.get_key_value_string().second << "\n";
     std::cout << "\n";
 }
 
-void StatTracker::logPitch(const Core::CPUThreadGuard& guard, Event& in_event){
+void StatTracker::logPitch(const Core::FrameSnapshot& frame, Event& in_event){
     std::cout << "Logging Pitching\n";
 
     in_event.pitch->logged = true;
     in_event.pitch->pitcher_team_id    = !in_event.half_inning;
-    in_event.pitch->pitcher_char_id    = PowerPC::MMU::HostRead_U8(guard, aAB_PitcherID);
-    in_event.pitch->pitch_type         = PowerPC::MMU::HostRead_U8(guard, aAB_PitchType);
-    in_event.pitch->charge_type        = PowerPC::MMU::HostRead_U8(guard, aAB_ChargePitchType);
-    in_event.pitch->star_pitch         = ((PowerPC::MMU::HostRead_U8(guard, aAB_StarPitch_NonCaptain) > 0) || (PowerPC::MMU::HostRead_U8(guard, aAB_StarPitch_Captain) > 0));
-    in_event.pitch->pitch_speed        = PowerPC::MMU::HostRead_U8(guard, aAB_PitchSpeed);
-    in_event.pitch->charge_up.read_value(guard);
-
-    in_event.pitch->pitch_target_x_pos.read_value(guard);
-    in_event.pitch->pitch_release_x_pos.read_value(guard);
-    in_event.pitch->pitch_release_y_pos.read_value(guard);
-    in_event.pitch->pitch_release_z_pos.read_value(guard);
-
-    in_event.pitch->ball_z_strike_vs_ball = PowerPC::MMU::HostRead_U32(guard, aAB_PitchBallPosZStrikezone);
-    in_event.pitch->bat_contact_x_pos.read_value(guard);
-    in_event.pitch->bat_contact_z_pos.read_value(guard);
+    in_event.pitch->pitcher_char_id    = frame.Read_U8(aAB_PitcherID);
+    in_event.pitch->pitch_type         = frame.Read_U8(aAB_PitchType);
+    in_event.pitch->charge_type        = frame.Read_U8(aAB_ChargePitchType);
+    in_event.pitch->star_pitch         = ((frame.Read_U8(aAB_StarPitch_NonCaptain) > 0) || (frame.Read_U8(aAB_StarPitch_Captain) > 0));
+    in_event.pitch->pitch_speed        = frame.Read_U8(aAB_PitchSpeed);
+    in_event.pitch->charge_up.read_value(frame);
+
+    in_event.pitch->pitch_target_x_pos.read_value(frame);
+    in_event.pitch->pitch_release_x_pos.read_value(frame);
+    in_event.pitch->pitch_release_y_pos.read_value(frame);
+    in_event.pitch->pitch_release_z_pos.read_value(frame);
+
+    in_event.pitch->ball_z_strike_vs_ball = frame.Read_U32(aAB_PitchBallPosZStrikezone);
+    in_event.pitch->bat_contact_x_pos.read_value(frame);
+    in_event.pitch->bat_contact_z_pos.read_value(frame);
 
     float ballposz_strikezone = floatConverter(in_event.pitch->ball_z_strike_vs_ball);
-    float strikezone_left = floatConverter(PowerPC::MMU::HostRead_U32(guard, aAB_PitchStrikezoneEdgeLeft));
-    float strikezone_right = floatConverter(PowerPC::MMU::HostRead_U32(guard, aAB_PitchStrikezoneEdgeRight));
+    float strikezone_left = floatConverter(frame.Read_U32(aAB_PitchStrikezoneEdgeLeft));
+    float strikezone_right = floatConverter(frame.Read_U32(aAB_PitchStrikezoneEdgeRight));
     in_event.pitch->ball_in_strikezone = (strikezone_left < ballposz_strikezone && ballposz_strikezone < strikezone_right) ? 1 : 0;
     
     // === Batter info ===
 
     //First slap,charge,star,bunt
-    u8 swing_type = PowerPC::MMU::HostRead_U8(guard, aAB_TypeOfSwing);  // 0=Slap, 1=charge, 3=bunt
-    u8 star_swing = PowerPC::MMU::HostRead_U8(guard, aAB_StarSwing);
+    u8 swing_type = frame.Read_U8(aAB_TypeOfSwing);  // 0=Slap, 1=charge, 3=bunt
+    u8 star_swing = frame.Read_U8(aAB_StarSwing);
     u8 adjusted_swing = 0; //0=miss, 1=slap, 2=charge, 3=star, 4=bunt
     //Adjust swing to definition
     if (star_swing != 0){
@@ -795,7 +789,7 @@ void StatTracker::logPitch(const Core::CPUThreadGuard& guard, Event& in_event){
     }
 
     //Use adjusted swing if swing and miss, else 0 (or 4 for bunt)
-    u8 any_swing = PowerPC::MMU::HostRead_U8(guard, aAB_AnySwing);  // 0=No swing, 1=swing
+    u8 any_swing = frame.Read_U8(aAB_AnySwing);  // 0=No swing, 1=swing
     if (any_swing == 0) {
         in_event.pitch->type_of_swing = 0;
     }
@@ -804,37 +798,37 @@ void StatTracker::logPitch(const Core::CPUThreadGuard& guard, Event& in_event){
     }
 
     std::cout << "SWING: Swing Type=" << std::to_string(swing_type) << " Star Swing=" << std::to_string(star_swing) 
-              << " AnySwing=" << std::to_string(PowerPC::MMU::HostRead_U8(guard, aAB_AnySwing)) << " Final=" << std::to_string(in_event.pitch->type_of_swing) << "\n";
+              << " AnySwing=" << std::to_string(frame.Read_U8(aAB_AnySwing)) << " Final=" << std::to_string(in_event.pitch->type_of_swing) << "\n";
 }
 
-void StatTracker::logPitchCurve(const Core::CPUThreadGuard& guard, Event& in_event){
+void StatTracker::logPitchCurve(const Core::FrameSnapshot& frame, Event& in_event){
     std::cout << "Logging pitch curve\n";
 
     Pitch* pitch = &in_event.pitch.value();
 
     PitchCurve curve_info = {
-        PowerPC::MMU::HostRead_U32(guard, aAB_PitchCurveInput)
+        frame.Read_U32(aAB_PitchCurveInput)
         // TODO find a way to get the curve left and right inputs
     };
     pitch->pitch_curve.insert(pitch->pitch_curve.end(), curve_info);
 
 }
 
-void StatTracker::logContactResult(const Core::CPUThreadGuard& guard, Contact* in_contact){
+void StatTracker::logContactResult(const Core::FrameSnapshot& frame, Contact* in_contact){
     std::cout << "Logging Contact Result\n";
 
-    u8 result = PowerPC::MMU::HostRead_U8(guard, aAB_ContactResult);
+    u8 result = frame.Read_U8(aAB_ContactResult);
 
     //Log primary contact result (and secondary if possible)
     if (result == 1 || result == 2){
         in_contact->primary_contact_result = result+1; //Landed Fair
         m_event_state = EVENT_STATE::LOG_FIELDER;
-        in_contact->ball_x_pos.read_value(guard);
-        in_contact->ball_y_pos.read_value(guard);
-        in_contact->ball_z_pos.read_value(guard);
+        in_contact->ball_x_pos.read_value(frame);
+        in_contact->ball_y_pos.read_value(frame);
+        in_contact->ball_z_pos.read_value(frame);
 
         //If 2, ball has been caught. Log this as final fielder. If ball has been bobbled they will be logged as bobble
-        in_contact->collect_fielder = logFielderWithBall(guard);
+        in_contact->collect_fielder = logFielderWithBall(frame);
     }
     else if (result == 3){
         in_contact->primary_contact_result = 0; //Out (secondary=caught)
@@ -847,7 +841,7 @@ void StatTracker::logContactResult(const Core::CPUThreadGuard& guard, Contact* i
         in_contact->ball_z_pos.set_value_to_prev();
 
         //Ball has been caught. Log this as final fielder. If ball has been bobbled they will be logged as bobble
-        in_contact->collect_fielder = logFielderWithBall(guard);
+        in_contact->collect_fielder = logFielderWithBall(frame);
 
         //Increment outs for that position for fielder
         m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].incrementOutForPosition(in_contact->collect_fielder->fielder_roster_loc, in_contact->collect_fielder->fielder_pos);
@@ -862,20 +856,20 @@ void StatTracker::logContactResult(const Core::CPUThreadGuard& guard, Contact* i
     else if (result == 0xFF){ // Known bug: this will be true for foul or HR. Correct when adjusting secondary contact later
         in_contact->primary_contact_result = 1; //Foul
         in_contact->secondary_contact_result = 3; //Foul
-        in_contact->ball_x_pos.read_value(guard);
-        in_contact->ball_y_pos.read_value(guard);
-        in_contact->ball_z_pos.read_value(guard);
+        in_contact->ball_x_pos.read_value(frame);
+        in_contact->ball_y_pos.read_value(frame);
+        in_contact->ball_z_pos.read_value(frame);
     }
     else{
         in_contact->primary_contact_result = result;
         in_contact->secondary_contact_result = 0xFF; //???
-        in_contact->ball_x_pos.read_value(guard);
-        in_contact->ball_y_pos.read_value(guard);
-        in_contact->ball_z_pos.read_value(guard);
+        in_contact->ball_x_pos.read_value(frame);
+        in_contact->ball_y_pos.read_value(frame);
+        in_contact->ball_z_pos.read_value(frame);
     }
 }
 
-void StatTracker::logFinalResults(const Core::CPUThreadGuard& guard, Event& in_event){
+void StatTracker::logFinalResults(const Core::FrameSnapshot& frame, Event& in_event){
 
     //Indicate strikeout in the runner_batter
     if (in_event.result_of_atbat == 1){
@@ -900,7 +894,7 @@ void StatTracker::logFinalResults(const Core::CPUThreadGuard& guard, Event& in_e
     }
 
     //num_outs_during_play
-    auto num_outs = in_event.num_outs_during_play.read_value(guard);
+    auto num_outs = in_event.num_outs_during_play.read_value(frame);
     std::cout << "Num outs for play=" << std::to_string(num_outs) << "\n";
     m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].incrementBatterOutForPosition(num_outs);
 
@@ -917,7 +911,7 @@ void StatTracker::logFinalResults(const Core::CPUThreadGuard& guard, Event& in_e
     }
 }
 
-std::string StatTracker::getStatJsonPath(std::string prefix){
+std::string StatTracker::getStatJsonPath(std::string prefix, std::string extension){
     std::string away_player_name;
     std::string home_player_name;
     if (m_game_info.away_port == m_game_info.team0_port) {
@@ -935,652 +929,545 @@ std::string StatTracker::getStatJsonPath(std::string prefix){
     
     std::string file_name = prefix + datetime_c + "_" + away_player_name 
                    + "-Vs-" + home_player_name
-                   + "_" + std::to_string(m_game_info.game_id) + ".json";
+                   + "_" + std::to_string(m_game_info.game_id) + extension;
 
     std::string full_file_path = File::GetUserPath(D_MSSBFILES_IDX) + file_name;
 
     return full_file_path;
 }
 
-std::string StatTracker::getStatJSON(bool inDecode, bool hide_riokey){
-    //TODO switch to IDs when submitting game
-    std::string away_player_info = (inDecode || hide_riokey) ? m_game_info.getAwayTeamPlayer().GetUsername() : m_game_info.getAwayTeamPlayer().GetUserID();
-    std::string home_player_info = (inDecode || hide_riokey) ? m_game_info.getHomeTeamPlayer().GetUsername() : m_game_info.getHomeTeamPlayer().GetUserID();
-
-    std::stringstream json_stream;
+std::optional<StatTracker::StatJSONs> StatTracker::writeStatFiles(std::string prefix, std::string decoded_prefix){
+    //The binary log is always written. The JSON files can be rebuilt from it with DolphinTool
+    StatLog::Write(getStatJsonPath(prefix, StatLog::FILE_EXTENSION), *this);
 
-    json_stream << "{\n";
-    std::string stadium = (inDecode) ? "\"" + cStadiumIdToStadiumName.at(m_game_info.stadium) + "\"" : std::to_string(m_game_info.stadium);
-    std::string start_date_time = (inDecode) ? m_game_info.start_local_date_time : m_game_info.start_unix_date_time;
-    std::string end_date_time = (inDecode) ? m_game_info.end_local_date_time : m_game_info.end_unix_date_time;
-    json_stream << "  \"GameID\": \"" << m_game_info.game_id << "\",\n";
-    json_stream << "  \"Date - Start\": \"" << start_date_time << "\",\n";
-    json_stream << "  \"Date - End\": \"" << end_date_time << "\",\n";
-    
-    std::string tag_set_id_str = "\"\"";
-    if (m_game_info.tag_set_id.has_value()){
-        tag_set_id_str = std::to_string(m_game_info.tag_set_id.value());
+    if (!Config::Get(Config::MAIN_STAT_JSON_FILES)){
+        return std::nullopt;
     }
-    json_stream << "  \"TagSetID\": " << tag_set_id_str << ",\n";
-    json_stream << "  \"Netplay\": " << std::to_string(m_game_info.netplay) << ",\n";
-    json_stream << "  \"StadiumID\": " << decode("Stadium", m_game_info.stadium, inDecode) << ",\n";
-    json_stream << "  \"Away Player\": \"" << away_player_info << "\",\n"; //TODO MAKE THIS AN ID
-    json_stream << "  \"Home Player\": \"" << home_player_info << "\",\n";
 
-    json_stream << "  \"Away Score\": " << std::dec << m_game_info.away_score << ",\n";
-    json_stream << "  \"Home Score\": " << std::dec << m_game_info.home_score << ",\n";
+    StatJSONs jsons = getStatJSONs();
+    File::WriteStringToFile(getStatJsonPath(decoded_prefix), jsons.decoded);
+    File::WriteStringToFile(getStatJsonPath(prefix), jsons.hidden_riokey);
+    return jsons;
+}
 
-    json_stream << "  \"Innings Selected\": " << std::to_string(m_game_info.innings_selected) << ",\n";
-    json_stream << "  \"Innings Played\": " << std::to_string(m_game_info.innings_played) << ",\n";
-    json_stream << "  \"Quitter Team\": " << decode("QuitterTeam", m_game_info.quitter_team, inDecode) << ",\n";
+namespace
+{
+// Writes one document into several JsonWriters at once. The end-of-game stat files share their
+// layout and only differ in whether ids are decoded and which player identifiers they carry, so
+// all of them are built in a single pass over the game.
+class StatJsonEmitter
+{
+public:
+    struct Target{
+        Common::JsonWriter* writer;
+        bool decode;
+        bool hide_riokey;
+    };
 
-    json_stream << "  \"Average Ping\": " << std::to_string(m_game_info.avg_ping) << ",\n";
-    json_stream << "  \"Lag Spikes\": " << std::to_string(m_game_info.lag_spikes) << ",\n";
-    json_stream << "  \"Version\": \"" << Common::GetRioRevStr() << "\",\n";
+    StatJsonEmitter(StatTracker& tracker, std::span<const Target> targets)
+        : m_tracker(tracker), m_targets(targets) {}
 
-    json_stream << "  \"Character Game Stats\": {\n";
+    void BeginObject() { forEach([](Common::JsonWriter& w) { w.BeginObject(); }); }
+    void BeginObject(std::string_view key) { forEach([&](Common::JsonWriter& w) { w.BeginObject(key); }); }
+    void EndObject() { forEach([](Common::JsonWriter& w) { w.EndObject(); }); }
+    void BeginArray(std::string_view key) { forEach([&](Common::JsonWriter& w) { w.BeginArray(key); }); }
+    void EndArray() { forEach([](Common::JsonWriter& w) { w.EndArray(); }); }
 
-    //Defensive Stats
-    for (int team=0; team < cNumOfTeams; ++team){
-        u8 captain_roster_loc;
-        if (team == 0){
-            captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
-        }
-        else{ // team == 1
-            captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
-        }
+    template <typename T>
+    void Value(const T& value){
+        forEach([&](Common::JsonWriter& w) { w.Value(value); });
+    }
 
-        std::string team_string = (team == 0) ? "Away" : "Home";
+    template <typename T>
+    void Field(std::string_view key, const T& value){
+        forEach([&](Common::JsonWriter& w) { w.Field(key, value); });
+    }
 
-        for (int roster=0; roster < cRosterSize; ++roster){
-            CharacterSummary& char_summary = m_game_info.character_summaries[team][roster];
-            
-            // team integer home or away
-            std::string label = "\"" + team_string + " Roster " + std::to_string(roster) + "\": ";
-            json_stream << "    " << label << "{\n";
-            json_stream << "      \"Team\": \""        << std::to_string(team) << "\",\n";
-            json_stream << "      \"RosterID\": "      << std::to_string(roster) << ",\n";
-            json_stream << "      \"CharID\": "        << decode("Character", char_summary.char_id, inDecode) << ",\n";
-            json_stream << "      \"Superstar\": "     << std::to_string(char_summary.is_starred) << ",\n";
-            json_stream << "      \"Captain\": "       << std::to_string(roster == captain_roster_loc) << ",\n";
-            json_stream << "      \"Fielding Hand\": " << decode("Hand", char_summary.fielding_hand, inDecode) << ",\n";
-            json_stream << "      \"Batting Hand\": "  << decode("Hand", char_summary.batting_hand, inDecode) << ",\n";
-
-            //=== Defensive Stats ===
-            EndGameRosterDefensiveStats& def_stat = char_summary.end_game_defensive_stats;
-            json_stream << "      \"Defensive Stats\": {\n";
-            json_stream << "        \"Batters Faced\": "       << std::to_string(def_stat.batters_faced) << ",\n";
-            json_stream << "        \"Runs Allowed\": "        << std::dec << def_stat.runs_allowed << ",\n";
-            json_stream << "        \"Earned Runs\": "        << std::dec << def_stat.earned_runs << ",\n";
-            json_stream << "        \"Batters Walked\": "      << def_stat.batters_walked << ",\n";
-            json_stream << "        \"Batters Hit\": "         << def_stat.batters_hit << ",\n";
-            json_stream << "        \"Hits Allowed\": "        << def_stat.hits_allowed << ",\n";
-            json_stream << "        \"HRs Allowed\": "         << def_stat.homeruns_allowed << ",\n";
-            json_stream << "        \"Pitches Thrown\": "      << def_stat.pitches_thrown << ",\n";
-            json_stream << "        \"Stamina\": "             << def_stat.stamina << ",\n";
-            json_stream << "        \"Was Pitcher\": "         << std::to_string(def_stat.was_pitcher) << ",\n";
-            json_stream << "        \"Strikeouts\": "          << std::to_string(def_stat.strike_outs) << ",\n";
-            json_stream << "        \"Star Pitches Thrown\": " << std::to_string(def_stat.star_pitches_thrown) << ",\n";
-            json_stream << "        \"Big Plays\": "           << std::to_string(def_stat.big_plays) << ",\n";
-            json_stream << "        \"Outs Pitched\": "        << std::to_string(def_stat.outs_pitched) << ",\n";
-            json_stream << "        \"Batters Per Position\": [\n";
-
-            if (m_fielder_tracker[team].battersAtAnyPosition(roster, 0)){
-                json_stream << "          {\n";
-                for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].battersAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos]) << comma << "\n";
-                    }
-                }
-                json_stream << "          }\n";
+    //Game memory holds floats as raw words
+    void FloatField(std::string_view key, u32 value){
+        Field(key, m_tracker.floatConverter(value));
+    }
+
+    //Ids are written as names in decoded documents and as numbers otherwise
+    void DecodedField(std::string_view key, DecodeType type, u8 value){
+        for (const Target& target : m_targets){
+            target.writer->Key(key);
+            if (!target.decode){
+                target.writer->Value(value);
             }
-            json_stream << "        ],\n";
-
-            json_stream << "        \"Batter Outs Per Position\": [\n";
-            if (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, 0)){
-                json_stream << "          {\n";
-                for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos]) << comma << "\n";
-                    }
-                }
-                json_stream << "          }\n";
+            else if (std::optional<std::string_view> name = decodeName(type, value)){
+                target.writer->Value(*name);
             }
-            json_stream << "        ],\n";
-
-            json_stream << "        \"Outs Per Position\": [\n";
-            if (m_fielder_tracker[team].outsAtAnyPosition(roster, 0)){
-                json_stream << "          {\n";
-                for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].outsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos]) << comma << "\n";
-                    }
-                }
-                json_stream << "          }\n";
+            else{
+                target.writer->Value(fmt::format("Unable to Decode. Invalid Value ({}).", value));
             }
-            json_stream << "        ]\n";
-            json_stream << "      },\n";
-
-            //=== Offensive Stats ===
-            EndGameRosterOffensiveStats& of_stat = char_summary.end_game_offensive_stats;
-            json_stream << "      \"Offensive Stats\": {\n";
-            json_stream << "        \"At Bats\": "          << std::to_string(of_stat.at_bats) << ",\n";
-            json_stream << "        \"Hits\": "             << std::to_string(of_stat.hits) << ",\n";
-            json_stream << "        \"Singles\": "          << std::to_string(of_stat.singles) << ",\n";
-            json_stream << "        \"Doubles\": "          << std::to_string(of_stat.doubles) << ",\n";
-            json_stream << "        \"Triples\": "          << std::to_string(of_stat.triples) << ",\n";
-            json_stream << "        \"Homeruns\": "         << std::to_string(of_stat.homeruns) << ",\n";
-            json_stream << "        \"Successful Bunts\": " << std::to_string(of_stat.successful_bunts) << ",\n";
-            json_stream << "        \"Sac Flys\": "         << std::to_string(of_stat.sac_flys) << ",\n";
-            json_stream << "        \"Strikeouts\": "       << std::to_string(of_stat.strikouts) << ",\n";
-            json_stream << "        \"Walks (4 Balls)\": "  << std::to_string(of_stat.walks_4balls) << ",\n";
-            json_stream << "        \"Walks (Hit)\": "      << std::to_string(of_stat.walks_hit) << ",\n";
-            json_stream << "        \"RBI\": "              << std::to_string(of_stat.rbi) << ",\n";
-            json_stream << "        \"Bases Stolen\": "     << std::to_string(of_stat.bases_stolen) << ",\n";
-            json_stream << "        \"Star Hits\": "        << std::to_string(of_stat.star_hits) << "\n";
-            json_stream << "      }\n";
-            std::string commas = ((roster == 8) && (team ==1)) ? "" : ",";
-            json_stream << "    }" << commas << "\n";
         }
     }
-    json_stream << "  },\n";
-    //=== Events === 
-    json_stream << "  \"Events\": [\n";
-    for (auto event_map_iter = m_game_info.events.begin(); event_map_iter != m_game_info.events.end(); event_map_iter++) {
-        u8 event_num = event_map_iter->first;
-        Event& event = event_map_iter->second;
 
-        //Don't log events with inning == 0. Means game has crashed/quit and this is an empty event
-        if (event.inning == 0) {
-            continue;
+    //Writes a field whose value depends on the target document
+    template <typename F>
+    void PerTargetField(std::string_view key, F&& get_value){
+        for (const Target& target : m_targets){
+            target.writer->Field(key, get_value(target));
         }
+    }
 
-        json_stream << "    {\n";
-        json_stream << "      \"Event Num\": "               << std::to_string(event_num) << ",\n";
-        json_stream << "      \"Inning\": "                  << std::to_string(event.inning) << ",\n";
-        json_stream << "      \"Half Inning\": "             << std::to_string(event.half_inning) << ",\n";
-        json_stream << "      \"Away Score\": "              << std::dec << event.away_score << ",\n";
-        json_stream << "      \"Home Score\": "              << std::dec << event.home_score << ",\n";
-        json_stream << "      \"Balls\": "                   << std::to_string(event.balls) << ",\n";
-        json_stream << "      \"Strikes\": "                 << std::to_string(event.strikes) << ",\n";
-        json_stream << "      \"Outs\": "                    << std::to_string(event.outs) << ",\n";
-        json_stream << "      \"Star Chance\": "             << std::to_string(event.is_star_chance) << ",\n";
-        json_stream << "      \"Away Stars\": "              << std::to_string(event.away_stars) << ",\n";
-        json_stream << "      \"Home Stars\": "              << std::to_string(event.home_stars) << ",\n";
-        json_stream << "      \"Pitcher Stamina\": "         << std::to_string(event.pitcher_stamina) << ",\n";
-        json_stream << "      \"Chemistry Links on Base\": " << std::to_string(event.chem_links_ob) << ",\n";
-        json_stream << "      \"Pitcher Roster Loc\": "      << std::to_string(event.pitcher_roster_loc) << ",\n";
-        json_stream << "      \"Batter Roster Loc\": "       << std::to_string(event.batter_roster_loc) << ",\n";
-        json_stream << "      \"Catcher Roster Loc\": "       << std::to_string(event.catcher_roster_loc) << ",\n";
-        json_stream << "      \"RBI\": "                     << std::to_string(event.rbi) << ",\n";
-        json_stream << "      \"" << event.num_outs_during_play.name << "\": " << event.num_outs_during_play.get_key_value_string().second << ",\n";
-        json_stream << "      \"Result of AB\": "            << decode("AtBatResult", event.result_of_atbat, inDecode) << ",\n";
-
-        //=== Runners ===
-        //Build vector of <Runner*, Label/Name>
-        std::vector<std::pair<Runner*, std::string>> runners;
-        if (event.runner_batter) {
-            runners.push_back({&event.runner_batter.value(), "Batter"});
-        }
-        if (event.runner_1) {
-            runners.push_back({&event.runner_1.value(), "1B"});
-        }
-        if (event.runner_2) {
-            runners.push_back({&event.runner_2.value(), "2B"});
-        }
-        if (event.runner_3) {
-            runners.push_back({&event.runner_3.value(), "3B"});
-        }
+    StatTracker& tracker() { return m_tracker; }
 
-        for (auto runner = runners.begin(); runner != runners.end(); runner++){
-            Runner* runner_info = runner->first;
-            std::string& label = runner->second;
-
-            json_stream << "      \"Runner " << label << "\": {\n";
-            json_stream << "        \"Runner Roster Loc\": "   << std::to_string(runner_info->roster_loc) << ",\n";
-            json_stream << "        \"Runner Char Id\": "      << decode("Character", runner_info->char_id, inDecode) << ",\n";
-            json_stream << "        \"Runner Initial Base\": " << std::to_string(runner_info->initial_base) << ",\n";
-            json_stream << "        \"Out Type\": "            << decode("Out", runner_info->out_type, inDecode) << ",\n";
-            json_stream << "        \"Out Location\": "        << std::to_string(runner_info->out_location) << ",\n";
-            //json_stream << "        \"Runner Basepath Location\": "  << std::to_string(runner_info->basepath_location) << ",\n";
-            json_stream << "        \"Steal\": "               << decode("Steal", runner_info->steal, inDecode) << ",\n";
-            json_stream << "        \"Runner Result Base\": "  << std::to_string(runner_info->result_base) << "\n";
-            std::string comma = (std::next(runner) == runners.end() && !event.pitch.has_value()) ? "" : ",";
-            json_stream << "      }" << comma << "\n";
+private:
+    template <typename F>
+    void forEach(F&& f){
+        for (const Target& target : m_targets){
+            f(*target.writer);
         }
+    }
 
+    StatTracker& m_tracker;
+    std::span<const Target> m_targets;
+};
 
-        //=== Pitch ===
-        if (event.pitch.has_value()){
-            Pitch* pitch = &event.pitch.value();
-            json_stream << "      \"Pitch\": {\n";
-            json_stream << "        \"Pitcher Team Id\": "    << std::to_string(pitch->pitcher_team_id) << ",\n";
-            json_stream << "        \"Pitcher Char Id\": "    << decode("Character", pitch->pitcher_char_id, inDecode) << ",\n";
-            json_stream << "        \"Pitch Type\": "         << decode("Pitch", pitch->pitch_type, inDecode) << ",\n";
-            json_stream << "        \"Charge Type\": "        << decode("ChargePitch", pitch->charge_type, inDecode) << ",\n";
-            json_stream << "        \"" << pitch->charge_up.name << "\": " << floatConverter(pitch->charge_up.get_value()) << ",\n";
-            json_stream << "        \"Star Pitch\": "         << std::to_string(pitch->star_pitch) << ",\n";
-            json_stream << "        \"Pitch Speed\": "        << std::to_string(pitch->pitch_speed) << ",\n";
-            json_stream << "        \"" << pitch->pitch_target_x_pos.name << "\": " << floatConverter(pitch->pitch_target_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << pitch->pitch_release_x_pos.name << "\": " << floatConverter(pitch->pitch_release_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << pitch->pitch_release_y_pos.name << "\": " << floatConverter(pitch->pitch_release_y_pos.get_value()) << ",\n";
-            json_stream << "        \"" << pitch->pitch_release_z_pos.name << "\": " << floatConverter(pitch->pitch_release_z_pos.get_value()) << ",\n";
-            json_stream << "        \"Ball Position - Strikezone\": "   << floatConverter(pitch->ball_z_strike_vs_ball) << ",\n";
-            json_stream << "        \"In Strikezone\": "      << std::to_string(pitch->ball_in_strikezone) << ",\n";
-            json_stream << "        \"" << pitch->bat_contact_x_pos.name << "\": " << floatConverter(pitch->bat_contact_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << pitch->bat_contact_z_pos.name << "\": " << floatConverter(pitch->bat_contact_z_pos.get_value()) << ",\n";
-            json_stream << "        \"DB\": "                 << std::to_string(pitch->db) << ",\n";
-            json_stream << "        \"Type of Swing\": "      << decode("Swing", pitch->type_of_swing, inDecode) << ",\n";
-
-            //=== Pitch Curve ===
-            json_stream << "        \"Curve\": {\n";
-            json_stream << "          \"Curve Velocity\": [\n";
-            for (int frame = 0; frame < pitch->pitch_curve.size(); ++frame){
-                std::string comma = (frame + 1 == pitch->pitch_curve.size()) ? "," : "";
-                json_stream << "            " << floatConverter(pitch->pitch_curve[frame]->curve_velocity) << comma << "\n";
+void writePositionCounts(StatJsonEmitter& emitter, std::string_view key,
+                         const std::array<int, cNumOfPositions>& counts){
+    //Written as an array holding at most one object, keyed by position
+    emitter.BeginArray(key);
+    if (std::any_of(counts.begin(), counts.end(), [](int count) { return count > 0; })){
+        emitter.BeginObject();
+        for (int pos = 0; pos < cNumOfPositions; ++pos) {
+            if (counts[pos] > 0){
+                emitter.Field(cPosition[pos], counts[pos]);
             }
-            json_stream << "          ],\n"; // TODO add pitch inputs
-            json_stream << "        }";
-            
-            //=== Contact ===
-            if (pitch->contact.has_value() && pitch->contact->type_of_contact.get_value() != 0xFF){
-                json_stream << ",\n";
-
-                Contact* contact = &pitch->contact.value();
-                json_stream << "        \"Contact\": {\n";
-                json_stream << "          \"" << contact->type_of_contact.name << "\":" << decode("Contact", contact->type_of_contact.get_value(), inDecode) << ",\n";
-                json_stream << "          \"" << contact->charge_power_up.name << "\": " << floatConverter(contact->charge_power_up.get_value()) << ",\n";
-                json_stream << "          \"" << contact->charge_power_down.name << "\": " << floatConverter(contact->charge_power_down.get_value()) << ",\n";
-                json_stream << "          \"" << contact->moon_shot.name << "\": " << contact->moon_shot.get_key_value_string().second << ",\n"; 
-                json_stream << "          \"" << contact->input_direction_push_pull.name << "\": " << decode("Stick", contact->input_direction_push_pull.get_value(), inDecode) << ",\n";
-                json_stream << "          \"" << contact->input_direction_stick.name << "\": " << decode("StickVec", contact->input_direction_stick.get_value(), inDecode) << ",\n";
-                json_stream << "          \"" << contact->frame_of_swing.name << "\": \"" << std::dec << contact->frame_of_swing.get_value() << "\",\n";
-
-                json_stream << "          \"" << contact->power.name << "\": \"" << std::dec << contact->power.get_value() <<"\",\n";
-                json_stream << "          \"" << contact->vert_angle.name << "\": \"" << std::dec << contact->vert_angle.get_value() << "\",\n";
-                json_stream << "          \"" << contact->horiz_angle.name << "\": \"" << std::dec << contact->horiz_angle.get_value() << "\",\n";
-
-                json_stream << "          \"" << contact->contact_absolute.name << "\": " << floatConverter(contact->contact_absolute.get_value()) << ",\n";
-                json_stream << "          \"" << contact->contact_quality.name << "\": " << floatConverter(contact->contact_quality.get_value()) << ",\n";
-                
-                json_stream << "          \"" << contact->rng1.name << "\": \"" << std::dec << contact->rng1.get_value() << "\",\n";
-                json_stream << "          \"" << contact->rng2.name << "\": \"" << std::dec << contact->rng2.get_value() << "\",\n";
-                json_stream << "          \"" << contact->rng3.name << "\": \"" << std::dec << contact->rng3.get_value() << "\",\n";
-
-                json_stream << "          \"" << contact->ball_x_velo.name << "\": " << floatConverter(contact->ball_x_velo.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_y_velo.name << "\": " << floatConverter(contact->ball_y_velo.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_z_velo.name << "\": " << floatConverter(contact->ball_z_velo.get_value()) << ",\n";
-
-                json_stream << "          \"" << contact->ball_contact_x_pos.name << "\": " << floatConverter(contact->ball_contact_x_pos.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_contact_z_pos.name << "\": " << floatConverter(contact->ball_contact_z_pos.get_value()) << ",\n";
-                                
-                json_stream << "          \"" << contact->ball_x_pos.name << "\": " << floatConverter(contact->ball_x_pos.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_y_pos.name << "\": " << floatConverter(contact->ball_y_pos.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_z_pos.name << "\": " << floatConverter(contact->ball_z_pos.get_value()) << ",\n";
-
-                json_stream << "          \"" << contact->ball_max_height.name << "\": " << floatConverter(contact->ball_max_height.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_hang_time.name << "\": \"" << std::dec << contact->ball_hang_time.get_value() << "\",\n";
-                json_stream << "          \"Contact Result - Primary\": "         << decode("PrimaryContactResult", contact->primary_contact_result, inDecode) << ",\n";
-                json_stream << "          \"Contact Result - Secondary\": "       << decode("SecondaryContactResult", contact->secondary_contact_result, inDecode);
-
-                //=== Fielder ===
-                //TODO could be reworked
-                if (contact->first_fielder.has_value() || contact->collect_fielder.has_value()){
-                    json_stream << ",\n";
-
-                    //First fielder to touch the ball
-                    Fielder* fielder;
-
-                    //If the fielder bobbled but the same fielder collected the ball OR there was no bobble, log single fielder
-                    
-                    if (contact->first_fielder.has_value()) { fielder = &contact->first_fielder.value(); }
-                    else {fielder = &contact->collect_fielder.value();}
-
-                    json_stream << "          \"First Fielder\": {\n";
-                    json_stream << "            \"Fielder Roster Location\": " << std::to_string(fielder->fielder_roster_loc) << ",\n";
-                    json_stream << "            \"Fielder Position\": "        << decode("Position", fielder->fielder_pos, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Character\": "       << decode("Character", fielder->fielder_char_id, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Action\": "          << decode("Action", fielder->fielder_action, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Jump\": "            << std::to_string(fielder->fielder_jump) << ",\n";
-                    json_stream << "            \"Fielder Swap\": "            << std::to_string(fielder->fielder_swapped_for_batter) << ",\n";
-                    json_stream << "            \"Fielder Manual Selected\": " << decode("ManualSelect", fielder->fielder_manual_select_arg, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Position - X\": "    << floatConverter(fielder->fielder_x_pos) << ",\n";
-                    json_stream << "            \"Fielder Position - Y\": "    << floatConverter(fielder->fielder_y_pos) << ",\n";
-                    json_stream << "            \"Fielder Position - Z\": "    << floatConverter(fielder->fielder_z_pos) << ",\n";
-                    json_stream << "            \"Fielder Bobble\": "          << decode("Bobble", fielder->bobble, inDecode) << "\n";
-                    json_stream << "          }\n";
-                    /*
-                    else if (contact->first_fielder.has_value() 
-                            && (contact->first_fielder->fielder_roster_loc != contact->collect_fielder->fielder_roster_loc)) {
-                        
-                        Fielder* first_fielder  = &contact->first_fielder.value();
-                        Fielder* second_fielder = &contact->collect_fielder.value();
-
-                        json_stream << "          \"First Fielder\": {\n";
-                        json_stream << "            \"Fielder Roster Location\": " << std::to_string(first_fielder->fielder_roster_loc) << ",\n";
-                        json_stream << "            \"Fielder Position\": "        << std::to_string(first_fielder->fielder_pos) << ",\n";
-                        json_stream << "            \"Fielder Character\": "       << std::to_string(first_fielder->fielder_char_id) << ",\n";
-                        json_stream << "            \"Fielder Action\": "          << std::to_string(first_fielder->fielder_action) << ",\n";
-                        json_stream << "            \"Fielder Swap\": "            << std::to_string(first_fielder->fielder_swapped_for_batter) << ",\n";
-                        json_stream << "            \"Fielder Position - X\": "    << floatConverter(first_fielder->fielder_x_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Y\": "    << floatConverter(first_fielder->fielder_y_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Z\": "    << floatConverter(first_fielder->fielder_z_pos) << ",\n";
-                        json_stream << "            \"Fielder Bobble\": "          << std::to_string(first_fielder->bobble) << "\n";
-                        json_stream << "          },\n";
-                        json_stream << "          \"Second Fielder\": {\n";
-                        json_stream << "            \"Fielder Roster Location\": " << std::to_string(second_fielder->fielder_roster_loc) << ",\n";
-                        json_stream << "            \"Fielder Position\": "        << std::to_string(second_fielder->fielder_pos) << ",\n";
-                        json_stream << "            \"Fielder Character\": "       << std::to_string(second_fielder->fielder_char_id) << ",\n";
-                        json_stream << "            \"Fielder Action\": "          << std::to_string(second_fielder->fielder_action) << ",\n";
-                        json_stream << "            \"Fielder Swap\": "            << std::to_string(second_fielder->fielder_swapped_for_batter) << ",\n";
-                        json_stream << "            \"Fielder Position - X\": "    << floatConverter(second_fielder->fielder_x_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Y\": "    << floatConverter(second_fielder->fielder_y_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Z\": "    << floatConverter(second_fielder->fielder_z_pos) << ",\n";
-                        json_stream << "            \"Fielder Bobble\": "          << std::to_string(second_fielder->bobble) << "\n";
-                        json_stream << "          }\n";
-                    }
-                    */
-                }
-                else{ //Finish contact section
-                    json_stream << "\n";
-                }
-                json_stream << "        }\n";
-            }
-            else { //Finish pitch section
-                json_stream << "\n";
-            }
-            json_stream << "      }\n";
         }
-
-        std::string end_comma = (std::next(event_map_iter) !=  m_game_info.events.end()) ? "," : "";
-        json_stream << "    }" << end_comma << "\n";
+        emitter.EndObject();
     }
+    emitter.EndArray();
+}
 
-    json_stream << "  ]\n";
-    json_stream << "}\n";
-
-    return json_stream.str();
+void writeCharacterSummary(StatJsonEmitter& emitter, int team, int roster, u8 captain_roster_loc){
+    StatTracker& tracker = emitter.tracker();
+    StatTracker::CharacterSummary& char_summary = tracker.m_game_info.character_summaries[team][roster];
+    StatTracker::FielderInfo& fielder_info = tracker.m_fielder_tracker[team].fielder_map[roster];
+
+    std::string team_string = (team == 0) ? "Away" : "Home";
+    emitter.BeginObject(fmt::format("{} Roster {}", team_string, roster));
+    emitter.Field("Team", std::to_string(team));
+    emitter.Field("RosterID", roster);
+    emitter.DecodedField("CharID", DecodeType::Character, char_summary.char_id);
+    emitter.Field("Superstar", char_summary.is_starred);
+    emitter.Field("Captain", static_cast<int>(roster == captain_roster_loc));
+    emitter.DecodedField("Fielding Hand", DecodeType::Hand, char_summary.fielding_hand);
+    emitter.DecodedField("Batting Hand", DecodeType::Hand, char_summary.batting_hand);
+
+    //=== Defensive Stats ===
+    StatTracker::EndGameRosterDefensiveStats& def_stat = char_summary.end_game_defensive_stats;
+    emitter.BeginObject("Defensive Stats");
+    emitter.Field("Batters Faced", def_stat.batters_faced);
+    emitter.Field("Runs Allowed", def_stat.runs_allowed);
+    emitter.Field("Earned Runs", def_stat.earned_runs);
+    emitter.Field("Batters Walked", def_stat.batters_walked);
+    emitter.Field("Batters Hit", def_stat.batters_hit);
+    emitter.Field("Hits Allowed", def_stat.hits_allowed);
+    emitter.Field("HRs Allowed", def_stat.homeruns_allowed);
+    emitter.Field("Pitches Thrown", def_stat.pitches_thrown);
+    emitter.Field("Stamina", def_stat.stamina);
+    emitter.Field("Was Pitcher", def_stat.was_pitcher);
+    emitter.Field("Strikeouts", def_stat.strike_outs);
+    emitter.Field("Star Pitches Thrown", def_stat.star_pitches_thrown);
+    emitter.Field("Big Plays", def_stat.big_plays);
+    emitter.Field("Outs Pitched", def_stat.outs_pitched);
+    writePositionCounts(emitter, "Batters Per Position", fielder_info.batter_count_by_position);
+    writePositionCounts(emitter, "Batter Outs Per Position", fielder_info.batter_outs_by_position);
+    writePositionCounts(emitter, "Outs Per Position", fielder_info.out_count_by_position);
+    emitter.EndObject();
+
+    //=== Offensive Stats ===
+    StatTracker::EndGameRosterOffensiveStats& of_stat = char_summary.end_game_offensive_stats;
+    emitter.BeginObject("Offensive Stats");
+    emitter.Field("At Bats", of_stat.at_bats);
+    emitter.Field("Hits", of_stat.hits);
+    emitter.Field("Singles", of_stat.singles);
+    emitter.Field("Doubles", of_stat.doubles);
+    emitter.Field("Triples", of_stat.triples);
+    emitter.Field("Homeruns", of_stat.homeruns);
+    emitter.Field("Successful Bunts", of_stat.successful_bunts);
+    emitter.Field("Sac Flys", of_stat.sac_flys);
+    emitter.Field("Strikeouts", of_stat.strikouts);
+    emitter.Field("Walks (4 Balls)", of_stat.walks_4balls);
+    emitter.Field("Walks (Hit)", of_stat.walks_hit);
+    emitter.Field("RBI", of_stat.rbi);
+    emitter.Field("Bases Stolen", of_stat.bases_stolen);
+    emitter.Field("Star Hits", of_stat.star_hits);
+    emitter.EndObject();
+
+    emitter.EndObject();
 }
 
-std::string StatTracker::getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event> in_prev_event, bool inDecode){
-    std::stringstream json_stream;
+void writeRunners(StatJsonEmitter& emitter, StatTracker::Event& event){
+    const std::array<std::pair<std::optional<StatTracker::Runner>*, const char*>, 4> runners = {{
+        {&event.runner_batter, "Runner Batter"},
+        {&event.runner_1, "Runner 1B"},
+        {&event.runner_2, "Runner 2B"},
+        {&event.runner_3, "Runner 3B"},
+    }};
 
-    if (in_curr_event.inning == 0) {
-        return "{}";
-    }
+    for (auto& [runner, label] : runners){
+        if (!runner->has_value()){
+            continue;
+        }
 
-    json_stream << "{\n";
+        StatTracker::Runner& runner_info = runner->value();
+        emitter.BeginObject(label);
+        emitter.Field("Runner Roster Loc", runner_info.roster_loc);
+        emitter.DecodedField("Runner Char Id", DecodeType::Character, runner_info.char_id);
+        emitter.Field("Runner Initial Base", runner_info.initial_base);
+        emitter.DecodedField("Out Type", DecodeType::Out, runner_info.out_type);
+        emitter.Field("Out Location", runner_info.out_location);
+        emitter.DecodedField("Steal", DecodeType::Steal, runner_info.steal);
+        emitter.Field("Runner Result Base", runner_info.result_base);
+        emitter.EndObject();
+    }
+}
 
-    json_stream << "  \"Event Num\": \""             << in_event_num << "\",\n";
-    json_stream << "  \"Away Player\": \""           << m_game_info.getAwayTeamPlayer().GetUsername() << "\",\n";
-    json_stream << "  \"Home Player\": \""           << m_game_info.getHomeTeamPlayer().GetUsername() << "\",\n";
-    json_stream << "  \"Inning\": "                  << std::to_string(in_curr_event.inning) << ",\n";
-    json_stream << "  \"Half Inning\": "             << std::to_string(in_curr_event.half_inning) << ",\n";
-    json_stream << "  \"Away Score\": "              << std::dec << in_curr_event.away_score << ",\n";
-    json_stream << "  \"Home Score\": "              << std::dec << in_curr_event.home_score << ",\n";
-    json_stream << "  \"Balls\": "                   << std::to_string(in_curr_event.balls) << ",\n";
-    json_stream << "  \"Strikes\": "                 << std::to_string(in_curr_event.strikes) << ",\n";
-    json_stream << "  \"Outs\": "                    << std::to_string(in_curr_event.outs) << ",\n";
-    json_stream << "  \"Star Chance\": "             << std::to_string(in_curr_event.is_star_chance) << ",\n";
-    json_stream << "  \"Away Stars\": "              << std::to_string(in_curr_event.away_stars) << ",\n";
-    json_stream << "  \"Home Stars\": "              << std::to_string(in_curr_event.home_stars) << ",\n";
-    json_stream << "  \"Pitcher Stamina\": "         << std::to_string(in_curr_event.pitcher_stamina) << ",\n";
-    json_stream << "  \"Chemistry Links on Base\": " << std::to_string(in_curr_event.chem_links_ob) << ",\n";
-    json_stream << "  \"" << in_curr_event.num_outs_during_play.name << "\": " << in_curr_event.num_outs_during_play.get_key_value_string().second << ",\n";
-    json_stream << "  \"Pitcher Roster Loc\": "      << std::to_string(in_curr_event.pitcher_roster_loc) << ",\n";
-    json_stream << "  \"Batter Roster Loc\": "       << std::to_string(in_curr_event.batter_roster_loc) << ",\n";
+void writeFielder(StatJsonEmitter& emitter, StatTracker::Fielder& fielder){
+    emitter.BeginObject("First Fielder");
+    emitter.Field("Fielder Roster Location", fielder.fielder_roster_loc);
+    emitter.DecodedField("Fielder Position", DecodeType::Position, fielder.fielder_pos);
+    emitter.DecodedField("Fielder Character", DecodeType::Character, fielder.fielder_char_id);
+    emitter.DecodedField("Fielder Action", DecodeType::Action, fielder.fielder_action);
+    emitter.Field("Fielder Jump", fielder.fielder_jump);
+    emitter.Field("Fielder Swap", fielder.fielder_swapped_for_batter);
+    emitter.DecodedField("Fielder Manual Selected", DecodeType::ManualSelect, fielder.fielder_manual_select_arg);
+    emitter.FloatField("Fielder Position - X", fielder.fielder_x_pos);
+    emitter.FloatField("Fielder Position - Y", fielder.fielder_y_pos);
+    emitter.FloatField("Fielder Position - Z", fielder.fielder_z_pos);
+    emitter.DecodedField("Fielder Bobble", DecodeType::Bobble, fielder.bobble);
+    emitter.EndObject();
+}
 
-    for (int team=0; team < 2; ++team){
-        for (int roster=0; roster < cRosterSize; ++roster){
+void writeContact(StatJsonEmitter& emitter, StatTracker::Contact& contact, bool for_hud){
+    emitter.BeginObject("Contact");
+    emitter.DecodedField(contact.type_of_contact.name, DecodeType::Contact, contact.type_of_contact.get_value());
+    emitter.FloatField(contact.charge_power_up.name, contact.charge_power_up.get_value());
+    emitter.FloatField(contact.charge_power_down.name, contact.charge_power_down.get_value());
+    emitter.Field(contact.moon_shot.name, contact.moon_shot.get_value());
+    emitter.DecodedField(contact.input_direction_push_pull.name, DecodeType::Stick, contact.input_direction_push_pull.get_value());
+    emitter.DecodedField(contact.input_direction_stick.name, DecodeType::StickVec, contact.input_direction_stick.get_value());
+    emitter.Field(contact.frame_of_swing.name, std::to_string(contact.frame_of_swing.get_value()));
+    emitter.Field(contact.power.name, std::to_string(contact.power.get_value()));
+    emitter.Field(contact.vert_angle.name, std::to_string(contact.vert_angle.get_value()));
+    emitter.Field(contact.horiz_angle.name, std::to_string(contact.horiz_angle.get_value()));
+    emitter.FloatField(contact.contact_absolute.name, contact.contact_absolute.get_value());
+    emitter.FloatField(contact.contact_quality.name, contact.contact_quality.get_value());
+    emitter.Field(contact.rng1.name, std::to_string(contact.rng1.get_value()));
+    emitter.Field(contact.rng2.name, std::to_string(contact.rng2.get_value()));
+    emitter.Field(contact.rng3.name, std::to_string(contact.rng3.get_value()));
+    emitter.FloatField(contact.ball_x_velo.name, contact.ball_x_velo.get_value());
+    emitter.FloatField(contact.ball_y_velo.name, contact.ball_y_velo.get_value());
+    emitter.FloatField(contact.ball_z_velo.name, contact.ball_z_velo.get_value());
+    emitter.FloatField(contact.ball_contact_x_pos.name, contact.ball_contact_x_pos.get_value());
+    emitter.FloatField(contact.ball_contact_z_pos.name, contact.ball_contact_z_pos.get_value());
+    emitter.FloatField(contact.ball_x_pos.name, contact.ball_x_pos.get_value());
+    emitter.FloatField(contact.ball_y_pos.name, contact.ball_y_pos.get_value());
+    emitter.FloatField(contact.ball_z_pos.name, contact.ball_z_pos.get_value());
+    //The HUD has always reported hang time as a number, the stat files as a string
+    if (for_hud){
+        emitter.Field(contact.ball_hang_time.name, contact.ball_hang_time.get_value());
+        emitter.FloatField(contact.ball_max_height.name, contact.ball_max_height.get_value());
+    }
+    else{
+        emitter.FloatField(contact.ball_max_height.name, contact.ball_max_height.get_value());
+        emitter.Field(contact.ball_hang_time.name, std::to_string(contact.ball_hang_time.get_value()));
+    }
+    emitter.DecodedField("Contact Result - Primary", DecodeType::PrimaryContactResult, contact.primary_contact_result);
+    emitter.DecodedField("Contact Result - Secondary", DecodeType::SecondaryContactResult, contact.secondary_contact_result);
 
-            u8 captain_roster_loc = 0;
-            if (team == 0){
-                captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
-            }
-            else{ // team == 1
-                captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
-            }
+    //=== Fielder ===
+    //Log the first fielder to touch the ball. If there was no bobble, that is the fielder who collected it
+    if (contact.first_fielder.has_value()){
+        writeFielder(emitter, contact.first_fielder.value());
+    }
+    else if (contact.collect_fielder.has_value()){
+        writeFielder(emitter, contact.collect_fielder.value());
+    }
+    emitter.EndObject();
+}
 
-            std::string team_string = (team == 0) ? "Away" : "Home";
-
-            CharacterSummary& char_summary = m_game_info.character_summaries[team][roster];
-            std::string label = "\"" + team_string + " Roster " + std::to_string(roster) + "\": ";
-            json_stream << "  " << label << "{\n";
-            json_stream << "    \"Team\": \""        << std::to_string(team) << "\",\n";
-            json_stream << "    \"RosterID\": "      << std::to_string(roster) << ",\n";
-            json_stream << "    \"CharID\": "        << decode("Character", char_summary.char_id, inDecode) << ",\n";
-            json_stream << "    \"Superstar\": "     << std::to_string(char_summary.is_starred) << ",\n";
-            json_stream << "    \"Captain\": "       << std::to_string(roster == captain_roster_loc) << ",\n";
-            json_stream << "    \"Fielding Hand\": " << decode("Hand", char_summary.fielding_hand, inDecode) << ",\n";
-            json_stream << "    \"Batting Hand\": "  << decode("Hand", char_summary.batting_hand, inDecode) << ",\n";
-
-            //=== Defensive Stats ===
-            EndGameRosterDefensiveStats& def_stat = char_summary.end_game_defensive_stats;
-            json_stream << "    \"Defensive Stats\": {\n";
-            json_stream << "      \"Batters Faced\": "       << std::to_string(def_stat.batters_faced) << ",\n";
-            json_stream << "      \"Runs Allowed\": "        << std::dec << def_stat.runs_allowed << ",\n";
-            json_stream << "      \"Earned Runs\": "        << std::dec << def_stat.earned_runs << ",\n";
-            json_stream << "      \"Batters Walked\": "      << def_stat.batters_walked << ",\n";
-            json_stream << "      \"Batters Hit\": "         << def_stat.batters_hit << ",\n";
-            json_stream << "      \"Hits Allowed\": "        << def_stat.hits_allowed << ",\n";
-            json_stream << "      \"HRs Allowed\": "         << def_stat.homeruns_allowed << ",\n";
-            json_stream << "      \"Pitches Thrown\": "      << def_stat.pitches_thrown << ",\n";
-            json_stream << "      \"Stamina\": "             << def_stat.stamina << ",\n";
-            json_stream << "      \"Was Pitcher\": "         << std::to_string(def_stat.was_pitcher) << ",\n";
-            json_stream << "      \"Strikeouts\": "          << std::to_string(def_stat.strike_outs) << ",\n";
-            json_stream << "      \"Star Pitches Thrown\": " << std::to_string(def_stat.star_pitches_thrown) << ",\n";
-            json_stream << "      \"Big Plays\": "           << std::to_string(def_stat.big_plays) << ",\n";
-            json_stream << "      \"Outs Pitched\": "        << std::to_string(def_stat.outs_pitched) << ",\n";
-            json_stream << "      \"Batters Per Position\": [\n";
-
-            if (m_fielder_tracker[team].battersAtAnyPosition(roster, 0)){
-                json_stream << "        {\n";
-                for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].battersAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos]) << comma << "\n";
-                    }
-                }
-                json_stream << "        }\n";
-            }
-            json_stream << "      ],\n";
-
-            json_stream << "      \"Batter Outs Per Position\": [\n";
-            if (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, 0)){
-                json_stream << "        {\n";
-                for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos]) << comma << "\n";
-                    }
-                }
-                json_stream << "        }\n";
-            }
-            json_stream << "      ],\n";
-
-            json_stream << "      \"Outs Per Position\": [\n";
-            if (m_fielder_tracker[team].outsAtAnyPosition(roster, 0)){
-                json_stream << "        {\n";
-                for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].outsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos]) << comma << "\n";
-                    }
-                }
-                json_stream << "        }\n";
-            }
-            json_stream << "      ]\n";
-            json_stream << "    },\n";
-
-            //=== Offensive Stats ===
-            EndGameRosterOffensiveStats& of_stat = char_summary.end_game_offensive_stats;
-            json_stream << "    \"Offensive Stats\": {\n";
-            json_stream << "      \"At Bats\": "          << std::to_string(of_stat.at_bats) << ",\n";
-            json_stream << "      \"Hits\": "             << std::to_string(of_stat.hits) << ",\n";
-            json_stream << "      \"Singles\": "          << std::to_string(of_stat.singles) << ",\n";
-            json_stream << "      \"Doubles\": "          << std::to_string(of_stat.doubles) << ",\n";
-            json_stream << "      \"Triples\": "          << std::to_string(of_stat.triples) << ",\n";
-            json_stream << "      \"Homeruns\": "         << std::to_string(of_stat.homeruns) << ",\n";
-            json_stream << "      \"Successful Bunts\": " << std::to_string(of_stat.successful_bunts) << ",\n";
-            json_stream << "      \"Sac Flys\": "         << std::to_string(of_stat.sac_flys) << ",\n";
-            json_stream << "      \"Strikeouts\": "       << std::to_string(of_stat.strikouts) << ",\n";
-            json_stream << "      \"Walks (4 Balls)\": "  << std::to_string(of_stat.walks_4balls) << ",\n";
-            json_stream << "      \"Walks (Hit)\": "      << std::to_string(of_stat.walks_hit) << ",\n";
-            json_stream << "      \"RBI\": "              << std::to_string(of_stat.rbi) << ",\n";
-            json_stream << "      \"Bases Stolen\": "     << std::to_string(of_stat.bases_stolen) << ",\n";
-            json_stream << "      \"Star Hits\": "        << std::to_string(of_stat.star_hits) << "\n";
-            json_stream << "    }\n";
-            json_stream << "  },\n";
+void writePitch(StatJsonEmitter& emitter, StatTracker::Pitch& pitch, bool for_hud){
+    emitter.BeginObject("Pitch");
+    emitter.Field("Pitcher Team Id", pitch.pitcher_team_id);
+    emitter.DecodedField("Pitcher Char Id", DecodeType::Character, pitch.pitcher_char_id);
+    emitter.DecodedField("Pitch Type", DecodeType::Pitch, pitch.pitch_type);
+    emitter.DecodedField("Charge Type", DecodeType::ChargePitch, pitch.charge_type);
+    emitter.FloatField(pitch.charge_up.name, pitch.charge_up.get_value());
+    emitter.Field("Star Pitch", pitch.star_pitch);
+    emitter.Field("Pitch Speed", pitch.pitch_speed);
+    emitter.FloatField(pitch.pitch_target_x_pos.name, pitch.pitch_target_x_pos.get_value());
+    emitter.FloatField(pitch.pitch_release_x_pos.name, pitch.pitch_release_x_pos.get_value());
+    emitter.FloatField(pitch.pitch_release_y_pos.name, pitch.pitch_release_y_pos.get_value());
+    emitter.FloatField(pitch.pitch_release_z_pos.name, pitch.pitch_release_z_pos.get_value());
+    emitter.FloatField("Ball Position - Strikezone", pitch.ball_z_strike_vs_ball);
+    emitter.Field("In Strikezone", pitch.ball_in_strikezone);
+    emitter.FloatField(pitch.bat_contact_x_pos.name, pitch.bat_contact_x_pos.get_value());
+    emitter.FloatField(pitch.bat_contact_z_pos.name, pitch.bat_contact_z_pos.get_value());
+    emitter.Field("DB", pitch.db);
+    emitter.DecodedField("Type of Swing", DecodeType::Swing, pitch.type_of_swing);
+
+    //=== Pitch Curve ===
+    if (!for_hud){
+        emitter.BeginObject("Curve");
+        emitter.BeginArray("Curve Velocity");
+        for (const StatTracker::PitchCurve& curve : pitch.pitch_curve){
+            emitter.Value(emitter.tracker().floatConverter(curve.curve_velocity));
         }
+        emitter.EndArray(); // TODO add pitch inputs
+        emitter.EndObject();
     }
 
-    //=== Runners ===
-    //Build vector of <Runner*, Label/Name>
-    std::vector<std::pair<Runner*, std::string>> runners;
-    if (in_curr_event.runner_batter) {
-        runners.push_back({&in_curr_event.runner_batter.value(), "Batter"});
-    }
-    if (in_curr_event.runner_1) {
-        runners.push_back({&in_curr_event.runner_1.value(), "1B"});
+    //=== Contact ===
+    if (pitch.contact.has_value() && pitch.contact->type_of_contact.get_value() != 0xFF){
+        writeContact(emitter, pitch.contact.value(), for_hud);
     }
-    if (in_curr_event.runner_2) {
-        runners.push_back({&in_curr_event.runner_2.value(), "2B"});
+    emitter.EndObject();
+}
+}  // namespace
+
+StatTracker::StatJSONs StatTracker::getStatJSONs(){
+    //Generous estimate so the writers never need to grow mid-game-end
+    const size_t reserve = 64 * 1024 + m_game_info.events.size() * 4 * 1024;
+    StatJSONs jsons;
+    Common::JsonWriter decoded_writer(reserve);
+    Common::JsonWriter hidden_riokey_writer(reserve);
+    Common::JsonWriter full_writer(reserve);
+
+    const std::array<StatJsonEmitter::Target, 3> targets = {{
+        {&decoded_writer, true, true},
+        {&hidden_riokey_writer, false, true},
+        {&full_writer, false, false},
+    }};
+    StatJsonEmitter emitter(*this, targets);
+
+    //TODO switch to IDs when submitting game
+    LocalPlayers::LocalPlayers::Player away_player = m_game_info.getAwayTeamPlayer();
+    LocalPlayers::LocalPlayers::Player home_player = m_game_info.getHomeTeamPlayer();
+
+    emitter.BeginObject();
+    emitter.Field("GameID", std::to_string(m_game_info.game_id));
+    emitter.PerTargetField("Date - Start", [&](const StatJsonEmitter::Target& target) {
+        return target.decode ? m_game_info.start_local_date_time : m_game_info.start_unix_date_time;
+    });
+    emitter.PerTargetField("Date - End", [&](const StatJsonEmitter::Target& target) {
+        return target.decode ? m_game_info.end_local_date_time : m_game_info.end_unix_date_time;
+    });
+
+    if (m_game_info.tag_set_id.has_value()){
+        emitter.Field("TagSetID", m_game_info.tag_set_id.value());
     }
-    if (in_curr_event.runner_3) {
-        runners.push_back({&in_curr_event.runner_3.value(), "3B"});
+    else{
+        emitter.Field("TagSetID", "");
     }
+    emitter.Field("Netplay", static_cast<int>(m_game_info.netplay));
+    emitter.DecodedField("StadiumID", DecodeType::Stadium, m_game_info.stadium);
+    emitter.PerTargetField("Away Player", [&](const StatJsonEmitter::Target& target) {
+        return target.hide_riokey ? away_player.GetUsername() : away_player.GetUserID();
+    });
+    emitter.PerTargetField("Home Player", [&](const StatJsonEmitter::Target& target) {
+        return target.hide_riokey ? home_player.GetUsername() : home_player.GetUserID();
+    });
 
-    for (auto runner = runners.begin(); runner != runners.end(); runner++){
-        Runner* runner_info = runner->first;
-        std::string& label = runner->second;
-
-        json_stream << "  \"Runner " << label << "\": {\n";
-        json_stream << "    \"Runner Roster Loc\": "   << std::to_string(runner_info->roster_loc) << ",\n";
-        json_stream << "    \"Runner Char Id\": "      << decode("Character", runner_info->char_id, inDecode) << ",\n";
-        json_stream << "    \"Runner Initial Base\": " << std::to_string(runner_info->initial_base) << ",\n";
-        json_stream << "    \"Out Type\": "            << decode("Out", runner_info->out_type, inDecode) << ",\n";
-        json_stream << "    \"Out Location\": "        << std::to_string(runner_info->out_location) << ",\n";
-        //json_stream << "    \"Runner Basepath Location\": "  << std::to_string(runner_info->basepath_location) << ",\n";
-        json_stream << "    \"Steal\": "               << decode("Steal", runner_info->steal, inDecode) << ",\n";
-        json_stream << "    \"Runner Result Base\": "  << std::to_string(runner_info->result_base) << "\n";
-        std::string comma = (std::next(runner) == runners.end() && !in_prev_event.has_value() ) ? "" : ",";
-        json_stream << "  }" << comma << "\n";
+    emitter.Field("Away Score", m_game_info.away_score);
+    emitter.Field("Home Score", m_game_info.home_score);
+
+    emitter.Field("Innings Selected", m_game_info.innings_selected);
+    emitter.Field("Innings Played", m_game_info.innings_played);
+    emitter.DecodedField("Quitter Team", DecodeType::QuitterTeam, m_game_info.quitter_team);
+
+    emitter.Field("Average Ping", m_game_info.avg_ping);
+    emitter.Field("Lag Spikes", m_game_info.lag_spikes);
+    emitter.Field("Version", m_game_info.version);
+
+    emitter.BeginObject("Character Game Stats");
+    for (int team=0; team < cNumOfTeams; ++team){
+        u8 captain_roster_loc;
+        if (team == 0){
+            captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
+        }
+        else{ // team == 1
+            captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
+        }
+
+        for (int roster=0; roster < cRosterSize; ++roster){
+            writeCharacterSummary(emitter, team, roster, captain_roster_loc);
+        }
     }
+    emitter.EndObject();
 
-    //Previous Event - return if first event of game. Else write the event
-    if (!in_prev_event.has_value()){
-        json_stream << "}";
-        return json_stream.str();
+    //=== Events ===
+    emitter.BeginArray("Events");
+    for (auto& [event_num, event] : m_game_info.events) {
+        //Don't log events with inning == 0. Means game has crashed/quit and this is an empty event
+        if (event.inning == 0) {
+            continue;
+        }
+
+        emitter.BeginObject();
+        emitter.Field("Event Num", event_num);
+        emitter.Field("Inning", event.inning);
+        emitter.Field("Half Inning", event.half_inning);
+        emitter.Field("Away Score", event.away_score);
+        emitter.Field("Home Score", event.home_score);
+        emitter.Field("Balls", event.balls);
+        emitter.Field("Strikes", event.strikes);
+        emitter.Field("Outs", event.outs);
+        emitter.Field("Star Chance", event.is_star_chance);
+        emitter.Field("Away Stars", event.away_stars);
+        emitter.Field("Home Stars", event.home_stars);
+        emitter.Field("Pitcher Stamina", event.pitcher_stamina);
+        emitter.Field("Chemistry Links on Base", event.chem_links_ob);
+        emitter.Field("Pitcher Roster Loc", event.pitcher_roster_loc);
+        emitter.Field("Batter Roster Loc", event.batter_roster_loc);
+        emitter.Field("Catcher Roster Loc", event.catcher_roster_loc);
+        emitter.Field("RBI", event.rbi);
+        emitter.Field(event.num_outs_during_play.name, event.num_outs_during_play.get_value());
+        emitter.DecodedField("Result of AB", DecodeType::AtBatResult, event.result_of_atbat);
+
+        writeRunners(emitter, event);
+
+        if (event.pitch.has_value()){
+            writePitch(emitter, event.pitch.value(), false);
+        }
+        emitter.EndObject();
     }
+    emitter.EndArray();
+    emitter.EndObject();
 
-    //=== Pitch ===
-
-    json_stream << "  \"Previous Event\": {\n";
-    json_stream << "    \"RBI\": "                     << std::to_string(in_prev_event->rbi) << ",\n";
-    std::string comma = (in_prev_event->pitch.has_value()) ? "," : "";
-    json_stream << "    \"Result of AB\": "            << decode("AtBatResult", in_prev_event->result_of_atbat, inDecode) << comma << "\n";
-    if (in_prev_event->pitch.has_value()){
-        Pitch* pitch = &in_prev_event->pitch.value();
-        json_stream << "    \"Pitch\": {\n";
-        json_stream << "      \"Pitcher Team Id\": "    << std::to_string(pitch->pitcher_team_id) << ",\n";
-        json_stream << "      \"Pitcher Char Id\": "    << decode("Character", pitch->pitcher_char_id, inDecode) << ",\n";
-        json_stream << "      \"Pitch Type\": "         << decode("Pitch", pitch->pitch_type, inDecode) << ",\n";
-        json_stream << "      \"Charge Type\": "        << decode("ChargePitch", pitch->charge_type, inDecode) << ",\n";
-        json_stream << "        \"" << pitch->charge_up.name << "\": " << floatConverter(pitch->charge_up.get_value()) << ",\n";
-        json_stream << "      \"Star Pitch\": "         << std::to_string(pitch->star_pitch) << ",\n";
-        json_stream << "      \"Pitch Speed\": "        << std::to_string(pitch->pitch_speed) << ",\n";
-        json_stream << "        \"" << pitch->pitch_target_x_pos.name << "\": " << floatConverter(pitch->pitch_target_x_pos.get_value()) << ",\n";
-        json_stream << "        \"" << pitch->pitch_release_x_pos.name << "\": " << floatConverter(pitch->pitch_release_x_pos.get_value()) << ",\n";
-        json_stream << "        \"" << pitch->pitch_release_y_pos.name << "\": " << floatConverter(pitch->pitch_release_y_pos.get_value()) << ",\n";
-        json_stream << "        \"" << pitch->pitch_release_z_pos.name << "\": " << floatConverter(pitch->pitch_release_z_pos.get_value()) << ",\n";
-        json_stream << "      \"Ball Position - Strikezone\": "   << floatConverter(pitch->ball_z_strike_vs_ball) << ",\n";
-        json_stream << "      \"In Strikezone\": "      << std::to_string(pitch->ball_in_strikezone) << ",\n";
-        json_stream << "        \"" << pitch->bat_contact_x_pos.name << "\": " << floatConverter(pitch->bat_contact_x_pos.get_value()) << ",\n";
-        json_stream << "        \"" << pitch->bat_contact_z_pos.name << "\": " << floatConverter(pitch->bat_contact_z_pos.get_value()) << ",\n";
-        json_stream << "      \"DB\": "                 << std::to_string(pitch->db) << ",\n";
-        json_stream << "      \"Type of Swing\": "      << decode("Swing", pitch->type_of_swing, inDecode);
-        
-        //=== Contact ===
-        if (pitch->contact.has_value() && pitch->contact->type_of_contact.get_value() != 0xFF){
-            json_stream << ",\n";
-
-            Contact* contact = &pitch->contact.value();
-            json_stream << "      \"Contact\": {\n";
-            json_stream << "        \"" << contact->type_of_contact.name << "\":" << decode("Contact", contact->type_of_contact.get_value(), inDecode) << ",\n";
-            json_stream << "        \"" << contact->charge_power_up.name << "\": " << floatConverter(contact->charge_power_up.get_value()) << ",\n";
-            json_stream << "        \"" << contact->charge_power_down.name << "\": " << floatConverter(contact->charge_power_down.get_value()) << ",\n";
-            json_stream << "        \"" << contact->moon_shot.name << "\": " << contact->moon_shot.get_key_value_string().second << ",\n"; 
-            json_stream << "        \"" << contact->input_direction_push_pull.name << "\": " << decode("Stick", contact->input_direction_push_pull.get_value(), inDecode) << ",\n";
-            json_stream << "        \"" << contact->input_direction_stick.name << "\": " << decode("StickVec", contact->input_direction_stick.get_value(), inDecode) << ",\n";
-            json_stream << "        \"" << contact->frame_of_swing.name << "\": \"" << std::dec << contact->frame_of_swing.get_value() << "\",\n";
-            json_stream << "        \"" << contact->power.name << "\": \"" << std::dec << contact->power.get_value() <<"\",\n";
-            json_stream << "        \"" << contact->vert_angle.name << "\": \"" << std::dec << contact->vert_angle.get_value() << "\",\n";
-            json_stream << "        \"" << contact->horiz_angle.name << "\": \"" << std::dec << contact->horiz_angle.get_value() << "\",\n";
-            json_stream << "        \"" << contact->contact_absolute.name << "\": " << floatConverter(contact->contact_absolute.get_value()) << ",\n";
-            json_stream << "        \"" << contact->contact_quality.name << "\": " << floatConverter(contact->contact_quality.get_value()) << ",\n";
-            json_stream << "        \"" << contact->rng1.name << "\": \"" << std::dec << contact->rng1.get_value() << "\",\n";
-            json_stream << "        \"" << contact->rng2.name << "\": \"" << std::dec << contact->rng2.get_value() << "\",\n";
-            json_stream << "        \"" << contact->rng3.name << "\": \"" << std::dec << contact->rng3.get_value() << "\",\n";
-            json_stream << "        \"" << contact->ball_x_velo.name << "\": " << floatConverter(contact->ball_x_velo.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_y_velo.name << "\": " << floatConverter(contact->ball_y_velo.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_z_velo.name << "\": " << floatConverter(contact->ball_z_velo.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_contact_x_pos.name << "\": " << floatConverter(contact->ball_contact_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_contact_z_pos.name << "\": " << floatConverter(contact->ball_contact_z_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_x_pos.name << "\": " << floatConverter(contact->ball_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_y_pos.name << "\": " << floatConverter(contact->ball_y_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_z_pos.name << "\": " << floatConverter(contact->ball_z_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_hang_time.name << "\": " << std::dec << contact->ball_hang_time.get_value() << ",\n";
-            json_stream << "        \"" << contact->ball_max_height.name << "\": " << floatConverter(contact->ball_max_height.get_value()) << ",\n";
-            json_stream << "        \"Contact Result - Primary\": "         << decode("PrimaryContactResult", contact->primary_contact_result, inDecode) << ",\n";
-            json_stream << "        \"Contact Result - Secondary\": "       << decode("SecondaryContactResult", contact->secondary_contact_result, inDecode);
-
-            //=== Fielder ===
-            //TODO could be reworked
-            if (contact->first_fielder.has_value() || contact->collect_fielder.has_value()){
-                json_stream << ",\n";
-
-                //First fielder to touch the ball
-                Fielder* fielder;
-
-                //If the fielder bobbled but the same fielder collected the ball OR there was no bobble, log single fielder
-                
-                if (contact->first_fielder.has_value()) { fielder = &contact->first_fielder.value(); }
-                else {fielder = &contact->collect_fielder.value();}
-
-                json_stream << "        \"First Fielder\": {\n";
-                json_stream << "          \"Fielder Roster Location\": " << std::to_string(fielder->fielder_roster_loc) << ",\n";
-                json_stream << "          \"Fielder Position\": "        << decode("Position", fielder->fielder_pos, inDecode) << ",\n";
-                json_stream << "          \"Fielder Character\": "       << decode("Character", fielder->fielder_char_id, inDecode) << ",\n";
-                json_stream << "          \"Fielder Action\": "          << decode("Action", fielder->fielder_action, inDecode) << ",\n";
-                json_stream << "          \"Fielder Jump\": "            << std::to_string(fielder->fielder_jump) << ",\n";
-                json_stream << "          \"Fielder Swap\": "            << std::to_string(fielder->fielder_swapped_for_batter) << ",\n";
-                json_stream << "          \"Fielder Manual Selected\": " << decode("ManualSelect", fielder->fielder_manual_select_arg, inDecode) << ",\n";
-                json_stream << "          \"Fielder Position - X\": "    << floatConverter(fielder->fielder_x_pos) << ",\n";
-                json_stream << "          \"Fielder Position - Y\": "    << floatConverter(fielder->fielder_y_pos) << ",\n";
-                json_stream << "          \"Fielder Position - Z\": "    << floatConverter(fielder->fielder_z_pos) << ",\n";
-                json_stream << "          \"Fielder Bobble\": "          << decode("Bobble", fielder->bobble, inDecode) << "\n";
-                json_stream << "        }\n";
-            }
-            else{ //Finish contact section
-                json_stream << "\n";
-            }
-            json_stream << "      }\n"; //close contact
+    jsons.decoded = decoded_writer.TakeString();
+    jsons.hidden_riokey = hidden_riokey_writer.TakeString();
+    jsons.full = full_writer.TakeString();
+    return jsons;
+}
+
+const std::string& StatTracker::getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event>& in_prev_event, bool inDecode){
+    //Reused across events so the HUD does not allocate once the buffer has grown
+    m_hud_writer.Reset();
+
+    const std::array<StatJsonEmitter::Target, 1> targets = {{{&m_hud_writer, inDecode, true}}};
+    StatJsonEmitter emitter(*this, targets);
+
+    emitter.BeginObject();
+    if (in_curr_event.inning == 0) {
+        emitter.EndObject();
+        return m_hud_writer.GetString();
+    }
+
+    emitter.Field("Event Num", in_event_num);
+    emitter.Field("Away Player", m_game_info.getAwayTeamPlayer().GetUsername());
+    emitter.Field("Home Player", m_game_info.getHomeTeamPlayer().GetUsername());
+    emitter.Field("Inning", in_curr_event.inning);
+    emitter.Field("Half Inning", in_curr_event.half_inning);
+    emitter.Field("Away Score", in_curr_event.away_score);
+    emitter.Field("Home Score", in_curr_event.home_score);
+    emitter.Field("Balls", in_curr_event.balls);
+    emitter.Field("Strikes", in_curr_event.strikes);
+    emitter.Field("Outs", in_curr_event.outs);
+    emitter.Field("Star Chance", in_curr_event.is_star_chance);
+    emitter.Field("Away Stars", in_curr_event.away_stars);
+    emitter.Field("Home Stars", in_curr_event.home_stars);
+    emitter.Field("Pitcher Stamina", in_curr_event.pitcher_stamina);
+    emitter.Field("Chemistry Links on Base", in_curr_event.chem_links_ob);
+    emitter.Field(in_curr_event.num_outs_during_play.name, in_curr_event.num_outs_during_play.get_value());
+    emitter.Field("Pitcher Roster Loc", in_curr_event.pitcher_roster_loc);
+    emitter.Field("Batter Roster Loc", in_curr_event.batter_roster_loc);
+
+    for (int team=0; team < cNumOfTeams; ++team){
+        u8 captain_roster_loc = 0;
+        if (team == 0){
+            captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
+        }
+        else{ // team == 1
+            captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
+        }
+
+        for (int roster=0; roster < cRosterSize; ++roster){
+            writeCharacterSummary(emitter, team, roster, captain_roster_loc);
         }
-        else { //Finish pitch section
-            json_stream << "\n";
+    }
+
+    writeRunners(emitter, in_curr_event);
+
+    //Previous Event - omitted on the first event of the game
+    if (in_prev_event.has_value()){
+        emitter.BeginObject("Previous Event");
+        emitter.Field("RBI", in_prev_event->rbi);
+        emitter.DecodedField("Result of AB", DecodeType::AtBatResult, in_prev_event->result_of_atbat);
+        if (in_prev_event->pitch.has_value()){
+            writePitch(emitter, in_prev_event->pitch.value(), true);
         }
-        json_stream << "    }\n"; //Close pitch
+        emitter.EndObject();
+    }
+
+    emitter.EndObject();
+    return m_hud_writer.GetString();
+}
+
+void StatTracker::publishHUD(std::string in_event_num){
+    Event& event = m_game_info.getCurrentEvent();
+
+    if (m_hud->IsDeltaEnabled()){
+        const std::optional<Event>& prev_event = m_game_info.previous_state;
+        const u8 batting_team = event.half_inning;
+        const CharacterSummary& batter = m_game_info.character_summaries[batting_team][event.batter_roster_loc % cRosterSize];
+        const CharacterSummary& pitcher = m_game_info.character_summaries[!batting_team][event.pitcher_roster_loc % cRosterSize];
+        const auto runner_loc = [](const std::optional<Runner>& runner) {
+            return runner.has_value() ? static_cast<s32>(runner->roster_loc) : -1;
+        };
+
+        m_hud_state.event_num = std::move(in_event_num);
+        m_hud_state.away_player = m_game_info.getAwayTeamPlayer().GetUsername();
+        m_hud_state.home_player = m_game_info.getHomeTeamPlayer().GetUsername();
+
+        auto& values = m_hud_state.values;
+        values[HudState::INNING] = event.inning;
+        values[HudState::HALF_INNING] = event.half_inning;
+        values[HudState::AWAY_SCORE] = event.away_score;
+        values[HudState::HOME_SCORE] = event.home_score;
+        values[HudState::BALLS] = event.balls;
+        values[HudState::STRIKES] = event.strikes;
+        values[HudState::OUTS] = event.outs;
+        values[HudState::STAR_CHANCE] = event.is_star_chance;
+        values[HudState::AWAY_STARS] = event.away_stars;
+        values[HudState::HOME_STARS] = event.home_stars;
+        values[HudState::CHEMISTRY_LINKS_ON_BASE] = event.chem_links_ob;
+        values[HudState::NUM_OUTS_DURING_PLAY] = event.num_outs_during_play.get_value();
+        values[HudState::RUNNER_1B] = runner_loc(event.runner_1);
+        values[HudState::RUNNER_2B] = runner_loc(event.runner_2);
+        values[HudState::RUNNER_3B] = runner_loc(event.runner_3);
+        values[HudState::BATTER_ROSTER_LOC] = event.batter_roster_loc;
+        values[HudState::BATTER_CHAR_ID] = batter.char_id;
+        values[HudState::BATTER_AT_BATS] = batter.end_game_offensive_stats.at_bats;
+        values[HudState::BATTER_HITS] = batter.end_game_offensive_stats.hits;
+        values[HudState::BATTER_HOMERUNS] = batter.end_game_offensive_stats.homeruns;
+        values[HudState::BATTER_RBI] = batter.end_game_offensive_stats.rbi;
+        values[HudState::BATTER_STRIKEOUTS] = batter.end_game_offensive_stats.strikouts;
+        values[HudState::PITCHER_ROSTER_LOC] = event.pitcher_roster_loc;
+        values[HudState::PITCHER_CHAR_ID] = pitcher.char_id;
+        values[HudState::PITCHER_STAMINA] = event.pitcher_stamina;
+        values[HudState::PITCHER_PITCHES_THROWN] = pitcher.end_game_defensive_stats.pitches_thrown;
+        values[HudState::PITCHER_BATTERS_FACED] = pitcher.end_game_defensive_stats.batters_faced;
+        values[HudState::PITCHER_STRIKEOUTS] = pitcher.end_game_defensive_stats.strike_outs;
+        values[HudState::PITCHER_RUNS_ALLOWED] = pitcher.end_game_defensive_stats.runs_allowed;
+        values[HudState::PREVIOUS_RBI] = prev_event ? prev_event->rbi : -1;
+        values[HudState::PREVIOUS_RESULT_OF_AB] = prev_event ? prev_event->result_of_atbat : -1;
+
+        m_hud->PublishDelta(m_hud_state);
+        in_event_num = m_hud_state.event_num;
+    }
+
+    if (m_hud->IsFileEnabled()){
+        m_hud->PublishFile(getHUDJSON(std::move(in_event_num), event, m_game_info.previous_state, true));
     }
-    json_stream << "  }\n"; //Close Previous Event
-    json_stream << "}";
-    return json_stream.str();
 }
 
 //Scans player for possession
-std::optional<StatTracker::Fielder> StatTracker::logFielderWithBall(const Core::CPUThreadGuard& guard) {
+std::optional<StatTracker::Fielder> StatTracker::logFielderWithBall(const Core::FrameSnapshot& frame) {
     std::optional<Fielder> fielder;
     for (u8 pos=0; pos < cRosterSize; ++pos){
         u32 aFielderControlStatus = aFielder_ControlStatus + (pos * cFielder_Offset);
@@ -1594,27 +1481,27 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderWithBall(const Core::
         u32 aFielderRosterLoc = aFielder_RosterLoc + (pos * cFielder_Offset);
         u32 aFielderCharId = aFielder_CharId + (pos * cFielder_Offset);
 
-        bool fielder_has_ball = (PowerPC::MMU::HostRead_U8(guard, aFielderControlStatus) == 0xA);
+        bool fielder_has_ball = (frame.Read_U8(aFielderControlStatus) == 0xA);
 
         if (fielder_has_ball) {
             Fielder fielder_with_ball;
             //get char id
-            fielder_with_ball.fielder_roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc);
-            fielder_with_ball.fielder_char_id = PowerPC::MMU::HostRead_U8(guard, aFielderCharId);
+            fielder_with_ball.fielder_roster_loc = frame.Read_U8(aFielderRosterLoc);
+            fielder_with_ball.fielder_char_id = frame.Read_U8(aFielderCharId);
             fielder_with_ball.fielder_pos = pos;
 
-            fielder_with_ball.fielder_x_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosX);
-            fielder_with_ball.fielder_y_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosY);
-            fielder_with_ball.fielder_z_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosZ);
+            fielder_with_ball.fielder_x_pos = frame.Read_U32(aFielderPosX);
+            fielder_with_ball.fielder_y_pos = frame.Read_U32(aFielderPosY);
+            fielder_with_ball.fielder_z_pos = frame.Read_U32(aFielderPosZ);
 
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderAction)) {
-                fielder_with_ball.fielder_action = PowerPC::MMU::HostRead_U8(guard, aFielderAction); //2 = Slide, 3 = Walljump
+            if (frame.Read_U8(aFielderAction)) {
+                fielder_with_ball.fielder_action = frame.Read_U8(aFielderAction); //2 = Slide, 3 = Walljump
             }
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderJump)) {
-                fielder_with_ball.fielder_jump = PowerPC::MMU::HostRead_U8(guard, aFielderJump); //1 = jump
+            if (frame.Read_U8(aFielderJump)) {
+                fielder_with_ball.fielder_jump = frame.Read_U8(aFielderJump); //1 = jump
             }
 
-            fielder_with_ball.fielder_manual_select_arg = PowerPC::MMU::HostRead_U8(guard, aFielder_ManualSelectArg);
+            fielder_with_ball.fielder_manual_select_arg = frame.Read_U8(aFielder_ManualSelectArg);
 
             std::cout << "Fielder Pos=" << std::to_string(pos) << " Fielder RosterLoc=" << std::to_string(fielder_with_ball.fielder_roster_loc)
                       << " Fielder Action: " << std::to_string(fielder_with_ball.fielder_action)
@@ -1629,7 +1516,7 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderWithBall(const Core::
     return std::nullopt;
 }
 
-std::optional<StatTracker::Fielder> StatTracker::logFielderBobble(const Core::CPUThreadGuard& guard) {
+std::optional<StatTracker::Fielder> StatTracker::logFielderBobble(const Core::FrameSnapshot& frame) {
     std::optional<Fielder> fielder;
     for (u8 pos=0; pos < cRosterSize; ++pos){
         u32 aFielderBobbleStatus = aFielder_Bobble + (pos * cFielder_Offset);
@@ -1646,8 +1533,8 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderBobble(const Core::CP
         u32 aFielderCharId = aFielder_CharId + (pos * cFielder_Offset);
         
         u8 typeOfFielderDisruption = 0x0;
-        u8 bobble_addr = PowerPC::MMU::HostRead_U8(guard, aFielderBobbleStatus);
-        u8 knockout_addr = PowerPC::MMU::HostRead_U8(guard, aFielderKnockoutStatus);
+        u8 bobble_addr = frame.Read_U8(aFielderBobbleStatus);
+        u8 knockout_addr = frame.Read_U8(aFielderKnockoutStatus);
 
         if (knockout_addr) {
             typeOfFielderDisruption = 0x10; //Knockout - no bobble
@@ -1659,24 +1546,24 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderBobble(const Core::CP
         if (typeOfFielderDisruption > 0x1) {
             Fielder fielder_that_bobbled;
             //get char id
-            fielder_that_bobbled.fielder_roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc);
-            fielder_that_bobbled.fielder_char_id = PowerPC::MMU::HostRead_U8(guard, aFielderCharId);
+            fielder_that_bobbled.fielder_roster_loc = frame.Read_U8(aFielderRosterLoc);
+            fielder_that_bobbled.fielder_char_id = frame.Read_U8(aFielderCharId);
 
-            fielder_that_bobbled.fielder_x_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosX);
-            fielder_that_bobbled.fielder_y_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosY);
-            fielder_that_bobbled.fielder_z_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosZ);
+            fielder_that_bobbled.fielder_x_pos = frame.Read_U32(aFielderPosX);
+            fielder_that_bobbled.fielder_y_pos = frame.Read_U32(aFielderPosY);
+            fielder_that_bobbled.fielder_z_pos = frame.Read_U32(aFielderPosZ);
             fielder_that_bobbled.fielder_pos = pos;
             fielder_that_bobbled.bobble = typeOfFielderDisruption;
 
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderAction)) {
-                fielder_that_bobbled.fielder_action = PowerPC::MMU::HostRead_U8(guard, aFielderAction); //2 = Slide, 3 = Walljump
+            if (frame.Read_U8(aFielderAction)) {
+                fielder_that_bobbled.fielder_action = frame.Read_U8(aFielderAction); //2 = Slide, 3 = Walljump
             }
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderJump)) {
-                fielder_that_bobbled.fielder_jump = PowerPC::MMU::HostRead_U8(guard, aFielderJump); //1 = jump
+            if (frame.Read_U8(aFielderJump)) {
+                fielder_that_bobbled.fielder_jump = frame.Read_U8(aFielderJump); //1 = jump
             }
 
             //We can read manual select now because we don't have the ball
-            fielder_that_bobbled.fielder_manual_select_arg = PowerPC::MMU::HostRead_U8(guard, aFielder_ManualSelectArg);
+            fielder_that_bobbled.fielder_manual_select_arg = frame.Read_U8(aFielder_ManualSelectArg);
 
             std::cout << "Fielder Pos=" << std::to_string(pos) << " Fielder RosterLoc=" << std::to_string(fielder_that_bobbled.fielder_roster_loc)
                       << " Fielder Action: " << std::to_string(fielder_that_bobbled.fielder_action) 
@@ -1775,19 +1662,20 @@ void StatTracker::setGameID(u32 gameID)
   m_game_info.game_id = gameID;
 }
 
-void StatTracker::initPlayerInfo(const Core::CPUThreadGuard& guard){
+void StatTracker::initPlayerInfo(const Core::FrameSnapshot& frame){
     //Read start time
     std::time_t unix_time = std::time(nullptr);
     m_game_info.start_unix_date_time = std::to_string(unix_time);
     m_game_info.start_local_date_time = std::asctime(std::localtime(&unix_time));
     m_game_info.start_local_date_time.pop_back();
+    m_game_info.version = Common::GetRioRevStr();
     //Collect port info for players
     if (m_game_info.team0_port == 0xFF && m_game_info.team1_port == 0xFF){
         //From Roeming
-        std::array<u8, 2> ports = {PowerPC::MMU::HostRead_U8(guard, 0x800e874c), PowerPC::MMU::HostRead_U8(guard, 0x800e874d)};
+        std::array<u8, 2> ports = {frame.Read_U8(0x800e874c), frame.Read_U8(0x800e874d)};
         
-        u8 BattingPort = ports[PowerPC::MMU::HostRead_U32(guard, 0x80892990)];
-        u8 FieldingPort = ports[PowerPC::MMU::HostRead_U32(guard, 0x80892994)];
+        u8 BattingPort = ports[frame.Read_U32(0x80892990)];
+        u8 FieldingPort = ports[frame.Read_U32(0x80892994)];
         
         m_game_info.team0_port = ports[0];
         m_game_info.team1_port = ports[1];
@@ -1809,22 +1697,22 @@ void StatTracker::initPlayerInfo(const Core::CPUThreadGuard& guard){
             home_player_name = m_game_info.team0_player.GetUsername();
         }
 
-        std::cout << "ports[0]=" << std::to_string(PowerPC::MMU::HostRead_U8(guard, 0x800e874c)) << " ports[1]=" << std::to_string(PowerPC::MMU::HostRead_U8(guard, 0x800e874d)) << "\n";
-        std::cout << "BattingPort=" << std::to_string(PowerPC::MMU::HostRead_U32(guard, 0x80892990)) << " FieldingPort=" << std::to_string(PowerPC::MMU::HostRead_U32(guard, 0x80892994)) << "\n";
+        std::cout << "ports[0]=" << std::to_string(frame.Read_U8(0x800e874c)) << " ports[1]=" << std::to_string(frame.Read_U8(0x800e874d)) << "\n";
+        std::cout << "BattingPort=" << std::to_string(frame.Read_U32(0x80892990)) << " FieldingPort=" << std::to_string(frame.Read_U32(0x80892994)) << "\n";
 
         std::cout << "Info:  Fielder Port=" << std::to_string(FieldingPort) << ", Batter Port=" << std::to_string(BattingPort) << "\n";
         std::cout << "Info:  Team0 Port=" << std::to_string(m_game_info.team0_port) << ", Team1 Port=" << std::to_string(m_game_info.team1_port) << "\n";
         std::cout << "Info:  Away Port=" << std::to_string(m_game_info.away_port) << ", Home Port=" << std::to_string(m_game_info.home_port) << "\n";
         std::cout << "Info:  Away Player=" << (away_player_name) << ", Home Player=" << (home_player_name) << "\n";
 
-        initCaptains(guard);
+        initCaptains(frame);
     }
 }
 
-void StatTracker::initCaptains(const Core::CPUThreadGuard& guard)
+void StatTracker::initCaptains(const Core::FrameSnapshot& frame)
 {
-    m_game_info.team0_captain_roster_loc = PowerPC::MMU::HostRead_U8(guard, aTeam0_Captain_Roster_Loc);
-    m_game_info.team1_captain_roster_loc = PowerPC::MMU::HostRead_U8(guard, aTeam1_Captain_Roster_Loc);
+    m_game_info.team0_captain_roster_loc = frame.Read_U8(aTeam0_Captain_Roster_Loc);
+    m_game_info.team1_captain_roster_loc = frame.Read_U8(aTeam1_Captain_Roster_Loc);
 
     u8 away_captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
     u8 home_captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
@@ -1833,227 +1721,72 @@ void StatTracker::initCaptains(const Core::CPUThreadGuard& guard)
     std::cout << "Info:  Away Captain=" << std::to_string(away_captain_roster_loc) << ", Home Captain=" << (std::to_string(home_captain_roster_loc)) << "\n\n";
 }
 
-void StatTracker::onGameQuit(const Core::CPUThreadGuard& guard){
-    u8 quitter_port = PowerPC::MMU::HostRead_U8(guard, aWhoQuit);
+void StatTracker::onGameQuit(const Core::FrameSnapshot& frame){
+    u8 quitter_port = frame.Read_U8(aWhoQuit);
     m_game_info.quitter_team = (quitter_port == m_game_info.away_port);
-    logGameInfo(guard);
+    logGameInfo(frame);
 
     std::cout << "Quit detected\n";
 
     //Game has ended. Write file but do not submit
-    std::string jsonPath = getStatJsonPath("quit.decode.");
-    std::string json = getStatJSON(true);
-    
-    File::WriteStringToFile(jsonPath, json);
-
-    jsonPath = getStatJsonPath("quit.");
-    json = getStatJSON(false, true);
-    
-    File::WriteStringToFile(jsonPath, json);
-
-    // json = getStatJSON(false, false);
-    // if (shouldSubmitGame()) {
-    //     const Common::HttpRequest::Response response =
-    //     m_http.Post("https://api.projectrio.app/populate_db/", json,
-    //         {
-    //             {"Content-Type", "application/json"},
-    //         }
-    //     );
-    // }
+    writeStatFiles("quit.", "quit.decode.");
 }
 
-std::optional<StatTracker::Runner> StatTracker::logRunnerInfo(const Core::CPUThreadGuard& guard, u8 base){
+std::optional<StatTracker::Runner> StatTracker::logRunnerInfo(const Core::FrameSnapshot& frame, u8 base){
     std::optional<Runner> runner;
     //See if there is a runner in this pos
-    if (PowerPC::MMU::HostRead_U8(guard, aRunner_RosterLoc + (base * cRunner_Offset)) != 0xFF){
+    if (frame.Read_U8(aRunner_RosterLoc + (base * cRunner_Offset)) != 0xFF){
         Runner init_runner;
-        init_runner.roster_loc = PowerPC::MMU::HostRead_U8(guard, aRunner_RosterLoc + (base * cRunner_Offset));
-        init_runner.char_id = PowerPC::MMU::HostRead_U8(guard, aRunner_CharId + (base * cRunner_Offset));
+        init_runner.roster_loc = frame.Read_U8(aRunner_RosterLoc + (base * cRunner_Offset));
+        init_runner.char_id = frame.Read_U8(aRunner_CharId + (base * cRunner_Offset));
         init_runner.initial_base = base;
-        init_runner.basepath_location = PowerPC::MMU::HostRead_U32(guard, aRunner_BasepathPercentage + (base * cRunner_Offset));
+        init_runner.basepath_location = frame.Read_U32(aRunner_BasepathPercentage + (base * cRunner_Offset));
         runner = std::make_optional(init_runner);
         return runner;        
     }
     return runner;
 }
 
-bool StatTracker::anyRunnerStealing(const Core::CPUThreadGuard& guard, Event& in_event)
+bool StatTracker::anyRunnerStealing(const Core::FrameSnapshot& frame, Event& in_event)
 {
-    u8 runner_1_stealing = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (1 * cRunner_Offset));
-    u8 runner_2_stealing = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (2 * cRunner_Offset));
-    u8 runner_3_stealing = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (3 * cRunner_Offset));
+    u8 runner_1_stealing = frame.Read_U8(aRunner_Stealing + (1 * cRunner_Offset));
+    u8 runner_2_stealing = frame.Read_U8(aRunner_Stealing + (2 * cRunner_Offset));
+    u8 runner_3_stealing = frame.Read_U8(aRunner_Stealing + (3 * cRunner_Offset));
 
     return (runner_1_stealing || runner_2_stealing || runner_3_stealing);
 }
 
-void StatTracker::logRunnerEvents(const Core::CPUThreadGuard& guard, Runner* in_runner){
+void StatTracker::logRunnerEvents(const Core::FrameSnapshot& frame, Runner* in_runner){
     //Return if no runner
     if (in_runner->out_type != 0 ) { return; }
 
     //Return if runner has already gotten out
-    in_runner->out_type = PowerPC::MMU::HostRead_U8(guard, aRunner_OutType + (in_runner->initial_base * cRunner_Offset));
+    in_runner->out_type = frame.Read_U8(aRunner_OutType + (in_runner->initial_base * cRunner_Offset));
     if (in_runner->out_type != 0) {
-        in_runner->out_location = PowerPC::MMU::HostRead_U8(guard, aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
+        in_runner->out_location = frame.Read_U8(aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
         in_runner->result_base = 0xFF;
-        in_runner->basepath_location = PowerPC::MMU::HostRead_U32(guard, aRunner_BasepathPercentage + (in_runner->initial_base * cRunner_Offset));
+        in_runner->basepath_location = frame.Read_U32(aRunner_BasepathPercentage + (in_runner->initial_base * cRunner_Offset));
 
         std::cout << "Logging Runner " << std::to_string(in_runner->initial_base) << ": Out. Type=" << std::to_string(in_runner->out_type)
         << " Location=" << std::to_string(in_runner->out_location) << "\n";
     }
     else{
-        in_runner->result_base = PowerPC::MMU::HostRead_U8(guard, aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
+        in_runner->result_base = frame.Read_U8(aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
     }
 
-    if (PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (in_runner->initial_base * cRunner_Offset)) > in_runner->steal){
-        in_runner->steal = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (in_runner->initial_base * cRunner_Offset));
+    if (frame.Read_U8(aRunner_Stealing + (in_runner->initial_base * cRunner_Offset)) > in_runner->steal){
+        in_runner->steal = frame.Read_U8(aRunner_Stealing + (in_runner->initial_base * cRunner_Offset));
         std::cout << "Logging Runner " << std::to_string(in_runner->initial_base) << ": Steal. Type=" << std::to_string(in_runner->steal)<< "\n";
     }
 }
 
-std::string StatTracker::decode(std::string type, u8 value, bool decode){
+std::string StatTracker::decode(DecodeType type, u8 value, bool decode){
     if (!decode) { return std::to_string(value);}
 
-    std::string retVal = "Unable to Decode";
-    
-    if (type == "Character"){
-        if (cCharIdToCharName.count(value)){
-            retVal = cCharIdToCharName.at(value);
-        }
-    }
-    else if (type == "Stadium"){
-        if (cStadiumIdToStadiumName.count(value)){
-            retVal = cStadiumIdToStadiumName.at(value);
-        }
-    }
-    else if (type == "Contact"){
-        if (cTypeOfContactToHR.count(value)){
-            retVal = cTypeOfContactToHR.at(value);
-        }
-    }
-    else if (type == "Hand"){
-        if (cHandToHR.count(value)){
-            retVal = cHandToHR.at(value);
-        }
-    }
-    else if (type == "Stick"){
-        if (cInputDirectionToHR.count(value)){
-            retVal = cInputDirectionToHR.at(value);
-        }
-    }
-    else if (type == "StickVec"){
-        retVal = "";
-        if ( (value & 0x1) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Left";
-        }
-        if ( (value & 0x2) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Right";
-        } 
-        if ( (value & 0x4) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Down";
-        } 
-        if ( (value & 0x8) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Up";
-        } 
-    }
-    else if (type == "Pitch"){
-        if (cPitchTypeToHR.count(value)){
-            retVal = cPitchTypeToHR.at(value);
-        }
-    }
-    else if (type == "ChargePitch"){
-        if (cChargePitchTypeToHR.count(value)){
-            retVal = cChargePitchTypeToHR.at(value);
-        }
-    }
-    else if (type == "Swing"){
-        if (cTypeOfSwing.count(value)){
-            retVal = cTypeOfSwing.at(value);
-        }
-    }
-    else if (type == "Position"){
-        if (cPosition.count(value)){
-            retVal = cPosition.at(value);
-        }
-    }
-    else if (type == "Action"){
-        if (cFielderActions.count(value)){
-            retVal = cFielderActions.at(value);
-        }
-    }
-    else if (type == "Bobble"){
-        if (cFielderBobbles.count(value)){
-            retVal = cFielderBobbles.at(value);
-        }
-    }
-    else if (type == "ManualSelect"){
-        if (cManualSelectDecode.count(value)){
-            retVal = cManualSelectDecode.at(value);
-        }
-    }
-    else if (type == "Steal"){
-        if (cStealType.count(value)){
-            retVal = cStealType.at(value);
-        }
-    }
-    else if (type == "Out"){
-        if (cOutType.count(value)){
-            retVal = cOutType.at(value);
-        }
-    }
-    else if (type == "PrimaryContactResult"){
-        if (cPrimaryContactResult.count(value)){
-            retVal = cPrimaryContactResult.at(value);
-        }
-    }
-    else if (type == "SecondaryContactResult"){
-        if (cSecondaryContactResult.count(value)){
-            retVal = cSecondaryContactResult.at(value);
-        }
-    }
-    else if (type == "PitchResult"){
-        if (cPitchResult.count(value)){
-            retVal = cPitchResult.at(value);
-        }
+    if (std::optional<std::string_view> name = decodeName(type, value)){
+        return fmt::format("\"{}\"", *name);
     }
-    else if (type == "AtBatResult"){
-        if (cAtBatResult.count(value)){
-            retVal = cAtBatResult.at(value);
-        }
-    }
-    else if (type == "QuitterTeam"){
-        if (value == 0){
-            retVal = "Home";
-        }
-        else if (value == 1){
-            retVal = "Away";
-        }
-        else if (value == 2){
-            retVal = "Crash";
-        }
-        else if (value == 0xFF){
-            retVal = "None";
-        }
-    }
-    else{
-        retVal += ". Invalid Type (" + type + ")";
-    }
-    
-    if (retVal == "Unable to Decode"){
-        retVal += ". Invalid Value (" + std::to_string(value) + ").";
-    }
-    return ("\"" + retVal + "\"");
+    return fmt::format("\"Unable to Decode. Invalid Value ({}).\"", value);
 }
 
 void StatTracker::postOngoingGame(Event& in_curr_event){
@@ -2073,7 +1806,7 @@ void StatTracker::postOngoingGame(Event& in_curr_event){
         tag_set_id_str = std::to_string(m_game_info.tag_set_id.value());
     }
     json_stream << "  \"TagSetID\": " << tag_set_id_str << ",\n";
-    json_stream << "  \"StadiumID\": " << decode("Stadium", m_game_info.stadium, false) << ",\n";
+    json_stream << "  \"StadiumID\": " << decode(DecodeType::Stadium, m_game_info.stadium, false) << ",\n";
     json_stream << "  \"Away Player\": \""           << m_game_info.getAwayTeamPlayer().GetUserID() << "\",\n";
     json_stream << "  \"Home Player\": \""           << m_game_info.getHomeTeamPlayer().GetUserID() << "\",\n";
 
@@ -2107,12 +1840,7 @@ void StatTracker::postOngoingGame(Event& in_curr_event){
     json_stream << "  \"Pitcher\": "                 << std::to_string(in_curr_event.pitcher_roster_loc) << "\n";
     json_stream << "}\n";
 
-    const Common::HttpRequest::Response response =
-        m_http.Post("https://api.projectrio.app/populate_db/ongoing_game/", json_stream.str(),
-            {
-                {"Content-Type", "application/json"},
-            }
-        );
+    m_uploader->SubmitOngoingGame(json_stream.str());
 }
 void StatTracker::updateOngoingGame(Event& in_curr_event){
     if (!shouldSubmitGame()){ return; }
@@ -2142,10 +1870,5 @@ void StatTracker::updateOngoingGame(Event& in_curr_event){
     json_stream << "  \"Runner 3B\": "       << std::to_string(runner_3) << "\n";
     json_stream << "}\n";
 
-    const Common::HttpRequest::Response response =
-        m_http.Post("https://api.projectrio.app/populate_db/ongoing_game/", json_stream.str(),
-            {
-                {"Content-Type", "application/json"},
-            }
-        );
+    m_uploader->SubmitOngoingGame(json_stream.str());
 }
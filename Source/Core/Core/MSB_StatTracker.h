@@ -1,9 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <array>
+#include <initializer_list>
 #include <vector>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <tuple>
 #include <iostream>
@@ -11,12 +15,15 @@
 #include <picojson.h>
 
 #include "Common/HttpRequest.h"
+#include "Common/JsonWriter.h"
 
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 
 #include "Core/LocalPlayers.h"
 #include "Core/Logger.h"
+#include "Core/MSB_HudPublisher.h"
+#include "Core/MSB_StatUploader.h"
 #include "Core/TrackerAdr.h"
 
 namespace Tag {
@@ -31,12 +38,16 @@ enum class GAME_STATE
   UNDEFINED
 };
 
-static std::map<GAME_STATE, std::string> c_game_state = {
-    {GAME_STATE::PREGAME, "PREGAME"},
-    {GAME_STATE::INGAME, "INGAME"},
-    {GAME_STATE::ENDGAME_LOGGED, "ENDGAME_LOGGED"},
-    {GAME_STATE::UNDEFINED, "UNDEFINED"}
+//Indexed by GAME_STATE
+inline constexpr std::array<std::string_view, 4> c_game_state = {
+    "PREGAME",
+    "INGAME",
+    "ENDGAME_LOGGED",
+    "UNDEFINED"
 };
+static_assert(c_game_state.size() == static_cast<size_t>(GAME_STATE::UNDEFINED) + 1);
+
+constexpr std::string_view toString(GAME_STATE state) { return c_game_state[static_cast<size_t>(state)]; }
 
 enum class EVENT_STATE
 {
@@ -52,24 +63,56 @@ enum class EVENT_STATE
     UNDEFINED
 };
 
-static std::map<EVENT_STATE, std::string> c_event_state = {
-    {EVENT_STATE::INIT_EVENT, "INIT_EVENT"},
-    {EVENT_STATE::PITCH_RESULT, "PITCH_RESULT"},
-    {EVENT_STATE::CONTACT_RESULT, "CONTACT_RESULT"},
-    {EVENT_STATE::LOG_FIELDER, "LOG_FIELDER"},
-    {EVENT_STATE::MONITOR_RUNNERS, "MONITOR_RUNNERS"},
-    {EVENT_STATE::PLAY_OVER, "PLAY_OVER"},
-    {EVENT_STATE::FINAL_RESULT, "FINAL_RESULT"},
-    {EVENT_STATE::WAITING_FOR_EVENT, "WAITING_FOR_EVENT"},
-    {EVENT_STATE::GAME_OVER, "GAME_OVER"},
-    {EVENT_STATE::UNDEFINED, "UNDEFINED"}
+//Indexed by EVENT_STATE
+inline constexpr std::array<std::string_view, 10> c_event_state = {
+    "INIT_EVENT",
+    "PITCH_RESULT",
+    "CONTACT_RESULT",
+    "LOG_FIELDER",
+    "MONITOR_RUNNERS",
+    "PLAY_OVER",
+    "FINAL_RESULT",
+    "WAITING_FOR_EVENT",
+    "GAME_OVER",
+    "UNDEFINED"
 };
+static_assert(c_event_state.size() == static_cast<size_t>(EVENT_STATE::UNDEFINED) + 1);
+
+constexpr std::string_view toString(EVENT_STATE state) { return c_event_state[static_cast<size_t>(state)]; }
 
 
 
 //Conversion Maps
 
-static const std::map<u8, std::string> cCharIdToCharName = {
+//Id to name table, indexed directly by the id. Built at compile time
+struct DecodeEntry{
+    u8 id;
+    std::string_view name;
+};
+
+class DecodeTable{
+public:
+    constexpr DecodeTable(std::initializer_list<DecodeEntry> entries){
+        for (const DecodeEntry& entry : entries){
+            m_names[entry.id] = entry.name;
+        }
+    }
+
+    constexpr std::optional<std::string_view> lookup(u8 id) const{
+        if (m_names[id].data() == nullptr){
+            return std::nullopt;
+        }
+        return m_names[id];
+    }
+
+    //Empty for unknown ids
+    constexpr std::string_view operator[](u8 id) const { return m_names[id]; }
+
+private:
+    std::array<std::string_view, 256> m_names{};
+};
+
+inline constexpr DecodeTable cCharIdToCharName = {
     {0x0, "Mario"},
     {0x1, "Luigi"},
     {0x2, "DK"},
@@ -126,7 +169,7 @@ static const std::map<u8, std::string> cCharIdToCharName = {
     {0x35, "Bro(B)"}
 };
 
-static const std::map<u8, std::string> cStadiumIdToStadiumName = {
+inline constexpr DecodeTable cStadiumIdToStadiumName = {
     {0x0, "Mario Stadium"},
     {0x1, "Bowser Castle"},
     {0x2, "Wario Palace"},
@@ -136,7 +179,7 @@ static const std::map<u8, std::string> cStadiumIdToStadiumName = {
     {0x6, "Toy Field"}
 };
 
-static const std::map<u8, std::string> cTypeOfContactToHR = {
+inline constexpr DecodeTable cTypeOfContactToHR = {
     {0xFF, "Miss"},
     {0, "Sour - Left"},
     {1, "Nice - Left"}, 
@@ -145,30 +188,30 @@ static const std::map<u8, std::string> cTypeOfContactToHR = {
     {4, "Sour - Right"}
 };
 
-static const std::map<u8, std::string> cHandToHR = {
+inline constexpr DecodeTable cHandToHR = {
     {0, "Right"},
     {1, "Left"}
 };
 
-static const std::map<u8, std::string> cInputDirectionToHR = {
+inline constexpr DecodeTable cInputDirectionToHR = {
     {0, "None"},
     {1, "Towards Batter"},
     {2, "Away From Batter"}
 };
 
-static const std::map<u8, std::string> cPitchTypeToHR = {
+inline constexpr DecodeTable cPitchTypeToHR = {
     {0, "Curve"},
     {1, "Charge"},
     {2, "ChangeUp"}
 };
 
-static const std::map<u8, std::string> cChargePitchTypeToHR = {
+inline constexpr DecodeTable cChargePitchTypeToHR = {
     {0, "N/A"},
     {2, "Slider"},
     {3, "Perfect"}
 };
 
-static const std::map<u8, std::string> cTypeOfSwing = {
+inline constexpr DecodeTable cTypeOfSwing = {
     {0, "None"},
     {1, "Slap"},
     {2, "Charge"},
@@ -176,7 +219,7 @@ static const std::map<u8, std::string> cTypeOfSwing = {
     {4, "Bunt"}
 };
 
-static const std::map<u8, std::string> cPosition = {
+inline constexpr DecodeTable cPosition = {
     {0, "P"},
     {1, "C"},
     {2, "1B"},
@@ -189,13 +232,13 @@ static const std::map<u8, std::string> cPosition = {
     {0xFF, "Inv"}
 };
 
-static const std::map<u8, std::string> cFielderActions = {
+inline constexpr DecodeTable cFielderActions = {
     {0, "None"},
     {2, "Sliding"},
     {3, "Walljump"},
 };
 
-static const std::map<u8, std::string> cFielderBobbles = {
+inline constexpr DecodeTable cFielderBobbles = {
     {0, "None"},
     {1, "Slide/stun lock"},
     {2, "Fumble"},
@@ -205,7 +248,7 @@ static const std::map<u8, std::string> cFielderBobbles = {
     {0xFF, "None"}
 };
 
-static const std::map<u8, std::string> cStealType = {
+inline constexpr DecodeTable cStealType = {
     {0, "None"},
     {1, "Ready"},
     {2, "Normal"},
@@ -213,7 +256,7 @@ static const std::map<u8, std::string> cStealType = {
     {0xFF, "None"}
 };
 
-static const std::map<u8, std::string> cOutType = {
+inline constexpr DecodeTable cOutType = {
     {0, "None"},
     {1, "Caught"},
     {2, "Force"},
@@ -222,7 +265,7 @@ static const std::map<u8, std::string> cOutType = {
     {0x10, "Strike-out"},
 };
 
-static const std::map<u8, std::string> cPitchResult = {
+inline constexpr DecodeTable cPitchResult = {
     {0, "HBP"},
     {1, "BB"},
     {2, "Ball"},
@@ -233,7 +276,7 @@ static const std::map<u8, std::string> cPitchResult = {
     {7, "Unknown"}
 };
 
-static const std::map<u8, std::string> cPrimaryContactResult = {
+inline constexpr DecodeTable cPrimaryContactResult = {
     {0, "Out"},
     {1, "Foul"},
     {2, "Fair"},
@@ -241,7 +284,7 @@ static const std::map<u8, std::string> cPrimaryContactResult = {
     {4, "Unknown"},
 };
 
-static const std::map<u8, std::string> cSecondaryContactResult = {
+inline constexpr DecodeTable cSecondaryContactResult = {
     {0x0,  "Out-caught"},
     {0x1,  "Out-force"},
     {0x2,  "Out-tag"},
@@ -259,7 +302,7 @@ static const std::map<u8, std::string> cSecondaryContactResult = {
     {0x10, "Foul catch"}
 };
 
-static const std::map<u8, std::string> cAtBatResult = {
+inline constexpr DecodeTable cAtBatResult = {
     {0x0,  "None"},
     {0x1,  "Strikeout"},
     {0x2,  "Walk (BB)"},
@@ -279,7 +322,7 @@ static const std::map<u8, std::string> cAtBatResult = {
     {0x10, "Foul catch"}
 };
 
-static const std::map<u8, std::string> cManualSelectDecode = {
+inline constexpr DecodeTable cManualSelectDecode = {
     {0x0,  "No Selected Char"},
     {0x1,  "Pitcher"},
     {0x2,  "Catcher"},
@@ -287,6 +330,93 @@ static const std::map<u8, std::string> cManualSelectDecode = {
     {0x4,  "Closest to Drop"},
 };
 
+//Stick directions are a bitfield: 1=Left, 2=Right, 4=Down, 8=Up
+inline constexpr DecodeTable cStickVec = {
+    {0x0, ""},
+    {0x1, "Left"},
+    {0x2, "Right"},
+    {0x3, "Left+Right"},
+    {0x4, "Down"},
+    {0x5, "Left+Down"},
+    {0x6, "Right+Down"},
+    {0x7, "Left+Right+Down"},
+    {0x8, "Up"},
+    {0x9, "Left+Up"},
+    {0xA, "Right+Up"},
+    {0xB, "Left+Right+Up"},
+    {0xC, "Down+Up"},
+    {0xD, "Left+Down+Up"},
+    {0xE, "Right+Down+Up"},
+    {0xF, "Left+Right+Down+Up"}
+};
+
+inline constexpr DecodeTable cQuitterTeam = {
+    {0, "Home"},
+    {1, "Away"},
+    {2, "Crash"},
+    {0xFF, "None"}
+};
+
+//Which table an id is decoded with
+enum class DecodeType : u8
+{
+    Character,
+    Stadium,
+    Contact,
+    Hand,
+    Stick,
+    StickVec,
+    Pitch,
+    ChargePitch,
+    Swing,
+    Position,
+    Action,
+    Bobble,
+    ManualSelect,
+    Steal,
+    Out,
+    PrimaryContactResult,
+    SecondaryContactResult,
+    PitchResult,
+    AtBatResult,
+    QuitterTeam
+};
+
+constexpr const DecodeTable& getDecodeTable(DecodeType type){
+    switch (type){
+    case DecodeType::Character: return cCharIdToCharName;
+    case DecodeType::Stadium: return cStadiumIdToStadiumName;
+    case DecodeType::Contact: return cTypeOfContactToHR;
+    case DecodeType::Hand: return cHandToHR;
+    case DecodeType::Stick: return cInputDirectionToHR;
+    case DecodeType::StickVec: return cStickVec;
+    case DecodeType::Pitch: return cPitchTypeToHR;
+    case DecodeType::ChargePitch: return cChargePitchTypeToHR;
+    case DecodeType::Swing: return cTypeOfSwing;
+    case DecodeType::Position: return cPosition;
+    case DecodeType::Action: return cFielderActions;
+    case DecodeType::Bobble: return cFielderBobbles;
+    case DecodeType::ManualSelect: return cManualSelectDecode;
+    case DecodeType::Steal: return cStealType;
+    case DecodeType::Out: return cOutType;
+    case DecodeType::PrimaryContactResult: return cPrimaryContactResult;
+    case DecodeType::SecondaryContactResult: return cSecondaryContactResult;
+    case DecodeType::PitchResult: return cPitchResult;
+    case DecodeType::AtBatResult: return cAtBatResult;
+    case DecodeType::QuitterTeam: return cQuitterTeam;
+    }
+    return cQuitterTeam;
+}
+
+//Name of the id, or nullopt if the table has no entry for it
+constexpr std::optional<std::string_view> decodeName(DecodeType type, u8 value){
+    //Only the low 4 bits of the stick are directions
+    if (type == DecodeType::StickVec){
+        value &= 0xF;
+    }
+    return getDecodeTable(type).lookup(value);
+}
+
 //Const for structs
 static const int cRosterSize = 9;
 static const int cNumOfTeams = 2;
@@ -741,7 +871,8 @@ public:
         std::string stringifyHistory() {
             std::string stringifiedHistory;
             for(EVENT_STATE i : history) {  
-                stringifiedHistory += c_event_state[i] + "\n";
+                stringifiedHistory += toString(i);
+                stringifiedHistory += "\n";
             }
             return stringifiedHistory;
         }
@@ -788,6 +919,9 @@ public:
         //Quit?
         u8 quitter_team = 0xFF;
 
+        //Rio build the game was played on
+        std::string version;
+
         //Bookkeeping
         //int pitch_num = 0;
         int event_num = 0;
@@ -864,16 +998,16 @@ public:
         u8 prev_batter_roster_loc = 0xFF; //Used to check each pitch if the batter has changed.
                                           //Mark current positions when changed
 
-        void initTracker(const Core::CPUThreadGuard& guard, u8 inTeamId){
+        void initTracker(const Core::FrameSnapshot& frame, u8 inTeamId){
             team_id = inTeamId;
             initialized = true;
             for (u8 pos=0; pos < cRosterSize; ++pos){
                 u32 aFielderRosterLoc_calc = aFielder_RosterLoc + (pos * cFielder_Offset);
 
-                u8 roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc_calc);
+                u8 roster_loc = frame.Read_U8(aFielderRosterLoc_calc);
 
                 std::cout << "RosterLoc:" << std::to_string(roster_loc) 
-                          << " Init Pos=" << cPosition.at(pos) << std::endl;
+                          << " Init Pos=" << cPosition[pos] << std::endl;
 
                 fielder_map[roster_loc].current_pos = pos;
                 fielder_map[roster_loc].previous_pos = pos;
@@ -887,18 +1021,18 @@ public:
         }
         
         //Scans field to see who is playing which position and increments counts for positions
-        void evaluateFielders(const Core::CPUThreadGuard& guard) {
+        void evaluateFielders(const Core::FrameSnapshot& frame) {
             for (u8 pos=0; pos < cRosterSize; ++pos){
                 u32 aFielderRosterLoc_calc = aFielder_RosterLoc + (pos * cFielder_Offset);
 
-                u8 roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc_calc);
+                u8 roster_loc = frame.Read_U8(aFielderRosterLoc_calc);
 
                 //If new position, mark changed (unless this is the first pitch of the AB (pos==0xFF))
                 //Then set new position
                 if (fielder_map[roster_loc].current_pos != pos){
                     std::cout << " Team=" << std::to_string(team_id) << " RosterLoc:" << std::to_string(roster_loc) 
-                                << " swapped from " << cPosition.at(fielder_map[roster_loc].current_pos)
-                                << " to " << cPosition.at(pos) << std::endl; 
+                                << " swapped from " << cPosition[fielder_map[roster_loc].current_pos]
+                                << " to " << cPosition[pos] << std::endl; 
                     fielder_map[roster_loc].current_pos = pos; 
                 }
 
@@ -987,6 +1121,13 @@ public:
         //Reset state machines
         m_game_state  = GAME_STATE::PREGAME;
         m_event_state = EVENT_STATE::INIT_EVENT;
+
+        if (!m_uploader)
+            m_uploader = std::make_unique<StatUploader>();
+        if (!m_hud)
+            m_hud = std::make_unique<HudPublisher>();
+        else
+            m_hud->Reset();
     }
 
     GAME_STATE  m_game_state  = GAME_STATE::PREGAME;
@@ -1018,34 +1159,36 @@ public:
     // void setTags(std::vector tags);
     // void setTagSet(int tagset);
 
-    void Run(const Core::CPUThreadGuard& guard);
-    void lookForTriggerEvents(const Core::CPUThreadGuard& guard);
+    // Registers the memory read by Run() so it is copied into the frame snapshot in bulk.
+    static void watchMemory(Core::FrameSnapshot& frame);
+    void Run(const Core::FrameSnapshot& frame);
+    void lookForTriggerEvents(const Core::FrameSnapshot& frame);
 
-    void logGameInfo(const Core::CPUThreadGuard& guard);
-    void logDefensiveStats(const Core::CPUThreadGuard& guard, int team_id, int roster_id);
-    void logOffensiveStats(const Core::CPUThreadGuard& guard, int team_id, int roster_id);
+    void logGameInfo(const Core::FrameSnapshot& frame);
+    void logDefensiveStats(const Core::FrameSnapshot& frame, int team_id, int roster_id);
+    void logOffensiveStats(const Core::FrameSnapshot& frame, int team_id, int roster_id);
     
-    void logEventState(const Core::CPUThreadGuard& guard, Event& in_event);
-    void logContact(const Core::CPUThreadGuard& guard, Event& in_event);
-    void logPitch(const Core::CPUThreadGuard& guard, Event& in_event);
-    void logPitchCurve(const Core::CPUThreadGuard& guard, Event& in_event);
-    void logContactResult(const Core::CPUThreadGuard& guard, Contact* in_contact);
-    void logFinalResults(const Core::CPUThreadGuard& guard, Event& in_event);
+    void logEventState(const Core::FrameSnapshot& frame, Event& in_event);
+    void logContact(const Core::FrameSnapshot& frame, Event& in_event);
+    void logPitch(const Core::FrameSnapshot& frame, Event& in_event);
+    void logPitchCurve(const Core::FrameSnapshot& frame, Event& in_event);
+    void logContactResult(const Core::FrameSnapshot& frame, Contact* in_contact);
+    void logFinalResults(const Core::FrameSnapshot& frame, Event& in_event);
     //void logManualSelectLocks(Event& in_event);
 
     //Quit function
-    void onGameQuit(const Core::CPUThreadGuard& guard);
+    void onGameQuit(const Core::FrameSnapshot& frame);
     bool shouldSubmitGame();
 
     //RunnerInfo
-    std::optional<Runner> logRunnerInfo(const Core::CPUThreadGuard& guard, u8 base);
-    bool anyRunnerStealing(const Core::CPUThreadGuard& guard, Event& in_event);
-    void logRunnerEvents(const Core::CPUThreadGuard& guard, Runner* in_runner);
+    std::optional<Runner> logRunnerInfo(const Core::FrameSnapshot& frame, u8 base);
+    bool anyRunnerStealing(const Core::FrameSnapshot& frame, Event& in_event);
+    void logRunnerEvents(const Core::FrameSnapshot& frame, Runner* in_runner);
 
     //TODO Redo these tuple functions
-    std::optional<Fielder> logFielderWithBall(const Core::CPUThreadGuard& guard);
+    std::optional<Fielder> logFielderWithBall(const Core::FrameSnapshot& frame);
 
-    std::optional<Fielder> logFielderBobble(const Core::CPUThreadGuard& guard);
+    std::optional<Fielder> logFielderBobble(const Core::FrameSnapshot& frame);
     //Read players from ini file and assign to team
     void readPlayerNames(bool local_game);
     //void setDefaultNames(bool local_game);
@@ -1057,30 +1200,48 @@ public:
         return out_float;
     }
 
-    Common::HttpRequest m_http{std::chrono::minutes{3}};
+    //Sends games and ongoing-game updates to the server off the CPU thread. Created by init() so
+    //trackers that only export logs (DolphinTool) do not start the upload thread
+    std::unique_ptr<StatUploader> m_uploader;
+
+    //The type of value to decode, the value to be decoded, bool for decode if true or original value if false.
+    //Returns a JSON token: the quoted name or the number
+    std::string decode(DecodeType type, u8 value, bool decode);
+
+    //The end-of-game stat files, built together in a single pass
+    struct StatJSONs{
+        std::string decoded;       //Decoded ids and local time, usernames
+        std::string hidden_riokey; //Raw ids and unix time, usernames
+        std::string full;          //Raw ids and unix time, user ids. Submitted to the server
+    };
+    StatJSONs getStatJSONs();
 
-    //The type of value to decode, the value to be decoded, bool for decode if true or original value if false
-    std::string decode(std::string type, u8 value, bool decode);
+    //Returns the HUD JSON. Valid until the next call
+    const std::string& getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event>& in_prev_event, bool inDecode);
+    Common::JsonWriter m_hud_writer;
 
-    //Returns JSON, PathToWriteTo
-    std::string getStatJSON(bool inDecode, bool hide_riokey = true);
-    std::string getEventJSON(u16 in_event_num, Event& in_event, bool inDecode);
-    std::string getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event> in_prev_event, bool inDecode);
+    //Sends the current event to the HUD file and/or HUD delta listeners
+    void publishHUD(std::string in_event_num);
+    //Created by init() alongside the uploader
+    std::unique_ptr<HudPublisher> m_hud;
+    HudState m_hud_state;
     //Returns path to save json
-    std::string getStatJsonPath(std::string prefix);
+    std::string getStatJsonPath(std::string prefix, std::string extension = ".json");
+    //Writes the binary stat log and, if enabled, the JSON stat files. Returns the JSONs if they were built
+    std::optional<StatJSONs> writeStatFiles(std::string prefix, std::string decoded_prefix);
 
     void postOngoingGame(Event& in_event);
     void updateOngoingGame(Event& in_event);
 
-    std::pair<u8,u8> getBatterFielderPorts(const Core::CPUThreadGuard& guard){
+    std::pair<u8,u8> getBatterFielderPorts(const Core::FrameSnapshot& frame){
         // These values are the actual port numbers
         // and are indexed into using the below u8s
-        std::array<u8, 2> ports = {PowerPC::MMU::HostRead_U8(guard, 0x800e874c), PowerPC::MMU::HostRead_U8(guard, 0x800e874d)};
+        std::array<u8, 2> ports = {frame.Read_U8(0x800e874c), frame.Read_U8(0x800e874d)};
 
         // These registers will always be 0 or 1
         // and swap values each half inning
-        u32 BattingTeam = PowerPC::MMU::HostRead_U32(guard, 0x80892990);
-        u32 PitchingTeam = PowerPC::MMU::HostRead_U32(guard, 0x80892994);
+        u32 BattingTeam = frame.Read_U32(0x80892990);
+        u32 PitchingTeam = frame.Read_U32(0x80892994);
         
         u8 BattingPort = ports[BattingTeam];
         u8 FieldingPort = ports[PitchingTeam];
@@ -1101,14 +1262,14 @@ public:
     }
     */
 
-    void initPlayerInfo(const Core::CPUThreadGuard& guard);
-    void initCaptains(const Core::CPUThreadGuard& guard);
+    void initPlayerInfo(const Core::FrameSnapshot& frame);
+    void initCaptains(const Core::FrameSnapshot& frame);
 
     //If mid-game, dump game
-    void dumpGame(const Core::CPUThreadGuard& guard){
+    void dumpGame(const Core::FrameSnapshot& frame){
         if (m_game_state == GAME_STATE::INGAME){
             m_game_info.quitter_team = 2;
-            logGameInfo(guard);
+            logGameInfo(frame);
 
             //Remove current event, wasn't finished
             auto it = m_game_info.events.find(m_game_info.event_num);
@@ -1118,15 +1279,7 @@ public:
             }
 
             //Game has ended. Write file but do not submit
-            std::string jsonPath = getStatJsonPath("crash.decode.");
-            std::string json = getStatJSON(true);
-            
-            File::WriteStringToFile(jsonPath, json);
-
-            jsonPath = getStatJsonPath("crash.");
-            json = getStatJSON(false, true);
-            
-            File::WriteStringToFile(jsonPath, json);
+            writeStatFiles("crash.", "crash.decode.");
             init();
         }
     }
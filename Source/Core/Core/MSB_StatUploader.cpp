@@ -0,0 +1,292 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MSB_StatUploader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace
+{
+constexpr char GAME_URL[] = "https://api.projectrio.app/populate_db/";
+constexpr char ONGOING_GAME_URL[] = "https://api.projectrio.app/populate_db/ongoing_game/";
+
+// Upper bound on queued submissions. Completed games are always queued, but spooled games past
+// this limit stay in the spool directory and are picked up on the next launch, and ongoing-game
+// updates past this limit are dropped.
+constexpr size_t MAX_PENDING_SUBMISSIONS = 32;
+
+constexpr int MAX_GAME_ATTEMPTS = 6;
+constexpr auto INITIAL_RETRY_DELAY = std::chrono::seconds{2};
+constexpr auto MAX_RETRY_DELAY = std::chrono::seconds{60};
+
+// Spool files are named <time>_<game id>_<failed launches>.json. Once a game has failed to submit
+// on this many launches, it is moved to the rejected directory instead of being retried again.
+constexpr int MAX_FAILED_LAUNCHES = 10;
+
+bool IsAccepted(s32 status)
+{
+  return status >= 200 && status < 300;
+}
+
+// Client errors won't go away by sending the same payload again, except for timeouts and rate
+// limiting
+bool IsRejected(s32 status)
+{
+  return status >= 400 && status < 500 && status != 408 && status != 429;
+}
+
+// Splits a spool file name into its "<time>_<game id>" part and the failed launch count. Files
+// spooled before the count was added have none, which counts as 0.
+std::pair<std::string, int> ParseSpoolName(const std::string& path)
+{
+  std::string name;
+  SplitPath(path, nullptr, &name, nullptr);
+  std::vector<std::string> parts = SplitString(name, '_');
+  int failed_launches = 0;
+  if (parts.size() == 3 && TryParse(parts[2], &failed_launches))
+    name = parts[0] + '_' + parts[1];
+  return {std::move(name), std::max(failed_launches, 0)};
+}
+}  // namespace
+
+StatUploader::StatUploader()
+    : m_http(std::chrono::minutes{3},
+             [this](s64, s64, s64, s64) { return !m_shutdown.load(std::memory_order_relaxed); })
+{
+  m_worker.Reset("Stat Uploader",
+                 [this](Submission submission) { HandleSubmission(std::move(submission)); });
+  LoadSpooledGames();
+}
+
+StatUploader::~StatUploader()
+{
+  // Stop posting, but drain the queue so that games which have not been spooled yet are written to
+  // disk and resubmitted next launch. Ongoing-game updates are stale by now and are skipped.
+  m_shutdown.store(true, std::memory_order_relaxed);
+  m_shutdown_event.Set();
+  m_worker.Shutdown();
+}
+
+std::string StatUploader::GetSpoolDirectory()
+{
+  return File::GetUserPath(D_MSSBFILES_IDX) + "PendingSubmissions" DIR_SEP;
+}
+
+std::string StatUploader::GetRejectedDirectory()
+{
+  return GetSpoolDirectory() + "Rejected" DIR_SEP;
+}
+
+void StatUploader::SubmitGame(std::string payload, u32 game_id)
+{
+  Enqueue({GAME_URL, std::move(payload), true, game_id, ""});
+}
+
+void StatUploader::SubmitOngoingGame(std::string payload)
+{
+  Enqueue({ONGOING_GAME_URL, std::move(payload), false, 0, ""});
+}
+
+void StatUploader::Enqueue(Submission submission)
+{
+  // A finished game that has not been spooled only exists in this submission, so it is queued
+  // regardless of the limit
+  const bool must_queue = submission.is_game && submission.spool_path.empty();
+  if (!must_queue && m_pending.load(std::memory_order_relaxed) >= MAX_PENDING_SUBMISSIONS)
+  {
+    WARN_LOG_FMT(CORE, "Stat Uploader: queue full, deferring submission to {}", submission.url);
+    return;
+  }
+
+  m_pending.fetch_add(1, std::memory_order_relaxed);
+  m_worker.Push(std::move(submission));
+}
+
+bool StatUploader::SpoolGame(Submission& submission)
+{
+  const std::string spool_dir = GetSpoolDirectory();
+  const std::string spool_path = fmt::format(
+      "{}{}_{}_0.json", spool_dir, static_cast<s64>(std::time(nullptr)), submission.game_id);
+  const std::string temp_path = spool_path + ".tmp";
+
+  // Write then rename, so a crash mid-write never leaves a truncated payload to be resubmitted.
+  File::CreateFullPath(spool_dir);
+  if (!File::WriteStringToFile(temp_path, submission.payload) ||
+      !File::Rename(temp_path, spool_path))
+  {
+    ERROR_LOG_FMT(CORE, "Stat Uploader: failed to spool game {} to {}", submission.game_id,
+                  spool_path);
+    File::Delete(temp_path);
+    return false;
+  }
+
+  submission.spool_path = spool_path;
+  return true;
+}
+
+void StatUploader::HandleSubmission(Submission submission)
+{
+  if (submission.is_game && submission.spool_path.empty() && !SpoolGame(submission))
+  {
+    OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                         "Could not save the game's stats to disk, submitting them without a "
+                         "backup",
+                         5000, OSD::Color::YELLOW);
+  }
+
+  const bool persistent = !submission.spool_path.empty();
+  const int max_attempts = submission.is_game ? MAX_GAME_ATTEMPTS : 1;
+
+  auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(INITIAL_RETRY_DELAY);
+  bool accepted = false;
+  bool rejected = false;
+  for (int attempt = 1; attempt <= max_attempts && !m_shutdown.load(); ++attempt)
+  {
+    const s32 status = Post(submission);
+    if (IsAccepted(status))
+    {
+      accepted = true;
+      break;
+    }
+    if (IsRejected(status))
+    {
+      ERROR_LOG_FMT(CORE, "Stat Uploader: {} rejected the submission with code {}", submission.url,
+                    status);
+      rejected = true;
+      break;
+    }
+
+    if (attempt == max_attempts)
+      break;
+
+    WARN_LOG_FMT(CORE, "Stat Uploader: attempt {} to {} failed with code {}, retrying in {} ms",
+                 attempt, submission.url, status, delay.count());
+
+    // Returns early if the uploader is being destroyed.
+    if (m_shutdown_event.WaitFor(delay))
+      break;
+    delay = std::min<std::chrono::milliseconds>(delay * 2, MAX_RETRY_DELAY);
+  }
+
+  if (submission.is_game)
+  {
+    if (accepted)
+    {
+      if (persistent)
+        File::Delete(submission.spool_path);
+      OSD::AddTypedMessage(OSD::MessageType::GameStateInfo, "Done submitting game", 5000,
+                           OSD::Color::GREEN);
+    }
+    else if (rejected)
+    {
+      if (persistent)
+        MoveToRejected(submission.spool_path);
+      OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                           "Game submission was rejected by the server", 5000, OSD::Color::RED);
+    }
+    else if (persistent)
+    {
+      // An interrupted session doesn't count towards the limit
+      if (!m_shutdown.load())
+        GiveUpForThisLaunch(submission.spool_path);
+    }
+    else
+    {
+      ERROR_LOG_FMT(CORE, "Stat Uploader: game {} could neither be submitted nor saved to disk",
+                    submission.game_id);
+      OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                           "Game submission failed and the game's stats could not be saved", 10000,
+                           OSD::Color::RED);
+    }
+  }
+
+  m_pending.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void StatUploader::GiveUpForThisLaunch(const std::string& spool_path)
+{
+  auto [prefix, failed_launches] = ParseSpoolName(spool_path);
+  ++failed_launches;
+  if (failed_launches >= MAX_FAILED_LAUNCHES)
+  {
+    ERROR_LOG_FMT(CORE, "Stat Uploader: {} failed on {} launches, giving up", spool_path,
+                  failed_launches);
+    MoveToRejected(spool_path);
+    OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                         "Game submission failed too many times and won't be retried", 5000,
+                         OSD::Color::RED);
+    return;
+  }
+
+  ERROR_LOG_FMT(CORE, "Stat Uploader: giving up on {} for this session", spool_path);
+  const std::string new_path =
+      fmt::format("{}{}_{}.json", GetSpoolDirectory(), prefix, failed_launches);
+  if (!File::Rename(spool_path, new_path))
+    ERROR_LOG_FMT(CORE, "Stat Uploader: failed to rename {} to {}", spool_path, new_path);
+  OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                       "Game submission failed, it will be retried on next launch", 5000,
+                       OSD::Color::RED);
+}
+
+void StatUploader::MoveToRejected(const std::string& spool_path)
+{
+  // Kept rather than deleted, so the stats of the game aren't lost
+  const std::string rejected_dir = GetRejectedDirectory();
+  std::string name;
+  std::string extension;
+  SplitPath(spool_path, nullptr, &name, &extension);
+  File::CreateFullPath(rejected_dir);
+  if (!File::Rename(spool_path, rejected_dir + name + extension))
+  {
+    ERROR_LOG_FMT(CORE, "Stat Uploader: failed to move {} to {}, deleting it", spool_path,
+                  rejected_dir);
+    File::Delete(spool_path);
+  }
+}
+
+s32 StatUploader::Post(const Submission& submission)
+{
+  const Common::HttpRequest::Response response =
+      m_http.Post(submission.url, submission.payload, {{"Content-Type", "application/json"}},
+                  Common::HttpRequest::AllowedReturnCodes::All);
+  if (!response)
+    return 0;
+  return m_http.GetLastResponseCode();
+}
+
+void StatUploader::LoadSpooledGames()
+{
+  const std::string spool_dir = GetSpoolDirectory();
+  if (!File::IsDirectory(spool_dir))
+    return;
+
+  // File names start with the submission time, so sorting keeps games in submission order.
+  std::vector<std::string> paths = Common::DoFileSearch({spool_dir}, {".json"}, false);
+  std::sort(paths.begin(), paths.end());
+
+  for (std::string& path : paths)
+  {
+    std::string payload;
+    if (!File::ReadFileToString(path, payload) || payload.empty())
+    {
+      File::Delete(path);
+      continue;
+    }
+
+    INFO_LOG_FMT(CORE, "Stat Uploader: resubmitting spooled game {}", path);
+    Enqueue({GAME_URL, std::move(payload), true, 0, std::move(path)});
+  }
+}
@@ -0,0 +1,71 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "Common/Event.h"
+#include "Common/HttpRequest.h"
+#include "Common/WorkQueueThread.h"
+
+// Submits StatTracker payloads to the Rio web API from a dedicated worker thread.
+//
+// The emulated CPU thread only enqueues; it never waits on the network or the disk. The worker
+// spools completed games to disk before submitting them so that a crash or an unreachable server
+// does not lose them. Spooled games are resubmitted the next time the uploader is created, until
+// the server rejects them or they have failed on too many launches.
+class StatUploader
+{
+public:
+  StatUploader();
+  ~StatUploader();
+
+  StatUploader(const StatUploader&) = delete;
+  StatUploader& operator=(const StatUploader&) = delete;
+
+  // Queues a completed game. Games are never dropped: the payload is written to the spool
+  // directory first and only removed once the server has accepted it. Games the server rejects
+  // are moved to a directory of their own.
+  void SubmitGame(std::string payload, u32 game_id);
+
+  // Queues an ongoing-game update. These are only useful while the game is live, so they are
+  // neither spooled nor retried across sessions, and are dropped when the queue is full.
+  void SubmitOngoingGame(std::string payload);
+
+  size_t GetPendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+
+private:
+  struct Submission
+  {
+    std::string url;
+    std::string payload;
+    // Completed games are retried and kept on disk until they are accepted
+    bool is_game = false;
+    u32 game_id = 0;
+    // Path of the on-disk copy of this submission. Empty if it has not been spooled (yet).
+    std::string spool_path;
+  };
+
+  void Enqueue(Submission submission);
+  void HandleSubmission(Submission submission);
+  bool SpoolGame(Submission& submission);
+  void GiveUpForThisLaunch(const std::string& spool_path);
+  void MoveToRejected(const std::string& spool_path);
+  // Returns the HTTP status, or 0 if there was no response
+  s32 Post(const Submission& submission);
+  void LoadSpooledGames();
+
+  static std::string GetSpoolDirectory();
+  static std::string GetRejectedDirectory();
+
+  Common::HttpRequest m_http;
+  Common::Event m_shutdown_event;
+  std::atomic<bool> m_shutdown{false};
+  std::atomic<size_t> m_pending{0};
+
+  // Must be last so the worker is stopped before the members it uses are destroyed.
+  Common::WorkQueueThread<Submission> m_worker;
+};
@@ -14,11 +14,14 @@
 #include <thread>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
+#include <lz4.h>
 
 #include "Common/Assert.h"
+#include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
@@ -30,9 +33,12 @@
 #include "Common/QoSSession.h"
 #include "Common/SFMLHelper.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
 
+#include "AudioCommon/SoundStream.h"
+
 #include "Core/HW/Memmap.h"
 
 #include "Core/ActionReplay.h"
@@ -42,7 +48,9 @@
 #include "Core/Config/SessionSettings.h"
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
+#include "Core/HW/CPU.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #ifdef HAS_LIBMGBA
@@ -54,6 +62,7 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/HW/SI/SI_DeviceGCController.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/HW/Sram.h"
 #include "Core/HW/WiiSave.h"
 #include "Core/HW/WiiSaveStructs.h"
@@ -67,6 +76,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -92,6 +102,11 @@ static std::mutex crit_netplay_client;
 static NetPlayClient* netplay_client = nullptr;
 static bool s_si_poll_batching = false;
 
+// How often the time taken by the rollback savestates is logged, and above which average they
+// take too much of a 60 Hz frame
+constexpr u32 ROLLBACK_SAVE_REPORT_FRAMES = 600;
+constexpr u64 ROLLBACK_SAVE_BUDGET_US = 4000;
+
 // called from ---GUI--- thread
 NetPlayClient::~NetPlayClient()
 {
@@ -99,6 +114,9 @@ NetPlayClient::~NetPlayClient()
   if (m_is_running.IsSet())
     StopGame();
 
+  if (m_keyframe_thread.joinable())
+    m_keyframe_thread.join();
+
   if (m_is_connected)
   {
     m_should_compute_game_digest = false;
@@ -426,6 +444,14 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnPadHostData(packet);
     break;
 
+  case MessageID::SpectatorRelay:
+    m_watching_relay.Set();
+    break;
+
+  case MessageID::SpectatorKeyframe:
+    OnSpectatorKeyframe(packet);
+    break;
+
   case MessageID::WiimoteData:
     OnWiimoteData(packet);
     break;
@@ -523,8 +549,10 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnNightMsg(packet);
     break;  
 
-  case MessageID::Checksum:
-    OnChecksumMsg(packet);
+  case MessageID::DesyncDigests:
+  case MessageID::DesyncHashes:
+  case MessageID::DesyncBlocks:
+    OnDesyncDetectorMsg(mid, packet);
     break;
 
   case MessageID::GameID:
@@ -770,6 +798,47 @@ void NetPlayClient::OnPadData(sf::Packet& packet)
   }
 }
 
+void NetPlayClient::OnSpectatorKeyframe(sf::Packet& packet)
+{
+  std::array<u64, 4> pad_counts;
+  for (u64& count : pad_counts)
+    count = Common::PacketReadU64(packet);
+  u32 state_size;
+  packet >> state_size;
+  if (!packet || !m_watching_relay.IsSet())
+    return;
+
+  // LZ4 can not compress more than 255 to 1
+  const size_t compressed_size = packet.getDataSize() - SPECTATOR_KEYFRAME_HEADER_SIZE;
+  if (state_size > MAX_SPECTATOR_KEYFRAME_SIZE || state_size / 255 > compressed_size)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Received a spectator keyframe with an invalid size of {} bytes",
+                  state_size);
+    return;
+  }
+
+  const char* compressed =
+      static_cast<const char*>(packet.getData()) + SPECTATOR_KEYFRAME_HEADER_SIZE;
+  std::vector<u8> state(state_size);
+  if (LZ4_decompress_safe(compressed, reinterpret_cast<char*>(state.data()),
+                          static_cast<int>(compressed_size),
+                          static_cast<int>(state_size)) != static_cast<int>(state_size))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Received an invalid spectator keyframe");
+    return;
+  }
+
+  INFO_LOG_FMT(NETPLAY, "Received a spectator keyframe of {} bytes", state_size);
+
+  {
+    std::lock_guard lk(m_keyframe_mutex);
+    m_keyframe_state = std::move(state);
+    m_keyframe_pad_counts = pad_counts;
+  }
+  m_keyframe_pending.Set();
+  m_gc_pad_event.Set();
+}
+
 void NetPlayClient::OnPadHostData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
@@ -1000,6 +1069,9 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.sync_codes;
 
     packet >> m_net_settings.golf_mode;
+    packet >> m_net_settings.rollback;
+    packet >> m_net_settings.rollback_max_frames;
+    packet >> m_net_settings.relay_keyframe_interval;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
 
@@ -1654,16 +1726,27 @@ void NetPlayClient::OnDisableReplaysMsg(sf::Packet& packet)
   Gecko::setDisableReplays(disable);
 }
 
-void NetPlayClient::OnChecksumMsg(sf::Packet& packet)
+void NetPlayClient::OnDesyncDetectorMsg(MessageID mid, sf::Packet& packet)
 {
-  u32 inChecksum;
-  u8 checksumId;
-  packet >> inChecksum;
-  packet >> checksumId;
+  PlayerId pid;
+  packet >> pid;
+
+  if (!m_desync_detector)
+    return;
 
-  if (ourChecksum[checksumId] != inChecksum)
+  switch (mid)
   {
-    m_dialog->OnDesync(0, "");
+  case MessageID::DesyncDigests:
+    m_desync_detector->OnDigests(pid, packet);
+    break;
+  case MessageID::DesyncHashes:
+    m_desync_detector->OnHashes(pid, packet);
+    break;
+  case MessageID::DesyncBlocks:
+    m_desync_detector->OnBlocks(pid, packet);
+    break;
+  default:
+    break;
   }
 }
 
@@ -2009,7 +2092,6 @@ void NetPlayClient::SendStopGamePacket()
 bool NetPlayClient::StartGame(const std::string& path)
 {
   std::lock_guard lkg(m_crit.game);
-  SendStartGamePacket();
 
   if (m_is_running.IsSet())
   {
@@ -2021,11 +2103,77 @@ bool NetPlayClient::StartGame(const std::string& path)
   m_current_golfer = 1;
   m_wait_on_input = false;
 
+  // Created before the game boots and only replaced here, so the CPU thread never sees it change
+  m_desync_detector.reset();
+  if (Config::Get(Config::NETPLAY_DESYNC_DETECTION))
+  {
+    auto regions = DesyncDetector::GetRegions(m_selected_game.game_id);
+    if (!regions.empty())
+    {
+      m_desync_detector = std::make_unique<DesyncDetector>(
+          std::move(regions), [this](sf::Packet&& packet) { SendAsync(std::move(packet)); },
+          [this](u64 frame, PlayerId pid) {
+            std::string player = "??";
+            {
+              std::lock_guard lkp(m_crit.players);
+              const auto it = m_players.find(pid);
+              if (it != m_players.end())
+                player = it->second.name;
+            }
+            m_dialog->OnDesync(static_cast<u32>(frame), player);
+          });
+    }
+  }
+
+  m_rollback.reset();
+  m_rollback_states.reset();
+  m_rollback_state_frames.clear();
+  m_rollback_frame_polled = false;
+  m_rollback_resimulating = false;
+  m_rollback_save_us = 0;
+  m_rollback_save_max_us = 0;
+  m_rollback_saves = 0;
+  m_rollback_slow_save_shown = false;
+  if (m_net_settings.rollback)
+  {
+    std::array<bool, 4> active_pads;
+    for (size_t i = 0; i < active_pads.size(); ++i)
+      active_pads[i] = m_pad_map[i] > 0;
+    m_rollback =
+        std::make_unique<RollbackSession>(m_net_settings.rollback_max_frames, active_pads);
+    // One state more than the frames that can be rolled back, plus the one being saved
+    m_rollback_states = std::make_unique<State::SnapshotRing>(m_rollback->GetMaxFrames() + 2);
+    m_rollback_state_frames.resize(m_rollback_states->GetSlotCount());
+
+    // Frames that are rolled back would be hashed with the predicted inputs
+    m_desync_detector.reset();
+  }
+
+  if (m_keyframe_thread.joinable())
+    m_keyframe_thread.join();
+  m_pad_popped.fill(0);
+  m_pad_skip.fill(0);
+  m_last_keyframe_time = std::chrono::steady_clock::now();
+  m_keyframe_pending.Clear();
+  if (m_spectator_catching_up)
+  {
+    m_spectator_catching_up = false;
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, m_speed_before_catching_up);
+  }
+
+  Core::System::GetInstance().GetCoreTiming().SetSliceEndCallback(
+      m_rollback || m_net_settings.relay_keyframe_interval != 0 ?
+          std::function<void()>(&NetPlayClient::OnSliceEnd) :
+          nullptr);
+
   m_is_running.Set();
   NetPlay_Enable(this);
 
   ClearBuffers();
 
+  // Sent once the buffers are empty, a relay starts sending the inputs of the game when it gets it
+  SendStartGamePacket();
+
   m_first_pad_status_received.fill(false);
 
   if (m_dialog->IsRecording())
@@ -2309,6 +2457,9 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback)
+    return GetRollbackPads(pad_nb, batching, pad_status);
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
     sf::Packet packet;
@@ -2384,10 +2535,44 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
   }
 
+  else if (IsFirstInGamePad(pad_nb) && batching && m_watching_relay.IsSet())
+  {
+    // Spectators have no inputs to wait on, so they run ahead until they are as close to the
+    // players as the players are to each other, e.g. after joining from a keyframe
+    const u32 buffered = m_pad_buffer[pad_nb].Size();
+    const bool catch_up = buffered > m_target_buffer_size + (m_spectator_catching_up ? 1 : 30);
+    if (catch_up != m_spectator_catching_up)
+    {
+      m_spectator_catching_up = catch_up;
+      if (catch_up)
+        m_speed_before_catching_up = Config::Get(Config::MAIN_EMULATION_SPEED);
+      Config::SetCurrent(Config::MAIN_EMULATION_SPEED,
+                         catch_up ? 0.0f : m_speed_before_catching_up);
+    }
+  }
+
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
-  while (m_pad_buffer[pad_nb].Size() == 0)
+  while (true)
   {
+    // The state is replaced at the end of the slice, so the inputs until then do not matter
+    if (m_keyframe_pending.IsSet())
+    {
+      *pad_status = GCPadStatus{};
+      return true;
+    }
+
+    if (m_pad_buffer[pad_nb].Pop(*pad_status))
+    {
+      ++m_pad_popped[pad_nb];
+      if (m_pad_skip[pad_nb] == 0)
+        break;
+
+      // The input was used before the keyframe that was loaded
+      --m_pad_skip[pad_nb];
+      continue;
+    }
+
     if (!m_is_running.IsSet())
     {
       return false;
@@ -2396,8 +2581,6 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_gc_pad_event.Wait();
   }
 
-  m_pad_buffer[pad_nb].Pop(*pad_status);
-
   auto& movie = Core::System::GetInstance().GetMovie();
   if (movie.IsRecordingInput())
   {
@@ -2412,6 +2595,259 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
   return true;
 }
 
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPads(const int pad_nb, const bool batching, GCPadStatus* pad_status)
+{
+  // Local inputs go through m_pad_buffer like in the other modes, so the pad buffer size is the
+  // local input delay. A little delay means fewer frames run with predicted inputs.
+  RollbackSession& session = *m_rollback;
+
+  if (IsFirstInGamePad(pad_nb) && batching)
+  {
+    // Frames that are simulated again sent their inputs the first time around
+    if (!session.IsResimulating())
+    {
+      sf::Packet packet;
+      packet << MessageID::PadData;
+
+      bool send_packet = false;
+      const int num_local_pads = NumLocalPads();
+      for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+        send_packet = PollLocalPad(local_pad, packet) || send_packet;
+
+      if (send_packet)
+        SendAsync(std::move(packet));
+    }
+
+    m_rollback_frame_polled = true;
+  }
+
+  if (IsLocalPlayer(m_pad_map[pad_nb]))
+  {
+    GCPadStatus status;
+    while (!session.HasInput(pad_nb) && m_pad_buffer[pad_nb].Pop(status))
+      session.AddInput(pad_nb, status);
+  }
+  else
+  {
+    ReceiveRollbackInputs(pad_nb);
+
+    // Only wait when the frame got too far ahead of this player
+    while (!session.HasInput(pad_nb) && !session.CanPredict(pad_nb))
+    {
+      if (!m_is_running.IsSet())
+        return false;
+
+      m_gc_pad_event.Wait();
+      ReceiveRollbackInputs(pad_nb);
+    }
+  }
+
+  *pad_status = session.GetInput(pad_nb);
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::ReceiveRollbackInputs(const PadIndex pad)
+{
+  if (m_pad_map[pad] <= 0 || IsLocalPlayer(m_pad_map[pad]))
+    return;
+
+  GCPadStatus status;
+  while (m_pad_buffer[pad].Pop(status))
+    m_rollback->AddInput(pad, status);
+}
+
+// called from ---CPU--- thread, at the end of every CoreTiming slice
+void NetPlayClient::OnSliceEnd()
+{
+  std::lock_guard lk(crit_netplay_client);
+
+  if (!netplay_client)
+    return;
+
+  if (netplay_client->m_rollback)
+  {
+    // The savestates are saved and loaded once the CPU thread left the run loop, as loading one
+    // here would replace the machine under the slice CoreTiming is starting
+    if (std::exchange(netplay_client->m_rollback_frame_polled, false))
+    {
+      Core::System::GetInstance().GetCPU().AddCPUThreadJobAndLeaveRunLoop(
+          &NetPlayClient::OnRollbackPoint);
+    }
+  }
+  else if (netplay_client->m_keyframe_pending.IsSet())
+    netplay_client->LoadKeyframe();
+  else if (netplay_client->m_local_player->IsHost())
+    netplay_client->SendKeyframe();
+}
+
+// Taken at the end of a slice like the rollback savestates, so all the inputs the state used were
+// counted and none of the following ones.
+void NetPlayClient::SendKeyframe()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_last_keyframe_time < std::chrono::seconds(m_net_settings.relay_keyframe_interval))
+    return;
+  m_last_keyframe_time = now;
+
+  std::vector<u8> state;
+  State::SaveToBuffer(state);
+
+  // Compressing the state takes a few frames worth of time
+  if (m_keyframe_thread.joinable())
+    m_keyframe_thread.join();
+  m_keyframe_thread = std::thread([this, state = std::move(state), pad_counts = m_pad_popped] {
+    Common::SetCurrentThreadName("NetPlay Keyframe");
+
+    std::vector<char> compressed(LZ4_compressBound(static_cast<int>(state.size())));
+    const int compressed_size =
+        LZ4_compress_default(reinterpret_cast<const char*>(state.data()), compressed.data(),
+                             static_cast<int>(state.size()), static_cast<int>(compressed.size()));
+    if (compressed_size <= 0)
+    {
+      ERROR_LOG_FMT(NETPLAY, "Failed to compress the spectator keyframe");
+      return;
+    }
+
+    sf::Packet packet;
+    packet << MessageID::SpectatorKeyframe;
+    for (u64 count : pad_counts)
+      packet << sf::Uint64{count};
+    packet << static_cast<u32>(state.size());
+    packet.append(compressed.data(), compressed_size);
+    SendAsync(std::move(packet));
+  });
+}
+
+void NetPlayClient::LoadKeyframe()
+{
+  std::vector<u8> state;
+  std::array<u64, 4> pad_counts;
+  {
+    std::lock_guard lk(m_keyframe_mutex);
+    state = std::move(m_keyframe_state);
+    pad_counts = m_keyframe_pad_counts;
+    m_keyframe_pending.Clear();
+  }
+
+  u8* ptr = state.data();
+  PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Read);
+  State::DoState(p);
+  if (!p.IsReadMode())
+  {
+    ERROR_LOG_FMT(NETPLAY, "Failed to load the spectator keyframe");
+    return;
+  }
+
+  for (size_t i = 0; i < pad_counts.size(); ++i)
+    m_pad_skip[i] = pad_counts[i] > m_pad_popped[i] ? pad_counts[i] - m_pad_popped[i] : 0;
+
+  INFO_LOG_FMT(NETPLAY, "Loaded a spectator keyframe, skipping {} inputs",
+               fmt::join(m_pad_skip, ", "));
+}
+
+// called from ---CPU--- thread, between the slices after a frame's inputs were polled
+void NetPlayClient::OnRollbackPoint()
+{
+  std::lock_guard lk(crit_netplay_client);
+
+  if (netplay_client && netplay_client->m_rollback && netplay_client->m_is_running.IsSet())
+    netplay_client->UpdateRollback();
+}
+
+// The savestate of frame n is taken where the CPU thread leaves the run loop, at the end of the
+// slice after the one the inputs of frame n were polled in. Slices are much shorter than a frame,
+// so loading it resumes before the poll of frame n + 1.
+void NetPlayClient::UpdateRollback()
+{
+  RollbackSession& session = *m_rollback;
+
+  // Inputs that arrived during the frame may already show a misprediction
+  for (PadIndex pad = 0; pad < static_cast<PadIndex>(m_pad_map.size()); ++pad)
+    ReceiveRollbackInputs(pad);
+  session.EndFrame();
+
+  if (const std::optional<u64> frame = session.TakeRollback())
+  {
+    // The session never predicts a frame before the first input of a pad arrived, so there is
+    // always a frame before the rolled back one.
+    const size_t slot = (*frame - 1) % m_rollback_state_frames.size();
+    if (m_rollback_state_frames[slot] != *frame - 1 || !m_rollback_states->Load(slot))
+    {
+      StopRollbackSession(*frame);
+      return;
+    }
+  }
+  else
+  {
+    SaveRollbackState(session.GetFrame() - 1);
+  }
+
+  // Frames that are simulated again run as fast as possible and their output was already shown
+  const bool resimulating = session.IsResimulating();
+  if (resimulating != m_rollback_resimulating)
+  {
+    m_rollback_resimulating = resimulating;
+
+    auto& system = Core::System::GetInstance();
+    system.GetCoreTiming().SetCatchingUp(resimulating);
+    system.GetVideoInterface().SetOutputSuppressed(resimulating);
+    if (SoundStream* sound_stream = system.GetSoundStream())
+      sound_stream->GetMixer()->SetSuppressed(resimulating);
+  }
+}
+
+void NetPlayClient::SaveRollbackState(const u64 frame)
+{
+  const size_t slot = frame % m_rollback_state_frames.size();
+  const u64 start_us = Common::Timer::NowUs();
+  m_rollback_states->Save(slot);
+  m_rollback_state_frames[slot] = frame;
+
+  // A state is saved every frame, so a slow save slows the whole game down
+  const u64 save_us = Common::Timer::NowUs() - start_us;
+  m_rollback_save_us += save_us;
+  m_rollback_save_max_us = std::max(m_rollback_save_max_us, save_us);
+  if (++m_rollback_saves < ROLLBACK_SAVE_REPORT_FRAMES)
+    return;
+
+  const u64 average_us = m_rollback_save_us / m_rollback_saves;
+  INFO_LOG_FMT(NETPLAY, "Rollback savestates took {} us on average and at most {} us, {} MiB",
+               average_us, m_rollback_save_max_us,
+               m_rollback_states->GetMemoryUsage() >> 20);
+  if (average_us > ROLLBACK_SAVE_BUDGET_US && !m_rollback_slow_save_shown)
+  {
+    m_rollback_slow_save_shown = true;
+    OSD::AddMessage(fmt::format("Rollback savestates take {:.1f} ms per frame, the game may not "
+                                "reach full speed",
+                                average_us / 1000.0),
+                    OSD::Duration::VERY_LONG, OSD::Color::YELLOW);
+  }
+  m_rollback_save_us = 0;
+  m_rollback_save_max_us = 0;
+  m_rollback_saves = 0;
+}
+
+// Running on from another state than the other players would desync the game for good
+void NetPlayClient::StopRollbackSession(const u64 frame)
+{
+  ERROR_LOG_FMT(NETPLAY, "Missing savestate to roll back to frame {}, stopping the game", frame);
+  m_dialog->AppendChat(Common::GetStringT("The game could not be rolled back and was stopped."));
+
+  InvokeStop();
+  if (LocalPlayerHasControllerMapped())
+    SendStopGamePacket();
+  m_dialog->StopGame();
+}
+
+bool NetPlayClient::IsResimulating()
+{
+  std::lock_guard lk(crit_netplay_client);
+
+  return netplay_client && netplay_client->m_rollback_resimulating;
+}
+
 u64 NetPlayClient::GetInitialRTCValue() const
 {
   return m_initial_rtc;
@@ -2868,21 +3304,12 @@ void NetPlayClient::SendGameStatus()
   Send(packet);
 }
 
-void NetPlayClient::SendChecksum(u8 checksumId, u64 frame, u32 checksum)
+void NetPlayClient::RunDesyncDetector(const Core::CPUThreadGuard& guard, u64 frame)
 {
-  netplay_client->ourChecksum[checksumId] = checksum;
-
-  if (frame < 1000) // dont send the initial ones since they're whack
-    return;
-
-  u8 newId = checksumId + 11 & 0xf;  // send checksum from 5 seconds ago
-
-  sf::Packet packet;
-  packet << MessageID::Checksum;
-  packet << netplay_client->ourChecksum[newId]; 
-  packet << newId;
+  std::lock_guard lk(crit_netplay_client);
 
-  netplay_client->SendAsync(std::move(packet));
+  if (netplay_client && netplay_client->m_desync_detector)
+    netplay_client->m_desync_detector->OnFrame(guard, frame);
 }
 
 void NetPlayClient::SendTimeBase()
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <thread>
@@ -20,7 +21,10 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayDesyncDetector.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/NetPlayProto.h"
+#include "Core/SnapshotRing.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 #include "Core/LocalPlayers.h"
@@ -162,7 +166,6 @@ public:
   void RequestGolfControl();
   std::string GetCurrentGolfer();
   std::vector<std::string> v_ActiveGeckoCodes;
-  std::map<u8, u32> ourChecksum;
 
   // Send and receive pads values
   struct WiimoteDataBatchEntry
@@ -196,7 +199,9 @@ public:
   bool PortHasPlayerAssigned(int port);
 
   static void SendTimeBase();
-  static void SendChecksum(u8 checksumId, u64 frame, u32 checksum);
+  static void RunDesyncDetector(const Core::CPUThreadGuard& guard, u64 frame);
+  // Whether the rollback network mode is simulating frames again that already ran once.
+  static bool IsResimulating();
   bool DoAllPlayersHaveGame();
 
   static std::string GetNetplayNames(u8 PortInt);
@@ -295,6 +300,15 @@ private:
   void SyncCodeResponse(bool success);
 
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool GetRollbackPads(int pad_nb, bool batching, GCPadStatus* pad_status);
+  void ReceiveRollbackInputs(PadIndex pad);
+  static void OnSliceEnd();
+  static void OnRollbackPoint();
+  void UpdateRollback();
+  void SaveRollbackState(u64 frame);
+  void StopRollbackSession(u64 frame);
+  void SendKeyframe();
+  void LoadKeyframe();
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
@@ -327,6 +341,7 @@ private:
   void OnWiimoteMapping(sf::Packet& packet);
   void OnGBAConfig(sf::Packet& packet);
   void OnPadData(sf::Packet& packet);
+  void OnSpectatorKeyframe(sf::Packet& packet);
   void OnPadHostData(sf::Packet& packet);
   void OnWiimoteData(sf::Packet& packet);
   void OnPadBuffer(sf::Packet& packet);
@@ -362,7 +377,7 @@ private:
   void OnSendCodesMsg(sf::Packet& packet);
   void OnCoinFlipMsg(sf::Packet& packet);
   void OnNightMsg(sf::Packet& packet);
-  void OnChecksumMsg(sf::Packet& packet);
+  void OnDesyncDetectorMsg(MessageID mid, sf::Packet& packet);
   void OnGameIDMsg(sf::Packet& packet);
   void OnStadiumMsg(sf::Packet& packet);
   void OnCourseMsg(sf::Packet& packet);
@@ -399,6 +414,38 @@ private:
 
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
+  std::unique_ptr<DesyncDetector> m_desync_detector;
+
+  // Rollback network mode, set up before the game boots and then only used on the CPU thread.
+  // The savestates are kept per frame in a ring, indexed by frame number, along with the frame
+  // each slot holds.
+  std::unique_ptr<RollbackSession> m_rollback;
+  std::unique_ptr<State::SnapshotRing> m_rollback_states;
+  std::vector<std::optional<u64>> m_rollback_state_frames;
+  bool m_rollback_frame_polled = false;
+  bool m_rollback_resimulating = false;
+  // Time taken by the savestates of the last frames, as one is saved every frame
+  u64 m_rollback_save_us = 0;
+  u64 m_rollback_save_max_us = 0;
+  u32 m_rollback_saves = 0;
+  bool m_rollback_slow_save_shown = false;
+
+  // Spectator keyframes. The host sends its state to the relays now and then, along with how many
+  // inputs of each pad it had used, so spectators joining a relay late do not have to run the
+  // whole game. A spectator loads the state it got at the end of the next slice and then drops
+  // the inputs that came before it.
+  std::array<u64, 4> m_pad_popped{};
+  std::array<u64, 4> m_pad_skip{};
+  std::chrono::steady_clock::time_point m_last_keyframe_time;
+  std::thread m_keyframe_thread;
+  std::mutex m_keyframe_mutex;
+  std::vector<u8> m_keyframe_state;
+  std::array<u64, 4> m_keyframe_pad_counts{};
+  Common::Flag m_keyframe_pending{false};
+  // Only spectators watching through a relay get keyframes and run ahead to catch up after one
+  Common::Flag m_watching_relay{false};
+  bool m_spectator_catching_up = false;
+  float m_speed_before_catching_up = 1.0f;
 
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
@@ -0,0 +1,397 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayDesyncDetector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <utility>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/SFMLHelper.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/NetplaySettings.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+
+namespace NetPlay
+{
+namespace
+{
+u32 ToPhysical(u32 address)
+{
+  return address & 0x3FFFFFFF;
+}
+
+// Mario Superstar Baseball: the state the game simulation runs on. Values only used for
+// presentation, which may legitimately differ between players, are left out.
+const std::vector<DesyncDetector::Region> MSSB_REGIONS = {
+    {"Rio Checksum", 0x802EBFB8, 0x4},
+    {"Rosters", 0x80353080, 0x16D0},
+    {"Runners and Fielders", 0x8088EE00, 0x1B10},
+    {"Ball", 0x80890910, 0x560},
+    {"Scoreboard", 0x80892500, 0x600},
+    {"At Bat", 0x80893890, 0x320},
+};
+}  // namespace
+
+DesyncDetector::DesyncDetector(std::vector<Region> regions, SendFunction send,
+                               DesyncCallback on_desync)
+    : m_regions(std::move(regions)), m_send(std::move(send)), m_on_desync(std::move(on_desync)),
+      m_history(HISTORY_FRAMES)
+{
+  for (u32 i = 0; i < m_regions.size(); ++i)
+  {
+    const Region& region = m_regions[i];
+    m_region_offsets.push_back(m_total_size);
+    for (u32 offset = 0; offset < region.size; offset += BLOCK_SIZE)
+    {
+      m_blocks.push_back({i, region.address + offset, m_total_size + offset,
+                          std::min(BLOCK_SIZE, region.size - offset)});
+    }
+    m_total_size += region.size;
+  }
+
+  m_batch.reserve(DIGESTS_PER_PACKET);
+}
+
+std::vector<DesyncDetector::Region> DesyncDetector::GetRegions(std::string_view game_id)
+{
+  const std::string configured = Config::Get(Config::NETPLAY_DESYNC_REGIONS);
+  if (!configured.empty())
+  {
+    if (auto regions = ParseRegions(configured))
+      return std::move(*regions);
+    ERROR_LOG_FMT(NETPLAY, "Invalid desync detection regions \"{}\", using the defaults",
+                  configured);
+  }
+
+  if (game_id == "GYQE01")
+    return MSSB_REGIONS;
+  return {};
+}
+
+std::optional<std::vector<DesyncDetector::Region>>
+DesyncDetector::ParseRegions(const std::string& str)
+{
+  std::vector<Region> regions;
+  u64 total_size = 0;
+  for (const std::string& entry : SplitString(str, ';'))
+  {
+    const std::string trimmed{StripWhitespace(entry)};
+    if (trimmed.empty())
+      continue;
+
+    const std::vector<std::string> fields = SplitString(trimmed, ':');
+    Region region;
+    if (fields.size() != 3 || !TryParse(std::string(StripWhitespace(fields[1])), &region.address) ||
+        !TryParse(std::string(StripWhitespace(fields[2])), &region.size) || region.size == 0)
+    {
+      return std::nullopt;
+    }
+
+    // Regions have to fit in the largest MEM1, and all of them are copied every frame
+    if (u64{ToPhysical(region.address)} + region.size > Memory::MEM1_SIZE_GDEV)
+      return std::nullopt;
+    total_size += region.size;
+    if (total_size > MAX_TOTAL_SIZE)
+      return std::nullopt;
+
+    region.name = StripWhitespace(fields[0]);
+    regions.push_back(std::move(region));
+  }
+  return regions;
+}
+
+void DesyncDetector::OnFrame(const Core::CPUThreadGuard& guard, u64 frame)
+{
+  auto& memory = guard.GetSystem().GetMemory();
+  OnFrame(std::span<const u8>(memory.GetRAM(), memory.GetRamSizeReal()), frame);
+}
+
+void DesyncDetector::OnFrame(std::span<const u8> ram, u64 frame)
+{
+  if (frame < FIRST_FRAME)
+    return;
+
+  std::lock_guard lk(m_lock);
+  if (m_last_frame && frame <= *m_last_frame)
+    return;
+
+  // A gap means frames were skipped (e.g. while paused), so the batch can't be continued
+  if (m_last_frame && frame != *m_last_frame + 1)
+    FlushDigests();
+  m_last_frame = frame;
+
+  FrameRecord& record = m_history[frame % HISTORY_FRAMES];
+  record.frame = frame;
+  record.data.resize(m_total_size);
+  record.region_hashes.resize(m_regions.size());
+
+  for (size_t i = 0; i < m_regions.size(); ++i)
+  {
+    const Region& region = m_regions[i];
+    u8* const dest = record.data.data() + m_region_offsets[i];
+    const u32 physical = ToPhysical(region.address);
+    if (u64{physical} + region.size <= ram.size())
+      std::memcpy(dest, ram.data() + physical, region.size);
+    else
+      std::memset(dest, 0, region.size);
+    record.region_hashes[i] = XXH3_64bits(dest, region.size);
+  }
+  record.digest =
+      XXH3_64bits(record.region_hashes.data(), record.region_hashes.size() * sizeof(u64));
+
+  for (auto& [pid, digests] : m_remote_digests)
+  {
+    // Digests too old to be in the history can't be compared anymore
+    while (!digests.empty() && digests.begin()->first + HISTORY_FRAMES <= frame)
+      digests.erase(digests.begin());
+
+    const auto it = digests.find(frame);
+    if (it != digests.end())
+    {
+      CompareDigest(pid, frame, it->second, record);
+      digests.erase(it);
+    }
+  }
+
+  if (m_batch.empty())
+    m_batch_first_frame = frame;
+  m_batch.push_back(record.digest);
+  if (m_batch.size() == DIGESTS_PER_PACKET)
+    FlushDigests();
+}
+
+void DesyncDetector::FlushDigests()
+{
+  if (m_batch.empty())
+    return;
+
+  sf::Packet packet;
+  packet << MessageID::DesyncDigests;
+  packet << static_cast<sf::Uint64>(m_batch_first_frame);
+  packet << static_cast<u8>(m_batch.size());
+  for (const u64 digest : m_batch)
+    packet << static_cast<sf::Uint64>(digest);
+  m_send(std::move(packet));
+
+  m_batch.clear();
+}
+
+const DesyncDetector::FrameRecord* DesyncDetector::FindRecord(u64 frame) const
+{
+  const FrameRecord& record = m_history[frame % HISTORY_FRAMES];
+  return record.frame == frame ? &record : nullptr;
+}
+
+std::vector<u64> DesyncDetector::ComputeBlockHashes(const FrameRecord& record) const
+{
+  std::vector<u64> hashes;
+  hashes.reserve(m_blocks.size());
+  for (const Block& block : m_blocks)
+    hashes.push_back(XXH3_64bits(record.data.data() + block.data_offset, block.size));
+  return hashes;
+}
+
+void DesyncDetector::CompareDigest(PlayerId pid, u64 frame, u64 digest, const FrameRecord& record)
+{
+  if (digest == record.digest || m_desynced_players.contains(pid))
+    return;
+
+  m_desynced_players.insert(pid);
+  WARN_LOG_FMT(NETPLAY, "Desync with player {} at frame {}", pid, frame);
+
+  // Send our region and block hashes so both sides can find the blocks that differ
+  sf::Packet packet;
+  packet << MessageID::DesyncHashes;
+  packet << static_cast<sf::Uint64>(frame);
+  packet << static_cast<u16>(record.region_hashes.size());
+  for (const u64 hash : record.region_hashes)
+    packet << static_cast<sf::Uint64>(hash);
+  const std::vector<u64> block_hashes = ComputeBlockHashes(record);
+  packet << static_cast<u16>(block_hashes.size());
+  for (const u64 hash : block_hashes)
+    packet << static_cast<sf::Uint64>(hash);
+  m_send(std::move(packet));
+
+  m_on_desync(frame, pid);
+}
+
+void DesyncDetector::OnDigests(PlayerId pid, sf::Packet& packet)
+{
+  const u64 first_frame = Common::PacketReadU64(packet);
+  u8 count;
+  packet >> count;
+
+  std::lock_guard lk(m_lock);
+  for (u64 frame = first_frame; frame < first_frame + count; ++frame)
+  {
+    const u64 digest = Common::PacketReadU64(packet);
+    if (!m_last_frame || frame > *m_last_frame)
+    {
+      // We haven't reached this frame yet
+      m_remote_digests[pid][frame] = digest;
+    }
+    else if (const FrameRecord* record = FindRecord(frame))
+    {
+      CompareDigest(pid, frame, digest, *record);
+    }
+  }
+}
+
+void DesyncDetector::OnHashes(PlayerId pid, sf::Packet& packet)
+{
+  const u64 frame = Common::PacketReadU64(packet);
+  u16 region_count;
+  packet >> region_count;
+  std::vector<u64> region_hashes(region_count);
+  for (u64& hash : region_hashes)
+    hash = Common::PacketReadU64(packet);
+  u16 block_count;
+  packet >> block_count;
+  std::vector<u64> block_hashes(block_count);
+  for (u64& hash : block_hashes)
+    hash = Common::PacketReadU64(packet);
+
+  std::lock_guard lk(m_lock);
+
+  const FrameRecord* record = FindRecord(frame);
+  if (!record)
+  {
+    WARN_LOG_FMT(NETPLAY, "Desync at frame {} is too old to compare", frame);
+    return;
+  }
+  if (region_count != m_regions.size() || block_count != m_blocks.size())
+  {
+    WARN_LOG_FMT(NETPLAY, "Player {} uses different desync detection regions", pid);
+    return;
+  }
+
+  for (size_t i = 0; i < m_regions.size(); ++i)
+  {
+    if (region_hashes[i] != record->region_hashes[i])
+      WARN_LOG_FMT(NETPLAY, "Desync at frame {}: region \"{}\" differs", frame, m_regions[i].name);
+  }
+
+  const std::vector<u64> our_block_hashes = ComputeBlockHashes(*record);
+  PendingDump dump{frame, {}, {}};
+  sf::Packet reply;
+  reply << MessageID::DesyncBlocks;
+  reply << static_cast<sf::Uint64>(frame);
+
+  for (u32 i = 0; i < m_blocks.size() && dump.blocks.size() < MAX_DUMP_BLOCKS; ++i)
+  {
+    if (block_hashes[i] != our_block_hashes[i])
+      dump.blocks.push_back(i);
+  }
+
+  reply << static_cast<u16>(dump.blocks.size());
+  for (const u32 i : dump.blocks)
+  {
+    const Block& block = m_blocks[i];
+    const u8* data = record->data.data() + block.data_offset;
+    dump.data.insert(dump.data.end(), data, data + block.size);
+    reply << i;
+    reply << std::string(reinterpret_cast<const char*>(data), block.size);
+  }
+  m_send(std::move(reply));
+
+  m_pending_dumps[pid] = std::move(dump);
+}
+
+void DesyncDetector::OnBlocks(PlayerId pid, sf::Packet& packet)
+{
+  const u64 frame = Common::PacketReadU64(packet);
+  u16 count;
+  packet >> count;
+  std::map<u32, std::string> theirs;
+  for (u16 i = 0; i < count; ++i)
+  {
+    u32 index;
+    std::string data;
+    packet >> index >> data;
+    theirs.emplace(index, std::move(data));
+  }
+
+  std::lock_guard lk(m_lock);
+  const auto it = m_pending_dumps.find(pid);
+  if (it == m_pending_dumps.end() || it->second.frame != frame)
+    return;
+
+  if (Config::Get(Config::NETPLAY_DESYNC_DUMPS))
+    WriteDump(pid, it->second, theirs);
+  m_pending_dumps.erase(it);
+}
+
+void DesyncDetector::WriteDump(PlayerId pid, const PendingDump& ours,
+                               const std::map<u32, std::string>& theirs) const
+{
+  const std::string dir = File::GetUserPath(D_DUMP_IDX) + "Desync" DIR_SEP;
+  if (!File::CreateFullPath(dir))
+    return;
+
+  char datetime[32];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(datetime, sizeof(datetime), "%Y%m%dT%H%M%S", std::localtime(&now));
+  const std::string path = fmt::format("{}{}_frame{}_player{}.txt", dir, datetime, ours.frame, pid);
+
+  std::ofstream out;
+  File::OpenFStream(out, path, std::ios_base::out | std::ios_base::trunc);
+  if (!out)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Failed to write desync dump {}", path);
+    return;
+  }
+
+  out << fmt::format("Desync with player {} at frame {}\n", pid, ours.frame);
+  out << "Lines are 16 bytes of local memory, then the remote player's. Differences marked with ^^\n";
+
+  u32 data_offset = 0;
+  for (const u32 index : ours.blocks)
+  {
+    const Block& block = m_blocks[index];
+    const u8* local = ours.data.data() + data_offset;
+    data_offset += block.size;
+
+    out << fmt::format("\n[{}] {:08X}-{:08X}\n", m_regions[block.region].name, block.address,
+                       block.address + block.size - 1);
+
+    const auto remote_it = theirs.find(index);
+    if (remote_it == theirs.end() || remote_it->second.size() != block.size)
+    {
+      out << "  (remote block missing)\n";
+      continue;
+    }
+    const u8* remote = reinterpret_cast<const u8*>(remote_it->second.data());
+
+    for (u32 line = 0; line < block.size; line += 16)
+    {
+      const u32 line_size = std::min<u32>(16, block.size - line);
+      if (std::memcmp(local + line, remote + line, line_size) == 0)
+        continue;
+
+      std::string local_hex, remote_hex, markers;
+      for (u32 i = line; i < line + line_size; ++i)
+      {
+        local_hex += fmt::format("{:02X} ", local[i]);
+        remote_hex += fmt::format("{:02X} ", remote[i]);
+        markers += local[i] != remote[i] ? "^^ " : "   ";
+      }
+      out << fmt::format("{:08X}  local  {}\n", block.address + line, local_hex);
+      out << fmt::format("{:8}  remote {}\n", "", remote_hex);
+      out << fmt::format("{:8}         {}\n", "", markers);
+    }
+  }
+
+  NOTICE_LOG_FMT(NETPLAY, "Wrote desync dump to {}", path);
+}
+}  // namespace NetPlay
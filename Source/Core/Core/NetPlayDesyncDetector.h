@@ -0,0 +1,134 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayProto.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+}
+
+namespace NetPlay
+{
+// Detects desyncs by hashing game state every frame and comparing the digests between players.
+//
+// Every frame, each configured RAM region is hashed with XXH3 and the region hashes are folded
+// into one 64-bit frame digest. Digests are sent to the other players in small batches. When a
+// remote digest does not match ours, both sides narrow the difference down in two steps: they
+// exchange per-region and per-block hashes for that frame, then the contents of the blocks that
+// differ, and each side writes a dump comparing its blocks with the other player's.
+//
+// The region contents of the last HISTORY_FRAMES frames are kept so the blocks can still be
+// compared after those round trips.
+class DesyncDetector
+{
+public:
+  struct Region
+  {
+    std::string name;
+    u32 address;
+    u32 size;
+  };
+
+  using SendFunction = std::function<void(sf::Packet&&)>;
+  using DesyncCallback = std::function<void(u64 frame, PlayerId pid)>;
+
+  // Granularity of the block comparison and of the dumps.
+  static constexpr u32 BLOCK_SIZE = 256;
+  static constexpr u32 HISTORY_FRAMES = 180;
+  static constexpr u32 DIGESTS_PER_PACKET = 10;
+  // Frames before this are not compared, the boot sequence does not line up between players.
+  static constexpr u64 FIRST_FRAME = 1000;
+  static constexpr u32 MAX_DUMP_BLOCKS = 64;
+  // The most RAM compared per frame, as HISTORY_FRAMES copies of it are kept
+  static constexpr u32 MAX_TOTAL_SIZE = 0x40000;
+
+  DesyncDetector(std::vector<Region> regions, SendFunction send, DesyncCallback on_desync);
+
+  // The regions from the NetPlay config, or the defaults for game_id if none are configured.
+  static std::vector<Region> GetRegions(std::string_view game_id);
+  // Parses a list of "name:address:size" entries separated by ';'. Regions past the end of MEM1
+  // or more than MAX_TOTAL_SIZE bytes in total are rejected.
+  static std::optional<std::vector<Region>> ParseRegions(const std::string& str);
+
+  // Called on the CPU thread once per frame.
+  void OnFrame(const Core::CPUThreadGuard& guard, u64 frame);
+  // Same as above, with ram being the contents of MEM1.
+  void OnFrame(std::span<const u8> ram, u64 frame);
+
+  // Called on the network thread with the body of the corresponding messages.
+  void OnDigests(PlayerId pid, sf::Packet& packet);
+  void OnHashes(PlayerId pid, sf::Packet& packet);
+  void OnBlocks(PlayerId pid, sf::Packet& packet);
+
+private:
+  struct Block
+  {
+    u32 region;
+    u32 address;
+    u32 data_offset;
+    u32 size;
+  };
+
+  struct FrameRecord
+  {
+    std::optional<u64> frame;
+    u64 digest = 0;
+    std::vector<u64> region_hashes;
+    // The contents of all regions, back to back.
+    std::vector<u8> data;
+  };
+
+  // Our side of a comparison, kept until the other player's blocks arrive.
+  struct PendingDump
+  {
+    u64 frame;
+    std::vector<u32> blocks;
+    std::vector<u8> data;
+  };
+
+  const FrameRecord* FindRecord(u64 frame) const;
+  std::vector<u64> ComputeBlockHashes(const FrameRecord& record) const;
+  void CompareDigest(PlayerId pid, u64 frame, u64 digest, const FrameRecord& record);
+  void FlushDigests();
+  void WriteDump(PlayerId pid, const PendingDump& ours,
+                 const std::map<u32, std::string>& theirs) const;
+
+  const std::vector<Region> m_regions;
+  std::vector<u32> m_region_offsets;
+  std::vector<Block> m_blocks;
+  u32 m_total_size = 0;
+
+  SendFunction m_send;
+  DesyncCallback m_on_desync;
+
+  std::mutex m_lock;
+  std::vector<FrameRecord> m_history;
+  std::optional<u64> m_last_frame;
+
+  u64 m_batch_first_frame = 0;
+  std::vector<u64> m_batch;
+
+  // Remote digests for frames we have not hashed yet.
+  std::map<PlayerId, std::map<u64, u64>> m_remote_digests;
+  // Players a desync was already reported for. Only the first desync is investigated, after that
+  // every frame differs anyway.
+  std::set<PlayerId> m_desynced_players;
+  std::map<PlayerId, PendingDump> m_pending_dumps;
+};
+}  // namespace NetPlay
@@ -103,6 +103,9 @@ struct NetSettings
   bool sync_codes = false;
   std::string save_data_region;
   bool golf_mode = false;
+  bool rollback = false;
+  u32 rollback_max_frames = 0;
+  u32 relay_keyframe_interval = 0;
   bool use_fma = false;
   bool hide_remote_gbas = false;
 
@@ -154,6 +157,8 @@ enum class MessageID : u8
   PadHostData = 0x63,
   GBAConfig = 0x64,
   PadSpectator = 0x66,
+  SpectatorRelay = 0x67,
+  SpectatorKeyframe = 0x68,
 
   WiimoteData = 0x70,
   WiimoteMapping = 0x71,
@@ -175,7 +180,9 @@ enum class MessageID : u8
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
-  Checksum = 0xB2,
+  DesyncDigests = 0xB2,
+  DesyncHashes = 0xB3,
+  DesyncBlocks = 0xB4,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -236,6 +243,11 @@ enum class SyncCodeID : u8
 constexpr u32 MAX_NAME_LENGTH = 30;
 constexpr size_t CHUNKED_DATA_UNIT_SIZE = 16384;
 constexpr u32 MAX_ENET_MTU = 1392;  // see https://github.com/lsalzman/enet/issues/132
+// SpectatorKeyframe: the inputs of each pad used before the state, the size of the state, and the
+// LZ4 compressed state
+constexpr size_t SPECTATOR_KEYFRAME_HEADER_SIZE = sizeof(MessageID) + 4 * sizeof(u64) + sizeof(u32);
+// Above the size of any savestate, which is mostly the emulated memory
+constexpr u32 MAX_SPECTATOR_KEYFRAME_SIZE = 256 * 1024 * 1024;
 
 enum : u8
 {
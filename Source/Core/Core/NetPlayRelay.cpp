@@ -0,0 +1,725 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRelay.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/ENet.h"
+#include "Common/Logging/Log.h"
+#include "Common/SFMLHelper.h"
+#include "Common/Thread.h"
+#include "Common/Version.h"
+#include "Core/NetPlayCommon.h"
+#include "Core/SyncIdentifier.h"
+
+namespace NetPlay
+{
+RelayLog::Kind RelayLog::Add(const sf::Packet& packet)
+{
+  sf::Packet reader = packet;
+  MessageID mid;
+  reader >> mid;
+
+  switch (mid)
+  {
+  case MessageID::PlayerJoin:
+  {
+    PlayerId pid;
+    reader >> pid;
+    m_players[pid] = RemoveRioKey(packet);
+    return Kind::Session;
+  }
+
+  case MessageID::PlayerLeave:
+  {
+    PlayerId pid;
+    reader >> pid;
+    m_players.erase(pid);
+    m_game_status.erase(pid);
+    return Kind::Session;
+  }
+
+  case MessageID::GameStatus:
+  {
+    PlayerId pid;
+    reader >> pid;
+    m_game_status[pid] = packet;
+    return Kind::Session;
+  }
+
+  case MessageID::GBAConfig:
+  {
+    for (bool& enabled : m_gba_enabled)
+    {
+      bool has_rom;
+      std::string title;
+      std::array<u8, 20> hash;
+      reader >> enabled >> has_rom >> title;
+      for (u8& data : hash)
+        reader >> data;
+    }
+    SetLatest(mid, packet);
+    return Kind::Session;
+  }
+
+  case MessageID::PadMapping:
+  case MessageID::PadBuffer:
+  case MessageID::WiimoteMapping:
+  case MessageID::ChangeGame:
+  case MessageID::HostInputAuthority:
+  case MessageID::GameMode:
+  case MessageID::NightStadium:
+  case MessageID::DisableReplays:
+    SetLatest(mid, packet);
+    return Kind::Session;
+
+  // A new synchronization replaces what is left of one that was aborted
+  case MessageID::SyncSaveData:
+  {
+    SyncSaveDataID sub_id;
+    reader >> sub_id;
+    if (sub_id == SyncSaveDataID::Notify)
+      EraseSetup(mid);
+    m_setup.push_back(packet);
+    return Kind::Session;
+  }
+
+  case MessageID::SyncCodes:
+  {
+    SyncCodeID sub_id;
+    reader >> sub_id;
+    if (sub_id == SyncCodeID::Notify)
+      EraseSetup(mid);
+    m_setup.push_back(packet);
+    return Kind::Session;
+  }
+
+  case MessageID::StartGame:
+    ClearGame();
+    m_setup.push_back(packet);
+    m_game_running = true;
+    return Kind::Session;
+
+  case MessageID::StopGame:
+  case MessageID::DisableGame:
+    ClearGame();
+    m_setup.clear();
+    m_game_running = false;
+    return Kind::Session;
+
+  case MessageID::PadData:
+    if (!m_game_running)
+      return Kind::Drop;
+    AddInputs(packet);
+    return Kind::Game;
+
+  case MessageID::PadHostData:
+  case MessageID::WiimoteData:
+  case MessageID::GolfSwitch:
+  case MessageID::GolfPrepare:
+  case MessageID::PowerButton:
+    if (!m_game_running)
+      return Kind::Drop;
+    m_game.push_back(GameMessage{packet});
+    return Kind::Game;
+
+  case MessageID::ChatMessage:
+  case MessageID::PlayerPingData:
+  case MessageID::SendCodes:
+  case MessageID::CoinFlip:
+  case MessageID::GameID:
+  case MessageID::Stadium:
+  case MessageID::Course:
+    return Kind::Live;
+
+  // Desync detection and game digests compare what the players run, the relay answers pings, and
+  // the chunked data messages are put back together by the relay
+  default:
+    return Kind::Drop;
+  }
+}
+
+sf::Packet RelayLog::RemoveRioKey(const sf::Packet& player_join)
+{
+  sf::Packet reader = player_join;
+  MessageID mid;
+  PlayerId pid;
+  std::string name;
+  std::string rio_key;
+  std::string revision;
+  reader >> mid >> pid >> name >> rio_key >> revision;
+
+  // Same layout as NetPlayClient::OnPlayerJoin
+  sf::Packet packet;
+  packet << MessageID::PlayerJoin << pid << name << std::string() << revision;
+  return packet;
+}
+
+void RelayLog::SetKeyframe(const sf::Packet& packet)
+{
+  if (!m_game_running || packet.getDataSize() < SPECTATOR_KEYFRAME_HEADER_SIZE)
+    return;
+
+  sf::Packet reader = packet;
+  MessageID mid;
+  reader >> mid;
+  std::array<u64, 4> used;
+  for (u64& count : used)
+    count = Common::PacketReadU64(reader);
+
+  // Everything up to the first message with an input the state did not use is in the state
+  const auto first_kept =
+      std::find_if(m_game.begin(), m_game.end(), [&used](const GameMessage& message) {
+        if (!message.has_inputs)
+          return false;
+        for (size_t i = 0; i < used.size(); ++i)
+        {
+          if (message.end_input[i] > used[i])
+            return true;
+        }
+        return false;
+      });
+  const std::array<u64, 4> first_input =
+      first_kept != m_game.end() ? first_kept->first_input : m_input_count;
+  m_game.erase(m_game.begin(), first_kept);
+
+  sf::Packet keyframe;
+  keyframe << MessageID::SpectatorKeyframe;
+  for (size_t i = 0; i < used.size(); ++i)
+    keyframe << sf::Uint64{used[i] > first_input[i] ? used[i] - first_input[i] : 0};
+  constexpr size_t counts_end = sizeof(MessageID) + sizeof(used);
+  keyframe.append(static_cast<const u8*>(packet.getData()) + counts_end,
+                  packet.getDataSize() - counts_end);
+  m_keyframe = std::move(keyframe);
+}
+
+std::vector<sf::Packet> RelayLog::GetSessionMessages() const
+{
+  std::vector<sf::Packet> messages;
+  for (const auto& [pid, packet] : m_players)
+    messages.push_back(packet);
+  for (const auto& [mid, packet] : m_latest)
+    messages.push_back(packet);
+  for (const auto& [pid, packet] : m_game_status)
+    messages.push_back(packet);
+  messages.insert(messages.end(), m_setup.begin(), m_setup.end());
+  return messages;
+}
+
+std::vector<sf::Packet> RelayLog::GetGameMessages() const
+{
+  std::vector<sf::Packet> messages;
+  if (m_keyframe)
+    messages.push_back(*m_keyframe);
+  for (const GameMessage& message : m_game)
+    messages.push_back(message.packet);
+  return messages;
+}
+
+void RelayLog::SetLatest(MessageID mid, const sf::Packet& packet)
+{
+  const auto it = std::find_if(m_latest.begin(), m_latest.end(),
+                               [mid](const auto& pair) { return pair.first == mid; });
+  if (it != m_latest.end())
+    it->second = packet;
+  else
+    m_latest.emplace_back(mid, packet);
+}
+
+void RelayLog::EraseSetup(MessageID mid)
+{
+  std::erase_if(m_setup, [mid](const sf::Packet& packet) {
+    return *static_cast<const MessageID*>(packet.getData()) == mid;
+  });
+}
+
+void RelayLog::AddInputs(sf::Packet packet)
+{
+  GameMessage& message = m_game.emplace_back(GameMessage{packet, true, m_input_count});
+
+  MessageID mid;
+  packet >> mid;
+  while (!packet.endOfPacket())
+  {
+    PadIndex map;
+    u16 button;
+    packet >> map >> button;
+    if (!packet || map < 0 || map >= static_cast<PadIndex>(m_input_count.size()))
+      break;
+
+    // Same layout as NetPlayClient::OnPadData
+    if (!m_gba_enabled[map])
+    {
+      u8 analog[8];
+      bool is_connected;
+      for (u8& value : analog)
+        packet >> value;
+      packet >> is_connected;
+    }
+    ++m_input_count[map];
+  }
+
+  message.end_input = m_input_count;
+}
+
+void RelayLog::ClearGame()
+{
+  m_game.clear();
+  m_input_count.fill(0);
+  m_keyframe.reset();
+}
+
+NetPlayRelay::NetPlayRelay(const std::string& host_address, u16 host_port,
+                           const std::string& token, u16 port, u32 max_spectators,
+                           std::chrono::milliseconds delay)
+    : m_max_spectators(std::max(max_spectators, 1u)), m_delay(delay)
+{
+  if (enet_initialize() != 0)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: enet_initialize failed");
+    return;
+  }
+
+  ENetAddress address;
+  address.host = ENET_HOST_ANY;
+  address.port = port;
+  m_downstream = enet_host_create(&address, m_max_spectators, CHANNEL_COUNT, 0, 0);
+  if (m_downstream == nullptr)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: could not listen on port {}", port);
+    return;
+  }
+  m_downstream->mtu = std::min(m_downstream->mtu, MAX_ENET_MTU);
+
+  if (!ConnectToHost(host_address, host_port, token))
+    return;
+
+  m_is_connected.Set();
+  m_thread = std::thread(&NetPlayRelay::ThreadFunc, this);
+}
+
+NetPlayRelay::~NetPlayRelay()
+{
+  if (m_thread.joinable())
+  {
+    m_do_loop.Clear();
+    m_thread.join();
+  }
+
+  if (m_upstream)
+  {
+    if (m_host)
+    {
+      enet_peer_disconnect(m_host, 0);
+      enet_host_flush(m_upstream);
+    }
+    enet_host_destroy(m_upstream);
+  }
+
+  if (m_downstream)
+  {
+    for (const auto& [peer, state] : m_spectators)
+      enet_peer_disconnect(peer, 0);
+    enet_host_flush(m_downstream);
+    enet_host_destroy(m_downstream);
+  }
+}
+
+// Connects like NetPlayClient does over a direct connection, then tells the host it is a relay
+bool NetPlayRelay::ConnectToHost(const std::string& host_address, u16 host_port,
+                                 const std::string& token)
+{
+  m_upstream = enet_host_create(nullptr, 1, CHANNEL_COUNT, 0, 0);
+  if (m_upstream == nullptr)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: could not create client");
+    return false;
+  }
+  m_upstream->mtu = std::min(m_upstream->mtu, MAX_ENET_MTU);
+
+  ENetAddress address;
+  enet_address_set_host(&address, host_address.c_str());
+  address.port = host_port;
+  m_host = enet_host_connect(m_upstream, &address, CHANNEL_COUNT, 0);
+  if (m_host == nullptr)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: could not create peer");
+    return false;
+  }
+  enet_peer_timeout(m_host, 0, PEER_TIMEOUT.count(), PEER_TIMEOUT.count());
+
+  ENetEvent event;
+  if (enet_host_service(m_upstream, &event, 5000) <= 0 || event.type != ENET_EVENT_TYPE_CONNECT)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: could not connect to {}:{}", host_address, host_port);
+    return false;
+  }
+
+  sf::Packet hello;
+  hello << Common::GetScmRevGitStr();
+  hello << Common::GetNetplayDolphinVer();
+  hello << std::string("Relay");
+  hello << std::string();
+  SendToHost(hello);
+
+  if (enet_host_service(m_upstream, &event, 5000) <= 0 || event.type != ENET_EVENT_TYPE_RECEIVE)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: the host did not answer");
+    return false;
+  }
+
+  sf::Packet response;
+  response.append(event.packet->data, event.packet->dataLength);
+  enet_packet_destroy(event.packet);
+
+  ConnectionError error;
+  response >> error;
+  if (error != ConnectionError::NoError)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Relay: the host refused the connection ({})", static_cast<u8>(error));
+    return false;
+  }
+  response >> m_pid;
+
+  // The host disconnects the relay if the token is wrong
+  sf::Packet relay;
+  relay << MessageID::SpectatorRelay << token;
+  SendToHost(relay);
+
+  INFO_LOG_FMT(NETPLAY, "Relay: connected to {}:{} as player {}", host_address, host_port, m_pid);
+  return true;
+}
+
+void NetPlayRelay::ThreadFunc()
+{
+  Common::SetCurrentThreadName("NetPlay Relay");
+
+  while (m_do_loop.IsSet())
+  {
+    // Inputs come from the host, so only wait on it. The spectators only acknowledge the start
+    // of a game and can wait a few milliseconds.
+    ENetEvent event;
+    if (enet_host_service(m_upstream, &event, 4) > 0)
+    {
+      do
+      {
+        switch (event.type)
+        {
+        case ENET_EVENT_TYPE_RECEIVE:
+        {
+          sf::Packet packet;
+          packet.append(event.packet->data, event.packet->dataLength);
+          enet_packet_destroy(event.packet);
+          OnHostData(std::move(packet));
+          break;
+        }
+        case ENET_EVENT_TYPE_DISCONNECT:
+          INFO_LOG_FMT(NETPLAY, "Relay: disconnected from the host");
+          m_host = nullptr;
+          m_is_connected.Clear();
+          return;
+        default:
+          break;
+        }
+      } while (enet_host_check_events(m_upstream, &event) > 0);
+    }
+
+    ReleaseDelayedMessages();
+
+    while (enet_host_service(m_downstream, &event, 0) > 0)
+    {
+      switch (event.type)
+      {
+      case ENET_EVENT_TYPE_RECEIVE:
+      {
+        sf::Packet packet;
+        packet.append(event.packet->data, event.packet->dataLength);
+        enet_packet_destroy(event.packet);
+        if (m_spectators.contains(event.peer))
+          OnSpectatorData(event.peer, packet);
+        else
+          OnSpectatorConnect(event.peer, packet);
+        break;
+      }
+      case ENET_EVENT_TYPE_DISCONNECT:
+        m_spectators.erase(event.peer);
+        INFO_LOG_FMT(NETPLAY, "Relay: spectator left, {} watching", m_spectators.size());
+        break;
+      default:
+        break;
+      }
+    }
+  }
+}
+
+// Answers right away what the host waits on, and holds everything else back for the delay
+void NetPlayRelay::OnHostData(sf::Packet packet)
+{
+  sf::Packet reader = packet;
+  MessageID mid;
+  reader >> mid;
+
+  switch (mid)
+  {
+  case MessageID::Ping:
+  {
+    u32 ping_key;
+    reader >> ping_key;
+    sf::Packet pong;
+    pong << MessageID::Pong << ping_key;
+    SendToHost(pong);
+    return;
+  }
+
+  case MessageID::ChangeGame:
+  {
+    // The relay does not run the game, so it never holds up its start
+    sf::Packet status;
+    status << MessageID::GameStatus << SyncIdentifierComparison::SameGame;
+    SendToHost(status);
+
+    sf::Packet capabilities;
+    capabilities << MessageID::ClientCapabilities << true << true;
+    SendToHost(capabilities);
+    break;
+  }
+
+  case MessageID::PlayerJoin:
+    packet = RelayLog::RemoveRioKey(packet);
+    break;
+
+  case MessageID::ComputeGameDigest:
+  {
+    sf::Packet error;
+    error << MessageID::GameDigestError << std::string("Spectator relays do not have the game");
+    SendToHost(error);
+    return;
+  }
+
+  case MessageID::SyncSaveData:
+  {
+    SyncSaveDataID sub_id;
+    reader >> sub_id;
+    if (sub_id == SyncSaveDataID::Notify)
+    {
+      reader >> m_save_data_count;
+      m_save_data_received = 0;
+    }
+    else
+    {
+      ++m_save_data_received;
+    }
+
+    if (m_save_data_received >= m_save_data_count)
+    {
+      sf::Packet success;
+      success << MessageID::SyncSaveData << SyncSaveDataID::Success;
+      SendToHost(success);
+    }
+    break;
+  }
+
+  case MessageID::SyncCodes:
+  {
+    SyncCodeID sub_id;
+    reader >> sub_id;
+    switch (sub_id)
+    {
+    case SyncCodeID::Notify:
+      m_gecko_codes_complete = false;
+      m_ar_codes_complete = false;
+      break;
+    case SyncCodeID::NotifyGecko:
+    {
+      u16 count;
+      reader >> count;
+      m_gecko_codes_complete = count == 0;
+      break;
+    }
+    case SyncCodeID::NotifyAR:
+    {
+      u16 count;
+      reader >> count;
+      m_ar_codes_complete = count == 0;
+      break;
+    }
+    case SyncCodeID::GeckoData:
+      m_gecko_codes_complete = true;
+      break;
+    case SyncCodeID::ARData:
+      m_ar_codes_complete = true;
+      break;
+    default:
+      break;
+    }
+
+    if (sub_id != SyncCodeID::Notify && m_gecko_codes_complete && m_ar_codes_complete)
+    {
+      sf::Packet success;
+      success << MessageID::SyncCodes << SyncCodeID::Success;
+      SendToHost(success);
+    }
+    break;
+  }
+
+  case MessageID::ChunkedDataStart:
+  case MessageID::ChunkedDataPayload:
+  case MessageID::ChunkedDataEnd:
+  case MessageID::ChunkedDataAbort:
+    OnHostChunkedData(mid, reader);
+    return;
+
+  default:
+    break;
+  }
+
+  m_delayed.push_back(
+      DelayedMessage{std::chrono::steady_clock::now() + m_delay, std::move(packet)});
+}
+
+// Spectators get the messages whole, the ENet connection to them is not shared with anything
+void NetPlayRelay::OnHostChunkedData(MessageID mid, sf::Packet& packet)
+{
+  u32 cid;
+  packet >> cid;
+
+  switch (mid)
+  {
+  case MessageID::ChunkedDataStart:
+    m_chunked_data[cid] = sf::Packet{};
+    break;
+
+  case MessageID::ChunkedDataPayload:
+  {
+    const auto it = m_chunked_data.find(cid);
+    if (it == m_chunked_data.end())
+      break;
+    constexpr size_t header_size = sizeof(MessageID) + sizeof(u32);
+    it->second.append(static_cast<const u8*>(packet.getData()) + header_size,
+                      packet.getDataSize() - header_size);
+    break;
+  }
+
+  case MessageID::ChunkedDataEnd:
+  {
+    const auto it = m_chunked_data.find(cid);
+    if (it == m_chunked_data.end())
+      break;
+    sf::Packet data = std::move(it->second);
+    m_chunked_data.erase(it);
+
+    sf::Packet complete;
+    complete << MessageID::ChunkedDataComplete << cid;
+    SendToHost(complete, CHUNKED_DATA_CHANNEL);
+
+    OnHostData(std::move(data));
+    break;
+  }
+
+  default:
+    m_chunked_data.erase(cid);
+    break;
+  }
+}
+
+void NetPlayRelay::ReleaseDelayedMessages()
+{
+  const auto now = std::chrono::steady_clock::now();
+  while (!m_delayed.empty() && m_delayed.front().time <= now)
+  {
+    const sf::Packet packet = std::move(m_delayed.front().packet);
+    m_delayed.pop_front();
+
+    if (*static_cast<const MessageID*>(packet.getData()) == MessageID::SpectatorKeyframe)
+    {
+      m_log.SetKeyframe(packet);
+      continue;
+    }
+
+    const bool was_running = m_log.IsGameRunning();
+    switch (m_log.Add(packet))
+    {
+    case RelayLog::Kind::Session:
+    case RelayLog::Kind::Live:
+      SendToSpectators(packet, false);
+      break;
+    case RelayLog::Kind::Game:
+      SendToSpectators(packet, true);
+      break;
+    case RelayLog::Kind::Drop:
+      break;
+    }
+
+    // The inputs of a game are only sent once a spectator started it and cleared its buffers
+    if (was_running != m_log.IsGameRunning() ||
+        *static_cast<const MessageID*>(packet.getData()) == MessageID::StartGame)
+    {
+      for (auto& [peer, state] : m_spectators)
+        state = m_log.IsGameRunning() ? SpectatorState::WaitingForStart : SpectatorState::Lobby;
+    }
+  }
+}
+
+void NetPlayRelay::OnSpectatorConnect(ENetPeer* peer, sf::Packet& packet)
+{
+  std::string netplay_version;
+  packet >> netplay_version;
+
+  sf::Packet response;
+  if (netplay_version != Common::GetScmRevGitStr())
+  {
+    response << ConnectionError::VersionMismatch;
+    Common::ENet::SendPacket(peer, response, DEFAULT_CHANNEL);
+    enet_peer_disconnect_later(peer, 0);
+    return;
+  }
+
+  enet_peer_timeout(peer, 0, PEER_TIMEOUT.count(), PEER_TIMEOUT.count());
+
+  // Spectators take the relay's player ID, which has no pads
+  response << MessageID::ConnectionSuccessful << m_pid;
+  Common::ENet::SendPacket(peer, response, DEFAULT_CHANNEL);
+  sf::Packet relay;
+  relay << MessageID::SpectatorRelay;
+  Common::ENet::SendPacket(peer, relay, DEFAULT_CHANNEL);
+  for (const sf::Packet& message : m_log.GetSessionMessages())
+    Common::ENet::SendPacket(peer, message, DEFAULT_CHANNEL);
+
+  m_spectators[peer] =
+      m_log.IsGameRunning() ? SpectatorState::WaitingForStart : SpectatorState::Lobby;
+  INFO_LOG_FMT(NETPLAY, "Relay: spectator joined, {} watching", m_spectators.size());
+}
+
+void NetPlayRelay::OnSpectatorData(ENetPeer* peer, sf::Packet& packet)
+{
+  MessageID mid;
+  packet >> mid;
+
+  // Everything else a spectator sends is meant for a host that runs the game with it
+  SpectatorState& state = m_spectators[peer];
+  if (mid != MessageID::StartGame || state != SpectatorState::WaitingForStart)
+    return;
+
+  for (const sf::Packet& message : m_log.GetGameMessages())
+    Common::ENet::SendPacket(peer, message, DEFAULT_CHANNEL);
+  state = SpectatorState::Running;
+}
+
+void NetPlayRelay::SendToHost(const sf::Packet& packet, u8 channel_id)
+{
+  Common::ENet::SendPacket(m_host, packet, channel_id);
+}
+
+void NetPlayRelay::SendToSpectators(const sf::Packet& packet, bool running_only)
+{
+  for (const auto& [peer, state] : m_spectators)
+  {
+    if (!running_only || state == SpectatorState::Running)
+      Common::ENet::SendPacket(peer, packet, DEFAULT_CHANNEL);
+  }
+}
+}  // namespace NetPlay
@@ -0,0 +1,153 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+#include <enet/enet.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+#include "Core/NetPlayProto.h"
+
+namespace NetPlay
+{
+// The messages of a host a relay has to keep so spectators can join at any time: the state of the
+// lobby, the setup of the running game, and the inputs of the game since the last keyframe.
+class RelayLog
+{
+public:
+  enum class Kind
+  {
+    // Changes the lobby or sets up a game. Sent to all spectators and kept.
+    Session,
+    // Part of the running game. Sent to the spectators that run it and kept.
+    Game,
+    // Sent to all spectators, but not kept
+    Live,
+    // Not for spectators
+    Drop,
+  };
+
+  Kind Add(const sf::Packet& packet);
+
+  // The PlayerJoin message spectators get, without the rio key of the player, which only the
+  // players and the host see.
+  static sf::Packet RemoveRioKey(const sf::Packet& player_join);
+
+  // Takes a SpectatorKeyframe from the host, which counts the inputs of each pad the state used
+  // since the game started. The inputs before the state are dropped and the counts rewritten to
+  // the inputs that remain, which a spectator skips after loading the state.
+  void SetKeyframe(const sf::Packet& packet);
+
+  bool IsGameRunning() const { return m_game_running; }
+  size_t GetGameMessageCount() const { return m_game.size(); }
+
+  // A joining spectator gets the session messages, then once it started the game, the keyframe
+  // and the game messages after it.
+  std::vector<sf::Packet> GetSessionMessages() const;
+  std::vector<sf::Packet> GetGameMessages() const;
+
+private:
+  struct GameMessage
+  {
+    sf::Packet packet;
+    bool has_inputs = false;
+    // Index of the first input of each pad in the message, and of the first input after it
+    std::array<u64, 4> first_input{};
+    std::array<u64, 4> end_input{};
+  };
+
+  void SetLatest(MessageID mid, const sf::Packet& packet);
+  void EraseSetup(MessageID mid);
+  void AddInputs(sf::Packet packet);
+  void ClearGame();
+
+  std::map<PlayerId, sf::Packet> m_players;
+  std::map<PlayerId, sf::Packet> m_game_status;
+  // The last message of each kind that replaces the previous one, in the order they first came
+  std::vector<std::pair<MessageID, sf::Packet>> m_latest;
+  std::array<bool, 4> m_gba_enabled{};
+
+  std::vector<sf::Packet> m_setup;
+  bool m_game_running = false;
+  std::deque<GameMessage> m_game;
+  std::array<u64, 4> m_input_count{};
+  std::optional<sf::Packet> m_keyframe;
+};
+
+// A spectator that connects to the host like a player and passes the game on to many spectators,
+// after a delay. The host sends each input and keyframe once, whatever the number of spectators.
+class NetPlayRelay
+{
+public:
+  // token is the one the host set in NETPLAY_RELAY_TOKEN
+  NetPlayRelay(const std::string& host_address, u16 host_port, const std::string& token, u16 port,
+               u32 max_spectators, std::chrono::milliseconds delay);
+  ~NetPlayRelay();
+
+  NetPlayRelay(const NetPlayRelay&) = delete;
+  NetPlayRelay& operator=(const NetPlayRelay&) = delete;
+
+  // False once the connection to the host is closed
+  bool IsConnected() const { return m_is_connected.IsSet(); }
+
+private:
+  enum class SpectatorState
+  {
+    Lobby,
+    WaitingForStart,
+    Running,
+  };
+
+  struct DelayedMessage
+  {
+    std::chrono::steady_clock::time_point time;
+    sf::Packet packet;
+  };
+
+  bool ConnectToHost(const std::string& host_address, u16 host_port, const std::string& token);
+  void ThreadFunc();
+
+  void OnHostData(sf::Packet packet);
+  void OnHostChunkedData(MessageID mid, sf::Packet& packet);
+  void ReleaseDelayedMessages();
+  void OnSpectatorConnect(ENetPeer* peer, sf::Packet& packet);
+  void OnSpectatorData(ENetPeer* peer, sf::Packet& packet);
+
+  void SendToHost(const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
+  void SendToSpectators(const sf::Packet& packet, bool running_only);
+
+  ENetHost* m_upstream = nullptr;
+  ENetPeer* m_host = nullptr;
+  ENetHost* m_downstream = nullptr;
+  PlayerId m_pid = 0;
+  u32 m_max_spectators;
+  std::chrono::milliseconds m_delay;
+
+  RelayLog m_log;
+  std::deque<DelayedMessage> m_delayed;
+  std::unordered_map<ENetPeer*, SpectatorState> m_spectators;
+  std::unordered_map<u32, sf::Packet> m_chunked_data;
+
+  // What the relay answers the host's save and code synchronization with
+  u8 m_save_data_count = 0;
+  u8 m_save_data_received = 0;
+  bool m_gecko_codes_complete = false;
+  bool m_ar_codes_complete = false;
+
+  Common::Flag m_is_connected{false};
+  Common::Flag m_do_loop{true};
+  std::thread m_thread;
+};
+}  // namespace NetPlay
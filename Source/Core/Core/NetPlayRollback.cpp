@@ -0,0 +1,120 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+
+#include "Common/Assert.h"
+
+namespace NetPlay
+{
+static bool IsSameInput(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+RollbackSession::RollbackSession(u32 max_frames, const std::array<bool, 4>& active_pads)
+    : m_max_frames(std::max<u32>(max_frames, 1))
+{
+  for (size_t i = 0; i < m_pads.size(); ++i)
+    m_pads[i].active = active_pads[i];
+}
+
+bool RollbackSession::HasInput(PadIndex pad) const
+{
+  return m_pads[pad].known_frames > m_frame;
+}
+
+bool RollbackSession::CanPredict(PadIndex pad) const
+{
+  const Pad& p = m_pads[pad];
+  return p.known_frames != 0 && m_frame - p.known_frames < m_max_frames;
+}
+
+RollbackSession::Input& RollbackSession::GetEntry(Pad& pad, u64 frame)
+{
+  ASSERT(frame >= m_first_frame);
+  const u64 index = frame - m_first_frame;
+  while (pad.inputs.size() <= index)
+    pad.inputs.emplace_back();
+  return pad.inputs[index];
+}
+
+void RollbackSession::AddInput(PadIndex pad, const GCPadStatus& status)
+{
+  Pad& p = m_pads[pad];
+  if (!p.active)
+    return;
+
+  const u64 frame = p.known_frames++;
+  p.last_known = status;
+
+  Input& input = GetEntry(p, frame);
+  input.status = status;
+  input.known = true;
+  if (input.predicted && !IsSameInput(*input.predicted, status))
+    m_rollback_frame = std::min(m_rollback_frame.value_or(frame), frame);
+  input.predicted.reset();
+}
+
+GCPadStatus RollbackSession::GetInput(PadIndex pad)
+{
+  Pad& p = m_pads[pad];
+  if (!p.active)
+    return {};
+
+  Input& input = GetEntry(p, m_frame);
+  if (input.known)
+    return input.status;
+
+  input.predicted = p.last_known;
+  return *input.predicted;
+}
+
+void RollbackSession::EndFrame()
+{
+  ++m_frame;
+  Trim();
+}
+
+std::optional<u64> RollbackSession::TakeRollback()
+{
+  if (!m_rollback_frame)
+    return std::nullopt;
+
+  const u64 frame = *m_rollback_frame;
+  m_rollback_frame.reset();
+  m_resimulate_end = std::max(m_resimulate_end, m_frame);
+  m_frame = frame;
+  return frame;
+}
+
+u64 RollbackSession::GetFirstUnconfirmedFrame() const
+{
+  u64 frame = std::min(m_frame, m_rollback_frame.value_or(m_frame));
+  for (const Pad& p : m_pads)
+  {
+    if (p.active)
+      frame = std::min(frame, p.known_frames);
+  }
+  return frame;
+}
+
+// Drops the inputs no rollback can go back to anymore.
+void RollbackSession::Trim()
+{
+  const u64 first_needed = GetFirstUnconfirmedFrame();
+  for (; m_first_frame < first_needed; ++m_first_frame)
+  {
+    for (Pad& p : m_pads)
+    {
+      if (!p.inputs.empty())
+        p.inputs.pop_front();
+    }
+  }
+}
+}  // namespace NetPlay
@@ -0,0 +1,90 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayProto.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Input bookkeeping for the rollback network mode.
+//
+// Instead of waiting for the other players' inputs, a frame whose remote inputs have not arrived
+// yet runs with a prediction: the last input received from that player. Every input a frame ran
+// with is kept until the real inputs of that frame are known. When an input arrives that differs
+// from the prediction used for its frame, the frames from there on have to be simulated again,
+// starting from a savestate taken just before that frame.
+//
+// Frames are counted in batched pad polls, not in video frames. A player's inputs arrive in the
+// order they were polled, so the nth input of a pad belongs to frame n. The caller polls the
+// current frame's inputs with AddInput/GetInput, then calls EndFrame.
+class RollbackSession
+{
+public:
+  // active_pads are the in-game pads that are played, locally or remotely.
+  RollbackSession(u32 max_frames, const std::array<bool, 4>& active_pads);
+
+  u32 GetMaxFrames() const { return m_max_frames; }
+  // The frame being polled.
+  u64 GetFrame() const { return m_frame; }
+  // Whether the current frame already ran once and is simulated again after a rollback.
+  bool IsResimulating() const { return m_frame < m_resimulate_end; }
+
+  // Whether the input of pad for the current frame is known.
+  bool HasInput(PadIndex pad) const;
+  // Whether the current frame may run with a predicted input for pad. This is not the case before
+  // the first input of pad arrived, or when the current frame is max_frames ahead of its inputs.
+  bool CanPredict(PadIndex pad) const;
+
+  // Adds the next input of pad. Inputs must be added in the order they were polled.
+  void AddInput(PadIndex pad, const GCPadStatus& status);
+  // The input of pad for the current frame, or a prediction if it is not known yet.
+  GCPadStatus GetInput(PadIndex pad);
+
+  void EndFrame();
+
+  // If a prediction turned out wrong, returns the first frame that has to be simulated again and
+  // makes it the current frame. The frames up to the one that was current are then resimulated.
+  // The caller must restore the state from before the returned frame.
+  std::optional<u64> TakeRollback();
+
+  // The first frame that ran with a prediction still unconfirmed. Savestates from before this frame
+  // are not needed anymore.
+  u64 GetFirstUnconfirmedFrame() const;
+
+private:
+  struct Input
+  {
+    GCPadStatus status;
+    bool known = false;
+    // The prediction the frame ran with, if it ran before the input was known.
+    std::optional<GCPadStatus> predicted;
+  };
+
+  struct Pad
+  {
+    bool active = false;
+    // Inputs from frame m_first_frame on.
+    std::deque<Input> inputs;
+    // Number of inputs received, i.e. the first frame without a known input.
+    u64 known_frames = 0;
+    GCPadStatus last_known;
+  };
+
+  Input& GetEntry(Pad& pad, u64 frame);
+  void Trim();
+
+  const u32 m_max_frames;
+  std::array<Pad, 4> m_pads;
+  u64 m_first_frame = 0;
+  u64 m_frame = 0;
+  u64 m_resimulate_end = 0;
+  std::optional<u64> m_rollback_frame;
+};
+}  // namespace NetPlay
@@ -856,6 +856,46 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::SpectatorRelay:
+  {
+    // A relay loses its pads and gets the host's keyframes, so it has to know the token the host
+    // set, and can only become one in the lobby
+    std::string token;
+    packet >> token;
+    const std::string expected_token = Config::Get(Config::NETPLAY_RELAY_TOKEN);
+    if (player.IsHost() || !packet || expected_token.empty() || token != expected_token ||
+        m_is_running || m_start_pending)
+    {
+      WARN_LOG_FMT(NETPLAY, "Refused spectator relay from player {}", player.pid);
+      return 1;
+    }
+
+    player.is_relay = true;
+
+    auto padmap = GetPadMapping();
+    for (PlayerId& mapping : padmap)
+    {
+      if (mapping == player.pid)
+        mapping = 0;
+    }
+    SetPadMapping(padmap);
+  }
+  break;
+
+  case MessageID::SpectatorKeyframe:
+  {
+    if (!player.IsHost())
+      break;
+
+    // The relays hand it to the spectators that join later, so the host sends it only once
+    for (const auto& [pid, client] : m_players)
+    {
+      if (client.is_relay)
+        SendChunked(sf::Packet(packet), pid, "Spectator keyframe");
+    }
+  }
+  break;
+
   case MessageID::SendCodes:
   {
     std::string codes;
@@ -1236,7 +1276,9 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
     std::vector<std::pair<PlayerId, u64>>& timebases = m_timebase_by_frame[frame];
     timebases.emplace_back(player.pid, timebase);
-    if (timebases.size() >= m_players.size())
+    const size_t relay_count = std::count_if(m_players.begin(), m_players.end(),
+                                             [](const auto& pair) { return pair.second.is_relay; });
+    if (timebases.size() >= m_players.size() - relay_count)
     {
       // we have all records for this frame
 
@@ -1270,18 +1312,17 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
-  case MessageID::Checksum:
+  case MessageID::DesyncDigests:
+  case MessageID::DesyncHashes:
+  case MessageID::DesyncBlocks:
   {
-    u32 inChecksum;
-    u8 checksumId;
-    packet >> inChecksum;
-    packet >> checksumId;
-
+    // Only the clients compare game state, forward the message tagged with its sender
     sf::Packet spac;
-    spac << MessageID::Checksum;
-    spac << inChecksum;
-    spac << checksumId;
-    SendToClients(spac);
+    spac << mid;
+    spac << player.pid;
+    spac.append(static_cast<const u8*>(packet.getData()) + sizeof(MessageID),
+                packet.getDataSize() - sizeof(MessageID));
+    SendToClients(spac, player.pid);
   }
   break;
 
@@ -1647,6 +1688,15 @@ bool NetPlayServer::SetupNetSettings()
   settings.strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   settings.sync_codes = true;
   settings.golf_mode = Config::Get(Config::NETPLAY_NETWORK_MODE) == "golf";
+  settings.rollback = Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback";
+  settings.rollback_max_frames = Config::Get(Config::NETPLAY_ROLLBACK_MAX_FRAMES);
+  // Keyframes are only useful to relays and need the fixed input delay of the default mode
+  const bool has_relay = std::any_of(m_players.begin(), m_players.end(),
+                                     [](const auto& pair) { return pair.second.is_relay; });
+  settings.relay_keyframe_interval =
+      has_relay && !settings.golf_mode && !settings.rollback && !m_host_input_authority ?
+          Config::Get(Config::NETPLAY_RELAY_KEYFRAME_INTERVAL) :
+          0;
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
 
@@ -1854,6 +1904,9 @@ bool NetPlayServer::StartGame()
   spac << m_settings.sync_codes;
 
   spac << m_settings.golf_mode;
+  spac << m_settings.rollback;
+  spac << m_settings.rollback_max_frames;
+  spac << m_settings.relay_keyframe_interval;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
 
@@ -94,6 +94,8 @@ private:
     SyncIdentifierComparison game_status = SyncIdentifierComparison::Unknown;
     bool has_ipl_dump = false;
     bool has_hardware_fma = false;
+    // A spectator relay, which takes no pads and does not emulate the game
+    bool is_relay = false;
 
     ENetPeer* socket = nullptr;
     u32 ping = 0;
@@ -860,6 +860,7 @@ static void WriteMemory(const Core::CPUThreadGuard& guard)
   auto& memory = system.GetMemory();
   u8* dst = memory.GetPointer(addr);
   Hex2mem(dst, s_cmd_bfr + i + 1, len);
+  memory.MarkDirty(dst, len);
   SendReply("OK");
 }
 
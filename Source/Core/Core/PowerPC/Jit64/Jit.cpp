@@ -314,8 +314,13 @@ void Jit64::ClearCache()
 void Jit64::ResetFreeMemoryRanges()
 {
   // Set the entire near and far code regions as unused.
+  m_hot_code_end = region;
+  if (UseBlockProfile() && m_block_profile.HasHotBlocks())
+    m_hot_code_end = region + HOT_CODE_SIZE;
+  m_free_ranges_hot.clear();
+  m_free_ranges_hot.insert(region, m_hot_code_end);
   m_free_ranges_near.clear();
-  m_free_ranges_near.insert(region, region + region_size);
+  m_free_ranges_near.insert(m_hot_code_end, region + region_size);
   m_free_ranges_far.clear();
   m_free_ranges_far.insert(m_far_code.GetWritableCodePtr(), m_far_code.GetWritableCodeEnd());
 }
@@ -471,6 +476,12 @@ bool Jit64::Cleanup()
     ABI_PopRegistersAndAdjustStack({}, 0);
     did_something = true;
   }
+  else if (m_record_block_profile)
+  {
+    MOV(64, R(RSCRATCH2), ImmPtr(&js.curBlock->profile_data.downcountCounter));
+    ADD(64, MatR(RSCRATCH2), Imm32(js.downcountAmount));
+    did_something = true;
+  }
 
   return did_something;
 }
@@ -748,6 +759,12 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 {
   CleanUpAfterStackFault();
 
+  if (m_block_profile_changed)
+  {
+    m_block_profile_changed = false;
+    ClearCache();
+  }
+
   if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
     if (!SConfig::GetInstance().bJITNoBlockCache)
@@ -757,13 +774,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     ClearCache();
   }
 
-  // Check if any code blocks have been freed in the block cache and transfer this information to
-  // the local rangesets to allow overwriting them with new code.
-  for (auto range : blocks.GetRangesToFreeNear())
-    m_free_ranges_near.insert(range.first, range.second);
-  for (auto range : blocks.GetRangesToFreeFar())
-    m_free_ranges_far.insert(range.first, range.second);
-  blocks.ClearRangesToFree();
+  TakeFreedRanges();
 
   std::size_t block_size = m_code_buffer.size();
 
@@ -794,7 +805,12 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  // Hot blocks follow more branches, which makes for more code but fewer exits to the dispatcher
+  const bool hot = IsHotBlock(em_address);
+  const u32 nextPC =
+      analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size,
+                       hot ? PPCAnalyst::PPCAnalyzer::HOT_BRANCH_FOLLOWING_THRESHOLD :
+                             PPCAnalyst::PPCAnalyzer::BRANCH_FOLLOWING_THRESHOLD);
 
   if (code_block.m_memory_exception)
   {
@@ -807,35 +823,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
-  if (SetEmitterStateToFreeCodeRegion())
-  {
-    u8* near_start = GetWritableCodePtr();
-    u8* far_start = m_far_code.GetWritableCodePtr();
-
-    JitBlock* b = blocks.AllocateBlock(em_address);
-    if (DoJit(em_address, b, nextPC))
-    {
-      // Code generation succeeded.
-
-      // Mark the memory regions that this code block uses as used in the local rangesets.
-      u8* near_end = GetWritableCodePtr();
-      if (near_start != near_end)
-        m_free_ranges_near.erase(near_start, near_end);
-      u8* far_end = m_far_code.GetWritableCodePtr();
-      if (far_start != far_end)
-        m_free_ranges_far.erase(far_start, far_end);
-
-      // Store the used memory regions in the block so we know what to mark as unused when the
-      // block gets invalidated.
-      b->near_begin = near_start;
-      b->near_end = near_end;
-      b->far_begin = far_start;
-      b->far_end = far_end;
-
-      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
-      return;
-    }
-  }
+  if (EmitBlock(em_address, nextPC, hot))
+    return;
 
   if (clear_cache_and_retry_on_failure)
   {
@@ -853,17 +842,105 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   std::exit(-1);
 }
 
-bool Jit64::SetEmitterStateToFreeCodeRegion()
+bool Jit64::PrecompileBlock(u32 em_address)
+{
+  // The block would be compiled again right away, or differently from what the game runs
+  if (m_block_profile_changed || m_enable_debugging || trampolines.IsAlmostFull() ||
+      SConfig::GetInstance().bJITNoBlockCache)
+  {
+    return false;
+  }
+
+  TakeFreedRanges();
+
+  const bool hot = IsHotBlock(em_address);
+  const u32 nextPC =
+      analyzer.Analyze(em_address, &code_block, &m_code_buffer, m_code_buffer.size(),
+                       hot ? PPCAnalyst::PPCAnalyzer::HOT_BRANCH_FOLLOWING_THRESHOLD :
+                             PPCAnalyst::PPCAnalyzer::BRANCH_FOLLOWING_THRESHOLD);
+  if (code_block.m_memory_exception)
+    return false;
+
+  return EmitBlock(em_address, nextPC, hot);
+}
+
+void Jit64::TakeFreedRanges()
+{
+  // Check if any code blocks have been freed in the block cache and transfer this information to
+  // the local rangesets to allow overwriting them with new code.
+  for (auto range : blocks.GetRangesToFreeNear())
+  {
+    if (range.first < m_hot_code_end)
+      m_free_ranges_hot.insert(range.first, range.second);
+    else
+      m_free_ranges_near.insert(range.first, range.second);
+  }
+  for (auto range : blocks.GetRangesToFreeFar())
+    m_free_ranges_far.insert(range.first, range.second);
+  blocks.ClearRangesToFree();
+}
+
+bool Jit64::EmitBlock(u32 em_address, u32 nextPC, bool hot)
+{
+  if (!SetEmitterStateToFreeCodeRegion(hot))
+    return false;
+
+  u8* near_start = GetWritableCodePtr();
+  u8* far_start = m_far_code.GetWritableCodePtr();
+
+  JitBlock* b = blocks.AllocateBlock(em_address);
+  if (!DoJit(em_address, b, nextPC))
+  {
+    blocks.DiscardBlock(*b);
+    return false;
+  }
+
+  // Code generation succeeded.
+
+  // Mark the memory regions that this code block uses as used in the local rangesets.
+  u8* near_end = GetWritableCodePtr();
+  if (near_start != near_end)
+  {
+    m_free_ranges_hot.erase(near_start, near_end);
+    m_free_ranges_near.erase(near_start, near_end);
+  }
+  u8* far_end = m_far_code.GetWritableCodePtr();
+  if (far_start != far_end)
+    m_free_ranges_far.erase(far_start, far_end);
+
+  // Store the used memory regions in the block so we know what to mark as unused when the
+  // block gets invalidated.
+  b->near_begin = near_start;
+  b->near_end = near_end;
+  b->far_begin = far_start;
+  b->far_end = far_end;
+
+  blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  RecordPrecompileBlock(*b, m_block_is_speculative);
+  return true;
+}
+
+bool Jit64::SetEmitterStateToFreeCodeRegion(bool hot)
 {
   // Find the largest free memory blocks and set code emitters to point at them.
   // If we can't find a free block return false instead, which will trigger a JIT cache clear.
+  // A hot block which doesn't fit in the hot part any more goes with the others.
+  const auto free_hot = m_free_ranges_hot.by_size_begin();
   const auto free_near = m_free_ranges_near.by_size_begin();
-  if (free_near == m_free_ranges_near.by_size_end())
+  if (hot && free_hot != m_free_ranges_hot.by_size_end() &&
+      free_hot.to() - free_hot.from() >= MIN_HOT_CODE_SPACE)
+  {
+    SetCodePtr(free_hot.from(), free_hot.to());
+  }
+  else if (free_near != m_free_ranges_near.by_size_end())
+  {
+    SetCodePtr(free_near.from(), free_near.to());
+  }
+  else
   {
     WARN_LOG_FMT(POWERPC, "Failed to find free memory region in near code region.");
     return false;
   }
-  SetCodePtr(free_near.from(), free_near.to());
 
   const auto free_far = m_free_ranges_far.by_size_begin();
   if (free_far == m_free_ranges_far.by_size_end())
@@ -908,6 +985,12 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+  else if (m_record_block_profile)
+  {
+    // Only count the runs and the emulated cycles, which is cheap enough for normal play
+    MOV(64, R(RSCRATCH), ImmPtr(&b->profile_data.runCount));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -922,6 +1005,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.skipInstructions = 0;
   js.carryFlag = CarryFlag::InPPCState;
   js.constantGqrValid = BitSet8();
+  m_block_is_speculative = false;
 
   // Assume that GQR values don't change often at runtime. Many paired-heavy games use largely float
   // loads and stores, which are significantly faster when inlined (especially in MMU mode, where
@@ -952,13 +1036,14 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         J_CC(CC_NZ, target);
       }
       js.constantGqrValid = gqr_static;
+      m_block_is_speculative = true;
     }
   }
 
   if (js.noSpeculativeConstantsAddresses.find(js.blockStart) ==
       js.noSpeculativeConstantsAddresses.end())
   {
-    IntializeSpeculativeConstants();
+    m_block_is_speculative |= IntializeSpeculativeConstants();
   }
 
   // Translate instructions
@@ -1237,7 +1322,7 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
 }
 
-void Jit64::IntializeSpeculativeConstants()
+bool Jit64::IntializeSpeculativeConstants()
 {
   // If the block depends on an input register which looks like a gather pipe or MMIO related
   // constant, guess that it is actually a constant input, and specialize the block based on this
@@ -1270,6 +1355,7 @@ void Jit64::IntializeSpeculativeConstants()
       gpr.SetImmediate32(i, compileTimeValue, false);
     }
   }
+  return target != nullptr;
 }
 
 bool Jit64::HandleFunctionHooking(u32 address)
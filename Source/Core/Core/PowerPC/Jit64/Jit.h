@@ -64,15 +64,20 @@ public:
   void Jit(u32 em_address) override;
   void Jit(u32 em_address, bool clear_cache_and_retry_on_failure);
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
+  bool PrecompileBlock(u32 em_address) override;
+  // Emits the block in code_block and adds it to the block cache. Returns false if it didn't fit.
+  bool EmitBlock(u32 em_address, u32 nextPC, bool hot);
 
   // Finds a free memory region and sets the near and far code emitters to point at that region.
-  // Returns false if no free memory region can be found for either of the two.
-  bool SetEmitterStateToFreeCodeRegion();
+  // Returns false if no free memory region can be found for either of the two. Hot blocks go to
+  // the hot part of the near code region while it has space.
+  bool SetEmitterStateToFreeCodeRegion(bool hot);
 
   BitSet32 CallerSavedRegistersInUse() const;
   BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
-  void IntializeSpeculativeConstants();
+  // Returns whether the block was specialized for the current register values
+  bool IntializeSpeculativeConstants();
 
   JitBlockCache* GetBlockCache() override { return &blocks; }
   void Trace();
@@ -261,6 +266,8 @@ private:
   bool HandleFunctionHooking(u32 address);
 
   void ResetFreeMemoryRanges();
+  // Makes the code space of the blocks the block cache destroyed available again
+  void TakeFreedRanges();
 
   static void ImHere(Jit64& jit);
 
@@ -274,6 +281,13 @@ private:
 
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_near;
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_far;
+  // The start of the near code region is kept for the hot blocks of the block profile, so they
+  // end up next to each other instead of spread between the rest
+  HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_hot;
+  u8* m_hot_code_end = nullptr;
+
+  // Whether the block being compiled depends on register values at the time it was compiled
+  bool m_block_is_speculative = false;
 
   const bool m_im_here_debug = false;
   const bool m_im_here_log = false;
@@ -21,3 +21,8 @@ constexpr Gen::X64Reg RMEM = Gen::RBX;
 constexpr Gen::X64Reg RPPCSTATE = Gen::RBP;
 
 constexpr size_t CODE_SIZE = 1024 * 1024 * 128;
+// The part of the near code region which holds the hot blocks of the block profile
+constexpr size_t HOT_CODE_SIZE = 1024 * 1024 * 8;
+// Less free hot code space than this and hot blocks go to the rest of the region, since a block
+// which doesn't fit into the space it was started in makes the JIT clear the cache
+constexpr size_t MIN_HOT_CODE_SPACE = 1024 * 256;
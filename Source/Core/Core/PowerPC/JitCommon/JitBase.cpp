@@ -5,12 +5,21 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <string>
 #include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Align.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/Version.h"
 
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/MainSettings.h"
@@ -18,7 +27,9 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
 #include "Core/MemTools.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -57,7 +68,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -73,6 +84,9 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JitB
     {&JitBase::bJITRegisterCacheOff, &Config::MAIN_DEBUG_JIT_REGISTER_CACHE_OFF},
     {&JitBase::m_enable_debugging, &Config::MAIN_ENABLE_DEBUGGING},
     {&JitBase::m_enable_branch_following, &Config::MAIN_JIT_FOLLOW_BRANCH},
+    {&JitBase::m_record_block_profile, &Config::MAIN_JIT_RECORD_BLOCK_PROFILE},
+    {&JitBase::m_use_block_profile, &Config::MAIN_JIT_USE_BLOCK_PROFILE},
+    {&JitBase::m_use_precompile_cache, &Config::MAIN_JIT_PRECOMPILE_CACHE},
     {&JitBase::m_enable_float_exceptions, &Config::MAIN_FLOAT_EXCEPTIONS},
     {&JitBase::m_enable_div_by_zero_exceptions, &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS},
     {&JitBase::m_low_dcbz_hack, &Config::MAIN_LOW_DCBZ_HACK},
@@ -140,6 +154,212 @@ void JitBase::RefreshConfig()
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
 }
 
+void JitBase::LoadBlockProfile(const std::string& game_id, u16 revision)
+{
+  SaveBlockProfile();
+
+  m_block_profile_game_id = game_id;
+  m_block_profile_revision = revision;
+  m_block_profile_recorded = false;
+  if (game_id.empty() ||
+      !m_block_profile.Load(JitBlockProfile::GetFileName(game_id), revision))
+  {
+    m_block_profile.Clear();
+  }
+  else
+  {
+    INFO_LOG_FMT(DYNA_REC, "Loaded the block profile of {}: {} blocks, {} of them hot", game_id,
+                 m_block_profile.GetBlockCount(), m_block_profile.GetHotBlockCount());
+  }
+
+  // The hot blocks get compiled differently, so start over the next time something is compiled
+  m_block_profile_changed = m_use_block_profile;
+}
+
+void JitBase::SaveBlockProfile()
+{
+  if (m_block_profile_game_id.empty())
+    return;
+
+  // Destroying the blocks adds their counters to the profile
+  if (m_record_block_profile)
+    GetBlockCache()->Clear();
+  if (!m_block_profile_recorded)
+    return;
+
+  const std::string path = JitBlockProfile::GetFileName(m_block_profile_game_id);
+  if (!m_block_profile.Save(path, m_block_profile_revision))
+    ERROR_LOG_FMT(DYNA_REC, "Failed to write the block profile to {}", path);
+  m_block_profile_recorded = false;
+}
+
+bool JitBase::UseBlockProfile() const
+{
+  // The profile of this host would make the blocks differ from the ones of other players or of
+  // the recording of a movie
+  return m_use_block_profile && !Core::WantsDeterminism();
+}
+
+void JitBase::RecordBlockProfile(const JitBlock& block)
+{
+  const JitBlock::ProfileData& data = block.profile_data;
+  if (!m_record_block_profile || data.runCount == 0)
+    return;
+
+  m_block_profile.AddRuns(block.effectiveAddress, data.runCount, data.downcountCounter);
+  m_block_profile_recorded = true;
+}
+
+// Blocks need at least this much time left before the deadline to be compiled
+static constexpr auto PRECOMPILE_TIME_NEEDED = std::chrono::microseconds(200);
+// How long to wait before looking for the code of the remaining blocks again
+static constexpr auto PRECOMPILE_PASS_INTERVAL = std::chrono::seconds(1);
+
+void JitBase::LoadPrecompileCache(const std::string& game_id, u16 revision)
+{
+  SavePrecompileCache();
+
+  m_precompile_game_id.clear();
+  m_precompile_cache.Clear();
+  m_precompile_queue.clear();
+  if (!m_use_precompile_cache || game_id.empty())
+    return;
+
+  m_precompile_game_id = game_id;
+  m_precompile_revision = revision;
+  m_precompile_config_key = GetPrecompileConfigKey();
+  if (!m_precompile_cache.Load(JitPrecompileCache::GetFileName(game_id), revision,
+                               m_precompile_config_key))
+  {
+    m_precompile_cache.Clear();
+    return;
+  }
+
+  const std::vector<JitPrecompileCache::Block>& blocks = m_precompile_cache.GetBlocks();
+  for (size_t i = 0; i < blocks.size(); ++i)
+  {
+    if (!blocks[i].speculative)
+      m_precompile_queue.push_back(i);
+  }
+  m_precompile_pass_left = m_precompile_queue.size();
+  m_precompile_next_pass = {};
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded the precompile cache of {}: {} blocks, {} of them to compile",
+               game_id, blocks.size(), m_precompile_queue.size());
+}
+
+void JitBase::SavePrecompileCache()
+{
+  if (m_precompile_game_id.empty() || !m_precompile_cache.HasChanged())
+    return;
+
+  const std::string path = JitPrecompileCache::GetFileName(m_precompile_game_id);
+  if (!m_precompile_cache.Save(path, m_precompile_revision, m_precompile_config_key))
+    ERROR_LOG_FMT(DYNA_REC, "Failed to write the precompile cache to {}", path);
+}
+
+void JitBase::PrecompileCachedBlocks(TimePoint deadline)
+{
+  // Compiling reads the guest code through the emulated instruction cache, at times which depend
+  // on the host, so it is left out when the emulation has to stay deterministic
+  if (m_precompile_queue.empty() || Clock::now() < m_precompile_next_pass ||
+      Core::WantsDeterminism())
+  {
+    return;
+  }
+
+  const std::vector<JitPrecompileCache::Block>& blocks = m_precompile_cache.GetBlocks();
+  while (!m_precompile_queue.empty() && Clock::now() + PRECOMPILE_TIME_NEEDED < deadline)
+  {
+    if (m_precompile_pass_left == 0)
+    {
+      m_precompile_pass_left = m_precompile_queue.size();
+      m_precompile_next_pass = Clock::now() + PRECOMPILE_PASS_INTERVAL;
+      return;
+    }
+    --m_precompile_pass_left;
+
+    const size_t index = m_precompile_queue.front();
+    m_precompile_queue.pop_front();
+    const JitPrecompileCache::Block& block = blocks[index];
+    const auto feature_flags = static_cast<CPUEmuFeatureFlags>(block.feature_flags);
+    if (GetBlockCache()->GetBlockFromStartAddress(block.effective_address, feature_flags))
+      continue;
+
+    // The game may not have loaded this code yet, or put something else there
+    const PowerPC::TranslateResult translated =
+        m_mmu.JitCache_TranslateAddress(block.effective_address);
+    if (feature_flags != m_ppc_state.feature_flags || !translated.valid ||
+        translated.address != block.physical_address ||
+        HashGuestCode(block.code_ranges) != block.code_hash)
+    {
+      m_precompile_queue.push_back(index);
+      continue;
+    }
+
+    if (!PrecompileBlock(block.effective_address))
+    {
+      m_precompile_queue.push_back(index);
+      return;
+    }
+  }
+}
+
+u64 JitBase::GetPrecompileConfigKey() const
+{
+  std::string key = fmt::format("{}\n{}\n", Common::GetScmRevGitStr(), cpu_info.Summarize());
+  for (const auto& [member, info] : JIT_SETTINGS)
+    key += this->*member ? '1' : '0';
+  return XXH3_64bits(key.data(), key.size());
+}
+
+std::optional<u64> JitBase::HashGuestCode(const JitPrecompileCache::CodeRanges& code_ranges) const
+{
+  auto& memory = m_system.GetMemory();
+  u64 hash = 0;
+  for (const JitPrecompileCache::CodeRange& range : code_ranges)
+  {
+    // Only code in RAM is cached, since looking anywhere else would raise a panic alert
+    const u32 address = range.physical_address;
+    const u32 size = range.instruction_count * sizeof(u32);
+    const u8* code = nullptr;
+    if (address < memory.GetRamSizeReal() && size <= memory.GetRamSizeReal() - address)
+    {
+      code = memory.GetRAM() + address;
+    }
+    else if (memory.GetEXRAM() && (address >> 28) == 0x1 &&
+             (address & 0x0fffffff) < memory.GetExRamSizeReal() &&
+             size <= memory.GetExRamSizeReal() - (address & 0x0fffffff))
+    {
+      code = memory.GetEXRAM() + (address & 0x0fffffff);
+    }
+    if (!code)
+      return std::nullopt;
+
+    hash = XXH3_64bits_withSeed(code, size, hash ^ address);
+  }
+  return hash;
+}
+
+void JitBase::RecordPrecompileBlock(const JitBlock& block, bool speculative)
+{
+  if (m_precompile_game_id.empty())
+    return;
+
+  JitPrecompileCache::Block cached_block;
+  cached_block.effective_address = block.effectiveAddress;
+  cached_block.physical_address = block.physicalAddress;
+  cached_block.feature_flags = block.feature_flags;
+  cached_block.speculative = speculative;
+  cached_block.code_ranges = JitPrecompileCache::GetCodeRanges(block.physical_addresses);
+  const std::optional<u64> code_hash = HashGuestCode(cached_block.code_ranges);
+  if (!code_hash)
+    return;
+
+  cached_block.code_hash = *code_hash;
+  m_precompile_cache.Record(std::move(cached_block));
+}
+
 void JitBase::InitFastmemArena()
 {
   auto& memory = m_system.GetMemory();
@@ -5,7 +5,10 @@
 
 #include <array>
 #include <cstddef>
+#include <deque>
 #include <map>
+#include <optional>
+#include <string>
 #include <unordered_set>
 #include <utility>
 
@@ -18,7 +21,9 @@
 #include "Core/MachineContext.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitCommon/JitPrecompileCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 namespace Core
@@ -149,6 +154,9 @@ protected:
   bool bJITRegisterCacheOff = false;
   bool m_enable_debugging = false;
   bool m_enable_branch_following = false;
+  bool m_record_block_profile = false;
+  bool m_use_block_profile = false;
+  bool m_use_precompile_cache = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
   bool m_low_dcbz_hack = false;
@@ -161,7 +169,23 @@ protected:
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
-  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JIT_SETTINGS;
+  JitBlockProfile m_block_profile;
+  std::string m_block_profile_game_id;
+  u16 m_block_profile_revision = 0;
+  bool m_block_profile_recorded = false;
+  bool m_block_profile_changed = false;
+
+  JitPrecompileCache m_precompile_cache;
+  std::string m_precompile_game_id;
+  u16 m_precompile_revision = 0;
+  u64 m_precompile_config_key = 0;
+  // Indices of the cached blocks which haven't been compiled yet
+  std::deque<size_t> m_precompile_queue;
+  // Blocks left to look at before waiting for more guest code to be loaded
+  size_t m_precompile_pass_left = 0;
+  TimePoint m_precompile_next_pass{};
+
+  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh();
   void RefreshConfig();
@@ -175,6 +199,21 @@ protected:
 
   bool CanMergeNextInstructions(int count) const;
 
+  // Hot blocks are compiled differently, which changes when the exceptions of a block are checked
+  bool UseBlockProfile() const;
+  bool IsHotBlock(u32 address) const
+  {
+    return UseBlockProfile() && m_block_profile.IsHot(address);
+  }
+
+  u64 GetPrecompileConfigKey() const;
+  std::optional<u64> HashGuestCode(const JitPrecompileCache::CodeRanges& code_ranges) const;
+  // Called once a block has been compiled. `speculative` is set if the code depends on register
+  // values at the time it was compiled.
+  void RecordPrecompileBlock(const JitBlock& block, bool speculative);
+  // Compiles a block without running it. Returns false if that isn't possible right now.
+  virtual bool PrecompileBlock(u32 em_address) { return false; }
+
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
 public:
@@ -187,6 +226,18 @@ public:
 
   bool IsDebuggingEnabled() const { return m_enable_debugging; }
 
+  // Saves the block profile of the previous game and loads the one of the given game
+  void LoadBlockProfile(const std::string& game_id, u16 revision);
+  void SaveBlockProfile();
+  // Called by the block cache before a block and its counters go away
+  void RecordBlockProfile(const JitBlock& block);
+
+  // Saves the precompile cache of the previous game and loads the one of the given game
+  void LoadPrecompileCache(const std::string& game_id, u16 revision);
+  void SavePrecompileCache();
+  // Compiles blocks from the precompile cache whose guest code is in memory until the deadline
+  void PrecompileCachedBlocks(TimePoint deadline);
+
   static const u8* Dispatch(JitBase& jit);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
@@ -0,0 +1,124 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+
+namespace
+{
+struct ProfileHeader
+{
+  static constexpr u32 MAGIC = 0x46504A44;  // "DJPF"
+  static constexpr u32 VERSION = 1;
+
+  u32 magic;
+  u32 version;
+  u32 block_count;
+  u16 revision;
+  u16 padding;
+};
+static_assert(sizeof(ProfileHeader) == 16);
+
+struct ProfileEntry
+{
+  u32 address;
+  u32 padding;
+  u64 run_count;
+  u64 cycles;
+};
+static_assert(sizeof(ProfileEntry) == 24);
+}  // namespace
+
+std::string JitBlockProfile::GetFileName(const std::string& game_id)
+{
+  return fmt::format("{}BlockProfile-{}.bin", File::GetUserPath(D_CACHE_IDX), game_id);
+}
+
+void JitBlockProfile::Clear()
+{
+  m_blocks.clear();
+  m_hot_blocks.clear();
+}
+
+bool JitBlockProfile::Load(const std::string& path, u16 revision)
+{
+  Clear();
+
+  File::IOFile file(path, "rb");
+  ProfileHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != ProfileHeader::MAGIC ||
+      header.version != ProfileHeader::VERSION || header.revision != revision)
+  {
+    return false;
+  }
+
+  if (header.block_count > (file.GetSize() - sizeof(header)) / sizeof(ProfileEntry))
+    return false;
+
+  std::vector<ProfileEntry> entries(header.block_count);
+  if (!file.ReadArray(entries.data(), entries.size()))
+    return false;
+
+  for (const ProfileEntry& entry : entries)
+    AddRuns(entry.address, entry.run_count / 2, entry.cycles / 2);
+  UpdateHotBlocks();
+  return true;
+}
+
+bool JitBlockProfile::Save(const std::string& path, u16 revision) const
+{
+  std::vector<ProfileEntry> entries;
+  entries.reserve(m_blocks.size());
+  for (const auto& [address, counts] : m_blocks)
+  {
+    if (counts.run_count != 0)
+      entries.push_back({address, 0, counts.run_count, counts.cycles});
+  }
+
+  const ProfileHeader header{ProfileHeader::MAGIC, ProfileHeader::VERSION,
+                             static_cast<u32>(entries.size()), revision, 0};
+  File::IOFile file(path, "wb");
+  return file.WriteArray(&header, 1) && file.WriteArray(entries.data(), entries.size());
+}
+
+void JitBlockProfile::AddRuns(u32 address, u64 run_count, u64 cycles)
+{
+  Counts& counts = m_blocks[address];
+  counts.run_count += run_count;
+  counts.cycles += cycles;
+}
+
+void JitBlockProfile::UpdateHotBlocks()
+{
+  m_hot_blocks.clear();
+
+  std::vector<std::pair<u64, u32>> blocks;
+  blocks.reserve(m_blocks.size());
+  u64 total_cycles = 0;
+  for (const auto& [address, counts] : m_blocks)
+  {
+    blocks.emplace_back(counts.cycles, address);
+    total_cycles += counts.cycles;
+  }
+  std::sort(blocks.begin(), blocks.end(), std::greater<>());
+
+  const double hot_cycles = total_cycles * HOT_CYCLES_SHARE;
+  u64 cycles = 0;
+  for (const auto& [block_cycles, address] : blocks)
+  {
+    if (cycles >= hot_cycles || m_hot_blocks.size() == MAX_HOT_BLOCKS || block_cycles == 0)
+      break;
+    m_hot_blocks.insert(address);
+    cycles += block_cycles;
+  }
+}
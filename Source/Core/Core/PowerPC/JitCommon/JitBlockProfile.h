@@ -0,0 +1,47 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Common/CommonTypes.h"
+
+// How often the blocks of a game ran and how many emulated cycles they took, kept across sessions
+// so the JIT can treat the blocks which were hot last time specially from the start.
+class JitBlockProfile
+{
+public:
+  // The smallest set of blocks which took this share of the cycles is hot
+  static constexpr double HOT_CYCLES_SHARE = 0.9;
+  static constexpr size_t MAX_HOT_BLOCKS = 4096;
+
+  static std::string GetFileName(const std::string& game_id);
+
+  void Clear();
+  // Keeps the counts of the game revision the file was recorded with, halved so that the profile
+  // follows how the game is played now. Returns false if there is no usable profile.
+  bool Load(const std::string& path, u16 revision);
+  bool Save(const std::string& path, u16 revision) const;
+
+  void AddRuns(u32 address, u64 run_count, u64 cycles);
+  void UpdateHotBlocks();
+
+  bool IsHot(u32 address) const { return m_hot_blocks.contains(address); }
+  bool HasHotBlocks() const { return !m_hot_blocks.empty(); }
+  size_t GetBlockCount() const { return m_blocks.size(); }
+  size_t GetHotBlockCount() const { return m_hot_blocks.size(); }
+
+private:
+  struct Counts
+  {
+    u64 run_count;
+    u64 cycles;
+  };
+
+  std::unordered_map<u32, Counts> m_blocks;
+  std::unordered_set<u32> m_hot_blocks;
+};
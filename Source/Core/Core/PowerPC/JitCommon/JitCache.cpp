@@ -116,6 +116,15 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
   return &b;
 }
 
+void JitBaseBlockCache::DiscardBlock(const JitBlock& block)
+{
+  const auto [begin, end] = block_map.equal_range(block.physicalAddress);
+  const auto iter =
+      std::find_if(begin, end, [&block](const auto& e) { return &e.second == &block; });
+  if (iter != end)
+    block_map.erase(iter);
+}
+
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
@@ -432,6 +441,8 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
 
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
+  m_jit.RecordBlockProfile(block);
+
   if (m_entry_points_ptr)
   {
     if (m_entry_points_ptr[block.fast_block_map_index] == block.normalEntry)
@@ -150,6 +150,8 @@ public:
 
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
+  // Forgets a block which couldn't be compiled, before it was finalized
+  void DiscardBlock(const JitBlock& block);
 
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
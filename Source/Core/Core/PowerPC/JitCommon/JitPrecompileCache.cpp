@@ -0,0 +1,164 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitPrecompileCache.h"
+
+#include <limits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+
+namespace
+{
+struct CacheHeader
+{
+  static constexpr u32 MAGIC = 0x43504A44;  // "DJPC"
+  static constexpr u32 VERSION = 1;
+
+  u32 magic;
+  u32 version;
+  u16 revision;
+  u16 padding;
+  u32 block_count;
+  u64 config_key;
+};
+static_assert(sizeof(CacheHeader) == 24);
+
+struct BlockHeader
+{
+  static constexpr u16 FLAG_SPECULATIVE = 1;
+
+  u32 effective_address;
+  u32 physical_address;
+  u32 feature_flags;
+  u16 flags;
+  u16 range_count;
+  u64 code_hash;
+};
+static_assert(sizeof(BlockHeader) == 24);
+}  // namespace
+
+std::string JitPrecompileCache::GetFileName(const std::string& game_id)
+{
+  return fmt::format("{}JitBlocks-{}.bin", File::GetUserPath(D_CACHE_IDX), game_id);
+}
+
+JitPrecompileCache::CodeRanges
+JitPrecompileCache::GetCodeRanges(const std::set<u32>& physical_addresses)
+{
+  CodeRanges ranges;
+  for (const u32 address : physical_addresses)
+  {
+    if (!ranges.empty())
+    {
+      CodeRange& last = ranges.back();
+      if (last.physical_address + last.instruction_count * sizeof(u32) == address)
+      {
+        ++last.instruction_count;
+        continue;
+      }
+    }
+    ranges.push_back({address, 1});
+  }
+  return ranges;
+}
+
+void JitPrecompileCache::Clear()
+{
+  m_blocks.clear();
+  m_block_indices.clear();
+  m_changed = false;
+}
+
+bool JitPrecompileCache::Load(const std::string& path, u16 revision, u64 config_key)
+{
+  Clear();
+
+  File::IOFile file(path, "rb");
+  CacheHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != CacheHeader::MAGIC ||
+      header.version != CacheHeader::VERSION || header.revision != revision ||
+      header.config_key != config_key || header.block_count > MAX_BLOCKS)
+  {
+    return false;
+  }
+
+  for (u32 i = 0; i < header.block_count; ++i)
+  {
+    BlockHeader block_header;
+    if (!file.ReadArray(&block_header, 1))
+      break;
+
+    Block block;
+    block.effective_address = block_header.effective_address;
+    block.physical_address = block_header.physical_address;
+    block.feature_flags = block_header.feature_flags;
+    block.speculative = (block_header.flags & BlockHeader::FLAG_SPECULATIVE) != 0;
+    block.code_hash = block_header.code_hash;
+    block.code_ranges.resize(block_header.range_count);
+    if (!file.ReadArray(block.code_ranges.data(), block.code_ranges.size()))
+      break;
+
+    Record(std::move(block));
+  }
+
+  m_changed = false;
+  return !m_blocks.empty();
+}
+
+bool JitPrecompileCache::Save(const std::string& path, u16 revision, u64 config_key) const
+{
+  const CacheHeader header{CacheHeader::MAGIC, CacheHeader::VERSION, revision, 0,
+                           static_cast<u32>(m_blocks.size()), config_key};
+  File::IOFile file(path, "wb");
+  if (!file.WriteArray(&header, 1))
+    return false;
+
+  for (const Block& block : m_blocks)
+  {
+    const BlockHeader block_header{
+        block.effective_address,
+        block.physical_address,
+        block.feature_flags,
+        block.speculative ? BlockHeader::FLAG_SPECULATIVE : u16{0},
+        static_cast<u16>(block.code_ranges.size()),
+        block.code_hash,
+    };
+    if (!file.WriteArray(&block_header, 1) ||
+        !file.WriteArray(block.code_ranges.data(), block.code_ranges.size()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void JitPrecompileCache::Record(Block block)
+{
+  if (block.code_ranges.empty() ||
+      block.code_ranges.size() > std::numeric_limits<u16>::max())
+  {
+    return;
+  }
+
+  const auto [iter, inserted] = m_block_indices.try_emplace(
+      GetKey(block.effective_address, block.feature_flags), m_blocks.size());
+  if (inserted)
+  {
+    if (m_blocks.size() == MAX_BLOCKS)
+    {
+      m_block_indices.erase(iter);
+      return;
+    }
+    m_blocks.push_back(std::move(block));
+  }
+  else
+  {
+    m_blocks[iter->second] = std::move(block);
+  }
+  m_changed = true;
+}
@@ -0,0 +1,69 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// The blocks a game had compiled in earlier sessions, along with a hash of their guest code. The
+// JIT compiles them again while the CPU thread would otherwise wait for throttling, so that the
+// game doesn't have to wait for them the first time it runs them.
+//
+// No host code is kept. It points into the emulator itself and into the other blocks, which would
+// all have to be relocated, so only which blocks to compile is carried across sessions.
+class JitPrecompileCache
+{
+public:
+  static constexpr size_t MAX_BLOCKS = 0x10000;
+
+  // A run of consecutive instructions
+  struct CodeRange
+  {
+    u32 physical_address;
+    u32 instruction_count;
+  };
+  using CodeRanges = std::vector<CodeRange>;
+
+  struct Block
+  {
+    u32 effective_address = 0;
+    u32 physical_address = 0;
+    u32 feature_flags = 0;
+    // The block was compiled for register values seen at the time, so it is left to be compiled
+    // when it actually runs
+    bool speculative = false;
+    u64 code_hash = 0;
+    CodeRanges code_ranges;
+  };
+
+  static std::string GetFileName(const std::string& game_id);
+  static CodeRanges GetCodeRanges(const std::set<u32>& physical_addresses);
+
+  void Clear();
+  // Only keeps blocks recorded for the same game revision, host CPU and JIT configuration, which
+  // the caller sums up in `config_key`. Returns false if there are no usable blocks.
+  bool Load(const std::string& path, u16 revision, u64 config_key);
+  bool Save(const std::string& path, u16 revision, u64 config_key) const;
+
+  // Replaces the block previously recorded for the same address and features
+  void Record(Block block);
+
+  const std::vector<Block>& GetBlocks() const { return m_blocks; }
+  bool HasChanged() const { return m_changed; }
+
+private:
+  static u64 GetKey(u32 effective_address, u32 feature_flags)
+  {
+    return u64{feature_flags} << 32 | effective_address;
+  }
+
+  std::vector<Block> m_blocks;
+  std::unordered_map<u64, size_t> m_block_indices;
+  bool m_changed = false;
+};
@@ -23,6 +23,7 @@
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -178,6 +179,24 @@ void JitInterface::GetProfileResults(Profiler::ProfileStats* prof_stats) const
   });
 }
 
+void JitInterface::LoadBlockProfile(const std::string& game_id, u16 revision)
+{
+  if (m_jit)
+    m_jit->LoadBlockProfile(game_id, revision);
+}
+
+void JitInterface::LoadPrecompileCache(const std::string& game_id, u16 revision)
+{
+  if (m_jit)
+    m_jit->LoadPrecompileCache(game_id, revision);
+}
+
+void JitInterface::PrecompileCachedBlocks(TimePoint deadline)
+{
+  if (m_jit)
+    m_jit->PrecompileCachedBlocks(deadline);
+}
+
 std::variant<JitInterface::GetHostCodeError, JitInterface::GetHostCodeResult>
 JitInterface::GetHostCode(u32 address) const
 {
@@ -222,6 +241,11 @@ JitInterface::GetHostCode(u32 address) const
 
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
+  // A store to a page write protected for dirty page tracking. Retry it now that it's writable,
+  // without backpatching it to the slow path.
+  if (m_system.GetMemory().HandleDirtyPageFault(access_address))
+    return true;
+
   // Prevent nullptr dereference on a crash with no JIT present
   if (!m_jit)
   {
@@ -343,6 +367,8 @@ void JitInterface::Shutdown()
 {
   if (m_jit)
   {
+    m_jit->SaveBlockProfile();
+    m_jit->SavePrecompileCache();
     m_jit->Shutdown();
     m_jit.reset();
   }
@@ -67,6 +67,13 @@ public:
   void GetProfileResults(Profiler::ProfileStats* prof_stats) const;
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
 
+  // Switches the per-game block profile over to the given game
+  void LoadBlockProfile(const std::string& game_id, u16 revision);
+  // Switches the precompile cache over to the given game
+  void LoadPrecompileCache(const std::string& game_id, u16 revision);
+  // Spends the time until the deadline on compiling blocks the game ran in earlier sessions
+  void PrecompileCachedBlocks(TimePoint deadline);
+
   // Memory Utilities
   bool HandleFault(uintptr_t access_address, SContext* ctx);
   bool HandleStackFault();
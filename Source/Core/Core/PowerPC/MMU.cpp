@@ -415,7 +415,10 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
       m_ppc_state.dCache.Write(em_address, &swapped_data, size, HID0(m_ppc_state).DLOCK);
 
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
+    {
       std::memcpy(&m_memory.GetRAM()[em_address], &swapped_data, size);
+      m_memory.MarkDirty(&m_memory.GetRAM()[em_address], size);
+    }
 
     return;
   }
@@ -432,7 +435,10 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
 
     if (!m_ppc_state.m_enable_dcache || wi || flag != XCheckTLBFlag::Write)
+    {
       std::memcpy(&m_memory.GetEXRAM()[em_address], &swapped_data, size);
+      m_memory.MarkDirty(&m_memory.GetEXRAM()[em_address], size);
+    }
 
     return;
   }
@@ -442,8 +448,9 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   // [0x7E000000, 0x80000000).
   if (m_memory.GetFakeVMEM() && ((em_address & 0xFE000000) == 0x7E000000))
   {
-    std::memcpy(&m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()], &swapped_data,
-                size);
+    u8* const pointer = &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()];
+    std::memcpy(pointer, &swapped_data, size);
+    m_memory.MarkDirty(pointer, size);
     return;
   }
 
@@ -1050,6 +1057,7 @@ void MMU::DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u
     return;
 
   memcpy(dst, src, 32 * num_blocks);
+  m_memory.MarkDirty(dst, 32 * num_blocks);
 }
 
 void MMU::DMA_MemoryToLC(const u32 cache_address, const u32 mem_address, const u32 num_blocks)
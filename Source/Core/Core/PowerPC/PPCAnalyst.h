@@ -174,6 +174,11 @@ public:
     OPTION_CROR_MERGE = (1 << 6),
   };
 
+  // How many branches a block follows. 0 does not perform block merging.
+  static constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+  // For the hot blocks of the block profile, where the extra code pays off
+  static constexpr u32 HOT_BRANCH_FOLLOWING_THRESHOLD = 6;
+
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
@@ -182,7 +187,8 @@ public:
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
-  u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
+  u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size,
+              u32 branch_following_threshold = BRANCH_FOLLOWING_THRESHOLD) const;
 
 private:
   enum class ReorderType
@@ -0,0 +1,313 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/SnapshotRing.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Assert.h"
+#include "Common/ChunkFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/State.h"
+
+namespace State
+{
+SnapshotRing::SnapshotRing(size_t slots) : m_slots(std::max<size_t>(slots, 1))
+{
+}
+
+SnapshotRing::~SnapshotRing() = default;
+
+size_t SnapshotRing::GetMemoryUsage() const
+{
+  // Freed pages keep their memory for reuse
+  size_t bytes = m_pages.size() * PAGE_SIZE;
+  for (const Slot& s : m_slots)
+    bytes += s.state.capacity() + s.pages.capacity() * sizeof(u32);
+  return bytes;
+}
+
+void SnapshotRing::Save(size_t slot)
+{
+  ASSERT(Core::IsCPUThread());
+  Save(slot, &State::DoState);
+}
+
+bool SnapshotRing::Load(size_t slot)
+{
+  ASSERT(Core::IsCPUThread());
+  return Load(slot, &State::DoState);
+}
+
+void SnapshotRing::Save(size_t slot, const Serializer& serializer)
+{
+  Slot& s = m_slots[slot];
+  m_stats.pages_copied = 0;
+
+  std::vector<u32> pages;
+  size_t block_index = 0;
+  const PointerWrap::MemoryBlockHandler handler = [&](u8* data, u32 size,
+                                                      Common::DirtyPageBitmap* dirty_pages) {
+    SaveBlock(GetBlock(block_index++, data, size), dirty_pages, pages);
+  };
+
+  while (true)
+  {
+    // Write into the space left from the previous save of the slot first, and only measure the
+    // state when it does not fit. A write that runs out of space switches to measure mode.
+    u8* ptr = s.state.data();
+    PointerWrap p(&ptr, s.state.size(), PointerWrap::Mode::Write, handler);
+    serializer(p);
+    const size_t size = ptr - s.state.data();
+
+    if (!p.IsMeasureMode())
+    {
+      s.state_size = size;
+      break;
+    }
+
+    // The pages stored by this pass stay live, so the next one doesn't copy them again
+    for (u32 page : pages)
+    {
+      if (page != NO_PAGE)
+        Release(page);
+    }
+    pages.clear();
+    block_index = 0;
+    // Leave some room so a state that grows slightly does not need a second pass every time
+    s.state.resize(size + size / 16);
+  }
+
+  // The serializer passed fewer blocks than before
+  if (block_index < m_blocks.size())
+    ResetBlocks(block_index);
+
+  ReleaseSlot(s);
+  s.pages = std::move(pages);
+  s.valid = true;
+}
+
+bool SnapshotRing::Load(size_t slot, const Serializer& serializer)
+{
+  Slot& s = m_slots[slot];
+  if (!s.valid)
+    return false;
+
+  m_stats.pages_copied = 0;
+
+  size_t block_index = 0;
+  bool layout_matches = true;
+  const PointerWrap::MemoryBlockHandler handler = [&](u8* data, u32 size,
+                                                      Common::DirtyPageBitmap* dirty_pages) {
+    const size_t index = block_index++;
+    if (!layout_matches || index >= m_blocks.size() || m_blocks[index].data != data ||
+        m_blocks[index].size != size)
+    {
+      layout_matches = false;
+      return;
+    }
+    LoadBlock(m_blocks[index], dirty_pages, s.pages);
+  };
+
+  u8* ptr = s.state.data();
+  PointerWrap p(&ptr, s.state_size, PointerWrap::Mode::Read, handler);
+  serializer(p);
+
+  if (!p.IsReadMode())
+    return false;
+
+  // The serializer checks the machine before it loads anything, so this means it passed other
+  // blocks than when saving
+  if (!layout_matches || block_index != m_blocks.size())
+  {
+    ERROR_LOG_FMT(CORE, "Snapshot does not match the emulated memory layout");
+    return false;
+  }
+
+  return true;
+}
+
+void SnapshotRing::Clear()
+{
+  for (Slot& s : m_slots)
+  {
+    s.valid = false;
+    s.pages.clear();
+  }
+  m_pages.clear();
+  m_free_pages.clear();
+  m_blocks.clear();
+  m_live_pages.clear();
+  m_stats = {};
+}
+
+SnapshotRing::Block& SnapshotRing::GetBlock(size_t index, u8* data, u32 size)
+{
+  if (index < m_blocks.size())
+  {
+    Block& block = m_blocks[index];
+    if (block.data == data && block.size == size)
+      return block;
+
+    // The memory was reallocated or resized, e.g. by another game being booted
+    ResetBlocks(index);
+  }
+
+  const size_t first_page = m_live_pages.size();
+  m_blocks.push_back({data, size, first_page, 0});
+  m_live_pages.resize(first_page + (size + PAGE_SIZE - 1) / PAGE_SIZE, NO_PAGE);
+  return m_blocks.back();
+}
+
+// Forgets the blocks from index on. Every stored state refers to them, so all slots are dropped.
+void SnapshotRing::ResetBlocks(size_t index)
+{
+  for (Slot& s : m_slots)
+  {
+    ReleaseSlot(s);
+    s.pages.clear();
+    s.valid = false;
+  }
+
+  const size_t first_page = m_blocks[index].first_page;
+  for (size_t i = first_page; i < m_live_pages.size(); ++i)
+  {
+    if (m_live_pages[i] != NO_PAGE)
+      Release(m_live_pages[i]);
+  }
+  m_live_pages.resize(first_page);
+  m_blocks.resize(index);
+}
+
+// Drops the live pages that were written since the last save or load, or all of them if the
+// writes weren't tracked the whole time.
+void SnapshotRing::ForgetWrittenPages(Block& block, Common::DirtyPageBitmap* dirty_pages)
+{
+  if (dirty_pages && dirty_pages->IsTracking() &&
+      dirty_pages->GetGeneration() == block.generation && dirty_pages->GetSize() == block.size)
+  {
+    dirty_pages->TakeDirtyPages([&](u32 page) {
+      const size_t index = block.first_page + page;
+      if (m_live_pages[index] != NO_PAGE)
+        Release(m_live_pages[index]);
+      m_live_pages[index] = NO_PAGE;
+    });
+    return;
+  }
+
+  const size_t page_count = (block.size + PAGE_SIZE - 1) / PAGE_SIZE;
+  for (size_t index = block.first_page; index < block.first_page + page_count; ++index)
+  {
+    if (m_live_pages[index] != NO_PAGE)
+      Release(m_live_pages[index]);
+    m_live_pages[index] = NO_PAGE;
+  }
+
+  // Everything written from here on is tracked, until someone else restarts the tracking
+  block.generation = 0;
+  if (dirty_pages && dirty_pages->GetSize() == block.size)
+  {
+    dirty_pages->StartTracking();
+    block.generation = dirty_pages->GetGeneration();
+  }
+}
+
+void SnapshotRing::SaveBlock(Block& block, Common::DirtyPageBitmap* dirty_pages,
+                             std::vector<u32>& pages)
+{
+  // Taken before copying, so that writes from other threads during the copy are seen next time
+  ForgetWrittenPages(block, dirty_pages);
+
+  const size_t page_count = (block.size + PAGE_SIZE - 1) / PAGE_SIZE;
+  if (pages.size() < block.first_page + page_count)
+    pages.resize(block.first_page + page_count, NO_PAGE);
+
+  for (size_t i = 0; i < page_count; ++i)
+  {
+    const size_t index = block.first_page + i;
+    if (m_live_pages[index] == NO_PAGE)
+    {
+      const u32 offset = static_cast<u32>(i * PAGE_SIZE);
+      SetLive(index, StorePage(block.data + offset, std::min(PAGE_SIZE, block.size - offset)));
+      ++m_stats.pages_copied;
+    }
+
+    pages[index] = m_live_pages[index];
+    AddRef(pages[index]);
+  }
+
+  m_stats.pages_total = m_live_pages.size();
+}
+
+void SnapshotRing::LoadBlock(Block& block, Common::DirtyPageBitmap* dirty_pages,
+                             const std::vector<u32>& pages)
+{
+  ForgetWrittenPages(block, dirty_pages);
+
+  const size_t page_count = (block.size + PAGE_SIZE - 1) / PAGE_SIZE;
+  for (size_t i = 0; i < page_count; ++i)
+  {
+    const size_t index = block.first_page + i;
+    const u32 page = pages[index];
+    if (page == m_live_pages[index])
+      continue;
+
+    // The ring writes through the block's own pointer, which is never write protected
+    const u32 offset = static_cast<u32>(i * PAGE_SIZE);
+    std::memcpy(block.data + offset, m_pages[page].data.get(),
+                std::min(PAGE_SIZE, block.size - offset));
+    SetLive(index, page);
+    ++m_stats.pages_copied;
+  }
+
+  m_stats.pages_total = m_live_pages.size();
+}
+
+u32 SnapshotRing::StorePage(const u8* data, u32 size)
+{
+  u32 id;
+  if (!m_free_pages.empty())
+  {
+    id = m_free_pages.back();
+    m_free_pages.pop_back();
+  }
+  else
+  {
+    id = static_cast<u32>(m_pages.size());
+    m_pages.emplace_back().data = std::make_unique<u8[]>(PAGE_SIZE);
+  }
+
+  Page& page = m_pages[id];
+  std::memcpy(page.data.get(), data, size);
+  page.refs = 0;
+  return id;
+}
+
+void SnapshotRing::Release(u32 page)
+{
+  if (--m_pages[page].refs == 0)
+    m_free_pages.push_back(page);
+}
+
+void SnapshotRing::SetLive(size_t index, u32 page)
+{
+  AddRef(page);
+  const u32 old_page = m_live_pages[index];
+  m_live_pages[index] = page;
+  if (old_page != NO_PAGE)
+    Release(old_page);
+}
+
+void SnapshotRing::ReleaseSlot(Slot& slot)
+{
+  if (!slot.valid)
+    return;
+  for (u32 page : slot.pages)
+  {
+    if (page != NO_PAGE)
+      Release(page);
+  }
+}
+}  // namespace State
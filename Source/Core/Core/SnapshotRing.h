@@ -0,0 +1,120 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/DirtyPageBitmap.h"
+
+class PointerWrap;
+
+namespace State
+{
+// In-memory savestates cheap enough to take every frame, for rollback, rewind and the like.
+//
+// Almost all of a savestate is emulated memory (MEM1, ARAM), of which only a few pages change
+// from one frame to the next. The memories are split into pages, and each version of a page is
+// stored once and shared by all the states it belongs to. The owners of the memories track which
+// pages were written (see Common::DirtyPageBitmap), so a save only copies those, and a load only
+// the pages that were written or differ from the state being loaded. The rest of the state is
+// small and serialized into a buffer of the slot, which is reused between saves.
+//
+// A memory passed to DoMemoryBlock without dirty pages, or whose tracking was restarted by someone
+// else, is copied whole. That is the case on the Wii, where IOS writes RAM through pointers.
+class SnapshotRing
+{
+public:
+  static constexpr u32 PAGE_SIZE = Common::DirtyPageBitmap::PAGE_SIZE;
+
+  // Serializes the state. The emulated memories must go through DoMemoryBlock. When loading, it
+  // must check that the state fits the machine before it changes anything, and switch to measure
+  // or verify mode otherwise, like State::DoState does.
+  using Serializer = std::function<void(PointerWrap&)>;
+
+  struct Stats
+  {
+    // Pages copied by the last save or load
+    size_t pages_copied = 0;
+    size_t pages_total = 0;
+  };
+
+  explicit SnapshotRing(size_t slots);
+  ~SnapshotRing();
+
+  SnapshotRing(const SnapshotRing&) = delete;
+  SnapshotRing& operator=(const SnapshotRing&) = delete;
+
+  size_t GetSlotCount() const { return m_slots.size(); }
+  bool HasState(size_t slot) const { return m_slots[slot].valid; }
+  const Stats& GetStats() const { return m_stats; }
+  // Memory held by the stored pages and the state buffers
+  size_t GetMemoryUsage() const;
+
+  // Save and load the emulated machine with State::DoState. Must be called on the CPU thread while
+  // the machine is in a consistent state.
+  void Save(size_t slot);
+  bool Load(size_t slot);
+
+  // The same with another serializer, which must pass the same memory blocks in the same order
+  // every time.
+  void Save(size_t slot, const Serializer& serializer);
+  bool Load(size_t slot, const Serializer& serializer);
+
+  void Clear();
+
+private:
+  static constexpr u32 NO_PAGE = 0xFFFFFFFF;
+
+  struct Page
+  {
+    u32 refs = 0;
+    std::unique_ptr<u8[]> data;
+  };
+
+  struct Block
+  {
+    u8* data;
+    u32 size;
+    // Index of the block's first page in m_live_pages and in the slots' page lists
+    size_t first_page;
+    // The dirty page tracking the live pages are based on, 0 if there is none
+    u64 generation;
+  };
+
+  struct Slot
+  {
+    bool valid = false;
+    std::vector<u8> state;
+    size_t state_size = 0;
+    std::vector<u32> pages;
+  };
+
+  Block& GetBlock(size_t index, u8* data, u32 size);
+  void ResetBlocks(size_t index);
+  void ForgetWrittenPages(Block& block, Common::DirtyPageBitmap* dirty_pages);
+  void SaveBlock(Block& block, Common::DirtyPageBitmap* dirty_pages, std::vector<u32>& pages);
+  void LoadBlock(Block& block, Common::DirtyPageBitmap* dirty_pages,
+                 const std::vector<u32>& pages);
+
+  u32 StorePage(const u8* data, u32 size);
+  void AddRef(u32 page) { ++m_pages[page].refs; }
+  void Release(u32 page);
+  void SetLive(size_t index, u32 page);
+  void ReleaseSlot(Slot& slot);
+
+  std::vector<Slot> m_slots;
+  std::vector<Page> m_pages;
+  std::vector<u32> m_free_pages;
+  // The memory blocks, in the order the serializer passes them
+  std::vector<Block> m_blocks;
+  // The stored page each page of the emulated memory held after the last save or load, or NO_PAGE
+  // if it was written since
+  std::vector<u32> m_live_pages;
+  Stats m_stats;
+};
+}  // namespace State
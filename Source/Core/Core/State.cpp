@@ -137,7 +137,7 @@ void EnableCompression(bool compression)
   s_use_compression = compression;
 }
 
-static void DoState(PointerWrap& p)
+void DoState(PointerWrap& p)
 {
   auto& system = Core::System::GetInstance();
 
@@ -13,6 +13,8 @@
 
 #include "Common/CommonTypes.h"
 
+class PointerWrap;
+
 namespace State
 {
 // number of states
@@ -104,6 +106,10 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// Serializes the whole emulated machine, without the savestate header. Must be called on the CPU
+// thread while the machine is in a consistent state. See State::SnapshotRing.
+void DoState(PointerWrap& p);
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
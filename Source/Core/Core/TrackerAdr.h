@@ -4,10 +4,10 @@
 #include <optional>
 #include <ostream>
 
+#include "Common/CommonTypes.h"
+
 //For Mem Access
-// #include "Core/HW/Memmap.h"
-#include "Core/PowerPC/MMU.h"
-#include "Core/PowerPC/PowerPC.h"
+#include "Core/FrameSnapshot.h"
 
 template <typename T>
 class TrackerValue {
@@ -61,16 +61,16 @@ public:
 
     u32 adr;
 
-    T read_value(const Core::CPUThreadGuard& guard) {
+    T read_value(const Core::FrameSnapshot& frame) {
         T mem_val;
         if constexpr(std::is_same<T, u8>::value){
-            mem_val = PowerPC::MMU::HostRead_U8(guard, adr);
+            mem_val = frame.Read_U8(adr);
         }
         else if constexpr(std::is_same<T, u16>::value){
-            mem_val = PowerPC::MMU::HostRead_U16(guard, adr);
+            mem_val = frame.Read_U16(adr);
         }
         else if constexpr(std::is_same<T, u32>::value){
-            mem_val = PowerPC::MMU::HostRead_U32(guard, adr);
+            mem_val = frame.Read_U32(adr);
         }
         TrackerValue<T>::set_value(mem_val);
         return mem_val;
@@ -0,0 +1,354 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBench.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/ScopeGuard.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
+
+namespace FifoBench
+{
+using FrontendProfiler::FrameTimes;
+using FrontendProfiler::Section;
+
+static constexpr char FRAMES_HEADER[] =
+    "file,frame,total_ns,opcode_decoder_ns,run_vertices_ns,texture_decode_ns,shader_uid_ns\n";
+static constexpr size_t FRAME_COLUMNS = 5;
+
+#ifdef _WIN32
+using Process = HANDLE;
+
+static std::wstring QuoteArgument(const std::wstring& argument)
+{
+  // Backslashes only need escaping in front of quotes, see CommandLineToArgvW
+  std::wstring quoted = L"\"";
+  size_t backslashes = 0;
+  for (const wchar_t c : argument)
+  {
+    if (c == L'\\')
+    {
+      ++backslashes;
+      continue;
+    }
+
+    quoted.append(c == L'"' ? backslashes * 2 + 1 : backslashes, L'\\');
+    quoted += c;
+    backslashes = 0;
+  }
+  quoted.append(backslashes * 2, L'\\');
+  quoted += L'"';
+  return quoted;
+}
+
+static std::optional<Process> Spawn(const std::string& program,
+                                    const std::vector<std::string>& args)
+{
+  std::wstring command_line = QuoteArgument(UTF8ToWString(program));
+  for (const std::string& arg : args)
+    command_line += L' ' + QuoteArgument(UTF8ToWString(arg));
+
+  // The replays print their window title to stdout, which would drown out the summaries
+  SECURITY_ATTRIBUTES security_attributes{sizeof(security_attributes), nullptr, TRUE};
+  const HANDLE null_handle = CreateFileW(L"NUL", GENERIC_WRITE, FILE_SHARE_WRITE,
+                                         &security_attributes, OPEN_EXISTING, 0, nullptr);
+  Common::ScopeGuard null_guard([null_handle] { CloseHandle(null_handle); });
+
+  STARTUPINFOW startup_info{};
+  startup_info.cb = sizeof(startup_info);
+  startup_info.dwFlags = STARTF_USESTDHANDLES;
+  startup_info.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+  startup_info.hStdOutput = null_handle;
+  startup_info.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+  PROCESS_INFORMATION process_info{};
+  if (!CreateProcessW(nullptr, command_line.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr,
+                      &startup_info, &process_info))
+  {
+    return std::nullopt;
+  }
+  CloseHandle(process_info.hThread);
+  return process_info.hProcess;
+}
+
+// Returns the index of the process which exited and whether it succeeded
+static std::pair<size_t, bool> WaitForAny(const std::vector<Process>& processes)
+{
+  const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(processes.size()),
+                                              processes.data(), FALSE, INFINITE);
+  if (result < WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + processes.size())
+    return {processes.size(), false};
+
+  const size_t index = result - WAIT_OBJECT_0;
+  DWORD exit_code = 1;
+  GetExitCodeProcess(processes[index], &exit_code);
+  CloseHandle(processes[index]);
+  return {index, exit_code == 0};
+}
+#else
+using Process = pid_t;
+
+static std::optional<Process> Spawn(const std::string& program,
+                                    const std::vector<std::string>& args)
+{
+  std::vector<std::string> strings{program};
+  strings.insert(strings.end(), args.begin(), args.end());
+  std::vector<char*> argv;
+  for (std::string& string : strings)
+    argv.push_back(string.data());
+  argv.push_back(nullptr);
+
+  // The replays print their window title to stdout, which would drown out the summaries
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+  Common::ScopeGuard actions_guard([&actions] { posix_spawn_file_actions_destroy(&actions); });
+
+  pid_t pid;
+  if (posix_spawnp(&pid, program.c_str(), &actions, nullptr, argv.data(), environ) != 0)
+    return std::nullopt;
+  return pid;
+}
+
+// Returns the index of the process which exited and whether it succeeded
+static std::pair<size_t, bool> WaitForAny(const std::vector<Process>& processes)
+{
+  while (true)
+  {
+    int status;
+    const pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return {processes.size(), false};
+    }
+
+    const auto iter = std::find(processes.begin(), processes.end(), pid);
+    if (iter != processes.end())
+      return {iter - processes.begin(), WIFEXITED(status) && WEXITSTATUS(status) == 0};
+  }
+}
+#endif
+
+void Prepare(bool video_backend_set)
+{
+  // Running the GPU on the CPU thread makes the frames line up with the ones in the log
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, false);
+  if (!video_backend_set)
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+
+  FrontendProfiler::SetEnabled(true);
+}
+
+std::vector<FrameTimes> Finish()
+{
+  std::vector<FrameTimes> frames = FrontendProfiler::TakeFrames();
+  FrontendProfiler::SetEnabled(false);
+
+  // The first frame includes starting the core and loading the log
+  if (!frames.empty())
+    frames.erase(frames.begin());
+  return frames;
+}
+
+static std::string FormatFrames(const std::string& name, const std::vector<FrameTimes>& frames)
+{
+  const std::string quoted_name = ReplaceAll(name, "\"", "\"\"");
+
+  std::string result;
+  for (size_t i = 0; i < frames.size(); ++i)
+  {
+    const FrameTimes& frame = frames[i];
+    result += fmt::format("\"{}\",{},{},{},{},{},{}\n", quoted_name, i, frame.total_ns,
+                          frame.section_ns[Section::OpcodeDecoder],
+                          frame.section_ns[Section::RunVertices],
+                          frame.section_ns[Section::TextureDecode],
+                          frame.section_ns[Section::ShaderUid]);
+  }
+  return result;
+}
+
+bool WriteFrames(const std::string& path, const std::string& name,
+                 const std::vector<FrameTimes>& frames)
+{
+  return File::WriteStringToFile(path, FRAMES_HEADER + FormatFrames(name, frames));
+}
+
+std::optional<std::vector<FrameTimes>> ReadFrames(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return std::nullopt;
+
+  std::vector<FrameTimes> frames;
+  const std::vector<std::string> lines = SplitString(contents, '\n');
+  for (size_t i = 1; i < lines.size(); ++i)
+  {
+    if (lines[i].empty())
+      continue;
+
+    // The columns are read from the end, so commas in the file name don't matter
+    const std::vector<std::string> columns = SplitString(lines[i], ',');
+    if (columns.size() < FRAME_COLUMNS + 2)
+      return std::nullopt;
+
+    std::array<u64, FRAME_COLUMNS> values;
+    for (size_t j = 0; j < FRAME_COLUMNS; ++j)
+    {
+      if (!TryParse(columns[columns.size() - FRAME_COLUMNS + j], &values[j]))
+        return std::nullopt;
+    }
+
+    FrameTimes& frame = frames.emplace_back();
+    frame.total_ns = values[0];
+    frame.section_ns[Section::OpcodeDecoder] = values[1];
+    frame.section_ns[Section::RunVertices] = values[2];
+    frame.section_ns[Section::TextureDecode] = values[3];
+    frame.section_ns[Section::ShaderUid] = values[4];
+  }
+  return frames;
+}
+
+void PrintSummary(const std::string& name, const std::vector<FrameTimes>& frames)
+{
+  fmt::print("{}: {} frames\n", name, frames.size());
+  if (frames.empty())
+    return;
+
+  fmt::print("{:<16} {:>10} {:>10} {:>10} {:>10}\n", "us", "mean", "p50", "p99", "max");
+  const auto print_row = [&frames](const char* row_name, auto get_ns) {
+    std::vector<double> samples;
+    double sum = 0;
+    for (const FrameTimes& frame : frames)
+    {
+      samples.push_back(get_ns(frame) / 1000.0);
+      sum += samples.back();
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](size_t p) {
+      return samples[std::min(samples.size() - 1, samples.size() * p / 100)];
+    };
+
+    fmt::print("{:<16} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n", row_name, sum / samples.size(),
+               percentile(50), percentile(99), samples.back());
+  };
+
+  print_row("frame", [](const FrameTimes& frame) { return frame.total_ns; });
+  print_row("opcode decoder",
+            [](const FrameTimes& frame) { return frame.section_ns[Section::OpcodeDecoder]; });
+  print_row("run vertices",
+            [](const FrameTimes& frame) { return frame.section_ns[Section::RunVertices]; });
+  print_row("texture decode",
+            [](const FrameTimes& frame) { return frame.section_ns[Section::TextureDecode]; });
+  print_row("shader uid",
+            [](const FrameTimes& frame) { return frame.section_ns[Section::ShaderUid]; });
+  fmt::print("\n");
+}
+
+int RunJobs(const std::string& program, const std::vector<std::string>& child_args,
+            const std::vector<std::string>& files, int jobs, const std::string& output)
+{
+  const std::string temp_dir = File::CreateTempDir();
+  if (temp_dir.empty())
+  {
+    fprintf(stderr, "Could not create a temporary directory\n");
+    return 1;
+  }
+  Common::ScopeGuard temp_dir_guard([&temp_dir] { File::DeleteDirRecursively(temp_dir); });
+  const auto get_frames_path = [&temp_dir](size_t i) {
+    return fmt::format("{}/{}.csv", temp_dir, i);
+  };
+
+  size_t max_running = static_cast<size_t>(std::max(jobs, 1));
+#ifdef _WIN32
+  max_running = std::min<size_t>(max_running, MAXIMUM_WAIT_OBJECTS);
+#endif
+
+  std::vector<Process> running;
+  std::vector<size_t> running_files;
+  std::vector<bool> succeeded(files.size());
+  size_t next_file = 0;
+  while (next_file < files.size() || !running.empty())
+  {
+    if (next_file < files.size() && running.size() < max_running)
+    {
+      std::vector<std::string> args = child_args;
+      args.insert(args.end(),
+                  {"--fifo-bench-output", get_frames_path(next_file), files[next_file]});
+      if (const std::optional<Process> process = Spawn(program, args))
+      {
+        running.push_back(*process);
+        running_files.push_back(next_file);
+      }
+      else
+      {
+        fprintf(stderr, "Could not start the replay of %s\n", files[next_file].c_str());
+      }
+      ++next_file;
+      continue;
+    }
+
+    const auto [index, success] = WaitForAny(running);
+    if (index >= running.size())
+    {
+      fprintf(stderr, "Could not wait for the replays\n");
+      return 1;
+    }
+    succeeded[running_files[index]] = success;
+    running.erase(running.begin() + index);
+    running_files.erase(running_files.begin() + index);
+  }
+
+  bool all_succeeded = true;
+  std::string all_frames = FRAMES_HEADER;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    const std::optional<std::vector<FrameTimes>> frames =
+        succeeded[i] ? ReadFrames(get_frames_path(i)) : std::nullopt;
+    if (!frames)
+    {
+      fprintf(stderr, "The replay of %s failed\n", files[i].c_str());
+      all_succeeded = false;
+      continue;
+    }
+
+    PrintSummary(files[i], *frames);
+    all_frames += FormatFrames(files[i], *frames);
+  }
+
+  if (!output.empty() && !File::WriteStringToFile(output, all_frames))
+  {
+    fprintf(stderr, "Could not write %s\n", output.c_str());
+    return 1;
+  }
+  return all_succeeded ? 0 : 1;
+}
+}  // namespace FifoBench
@@ -0,0 +1,31 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "VideoCommon/FrontendProfiler.h"
+
+// Replays FIFO logs as fast as possible and reports how long the video frontend took per frame.
+// Every log is replayed in a process of its own, so several can run at once.
+namespace FifoBench
+{
+// Enables the profiler and the settings for replaying as fast as possible. Call before booting.
+void Prepare(bool video_backend_set);
+// Takes the frame times of the replay, without the frame that loaded the log
+std::vector<FrontendProfiler::FrameTimes> Finish();
+
+bool WriteFrames(const std::string& path, const std::string& name,
+                 const std::vector<FrontendProfiler::FrameTimes>& frames);
+std::optional<std::vector<FrontendProfiler::FrameTimes>> ReadFrames(const std::string& path);
+
+void PrintSummary(const std::string& name, const std::vector<FrontendProfiler::FrameTimes>& frames);
+
+// Replays every file in a child process running `program` with the given arguments, at most
+// `jobs` at a time, then prints the summaries and writes all frames to `output` if it is set.
+int RunJobs(const std::string& program, const std::vector<std::string>& child_args,
+            const std::vector<std::string>& files, int jobs, const std::string& output);
+}  // namespace FifoBench
@@ -0,0 +1,121 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/JitProfileBench.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "VideoCommon/PerformanceMetrics.h"
+
+namespace JitProfileBench
+{
+using Clock = std::chrono::steady_clock;
+
+// Frames run after every switch before measuring, so that the hot code has been compiled again
+static constexpr u64 WARMUP_FRAMES = 120;
+
+static std::thread s_thread;
+static std::atomic<bool> s_stop = false;
+// Microseconds per frame of every window, without and with the profile
+static std::array<std::vector<double>, 2> s_results;
+
+static bool WaitForFrames(u64 frames)
+{
+  const u64 target = g_perf_metrics.GetVBlankCount() + frames;
+  while (g_perf_metrics.GetVBlankCount() < target)
+  {
+    if (s_stop || !Core::IsRunning())
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+static void BenchThread(u32 frames, u32 rounds)
+{
+  Common::SetCurrentThreadName("JIT Profile Bench");
+
+  while (!Core::IsRunningAndStarted())
+  {
+    if (s_stop)
+      return;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  for (u32 round = 0; round < rounds; ++round)
+  {
+    for (const bool use_profile : {false, true})
+    {
+      // Changing the setting makes the JIT start over with an empty cache
+      Config::SetCurrent(Config::MAIN_JIT_USE_BLOCK_PROFILE, use_profile);
+      if (!WaitForFrames(WARMUP_FRAMES))
+        return;
+
+      const Clock::time_point start = Clock::now();
+      const u64 start_frame = g_perf_metrics.GetVBlankCount();
+      if (!WaitForFrames(frames))
+        return;
+      const std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+      const u64 frame_count = g_perf_metrics.GetVBlankCount() - start_frame;
+
+      s_results[use_profile].push_back(elapsed.count() / frame_count);
+      fmt::print("round {} {} profile: {:.1f} us/frame\n", round, use_profile ? "with" : "without",
+                 s_results[use_profile].back());
+    }
+  }
+
+  Core::QueueHostJob([] { Core::Stop(); });
+}
+
+void Prepare(bool video_backend_set)
+{
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_JIT_RECORD_BLOCK_PROFILE, false);
+  if (!video_backend_set)
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+}
+
+void Start(u32 frames, u32 rounds)
+{
+  s_stop = false;
+  s_results = {};
+  s_thread = std::thread(BenchThread, std::max(frames, 1u), rounds);
+}
+
+bool Finish()
+{
+  s_stop = true;
+  if (s_thread.joinable())
+    s_thread.join();
+
+  if (s_results[false].empty() || s_results[true].empty())
+  {
+    fmt::print(stderr, "The game stopped before a round finished\n");
+    return false;
+  }
+
+  const auto print_row = [](const char* name, const std::vector<double>& windows) {
+    double sum = 0;
+    for (const double us : windows)
+      sum += us;
+    fmt::print("{:<16} {:>10.1f} {:>10.1f}\n", name, sum / windows.size(),
+               *std::min_element(windows.begin(), windows.end()));
+  };
+
+  fmt::print("{:<16} {:>10} {:>10}\n", "us/frame", "mean", "min");
+  print_row("without profile", s_results[false]);
+  print_row("with profile", s_results[true]);
+  return true;
+}
+}  // namespace JitProfileBench
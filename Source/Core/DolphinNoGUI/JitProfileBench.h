@@ -0,0 +1,18 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Runs a game as fast as possible, alternating between compiling with and without the JIT block
+// profile recorded in earlier sessions, and reports the host time per emulated frame of both.
+namespace JitProfileBench
+{
+// Sets up running as fast as possible without recording a profile. Call before booting.
+void Prepare(bool video_backend_set);
+// Measures `rounds` windows of `frames` emulated frames each way, then stops the core
+void Start(u32 frames, u32 rounds);
+// Waits for the measurements and prints them. Returns false if none were taken.
+bool Finish();
+}  // namespace JitProfileBench
@@ -4,11 +4,14 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <signal.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifndef _WIN32
@@ -17,13 +20,22 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Flag.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/NetplaySettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
+#include "Core/NetPlayRelay.h"
+
+#include "DolphinNoGUI/FifoBench.h"
+#include "DolphinNoGUI/JitProfileBench.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -36,6 +48,7 @@
 #include "VideoCommon/VideoBackendBase.h"
 
 static std::unique_ptr<Platform> s_platform;
+static Common::Flag s_relay_shutdown;
 
 static void signal_handler(int)
 {
@@ -48,7 +61,100 @@ static void signal_handler(int)
   }
 #endif
 
-  s_platform->RequestShutdown();
+  if (s_platform)
+    s_platform->RequestShutdown();
+  else
+    s_relay_shutdown.Set();
+}
+
+static void InstallSignalHandlers()
+{
+#ifdef _WIN32
+  signal(SIGINT, signal_handler);
+  signal(SIGTERM, signal_handler);
+#else
+  // Shut down cleanly on SIGINT and SIGTERM
+  struct sigaction sa;
+  sa.sa_handler = signal_handler;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESETHAND;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+#endif
+}
+
+// Passes a NetPlay session on to spectators until the host closes it or a signal is received
+static int RunRelay(const optparse::Values& options)
+{
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+  Common::ScopeGuard ui_common_guard([] { UICommon::Shutdown(); });
+
+  std::string host_address = static_cast<const char*>(options.get("relay"));
+  u16 host_port = Config::Get(Config::NETPLAY_CONNECT_PORT);
+  if (const size_t colon = host_address.rfind(':'); colon != std::string::npos)
+  {
+    if (!TryParse(host_address.substr(colon + 1), &host_port))
+    {
+      fprintf(stderr, "Invalid relay host port\n");
+      return 1;
+    }
+    host_address.erase(colon);
+  }
+
+  u16 port = Config::Get(Config::NETPLAY_HOST_PORT);
+  if (options.is_set("relay_port"))
+    port = static_cast<u16>(static_cast<int>(options.get("relay_port")));
+  u32 max_spectators = 64;
+  if (options.is_set("relay_max_spectators"))
+    max_spectators = static_cast<u32>(static_cast<int>(options.get("relay_max_spectators")));
+  std::string token = Config::Get(Config::NETPLAY_RELAY_TOKEN);
+  if (options.is_set("relay_token"))
+    token = static_cast<const char*>(options.get("relay_token"));
+  std::chrono::seconds delay{0};
+  if (options.is_set("relay_delay"))
+    delay = std::chrono::seconds(static_cast<int>(options.get("relay_delay")));
+
+  InstallSignalHandlers();
+
+  NetPlay::NetPlayRelay relay(host_address, host_port, token, port, max_spectators, delay);
+  if (!relay.IsConnected())
+  {
+    fprintf(stderr, "Could not connect to the NetPlay host\n");
+    return 1;
+  }
+
+  fprintf(stderr, "Relaying %s:%u to spectators on port %u\n", host_address.c_str(), host_port,
+          port);
+  while (relay.IsConnected() && !s_relay_shutdown.IsSet())
+    Common::SleepCurrentThread(100);
+
+  return 0;
+}
+
+// Replays each FIFO log in a child process, several at a time
+static int RunFifoBenchJobs(const optparse::Values& options, const std::vector<std::string>& files)
+{
+  std::vector<std::string> child_args{"--fifo-bench", "--platform", "headless"};
+  if (options.is_set("user"))
+    child_args.insert(child_args.end(), {"--user", static_cast<const char*>(options.get("user"))});
+  const std::string video_backend = static_cast<const char*>(options.get("video_backend"));
+  if (!video_backend.empty())
+    child_args.insert(child_args.end(), {"--video_backend", video_backend});
+  for (const std::string& config : options.all("config"))
+    child_args.insert(child_args.end(), {"--config", config});
+
+  int jobs = static_cast<int>(std::thread::hardware_concurrency());
+  if (options.is_set("fifo_bench_jobs"))
+    jobs = static_cast<int>(options.get("fifo_bench_jobs"));
+  std::string output;
+  if (options.is_set("fifo_bench_output"))
+    output = static_cast<const char*>(options.get("fifo_bench_output"));
+
+  return FifoBench::RunJobs(File::GetExePath(), child_args, files, jobs, output);
 }
 
 std::vector<std::string> Host_GetPreferredLocales()
@@ -153,6 +259,9 @@ std::unique_ptr<GBAHostInterface> Host_CreateGBAHost(std::weak_ptr<HW::GBA::Core
 static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
   std::string platform_name = static_cast<const char*>(options.get("platform"));
+  if (platform_name.empty() &&
+      (options.is_set("fifo_bench") || options.is_set("jit_profile_bench")))
+    platform_name = "headless";
 
 #if HAVE_X11
   if (platform_name == "x11" || platform_name.empty())
@@ -211,9 +320,72 @@ int main(int argc, char* argv[])
 #endif
       });
 
+  parser->add_option("--relay")
+      .action("store")
+      .metavar("HOST[:PORT]")
+      .help("Pass the NetPlay session of a host on to spectators instead of running a game. "
+            "Must join while no game is running");
+  parser->add_option("--relay-token")
+      .action("store")
+      .help("The relay token set by the host (NetPlay/RelayToken). Defaults to the one in the "
+            "relay's own configuration");
+  parser->add_option("--relay-port")
+      .type("int")
+      .action("store")
+      .help("Port spectators connect to the relay on");
+  parser->add_option("--relay-delay")
+      .type("int")
+      .action("store")
+      .help("Seconds the relay holds the game back for");
+  parser->add_option("--relay-max-spectators")
+      .type("int")
+      .action("store")
+      .help("Number of spectators the relay takes (default 64)");
+  parser->add_option("--fifo-bench")
+      .action("store_true")
+      .help("Replay the given FIFO logs as fast as possible and report the time the video "
+            "frontend takes per frame. Uses the Null video backend unless another is specified");
+  parser->add_option("--fifo-bench-jobs")
+      .type("int")
+      .action("store")
+      .help("Number of FIFO logs replayed at once (default is the number of CPU threads)");
+  parser->add_option("--fifo-bench-output")
+      .action("store")
+      .metavar("FILE")
+      .help("Write the time of every frame of the FIFO logs to a CSV file");
+  parser->add_option("--jit-profile-bench")
+      .action("store_true")
+      .help("Run the game as fast as possible and compare the time per emulated frame with and "
+            "without the JIT block profile recorded in earlier sessions");
+  parser->add_option("--jit-profile-bench-frames")
+      .type("int")
+      .action("store")
+      .help("Number of emulated frames measured per round (default 600)");
+  parser->add_option("--jit-profile-bench-rounds")
+      .type("int")
+      .action("store")
+      .help("Number of times the frames are measured each way (default 3)");
+
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
+  if (options.is_set("relay"))
+    return RunRelay(options);
+
+  const bool fifo_bench = options.is_set("fifo_bench");
+  std::string fifo_bench_file;
+  if (fifo_bench)
+  {
+    if (args.empty())
+    {
+      fprintf(stderr, "No FIFO logs specified\n");
+      return 1;
+    }
+    if (args.size() > 1)
+      return RunFifoBenchJobs(options, args);
+    fifo_bench_file = args.front();
+  }
+
   std::optional<std::string> save_state_path;
   if (options.is_set("save_state"))
   {
@@ -278,6 +450,19 @@ int main(int argc, char* argv[])
     UICommon::Shutdown();
   });
 
+  if (fifo_bench)
+  {
+    const std::string video_backend = static_cast<const char*>(options.get("video_backend"));
+    FifoBench::Prepare(!video_backend.empty());
+  }
+
+  const bool jit_profile_bench = options.is_set("jit_profile_bench");
+  if (jit_profile_bench)
+  {
+    const std::string video_backend = static_cast<const char*>(options.get("video_backend"));
+    JitProfileBench::Prepare(!video_backend.empty());
+  }
+
   if (save_state_path && !game_specified)
   {
     fprintf(stderr, "A save state cannot be loaded without specifying a game to launch.\n");
@@ -289,18 +474,7 @@ int main(int argc, char* argv[])
       s_platform->Stop();
   });
 
-#ifdef _WIN32
-  signal(SIGINT, signal_handler);
-  signal(SIGTERM, signal_handler);
-#else
-  // Shut down cleanly on SIGINT and SIGTERM
-  struct sigaction sa;
-  sa.sa_handler = signal_handler;
-  sigemptyset(&sa.sa_mask);
-  sa.sa_flags = SA_RESETHAND;
-  sigaction(SIGINT, &sa, nullptr);
-  sigaction(SIGTERM, &sa, nullptr);
-#endif
+  InstallSignalHandlers();
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
@@ -314,12 +488,43 @@ int main(int argc, char* argv[])
   Discord::UpdateDiscordPresence();
 #endif
 
+  if (jit_profile_bench)
+  {
+    int frames = 600;
+    int rounds = 3;
+    if (options.is_set("jit_profile_bench_frames"))
+      frames = static_cast<int>(options.get("jit_profile_bench_frames"));
+    if (options.is_set("jit_profile_bench_rounds"))
+      rounds = static_cast<int>(options.get("jit_profile_bench_rounds"));
+    JitProfileBench::Start(static_cast<u32>(std::max(frames, 1)),
+                           static_cast<u32>(std::max(rounds, 1)));
+  }
+
   s_platform->MainLoop();
   Core::Stop();
 
   Core::Shutdown();
   s_platform.reset();
 
+  if (jit_profile_bench)
+    return JitProfileBench::Finish() ? 0 : 1;
+
+  if (fifo_bench)
+  {
+    const std::vector<FrontendProfiler::FrameTimes> frames = FifoBench::Finish();
+    FifoBench::PrintSummary(fifo_bench_file, frames);
+    if (options.is_set("fifo_bench_output"))
+    {
+      const std::string output = static_cast<const char*>(options.get("fifo_bench_output"));
+      if (!FifoBench::WriteFrames(output, fifo_bench_file, frames))
+      {
+        fprintf(stderr, "Could not write %s\n", output.c_str());
+        return 1;
+      }
+    }
+    return frames.empty() ? 1 : 0;
+  }
+
   return 0;
 }
 
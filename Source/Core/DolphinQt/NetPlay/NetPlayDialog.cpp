@@ -203,11 +203,18 @@ void NetPlayDialog::CreateMainLayout()
       tr("Each player sends their own inputs to the game, with equal buffer size for all players, "
          "configured by the host.\nRecommended only for casual games or when playing minigames."));
   m_fixed_delay_action->setCheckable(true);
+  m_rollback_action = m_network_menu->addAction(tr("Rollback"));
+  m_rollback_action->setToolTip(
+      tr("Each player runs ahead of the other players' inputs by predicting them, and rolls back "
+         "and replays the last frames when a prediction was wrong.\nThe buffer size is the "
+         "local input delay. Uses more CPU than the other modes."));
+  m_rollback_action->setCheckable(true);
 
   m_network_mode_group = new QActionGroup(this);
   m_network_mode_group->setExclusive(true);
   m_network_mode_group->addAction(m_fixed_delay_action);
   m_network_mode_group->addAction(m_golf_mode_action);
+  m_network_mode_group->addAction(m_rollback_action);
   m_fixed_delay_action->setChecked(true);
 
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
@@ -444,6 +451,7 @@ void NetPlayDialog::ConnectWidgets()
 
   connect(m_golf_mode_action, &QAction::toggled, this, [hia_function] { hia_function(true); });
   connect(m_fixed_delay_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
+  connect(m_rollback_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
 
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
@@ -492,6 +500,7 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_rollback_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   //connect(m_night_stadium_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   //connect(m_disable_music_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
@@ -1123,6 +1132,7 @@ void NetPlayDialog::SetOptionsEnabled(bool enabled)
     //m_host_input_authority_action->setEnabled(enabled);
     m_golf_mode_action->setEnabled(enabled);
     m_fixed_delay_action->setEnabled(enabled);
+    m_rollback_action->setEnabled(enabled);
     m_night_stadium->setCheckable(enabled);
     m_disable_replays->setCheckable(enabled);
     //m_night_stadium_action->setEnabled(enabled);
@@ -1469,6 +1479,10 @@ void NetPlayDialog::LoadSettings()
   {
     m_golf_mode_action->setChecked(true);
   }
+  else if (network_mode == "rollback")
+  {
+    m_rollback_action->setChecked(true);
+  }
   else
   {
     WARN_LOG_FMT(NETPLAY, "Unknown network mode '{}', using 'fixeddelay'", network_mode);
@@ -1511,6 +1525,10 @@ void NetPlayDialog::SaveSettings()
   {
     network_mode = "golf";
   }
+  else if (m_rollback_action->isChecked())
+  {
+    network_mode = "rollback";
+  }
 
   Config::SetBase(Config::NETPLAY_NETWORK_MODE, network_mode);
 }
@@ -93,6 +93,13 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_buffer_depth_spin = new QSpinBox();
+  m_buffer_depth_spin->setRange(5, 60);
+  m_buffer_depth_spin->setSuffix(tr(" ms"));
+  m_buffer_depth_spin->setToolTip(
+      tr("Sets how much emulated audio is buffered before it is played. Lower values reduce "
+         "audio latency. The buffer grows on its own for a while after audio runs dry."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -124,6 +131,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(tr("Buffer Depth:"), m_buffer_depth_spin);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -180,6 +188,7 @@ void AudioPane::ConnectWidgets()
   {
     connect(m_latency_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   }
+  connect(m_buffer_depth_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
@@ -241,6 +250,7 @@ void AudioPane::LoadSettings()
   // Latency
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
+  m_buffer_depth_spin->setValue(Config::Get(Config::MAIN_AUDIO_BUFFER_DEPTH));
 
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
@@ -309,6 +319,7 @@ void AudioPane::SaveSettings()
   // Latency
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_BUFFER_DEPTH, m_buffer_depth_spin->value());
 
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
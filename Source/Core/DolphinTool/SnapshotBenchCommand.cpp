@@ -0,0 +1,259 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/SnapshotBenchCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/DirtyPageBitmap.h"
+#include "Core/SnapshotRing.h"
+
+namespace DolphinTool
+{
+namespace
+{
+constexpr u32 PAGE_SIZE = State::SnapshotRing::PAGE_SIZE;
+
+// Stands in for the emulated machine: MEM1 and ARAM, with the rest of the state in between. The
+// writes are marked dirty the way DMA and the DSP mark theirs.
+struct FakeMachine
+{
+  std::vector<u8> mem1 = std::vector<u8>(24 * 1024 * 1024);
+  std::vector<u8> other = std::vector<u8>(256 * 1024);
+  std::vector<u8> aram = std::vector<u8>(16 * 1024 * 1024);
+  Common::DirtyPageBitmap mem1_dirty_pages;
+  Common::DirtyPageBitmap aram_dirty_pages;
+
+  FakeMachine()
+  {
+    mem1_dirty_pages.Init(static_cast<u32>(mem1.size()));
+    aram_dirty_pages.Init(static_cast<u32>(aram.size()));
+  }
+
+  void DoState(PointerWrap& p)
+  {
+    p.DoMemoryBlock(mem1.data(), static_cast<u32>(mem1.size()), &mem1_dirty_pages);
+    p.DoArray(other.data(), static_cast<u32>(other.size()));
+    p.DoMemoryBlock(aram.data(), static_cast<u32>(aram.size()), &aram_dirty_pages);
+  }
+};
+
+struct Write
+{
+  bool aram;
+  u32 offset;
+  u8 value;
+};
+
+using Clock = std::chrono::steady_clock;
+
+class Samples
+{
+public:
+  void Add(Clock::duration time)
+  {
+    m_samples.push_back(std::chrono::duration<double, std::micro>(time).count());
+  }
+
+  void Print(const char* name)
+  {
+    if (m_samples.empty())
+      return;
+
+    std::sort(m_samples.begin(), m_samples.end());
+    double sum = 0;
+    for (double sample : m_samples)
+      sum += sample;
+    const auto percentile = [this](size_t p) {
+      return m_samples[std::min(m_samples.size() - 1, m_samples.size() * p / 100)];
+    };
+
+    fmt::print(std::cout, "{:<16} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n", name,
+               sum / m_samples.size(), percentile(50), percentile(99), m_samples.back());
+  }
+
+private:
+  std::vector<double> m_samples;
+};
+
+// The writes of a frame, to random bytes of the given fraction of the pages
+std::vector<Write> MakeWrites(const FakeMachine& machine, double dirty_fraction,
+                              std::mt19937& rng)
+{
+  std::vector<Write> writes;
+  for (const bool aram : {false, true})
+  {
+    const size_t pages = (aram ? machine.aram : machine.mem1).size() / PAGE_SIZE;
+    const size_t dirty = static_cast<size_t>(pages * dirty_fraction);
+    std::uniform_int_distribution<u32> page(0, static_cast<u32>(pages - 1));
+    for (size_t i = 0; i < dirty; ++i)
+      writes.push_back({aram, page(rng) * PAGE_SIZE + (rng() & (PAGE_SIZE - 1)), u8(rng() | 1)});
+  }
+  return writes;
+}
+
+void ApplyWrites(FakeMachine& machine, const std::vector<Write>& writes, u32 frame)
+{
+  for (const Write& write : writes)
+  {
+    if (write.aram)
+    {
+      machine.aram[write.offset] ^= write.value;
+      machine.aram_dirty_pages.MarkDirty(write.offset, 1);
+    }
+    else
+    {
+      machine.mem1[write.offset] ^= write.value;
+      machine.mem1_dirty_pages.MarkDirty(write.offset, 1);
+    }
+  }
+  machine.other[frame % machine.other.size()] ^= 1;
+}
+}  // namespace
+
+int SnapshotBenchCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: snapshotbench [options]...\n\n"
+               "Compares full savestates to the incremental ones of NetPlay rollback, on a "
+               "synthetic machine with MEM1 and ARAM.");
+
+  parser.add_option("-f", "--frames")
+      .type("int")
+      .action("store")
+      .help("Number of frames to save. Default is 600.")
+      .set_default(600);
+
+  parser.add_option("-d", "--dirty")
+      .type("float")
+      .action("store")
+      .help("Percentage of the memory pages written every frame. Default is 1.")
+      .set_default(1.0);
+
+  parser.add_option("-r", "--rollback")
+      .type("int")
+      .action("store")
+      .help("Roll back this many frames every time the ring is full. Default is 7.")
+      .set_default(7);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const int frames = static_cast<int>(options.get("frames"));
+  const double dirty_fraction = static_cast<double>(options.get("dirty")) / 100;
+  const int rollback = static_cast<int>(options.get("rollback"));
+  if (frames <= 0 || rollback <= 0 || dirty_fraction < 0 || dirty_fraction > 1)
+  {
+    fmt::print(std::cerr, "Error: Invalid options\n");
+    return EXIT_FAILURE;
+  }
+
+  // A full load marks all of the memory dirty, so each way of saving gets its own machine
+  FakeMachine full_machine;
+  FakeMachine ring_machine;
+  std::mt19937 rng(0);
+  for (u8& byte : full_machine.mem1)
+    byte = static_cast<u8>(rng());
+  for (u8& byte : full_machine.aram)
+    byte = static_cast<u8>(rng());
+  ring_machine.mem1 = full_machine.mem1;
+  ring_machine.aram = full_machine.aram;
+
+  const auto serializer = [&ring_machine](PointerWrap& p) { ring_machine.DoState(p); };
+
+  // Full states, saved and loaded the way State::SaveToBuffer does it minus the compression
+  std::vector<std::vector<u8>> full_states(rollback + 2);
+  Samples full_save, full_load;
+  State::SnapshotRing ring(rollback + 2);
+  Samples ring_save, ring_load;
+  size_t pages_saved = 0;
+  size_t pages_loaded = 0;
+  size_t loads = 0;
+
+  for (int frame = 0; frame < frames; ++frame)
+  {
+    const std::vector<Write> writes = MakeWrites(full_machine, dirty_fraction, rng);
+    ApplyWrites(full_machine, writes, frame);
+    ApplyWrites(ring_machine, writes, frame);
+    const size_t slot = frame % ring.GetSlotCount();
+
+    Clock::time_point start = Clock::now();
+    {
+      std::vector<u8>& buffer = full_states[slot];
+      u8* ptr = nullptr;
+      PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+      full_machine.DoState(p_measure);
+      buffer.resize(reinterpret_cast<size_t>(ptr));
+      ptr = buffer.data();
+      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+      full_machine.DoState(p);
+    }
+    full_save.Add(Clock::now() - start);
+
+    start = Clock::now();
+    ring.Save(slot, serializer);
+    ring_save.Add(Clock::now() - start);
+    pages_saved += ring.GetStats().pages_copied;
+
+    if (frame >= rollback && (frame + 1) % ring.GetSlotCount() == 0)
+    {
+      const size_t load_slot = (frame - rollback) % ring.GetSlotCount();
+
+      start = Clock::now();
+      {
+        u8* ptr = full_states[load_slot].data();
+        PointerWrap p(&ptr, full_states[load_slot].size(), PointerWrap::Mode::Read);
+        full_machine.DoState(p);
+      }
+      full_load.Add(Clock::now() - start);
+
+      start = Clock::now();
+      if (!ring.Load(load_slot, serializer))
+      {
+        fmt::print(std::cerr, "Error: Unable to load snapshot\n");
+        return EXIT_FAILURE;
+      }
+      ring_load.Add(Clock::now() - start);
+      pages_loaded += ring.GetStats().pages_copied;
+      ++loads;
+
+      if (full_machine.mem1 != ring_machine.mem1 || full_machine.aram != ring_machine.aram ||
+          full_machine.other != ring_machine.other)
+      {
+        fmt::print(std::cerr, "Error: Snapshot does not match the full state\n");
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  size_t full_bytes = 0;
+  for (const std::vector<u8>& state : full_states)
+    full_bytes += state.capacity();
+
+  fmt::print(std::cout, "{} frames, {:.2f}% of {} pages written per frame, {} states\n\n", frames,
+             dirty_fraction * 100, ring.GetStats().pages_total, ring.GetSlotCount());
+  fmt::print(std::cout, "{:<16} {:>10} {:>10} {:>10} {:>10}\n", "us", "mean", "p50", "p99",
+             "max");
+  full_save.Print("full save");
+  ring_save.Print("snapshot save");
+  full_load.Print("full load");
+  ring_load.Print("snapshot load");
+  fmt::print(std::cout, "\npages copied per save: {:.1f}, per load: {:.1f}\n",
+             static_cast<double>(pages_saved) / frames,
+             loads ? static_cast<double>(pages_loaded) / loads : 0.0);
+  fmt::print(std::cout, "memory: full {} KiB, snapshots {} KiB\n", full_bytes / 1024,
+             ring.GetMemoryUsage() / 1024);
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
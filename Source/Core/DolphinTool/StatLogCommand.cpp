@@ -0,0 +1,124 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/StatLogCommand.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/MSB_StatLog.h"
+#include "Core/MSB_StatTracker.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+static bool ExportStatLog(const std::string& input_path, const std::string& output_path,
+                          const std::string& variant)
+{
+  auto tracker = std::make_unique<StatTracker>();
+  if (!StatLog::Read(input_path, *tracker))
+  {
+    fmt::print(std::cerr, "Error: Unable to read stat log {}\n", input_path);
+    return false;
+  }
+
+  StatTracker::StatJSONs jsons = tracker->getStatJSONs();
+  const std::string& json = variant == "decoded" ? jsons.decoded :
+                            variant == "full"    ? jsons.full :
+                                                   jsons.hidden_riokey;
+
+  if (!File::CreateFullPath(output_path) || !File::WriteStringToFile(output_path, json))
+  {
+    fmt::print(std::cerr, "Error: Unable to write {}\n", output_path);
+    return false;
+  }
+  return true;
+}
+
+int StatLogCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: statlog [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path. Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a stat log FILE, or a folder of stat logs to export all of them.")
+      .metavar("PATH");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination JSON FILE, or a folder when the input is a folder.")
+      .metavar("PATH");
+
+  parser.add_option("-v", "--variant")
+      .type("string")
+      .action("store")
+      .help("Which stat file to produce. 'local' matches the file written next to the log, "
+            "'full' is the file submitted to the server. Default is local. [%choices]")
+      .choices({"local", "decoded", "full"})
+      .set_default("local");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+  const std::string& input_path = options["input"];
+  if (input_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_path = options["output"];
+  if (output_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& variant = options["variant"];
+
+  if (!File::IsDirectory(input_path))
+    return ExportStatLog(input_path, output_path, variant) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  // Export every log in the folder, keeping the file names
+  const std::string output_dir = output_path + DIR_SEP;
+  int failures = 0;
+  for (const std::string& log_path :
+       Common::DoFileSearch({input_path}, {StatLog::FILE_EXTENSION}, true))
+  {
+    std::string name;
+    SplitPath(log_path, nullptr, &name, nullptr);
+    if (!ExportStatLog(log_path, output_dir + name + ".json", variant))
+      ++failures;
+  }
+
+  if (failures != 0)
+  {
+    fmt::print(std::cerr, "Error: {} stat logs could not be exported\n", failures);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,190 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+
+namespace DolphinTool
+{
+constexpr std::string_view TEXTURE_PREFIX = "tex1_";
+
+using Level = VideoCommon::CustomTextureData::ArraySlice::Level;
+
+// Box filters the last level down to 1x1
+static void GenerateMips(VideoCommon::CustomTextureData::ArraySlice* slice)
+{
+  while (slice->m_levels.back().width != 1 || slice->m_levels.back().height != 1)
+  {
+    const Level& src = slice->m_levels.back();
+    Level dst;
+    dst.format = src.format;
+    dst.width = std::max(src.width / 2, 1u);
+    dst.height = std::max(src.height / 2, 1u);
+    dst.row_length = dst.width;
+    dst.data.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+    for (u32 y = 0; y < dst.height; ++y)
+    {
+      const u32 y0 = std::min(y * 2, src.height - 1);
+      const u32 y1 = std::min(y * 2 + 1, src.height - 1);
+      for (u32 x = 0; x < dst.width; ++x)
+      {
+        const u32 x0 = std::min(x * 2, src.width - 1);
+        const u32 x1 = std::min(x * 2 + 1, src.width - 1);
+        for (u32 c = 0; c < 4; ++c)
+        {
+          const auto texel = [&](u32 sx, u32 sy) -> u32 {
+            return src.data[(static_cast<size_t>(sy) * src.row_length + sx) * 4 + c];
+          };
+          const u32 sum = texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1);
+          dst.data[(static_cast<size_t>(y) * dst.width + x) * 4 + c] =
+              static_cast<u8>((sum + 2) / 4);
+        }
+      }
+    }
+
+    slice->m_levels.push_back(std::move(dst));
+  }
+}
+
+int TexturePackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: texturepack [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path. Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a folder of custom textures, like Load/Textures/<game id>.")
+      .metavar("PATH");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE. Default is the input folder with the .dtp extension, "
+            "which is where Dolphin looks for it.")
+      .metavar("FILE");
+
+  parser.add_option("-m", "--generate-mips")
+      .action("store_true")
+      .help("Generate the mipmaps of RGBA textures which don't come with any.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+  std::string input_path = options["input"];
+  while (input_path.size() > 1 && (input_path.back() == '/' || input_path.back() == '\\'))
+    input_path.pop_back();
+  if (input_path.empty() || !File::IsDirectory(input_path))
+  {
+    fmt::print(std::cerr, "Error: No input folder set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::string output_path = options["output"];
+  if (output_path.empty())
+    output_path = input_path + std::string(VideoCommon::TexturePackArchive::EXTENSION);
+
+  const bool generate_mips = options.get("generate_mips");
+
+  VideoCommon::TexturePackArchiveWriter writer(output_path);
+  if (!writer.IsOpen())
+  {
+    fmt::print(std::cerr, "Error: Unable to create {}\n", output_path);
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::DirectFilesystemAssetLibrary library;
+  int texture_count = 0;
+  int failures = 0;
+  for (const std::string& path : Common::DoFileSearch({input_path}, {".png", ".dds"}, true))
+  {
+    std::string name;
+    SplitPath(path, nullptr, &name, nullptr);
+    if (!name.starts_with(TEXTURE_PREFIX))
+      continue;
+
+    // Mipmaps stored in files of their own are loaded along with the first level
+    const size_t mip_index = name.rfind("_mip");
+    if (mip_index != std::string::npos && mip_index + 4 < name.size() &&
+        std::all_of(name.begin() + mip_index + 4, name.end(),
+                    [](char c) { return c >= '0' && c <= '9'; }))
+    {
+      continue;
+    }
+
+    const size_t arb_index = name.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      name.erase(arb_index, 4);
+
+    library.SetAssetIDMapData(name, {{"texture", StringToPath(path)}});
+    VideoCommon::TextureData data;
+    if (library.LoadGameTexture(name, &data).m_bytes_loaded == 0 ||
+        data.m_texture.m_slices.size() != 1)
+    {
+      fmt::print(std::cerr, "Error: Unable to load {}\n", path);
+      ++failures;
+      continue;
+    }
+
+    VideoCommon::CustomTextureData::ArraySlice& slice = data.m_texture.m_slices[0];
+    if (generate_mips && !has_arbitrary_mipmaps && slice.m_levels.size() == 1 &&
+        slice.m_levels[0].format == AbstractTextureFormat::RGBA8)
+    {
+      GenerateMips(&slice);
+    }
+
+    if (!writer.AddTexture(name, has_arbitrary_mipmaps, slice))
+    {
+      fmt::print(std::cerr, "Error: Unable to write {}\n", path);
+      ++failures;
+      continue;
+    }
+    ++texture_count;
+  }
+
+  if (!writer.Finish())
+  {
+    fmt::print(std::cerr, "Error: Unable to finish {}\n", output_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Wrote {} textures to {}\n", texture_count, output_path);
+  if (failures != 0)
+  {
+    fmt::print(std::cerr, "Error: {} textures could not be added\n", failures);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -18,13 +18,18 @@
 
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/SnapshotBenchCommand.h"
+#include "DolphinTool/StatLogCommand.h"
+#include "DolphinTool/TexturePackCommand.h"
+#include "DolphinTool/UIDCacheCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header]\n");
+                        "commands supported: [convert, verify, header, statlog, snapshotbench, "
+                        "texturepack, uidcache]\n");
 }
 
 #ifdef _WIN32
@@ -51,6 +56,14 @@ int main(int argc, char* argv[])
     return DolphinTool::VerifyCommand(args);
   else if (command_str == "header")
     return DolphinTool::HeaderCommand(args);
+  else if (command_str == "statlog")
+    return DolphinTool::StatLogCommand(args);
+  else if (command_str == "snapshotbench")
+    return DolphinTool::SnapshotBenchCommand(args);
+  else if (command_str == "texturepack")
+    return DolphinTool::TexturePackCommand(args);
+  else if (command_str == "uidcache")
+    return DolphinTool::UIDCacheCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
@@ -0,0 +1,70 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/UIDCacheCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "VideoCommon/GXPipelineUIDCache.h"
+
+namespace DolphinTool
+{
+int UIDCacheCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: uidcache [options]... FILE...\n\n"
+               "Merges pipeline UID caches, like the <game id>.uidcache files in the Cache\n"
+               "folder of several users, into one without duplicates. Without an output, only\n"
+               "checks the files and prints how many UIDs they have.");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the merged UID cache FILE.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+  const std::vector<std::string> input_paths = parser.args();
+  if (input_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<VideoCommon::SerializedGXPipelineUid> merged;
+  for (const std::string& input_path : input_paths)
+  {
+    const auto uids = VideoCommon::ReadGXPipelineUIDCache(input_path);
+    if (!uids)
+    {
+      fmt::print(std::cerr, "Error: {} is not a UID cache of version {}\n", input_path,
+                 VideoCommon::GX_PIPELINE_UID_VERSION);
+      return EXIT_FAILURE;
+    }
+
+    const size_t new_count = VideoCommon::MergeGXPipelineUIDs(&merged, *uids);
+    fmt::print(std::cout, "{}: {} UIDs, {} new\n", input_path, uids->size(), new_count);
+  }
+
+  const std::string& output_path = options["output"];
+  if (output_path.empty())
+    return EXIT_SUCCESS;
+
+  if (!VideoCommon::WriteGXPipelineUIDCache(output_path, merged))
+  {
+    fmt::print(std::cerr, "Error: Unable to write {}\n", output_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Wrote {} UIDs to {}\n", merged.size(), output_path);
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -9,6 +9,7 @@
 #include "Common/Logging/Log.h"
 #include "Core/HW/Memmap.h"
 #include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/TextureEncoder.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -26,6 +27,7 @@ void ClearEfb()
   int top = bpmem.copyTexSrcXY.y;
   int right = std::min(left + bpmem.copyTexSrcWH.x, EFB_WIDTH - 1);
   int bottom = std::min(top + bpmem.copyTexSrcWH.y, EFB_HEIGHT - 1);
+  Rasterizer::MarkTilesDirty(left, top, right + 1, bottom + 1);
 
   for (u16 y = top; y <= bottom; y++)
   {
@@ -23,6 +23,7 @@ namespace EfbInterface
 static std::array<u8, EFB_WIDTH * EFB_HEIGHT * 6> efb;
 
 static std::array<u32, PQ_NUM_MEMBERS> perf_values;
+static std::array<u32, PQ_NUM_MEMBERS> perf_quads;
 
 static inline u32 GetColorOffset(u16 x, u16 y)
 {
@@ -710,10 +711,16 @@ void IncPerfCounterQuadCount(PerfQueryType type)
   // Current software renderer architecture works on pixels though, so
   // we have this "quad" hack here to only increment the registers on
   // every fourth rendered pixel
-  static u32 quad[PQ_NUM_MEMBERS];
-  if (++quad[type] != 3)
+  if (++perf_quads[type] != 3)
     return;
-  quad[type] = 0;
+  perf_quads[type] = 0;
   ++perf_values[type];
 }
+
+void AddPerfCounterQuadCount(PerfQueryType type, u32 count)
+{
+  const u32 total = perf_quads[type] + count;
+  perf_values[type] += total / 3;
+  perf_quads[type] = total % 3;
+}
 }  // namespace EfbInterface
@@ -59,4 +59,6 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
 void IncPerfCounterQuadCount(PerfQueryType type);
+// The same as calling IncPerfCounterQuadCount count times, for pixels counted on other threads
+void AddPerfCounterQuadCount(PerfQueryType type, u32 count);
 }  // namespace EfbInterface
@@ -4,14 +4,22 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Thread.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/Tev.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
@@ -97,20 +105,81 @@ struct Slope
 };
 
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// A triangle set up for one scissor rectangle, with what is needed to draw its pixels
+struct Triangle
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // 28.4 fixed-point deltas and half-edge constants
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+  s32 C1, C2, C3;
+
+  // Bounding rectangle, clipped to the scissor
+  s32 minx, maxx, miny, maxy;
+};
+
+// What a thread needs to draw pixels
+struct ShadingContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  PixelCounters counters;
+};
+
+// With several threads, triangles are binned to the tiles they cover and each tile is drawn by one
+// thread, in the order the triangles came, which keeps the output the same as drawing them one
+// after the other.
+// Draws are drawn in parts of this many triangles, to bound the memory used by the bins
+static constexpr size_t MAX_BINNED_TRIANGLES = 4096;
+// Below this many pixels, waking up the threads costs more than they save
+static constexpr u32 MIN_THREADED_PIXELS = 4 * TILE_SIZE * TILE_SIZE;
+
+static ShadingContext mainContext;
+
+static std::vector<Triangle> binnedTriangles;
+static std::array<std::vector<u32>, TILES_X * TILES_Y> tileBins;
+static std::vector<u32> activeTiles;
+static u32 binnedPixels = 0;
+
+// Everything is dirty until the first copy looked
+static TileMask dirtyTiles = TileMask().set();
+
+// One context for each thread. The first one is used by the GPU thread, which draws tiles too.
+static std::vector<std::unique_ptr<ShadingContext>> threadContexts;
+static std::vector<std::thread> threads;
+static std::mutex threadsMutex;
+static std::condition_variable threadsStartCV;
+static std::condition_variable threadsDoneCV;
+static u32 threadsGeneration = 0;
+static size_t threadsRunning = 0;
+static bool threadsExit = false;
+static std::atomic<size_t> nextTile;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+static void SetThreadCount(u32 count);
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  mainContext.tev.Init();
+  dirtyTiles.set();
+  binnedTriangles.reserve(MAX_BINNED_TRIANGLES);
+  SetThreadCount(g_ActiveConfig.GetSWRasterizerThreads());
+}
+
+void Shutdown()
+{
+  Flush();
+  SetThreadCount(0);
 }
 
 void ScissorChanged()
@@ -142,29 +211,47 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  // Binned triangles are drawn with the colors they were set up with
+  Flush();
+
+  mainContext.tev.SetKonstColors();
+  for (auto& context : threadContexts)
+    context->tev.SetKonstColors();
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void IncPerfCounterQuadCount(ShadingContext& context, PerfQueryType type)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  if (context.tev.counters)
+    ++context.tev.counters->perf_quads[type];
+  else
+    EfbInterface::IncPerfCounterQuadCount(type);
+}
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+static void Draw(const Triangle& tri, ShadingContext& context, s32 x, s32 y, s32 xi, s32 yi)
+{
+  if (context.tev.counters)
+    ++context.tev.counters->rasterized_pixels;
+  else
+    INCSTAT(g_stats.this_frame.rasterized_pixels);
+
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    IncPerfCounterQuadCount(context, PQ_ZCOMP_INPUT_ZCOMPLOC);
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    IncPerfCounterQuadCount(context, PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +262,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +294,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,10 +306,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
-
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
   float dudy = fabsf(uv00[0] - uv01[0]);
@@ -258,7 +345,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(const Triangle& tri, RasterBlock& rasterBlock, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +356,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / tri.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +378,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +391,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,9 +409,10 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Returns false if the triangle has no pixels within the scissor
+static bool SetupTriangle(const OutputVertexData* v0, const OutputVertexData* v1,
+                          const OutputVertexData* v2, const BPFunctions::ScissorRect& scissor,
+                          Triangle& tri)
 {
   // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
   // zfreeze depends on it
@@ -349,15 +439,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -376,28 +457,38 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   maxy = std::min(maxy, scissor.rect.bottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
+
+  tri.minx = minx;
+  tri.maxx = maxx;
+  tri.miny = miny;
+  tri.maxy = maxy;
 
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
                          scissor.y_off);
 
+  tri.ZSlope = ZSlope;
+
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  tri.WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      tri.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      tri.TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                                     v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
@@ -414,6 +505,46 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  tri.DX12 = DX12;
+  tri.DX23 = DX23;
+  tri.DX31 = DX31;
+  tri.DY12 = DY12;
+  tri.DY23 = DY23;
+  tri.DY31 = DY31;
+  tri.C1 = C1;
+  tri.C2 = C2;
+  tri.C3 = C3;
+
+  return true;
+}
+
+// Draws the pixels of the triangle within the rectangle, which is within the triangle's bounding
+// rectangle. The rectangle must start on a block boundary unless it starts where the triangle's
+// does, so the blocks are the same however the triangle is split.
+static void RasterizeTriangle(const Triangle& tri, ShadingContext& context, s32 minx, s32 maxx,
+                              s32 miny, s32 maxy)
+{
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +586,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(tri, context.rasterBlock, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +596,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(tri, context, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +619,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(tri, context, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,6 +636,219 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+TileMask GetTiles(s32 left, s32 top, s32 right, s32 bottom)
+{
+  left = std::max(left, 0);
+  top = std::max(top, 0);
+  right = std::min(right, static_cast<s32>(EFB_WIDTH));
+  bottom = std::min(bottom, static_cast<s32>(EFB_HEIGHT));
+
+  TileMask tiles;
+  if (left >= right || top >= bottom)
+    return tiles;
+
+  for (s32 tile_y = top / TILE_SIZE; tile_y <= (bottom - 1) / TILE_SIZE; tile_y++)
+  {
+    for (s32 tile_x = left / TILE_SIZE; tile_x <= (right - 1) / TILE_SIZE; tile_x++)
+      tiles.set(tile_y * TILES_X + tile_x);
+  }
+  return tiles;
+}
+
+void MarkTilesDirty(s32 left, s32 top, s32 right, s32 bottom)
+{
+  dirtyTiles |= GetTiles(left, top, right, bottom);
+}
+
+TileMask TakeDirtyTiles()
+{
+  const TileMask tiles = dirtyTiles;
+  dirtyTiles.reset();
+  return tiles;
+}
+
+static void BinTriangle(u32 index)
+{
+  const Triangle& tri = binnedTriangles[index];
+  for (s32 tile_y = tri.miny / TILE_SIZE; tile_y <= (tri.maxy - 1) / TILE_SIZE; tile_y++)
+  {
+    for (s32 tile_x = tri.minx / TILE_SIZE; tile_x <= (tri.maxx - 1) / TILE_SIZE; tile_x++)
+    {
+      const u32 tile = tile_y * TILES_X + tile_x;
+      if (tileBins[tile].empty())
+        activeTiles.push_back(tile);
+      tileBins[tile].push_back(index);
+      dirtyTiles.set(tile);
+    }
+  }
+
+  binnedPixels += (tri.maxx - tri.minx) * (tri.maxy - tri.miny);
+}
+
+static void DrawTile(u32 tile, ShadingContext& context)
+{
+  const s32 tile_left = (tile % TILES_X) * TILE_SIZE;
+  const s32 tile_top = (tile / TILES_X) * TILE_SIZE;
+
+  for (u32 index : tileBins[tile])
+  {
+    const Triangle& tri = binnedTriangles[index];
+    RasterizeTriangle(tri, context, std::max(tri.minx, tile_left),
+                      std::min(tri.maxx, tile_left + TILE_SIZE), std::max(tri.miny, tile_top),
+                      std::min(tri.maxy, tile_top + TILE_SIZE));
+  }
+}
+
+static void DrawTiles(ShadingContext& context)
+{
+  for (size_t i = nextTile++; i < activeTiles.size(); i = nextTile++)
+    DrawTile(activeTiles[i], context);
+}
+
+static void ThreadFunc(size_t index, u32 generation)
+{
+  Common::SetCurrentThreadName("SW Rasterizer");
+
+  while (true)
+  {
+    {
+      std::unique_lock lk(threadsMutex);
+      threadsStartCV.wait(lk, [&] { return threadsExit || threadsGeneration != generation; });
+      if (threadsExit)
+        return;
+      generation = threadsGeneration;
+    }
+
+    DrawTiles(*threadContexts[index]);
+
+    {
+      std::lock_guard lk(threadsMutex);
+      if (--threadsRunning == 0)
+        threadsDoneCV.notify_one();
+    }
+  }
+}
+
+static void SetThreadCount(u32 count)
+{
+  // A single thread draws the triangles as they come
+  const size_t num_contexts = count > 1 ? count : 0;
+  if (threadContexts.size() == num_contexts)
+    return;
+
+  {
+    std::lock_guard lk(threadsMutex);
+    threadsExit = true;
+  }
+  threadsStartCV.notify_all();
+  for (std::thread& thread : threads)
+    thread.join();
+  threads.clear();
+  threadsExit = false;
+
+  threadContexts.clear();
+  for (size_t i = 0; i < num_contexts; i++)
+  {
+    auto context = std::make_unique<ShadingContext>();
+    context->tev.counters = &context->counters;
+    context->tev.Init();
+    context->tev.SetKonstColors();
+    threadContexts.push_back(std::move(context));
+  }
+
+  for (size_t i = 1; i < num_contexts; i++)
+    threads.emplace_back(ThreadFunc, i, threadsGeneration);
+}
+
+// Adds what the threads counted to the shared counters
+static void MergeCounters()
+{
+  for (auto& context : threadContexts)
+  {
+    PixelCounters& counters = context->counters;
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, counters.rasterized_pixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, counters.tev_pixels_in);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, counters.tev_pixels_out);
+
+    for (size_t i = 0; i < counters.perf_quads.size(); i++)
+    {
+      const u32 count = counters.perf_quads[i];
+      if (count != 0)
+        EfbInterface::AddPerfCounterQuadCount(static_cast<PerfQueryType>(i), count);
+    }
+
+    if (counters.tev_pixels_out != 0)
+    {
+      BBoxManager::Update(counters.bbox_left, counters.bbox_right, counters.bbox_top,
+                          counters.bbox_bottom);
+    }
+
+    counters = {};
+  }
+}
+
+void Flush()
+{
+  if (!activeTiles.empty())
+  {
+    nextTile = 0;
+    if (binnedPixels < MIN_THREADED_PIXELS || threads.empty())
+    {
+      DrawTiles(*threadContexts[0]);
+    }
+    else
+    {
+      {
+        std::lock_guard lk(threadsMutex);
+        threadsRunning = threads.size();
+        threadsGeneration++;
+      }
+      threadsStartCV.notify_all();
+
+      DrawTiles(*threadContexts[0]);
+
+      std::unique_lock lk(threadsMutex);
+      threadsDoneCV.wait(lk, [] { return threadsRunning == 0; });
+    }
+
+    MergeCounters();
+
+    for (u32 tile : activeTiles)
+      tileBins[tile].clear();
+    activeTiles.clear();
+    binnedTriangles.clear();
+    binnedPixels = 0;
+  }
+
+  SetThreadCount(g_ActiveConfig.GetSWRasterizerThreads());
+}
+
+static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                                  const OutputVertexData* v2,
+                                  const BPFunctions::ScissorRect& scissor)
+{
+  if (threadContexts.empty())
+  {
+    Triangle tri;
+    if (SetupTriangle(v0, v1, v2, scissor, tri))
+    {
+      MarkTilesDirty(tri.minx, tri.miny, tri.maxx, tri.maxy);
+      RasterizeTriangle(tri, mainContext, tri.minx, tri.maxx, tri.miny, tri.maxy);
+    }
+    return;
+  }
+
+  if (!SetupTriangle(v0, v1, v2, scissor, binnedTriangles.emplace_back()))
+  {
+    binnedTriangles.pop_back();
+    return;
+  }
+
+  BinTriangle(static_cast<u32>(binnedTriangles.size() - 1));
+  if (binnedTriangles.size() >= MAX_BINNED_TRIANGLES)
+    Flush();
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include <bitset>
+
 #include "Common/CommonTypes.h"
+#include "VideoCommon/VideoCommon.h"
 
 struct OutputVertexData;
 
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
@@ -17,8 +21,26 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
 
+// Draws the triangles binned for the rasterizer threads. Must be called at the end of each draw,
+// before the state they are drawn with changes.
+void Flush();
+
 void SetTevKonstColors();
 
+// The EFB is split into tiles, which are binned to when drawing on several threads, and which are
+// marked dirty when they are drawn to or cleared, so an EFB copy of tiles that didn't change since
+// the previous identical copy can reuse its output.
+constexpr s32 TILE_SIZE = 32;
+constexpr s32 TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+constexpr s32 TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+using TileMask = std::bitset<TILES_X * TILES_Y>;
+
+// The tiles overlapping the pixels from (left, top) up to but excluding (right, bottom)
+TileMask GetTiles(s32 left, s32 top, s32 right, s32 bottom);
+void MarkTilesDirty(s32 left, s32 top, s32 right, s32 bottom);
+// Returns the tiles marked dirty since the last call, and marks them all clean
+TileMask TakeDirtyTiles();
+
 struct RasterBlockPixel
 {
   float InvW;
@@ -23,6 +23,7 @@
 #include "VideoBackends/Software/SWTexture.h"
 #include "VideoBackends/Software/SWVertexLoader.h"
 #include "VideoBackends/Software/TextureCache.h"
+#include "VideoBackends/Software/TextureEncoder.h"
 
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/Present.h"
@@ -114,6 +115,8 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
 
 void VideoSoftware::Shutdown()
 {
+  Rasterizer::Shutdown();
+  TextureEncoder::Shutdown();
   ShutdownShared();
 }
 }  // namespace SW
@@ -106,6 +106,47 @@ void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const Inpu
   }
 }
 
+void Tev::DrawRegular(unsigned int stageNum, const TevStageCombiner::ColorCombiner& cc,
+                      const TevStageCombiner::AlphaCombiner& ac)
+{
+  const u64 key = u64{cc.hex} << 32 | ac.hex;
+  if (m_CombinerKeys[stageNum] != key)
+  {
+    m_CombinerParams[stageNum] = TevCombiner::MakeParams(cc, ac);
+    m_CombinerKeys[stageNum] = key;
+  }
+
+  // The inputs go straight into the lanes. a, b and c keep their low 8 bits like the Tev's input
+  // registers, d is always in the 11 bit range of the registers.
+  TevCombiner::Inputs lanes;
+  const auto pack = [this](s32* lane, TevColorArg color_arg, TevAlphaArg alpha_arg) {
+    const TevColorRef& color = m_ColorInputLUT[color_arg];
+    lane[ALP_C] = m_AlphaInputLUT[alpha_arg].a;
+    lane[BLU_C] = color.b;
+    lane[GRN_C] = color.g;
+    lane[RED_C] = color.r;
+  };
+  pack(lanes.a, cc.a, ac.a);
+  pack(lanes.b, cc.b, ac.b);
+  pack(lanes.c, cc.c, ac.c);
+  pack(lanes.d, cc.d, ac.d);
+  for (int i = ALP_C; i <= RED_C; i++)
+  {
+    lanes.a[i] &= 0xFF;
+    lanes.b[i] &= 0xFF;
+    lanes.c[i] &= 0xFF;
+  }
+
+  // Both combiners at once, clamped like the compare mode results below
+  s32 result[4];
+  m_Combine(lanes, m_CombinerParams[stageNum], result);
+
+  Reg[cc.dest].r = result[RED_C];
+  Reg[cc.dest].g = result[GRN_C];
+  Reg[cc.dest].b = result[BLU_C];
+  Reg[ac.dest].a = result[ALP_C];
+}
+
 void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
 {
   for (int i = BLU_C; i <= RED_C; i++)
@@ -397,7 +438,10 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  if (counters)
+    ++counters->tev_pixels_in;
+  else
+    INCSTAT(g_stats.this_frame.tev_pixels_in);
 
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
@@ -491,6 +535,12 @@ void Tev::Draw()
     // set color
     SetRasColor(order.getColorChan(stageOdd), ac.rswap);
 
+    if (m_Combine && cc.bias != TevBias::Compare && ac.bias != TevBias::Compare)
+    {
+      DrawRegular(stageNum, cc, ac);
+      continue;
+    }
+
     // combine inputs
     InputRegType inputs[4];
     inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
@@ -666,25 +716,51 @@ void Tev::Draw()
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
-
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  const u16 bbox_left = static_cast<u16>(Position[0] & ~1);
+  const u16 bbox_right = static_cast<u16>(Position[0] | 1);
+  const u16 bbox_top = static_cast<u16>(Position[1] & ~1);
+  const u16 bbox_bottom = static_cast<u16>(Position[1] | 1);
+  if (counters)
+  {
+    counters->bbox_left = std::min(counters->bbox_left, bbox_left);
+    counters->bbox_right = std::max(counters->bbox_right, bbox_right);
+    counters->bbox_top = std::min(counters->bbox_top, bbox_top);
+    counters->bbox_bottom = std::max(counters->bbox_bottom, bbox_bottom);
+    ++counters->tev_pixels_out;
+  }
+  else
+  {
+    BBoxManager::Update(bbox_left, bbox_right, bbox_top, bbox_bottom);
+    INCSTAT(g_stats.this_frame.tev_pixels_out);
+  }
+  IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
+void Tev::IncPerfCounterQuadCount(PerfQueryType type)
+{
+  if (counters)
+    ++counters->perf_quads[type];
+  else
+    EfbInterface::IncPerfCounterQuadCount(type);
+}
+
+void Tev::Init()
+{
+  m_Combine = TevCombiner::GetSIMDCombineFunction();
+}
+
 void Tev::SetKonstColors()
 {
   auto& system = Core::System::GetInstance();
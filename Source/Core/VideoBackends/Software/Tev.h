@@ -5,8 +5,25 @@
 
 #include <array>
 
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/TevCombiner.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
+
+// What drawing pixels adds to the statistics, perf queries and bounding box. Rasterizer threads
+// collect them here, to be added to the shared ones once all threads are done.
+struct PixelCounters
+{
+  u32 rasterized_pixels = 0;
+  u32 tev_pixels_in = 0;
+  u32 tev_pixels_out = 0;
+  std::array<u32, PQ_NUM_MEMBERS> perf_quads{};
+  u16 bbox_left = 0xFFFF;
+  u16 bbox_right = 0;
+  u16 bbox_top = 0xFFFF;
+  u16 bbox_bottom = 0;
+};
 
 class Tev
 {
@@ -126,6 +143,19 @@ class Tev
   u8 IndirectTex[4][4]{};
   TextureCoordinateType TexCoord{};
 
+  // Picked by Init, null without SIMD
+  TevCombiner::CombineFunction m_Combine = nullptr;
+  // The combiner settings of each stage, made again when the stage's combiners change
+  std::array<TevCombiner::Params, 16> m_CombinerParams{};
+  std::array<u64, 16> m_CombinerKeys = MakeCombinerKeys();
+
+  static constexpr std::array<u64, 16> MakeCombinerKeys()
+  {
+    std::array<u64, 16> keys{};
+    keys.fill(~u64{0});
+    return keys;
+  }
+
   const Common::EnumMap<TevColorRef, TevColorArg::Zero> m_ColorInputLUT{
       TevColorRef::Color(Reg[TevOutput::Prev]),    // prev.rgb
       TevColorRef::Alpha(Reg[TevOutput::Prev]),    // prev.aaa
@@ -205,6 +235,9 @@ class Tev
 
   void SetRasColor(RasColorChan colorChan, u32 swaptable);
 
+  // Both combiners of a stage which does not use compare mode, with m_Combine
+  void DrawRegular(unsigned int stageNum, const TevStageCombiner::ColorCombiner& cc,
+                   const TevStageCombiner::AlphaCombiner& ac);
   void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
@@ -212,6 +245,8 @@ class Tev
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  void IncPerfCounterQuadCount(PerfQueryType type);
+
 public:
   s32 Position[3]{};
   u8 Color[2][4]{};  // must be RGBA for correct swap table ordering
@@ -221,6 +256,9 @@ public:
   s32 TextureLod[16]{};
   bool TextureLinear[16]{};
 
+  // If set, the pixels are counted here instead of in the shared counters
+  PixelCounters* counters = nullptr;
+
   enum
   {
     ALP_C,
@@ -229,6 +267,9 @@ public:
     RED_C
   };
 
+  // Must be called before drawing. Not done by the constructor, which may run before the CPU is
+  // detected.
+  void Init();
   void SetKonstColors();
   void Draw();
 };
@@ -0,0 +1,110 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Software/TevCombiner.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/CPUDetect.h"
+#include "Common/Inline.h"
+
+#if defined(_M_X86) || defined(_M_X86_64)
+#define USE_SSE
+#include <immintrin.h>
+#endif
+
+#define NO_SIMD
+#include "VideoBackends/Software/TevCombinerImpl.h"
+#undef NO_SIMD
+#ifdef USE_SSE
+#define USE_SSE41
+#include "VideoBackends/Software/TevCombinerImpl.h"
+#define USE_AVX2
+#include "VideoBackends/Software/TevCombinerImpl.h"
+#endif
+
+namespace TevCombiner
+{
+// Lookup tables of the Tev
+static constexpr Common::EnumMap<s32, TevBias::Compare> BIAS{0, 128, -128, 0};
+static constexpr Common::EnumMap<s32, TevScale::Divide2> SCALE_LEFT{0, 1, 2, 0};
+static constexpr Common::EnumMap<s32, TevScale::Divide2> SCALE_RIGHT{0, 0, 0, 1};
+
+Params MakeParams(const TevStageCombiner::ColorCombiner& cc,
+                  const TevStageCombiner::AlphaCombiner& ac)
+{
+  Params params;
+  for (int i = 0; i < 4; i++)
+  {
+    // Lane 0 is alpha
+    const bool alpha = i == 0;
+    const TevScale scale = alpha ? ac.scale : cc.scale;
+    const TevOp op = alpha ? ac.op : cc.op;
+    const bool clamp = alpha ? ac.clamp : cc.clamp;
+
+    params.scale_left[i] = SCALE_LEFT[scale];
+    params.scale_mul[i] = 1 << SCALE_LEFT[scale];
+    params.scale_right[i] = SCALE_RIGHT[scale];
+    params.round[i] = scale == TevScale::Divide2 ? 0 : op == TevOp::Sub ? 127 : 128;
+    // The alpha combiner negates before dividing, the color combiner after, which rounds the other
+    // way.
+    params.negate_before[i] = alpha && op == TevOp::Sub ? -1 : 0;
+    params.negate_after[i] = !alpha && op == TevOp::Sub ? -1 : 0;
+    params.bias[i] = BIAS[alpha ? ac.bias : cc.bias];
+    params.clamp_min[i] = clamp ? 0 : -1024;
+    params.clamp_max[i] = clamp ? 255 : 1023;
+  }
+  return params;
+}
+
+bool IsSupported(InstructionSet set)
+{
+  switch (set)
+  {
+  case InstructionSet::Scalar:
+    return true;
+#ifdef USE_SSE
+  case InstructionSet::SSE41:
+    return cpu_info.bSSE4_1;
+  case InstructionSet::AVX2:
+    return cpu_info.bAVX2;
+#endif
+  default:
+    return false;
+  }
+}
+
+const Functions& GetFunctions(InstructionSet set)
+{
+  switch (set)
+  {
+#ifdef USE_SSE
+  case InstructionSet::SSE41:
+    return TevCombiner_SSE41::FUNCTIONS;
+  case InstructionSet::AVX2:
+    return TevCombiner_AVX2::FUNCTIONS;
+#endif
+  default:
+    return TevCombiner_Scalar::FUNCTIONS;
+  }
+}
+
+const Functions& GetFunctions()
+{
+  static const Functions& functions = []() -> const Functions& {
+    if (IsSupported(InstructionSet::AVX2))
+      return GetFunctions(InstructionSet::AVX2);
+    if (IsSupported(InstructionSet::SSE41))
+      return GetFunctions(InstructionSet::SSE41);
+    return GetFunctions(InstructionSet::Scalar);
+  }();
+  return functions;
+}
+
+CombineFunction GetSIMDCombineFunction()
+{
+  const Functions& functions = GetFunctions();
+  return &functions == &GetFunctions(InstructionSet::Scalar) ? nullptr : functions.combine;
+}
+}  // namespace TevCombiner
@@ -0,0 +1,73 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+
+// The per-pixel arithmetic of the TEV and texture sampler, for all four channels of a pixel at
+// once. The SIMD versions are picked at runtime and give the same results as the scalar one.
+namespace TevCombiner
+{
+// The inputs of a stage, one lane per channel in the Tev's order: alpha, blue, green, red. The
+// lanes of blue, green and red go through the color combiner, the alpha lane through the alpha
+// combiner.
+struct alignas(16) Inputs
+{
+  s32 a[4];
+  s32 b[4];
+  s32 c[4];
+  s32 d[4];
+};
+
+// The combiner settings of a stage, spread over the lanes
+struct alignas(16) Params
+{
+  s32 scale_mul[4];
+  s32 scale_left[4];
+  s32 scale_right[4];
+  s32 round[4];
+  // All bits set to negate before or after the division by 256
+  s32 negate_before[4];
+  s32 negate_after[4];
+  s32 bias[4];
+  s32 clamp_min[4];
+  s32 clamp_max[4];
+};
+
+// Combiners using compare mode are not handled here
+Params MakeParams(const TevStageCombiner::ColorCombiner& cc,
+                  const TevStageCombiner::AlphaCombiner& ac);
+
+// Computes (d + bias + lerp(a, b, c)) * scale with the rounding of each combiner, clamped
+using CombineFunction = void (*)(const Inputs& inputs, const Params& params, s32* output);
+// Bilinear filter of four RGBA texels: top left, top right, bottom left, bottom right
+using BilinearFunction = void (*)(const u8 (*texels)[4], u32 fract_s, u32 fract_t, u8* sample);
+// Linear filter between two RGBA texels, with fract in 1/16
+using LerpFunction = void (*)(const u8* texel0, const u8* texel1, u32 fract, u8* sample);
+
+struct Functions
+{
+  CombineFunction combine;
+  BilinearFunction bilinear;
+  LerpFunction lerp;
+};
+
+enum class InstructionSet
+{
+  Scalar,
+  SSE41,
+  AVX2,
+};
+
+bool IsSupported(InstructionSet set);
+const Functions& GetFunctions(InstructionSet set);
+
+// The functions for the best instruction set of the CPU
+const Functions& GetFunctions();
+
+// The SIMD combine function for the CPU, or null if it has none. Without SIMD, combining the
+// channels one by one inline is faster than calling the scalar function.
+CombineFunction GetSIMDCombineFunction();
+}  // namespace TevCombiner
@@ -0,0 +1,156 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#if defined(USE_AVX2)
+#define VECTOR_NAMESPACE TevCombiner_AVX2
+#elif defined(USE_SSE41)
+#define VECTOR_NAMESPACE TevCombiner_SSE41
+#elif defined(NO_SIMD)
+#define VECTOR_NAMESPACE TevCombiner_Scalar
+#else
+#error This file is meant to be used by TevCombiner.cpp only!
+#endif
+
+#if defined(__GNUC__) && defined(USE_AVX2) && !defined(__AVX2__)
+#define ATTR_TARGET __attribute__((target("avx2")))
+#elif defined(__GNUC__) && defined(USE_SSE41) && !defined(__SSE4_1__)
+#define ATTR_TARGET __attribute__((target("sse4.1")))
+#else
+#define ATTR_TARGET
+#endif
+
+namespace VECTOR_NAMESPACE
+{
+#if defined(USE_SSE41)
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i Load(const s32* values)
+{
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(values));
+}
+
+// Negates the lanes which have all bits set in the mask
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i Negate(__m128i value, __m128i mask)
+{
+  return _mm_sub_epi32(_mm_xor_si128(value, mask), mask);
+}
+
+// Packs the low 16 bits of the lanes of two vectors into pairs, for _mm_madd_epi16
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128i MakePairs(__m128i low, __m128i high)
+{
+  return _mm_or_si128(low, _mm_slli_epi32(high, 16));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void StoreTexel(__m128i sum, int shift, u8* sample)
+{
+  const __m128i texel = _mm_srli_epi32(sum, shift);
+  const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(texel, texel), texel);
+  const u32 value = static_cast<u32>(_mm_cvtsi128_si32(packed));
+  std::memcpy(sample, &value, sizeof(value));
+}
+#endif
+
+ATTR_TARGET static void Combine(const TevCombiner::Inputs& inputs,
+                                const TevCombiner::Params& params, s32* output)
+{
+#if defined(USE_SSE41)
+  const __m128i a = Load(inputs.a);
+  const __m128i b = Load(inputs.b);
+  const __m128i c = _mm_add_epi32(Load(inputs.c), _mm_srai_epi32(Load(inputs.c), 7));
+
+  // a and b are 8 bits and c at most 256, so a * (256 - c) + b * c fits a multiply-add of pairs
+  const __m128i c_pairs = MakePairs(_mm_sub_epi32(_mm_set1_epi32(256), c), c);
+  __m128i temp = _mm_madd_epi16(MakePairs(a, b), c_pairs);
+#if defined(USE_AVX2)
+  temp = _mm_sllv_epi32(temp, Load(params.scale_left));
+#else
+  temp = _mm_mullo_epi32(temp, Load(params.scale_mul));
+#endif
+  temp = _mm_add_epi32(temp, Load(params.round));
+  temp = Negate(temp, Load(params.negate_before));
+  temp = _mm_srai_epi32(temp, 8);
+  temp = Negate(temp, Load(params.negate_after));
+
+  __m128i result = _mm_add_epi32(Load(inputs.d), Load(params.bias));
+#if defined(USE_AVX2)
+  result = _mm_add_epi32(_mm_sllv_epi32(result, Load(params.scale_left)), temp);
+  result = _mm_srav_epi32(result, Load(params.scale_right));
+#else
+  result = _mm_add_epi32(_mm_mullo_epi32(result, Load(params.scale_mul)), temp);
+  const __m128i divide = _mm_sub_epi32(_mm_setzero_si128(), Load(params.scale_right));
+  result = _mm_blendv_epi8(result, _mm_srai_epi32(result, 1), divide);
+#endif
+
+  result = _mm_min_epi32(_mm_max_epi32(result, Load(params.clamp_min)), Load(params.clamp_max));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output), result);
+#else
+  for (int i = 0; i < 4; i++)
+  {
+    const s32 c = inputs.c[i] + (inputs.c[i] >> 7);
+
+    s32 temp = inputs.a[i] * (256 - c) + inputs.b[i] * c;
+    temp <<= params.scale_left[i];
+    temp += params.round[i];
+    temp = (temp ^ params.negate_before[i]) - params.negate_before[i];
+    temp >>= 8;
+    temp = (temp ^ params.negate_after[i]) - params.negate_after[i];
+
+    s32 result = ((inputs.d[i] + params.bias[i]) << params.scale_left[i]) + temp;
+    result >>= params.scale_right[i];
+
+    output[i] = std::clamp(result, params.clamp_min[i], params.clamp_max[i]);
+  }
+#endif
+}
+
+ATTR_TARGET static void Bilinear(const u8 (*texels)[4], u32 fract_s, u32 fract_t, u8* sample)
+{
+  const u32 weights[4] = {(128 - fract_s) * (128 - fract_t), fract_s * (128 - fract_t),
+                          (128 - fract_s) * fract_t, fract_s * fract_t};
+
+#if defined(USE_SSE41)
+  const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels));
+  const __m128i texels01 = _mm_cvtepu8_epi16(bytes);
+  const __m128i texels23 = _mm_unpackhi_epi8(bytes, _mm_setzero_si128());
+
+  // The channels of the left and right texels side by side, weighted by one multiply-add. The
+  // weights are at most 128 * 128, which fits the signed 16 bits.
+  const __m128i pairs01 = _mm_unpacklo_epi16(texels01, _mm_srli_si128(texels01, 8));
+  const __m128i pairs23 = _mm_unpacklo_epi16(texels23, _mm_srli_si128(texels23, 8));
+  const __m128i weights01 = _mm_set1_epi32(static_cast<s32>(weights[0] | weights[1] << 16));
+  const __m128i weights23 = _mm_set1_epi32(static_cast<s32>(weights[2] | weights[3] << 16));
+
+  const __m128i sum =
+      _mm_add_epi32(_mm_madd_epi16(pairs01, weights01), _mm_madd_epi16(pairs23, weights23));
+  StoreTexel(sum, 14, sample);
+#else
+  for (int i = 0; i < 4; i++)
+  {
+    const u32 sum = texels[0][i] * weights[0] + texels[1][i] * weights[1] +
+                    texels[2][i] * weights[2] + texels[3][i] * weights[3];
+    sample[i] = static_cast<u8>(sum >> 14);
+  }
+#endif
+}
+
+ATTR_TARGET static void Lerp(const u8* texel0, const u8* texel1, u32 fract, u8* sample)
+{
+#if defined(USE_SSE41)
+  u32 values[2];
+  std::memcpy(&values[0], texel0, sizeof(u32));
+  std::memcpy(&values[1], texel1, sizeof(u32));
+
+  const __m128i texels = _mm_cvtepu8_epi16(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<s32>(values[0])),
+                        _mm_cvtsi32_si128(static_cast<s32>(values[1]))));
+  const __m128i weights = _mm_set1_epi32(static_cast<s32>((16 - fract) | fract << 16));
+  StoreTexel(_mm_madd_epi16(texels, weights), 4, sample);
+#else
+  for (int i = 0; i < 4; i++)
+    sample[i] = static_cast<u8>((texel0[i] * (16 - fract) + texel1[i] * fract) >> 4);
+#endif
+}
+
+static constexpr TevCombiner::Functions FUNCTIONS = {Combine, Bilinear, Lerp};
+}  // namespace VECTOR_NAMESPACE
+
+#undef ATTR_TARGET
+#undef VECTOR_NAMESPACE
@@ -3,20 +3,28 @@
 
 #include "VideoBackends/Software/TextureEncoder.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/SWTexture.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VideoCommon.h"
 
 namespace TextureEncoder
 {
@@ -1418,29 +1426,219 @@ static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format)
   }
 }
 
-namespace
+#ifdef _M_X86_64
+// SSSE3 versions of the most common full scale copies. They produce the same output as the
+// scalar encoders above, but convert a whole row of a block at once.
+enum class FastFormat
+{
+  RGBA8,
+  RGB565,
+  I8,
+  R8,
+};
+
+// Loads four EFB pixels as A, R, G, B bytes, using exactly the 12 bytes the pixels occupy
+template <bool rgba6>
+FUNCTION_TARGET_SSSE3 static __m128i LoadARGB(const u8* src)
+{
+  u32 last;
+  std::memcpy(&last, src + 8, sizeof(last));
+  const __m128i pixels = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+                                            _mm_cvtsi32_si128(last));
+
+  if constexpr (rgba6)
+  {
+    const __m128i v = _mm_shuffle_epi8(
+        pixels, _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+    const __m128i a = _mm_and_si128(v, _mm_set1_epi32(0x3f));
+    const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 10), _mm_set1_epi32(0x3f00));
+    const __m128i g = _mm_and_si128(_mm_slli_epi32(v, 4), _mm_set1_epi32(0x3f0000));
+    const __m128i b = _mm_and_si128(_mm_slli_epi32(v, 18), _mm_set1_epi32(0x3f000000));
+    const __m128i c6 = _mm_or_si128(_mm_or_si128(a, r), _mm_or_si128(g, b));
+
+    // Convert6To8 on every byte
+    const __m128i hi = _mm_slli_epi16(c6, 2);
+    const __m128i lo = _mm_and_si128(_mm_srli_epi16(c6, 4), _mm_set1_epi8(0x03));
+    return _mm_or_si128(hi, lo);
+  }
+  else
+  {
+    const __m128i argb = _mm_shuffle_epi8(
+        pixels, _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9));
+    return _mm_or_si128(argb, _mm_set1_epi32(0xff));
+  }
+}
+
+template <bool yuv>
+FUNCTION_TARGET_SSSE3 static __m128i ARGBToX8(__m128i argb)
+{
+  const __m128i mask = _mm_set1_epi32(0xff);
+  const __m128i r = _mm_and_si128(_mm_srli_epi32(argb, 8), mask);
+  if constexpr (!yuv)
+    return r;
+
+  const __m128i g = _mm_and_si128(_mm_srli_epi32(argb, 16), mask);
+  const __m128i b = _mm_srli_epi32(argb, 24);
+  // Same as RGB8_to_I, the products and the sum fit in 16 bits
+  __m128i val = _mm_add_epi32(_mm_set1_epi32(4096), _mm_mullo_epi16(r, _mm_set1_epi32(66)));
+  val = _mm_add_epi32(val, _mm_mullo_epi16(g, _mm_set1_epi32(129)));
+  val = _mm_add_epi32(val, _mm_mullo_epi16(b, _mm_set1_epi32(25)));
+  return _mm_srli_epi32(val, 8);
+}
+
+template <bool rgba6, FastFormat format, bool yuv>
+FUNCTION_TARGET_SSSE3 static void EncodeRowSSSE3(u8* dst, const u8* src)
+{
+  if constexpr (format == FastFormat::RGBA8)
+  {
+    // The AR pairs of a block come first, followed by the GB pairs
+    const __m128i argb = _mm_shuffle_epi8(
+        LoadARGB<rgba6>(src),
+        _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), argb);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 32), _mm_srli_si128(argb, 8));
+  }
+  else if constexpr (format == FastFormat::RGB565)
+  {
+    const __m128i argb = LoadARGB<rgba6>(src);
+    const __m128i r = _mm_and_si128(argb, _mm_set1_epi32(0xf800));
+    const __m128i g = _mm_and_si128(_mm_srli_epi32(argb, 13), _mm_set1_epi32(0x07e0));
+    const __m128i b = _mm_srli_epi32(argb, 27);
+    const __m128i rgb = _mm_or_si128(_mm_or_si128(r, g), b);
+    const __m128i swapped = _mm_shuffle_epi8(
+        rgb, _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), swapped);
+  }
+  else
+  {
+    const __m128i x0 = ARGBToX8<yuv>(LoadARGB<rgba6>(src));
+    const __m128i x1 = ARGBToX8<yuv>(LoadARGB<rgba6>(src + 4 * 3));
+    const __m128i x8 = _mm_packus_epi16(_mm_packs_epi32(x0, x1), _mm_setzero_si128());
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), x8);
+  }
+}
+
+template <bool rgba6, FastFormat format, bool yuv>
+FUNCTION_TARGET_SSSE3 static void EncodeSSSE3(u8* dst, const u8* src)
+{
+  constexpr u32 block_width = (format == FastFormat::I8 || format == FastFormat::R8) ? 8 : 4;
+  constexpr u32 block_height = 4;
+  constexpr u32 block_bytes = format == FastFormat::RGBA8 ? 64 : 32;
+  constexpr u32 row_bytes = block_bytes / block_height / (format == FastFormat::RGBA8 ? 2 : 1);
+  constexpr u32 src_row_stride = EFB_WIDTH * 3;
+
+  const u32 s_blocks = bpmem.copyTexSrcWH.x / block_width + 1;
+  const u32 t_blocks = bpmem.copyTexSrcWH.y / block_height + 1;
+  const u32 write_stride = bpmem.copyDestStride << 5;
+
+  for (u32 t_block = 0; t_block < t_blocks; t_block++)
+  {
+    const u8* const src_block_row = src + t_block * block_height * src_row_stride;
+    u8* const dst_block_row = dst + t_block * write_stride;
+    for (u32 s_block = 0; s_block < s_blocks; s_block++)
+    {
+      const u8* const src_block = src_block_row + s_block * block_width * 3;
+      u8* const dst_block = dst_block_row + s_block * block_bytes;
+      for (u32 t = 0; t < block_height; t++)
+      {
+        EncodeRowSSSE3<rgba6, format, yuv>(dst_block + t * row_bytes,
+                                           src_block + t * src_row_stride);
+      }
+    }
+  }
+}
+
+template <bool rgba6>
+static bool EncodeFastForSource(u8* dst, const u8* src, EFBCopyFormat format, bool yuv)
+{
+  switch (format)
+  {
+  case EFBCopyFormat::RGBA8:
+    EncodeSSSE3<rgba6, FastFormat::RGBA8, false>(dst, src);
+    return true;
+  case EFBCopyFormat::RGB565:
+    EncodeSSSE3<rgba6, FastFormat::RGB565, false>(dst, src);
+    return true;
+  case EFBCopyFormat::R8_0x1:
+  case EFBCopyFormat::R8:
+    if (yuv)
+      EncodeSSSE3<rgba6, FastFormat::I8, true>(dst, src);
+    else
+      EncodeSSSE3<rgba6, FastFormat::R8, false>(dst, src);
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns false if the copy has to go through the scalar encoders
+static bool EncodeFast(u8* dst, const u8* src, PixelFormat efb_format, EFBCopyFormat format,
+                       bool yuv)
+{
+  switch (efb_format)
+  {
+  case PixelFormat::RGBA6_Z24:
+    return EncodeFastForSource<true>(dst, src, format, yuv);
+  case PixelFormat::RGB8_Z24:
+  case PixelFormat::RGB565_Z16:
+    return EncodeFastForSource<false>(dst, src, format, yuv);
+  case PixelFormat::Z24:
+    // Depth is stored like RGB8, but only RGBA8 and R8 copies of it match the color encoders
+    if (format != EFBCopyFormat::RGBA8 && format != EFBCopyFormat::R8 &&
+        format != EFBCopyFormat::R8_0x1)
+    {
+      return false;
+    }
+    return EncodeFastForSource<false>(dst, src, format, false);
+  default:
+    return false;
+  }
+}
+#endif
+
+bool IsSupported(InstructionSet set)
 {
-void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
-                   u32 num_blocks_y, u32 memory_stride, const MathUtil::Rectangle<int>& src_rect,
-                   bool scale_by_half)
+  switch (set)
+  {
+  case InstructionSet::Scalar:
+    return true;
+  case InstructionSet::SSSE3:
+#ifdef _M_X86_64
+    return cpu_info.bSSSE3;
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+void EncodeEfbCopy(u8* dst, const u8* src, PixelFormat efb_format, EFBCopyFormat copy_format,
+                   bool yuv, bool scale_by_half, InstructionSet set)
 {
-  const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
+#ifdef _M_X86_64
+  if (set == InstructionSet::SSSE3 && !scale_by_half &&
+      EncodeFast(dst, src, efb_format, copy_format, yuv))
+  {
+    return;
+  }
+#endif
 
   if (scale_by_half)
   {
-    switch (params.efb_format)
+    switch (efb_format)
     {
     case PixelFormat::RGBA6_Z24:
-      EncodeRGBA6halfscale(dst, src, params.copy_format, params.yuv);
+      EncodeRGBA6halfscale(dst, src, copy_format, yuv);
       break;
     case PixelFormat::RGB8_Z24:
-      EncodeRGB8halfscale(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8halfscale(dst, src, copy_format, yuv);
       break;
     case PixelFormat::RGB565_Z16:
-      EncodeRGB8halfscale(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8halfscale(dst, src, copy_format, yuv);
       break;
     case PixelFormat::Z24:
-      EncodeZ24halfscale(dst, src, params.copy_format);
+      EncodeZ24halfscale(dst, src, copy_format);
       break;
     default:
       break;
@@ -1448,26 +1646,89 @@ void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 b
   }
   else
   {
-    switch (params.efb_format)
+    switch (efb_format)
     {
     case PixelFormat::RGBA6_Z24:
-      EncodeRGBA6(dst, src, params.copy_format, params.yuv);
+      EncodeRGBA6(dst, src, copy_format, yuv);
       break;
     case PixelFormat::RGB8_Z24:
-      EncodeRGB8(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8(dst, src, copy_format, yuv);
       break;
     case PixelFormat::RGB565_Z16:
-      EncodeRGB8(dst, src, params.copy_format, params.yuv);
+      EncodeRGB8(dst, src, copy_format, yuv);
       break;
     case PixelFormat::Z24:
-      EncodeZ24(dst, src, params.copy_format);
+      EncodeZ24(dst, src, copy_format);
       break;
     default:
       break;
     }
   }
 }
-}  // namespace
+
+// Games copy the same EFB region every frame, often without drawing to it in between, e.g. for
+// shadow or HUD textures. Copies are keyed by everything the encoders read besides the EFB, and
+// remember the EFB tiles they read, so an identical copy reuses the output unless one of those
+// tiles was drawn to or cleared since.
+struct CopyKey
+{
+  PixelFormat efb_format;
+  EFBCopyFormat copy_format;
+  bool depth;
+  bool yuv;
+  u32 native_width;
+  u32 bytes_per_row;
+  u32 num_blocks_y;
+  u32 memory_stride;
+  MathUtil::Rectangle<int> src_rect;
+  bool scale_by_half;
+  float y_scale;
+  float gamma;
+  u32 src_wh;
+  u32 trigger;
+  u32 dest_stride;
+  u64 copy_filter;
+  u32 zcontrol;
+
+  bool operator==(const CopyKey& other) const = default;
+};
+
+struct CachedCopy
+{
+  CopyKey key;
+  Rasterizer::TileMask tiles;
+  u64 last_use;
+  std::vector<u8> data;
+};
+
+static constexpr size_t MAX_CACHED_COPIES = 8;
+static std::vector<CachedCopy> s_cached_copies;
+static u64 s_copy_counter = 0;
+
+// The EFB tiles the encoders read for the copy
+static Rasterizer::TileMask GetSourceTiles(const CopyKey& key)
+{
+  if (key.copy_format == EFBCopyFormat::XFB)
+  {
+    // The copy filter reads the rows above and below
+    return Rasterizer::GetTiles(key.src_rect.left, key.src_rect.top - 1, key.src_rect.right,
+                                key.src_rect.bottom + 1);
+  }
+
+  // Whole blocks are encoded, up to 8 pixels wide and high, and half scale copies read two pixels
+  // for each one
+  const u32 half_scale = key.scale_by_half ? 1 : 0;
+  const auto block_aligned = [half_scale](u32 size_minus_one) {
+    return static_cast<s32>((((size_minus_one >> half_scale) | 7) + 1) << half_scale) + 1;
+  };
+  const s32 right = key.src_rect.left + block_aligned(bpmem.copyTexSrcWH.x);
+  const s32 bottom = key.src_rect.top + block_aligned(bpmem.copyTexSrcWH.y);
+
+  // Reading past the right edge continues on the next row
+  if (right > static_cast<s32>(EFB_WIDTH))
+    return Rasterizer::GetTiles(0, key.src_rect.top, EFB_WIDTH, bottom + 1);
+  return Rasterizer::GetTiles(key.src_rect.left, key.src_rect.top, right, bottom);
+}
 
 void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
@@ -1481,15 +1742,89 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
   ASSERT(memory_stride <= (dst->GetConfig().width * dst->GetTexelSize()));
   static_cast<SW::SWStagingTexture*>(dst)->SetMapStride(memory_stride);
 
+  // Forget the copies of tiles that changed
+  const Rasterizer::TileMask dirty_tiles = Rasterizer::TakeDirtyTiles();
+  if (dirty_tiles.any())
+  {
+    std::erase_if(s_cached_copies,
+                  [&](const CachedCopy& copy) { return (copy.tiles & dirty_tiles).any(); });
+  }
+
+  u8* const dst_pointer = reinterpret_cast<u8*>(dst->GetMappedPointer());
+  const CopyKey key{params.efb_format,
+                    params.copy_format,
+                    params.depth,
+                    params.yuv,
+                    native_width,
+                    bytes_per_row,
+                    num_blocks_y,
+                    memory_stride,
+                    src_rect,
+                    scale_by_half,
+                    y_scale,
+                    gamma,
+                    bpmem.copyTexSrcWH.hex,
+                    bpmem.triggerEFBCopy.Hex,
+                    bpmem.copyDestStride,
+                    bpmem.copyfilter.Hex,
+                    bpmem.zcontrol.hex};
+
+  const auto cached = std::find_if(s_cached_copies.begin(), s_cached_copies.end(),
+                                   [&](const CachedCopy& copy) { return copy.key == key; });
+  if (cached != s_cached_copies.end() && dst_pointer)
+  {
+    std::memcpy(dst_pointer, cached->data.data(), cached->data.size());
+    cached->last_use = ++s_copy_counter;
+    return;
+  }
+
+  size_t output_size;
   if (params.copy_format == EFBCopyFormat::XFB)
   {
-    EfbInterface::EncodeXFB(reinterpret_cast<u8*>(dst->GetMappedPointer()), native_width, src_rect,
-                            y_scale, gamma);
+    EfbInterface::EncodeXFB(dst_pointer, native_width, src_rect, y_scale, gamma);
+    output_size = static_cast<size_t>(src_rect.GetWidth()) *
+                  static_cast<int>(src_rect.GetHeight() * y_scale) * sizeof(u16);
   }
   else
   {
-    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), params, native_width,
-                  bytes_per_row, num_blocks_y, memory_stride, src_rect, scale_by_half);
+    const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
+    EncodeEfbCopy(dst_pointer, src, params.efb_format, params.copy_format, params.yuv,
+                  scale_by_half,
+                  IsSupported(InstructionSet::SSSE3) ? InstructionSet::SSSE3 :
+                                                       InstructionSet::Scalar);
+    output_size = static_cast<size_t>(std::max(memory_stride, bpmem.copyDestStride << 5)) *
+                  num_blocks_y;
   }
+
+  const Rasterizer::TileMask tiles = GetSourceTiles(key);
+  if (!dst_pointer || tiles.none())
+    return;
+
+  const TextureConfig& config = dst->GetConfig();
+  output_size = std::min<size_t>(output_size, static_cast<size_t>(config.width) *
+                                                  dst->GetTexelSize() * config.height);
+
+  CachedCopy* entry;
+  if (s_cached_copies.size() < MAX_CACHED_COPIES)
+  {
+    entry = &s_cached_copies.emplace_back();
+  }
+  else
+  {
+    entry = &*std::min_element(
+        s_cached_copies.begin(), s_cached_copies.end(),
+        [](const CachedCopy& a, const CachedCopy& b) { return a.last_use < b.last_use; });
+  }
+  entry->key = key;
+  entry->tiles = tiles;
+  entry->last_use = ++s_copy_counter;
+  entry->data.assign(dst_pointer, dst_pointer + output_size);
+}
+
+void Shutdown()
+{
+  s_cached_copies.clear();
+  s_cached_copies.shrink_to_fit();
+  s_copy_counter = 0;
 }
 }  // namespace TextureEncoder
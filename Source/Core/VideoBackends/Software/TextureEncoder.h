@@ -9,8 +9,28 @@
 
 namespace TextureEncoder
 {
+// The SSSE3 encoders handle the common full scale copies and give the same output as the scalar
+// ones, which handle everything else.
+enum class InstructionSet
+{
+  Scalar,
+  SSSE3,
+};
+
+bool IsSupported(InstructionSet set);
+
+// Encodes the EFB data at src, laid out like the EFB, with the copy size and destination stride
+// set in bpmem
+void EncodeEfbCopy(u8* dst, const u8* src, PixelFormat efb_format, EFBCopyFormat copy_format,
+                   bool yuv, bool scale_by_half, InstructionSet set);
+
+// Encodes an EFB copy. A copy identical to a recent one, of EFB tiles that weren't drawn to or
+// cleared since, reuses its output.
 void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
             const MathUtil::Rectangle<int>& src_rect, bool scale_by_half, float y_scale,
             float gamma);
+
+// Frees the outputs kept for reuse
+void Shutdown();
 }
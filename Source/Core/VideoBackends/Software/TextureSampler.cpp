@@ -11,6 +11,8 @@
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
+#include "VideoBackends/Software/TevCombiner.h"
+
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureDecoder.h"
 
@@ -52,22 +54,6 @@ static inline void WrapCoord(int* coordp, WrapMode wrap_mode, int image_size)
   *coordp = coord;
 }
 
-static inline void SetTexel(const u8* inTexel, u32* outTexel, u32 fract)
-{
-  outTexel[0] = inTexel[0] * fract;
-  outTexel[1] = inTexel[1] * fract;
-  outTexel[2] = inTexel[2] * fract;
-  outTexel[3] = inTexel[3] * fract;
-}
-
-static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
-{
-  outTexel[0] += inTexel[0] * fract;
-  outTexel[1] += inTexel[1] * fract;
-  outTexel[2] += inTexel[2] * fract;
-  outTexel[3] += inTexel[3] * fract;
-}
-
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
   int baseMip = 0;
@@ -92,19 +78,12 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 
   if (mipLinear)
   {
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[2][4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
-    SetTexel(sampledTex, texel, (16 - lodFract));
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex[0]);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex[1]);
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
-    AddTexel(sampledTex, texel, lodFract);
-
-    sample[0] = (u8)(texel[0] >> 4);
-    sample[1] = (u8)(texel[1] >> 4);
-    sample[2] = (u8)(texel[2] >> 4);
-    sample[3] = (u8)(texel[3] >> 4);
+    TevCombiner::GetFunctions().lerp(sampledTex[0], sampledTex[1], lodFract, sample);
   }
   else
 #endif
@@ -192,8 +171,8 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
+    // top left, top right, bottom left, bottom right
+    u8 sampledTex[4][4];
 
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
@@ -202,45 +181,28 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, image_width_minus_1, texfmt,
+      TexDecoder_DecodeTexel(sampledTex[0], imageSrc, imageS, imageT, image_width_minus_1, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, image_width_minus_1,
+      TexDecoder_DecodeTexel(sampledTex[1], imageSrc, imageSPlus1, imageT, image_width_minus_1,
+                             texfmt, tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[2], imageSrc, imageS, imageTPlus1, image_width_minus_1,
+                             texfmt, tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[3], imageSrc, imageSPlus1, imageTPlus1, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[0], imageSrc, imageSrcOdd, imageS, imageT,
                                           image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[1], imageSrc, imageSrcOdd, imageSPlus1, imageT,
                                           image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[2], imageSrc, imageSrcOdd, imageS, imageTPlus1,
                                           image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[3], imageSrc, imageSrcOdd, imageSPlus1,
                                           imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    TevCombiner::GetFunctions().bilinear(sampledTex, fractS, fractT, sample);
   }
   else
   {
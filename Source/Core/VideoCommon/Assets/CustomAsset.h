@@ -28,6 +28,9 @@ public:
   // Loads the asset from the library returning a pass/fail result
   bool Load();
 
+  // Releases the loaded data, the asset can be loaded again afterwards
+  void Unload();
+
   // Queries the last time the asset was modified or standard epoch time
   // if the asset hasn't been modified yet
   // Note: not thread safe, expected to be called by the loader
@@ -48,6 +51,7 @@ protected:
 
 private:
   virtual CustomAssetLibrary::LoadInfo LoadImpl(const CustomAssetLibrary::AssetID& asset_id) = 0;
+  virtual void UnloadImpl() = 0;
   CustomAssetLibrary::AssetID m_asset_id;
 
   mutable std::mutex m_info_lock;
@@ -80,6 +84,13 @@ public:
   }
 
 protected:
+  void UnloadImpl() override
+  {
+    std::lock_guard lk(m_data_lock);
+    m_loaded = false;
+    m_data.reset();
+  }
+
   bool m_loaded = false;
   mutable std::mutex m_data_lock;
   std::shared_ptr<UnderlyingType> m_data;
@@ -3,8 +3,14 @@
 
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 
+#include <algorithm>
+#include <iterator>
+
+#include <fmt/format.h>
+
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Thread.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
 namespace VideoCommon
@@ -45,56 +51,179 @@ void CustomAssetLoader::Init()
     }
   });
 
-  m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
-    if (auto ptr = asset.lock())
-    {
-      if (ptr->Load())
-      {
-        std::lock_guard lk(m_asset_load_lock);
-        const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
-        if (m_max_memory_available >= m_total_bytes_loaded + asset_memory_size)
-        {
-          m_total_bytes_loaded += asset_memory_size;
-          m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
-        }
-        else
-        {
-          ERROR_LOG_FMT(VIDEO, "Failed to load asset {} because there was not enough memory.",
-                        ptr->GetAssetId());
-        }
-      }
-    }
-  });
+  m_asset_load_shutdown = false;
+  const u32 thread_count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+  for (u32 i = 0; i < thread_count; ++i)
+  {
+    m_asset_load_threads.emplace_back([this, i]() {
+      Common::SetCurrentThreadName(fmt::format("Custom Asset Loader {}", i).c_str());
+      LoadThread();
+    });
+  }
 }
 
 void CustomAssetLoader ::Shutdown()
 {
-  m_asset_load_thread.Shutdown(true);
+  {
+    std::lock_guard lk(m_asset_load_lock);
+    m_asset_load_shutdown = true;
+  }
+  m_asset_load_cv.notify_all();
+  for (std::thread& thread : m_asset_load_threads)
+    thread.join();
+  m_asset_load_threads.clear();
 
   m_asset_monitor_thread_shutdown.Set();
   m_asset_monitor_thread.join();
   m_assets_to_monitor.clear();
+  m_assets.clear();
+  m_load_queue.clear();
+  m_evictable_assets.clear();
   m_total_bytes_loaded = 0;
 }
 
+void CustomAssetLoader::Request(const std::shared_ptr<CustomAsset>& asset, bool evictable)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  auto [it, inserted] = m_assets.try_emplace(asset.get());
+  AssetEntry& entry = it->second;
+  if (inserted)
+  {
+    entry.asset = asset;
+    entry.evictable = evictable;
+  }
+  else
+  {
+    m_load_queue.erase(entry.last_use);
+    m_evictable_assets.erase(entry.last_use);
+  }
+  entry.last_use = ++m_use_counter;
+
+  switch (entry.state)
+  {
+  case LoadState::Evicted:
+    entry.state = LoadState::Queued;
+    [[fallthrough]];
+  case LoadState::Queued:
+    m_load_queue.emplace(entry.last_use, asset.get());
+    m_asset_load_cv.notify_one();
+    break;
+  case LoadState::Loaded:
+    if (entry.evictable && entry.bytes != 0)
+      m_evictable_assets.emplace(entry.last_use, asset.get());
+    break;
+  case LoadState::Loading:
+  case LoadState::Failed:
+    break;
+  }
+}
+
+void CustomAssetLoader::Forget(const CustomAsset* asset)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  if (const auto it = m_assets.find(asset); it != m_assets.end())
+  {
+    m_total_bytes_loaded -= it->second.bytes;
+    m_load_queue.erase(it->second.last_use);
+    m_evictable_assets.erase(it->second.last_use);
+    m_assets.erase(it);
+  }
+  m_assets_to_monitor.erase(asset->GetAssetId());
+}
+
+void CustomAssetLoader::LoadThread()
+{
+  std::unique_lock lk(m_asset_load_lock);
+  while (true)
+  {
+    m_asset_load_cv.wait(lk,
+                         [this] { return m_asset_load_shutdown || !m_load_queue.empty(); });
+    if (m_asset_load_shutdown)
+      return;
+
+    // The most recently requested asset is the most likely to be drawn next
+    const auto queue_iter = std::prev(m_load_queue.end());
+    AssetEntry& entry = m_assets.at(queue_iter->second);
+    m_load_queue.erase(queue_iter);
+
+    std::shared_ptr<CustomAsset> asset = entry.asset.lock();
+    if (!asset)
+      continue;
+
+    entry.state = LoadState::Loading;
+    lk.unlock();
+    const bool loaded = asset->Load();
+    lk.lock();
+
+    if (!loaded)
+    {
+      entry.state = LoadState::Failed;
+      continue;
+    }
+    entry.state = LoadState::Loaded;
+
+    // Unload the least recently requested game textures until the asset fits. The evicted assets
+    // are released without holding the lock, in case they are the last references.
+    std::vector<std::shared_ptr<CustomAsset>> evicted_assets;
+    const std::size_t asset_memory_size = asset->GetByteSizeInMemory();
+    while (m_total_bytes_loaded + asset_memory_size > m_max_memory_available &&
+           !m_evictable_assets.empty())
+    {
+      const auto evict_iter = m_evictable_assets.begin();
+      AssetEntry& evicted_entry = m_assets.at(evict_iter->second);
+      m_evictable_assets.erase(evict_iter);
+
+      m_total_bytes_loaded -= evicted_entry.bytes;
+      evicted_entry.bytes = 0;
+      evicted_entry.state = LoadState::Evicted;
+      if (auto evicted_asset = evicted_entry.asset.lock())
+      {
+        m_assets_to_monitor.erase(evicted_asset->GetAssetId());
+        evicted_asset->Unload();
+        evicted_assets.push_back(std::move(evicted_asset));
+      }
+    }
+
+    if (m_max_memory_available >= m_total_bytes_loaded + asset_memory_size)
+    {
+      m_total_bytes_loaded += asset_memory_size;
+      entry.bytes = asset_memory_size;
+      m_assets_to_monitor.try_emplace(asset->GetAssetId(), asset);
+      if (entry.evictable)
+        m_evictable_assets.emplace(entry.last_use, asset.get());
+    }
+    else
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to load asset {} because there was not enough memory.",
+                    asset->GetAssetId());
+    }
+
+    lk.unlock();
+    evicted_assets.clear();
+    asset.reset();
+    lk.lock();
+  }
+}
+
 std::shared_ptr<GameTextureAsset>
 CustomAssetLoader::LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
                                    std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library));
+  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library), true);
 }
 
 std::shared_ptr<PixelShaderAsset>
 CustomAssetLoader::LoadPixelShader(const CustomAssetLibrary::AssetID& asset_id,
                                    std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<PixelShaderAsset>(asset_id, m_pixel_shaders, std::move(library));
+  return LoadOrCreateAsset<PixelShaderAsset>(asset_id, m_pixel_shaders, std::move(library),
+                                             false);
 }
 
 std::shared_ptr<MaterialAsset>
 CustomAssetLoader::LoadMaterial(const CustomAssetLibrary::AssetID& asset_id,
                                 std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<MaterialAsset>(asset_id, m_materials, std::move(library));
+  return LoadOrCreateAsset<MaterialAsset>(asset_id, m_materials, std::move(library), false);
 }
 }  // namespace VideoCommon
@@ -4,13 +4,15 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
+#include "Common/CommonTypes.h"
 #include "Common/Flag.h"
-#include "Common/WorkQueueThread.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/MaterialAsset.h"
 #include "VideoCommon/Assets/ShaderAsset.h"
@@ -20,6 +22,9 @@ namespace VideoCommon
 {
 // This class is responsible for loading data asynchronously when requested
 // and watches that data asynchronously reloading it if it changes
+// Assets are loaded by a pool of threads, the most recently requested first. When the memory
+// budget is exceeded, the least recently requested game textures are unloaded, and loaded again
+// the next time they are requested.
 class CustomAssetLoader
 {
 public:
@@ -53,28 +58,54 @@ private:
   std::shared_ptr<AssetType>
   LoadOrCreateAsset(const CustomAssetLibrary::AssetID& asset_id,
                     std::map<CustomAssetLibrary::AssetID, std::weak_ptr<AssetType>>& asset_map,
-                    std::shared_ptr<CustomAssetLibrary> library)
+                    std::shared_ptr<CustomAssetLibrary> library, bool evictable)
   {
     auto [it, inserted] = asset_map.try_emplace(asset_id);
     if (!inserted)
     {
       auto shared = it->second.lock();
       if (shared)
+      {
+        Request(shared, evictable);
         return shared;
+      }
     }
     std::shared_ptr<AssetType> ptr(new AssetType(std::move(library), asset_id), [&](AssetType* a) {
-      {
-        std::lock_guard lk(m_asset_load_lock);
-        m_total_bytes_loaded -= a->GetByteSizeInMemory();
-        m_assets_to_monitor.erase(a->GetAssetId());
-      }
+      Forget(a);
       delete a;
     });
     it->second = ptr;
-    m_asset_load_thread.Push(it->second);
+    Request(ptr, evictable);
     return ptr;
   }
 
+  enum class LoadState
+  {
+    Queued,
+    Loading,
+    Loaded,
+    // Not loaded again until the asset is made again
+    Failed,
+    Evicted,
+  };
+
+  struct AssetEntry
+  {
+    std::weak_ptr<CustomAsset> asset;
+    LoadState state = LoadState::Queued;
+    // When the asset was last requested, also its key in the queue or the LRU list
+    u64 last_use = 0;
+    // The size counted against the memory budget
+    std::size_t bytes = 0;
+    bool evictable = false;
+  };
+
+  // Marks the asset as the most recently used one, and queues it if it isn't loaded
+  void Request(const std::shared_ptr<CustomAsset>& asset, bool evictable);
+  // Drops the bookkeeping of an asset which is being destroyed
+  void Forget(const CustomAsset* asset);
+  void LoadThread();
+
   static constexpr auto TIME_BETWEEN_ASSET_MONITOR_CHECKS = std::chrono::milliseconds{500};
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<GameTextureAsset>> m_game_textures;
@@ -88,9 +119,17 @@ private:
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_assets_to_monitor;
 
+  std::map<const CustomAsset*, AssetEntry> m_assets;
+  // Both ordered by the last use, loaded from the back and evicted from the front
+  std::map<u64, const CustomAsset*> m_load_queue;
+  std::map<u64, const CustomAsset*> m_evictable_assets;
+  u64 m_use_counter = 0;
+
   // Use a recursive mutex to handle the scenario where an asset goes out of scope while
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
-  Common::WorkQueueThread<std::weak_ptr<CustomAsset>> m_asset_load_thread;
+  std::condition_variable_any m_asset_load_cv;
+  bool m_asset_load_shutdown = false;
+  std::vector<std::thread> m_asset_load_threads;
 };
 }  // namespace VideoCommon
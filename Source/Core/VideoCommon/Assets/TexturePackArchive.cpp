@@ -0,0 +1,301 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackArchive.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include <lz4.h>
+
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+
+namespace VideoCommon
+{
+static constexpr size_t ALIGNMENT = 8;
+// Larger than any texture a backend can make, small enough that the sizes below can't overflow
+static constexpr u32 MAX_LEVEL_DIMENSION = 1 << 16;
+
+// The backends upload a level with its row length, so its data has to cover every row of blocks
+static bool IsValidLevel(const TexturePackLevel& level)
+{
+  if (level.format >= AbstractTextureFormat::Undefined || level.width == 0 || level.height == 0 ||
+      level.row_length < level.width || level.row_length > MAX_LEVEL_DIMENSION ||
+      level.height > MAX_LEVEL_DIMENSION)
+  {
+    return false;
+  }
+
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(level.format);
+  const u64 block_rows = (level.height + block_size - 1) / block_size;
+  const u64 stride = AbstractTexture::CalculateStrideForFormat(level.format, level.row_length);
+  return level.size == stride * block_rows;
+}
+
+std::unique_ptr<TexturePackArchive> TexturePackArchive::Open(const std::string& path)
+{
+  auto archive = std::make_unique<TexturePackArchive>();
+  if (!archive->m_file.Open(path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' could not be opened", path);
+    return nullptr;
+  }
+
+  const u8* const data = archive->m_file.GetData();
+  const u64 size = archive->m_file.GetSize();
+  const auto is_in_file = [size](u64 offset, u64 length) {
+    return offset % ALIGNMENT == 0 && offset <= size && length <= size - offset;
+  };
+
+  TexturePackHeader header;
+  if (size < sizeof(header))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' is too small", path);
+    return nullptr;
+  }
+  std::memcpy(&header, data, sizeof(header));
+
+  if (header.magic != TexturePackHeader::MAGIC || header.version != TexturePackHeader::VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' has an unknown format", path);
+    return nullptr;
+  }
+
+  const u64 textures_size = u64{header.texture_count} * sizeof(TexturePackTexture);
+  const u64 levels_size = u64{header.level_count} * sizeof(TexturePackLevel);
+  if (!is_in_file(header.textures_offset, textures_size) ||
+      !is_in_file(header.levels_offset, levels_size) ||
+      !is_in_file(header.names_offset, header.names_size))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' has an invalid index", path);
+    return nullptr;
+  }
+
+  archive->m_textures = {
+      reinterpret_cast<const TexturePackTexture*>(data + header.textures_offset),
+      header.texture_count};
+  archive->m_levels = {reinterpret_cast<const TexturePackLevel*>(data + header.levels_offset),
+                       header.level_count};
+  archive->m_names = {reinterpret_cast<const char*>(data + header.names_offset),
+                      static_cast<size_t>(header.names_size)};
+
+  for (const TexturePackLevel& level : archive->m_levels)
+  {
+    if (!is_in_file(level.offset, level.compressed_size) || level.compressed_size > level.size ||
+        !IsValidLevel(level))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack '{}' has an invalid texture level", path);
+      return nullptr;
+    }
+  }
+
+  for (size_t i = 0; i < archive->m_textures.size(); ++i)
+  {
+    const TexturePackTexture& texture = archive->m_textures[i];
+    const bool valid_name = u64{texture.name_offset} + texture.name_length <= header.names_size;
+    const bool valid_levels = texture.level_count != 0 &&
+                              u64{texture.first_level} + texture.level_count <= header.level_count;
+    // Lookups are binary searches, so the names have to be sorted and unique
+    if (!valid_name || !valid_levels ||
+        (i != 0 && archive->GetTextureName(i - 1) >= archive->GetTextureName(i)))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack '{}' has an invalid texture entry", path);
+      return nullptr;
+    }
+  }
+
+  return archive;
+}
+
+std::string_view TexturePackArchive::GetTextureName(size_t index) const
+{
+  const TexturePackTexture& texture = m_textures[index];
+  return m_names.substr(texture.name_offset, texture.name_length);
+}
+
+bool TexturePackArchive::HasArbitraryMipmaps(size_t index) const
+{
+  return (m_textures[index].flags & TexturePackTexture::FLAG_ARBITRARY_MIPMAPS) != 0;
+}
+
+std::optional<size_t> TexturePackArchive::FindTexture(std::string_view name) const
+{
+  size_t first = 0;
+  size_t count = m_textures.size();
+  while (count > 0)
+  {
+    const size_t step = count / 2;
+    if (GetTextureName(first + step) < name)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  if (first == m_textures.size() || GetTextureName(first) != name)
+    return std::nullopt;
+  return first;
+}
+
+bool TexturePackArchive::LoadTexture(size_t index, CustomTextureData::ArraySlice* slice) const
+{
+  const TexturePackTexture& texture = m_textures[index];
+  slice->m_levels.resize(texture.level_count);
+
+  for (u32 i = 0; i < texture.level_count; ++i)
+  {
+    const TexturePackLevel& level = m_levels[texture.first_level + i];
+    CustomTextureData::ArraySlice::Level& out = slice->m_levels[i];
+    out.format = level.format;
+    out.width = level.width;
+    out.height = level.height;
+    out.row_length = level.row_length;
+    out.data.resize(level.size);
+
+    const u8* const src = m_file.GetData() + level.offset;
+    if (level.compressed_size == level.size)
+    {
+      std::memcpy(out.data.data(), src, level.size);
+      continue;
+    }
+
+    const int decompressed_size = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data.data()),
+        static_cast<int>(level.compressed_size), static_cast<int>(level.size));
+    if (decompressed_size != static_cast<int>(level.size))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture '{}' level {} in texture pack is corrupted",
+                    GetTextureName(index), i);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+TexturePackArchiveWriter::TexturePackArchiveWriter(const std::string& path) : m_file(path, "wb")
+{
+  // The header is written again with the location of the index when finishing
+  const TexturePackHeader header{};
+  if (m_file.IsOpen())
+    WriteAligned(&header, sizeof(header));
+}
+
+bool TexturePackArchiveWriter::AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                          const CustomTextureData::ArraySlice& slice)
+{
+  if (slice.m_levels.empty() || slice.m_levels.size() > std::numeric_limits<u16>::max())
+    return false;
+
+  PendingTexture texture{std::string(name),
+                         has_arbitrary_mipmaps ? TexturePackTexture::FLAG_ARBITRARY_MIPMAPS : u8{0},
+                         {}};
+
+  // Check all levels before writing any, so a rejected texture leaves nothing behind
+  for (const CustomTextureData::ArraySlice::Level& level : slice.m_levels)
+  {
+    TexturePackLevel packed_level{};
+    packed_level.size = static_cast<u32>(level.data.size());
+    packed_level.width = level.width;
+    packed_level.height = level.height;
+    packed_level.row_length = level.row_length;
+    packed_level.format = level.format;
+    if (level.data.size() > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+        !IsValidLevel(packed_level))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture '{}' has a level whose size doesn't match its dimensions",
+                    name);
+      return false;
+    }
+    texture.levels.push_back(packed_level);
+  }
+
+  std::vector<char> compressed;
+  for (size_t i = 0; i < slice.m_levels.size(); ++i)
+  {
+    const std::vector<u8>& data = slice.m_levels[i].data;
+    const int size = static_cast<int>(data.size());
+    compressed.resize(LZ4_compressBound(size));
+    const int compressed_size =
+        LZ4_compress_default(reinterpret_cast<const char*>(data.data()), compressed.data(), size,
+                             static_cast<int>(compressed.size()));
+
+    // Levels which don't get smaller, like most block compressed ones, are stored as they are
+    const bool store_compressed = compressed_size > 0 && compressed_size < size;
+    TexturePackLevel& packed_level = texture.levels[i];
+    packed_level.offset = m_offset;
+    packed_level.compressed_size = store_compressed ? compressed_size : size;
+
+    const void* const level_data =
+        store_compressed ? static_cast<const void*>(compressed.data()) : data.data();
+    if (!WriteAligned(level_data, packed_level.compressed_size))
+      return false;
+  }
+
+  m_textures.push_back(std::move(texture));
+  return true;
+}
+
+bool TexturePackArchiveWriter::Finish()
+{
+  std::sort(m_textures.begin(), m_textures.end(),
+            [](const PendingTexture& a, const PendingTexture& b) { return a.name < b.name; });
+
+  std::vector<TexturePackTexture> textures;
+  std::vector<TexturePackLevel> levels;
+  std::string names;
+  for (size_t i = 0; i < m_textures.size(); ++i)
+  {
+    const PendingTexture& texture = m_textures[i];
+    if (i != 0 && m_textures[i - 1].name == texture.name)
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture '{}' was added to the texture pack twice", texture.name);
+      return false;
+    }
+
+    textures.push_back({static_cast<u32>(names.size()), static_cast<u32>(texture.name.size()),
+                        static_cast<u32>(levels.size()),
+                        static_cast<u16>(texture.levels.size()), texture.flags, 0});
+    levels.insert(levels.end(), texture.levels.begin(), texture.levels.end());
+    names += texture.name;
+  }
+
+  TexturePackHeader header{};
+  header.magic = TexturePackHeader::MAGIC;
+  header.version = TexturePackHeader::VERSION;
+  header.texture_count = static_cast<u32>(textures.size());
+  header.level_count = static_cast<u32>(levels.size());
+
+  header.textures_offset = m_offset;
+  if (!WriteAligned(textures.data(), textures.size() * sizeof(TexturePackTexture)))
+    return false;
+  header.levels_offset = m_offset;
+  if (!WriteAligned(levels.data(), levels.size() * sizeof(TexturePackLevel)))
+    return false;
+  header.names_offset = m_offset;
+  header.names_size = names.size();
+  if (!WriteAligned(names.data(), names.size()))
+    return false;
+
+  return m_file.Seek(0, File::SeekOrigin::Begin) && m_file.WriteArray(&header, 1) &&
+         m_file.Close();
+}
+
+bool TexturePackArchiveWriter::WriteAligned(const void* data, size_t size)
+{
+  static constexpr std::array<u8, ALIGNMENT> padding{};
+  const size_t padding_size = (ALIGNMENT - size % ALIGNMENT) % ALIGNMENT;
+  if (!m_file.WriteBytes(data, size) || !m_file.WriteBytes(padding.data(), padding_size))
+    return false;
+
+  m_offset += size + padding_size;
+  return true;
+}
+}  // namespace VideoCommon
@@ -0,0 +1,114 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// A texture pack in a single file. The file starts with a header and the texture data, and ends
+// with an index of the textures sorted by name. Every texture stores its whole mip chain decoded,
+// one LZ4 compressed block per level, so loading a texture is a lookup and a decompression.
+struct TexturePackHeader
+{
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+
+  u32 magic;
+  u32 version;
+  u32 texture_count;
+  u32 level_count;
+  u64 textures_offset;
+  u64 levels_offset;
+  u64 names_offset;
+  u64 names_size;
+};
+static_assert(sizeof(TexturePackHeader) == 48);
+
+struct TexturePackTexture
+{
+  static constexpr u8 FLAG_ARBITRARY_MIPMAPS = 1;
+
+  u32 name_offset;
+  u32 name_length;
+  u32 first_level;
+  u16 level_count;
+  u8 flags;
+  u8 padding;
+};
+static_assert(sizeof(TexturePackTexture) == 16);
+
+struct TexturePackLevel
+{
+  u64 offset;
+  // Equal to the size if the level is stored uncompressed
+  u32 compressed_size;
+  u32 size;
+  u32 width;
+  u32 height;
+  u32 row_length;
+  AbstractTextureFormat format;
+};
+static_assert(sizeof(TexturePackLevel) == 32);
+
+class TexturePackArchive
+{
+public:
+  static constexpr std::string_view EXTENSION = ".dtp";
+
+  // Maps the archive and validates its index, without touching the texture data
+  static std::unique_ptr<TexturePackArchive> Open(const std::string& path);
+
+  size_t GetTextureCount() const { return m_textures.size(); }
+  std::string_view GetTextureName(size_t index) const;
+  bool HasArbitraryMipmaps(size_t index) const;
+  std::optional<size_t> FindTexture(std::string_view name) const;
+
+  // Decompresses all levels of a texture. Can be called from several threads at once.
+  bool LoadTexture(size_t index, CustomTextureData::ArraySlice* slice) const;
+
+private:
+  Common::MappedFile m_file;
+  std::span<const TexturePackTexture> m_textures;
+  std::span<const TexturePackLevel> m_levels;
+  std::string_view m_names;
+};
+
+// Writes the textures one at a time, then the index once all of them have been added
+class TexturePackArchiveWriter
+{
+public:
+  explicit TexturePackArchiveWriter(const std::string& path);
+
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  bool AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                  const CustomTextureData::ArraySlice& slice);
+  bool Finish();
+
+private:
+  struct PendingTexture
+  {
+    std::string name;
+    u8 flags;
+    std::vector<TexturePackLevel> levels;
+  };
+
+  bool WriteAligned(const void* data, size_t size);
+
+  File::IOFile m_file;
+  u64 m_offset = 0;
+  std::vector<PendingTexture> m_textures;
+};
+}  // namespace VideoCommon
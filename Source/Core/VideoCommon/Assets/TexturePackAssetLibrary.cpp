@@ -0,0 +1,73 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
+
+#include "Common/Logging/Log.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+#include "VideoCommon/RenderState.h"
+
+namespace VideoCommon
+{
+TexturePackAssetLibrary::TexturePackAssetLibrary() : m_creation_time(TimeType::clock::now())
+{
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                  TextureData* data)
+{
+  TextureLocation location;
+  {
+    std::lock_guard lk(m_lock);
+    const auto iter = m_assetid_to_texture.find(asset_id);
+    if (iter == m_assetid_to_texture.end())
+    {
+      ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in any texture pack!", asset_id);
+      return {};
+    }
+    location = iter->second;
+  }
+
+  data->m_type = TextureData::Type::Type_Texture2D;
+  data->m_sampler = RenderState::GetLinearSamplerState();
+  data->m_texture.m_slices.resize(1);
+
+  auto& slice = data->m_texture.m_slices[0];
+  if (!location.archive->LoadTexture(location.index, &slice))
+    return {};
+
+  std::size_t total = 0;
+  for (const auto& level : slice.m_levels)
+    total += level.data.size();
+
+  return LoadInfo{total, m_creation_time};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                      PixelShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't contain pixel shaders!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                   MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't contain materials!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType TexturePackAssetLibrary::GetLastAssetWriteTime(const AssetID&) const
+{
+  return m_creation_time;
+}
+
+void TexturePackAssetLibrary::SetAssetIDMapData(const AssetID& asset_id,
+                                                std::shared_ptr<const TexturePackArchive> archive,
+                                                std::size_t index)
+{
+  std::lock_guard lk(m_lock);
+  m_assetid_to_texture[asset_id] = TextureLocation{std::move(archive), index};
+}
+}  // namespace VideoCommon
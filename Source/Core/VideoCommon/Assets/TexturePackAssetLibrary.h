@@ -0,0 +1,46 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+
+namespace VideoCommon
+{
+class TexturePackArchive;
+
+// This class implements 'CustomAssetLibrary' and loads game textures from
+// texture pack archives, see 'TexturePackArchive'
+class TexturePackAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  TexturePackAssetLibrary();
+
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+
+  // Archives don't change while they are open, so this is the time the library was created
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+  // Makes the texture at the index of the archive loadable as the asset id
+  void SetAssetIDMapData(const AssetID& asset_id, std::shared_ptr<const TexturePackArchive> archive,
+                         std::size_t index);
+
+private:
+  struct TextureLocation
+  {
+    std::shared_ptr<const TexturePackArchive> archive;
+    std::size_t index;
+  };
+
+  const TimeType m_creation_time;
+
+  mutable std::mutex m_lock;
+  std::map<AssetID, TextureLocation> m_assetid_to_texture;
+};
+}  // namespace VideoCommon
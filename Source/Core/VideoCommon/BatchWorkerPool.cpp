@@ -0,0 +1,105 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/BatchWorkerPool.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+
+BatchWorkerPool::~BatchWorkerPool()
+{
+  Stop();
+}
+
+u32 BatchWorkerPool::GetDefaultWorkerCount()
+{
+  // Waking the workers costs a few microseconds, which only pays off with spare cores
+  const u32 host_threads = std::thread::hardware_concurrency();
+  return std::min(host_threads / 4, 3u);
+}
+
+void BatchWorkerPool::Start(u32 num_workers)
+{
+  Stop();
+
+  m_exit = false;
+  for (u32 i = 0; i < num_workers; ++i)
+    m_workers.emplace_back(&BatchWorkerPool::WorkerThread, this, i);
+}
+
+void BatchWorkerPool::Stop()
+{
+  if (m_workers.empty())
+    return;
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit = true;
+  }
+  m_work_cv.notify_all();
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void BatchWorkerPool::RunChunks(u32 num_chunks, void* context, ChunkFunction function)
+{
+  {
+    std::unique_lock lk(m_mutex);
+    // A worker which woke up too late for the previous job may still be looking at it
+    m_done_cv.wait(lk, [this] { return m_busy_workers == 0; });
+    m_context = context;
+    m_function = function;
+    m_num_chunks = num_chunks;
+    m_next_chunk.store(0, std::memory_order_relaxed);
+    m_pending_chunks.store(num_chunks, std::memory_order_relaxed);
+    ++m_generation;
+  }
+  m_work_cv.notify_all();
+
+  WorkOnChunks();
+
+  std::unique_lock lk(m_mutex);
+  m_done_cv.wait(lk, [this] { return m_pending_chunks.load(std::memory_order_acquire) == 0; });
+}
+
+void BatchWorkerPool::WorkOnChunks()
+{
+  u32 chunk;
+  while ((chunk = m_next_chunk.fetch_add(1, std::memory_order_relaxed)) < m_num_chunks)
+  {
+    m_function(m_context, chunk);
+    if (m_pending_chunks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      std::lock_guard lk(m_mutex);
+      m_done_cv.notify_all();
+    }
+  }
+}
+
+void BatchWorkerPool::WorkerThread(u32 index)
+{
+  Common::SetCurrentThreadName(fmt::format("Batch Worker {}", index).c_str());
+
+  u64 generation = 0;
+  std::unique_lock lk(m_mutex);
+  while (true)
+  {
+    m_work_cv.wait(lk, [&] { return m_exit || m_generation != generation; });
+    if (m_exit)
+      return;
+
+    generation = m_generation;
+    ++m_busy_workers;
+    lk.unlock();
+
+    WorkOnChunks();
+
+    lk.lock();
+    if (--m_busy_workers == 0)
+      m_done_cv.notify_all();
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A few threads which help the video thread with large batches of vertices. Run() splits the work
+// into chunks and returns once all of them are done, so the callers merge the results of the
+// chunks in order and stay deterministic. The calling thread works on chunks too.
+class BatchWorkerPool
+{
+public:
+  BatchWorkerPool() = default;
+  ~BatchWorkerPool();
+
+  BatchWorkerPool(const BatchWorkerPool&) = delete;
+  BatchWorkerPool& operator=(const BatchWorkerPool&) = delete;
+
+  // Picks the worker count from the number of host threads, leaving the CPU and GPU threads alone
+  static u32 GetDefaultWorkerCount();
+
+  void Start(u32 num_workers);
+  void Stop();
+
+  // Without workers, Run() calls the function for every chunk on the calling thread
+  u32 GetWorkerCount() const { return static_cast<u32>(m_workers.size()); }
+
+  // Calls function(chunk) for every chunk in [0, num_chunks), in no particular order
+  template <typename F>
+  void Run(u32 num_chunks, F&& function)
+  {
+    if (m_workers.empty() || num_chunks < 2)
+    {
+      for (u32 chunk = 0; chunk < num_chunks; ++chunk)
+        function(chunk);
+      return;
+    }
+
+    using Function = std::remove_reference_t<F>;
+    RunChunks(num_chunks, const_cast<void*>(static_cast<const void*>(&function)),
+              [](void* context, u32 chunk) { (*static_cast<Function*>(context))(chunk); });
+  }
+
+private:
+  using ChunkFunction = void (*)(void*, u32);
+
+  void RunChunks(u32 num_chunks, void* context, ChunkFunction function);
+  void WorkOnChunks();
+  void WorkerThread(u32 index);
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  u64 m_generation = 0;
+  u32 m_busy_workers = 0;
+  bool m_exit = false;
+
+  // The current job. Only written while no worker is busy.
+  void* m_context = nullptr;
+  ChunkFunction m_function = nullptr;
+  u32 m_num_chunks = 0;
+  std::atomic<u32> m_next_chunk = 0;
+  std::atomic<u32> m_pending_chunks = 0;
+};
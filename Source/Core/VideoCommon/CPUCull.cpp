@@ -3,6 +3,9 @@
 
 #include "VideoCommon/CPUCull.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
 #include "Common/MathUtil.h"
@@ -54,10 +57,14 @@
 #include "VideoCommon/CPUCullImpl.h"
 #define USE_FMA
 #include "VideoCommon/CPUCullImpl.h"
+#define USE_AVX2
+#include "VideoCommon/CPUCullImpl.h"
 #endif
 
 #if defined(USE_SSE)
-#if defined(__AVX__) && defined(__FMA__)
+#if defined(__AVX2__) && defined(__FMA__)
+static constexpr int MIN_SSE = 52;
+#elif defined(__AVX__) && defined(__FMA__)
 static constexpr int MIN_SSE = 51;
 #elif defined(__AVX__)
 static constexpr int MIN_SSE = 50;
@@ -74,7 +81,9 @@ template <bool PositionHas3Elems, bool PerVertexPosMtx>
 static CPUCull::TransformFunction GetTransformFunction()
 {
 #if defined(USE_SSE)
-  if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
+  if (MIN_SSE >= 52 || (cpu_info.bAVX2 && cpu_info.bFMA))
+    return CPUCull_AVX2::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+  else if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
     return CPUCull_FMA::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
   else if (MIN_SSE >= 50 || cpu_info.bAVX)
     return CPUCull_AVX::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
@@ -121,10 +130,14 @@ static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
   };
 }
 
+// Below this, waking up the workers takes longer than transforming the vertices
+static constexpr u32 MIN_PARALLEL_VERTICES = 4096;
+
 CPUCull::~CPUCull() = default;
 
-void CPUCull::Init()
+void CPUCull::Init(BatchWorkerPool* workers)
 {
+  m_workers = workers;
   m_transform_table[false][false] = GetTransformFunction<false, false>();
   m_transform_table[false][true] = GetTransformFunction<false, true>();
   m_transform_table[true][false] = GetTransformFunction<true, false>();
@@ -164,9 +177,66 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
     cullmode = cullmode_invert[cullmode];
   const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
+  if (count >= MIN_PARALLEL_VERTICES && m_workers && m_workers->GetWorkerCount() != 0)
+  {
+    TransformParallel(transform, src, stride, count);
+    return AreAllTransformedVerticesCulledParallel(m_transform_buffer.get(), count, primitive,
+                                                   cullmode);
+  }
+
   transform(m_transform_buffer.get(), src, stride, count);
-  const CullFunction cull = m_cull_table[primitive][cullmode];
-  return cull(m_transform_buffer.get(), count);
+  return AreAllTransformedVerticesCulled(m_transform_buffer.get(), count, primitive, cullmode);
+}
+
+bool CPUCull::AreAllTransformedVerticesCulled(const TransformedVertex* transformed, u32 count,
+                                              OpcodeDecoder::Primitive primitive,
+                                              CullMode mode) const
+{
+  const CullFunction cull = m_cull_table[primitive][mode];
+  return cull(transformed, count);
+}
+
+void CPUCull::TransformParallel(TransformFunction transform, const u8* src, u32 stride, u32 count)
+{
+  TransformedVertex* const transformed = m_transform_buffer.get();
+  const u32 num_chunks = (count + CHUNK_VERTICES - 1) / CHUNK_VERTICES;
+  m_workers->Run(num_chunks, [&](u32 chunk) {
+    const u32 first = chunk * CHUNK_VERTICES;
+    transform(transformed + first, src + first * stride, stride,
+              std::min(CHUNK_VERTICES, count - first));
+  });
+}
+
+bool CPUCull::AreAllTransformedVerticesCulledParallel(const TransformedVertex* transformed,
+                                                      u32 count,
+                                                      OpcodeDecoder::Primitive primitive,
+                                                      CullMode mode) const
+{
+  const CullFunction cull = m_cull_table[primitive][mode];
+  using Prim = OpcodeDecoder::Primitive;
+  // Fans share their first vertex between all triangles, so only their transform is split up
+  if (!m_workers || primitive == Prim::GX_DRAW_TRIANGLE_FAN)
+    return cull(transformed, count);
+
+  const u32 num_chunks = (count + CHUNK_VERTICES - 1) / CHUNK_VERTICES;
+
+  // Every chunk starts on a primitive boundary: chunks of lists and quads hold whole primitives,
+  // and the chunks of a strip overlap by two vertices and start on an even vertex, so the winding
+  // of their triangles matches the whole strip. The remainder of the batch stays in the last
+  // chunk, where the cull functions deal with it like they do for the whole batch.
+  std::atomic<bool> visible = false;
+  m_workers->Run(num_chunks, [&](u32 chunk) {
+    if (visible.load(std::memory_order_relaxed))
+      return;
+
+    const u32 first = chunk * CHUNK_VERTICES;
+    u32 chunk_count = chunk == num_chunks - 1 ? count - first : CHUNK_VERTICES;
+    if (primitive == Prim::GX_DRAW_TRIANGLE_STRIP)
+      chunk_count = std::min(chunk_count + 2, count - first);
+    if (!cull(transformed + first, chunk_count))
+      visible.store(true, std::memory_order_relaxed);
+  });
+  return !visible.load(std::memory_order_relaxed);
 }
 
 template <typename T>
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BatchWorkerPool.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
 
@@ -11,7 +12,8 @@ class CPUCull
 {
 public:
   ~CPUCull();
-  void Init();
+  // Large batches are split between the workers of the pool, if there are any
+  void Init(BatchWorkerPool* workers);
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
 
@@ -23,7 +25,22 @@ public:
   using TransformFunction = void (*)(void*, const void*, u32, int);
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
 
+  // The size of the chunks of parallel batches. A multiple of 3 and 4, so that the chunks of
+  // lists and quads hold whole primitives.
+  static constexpr u32 CHUNK_VERTICES = 1536;
+
+  // The cull steps of AreAllVerticesCulled, for vertices which are already transformed. The
+  // parallel one splits the batch into chunks between the workers, whatever its size, and gives
+  // the same result as culling the whole batch at once.
+  bool AreAllTransformedVerticesCulled(const TransformedVertex* transformed, u32 count,
+                                       OpcodeDecoder::Primitive primitive, CullMode mode) const;
+  bool AreAllTransformedVerticesCulledParallel(const TransformedVertex* transformed, u32 count,
+                                               OpcodeDecoder::Primitive primitive,
+                                               CullMode mode) const;
+
 private:
+  void TransformParallel(TransformFunction transform, const u8* src, u32 stride, u32 count);
+
   template <typename T>
   struct BufferDeleter
   {
@@ -35,4 +52,5 @@ private:
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
       m_cull_table{};
+  BatchWorkerPool* m_workers = nullptr;
 };
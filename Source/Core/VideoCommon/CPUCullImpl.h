@@ -1,7 +1,9 @@
 // Copyright 2022 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#if defined(USE_FMA)
+#if defined(USE_AVX2)
+#define VECTOR_NAMESPACE CPUCull_AVX2
+#elif defined(USE_FMA)
 #define VECTOR_NAMESPACE CPUCull_FMA
 #elif defined(USE_AVX)
 #define VECTOR_NAMESPACE CPUCull_AVX
@@ -19,7 +21,9 @@
 #error This file is meant to be used by CPUCull.cpp only!
 #endif
 
-#if defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
+#if defined(__GNUC__) && defined(USE_AVX2) && !(defined(__AVX2__) && defined(__FMA__))
+#define ATTR_TARGET __attribute__((target("avx2,fma")))
+#elif defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
 #define ATTR_TARGET __attribute__((target("avx,fma")))
 #elif defined(__GNUC__) && defined(USE_AVX) && !defined(__AVX__)
 #define ATTR_TARGET __attribute__((target("avx")))
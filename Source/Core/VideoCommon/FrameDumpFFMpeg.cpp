@@ -7,9 +7,11 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
 #include <array>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -50,6 +52,8 @@ struct FrameDumpContext
   AVFrame* src_frame = nullptr;
   AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
+  int sws_width = 0;
+  int sws_height = 0;
 
   s64 last_pts = AV_NOPTS_VALUE;
 
@@ -151,6 +155,39 @@ std::string GetDumpPath(const std::string& extension, std::time_t time, u32 inde
   return path;
 }
 
+// Conversion and encoding each get a few threads, leaving the rest of the CPU to emulation.
+int GetFrameDumpThreadCount()
+{
+  return static_cast<int>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+}
+
+SwsContext* CreateScaler(int src_width, int src_height, AVPixelFormat src_format, int dst_width,
+                         int dst_height, AVPixelFormat dst_format)
+{
+  SwsContext* const sws = sws_alloc_context();
+  if (!sws)
+    return nullptr;
+
+  av_opt_set_int(sws, "srcw", src_width, 0);
+  av_opt_set_int(sws, "srch", src_height, 0);
+  av_opt_set_int(sws, "src_format", src_format, 0);
+  av_opt_set_int(sws, "dstw", dst_width, 0);
+  av_opt_set_int(sws, "dsth", dst_height, 0);
+  av_opt_set_int(sws, "dst_format", dst_format, 0);
+  av_opt_set_int(sws, "sws_flags", SWS_BICUBIC, 0);
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+  // Older versions don't have the option and convert on the calling thread.
+  av_opt_set_int(sws, "threads", GetFrameDumpThreadCount(), 0);
+#endif
+
+  if (sws_init_context(sws, nullptr, nullptr) < 0)
+  {
+    sws_freeContext(sws);
+    return nullptr;
+  }
+  return sws;
+}
+
 std::string AVErrorString(int error)
 {
   std::array<char, AV_ERROR_MAX_STRING_SIZE> msg;
@@ -264,6 +301,10 @@ bool FFMpegFrameDump::CreateVideoFile()
   m_context->codec->time_base = time_base;
   m_context->codec->gop_size = 1;
   m_context->codec->level = 1;
+  // Encoders which support it work on several frames at once, so that a slow encoder only adds
+  // latency to the dump instead of holding up the next frame.
+  m_context->codec->thread_count = GetFrameDumpThreadCount();
+  m_context->codec->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
 
   AVPixelFormat pix_fmt = AV_PIX_FMT_NONE;
 
@@ -381,17 +422,37 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
   m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
   m_context->src_frame->linesize[0] = frame.stride;
   m_context->src_frame->format = pix_fmt;
-  m_context->src_frame->width = m_context->width;
-  m_context->src_frame->height = m_context->height;
+  m_context->src_frame->width = frame.width;
+  m_context->src_frame->height = frame.height;
+
+  // With frame threading the encoder may still reference the previous frame's buffer, in which
+  // case this allocates a new one instead of overwriting it.
+  if (const int error = av_frame_make_writable(m_context->scaled_frame))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not make frame writable: {}", AVErrorString(error));
+    return;
+  }
 
   // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+  if (!m_context->sws || m_context->sws_width != frame.width ||
+      m_context->sws_height != frame.height)
+  {
+    if (m_context->sws)
+      sws_freeContext(m_context->sws);
+    m_context->sws = CreateScaler(frame.width, frame.height, pix_fmt, m_context->width,
+                                  m_context->height, m_context->codec->pix_fmt);
+    m_context->sws_width = frame.width;
+    m_context->sws_height = frame.height;
+  }
   if (m_context->sws)
   {
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+    // Only the frame API splits the conversion across the scaler's threads.
+    sws_scale_frame(m_context->sws, m_context->scaled_frame, m_context->src_frame);
+#else
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
               frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+#endif
   }
 
   m_context->last_pts = pts;
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -15,6 +17,7 @@
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -41,6 +44,18 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
                                    const MathUtil::Rectangle<int>& target_rect, u64 ticks,
                                    int frame_number)
 {
+  ReleaseEncodedBuffers();
+
+  // The buffer after the last one read back is the oldest. If it's still waiting for the dump
+  // thread, so are all the others.
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[m_frame_dump_next_buffer];
+  if (buffer.mapped || std::find(m_frame_dump_readbacks.begin(), m_frame_dump_readbacks.end(),
+                                 &buffer) != m_frame_dump_readbacks.end())
+  {
+    g_perf_metrics.CountDroppedFrameDumpFrame();
+    return;
+  }
+
   int source_width = src_rect.GetWidth();
   int source_height = src_rect.GetHeight();
   int target_width = target_rect.GetWidth();
@@ -59,13 +74,14 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  if (!CheckFrameDumpReadbackTexture(buffer, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  buffer.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, buffer.texture->GetRect());
+  buffer.state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  buffer.readback_time = Clock::now();
+  m_frame_dump_readbacks.push_back(&buffer);
+  m_frame_dump_next_buffer = (m_frame_dump_next_buffer + 1) % FRAME_DUMP_BUFFER_COUNT;
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -96,9 +112,10 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool FrameDumper::CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                                u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = buffer.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -115,156 +132,146 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
 
 void FrameDumper::FlushFrameDump()
 {
-  if (!m_frame_dump_needs_flush)
+  if (m_frame_dump_readbacks.empty())
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
-
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
-  {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
-
-  m_frame_dump_needs_flush = false;
+  // Screenshots are taken from the newest frame, which may be the last one when paused.
+  QueueReadbacks(!Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES) || m_screenshot_request.IsSet());
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
     ShutdownFrameDumping();
 }
 
-void FrameDumper::ShutdownFrameDumping()
+void FrameDumper::QueueReadbacks(bool all)
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
-
-  if (!m_frame_dump_thread_running.IsSet())
-    return;
+  while (m_frame_dump_readbacks.size() > (all ? 0 : 1))
+  {
+    FrameDumpBuffer& buffer = *m_frame_dump_readbacks.front();
+    m_frame_dump_readbacks.pop_front();
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+    AbstractStagingTexture* const texture = buffer.texture.get();
+    texture->Flush();
+    if (!texture->Map())
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+      continue;
+    }
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
-  m_frame_dump_render_framebuffer.reset();
-  m_frame_dump_render_texture.reset();
+    if (!m_frame_dump_thread_running)
+    {
+      m_dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
+      m_frame_dump_started = false;
+      m_frame_dump_thread.Reset("FrameDumping", [this](const QueuedFrame& queued_frame) {
+        DumpQueuedFrame(queued_frame);
+      });
+      m_frame_dump_thread_running = true;
+    }
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+    buffer.mapped = true;
+    buffer.encoding.store(true, std::memory_order_relaxed);
+    const FrameData frame{reinterpret_cast<u8*>(texture->GetMappedPointer()),
+                          texture->GetConfig().width, texture->GetConfig().height,
+                          static_cast<int>(texture->GetMappedStride()), buffer.state};
+    m_frame_dump_thread.Push(QueuedFrame{frame, &buffer});
+  }
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::ReleaseEncodedBuffers()
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
-
-  if (!m_frame_dump_thread_running.IsSet())
+  for (FrameDumpBuffer& buffer : m_frame_dump_buffers)
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+    if (buffer.mapped && !buffer.encoding.load(std::memory_order_acquire))
+    {
+      buffer.texture->Unmap();
+      buffer.mapped = false;
+    }
   }
-
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
 }
 
-void FrameDumper::FinishFrameData()
+void FrameDumper::ShutdownFrameDumping()
 {
-  if (!m_frame_dump_frame_running)
+  // Ensure the last readbacks have been sent to the encoder.
+  QueueReadbacks(true);
+
+  if (!m_frame_dump_thread_running)
     return;
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  // Encode the remaining frames and wait for the thread to exit.
+  m_frame_dump_thread.Shutdown();
+  m_frame_dump_thread_running = false;
 
-  m_frame_dump_output_texture->Unmap();
+  if (m_frame_dump_started)
+  {
+    // No additional cleanup is needed when dumping to images.
+    if (m_dump_to_ffmpeg)
+      StopFrameDumpToFFMPEG();
+    m_frame_dump_started = false;
+  }
+
+  m_frame_dump_render_framebuffer.reset();
+  m_frame_dump_render_texture.reset();
+
+  ReleaseEncodedBuffers();
+  for (FrameDumpBuffer& buffer : m_frame_dump_buffers)
+    buffer.texture.reset();
+  m_frame_dump_next_buffer = 0;
 }
 
-void FrameDumper::FrameDumpThreadFunc()
+void FrameDumper::DumpQueuedFrame(const QueuedFrame& queued_frame)
 {
-  Common::SetCurrentThreadName("FrameDumping");
-
-  bool dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
-  bool frame_dump_started = false;
+  const FrameData& frame = queued_frame.frame;
 
 // If Dolphin was compiled without ffmpeg, we only support dumping to images.
 #if !defined(HAVE_FFMPEG)
-  if (dump_to_ffmpeg)
+  if (m_dump_to_ffmpeg)
   {
     WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
                         "Frames will be saved as PNG images instead.");
-    dump_to_ffmpeg = false;
+    m_dump_to_ffmpeg = false;
   }
 #endif
 
-  while (true)
+  // Save screenshot
+  if (m_screenshot_request.TestAndClear())
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-    auto frame = m_frame_dump_data;
+    if (DumpFrameToPNG(frame, m_screenshot_name))
+      OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
-    {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+    // Reset settings
+    m_screenshot_name.clear();
+    m_screenshot_completed.Set();
+  }
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+  {
+    if (!m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        m_frame_dump_started = StartFrameDumpToFFMPEG(frame);
+      else
+        m_frame_dump_started = StartFrameDumpToImage(frame);
+
+      // Stop frame dumping if we fail to start.
+      if (!m_frame_dump_started)
+        Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
     }
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+    // If we failed to start frame dumping, don't write a frame.
+    if (m_frame_dump_started)
     {
-      if (!frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
-      }
-
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
-      }
-    }
+      if (m_dump_to_ffmpeg)
+        DumpFrameToFFMPEG(frame);
+      else
+        DumpFrameToImage(frame);
 
-    m_frame_dump_done.Set();
+      g_perf_metrics.CountFrameDumpFrame(Clock::now() - queued_frame.buffer->readback_time);
+    }
   }
 
-  if (frame_dump_started)
-  {
-    // No additional cleanup is needed when dumping to images.
-    if (dump_to_ffmpeg)
-      StopFrameDumpToFFMPEG();
-  }
+  queued_frame.buffer->encoding.store(false, std::memory_order_release);
 }
 
 #if defined(HAVE_FFMPEG)
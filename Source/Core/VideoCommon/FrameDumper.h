@@ -3,11 +3,16 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <deque>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -22,10 +27,12 @@ public:
   FrameDumper();
   ~FrameDumper();
 
-  // Ensures all rendered frames are queued for encoding.
+  // Queues the frames read back so far for encoding. While dumping a movie, the newest readback
+  // is left in flight until the next frame so that mapping it doesn't wait for the GPU.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Reads the current XFB texture back into a free frame dump staging texture, or drops the
+  // frame if the encoder has fallen too far behind.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -37,8 +44,28 @@ public:
   void DoState(PointerWrap& p);
 
 private:
+  // Frames are read back into a ring of staging textures. A texture stays mapped while the dump
+  // thread encodes it, and frames are dropped instead of stalling when all of them are in use.
+  static constexpr size_t FRAME_DUMP_BUFFER_COUNT = 6;
+
+  struct FrameDumpBuffer
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+    TimePoint readback_time;
+    bool mapped = false;
+    // Cleared by the dump thread once the frame has been encoded.
+    std::atomic<bool> encoding = false;
+  };
+
+  struct QueuedFrame
+  {
+    FrameData frame;
+    FrameDumpBuffer* buffer;
+  };
+
   // NOTE: The methods below are called on the framedumping thread.
-  void FrameDumpThreadFunc();
+  void DumpQueuedFrame(const QueuedFrame& queued_frame);
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
@@ -52,40 +79,31 @@ private:
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
   // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
-
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
-
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
-
-  std::thread m_frame_dump_thread;
-  Common::Flag m_frame_dump_thread_running;
+  bool CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width, u32 target_height);
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  // Sends the buffers with finished readbacks to the dump thread, keeping the newest readback
+  // in flight for another frame unless `all` is set.
+  void QueueReadbacks(bool all);
 
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
+  // Unmaps the buffers the dump thread is done with, making them available for readbacks.
+  void ReleaseEncodedBuffers();
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
+  Common::WorkQueueThread<QueuedFrame> m_frame_dump_thread;
+  bool m_frame_dump_thread_running = false;
 
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Only used on the dump thread.
+  bool m_dump_to_ffmpeg = false;
+  bool m_frame_dump_started = false;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  std::array<FrameDumpBuffer, FRAME_DUMP_BUFFER_COUNT> m_frame_dump_buffers;
+  // The next buffer to read back into. Buffers are encoded in order, so this is the oldest one.
+  size_t m_frame_dump_next_buffer = 0;
+  // Buffers holding readbacks which haven't been sent to the dump thread yet, oldest first.
+  std::deque<FrameDumpBuffer*> m_frame_dump_readbacks;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
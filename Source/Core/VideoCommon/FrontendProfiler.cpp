@@ -0,0 +1,75 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrontendProfiler.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include "Common/HookableEvent.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace FrontendProfiler
+{
+namespace detail
+{
+bool s_enabled = false;
+}
+
+using Clock = std::chrono::steady_clock;
+
+// Sections are timed on the GPU thread, but the frames are taken by the host
+static Common::EnumMap<std::atomic<u64>, Section::ShaderUid> s_section_ns;
+static Clock::time_point s_frame_start;
+static std::mutex s_frames_lock;
+static std::vector<FrameTimes> s_frames;
+
+static Common::EventHook s_after_frame_event = AfterFrameEvent::Register(
+    [](Core::System&) {
+      if (detail::s_enabled)
+        EndFrame();
+    },
+    "FrontendProfiler::EndFrame");
+
+void SetEnabled(bool enabled)
+{
+  detail::s_enabled = enabled;
+  for (std::atomic<u64>& time : s_section_ns)
+    time.store(0, std::memory_order_relaxed);
+  s_frame_start = Clock::now();
+
+  std::lock_guard lk(s_frames_lock);
+  s_frames.clear();
+}
+
+void EndFrame()
+{
+  const Clock::time_point now = Clock::now();
+
+  FrameTimes frame;
+  frame.total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - s_frame_start).count();
+  for (size_t i = 0; i < s_section_ns.size(); ++i)
+  {
+    const auto section = static_cast<Section>(i);
+    frame.section_ns[section] = s_section_ns[section].exchange(0, std::memory_order_relaxed);
+  }
+  s_frame_start = now;
+
+  std::lock_guard lk(s_frames_lock);
+  s_frames.push_back(frame);
+}
+
+std::vector<FrameTimes> TakeFrames()
+{
+  std::lock_guard lk(s_frames_lock);
+  return std::exchange(s_frames, {});
+}
+
+void AddTime(Section section, Clock::duration time)
+{
+  s_section_ns[section].fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+      std::memory_order_relaxed);
+}
+}  // namespace FrontendProfiler
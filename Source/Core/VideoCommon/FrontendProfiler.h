@@ -0,0 +1,67 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
+
+// Measures how long the video frontend spends in its hot paths every frame, for benchmarking
+// FIFO logs. The sections can nest: the opcode decoder time includes the time of the others.
+namespace FrontendProfiler
+{
+enum class Section
+{
+  OpcodeDecoder,
+  RunVertices,
+  TextureDecode,
+  ShaderUid,
+};
+
+struct FrameTimes
+{
+  // Time between the ends of this frame and the previous one
+  u64 total_ns = 0;
+  Common::EnumMap<u64, Section::ShaderUid> section_ns{};
+};
+
+// Only change this while no video thread is running
+void SetEnabled(bool enabled);
+
+// Closes the current frame. Called after every frame when enabled.
+void EndFrame();
+// Takes the times of the frames closed so far
+std::vector<FrameTimes> TakeFrames();
+
+void AddTime(Section section, std::chrono::steady_clock::duration time);
+
+namespace detail
+{
+extern bool s_enabled;
+}
+
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(Section section) : m_section(section)
+  {
+    if (detail::s_enabled) [[unlikely]]
+      m_start = std::chrono::steady_clock::now();
+  }
+  ~ScopedTimer()
+  {
+    if (detail::s_enabled) [[unlikely]]
+      AddTime(m_section, std::chrono::steady_clock::now() - m_start);
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  Section m_section;
+  std::chrono::steady_clock::time_point m_start;
+};
+}  // namespace FrontendProfiler
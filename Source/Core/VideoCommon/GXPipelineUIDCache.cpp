@@ -0,0 +1,75 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/GXPipelineUIDCache.h"
+
+#include <cstring>
+#include <set>
+
+#include "Common/IOFile.h"
+
+namespace VideoCommon
+{
+namespace
+{
+// The serialized UIDs are packed and have their padding zeroed, so the bytes identify them
+struct SerializedUidLess
+{
+  bool operator()(const SerializedGXPipelineUid* a, const SerializedGXPipelineUid* b) const
+  {
+    return std::memcmp(a, b, sizeof(SerializedGXPipelineUid)) < 0;
+  }
+};
+}  // namespace
+
+std::optional<std::vector<SerializedGXPipelineUid>> ReadGXPipelineUIDCache(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  u32 magic;
+  u32 version;
+  if (!file.ReadArray(&magic, 1) || !file.ReadArray(&version, 1) ||
+      magic != GX_PIPELINE_UID_CACHE_MAGIC || version != GX_PIPELINE_UID_VERSION)
+  {
+    return std::nullopt;
+  }
+
+  const u64 file_size = file.GetSize();
+  std::vector<SerializedGXPipelineUid> uids(
+      static_cast<size_t>((file_size - GX_PIPELINE_UID_CACHE_HEADER_SIZE) /
+                          sizeof(SerializedGXPipelineUid)));
+  if (!file.ReadArray(uids.data(), uids.size()))
+    return std::nullopt;
+
+  return uids;
+}
+
+bool WriteGXPipelineUIDCache(const std::string& path,
+                             std::span<const SerializedGXPipelineUid> uids)
+{
+  File::IOFile file(path, "wb");
+  return file.WriteArray(&GX_PIPELINE_UID_CACHE_MAGIC, 1) &&
+         file.WriteArray(&GX_PIPELINE_UID_VERSION, 1) && file.WriteArray(uids.data(), uids.size());
+}
+
+size_t MergeGXPipelineUIDs(std::vector<SerializedGXPipelineUid>* out,
+                           std::span<const SerializedGXPipelineUid> uids)
+{
+  // Reserving first keeps the pointers into `out` valid while appending
+  out->reserve(out->size() + uids.size());
+  std::set<const SerializedGXPipelineUid*, SerializedUidLess> known;
+  for (const SerializedGXPipelineUid& uid : *out)
+    known.insert(&uid);
+
+  const size_t old_size = out->size();
+  for (const SerializedGXPipelineUid& uid : uids)
+  {
+    if (known.contains(&uid))
+      continue;
+
+    out->push_back(uid);
+    known.insert(&out->back());
+  }
+
+  return out->size() - old_size;
+}
+}  // namespace VideoCommon
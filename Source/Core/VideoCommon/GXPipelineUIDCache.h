@@ -0,0 +1,34 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GXPipelineTypes.h"
+
+namespace VideoCommon
+{
+// A pipeline UID cache lists the GX pipelines a game has used, so they can be compiled before
+// they are drawn. The file is a magic number and GX_PIPELINE_UID_VERSION followed by the
+// serialized UIDs. Nothing in it depends on the backend or the GPU, so the caches of different
+// users can be merged into one and shipped with Dolphin.
+constexpr u32 GX_PIPELINE_UID_CACHE_MAGIC = 0x44495550;  // PUID
+constexpr size_t GX_PIPELINE_UID_CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+constexpr std::string_view GX_PIPELINE_UID_CACHE_EXTENSION = ".uidcache";
+
+// Returns nothing if the file can't be read or is from another UID version. A partially
+// written last UID, like after a crash, is ignored.
+std::optional<std::vector<SerializedGXPipelineUid>>
+ReadGXPipelineUIDCache(const std::string& path);
+bool WriteGXPipelineUIDCache(const std::string& path,
+                             std::span<const SerializedGXPipelineUid> uids);
+
+// Appends the UIDs which aren't in `out` yet, in order. Returns how many were appended.
+size_t MergeGXPipelineUIDs(std::vector<SerializedGXPipelineUid>* out,
+                           std::span<const SerializedGXPipelineUid> uids);
+}  // namespace VideoCommon
@@ -27,6 +27,8 @@
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 #include <Common/MsgHandler.h>
@@ -34,16 +36,35 @@
 constexpr std::string_view s_format_prefix{"tex1_"};
 
 static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_texture_cache;
-static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
+
+namespace
+{
+struct HiresTextureEntry
+{
+  bool has_arbitrary_mipmaps;
+  // Whether the texture is loaded from a texture pack archive instead of a loose file
+  bool from_pack;
+};
+}  // namespace
+
+static std::unordered_map<std::string, HiresTextureEntry> s_hires_texture_id_to_arbmipmap;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+static auto s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 
 namespace
 {
-std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
+std::shared_ptr<VideoCommon::CustomAssetLibrary> GetLibrary(const HiresTextureEntry& entry)
+{
+  if (entry.from_pack)
+    return s_pack_library;
+  return s_file_library;
+}
+
+std::pair<std::string, HiresTextureEntry> GetNameArbPair(const TextureInfo& texture_info)
 {
   if (s_hires_texture_id_to_arbmipmap.empty())
-    return {"", false};
+    return {"", {}};
 
   const auto texture_name_details = texture_info.CalculateTextureName();
   // look for an exact match first
@@ -74,7 +95,46 @@ std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
     return {texture_name_single_wildcard_tex, iter->second};
   }
 
-  return {"", false};
+  return {"", {}};
+}
+
+// Adds the textures of the archive next to a texture directory, if there is one. Loose files
+// take precedence, so single textures of a pack can still be replaced while editing it.
+void AddTexturePackArchive(const std::string& texture_directory)
+{
+  const std::string archive_path =
+      texture_directory + std::string(VideoCommon::TexturePackArchive::EXTENSION);
+  if (!File::Exists(archive_path))
+    return;
+
+  std::shared_ptr<const VideoCommon::TexturePackArchive> archive =
+      VideoCommon::TexturePackArchive::Open(archive_path);
+  if (!archive)
+    return;
+
+  auto& system = Core::System::GetInstance();
+  for (std::size_t i = 0; i < archive->GetTextureCount(); ++i)
+  {
+    std::string name(archive->GetTextureName(i));
+    const bool has_arbitrary_mipmaps = archive->HasArbitraryMipmaps(i);
+    const auto [it, inserted] = s_hires_texture_id_to_arbmipmap.try_emplace(
+        name, HiresTextureEntry{has_arbitrary_mipmaps, true});
+    if (!inserted)
+      continue;
+
+    s_pack_library->SetAssetIDMapData(name, archive, i);
+
+    if (g_ActiveConfig.bCacheHiresTextures)
+    {
+      auto hires_texture = std::make_shared<HiresTexture>(
+          has_arbitrary_mipmaps,
+          system.GetCustomAssetLoader().LoadGameTexture(name, s_pack_library));
+      s_hires_texture_cache.try_emplace(std::move(name), std::move(hires_texture));
+    }
+  }
+
+  INFO_LOG_FMT(VIDEO, "Found {} textures in texture pack '{}'", archive->GetTextureCount(),
+               archive_path);
 }
 }  // namespace
 
@@ -121,8 +181,8 @@ void HiresTexture::Update()
         if (has_arbitrary_mipmaps)
           filename.erase(arb_index, 4);
 
-        const auto [it, inserted] =
-            s_hires_texture_id_to_arbmipmap.try_emplace(filename, has_arbitrary_mipmaps);
+        const auto [it, inserted] = s_hires_texture_id_to_arbmipmap.try_emplace(
+            filename, HiresTextureEntry{has_arbitrary_mipmaps, false});
         if (!inserted)
         {
           failed_insert = true;
@@ -150,6 +210,8 @@ void HiresTexture::Update()
       ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted",
                     texture_directory);
     }
+
+    AddTexturePackArchive(texture_directory);
   }
 
   if (g_ActiveConfig.bCacheHiresTextures)
@@ -169,24 +231,27 @@ void HiresTexture::Clear()
   s_hires_texture_cache.clear();
   s_hires_texture_id_to_arbmipmap.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
 {
-  const auto [base_filename, has_arb_mipmaps] = GetNameArbPair(texture_info);
+  const auto [base_filename, entry] = GetNameArbPair(texture_info);
   if (base_filename == "")
     return nullptr;
 
+  auto& system = Core::System::GetInstance();
   if (auto iter = s_hires_texture_cache.find(base_filename); iter != s_hires_texture_cache.end())
   {
+    // Requesting the asset again keeps it from being evicted, or reloads it if it was
+    (void)system.GetCustomAssetLoader().LoadGameTexture(base_filename, GetLibrary(entry));
     return iter->second;
   }
   else
   {
-    auto& system = Core::System::GetInstance();
     auto hires_texture = std::make_shared<HiresTexture>(
-        has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
+        entry.has_arbitrary_mipmaps,
+        system.GetCustomAssetLoader().LoadGameTexture(base_filename, GetLibrary(entry)));
     if (g_ActiveConfig.bCacheHiresTextures)
     {
       s_hires_texture_cache.try_emplace(base_filename, hires_texture);
@@ -224,7 +289,13 @@ std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_di
   const std::string textureFolder = isCustomTexturePack ? game_id : texturePack;
   const std::string texture_directory = root_directory + textureFolder;
 
-  if (File::Exists(texture_directory))
+  // A texture pack archive named like the directory stands in for it
+  const auto exists = [](const std::string& directory) {
+    return File::Exists(directory) ||
+           File::Exists(directory + std::string(VideoCommon::TexturePackArchive::EXTENSION));
+  };
+
+  if (exists(texture_directory))
   {
     result.insert(texture_directory);
   }
@@ -233,7 +304,7 @@ std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_di
     // If there's no directory with the region-specific ID, look for a 3-character region-free one
     const std::string region_free_directory = root_directory + game_id.substr(0, 3);
 
-    if (File::Exists(region_free_directory))
+    if (exists(region_free_directory))
     {
       result.insert(region_free_directory);
     }
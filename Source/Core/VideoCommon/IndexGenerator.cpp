@@ -3,6 +3,7 @@
 
 #include "VideoCommon/IndexGenerator.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -262,10 +263,18 @@ u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 }
 }  // Anonymous namespace
 
-void IndexGenerator::Init()
+// Below this, waking up the workers takes longer than writing the indices
+static constexpr u32 MIN_PARALLEL_VERTICES = 8192;
+// A multiple of 3 and 4, so that the chunks of lists and quads hold whole primitives
+static constexpr u32 CHUNK_VERTICES = 2400;
+
+void IndexGenerator::Init(BatchWorkerPool* workers)
 {
   using OpcodeDecoder::Primitive;
 
+  m_workers = workers;
+  m_primitive_restart = g_Config.backend_info.bSupportsPrimitiveRestart;
+
   if (g_Config.backend_info.bSupportsPrimitiveRestart)
   {
     m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<true>;
@@ -314,11 +323,47 @@ void IndexGenerator::Start(u16* index_ptr)
 
 void IndexGenerator::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
 {
+  if (num_vertices >= MIN_PARALLEL_VERTICES && AddIndicesParallel(primitive, num_vertices))
+  {
+    m_base_index += num_vertices;
+    return;
+  }
+
   m_index_buffer_current =
       m_primitive_table[primitive](m_index_buffer_current, num_vertices, m_base_index);
   m_base_index += num_vertices;
 }
 
+bool IndexGenerator::AddIndicesParallel(OpcodeDecoder::Primitive primitive, u32 num_vertices)
+{
+  if (!m_workers || m_workers->GetWorkerCount() == 0)
+    return false;
+
+  // Only lists and quads write the same number of indices for every primitive, which tells where
+  // the output of each chunk starts
+  using OpcodeDecoder::Primitive;
+  u32 indices_per_chunk;
+  if (primitive == Primitive::GX_DRAW_TRIANGLES)
+    indices_per_chunk = CHUNK_VERTICES / 3 * (m_primitive_restart ? 4 : 3);
+  else if (primitive == Primitive::GX_DRAW_QUADS)
+    indices_per_chunk = CHUNK_VERTICES / 4 * (m_primitive_restart ? 5 : 6);
+  else
+    return false;
+
+  const PrimitiveFunction function = m_primitive_table[primitive];
+  u16* const output = m_index_buffer_current;
+  const u32 num_chunks = (num_vertices + CHUNK_VERTICES - 1) / CHUNK_VERTICES;
+  m_workers->Run(num_chunks, [&](u32 chunk) {
+    const u32 first = chunk * CHUNK_VERTICES;
+    // The last chunk also gets the leftover vertices, like the end of a whole batch would
+    u16* const end = function(output + chunk * indices_per_chunk,
+                              std::min(CHUNK_VERTICES, num_vertices - first), m_base_index + first);
+    if (chunk == num_chunks - 1)
+      m_index_buffer_current = end;
+  });
+  return true;
+}
+
 void IndexGenerator::AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices)
 {
   std::memcpy(m_index_buffer_current, indices, sizeof(u16) * num_indices);
@@ -8,12 +8,14 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "VideoCommon/BatchWorkerPool.h"
 #include "VideoCommon/OpcodeDecoding.h"
 
 class IndexGenerator
 {
 public:
-  void Init();
+  // Large lists of triangles and quads are split between the workers of the pool, if given
+  void Init(BatchWorkerPool* workers = nullptr);
   void Start(u16* index_ptr);
 
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
@@ -26,10 +28,14 @@ public:
   u32 GetRemainingIndices(OpcodeDecoder::Primitive primitive) const;
 
 private:
+  bool AddIndicesParallel(OpcodeDecoder::Primitive primitive, u32 num_vertices);
+
   u16* m_index_buffer_current = nullptr;
   u16* m_base_index_ptr = nullptr;
   u32 m_base_index = 0;
 
   using PrimitiveFunction = u16* (*)(u16*, u32, u32);
   Common::EnumMap<PrimitiveFunction, OpcodeDecoder::Primitive::GX_DRAW_POINTS> m_primitive_table{};
+  BatchWorkerPool* m_workers = nullptr;
+  bool m_primitive_restart = false;
 };
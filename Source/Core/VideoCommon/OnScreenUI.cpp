@@ -311,7 +311,11 @@ void OnScreenUI::DrawDebugText()
   }
 
   if (g_ActiveConfig.bOverlayStats)
+  {
     g_stats.Display();
+    g_stats.DisplayVertexLoaders();
+    g_stats.DisplayCoreTimingEvents();
+  }
 
   if (g_ActiveConfig.bShowNetPlayMessages && g_netplay_chat_ui)
     g_netplay_chat_ui->Display();
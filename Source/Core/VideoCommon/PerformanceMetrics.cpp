@@ -8,6 +8,7 @@
 #include <imgui.h>
 #include <implot.h>
 
+#include "Core/Config/MainSettings.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
@@ -24,6 +25,11 @@ void PerformanceMetrics::Reset()
   m_time_sleeping = DT::zero();
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
+
+  m_vblank_count = 0;
+  m_frame_dump_frames = 0;
+  m_frame_dump_drops = 0;
+  m_frame_dump_latency = DT::zero();
 }
 
 void PerformanceMetrics::CountFrame()
@@ -34,6 +40,7 @@ void PerformanceMetrics::CountFrame()
 void PerformanceMetrics::CountVBlank()
 {
   m_vps_counter.Count();
+  m_vblank_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 void PerformanceMetrics::CountThrottleSleep(DT sleep)
@@ -52,6 +59,21 @@ void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cycles
   m_time_index += 1;
 }
 
+void PerformanceMetrics::CountFrameDumpFrame(DT latency)
+{
+  // Only the frame dump thread counts frames, so the average doesn't need a lock
+  const DT average = m_frame_dump_latency.load(std::memory_order_relaxed);
+  if (m_frame_dump_frames.fetch_add(1, std::memory_order_relaxed) == 0)
+    m_frame_dump_latency.store(latency, std::memory_order_relaxed);
+  else
+    m_frame_dump_latency.store(average + (latency - average) / 16, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountDroppedFrameDumpFrame()
+{
+  m_frame_dump_drops.fetch_add(1, std::memory_order_relaxed);
+}
+
 double PerformanceMetrics::GetFPS() const
 {
   return m_fps_counter.GetHzAvg();
@@ -80,6 +102,26 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+u64 PerformanceMetrics::GetVBlankCount() const
+{
+  return m_vblank_count.load(std::memory_order_relaxed);
+}
+
+u64 PerformanceMetrics::GetFrameDumpFrameCount() const
+{
+  return m_frame_dump_frames.load(std::memory_order_relaxed);
+}
+
+u64 PerformanceMetrics::GetDroppedFrameDumpFrameCount() const
+{
+  return m_frame_dump_drops.load(std::memory_order_relaxed);
+}
+
+DT PerformanceMetrics::GetFrameDumpLatency() const
+{
+  return m_frame_dump_latency.load(std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -269,5 +311,32 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  if ((g_ActiveConfig.bShowFPS || g_ActiveConfig.bShowFTimes) &&
+      Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+  {
+    float window_height = (12.f + 17.f * 2) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("FrameDumpStats", nullptr, imgui_flags))
+    {
+      // Dropped frames are missing from the recording, so make them stand out
+      const u64 drops = GetDroppedFrameDumpFrameCount();
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Dump:%4.0lfms",
+                         DT_ms(GetFrameDumpLatency()).count());
+      ImGui::TextColored(drops != 0 ? ImVec4(1.0f, 0.0f, 0.0f, 1.0f) : ImVec4(r, g, b, 1.0f),
+                         "Drop:%5llu", static_cast<unsigned long long>(drops));
+      ImGui::End();
+    }
+  }
+
   ImGui::PopStyleVar(2);
 }
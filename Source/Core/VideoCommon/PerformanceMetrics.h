@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +34,10 @@ public:
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
 
+  // Frame dumping, latency is the time from reading a frame back to it being encoded
+  void CountFrameDumpFrame(DT latency);
+  void CountDroppedFrameDumpFrame();
+
   // Getter Functions
   double GetFPS() const;
   double GetVPS() const;
@@ -41,6 +46,13 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  // Emulated frames since the last reset
+  u64 GetVBlankCount() const;
+
+  u64 GetFrameDumpFrameCount() const;
+  u64 GetDroppedFrameDumpFrameCount() const;
+  DT GetFrameDumpLatency() const;
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
@@ -57,6 +69,11 @@ private:
   std::array<TimePoint, 256> m_real_times{};
   std::array<TimePoint, 256> m_cpu_times{};
   DT m_time_sleeping{};
+
+  std::atomic<u64> m_vblank_count = 0;
+  std::atomic<u64> m_frame_dump_frames = 0;
+  std::atomic<u64> m_frame_dump_drops = 0;
+  std::atomic<DT> m_frame_dump_latency{};
 };
 
 extern PerformanceMetrics g_perf_metrics;
@@ -6,6 +6,7 @@
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
 #include "Core/ConfigManager.h"
@@ -15,6 +16,7 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/GXPipelineUIDCache.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -56,20 +58,30 @@ void ShaderCache::InitializeShaderCache()
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
 
   // Load shader and UID caches.
+  std::vector<SerializedGXPipelineUid> new_shipped_uids;
   if (g_ActiveConfig.bShaderCache && m_api_type != APIType::Nothing)
   {
     LoadCaches();
     LoadPipelineUIDCache();
+    new_shipped_uids = LoadShippedPipelineUIDCache();
   }
 
   // Queue ubershader precompiling if required.
   if (g_ActiveConfig.UsingUberShaders())
     QueueUberShaderPipelines();
 
-  // Compile all known UIDs.
+  // Compile all known UIDs. Shipped UIDs the user hasn't compiled yet are compiled before the game
+  // starts, as stutter-free play from the first boot is their whole point. They are added to the
+  // user's cache once compiled, so later boots only wait when a new build ships more of them.
   CompileMissingPipelines();
-  if (g_ActiveConfig.bWaitForShadersBeforeStarting)
-    WaitForAsyncCompiler();
+  if (g_ActiveConfig.bWaitForShadersBeforeStarting || !new_shipped_uids.empty())
+  {
+    if (WaitForAsyncCompiler())
+    {
+      for (const SerializedGXPipelineUid& uid : new_shipped_uids)
+        AppendSerializedGXPipelineUID(uid);
+    }
+  }
 
   // Switch to the runtime shader compiler thread configuration.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
@@ -160,7 +172,7 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
-void ShaderCache::WaitForAsyncCompiler()
+bool ShaderCache::WaitForAsyncCompiler()
 {
   bool running = true;
 
@@ -197,6 +209,7 @@ void ShaderCache::WaitForAsyncCompiler()
 
   // An extra Present to clear the screen
   g_presenter->Present();
+  return running;
 }
 
 template <typename SerializedUidType, typename UidType>
@@ -922,95 +935,82 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  const std::string filename = File::GetUserPath(D_CACHE_IDX) +
+                               SConfig::GetInstance().GetGameID() +
+                               std::string(GX_PIPELINE_UID_CACHE_EXTENSION);
+  if (const auto uids = ReadGXPipelineUIDCache(filename))
   {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
+    // This just adds the pipelines to the map, they are compiled later.
+    for (const SerializedGXPipelineUid& uid : *uids)
+      AddSerializedGXPipelineUID(uid);
+
+    // New UIDs are written after the last whole one, over a partially written one if any
+    const u64 end = GX_PIPELINE_UID_CACHE_HEADER_SIZE + uids->size() * sizeof(*uids->data());
+    if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+") &&
+        !m_gx_pipeline_uid_cache_file.Seek(end, File::SeekOrigin::Begin))
     {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
-
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
-    }
-
-    // If the file is invalid, close it. We re-open and truncate it below.
-    if (!uid_file_valid)
       m_gx_pipeline_uid_cache_file.Close();
+    }
   }
 
-  // If the file is not open, it means it was either corrupted or didn't exist.
+  // If the file is not open, it was missing, from another version or couldn't be read. Start it
+  // over with any current UIDs, so the ones from an incomplete file (e.g. Dolphin crashed) aren't
+  // lost.
   if (!m_gx_pipeline_uid_cache_file.IsOpen())
   {
-    if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
-    {
-      // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
-
-      // Write any current UIDs out to the file.
-      // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
-      // we don't lose the existing UIDs which were previously at the beginning.
-      for (const auto& it : m_gx_pipeline_cache)
-        AppendGXPipelineUID(it.first);
-    }
+    std::vector<SerializedGXPipelineUid> uids;
+    uids.reserve(m_gx_pipeline_cache.size());
+    for (const auto& it : m_gx_pipeline_cache)
+      SerializePipelineUid(it.first, uids.emplace_back());
+
+    if (WriteGXPipelineUIDCache(filename, uids))
+      m_gx_pipeline_uid_cache_file.Open(filename, "ab");
   }
 
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
 }
 
+std::vector<SerializedGXPipelineUid> ShaderCache::LoadShippedPipelineUIDCache()
+{
+  // These are loaded after the user's cache is open, so they are only written to it once compiled
+  const std::string filename = File::GetSysDirectory() + PIPELINE_UID_CACHE_DIR DIR_SEP +
+                               SConfig::GetInstance().GetGameID() +
+                               std::string(GX_PIPELINE_UID_CACHE_EXTENSION);
+  const auto uids = ReadGXPipelineUIDCache(filename);
+  if (!uids)
+    return {};
+
+  std::vector<SerializedGXPipelineUid> new_uids;
+  for (const SerializedGXPipelineUid& uid : *uids)
+  {
+    if (AddSerializedGXPipelineUID(uid))
+      new_uids.push_back(uid);
+  }
+
+  INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}, {} of them new", uids->size(), filename,
+               new_uids.size());
+  return new_uids;
+}
+
 void ShaderCache::ClosePipelineUIDCache()
 {
   // This is left as a method in case we need to append extra data to the file in the future.
   m_gx_pipeline_uid_cache_file.Close();
 }
 
-void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
+bool ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
   UnserializePipelineUid(uid, real_uid);
 
   auto iter = m_gx_pipeline_cache.find(real_uid);
   if (iter != m_gx_pipeline_cache.end())
-    return;
+    return false;
 
   // Flag it as empty with a null pipeline object, for later compilation.
   auto& entry = m_gx_pipeline_cache[real_uid];
   entry.second = false;
+  return true;
 }
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
@@ -1020,7 +1020,15 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
 
   SerializedGXPipelineUid disk_uid;
   SerializePipelineUid(config, disk_uid);
-  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  AppendSerializedGXPipelineUID(disk_uid);
+}
+
+void ShaderCache::AppendSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
+{
+  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+    return;
+
+  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&uid, sizeof(uid)))
   {
     WARN_LOG_FMT(VIDEO, "Writing pipeline UID to cache failed, closing file.");
     m_gx_pipeline_uid_cache_file.Close();
@@ -117,10 +117,13 @@ public:
 private:
   static constexpr size_t NUM_PALETTE_CONVERSION_SHADERS = 3;
 
-  void WaitForAsyncCompiler();
+  // Returns false if the compiler was stopped before finishing
+  bool WaitForAsyncCompiler();
   void LoadCaches();
   void ClearCaches();
   void LoadPipelineUIDCache();
+  // Returns the shipped UIDs which weren't in the user's cache
+  std::vector<SerializedGXPipelineUid> LoadShippedPipelineUIDCache();
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
@@ -159,8 +162,9 @@ private:
                                            std::unique_ptr<AbstractPipeline> pipeline);
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
                                                std::unique_ptr<AbstractPipeline> pipeline);
-  void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
+  bool AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void AppendSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
 
   // ASync Compiler Methods
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
@@ -3,16 +3,21 @@
 
 #include "VideoCommon/Statistics.h"
 
+#include <cinttypes>
 #include <cstring>
 #include <utility>
 
 #include <imgui.h>
 
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/SoundStream.h"
+#include "Core/CoreTiming.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/System.h"
 
 #include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VideoEvents.h"
@@ -110,11 +115,99 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Vertex Loaders cached", "%d", num_vertex_loaders_precompiled);
+  draw_statistic("VL lookups/compiles", "%d/%d", this_frame.num_vertex_loader_lookups,
+                 this_frame.num_vertex_loaders_compiled);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
+  if (const SoundStream* sound_stream = Core::System::GetInstance().GetSoundStream())
+  {
+    const Mixer::FifoStatistics audio = sound_stream->GetMixer()->GetDMAStatistics();
+    draw_statistic("Audio buffered/target", "%u/%u ms", audio.buffered_ms, audio.target_ms);
+    draw_statistic("Audio underruns/overruns", "%" PRIu64 "/%" PRIu64, audio.underruns,
+                   audio.overruns);
+  }
+
+  ImGui::Columns(1);
+
+  ImGui::End();
+}
+
+void Statistics::DisplayVertexLoaders() const
+{
+  if (!ImGui::Begin("Vertex Loader Statistics", nullptr, ImGuiWindowFlags_NoNavInputs))
+  {
+    ImGui::End();
+    return;
+  }
+
+  // Sampled once per frame, so the vertex counts are per frame as well
+  const std::vector<VertexLoaderManager::LoaderStatistics> loaders =
+      VertexLoaderManager::SampleLoaderStatistics();
+
+  ImGui::Columns(4, "VertexLoaders", true);
+  for (const char* header : {"VCD/VAT", "Size", "Vertices", "Cached"})
+  {
+    ImGui::TextUnformatted(header);
+    ImGui::NextColumn();
+  }
+  ImGui::Separator();
+
+  for (const VertexLoaderManager::LoaderStatistics& loader : loaders)
+  {
+    ImGui::Text("%08x %08x %08x %08x %08x", loader.uid[0], loader.uid[1], loader.uid[2],
+                loader.uid[3], loader.uid[4]);
+    ImGui::NextColumn();
+    ImGui::Text("%u", loader.vertex_size);
+    ImGui::NextColumn();
+    ImGui::Text("%d", loader.sampled_vertices);
+    ImGui::NextColumn();
+    ImGui::TextUnformatted(loader.precompiled ? "yes" : "no");
+    ImGui::NextColumn();
+  }
+
+  ImGui::Columns(1);
+
+  ImGui::End();
+}
+
+void Statistics::DisplayCoreTimingEvents() const
+{
+  if (!ImGui::Begin("CoreTiming Event Statistics", nullptr, ImGuiWindowFlags_NoNavInputs))
+  {
+    ImGui::End();
+    return;
+  }
+
+  // Sampled once per frame, so the counts are per frame as well
+  const std::vector<CoreTiming::EventStatistics> events =
+      Core::System::GetInstance().GetCoreTiming().SampleEventStatistics();
+
+  ImGui::Columns(5, "CoreTimingEvents", true);
+  for (const char* header : {"Event", "Scheduled", "Removed", "Ran", "Callback time"})
+  {
+    ImGui::TextUnformatted(header);
+    ImGui::NextColumn();
+  }
+  ImGui::Separator();
+
+  for (const CoreTiming::EventStatistics& event : events)
+  {
+    ImGui::TextUnformatted(event.name.c_str());
+    ImGui::NextColumn();
+    ImGui::Text("%" PRIu64, event.schedule_count);
+    ImGui::NextColumn();
+    ImGui::Text("%" PRIu64, event.remove_count);
+    ImGui::NextColumn();
+    ImGui::Text("%" PRIu64, event.callback_count);
+    ImGui::NextColumn();
+    ImGui::Text("%.1f us", event.callback_ns / 1000.0);
+    ImGui::NextColumn();
+  }
+
   ImGui::Columns(1);
 
   ImGui::End();
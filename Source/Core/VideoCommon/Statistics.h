@@ -20,6 +20,7 @@ struct Statistics
   int num_textures_alive = 0;
 
   int num_vertex_loaders = 0;
+  int num_vertex_loaders_precompiled = 0;
 
   std::array<float, 6> proj{};
   std::array<float, 16> gproj{};
@@ -66,6 +67,8 @@ struct Statistics
     int rasterized_pixels = 0;
     int num_triangles_drawn = 0;
     int num_vertices_loaded = 0;
+    int num_vertex_loader_lookups = 0;
+    int num_vertex_loaders_compiled = 0;
     int tev_pixels_in = 0;
     int tev_pixels_out = 0;
 
@@ -82,6 +85,8 @@ struct Statistics
   void AddScissorRect();
   void Display() const;
   void DisplayProj() const;
+  void DisplayVertexLoaders() const;
+  void DisplayCoreTimingEvents() const;
   void DisplayScissor();
 };
 
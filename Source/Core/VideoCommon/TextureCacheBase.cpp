@@ -130,6 +130,15 @@ bool TextureCacheBase::Initialize()
     return false;
   }
 
+  // Run a FIFO log with this enabled to get a trace for the texture cache index benchmark
+  if (Config::Get(Config::GFX_DUMP_TEXTURE_CACHE_TRACE))
+  {
+    m_trace = std::make_unique<VideoCommon::TextureCacheTraceWriter>(
+        File::GetUserPath(D_DUMP_IDX) + "TextureCache.trace");
+    m_textures_by_address.SetTrace(m_trace.get());
+    m_textures_by_hash.SetTrace(m_trace.get());
+  }
+
   return true;
 }
 
@@ -140,8 +149,8 @@ void TextureCacheBase::Invalidate()
 
   for (auto& bind : m_bound_textures)
     bind.reset();
-  m_textures_by_hash.clear();
-  m_textures_by_address.clear();
+  m_textures_by_hash.Clear();
+  m_textures_by_address.Clear();
 
   m_texture_pool.clear();
 }
@@ -177,43 +186,27 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
-  TexAddrCache::iterator iter = m_textures_by_address.begin();
-  TexAddrCache::iterator tcend = m_textures_by_address.end();
-  while (iter != tcend)
-  {
-    if (iter->second->frameCount == FRAMECOUNT_INVALID)
-    {
-      iter->second->frameCount = _frameCount;
-      ++iter;
-    }
-    else if (_frameCount > TEXTURE_KILL_THRESHOLD + iter->second->frameCount)
+  m_textures_by_address.EraseIf([this, _frameCount](const RcTcacheEntry& entry) {
+    if (entry->frameCount == FRAMECOUNT_INVALID)
     {
-      if (iter->second->IsCopy())
-      {
-        // Only remove EFB copies when they wouldn't be used anymore(changed hash), because EFB
-        // copies living on the
-        // host GPU are unrecoverable. Perform this check only every TEXTURE_KILL_THRESHOLD for
-        // performance reasons
-        if ((_frameCount - iter->second->frameCount) % TEXTURE_KILL_THRESHOLD == 1 &&
-            iter->second->hash != iter->second->CalculateHash())
-        {
-          iter = InvalidateTexture(iter);
-        }
-        else
-        {
-          ++iter;
-        }
-      }
-      else
-      {
-        iter = InvalidateTexture(iter);
-      }
+      entry->frameCount = _frameCount;
+      return false;
     }
-    else
+    if (_frameCount <= TEXTURE_KILL_THRESHOLD + entry->frameCount)
+      return false;
+
+    // Only remove EFB copies when they wouldn't be used anymore(changed hash), because EFB
+    // copies living on the host GPU are unrecoverable. Perform this check only every
+    // TEXTURE_KILL_THRESHOLD for performance reasons
+    if (entry->IsCopy() && ((_frameCount - entry->frameCount) % TEXTURE_KILL_THRESHOLD != 1 ||
+                            entry->hash == entry->CalculateHash()))
     {
-      ++iter;
+      return false;
     }
-  }
+
+    UnlinkTexture(entry.get(), false);
+    return true;
+  });
 
   TexPool::iterator iter2 = m_texture_pool.begin();
   TexPool::iterator tcend2 = m_texture_pool.end();
@@ -349,7 +342,7 @@ RcTcacheEntry TextureCacheBase::ApplyPaletteToEntry(RcTcacheEntry& entry, const
     g_gfx->EndUtilityDrawing();
   }
 
-  m_textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  m_textures_by_address.Insert(decoded_entry->addr, decoded_entry->size_in_bytes, decoded_entry);
 
   return decoded_entry;
 }
@@ -395,12 +388,14 @@ RcTcacheEntry TextureCacheBase::ReinterpretEntry(const RcTcacheEntry& existing_e
   g_gfx->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  m_textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  m_textures_by_address.Insert(reinterpreted_entry->addr, reinterpreted_entry->size_in_bytes,
+                               reinterpreted_entry);
 
   return reinterpreted_entry;
 }
 
-void TextureCacheBase::ScaleTextureCacheEntryTo(RcTcacheEntry& entry, u32 new_width, u32 new_height)
+void TextureCacheBase::ScaleTextureCacheEntryTo(const RcTcacheEntry& entry, u32 new_width,
+                                                u32 new_height)
 {
   if (entry->GetWidth() == new_width && entry->GetHeight() == new_height)
   {
@@ -611,22 +606,20 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
   std::vector<std::pair<u32, u32>> bound_textures_list;
   if (Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
   {
-    for (const auto& it : m_textures_by_address)
-    {
-      if (ShouldSaveEntry(it.second))
+    m_textures_by_address.ForEach([&](u32 address, const RcTcacheEntry& entry) {
+      if (ShouldSaveEntry(entry))
       {
-        const u32 id = AddCacheEntryToMap(it.second);
-        textures_by_address_list.emplace_back(it.first, id);
+        const u32 id = AddCacheEntryToMap(entry);
+        textures_by_address_list.emplace_back(address, id);
       }
-    }
-    for (const auto& it : m_textures_by_hash)
-    {
-      if (ShouldSaveEntry(it.second))
+    });
+    m_textures_by_hash.ForEach([&](u64 hash, const RcTcacheEntry& entry) {
+      if (ShouldSaveEntry(entry))
       {
-        const u32 id = AddCacheEntryToMap(it.second);
-        textures_by_hash_list.emplace_back(it.first, id);
+        const u32 id = AddCacheEntryToMap(entry);
+        textures_by_hash_list.emplace_back(hash, id);
       }
-    }
+    });
     for (u32 i = 0; i < m_bound_textures.size(); i++)
     {
       const auto& tentry = m_bound_textures[i];
@@ -716,9 +709,8 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     // Even if the texture isn't valid, we still need to create the cache entry object
     // to update the point in the state state. We'll just throw it away if it's invalid.
     auto tex = DeserializeTexture(p);
-    auto entry =
-        std::make_shared<TCacheEntry>(std::move(tex->texture), std::move(tex->framebuffer));
-    entry->textures_by_hash_iter = m_textures_by_hash.end();
+    auto entry = std::allocate_shared<TCacheEntry>(m_entry_allocator, std::move(tex->texture),
+                                                   std::move(tex->framebuffer));
     entry->DoState(p);
     if (entry->texture && commit_state)
       id_map.emplace(i, entry);
@@ -749,7 +741,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     auto& entry = GetEntry(id);
     if (entry)
-      m_textures_by_address.emplace(addr, entry);
+      m_textures_by_address.Insert(addr, entry->size_in_bytes, entry);
   }
 
   // Fill in hash map.
@@ -763,7 +755,10 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     auto& entry = GetEntry(id);
     if (entry)
-      entry->textures_by_hash_iter = m_textures_by_hash.emplace(hash, entry);
+    {
+      m_textures_by_hash.Insert(hash, entry);
+      entry->textures_by_hash_key = hash;
+    }
   }
 
   // Clear bound textures
@@ -819,7 +814,7 @@ void TCacheEntry::DoState(PointerWrap& p)
   p.Do(frameCount);
 }
 
-RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_update,
+RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(const RcTcacheEntry& entry_to_update,
                                                         const u8* palette, TLUTFormat tlutfmt)
 {
   // If the flag may_have_overlapping_textures is cleared, there are no overlapping EFB copies,
@@ -850,15 +845,15 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
 
   u32 numBlocksX = (entry_to_update->native_width + block_width - 1) / block_width;
 
-  auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
-  while (iter.first != iter.second)
+  for (const RcTcacheEntry& overlapping_entry : m_textures_by_address.FindOverlapping(
+           entry_to_update->addr, entry_to_update->size_in_bytes))
   {
-    auto& entry = iter.first->second;
-    if (entry != entry_to_update && entry->IsCopy() &&
-        entry->references.count(entry_to_update.get()) == 0 &&
-        entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
-        entry->memory_stride == numBlocksX * block_size)
+    if (overlapping_entry != entry_to_update && overlapping_entry->IsCopy() &&
+        overlapping_entry->references.count(entry_to_update.get()) == 0 &&
+        overlapping_entry->memory_stride == numBlocksX * block_size)
     {
+      // Copied, as it is replaced by the converted entry below
+      RcTcacheEntry entry = overlapping_entry;
       if (entry->hash == entry->CalculateHash())
       {
         // If the texture formats are not compatible or convertible, skip it.
@@ -866,7 +861,6 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
         {
           if (!CanReinterpretTextureOnGPU(entry_to_update->format.texfmt, entry->format.texfmt))
           {
-            ++iter.first;
             continue;
           }
 
@@ -889,7 +883,6 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
           }
           else
           {
-            ++iter.first;
             continue;
           }
         }
@@ -951,7 +944,6 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
             static_cast<u32>(dst_x + copy_width) > entry_to_update->GetWidth() ||
             static_cast<u32>(dst_y + copy_height) > entry_to_update->GetHeight())
         {
-          ++iter.first;
           continue;
         }
 
@@ -977,7 +969,7 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
         {
           // Remove the temporary converted texture, it won't be used anywhere else
           // TODO: It would be nice to convert and copy in one step, but this code path isn't common
-          iter.first = InvalidateTexture(iter.first);
+          InvalidateTexture(entry.get());
           continue;
         }
         else
@@ -991,11 +983,10 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
+        InvalidateTexture(entry.get());
         continue;
       }
     }
-    ++iter.first;
   }
 
   return entry_to_update;
@@ -1254,7 +1245,7 @@ TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
       return entry;
     }
 
-    InvalidateTexture(GetTexCacheIter(entry));
+    InvalidateTexture(entry);
     return LoadImpl(texture_info, true);
   }
 
@@ -1398,17 +1389,13 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
   //
   // For efb copies, the entry created in CopyRenderTargetToTexture always has to be used, or else
   // it was done in vain.
-  auto iter_range = m_textures_by_address.equal_range(texture_info.GetRawAddress());
-  TexAddrCache::iterator iter = iter_range.first;
-  TexAddrCache::iterator oldest_entry = iter;
+  RcTcacheEntry oldest_entry;
   int temp_frameCount = 0x7fffffff;
-  TexAddrCache::iterator unconverted_copy = m_textures_by_address.end();
-  TexAddrCache::iterator unreinterpreted_copy = m_textures_by_address.end();
+  RcTcacheEntry unconverted_copy;
+  RcTcacheEntry unreinterpreted_copy;
 
-  while (iter != iter_range.second)
+  for (const RcTcacheEntry& entry : m_textures_by_address.Find(texture_info.GetRawAddress()))
   {
-    RcTcacheEntry& entry = iter->second;
-
     // TODO: Some games (Rogue Squadron 3, Twin Snakes) seem to load a previously made XFB
     // copy as a regular texture. You can see this particularly well in RS3 whenever the
     // game freezes the image and fades it out to black on screen transitions, which fades
@@ -1439,21 +1426,20 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
           {
             // Delay the conversion until afterwards, it's possible this texture has already been
             // converted.
-            unreinterpreted_copy = iter++;
+            unreinterpreted_copy = entry;
             continue;
           }
           else
           {
             // If the EFB copies are in a different format and are not reinterpretable, use the RAM
             // copy.
-            ++iter;
             continue;
           }
         }
         else
         {
           // Prefer the already-converted copy.
-          unconverted_copy = m_textures_by_address.end();
+          unconverted_copy.reset();
         }
 
         // TODO: We should check width/height/levels for EFB copies. I'm not sure what effect
@@ -1465,7 +1451,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
         // perform the conversion later.  Currently, we only convert EFB copies to
         // palette textures; we could do other conversions if it proved to be
         // beneficial.
-        unconverted_copy = iter;
+        unconverted_copy = entry;
       }
       else
       {
@@ -1473,7 +1459,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
         // never be useful again.  It's theoretically possible for a game to do
         // something weird where the copy could become useful in the future, but in
         // practice it doesn't happen.
-        iter = InvalidateTexture(iter);
+        InvalidateTexture(entry.get());
         continue;
       }
     }
@@ -1485,12 +1471,12 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
-        entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
-                                        texture_info.GetTlutFormat());
-        if (entry)
+        RcTcacheEntry updated_entry = DoPartialTextureUpdates(
+            entry, texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        if (updated_entry)
         {
-          entry->texture->FinishedRendering();
-          return entry;
+          updated_entry->texture->FinishedRendering();
+          return updated_entry;
         }
       }
     }
@@ -1506,15 +1492,13 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
         !entry->IsCopy() && !(texture_info.GetPaletteSize() && entry->base_hash == base_hash))
     {
       temp_frameCount = entry->frameCount;
-      oldest_entry = iter;
+      oldest_entry = entry;
     }
-    ++iter;
   }
 
-  if (unreinterpreted_copy != m_textures_by_address.end())
+  if (unreinterpreted_copy)
   {
-    auto decoded_entry =
-        ReinterpretEntry(unreinterpreted_copy->second, texture_info.GetTextureFormat());
+    auto decoded_entry = ReinterpretEntry(unreinterpreted_copy, texture_info.GetTextureFormat());
 
     // It's possible to combine reinterpreted textures + palettes.
     if (unreinterpreted_copy == unconverted_copy && decoded_entry)
@@ -1525,10 +1509,10 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
       return decoded_entry;
   }
 
-  if (unconverted_copy != m_textures_by_address.end())
+  if (unconverted_copy)
   {
-    auto decoded_entry = ApplyPaletteToEntry(
-        unconverted_copy->second, texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+    auto decoded_entry = ApplyPaletteToEntry(unconverted_copy, texture_info.GetTlutAddress(),
+                                             texture_info.GetTlutFormat());
 
     if (decoded_entry)
     {
@@ -1546,25 +1530,21 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
   {
-    auto hash_range = m_textures_by_hash.equal_range(full_hash);
-    TexHashCache::iterator hash_iter = hash_range.first;
-    while (hash_iter != hash_range.second)
+    for (const RcTcacheEntry& entry : m_textures_by_hash.Find(full_hash))
     {
-      RcTcacheEntry& entry = hash_iter->second;
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
-        entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
-                                        texture_info.GetTlutFormat());
-        if (entry)
+        RcTcacheEntry updated_entry = DoPartialTextureUpdates(
+            entry, texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        if (updated_entry)
         {
-          entry->texture->FinishedRendering();
-          return entry;
+          updated_entry->texture->FinishedRendering();
+          return updated_entry;
         }
       }
-      ++hash_iter;
     }
   }
 
@@ -1572,7 +1552,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
   if (temp_frameCount != 0x7fffffff)
   {
     // pool this texture and make a new one later
-    InvalidateTexture(oldest_entry);
+    InvalidateTexture(oldest_entry.get());
   }
 
   std::vector<VideoCommon::CachedAsset<VideoCommon::GameTextureAsset>> cached_game_assets;
@@ -1832,14 +1812,6 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     }
   }
 
-  const auto iter = m_textures_by_address.emplace(texture_info.GetRawAddress(), entry);
-  if (safety_color_sample_size == 0 ||
-      std::max(texture_info.GetTextureSize(), creation_info.palette_size) <=
-          (u32)safety_color_sample_size * 8)
-  {
-    entry->textures_by_hash_iter = m_textures_by_hash.emplace(creation_info.full_hash, entry);
-  }
-
   const TextureAndTLUTFormat full_format(texture_info.GetTextureFormat(),
                                          texture_info.GetTlutFormat());
   entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
@@ -1850,10 +1822,19 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
+  m_textures_by_address.Insert(entry->addr, entry->size_in_bytes, entry);
+  if (safety_color_sample_size == 0 ||
+      std::max(texture_info.GetTextureSize(), creation_info.palette_size) <=
+          (u32)safety_color_sample_size * 8)
+  {
+    m_textures_by_hash.Insert(creation_info.full_hash, entry);
+    entry->textures_by_hash_key = creation_info.full_hash;
+  }
+
   INCSTAT(g_stats.num_textures_uploaded);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
 
-  entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
+  entry = DoPartialTextureUpdates(entry, texture_info.GetTlutAddress(),
                                   texture_info.GetTlutFormat());
 
   // This should only be needed if the texture was updated, or used GPU decoding.
@@ -1931,7 +1912,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  m_textures_by_address.emplace(entry->addr, entry);
+  m_textures_by_address.Insert(entry->addr, entry->size_in_bytes, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1957,13 +1938,8 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
 
 RcTcacheEntry TextureCacheBase::GetXFBFromCache(u32 address, u32 width, u32 height, u32 stride)
 {
-  auto iter_range = m_textures_by_address.equal_range(address);
-  TexAddrCache::iterator iter = iter_range.first;
-
-  while (iter != iter_range.second)
+  for (const RcTcacheEntry& entry : m_textures_by_address.Find(address))
   {
-    auto& entry = iter->second;
-
     // The only thing which has to match exactly is the stride. We can use a partial rectangle if
     // the VI width/height differs from that of the XFB copy.
     if (entry->is_xfb_copy && entry->memory_stride == stride && entry->native_width >= width &&
@@ -1978,12 +1954,10 @@ RcTcacheEntry TextureCacheBase::GetXFBFromCache(u32 address, u32 width, u32 heig
         // At this point, we either have an xfb copy that has changed its hash
         // or an xfb created by stitching or from memory that has been changed
         // we are safe to invalidate this
-        iter = InvalidateTexture(iter);
+        InvalidateTexture(entry.get());
         continue;
       }
     }
-
-    ++iter;
   }
 
   return {};
@@ -2000,17 +1974,15 @@ void TextureCacheBase::StitchXFBCopy(RcTcacheEntry& stitched_entry)
   std::vector<TCacheEntry*> candidates;
   bool create_upscaled_copy = false;
 
-  auto iter = FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes);
-  while (iter.first != iter.second)
+  for (const RcTcacheEntry& entry :
+       m_textures_by_address.FindOverlapping(stitched_entry->addr, stitched_entry->size_in_bytes))
   {
     // Currently, this checks the stride of the VRAM copy against the VI request. Therefore, for
     // interlaced modes, VRAM copies won't be considered candidates. This is okay for now, because
     // our force progressive hack means that an XFB copy should always have a matching stride. If
     // the hack is disabled, XFB2RAM should also be enabled. Should we wish to implement interlaced
     // stitching in the future, this would require a shader which grabs every second line.
-    auto& entry = iter.first->second;
     if (entry != stitched_entry && entry->IsCopy() &&
-        entry->OverlapsMemoryRange(stitched_entry->addr, stitched_entry->size_in_bytes) &&
         entry->memory_stride == stitched_entry->memory_stride)
     {
       if (entry->hash == entry->CalculateHash())
@@ -2024,11 +1996,9 @@ void TextureCacheBase::StitchXFBCopy(RcTcacheEntry& stitched_entry)
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
-        continue;
+        InvalidateTexture(entry.get());
       }
     }
-    ++iter.first;
   }
 
   if (candidates.empty())
@@ -2470,11 +2440,9 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   // as our efb copy are marked to check them for partial texture updates.
   // TODO: The logic to detect overlapping strided efb copies is not 100% accurate.
   bool strided_efb_copy = dstStride != bytes_per_row;
-  auto iter = FindOverlappingTextures(dstAddr, covered_range);
-  while (iter.first != iter.second)
+  for (const RcTcacheEntry& overlapping_entry :
+       m_textures_by_address.FindOverlapping(dstAddr, covered_range))
   {
-    RcTcacheEntry& overlapping_entry = iter.first->second;
-
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
     {
       for (auto& reference : overlapping_entry->references)
@@ -2483,49 +2451,45 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       }
     }
 
-    if (overlapping_entry->OverlapsMemoryRange(dstAddr, covered_range))
+    u32 overlap_range = std::min(overlapping_entry->addr + overlapping_entry->size_in_bytes,
+                                 dstAddr + covered_range) -
+                        std::max(overlapping_entry->addr, dstAddr);
+    if (!copy_to_vram || overlapping_entry->memory_stride != dstStride ||
+        (!strided_efb_copy && overlapping_entry->size_in_bytes == overlap_range) ||
+        (strided_efb_copy && overlapping_entry->size_in_bytes == overlap_range &&
+         overlapping_entry->addr == dstAddr))
     {
-      u32 overlap_range = std::min(overlapping_entry->addr + overlapping_entry->size_in_bytes,
-                                   dstAddr + covered_range) -
-                          std::max(overlapping_entry->addr, dstAddr);
-      if (!copy_to_vram || overlapping_entry->memory_stride != dstStride ||
-          (!strided_efb_copy && overlapping_entry->size_in_bytes == overlap_range) ||
-          (strided_efb_copy && overlapping_entry->size_in_bytes == overlap_range &&
-           overlapping_entry->addr == dstAddr))
-      {
-        // Pending EFB copies which are completely covered by this new copy can simply be tossed,
-        // instead of having to flush them later on, since this copy will write over everything.
-        iter.first = InvalidateTexture(iter.first, true);
-        continue;
-      }
+      // Pending EFB copies which are completely covered by this new copy can simply be tossed,
+      // instead of having to flush them later on, since this copy will write over everything.
+      InvalidateTexture(overlapping_entry.get(), true);
+      continue;
+    }
 
-      // We don't want to change the may_have_overlapping_textures flag on XFB container entries
-      // because otherwise they can't be re-used/updated, leaking textures for several frames.
-      if (!overlapping_entry->is_xfb_container)
-        overlapping_entry->may_have_overlapping_textures = true;
-
-      // There are cases (Rogue Squadron 2 / Texas Holdem on Wiiware) where
-      // for xfb copies the textures overlap which causes the hash of the first copy
-      // to be different (from when it was originally created).  This has no implications
-      // for XFB2Tex because the underlying memory doesn't change (dummy values) but
-      // can affect XFB2Ram when we compare the texture cache copy hash with the
-      // newly computed hash
-      // By calculating the hash when we receive overlapping xfbs, we are able
-      // to mitigate this
-      if (overlapping_entry->is_xfb_copy && copy_to_ram)
-      {
-        overlapping_entry->hash = overlapping_entry->CalculateHash();
-      }
+    // We don't want to change the may_have_overlapping_textures flag on XFB container entries
+    // because otherwise they can't be re-used/updated, leaking textures for several frames.
+    if (!overlapping_entry->is_xfb_container)
+      overlapping_entry->may_have_overlapping_textures = true;
 
-      // Do not load textures by hash, if they were at least partly overwritten by an efb copy.
-      // In this case, comparing the hash is not enough to check, if two textures are identical.
-      if (overlapping_entry->textures_by_hash_iter != m_textures_by_hash.end())
-      {
-        m_textures_by_hash.erase(overlapping_entry->textures_by_hash_iter);
-        overlapping_entry->textures_by_hash_iter = m_textures_by_hash.end();
-      }
+    // There are cases (Rogue Squadron 2 / Texas Holdem on Wiiware) where
+    // for xfb copies the textures overlap which causes the hash of the first copy
+    // to be different (from when it was originally created).  This has no implications
+    // for XFB2Tex because the underlying memory doesn't change (dummy values) but
+    // can affect XFB2Ram when we compare the texture cache copy hash with the
+    // newly computed hash
+    // By calculating the hash when we receive overlapping xfbs, we are able
+    // to mitigate this
+    if (overlapping_entry->is_xfb_copy && copy_to_ram)
+    {
+      overlapping_entry->hash = overlapping_entry->CalculateHash();
+    }
+
+    // Do not load textures by hash, if they were at least partly overwritten by an efb copy.
+    // In this case, comparing the hash is not enough to check, if two textures are identical.
+    if (overlapping_entry->textures_by_hash_key)
+    {
+      m_textures_by_hash.Erase(*overlapping_entry->textures_by_hash_key, overlapping_entry.get());
+      overlapping_entry->textures_by_hash_key.reset();
     }
-    ++iter.first;
   }
 
   if (OpcodeDecoder::g_record_fifo_data)
@@ -2546,7 +2510,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    m_textures_by_address.emplace(dstAddr, std::move(entry));
+    m_textures_by_address.Insert(dstAddr, entry->size_in_bytes, entry);
   }
 }
 
@@ -2569,12 +2533,23 @@ void TextureCacheBase::FlushStaleBinds()
   }
 }
 
+// EFB and XFB copies write RAM through a pointer, which the snapshots of the memory must be told
+static void MarkRAMDirty(const u8* dst, u32 stride, u32 bytes_per_row, u32 num_rows)
+{
+  if (num_rows != 0)
+  {
+    auto& memory = Core::System::GetInstance().GetMemory();
+    memory.MarkDirty(dst, size_t(stride) * (num_rows - 1) + bytes_per_row);
+  }
+}
+
 void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
                                          std::unique_ptr<AbstractStagingTexture> staging_texture)
 {
   MathUtil::Rectangle<int> copy_rect(0, 0, static_cast<int>(width), static_cast<int>(height));
   staging_texture->ReadTexels(copy_rect, dst_ptr, stride);
   ReleaseEFBCopyStagingTexture(std::move(staging_texture));
+  MarkRAMDirty(dst_ptr, stride, width * sizeof(u32), height);
 }
 
 void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
@@ -2601,12 +2576,10 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   if (entry->is_xfb_copy)
   {
     const u32 covered_range = entry->pending_efb_copy_height * entry->memory_stride;
-    auto range = FindOverlappingTextures(entry->addr, covered_range);
-    for (auto iter = range.first; iter != range.second; ++iter)
+    for (const RcTcacheEntry& overlapping_entry :
+         m_textures_by_address.FindOverlapping(entry->addr, covered_range))
     {
-      auto& overlapping_entry = iter->second;
-      if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
-          overlapping_entry->OverlapsMemoryRange(entry->addr, covered_range))
+      if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy)
       {
         const u64 overlapping_hash = overlapping_entry->CalculateHash();
         entry->SetHashes(overlapping_hash, overlapping_hash);
@@ -2650,6 +2623,7 @@ void TextureCacheBase::UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_
     std::memset(ptr, 0, bytes_per_row);
     ptr += stride;
   }
+  MarkRAMDirty(dst, stride, bytes_per_row, num_blocks_y);
 }
 
 void TextureCacheBase::UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row,
@@ -2666,6 +2640,7 @@ void TextureCacheBase::UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_
 #if defined(_M_X86_64)
   __m128i sixteenBytes = _mm_set1_epi16((s16)(u16)0xFE01);
 #endif
+  MarkRAMDirty(dst, stride, bytes_per_row, num_blocks_y);
 
   for (u32 i = 0; i < num_blocks_y; i++)
   {
@@ -2700,9 +2675,8 @@ RcTcacheEntry TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
   if (!alloc)
     return {};
 
-  auto cacheEntry =
-      std::make_shared<TCacheEntry>(std::move(alloc->texture), std::move(alloc->framebuffer));
-  cacheEntry->textures_by_hash_iter = m_textures_by_hash.end();
+  auto cacheEntry = std::allocate_shared<TCacheEntry>(m_entry_allocator, std::move(alloc->texture),
+                                                      std::move(alloc->framebuffer));
   cacheEntry->id = m_last_entry_id++;
   return cacheEntry;
 }
@@ -2757,50 +2731,20 @@ TextureCacheBase::FindMatchingTextureFromPool(const TextureConfig& config)
   return matching_iter != range.second ? matching_iter : m_texture_pool.end();
 }
 
-TextureCacheBase::TexAddrCache::iterator TextureCacheBase::GetTexCacheIter(TCacheEntry* entry)
-{
-  auto iter_range = m_textures_by_address.equal_range(entry->addr);
-  TexAddrCache::iterator iter = iter_range.first;
-  while (iter != iter_range.second)
-  {
-    if (iter->second.get() == entry)
-    {
-      return iter;
-    }
-    ++iter;
-  }
-  return m_textures_by_address.end();
-}
-
-std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
-TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
+void TextureCacheBase::InvalidateTexture(TCacheEntry* entry, bool discard_pending_efb_copy)
 {
-  // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
-  auto begin = m_textures_by_address.lower_bound(lower_addr);
-  auto end = m_textures_by_address.upper_bound(addr + size_in_bytes);
+  if (!m_textures_by_address.Erase(entry->addr, entry))
+    return;
 
-  return std::make_pair(begin, end);
+  UnlinkTexture(entry, discard_pending_efb_copy);
 }
 
-TextureCacheBase::TexAddrCache::iterator
-TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pending_efb_copy)
+void TextureCacheBase::UnlinkTexture(TCacheEntry* entry, bool discard_pending_efb_copy)
 {
-  if (iter == m_textures_by_address.end())
-    return m_textures_by_address.end();
-
-  RcTcacheEntry& entry = iter->second;
-
-  if (entry->textures_by_hash_iter != m_textures_by_hash.end())
+  if (entry->textures_by_hash_key)
   {
-    m_textures_by_hash.erase(entry->textures_by_hash_iter);
-    entry->textures_by_hash_iter = m_textures_by_hash.end();
+    m_textures_by_hash.Erase(*entry->textures_by_hash_key, entry);
+    entry->textures_by_hash_key.reset();
   }
 
   // If this is a pending EFB copy, we don't want to flush it here.
@@ -2819,7 +2763,9 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
       // Xenoblade's sunset scene, where 35 copies are done per frame, and 25 of them are
       // copied to the same address, and can be skipped.
       ReleaseEFBCopyStagingTexture(std::move(entry->pending_efb_copy));
-      auto pending_it = std::find(m_pending_efb_copies.begin(), m_pending_efb_copies.end(), entry);
+      auto pending_it =
+          std::find_if(m_pending_efb_copies.begin(), m_pending_efb_copies.end(),
+                       [entry](const RcTcacheEntry& pending) { return pending.get() == entry; });
       if (pending_it != m_pending_efb_copies.end())
         m_pending_efb_copies.erase(pending_it);
     }
@@ -2828,12 +2774,10 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
       // The texture data has already been copied into the staging texture, so it's valid to
       // optimistically release the texture data. Will slightly lower VRAM usage.
       if (!entry->IsLocked())
-        ReleaseToPool(entry.get());
+        ReleaseToPool(entry);
     }
   }
   entry->invalidated = true;
-
-  return m_textures_by_address.erase(iter);
 }
 
 void TextureCacheBase::ReleaseToPool(TCacheEntry* entry)
@@ -20,10 +20,13 @@
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/SlabAllocator.h"
 
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TextureCacheIndex.h"
+#include "VideoCommon/TextureCacheTrace.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureInfo.h"
@@ -150,9 +153,8 @@ struct TCacheEntry
   // used to delete textures which haven't been used for TEXTURE_KILL_THRESHOLD frames
   int frameCount = FRAMECOUNT_INVALID;
 
-  // Keep an iterator to the entry in m_textures_by_hash, so it does not need to be searched when
-  // removing the cache entry
-  std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
+  // The key of the entry in m_textures_by_hash, if it is in there
+  std::optional<u64> textures_by_hash_key;
 
   // This is used to keep track of both:
   //   * efb copies used by this partially updated texture
@@ -289,7 +291,7 @@ public:
                                  bool clamp_bottom,
                                  const CopyFilterCoefficients::Values& filter_coefficients);
 
-  void ScaleTextureCacheEntryTo(RcTcacheEntry& entry, u32 new_width, u32 new_height);
+  void ScaleTextureCacheEntryTo(const RcTcacheEntry& entry, u32 new_width, u32 new_height);
 
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
@@ -333,8 +335,8 @@ protected:
   size_t m_temp_size = 0;
 
 private:
-  using TexAddrCache = std::multimap<u32, RcTcacheEntry>;
-  using TexHashCache = std::multimap<u64, RcTcacheEntry>;
+  using TexAddrCache = VideoCommon::TextureAddressIndex<TCacheEntry>;
+  using TexHashCache = VideoCommon::TextureHashIndex<TCacheEntry>;
 
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
 
@@ -358,7 +360,7 @@ private:
 
   RcTcacheEntry ReinterpretEntry(const RcTcacheEntry& existing_entry, TextureFormat new_format);
 
-  RcTcacheEntry DoPartialTextureUpdates(RcTcacheEntry& entry_to_update, const u8* palette,
+  RcTcacheEntry DoPartialTextureUpdates(const RcTcacheEntry& entry_to_update, const u8* palette,
                                         TLUTFormat tlutfmt);
   void StitchXFBCopy(RcTcacheEntry& entry_to_update);
 
@@ -367,16 +369,11 @@ private:
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
-  TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
-
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
-  std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
-  FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
   // Removes and unlinks texture from texture cache and returns it to the pool
-  TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
-                                           bool discard_pending_efb_copy = false);
+  void InvalidateTexture(TCacheEntry* entry, bool discard_pending_efb_copy = false);
+  // Unlinks a texture which was removed from m_textures_by_address
+  void UnlinkTexture(TCacheEntry* entry, bool discard_pending_efb_copy);
 
   void UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
   void UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
@@ -402,6 +399,13 @@ private:
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
+  // The cache entries and their control blocks come from here, as they are made and destroyed
+  // every time a texture changes
+  Common::SlabAllocator<TCacheEntry> m_entry_allocator;
+
+  // Records the operations on the indices below, if enabled
+  std::unique_ptr<VideoCommon::TextureCacheTraceWriter> m_trace;
+
   // m_textures_by_address is the authoritive version of what's actually "in" the texture cache
   // but it's possible for invalidated TCache entries to live on elsewhere
   TexAddrCache m_textures_by_address;
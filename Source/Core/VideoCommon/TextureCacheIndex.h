@@ -0,0 +1,595 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureCacheTrace.h"
+
+namespace VideoCommon
+{
+// The entries found by a lookup in one of the indices below. The index doesn't move its entries
+// while a lookup is being iterated, so the entries can be inserted and erased in the loop. Those
+// changes are applied when the last lookup is done: erased entries are skipped right away, but
+// inserted entries are only found by the lookups made after that.
+template <typename Index, typename Iterator>
+class TextureIndexRange
+{
+public:
+  TextureIndexRange(Index* index, Iterator begin) : m_index(index), m_begin(begin)
+  {
+    ++m_index->m_lookups;
+  }
+  ~TextureIndexRange()
+  {
+    if (--m_index->m_lookups == 0)
+      m_index->ApplyDeferredChanges();
+  }
+
+  TextureIndexRange(const TextureIndexRange&) = delete;
+  TextureIndexRange& operator=(const TextureIndexRange&) = delete;
+
+  Iterator begin() const { return m_begin; }
+  Iterator end() const { return {}; }
+
+private:
+  Index* m_index;
+  Iterator m_begin;
+};
+
+// The texture cache entries by the memory range they were loaded from. The entries are kept in
+// one array sorted by address, with their end address next to them, so lookups don't have to
+// touch the entries themselves. Entries with the same address stay in the order they were added.
+// New entries go to a small sorted array first, which is merged into the large one when it's full,
+// and erased entries are only marked until enough of them are left to remove in one pass.
+template <typename Entry>
+class TextureAddressIndex
+{
+  struct Item
+  {
+    u32 address;
+    u32 end;
+    bool erased;
+    std::shared_ptr<Entry> entry;
+  };
+
+public:
+  using Pointer = std::shared_ptr<Entry>;
+
+  // Walks the entries of the large and the small array in address order
+  class Iterator
+  {
+  public:
+    Iterator() = default;
+    Iterator(const TextureAddressIndex& index, u32 first, u32 end, u32 min_end)
+        : m_items(LowerBound(index.m_items, first)),
+          m_items_end(index.m_items.data() + index.m_items.size()),
+          m_recent(LowerBound(index.m_recent, first)),
+          m_recent_end(index.m_recent.data() + index.m_recent.size()), m_end(end),
+          m_min_end(min_end)
+    {
+      Advance();
+    }
+
+    const Pointer& operator*() const { return m_current->entry; }
+    const Pointer* operator->() const { return &m_current->entry; }
+    Iterator& operator++()
+    {
+      Advance();
+      return *this;
+    }
+    bool operator==(const Iterator& other) const { return m_current == other.m_current; }
+
+  private:
+    void Advance()
+    {
+      while (true)
+      {
+        const bool items_left = m_items != m_items_end && m_items->address < m_end;
+        const bool recent_left = m_recent != m_recent_end && m_recent->address < m_end;
+        if (!items_left && !recent_left)
+        {
+          m_current = nullptr;
+          return;
+        }
+
+        // The large array has the older entries, so it goes first for the same address
+        if (items_left && (!recent_left || m_items->address <= m_recent->address))
+          m_current = m_items++;
+        else
+          m_current = m_recent++;
+
+        if (!m_current->erased && m_current->end >= m_min_end)
+          return;
+      }
+    }
+
+    const Item* m_current = nullptr;
+    const Item* m_items = nullptr;
+    const Item* m_items_end = nullptr;
+    const Item* m_recent = nullptr;
+    const Item* m_recent_end = nullptr;
+    u32 m_end = 0;
+    u32 m_min_end = 0;
+  };
+
+  using Range = TextureIndexRange<TextureAddressIndex, Iterator>;
+
+  void Insert(u32 address, u32 size, Pointer entry)
+  {
+    if (m_trace)
+      m_trace->Insert(entry.get(), address, size);
+
+    m_largest_size = std::max(m_largest_size, size);
+    ++m_size;
+    Item item{address, address + size, false, std::move(entry)};
+    if (m_lookups != 0)
+      m_deferred.push_back(std::move(item));
+    else
+      InsertRecent(std::move(item));
+  }
+
+  // Returns false if the entry is not in the index
+  bool Erase(u32 address, const Entry* entry)
+  {
+    Item* item = FindItem(m_items, address, entry);
+    if (!item)
+      item = FindItem(m_recent, address, entry);
+
+    if (item)
+    {
+      // An entry erased during a lookup stays alive until the lookup is done, as the loop may
+      // still use it
+      item->erased = true;
+      if (m_lookups != 0)
+        m_erased_during_lookup.push_back(item);
+      else
+        item->entry.reset();
+      ++m_erased;
+    }
+    else
+    {
+      const auto iter = std::find_if(m_deferred.begin(), m_deferred.end(),
+                                     [entry](const Item& i) { return i.entry.get() == entry; });
+      if (iter == m_deferred.end())
+        return false;
+      m_deferred.erase(iter);
+    }
+
+    if (m_trace)
+      m_trace->Erase(entry);
+    --m_size;
+    if (m_lookups == 0 && m_erased > (m_items.size() + m_recent.size()) / 2)
+      Merge([](const Pointer&) { return false; });
+    return true;
+  }
+
+  // Removes the entries for which the predicate returns true, in address order.
+  // Not allowed while a lookup is being iterated.
+  template <typename Predicate>
+  void EraseIf(Predicate predicate)
+  {
+    Merge(std::move(predicate));
+  }
+
+  // The entries at the address, in the order they were added
+  Range Find(u32 address)
+  {
+    if (m_trace)
+      m_trace->Find(address);
+
+    return Range(this, Iterator(*this, address, address + 1, 0));
+  }
+
+  // The entries whose memory range overlaps the given one, in address order
+  Range FindOverlapping(u32 address, u32 size)
+  {
+    if (m_trace)
+      m_trace->FindOverlapping(address, size);
+
+    // Only entries starting less than the largest entry size before the range can reach into it
+    const u32 first = address > m_largest_size ? address - m_largest_size : 0;
+    return Range(this, Iterator(*this, first, address + size, address + 1));
+  }
+
+  // Calls the function for every entry, in address order.
+  // Not allowed while a lookup is being iterated.
+  template <typename Function>
+  void ForEach(Function function)
+  {
+    Merge([](const Pointer&) { return false; });
+    for (const Item& item : m_items)
+      function(item.address, item.entry);
+  }
+
+  void Clear()
+  {
+    if (m_trace)
+      m_trace->Clear();
+    m_items.clear();
+    m_recent.clear();
+    m_merged.clear();
+    m_deferred.clear();
+    m_erased_during_lookup.clear();
+    m_size = 0;
+    m_erased = 0;
+    m_largest_size = 0;
+  }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  void SetTrace(TextureCacheTraceWriter* trace) { m_trace = trace; }
+
+private:
+  template <typename, typename>
+  friend class TextureIndexRange;
+
+  // The small array is merged into the large one at this size. Inserting into it moves at most
+  // this many entries, and merging moves all of them once for this many inserts.
+  static constexpr size_t MAX_RECENT_ITEMS = 128;
+
+  static const Item* LowerBound(const std::vector<Item>& items, u32 address)
+  {
+    const auto iter =
+        std::lower_bound(items.begin(), items.end(), address,
+                         [](const Item& item, u32 value) { return item.address < value; });
+    return items.data() + (iter - items.begin());
+  }
+
+  static Item* FindItem(std::vector<Item>& items, u32 address, const Entry* entry)
+  {
+    auto iter = std::lower_bound(items.begin(), items.end(), address,
+                                 [](const Item& item, u32 value) { return item.address < value; });
+    for (; iter != items.end() && iter->address == address; ++iter)
+    {
+      if (!iter->erased && iter->entry.get() == entry)
+        return &*iter;
+    }
+    return nullptr;
+  }
+
+  void InsertRecent(Item item)
+  {
+    const auto iter =
+        std::upper_bound(m_recent.begin(), m_recent.end(), item.address,
+                         [](u32 value, const Item& i) { return value < i.address; });
+    m_recent.insert(iter, std::move(item));
+    if (m_recent.size() > MAX_RECENT_ITEMS)
+      Merge([](const Pointer&) { return false; });
+  }
+
+  // Merges the small array into the large one in one pass, and drops the erased entries and the
+  // ones the predicate returns true for
+  template <typename Predicate>
+  void Merge(Predicate remove)
+  {
+    m_merged.clear();
+    m_merged.reserve(m_items.size() + m_recent.size());
+
+    auto items = m_items.begin();
+    auto recent = m_recent.begin();
+    while (items != m_items.end() || recent != m_recent.end())
+    {
+      const bool from_items =
+          recent == m_recent.end() || (items != m_items.end() && items->address <= recent->address);
+      Item& item = from_items ? *items++ : *recent++;
+      if (item.erased)
+        continue;
+
+      if (remove(item.entry))
+      {
+        if (m_trace)
+          m_trace->Erase(item.entry.get());
+        --m_size;
+        continue;
+      }
+      m_merged.push_back(std::move(item));
+    }
+
+    // The removed entries are released last, in case releasing one calls back into the index
+    std::swap(m_items, m_merged);
+    m_recent.clear();
+    m_erased = 0;
+    m_merged.clear();
+  }
+
+  void ApplyDeferredChanges()
+  {
+    for (Item* item : m_erased_during_lookup)
+      item->entry.reset();
+    m_erased_during_lookup.clear();
+
+    for (Item& item : m_deferred)
+      InsertRecent(std::move(item));
+    m_deferred.clear();
+
+    if (m_erased > (m_items.size() + m_recent.size()) / 2)
+      Merge([](const Pointer&) { return false; });
+  }
+
+  // The large and the small array, both sorted by address
+  std::vector<Item> m_items;
+  std::vector<Item> m_recent;
+  // Kept to merge the arrays without allocating every time
+  std::vector<Item> m_merged;
+  // The changes made while a lookup is being iterated
+  std::vector<Item> m_deferred;
+  std::vector<Item*> m_erased_during_lookup;
+  u32 m_lookups = 0;
+
+  size_t m_size = 0;
+  // The erased entries still in the arrays
+  size_t m_erased = 0;
+  // The largest size of an entry since the last clear
+  u32 m_largest_size = 0;
+  TextureCacheTraceWriter* m_trace = nullptr;
+};
+
+// The texture cache entries by hash, in an open addressing hash table with linear probing. Several
+// entries can have the same hash, and are found in the order they were added.
+template <typename Entry>
+class TextureHashIndex
+{
+  struct Slot
+  {
+    u64 hash;
+    std::shared_ptr<Entry> entry;
+    bool erased;
+  };
+
+public:
+  using Pointer = std::shared_ptr<Entry>;
+
+  // Walks the run of slots from the home of the hash to the next empty one
+  class Iterator
+  {
+  public:
+    Iterator() = default;
+    Iterator(const TextureHashIndex& index, u64 hash)
+        : m_slots(index.m_slots.data()), m_mask(index.m_mask), m_hash(hash)
+    {
+      if (index.m_slots.empty())
+        return;
+
+      m_index = index.GetHome(hash);
+      Seek();
+    }
+
+    const Pointer& operator*() const { return m_current->entry; }
+    const Pointer* operator->() const { return &m_current->entry; }
+    Iterator& operator++()
+    {
+      m_index = (m_index + 1) & m_mask;
+      Seek();
+      return *this;
+    }
+    bool operator==(const Iterator& other) const { return m_current == other.m_current; }
+
+  private:
+    void Seek()
+    {
+      for (; m_slots[m_index].entry; m_index = (m_index + 1) & m_mask)
+      {
+        const Slot& slot = m_slots[m_index];
+        if (slot.hash == m_hash && !slot.erased)
+        {
+          m_current = &slot;
+          return;
+        }
+      }
+      m_current = nullptr;
+    }
+
+    const Slot* m_current = nullptr;
+    const Slot* m_slots = nullptr;
+    size_t m_mask = 0;
+    size_t m_index = 0;
+    u64 m_hash = 0;
+  };
+
+  using Range = TextureIndexRange<TextureHashIndex, Iterator>;
+
+  void Insert(u64 hash, Pointer entry)
+  {
+    if (m_trace)
+      m_trace->InsertHash(entry.get(), hash);
+
+    if (m_lookups != 0)
+      m_deferred.push_back(Slot{hash, std::move(entry), false});
+    else
+      InsertSlot(Slot{hash, std::move(entry), false});
+  }
+
+  // Returns false if the entry is not in the index
+  bool Erase(u64 hash, const Entry* entry)
+  {
+    const size_t index = FindSlot(hash, entry);
+    if (index != NOT_FOUND)
+    {
+      // The slot stays in place during a lookup, so the runs of slots the lookup walks don't move
+      if (m_lookups != 0)
+      {
+        m_slots[index].erased = true;
+        m_erased_during_lookup.emplace_back(hash, entry);
+      }
+      else
+      {
+        EraseSlot(index);
+      }
+    }
+    else
+    {
+      const auto iter =
+          std::find_if(m_deferred.begin(), m_deferred.end(),
+                       [entry](const Slot& slot) { return slot.entry.get() == entry; });
+      if (iter == m_deferred.end())
+        return false;
+      m_deferred.erase(iter);
+    }
+
+    if (m_trace)
+      m_trace->EraseHash(entry);
+    return true;
+  }
+
+  // The entries with the hash, in the order they were added
+  Range Find(u64 hash)
+  {
+    if (m_trace)
+      m_trace->FindHash(hash);
+
+    return Range(this, Iterator(*this, hash));
+  }
+
+  void Clear()
+  {
+    m_slots.clear();
+    m_deferred.clear();
+    m_erased_during_lookup.clear();
+    m_mask = 0;
+    m_size = 0;
+  }
+
+  size_t size() const { return m_size - m_erased_during_lookup.size() + m_deferred.size(); }
+  bool empty() const { return size() == 0; }
+
+  // Calls the function for every entry, in no particular order.
+  // Not allowed while a lookup is being iterated.
+  template <typename Function>
+  void ForEach(Function function) const
+  {
+    for (const Slot& slot : m_slots)
+    {
+      if (slot.entry && !slot.erased)
+        function(slot.hash, slot.entry);
+    }
+  }
+
+  void SetTrace(TextureCacheTraceWriter* trace) { m_trace = trace; }
+
+private:
+  template <typename, typename>
+  friend class TextureIndexRange;
+
+  static constexpr size_t MIN_SLOTS = 256;
+  static constexpr size_t NOT_FOUND = ~size_t(0);
+
+  size_t GetHome(u64 hash) const
+  {
+    // The hashes are often made from few bytes, so mix the high bits into the index
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> 32) & m_mask;
+  }
+
+  size_t FindSlot(u64 hash, const Entry* entry) const
+  {
+    if (m_slots.empty())
+      return NOT_FOUND;
+
+    for (size_t index = GetHome(hash); m_slots[index].entry; index = (index + 1) & m_mask)
+    {
+      if (m_slots[index].entry.get() == entry && !m_slots[index].erased)
+        return index;
+    }
+    return NOT_FOUND;
+  }
+
+  void InsertSlot(Slot slot)
+  {
+    if ((m_size + 1) * 2 > m_slots.size())
+      Grow();
+
+    size_t index = GetHome(slot.hash);
+    while (m_slots[index].entry)
+      index = (index + 1) & m_mask;
+    m_slots[index] = std::move(slot);
+    ++m_size;
+  }
+
+  void Grow()
+  {
+    std::vector<Slot> old_slots = std::move(m_slots);
+    m_slots = std::vector<Slot>(std::max(old_slots.size() * 2, MIN_SLOTS));
+    m_mask = m_slots.size() - 1;
+
+    // Reinserting in slot order keeps entries with the same hash in the order they were added.
+    // Start at an empty slot, so a run which wraps around the end is moved in order too.
+    const size_t start = FindEmpty(old_slots);
+    for (size_t i = 0; i < old_slots.size(); i++)
+    {
+      Slot& slot = old_slots[(start + i) & (old_slots.size() - 1)];
+      if (!slot.entry)
+        continue;
+
+      size_t index = GetHome(slot.hash);
+      while (m_slots[index].entry)
+        index = (index + 1) & m_mask;
+      m_slots[index] = std::move(slot);
+    }
+  }
+
+  static size_t FindEmpty(const std::vector<Slot>& slots)
+  {
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+      if (!slots[i].entry)
+        return i;
+    }
+    return 0;
+  }
+
+  // Removes a slot by moving the following slots of the run back, so no tombstones are needed
+  void EraseSlot(size_t index)
+  {
+    size_t next = (index + 1) & m_mask;
+    while (m_slots[next].entry)
+    {
+      // A slot can move back to the hole if its home is not between the hole and the slot
+      const size_t home = GetHome(m_slots[next].hash);
+      if (((next - home) & m_mask) >= ((next - index) & m_mask))
+      {
+        m_slots[index] = std::move(m_slots[next]);
+        index = next;
+      }
+      next = (next + 1) & m_mask;
+    }
+    m_slots[index] = Slot{};
+    --m_size;
+  }
+
+  void ApplyDeferredChanges()
+  {
+    for (const auto& [hash, entry] : m_erased_during_lookup)
+    {
+      for (size_t index = GetHome(hash); m_slots[index].entry; index = (index + 1) & m_mask)
+      {
+        if (m_slots[index].entry.get() == entry)
+        {
+          EraseSlot(index);
+          break;
+        }
+      }
+    }
+    m_erased_during_lookup.clear();
+
+    for (Slot& slot : m_deferred)
+      InsertSlot(std::move(slot));
+    m_deferred.clear();
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_mask = 0;
+  // The used slots, including the ones erased during a lookup
+  size_t m_size = 0;
+  // The changes made while a lookup is being iterated
+  std::vector<Slot> m_deferred;
+  std::vector<std::pair<u64, const Entry*>> m_erased_during_lookup;
+  u32 m_lookups = 0;
+  TextureCacheTraceWriter* m_trace = nullptr;
+};
+}  // namespace VideoCommon
@@ -0,0 +1,117 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/TextureCacheTrace.h"
+
+#include "Common/Logging/Log.h"
+
+namespace VideoCommon
+{
+static constexpr u32 TRACE_MAGIC = 0x54435444;  // "DTCT"
+static constexpr u32 TRACE_VERSION = 1;
+static constexpr size_t BUFFER_SIZE = 4096;
+
+using Op = TextureCacheTraceRecord::Op;
+
+TextureCacheTraceWriter::TextureCacheTraceWriter(const std::string& path) : m_file(path, "wb")
+{
+  if (!m_file.IsOpen())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to create texture cache trace {}", path);
+    return;
+  }
+
+  const u32 header[] = {TRACE_MAGIC, TRACE_VERSION};
+  m_file.WriteArray(header, std::size(header));
+  m_buffer.reserve(BUFFER_SIZE);
+}
+
+TextureCacheTraceWriter::~TextureCacheTraceWriter()
+{
+  Flush();
+}
+
+void TextureCacheTraceWriter::Clear()
+{
+  m_entry_ids.clear();
+  Add(Op::Clear, 0, 0, 0, 0);
+}
+
+void TextureCacheTraceWriter::Insert(const void* entry, u32 address, u32 size)
+{
+  // The memory of an erased entry can be reused for a new one, which gets a new ID
+  const u64 id = m_next_entry_id++;
+  m_entry_ids[entry] = id;
+  Add(Op::Insert, address, size, 0, id);
+}
+
+void TextureCacheTraceWriter::Erase(const void* entry)
+{
+  Add(Op::Erase, 0, 0, 0, GetEntryId(entry));
+}
+
+void TextureCacheTraceWriter::InsertHash(const void* entry, u64 hash)
+{
+  Add(Op::InsertHash, 0, 0, hash, GetEntryId(entry));
+}
+
+void TextureCacheTraceWriter::EraseHash(const void* entry)
+{
+  Add(Op::EraseHash, 0, 0, 0, GetEntryId(entry));
+}
+
+void TextureCacheTraceWriter::Find(u32 address)
+{
+  Add(Op::Find, address, 0, 0, 0);
+}
+
+void TextureCacheTraceWriter::FindOverlapping(u32 address, u32 size)
+{
+  Add(Op::FindOverlapping, address, size, 0, 0);
+}
+
+void TextureCacheTraceWriter::FindHash(u64 hash)
+{
+  Add(Op::FindHash, 0, 0, hash, 0);
+}
+
+void TextureCacheTraceWriter::Add(Op op, u32 address, u32 size, u64 hash, u64 entry)
+{
+  if (!m_file.IsOpen())
+    return;
+
+  m_buffer.push_back({op, address, size, 0, hash, entry});
+  if (m_buffer.size() == BUFFER_SIZE)
+    Flush();
+}
+
+u64 TextureCacheTraceWriter::GetEntryId(const void* entry) const
+{
+  const auto iter = m_entry_ids.find(entry);
+  return iter != m_entry_ids.end() ? iter->second : ~u64{0};
+}
+
+void TextureCacheTraceWriter::Flush()
+{
+  if (!m_buffer.empty())
+    m_file.WriteArray(m_buffer.data(), m_buffer.size());
+  m_buffer.clear();
+}
+
+std::optional<std::vector<TextureCacheTraceRecord>> LoadTextureCacheTrace(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  u32 header[2];
+  if (!file.ReadArray(header, std::size(header)) || header[0] != TRACE_MAGIC ||
+      header[1] != TRACE_VERSION)
+  {
+    return std::nullopt;
+  }
+
+  const u64 size = file.GetSize() - sizeof(header);
+  std::vector<TextureCacheTraceRecord> records(size / sizeof(TextureCacheTraceRecord));
+  if (!file.ReadArray(records.data(), records.size()))
+    return std::nullopt;
+  return records;
+}
+}  // namespace VideoCommon
@@ -0,0 +1,75 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace VideoCommon
+{
+// A log of the operations on the texture cache's indices, recorded while a game or FIFO log runs
+// so the indices can be benchmarked by replaying it. Entries are identified by the order in which
+// they were inserted.
+struct TextureCacheTraceRecord
+{
+  enum class Op : u32
+  {
+    Clear,
+    Insert,
+    Erase,
+    InsertHash,
+    EraseHash,
+    Find,
+    FindOverlapping,
+    FindHash,
+  };
+
+  Op op;
+  u32 address;
+  u32 size;
+  u32 padding;
+  u64 hash;
+  u64 entry;
+};
+static_assert(sizeof(TextureCacheTraceRecord) == 32);
+
+class TextureCacheTraceWriter
+{
+public:
+  explicit TextureCacheTraceWriter(const std::string& path);
+  ~TextureCacheTraceWriter();
+
+  TextureCacheTraceWriter(const TextureCacheTraceWriter&) = delete;
+  TextureCacheTraceWriter& operator=(const TextureCacheTraceWriter&) = delete;
+
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  void Clear();
+  void Insert(const void* entry, u32 address, u32 size);
+  void Erase(const void* entry);
+  void InsertHash(const void* entry, u64 hash);
+  void EraseHash(const void* entry);
+  void Find(u32 address);
+  void FindOverlapping(u32 address, u32 size);
+  void FindHash(u64 hash);
+
+private:
+  void Add(TextureCacheTraceRecord::Op op, u32 address, u32 size, u64 hash, u64 entry);
+  u64 GetEntryId(const void* entry) const;
+  void Flush();
+
+  File::IOFile m_file;
+  std::vector<TextureCacheTraceRecord> m_buffer;
+  // The ID of the entry last inserted at each address in memory
+  std::unordered_map<const void*, u64> m_entry_ids;
+  u64 m_next_entry_id = 0;
+};
+
+std::optional<std::vector<TextureCacheTraceRecord>> LoadTextureCacheTrace(const std::string& path);
+}  // namespace VideoCommon
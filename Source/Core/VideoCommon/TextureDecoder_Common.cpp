@@ -9,6 +9,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
+#include "VideoCommon/FrontendProfiler.h"
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureDecoder_Util.h"
@@ -298,6 +299,8 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt)
 {
+  FrontendProfiler::ScopedTimer timer(FrontendProfiler::Section::TextureDecode);
+
   _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
 
   if (TexFmt_Overlay_Enable)
@@ -667,6 +670,8 @@ void TexDecoder_DecodeTexelRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* sr
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height)
 {
+  FrontendProfiler::ScopedTimer timer(FrontendProfiler::Section::TextureDecode);
+
   // TODO for someone who cares: Make this less slow!
   for (int y = 0; y < height; ++y)
   {
@@ -18,6 +18,8 @@ class VertexLoaderUID
   size_t hash = 0;
 
 public:
+  using Data = std::array<u32, 5>;
+
   VertexLoaderUID() {}
   VertexLoaderUID(const TVtxDesc& vtx_desc, const VAT& vat)
   {
@@ -28,9 +30,27 @@ public:
     vid[4] = vat.g2.Hex;
     hash = CalculateHash();
   }
+  explicit VertexLoaderUID(const Data& data) : vid(data), hash(CalculateHash()) {}
 
   bool operator==(const VertexLoaderUID& rh) const { return vid == rh.vid; }
   size_t GetHash() const { return hash; }
+  const Data& GetData() const { return vid; }
+
+  TVtxDesc GetVtxDesc() const
+  {
+    TVtxDesc vtx_desc;
+    vtx_desc.low.Hex = vid[0];
+    vtx_desc.high.Hex = vid[1];
+    return vtx_desc;
+  }
+  VAT GetVAT() const
+  {
+    VAT vat;
+    vat.g0.Hex = vid[2];
+    vat.g1.Hex = vid[3];
+    vat.g2.Hex = vid[4];
+    return vat;
+  }
 
 private:
   size_t CalculateHash() const
@@ -70,6 +90,8 @@ public:
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
   int m_numLoadedVertices = 0;
+  int m_numSampledVertices = 0;
+  bool m_precompiled = false;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
@@ -15,6 +15,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/DolphinAnalytics.h"
@@ -25,8 +26,10 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrontendProfiler.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -52,6 +55,10 @@ static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
+// The layouts of the loaders used by the game, so that they can be compiled before they're needed.
+// The generated code refers to the addresses of this process, so it is compiled again every boot.
+static Common::LinearDiskCache<VertexLoaderUID::Data, u8> s_vertex_loader_disk_cache;
+
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
 BitSet8 g_main_vat_dirty;
@@ -61,21 +68,77 @@ std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_main_vertex_loaders;
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_preprocess_vertex_loaders;
 bool g_needs_cp_xf_consistency_check;
 
+static void LoadVertexLoaderCache()
+{
+  class CacheReader : public Common::LinearDiskCacheReader<VertexLoaderUID::Data, u8>
+  {
+  public:
+    void Read(const VertexLoaderUID::Data& key, const u8* value, u32 value_size) override
+    {
+      const VertexLoaderUID uid(key);
+      auto [it, added] = s_vertex_loader_map.try_emplace(
+          uid, VertexLoaderBase::CreateVertexLoader(uid.GetVtxDesc(), uid.GetVAT()));
+      if (!added)
+        return;
+
+      it->second->m_precompiled = true;
+      INCSTAT(g_stats.num_vertex_loaders);
+      INCSTAT(g_stats.num_vertex_loaders_precompiled);
+    }
+  };
+
+  const std::string filename =
+      GetDiskShaderCacheFileName(APIType::Nothing, "VertexLoaders", true, false, false);
+  CacheReader reader;
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  const u32 count = s_vertex_loader_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(VIDEO, "Compiled {} cached vertex loaders from {}", count, filename);
+}
+
 void Init()
 {
   MarkAllDirty();
   g_main_vertex_loaders.fill(nullptr);
   g_preprocess_vertex_loaders.fill(nullptr);
   SETSTAT(g_stats.num_vertex_loaders, 0);
+  SETSTAT(g_stats.num_vertex_loaders_precompiled, 0);
+
+  if (g_Config.bShaderCache)
+    LoadVertexLoaderCache();
 }
 
 void Clear()
 {
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_vertex_loader_disk_cache.Sync();
+  s_vertex_loader_disk_cache.Close();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
 
+std::vector<LoaderStatistics> SampleLoaderStatistics()
+{
+  std::vector<LoaderStatistics> statistics;
+  {
+    std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+    statistics.reserve(s_vertex_loader_map.size());
+    for (const auto& [uid, loader] : s_vertex_loader_map)
+    {
+      const int loaded = loader->m_numLoadedVertices;
+      statistics.push_back(
+          {uid.GetData(), loader->m_vertex_size, loaded - loader->m_numSampledVertices,
+           loader->m_precompiled});
+      loader->m_numSampledVertices = loaded;
+    }
+  }
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const LoaderStatistics& a, const LoaderStatistics& b) {
+              return a.sampled_vertices > b.sampled_vertices;
+            });
+  return statistics;
+}
+
 void UpdateVertexArrayPointers()
 {
   // Anything to update?
@@ -213,6 +276,8 @@ VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group)
 
   VertexLoaderUID uid(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  if constexpr (!IsPreprocess)
+    INCSTAT(g_stats.this_frame.num_vertex_loader_lookups);
   VertexLoaderMap::iterator iter = s_vertex_loader_map.find(uid);
   if (iter != s_vertex_loader_map.end())
   {
@@ -226,6 +291,9 @@ VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group)
         VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]));
     loader = it->second.get();
     INCSTAT(g_stats.num_vertex_loaders);
+    if constexpr (!IsPreprocess)
+      INCSTAT(g_stats.this_frame.num_vertex_loaders_compiled);
+    s_vertex_loader_disk_cache.Append(uid.GetData(), nullptr, 0);
   }
   if (check_for_native_format)
   {
@@ -328,6 +396,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     return 0;
   ASSERT(count > 0);
 
+  FrontendProfiler::ScopedTimer timer(FrontendProfiler::Section::RunVertices);
+
   VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
 
   int size = count * loader->m_vertex_size;
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
@@ -25,9 +26,22 @@ namespace VertexLoaderManager
 using NativeVertexFormatMap =
     std::unordered_map<PortableVertexDeclaration, std::unique_ptr<NativeVertexFormat>>;
 
+// Also compiles the vertex loaders the game used in previous sessions, if the shader cache is
+// enabled. New loaders are appended to the same cache file while the game runs.
 void Init();
 void Clear();
 
+struct LoaderStatistics
+{
+  std::array<u32, 5> uid;
+  u32 vertex_size;
+  int sampled_vertices;
+  bool precompiled;
+};
+
+// Returns the vertices each loader has loaded since the previous call, busiest loaders first
+std::vector<LoaderStatistics> SampleLoaderStatistics();
+
 void MarkAllDirty();
 
 // Creates or obtains a pointer to a VertexFormat representing decl.
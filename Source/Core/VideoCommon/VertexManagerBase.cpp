@@ -23,6 +23,7 @@
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/FrontendProfiler.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/CustomShaderCache.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
@@ -122,9 +123,10 @@ bool VertexManagerBase::Initialize()
   m_after_present_event = AfterPresentEvent::Register(
       [this](const PresentInfo& pi) { m_ticks_elapsed = pi.emulated_timestamp; },
       "VertexManagerBase");
-  m_index_generator.Init();
+  m_batch_workers.Start(BatchWorkerPool::GetDefaultWorkerCount());
+  m_index_generator.Init(&m_batch_workers);
   m_custom_shader_cache = std::make_unique<CustomShaderCache>();
-  m_cpu_cull.Init();
+  m_cpu_cull.Init(&m_batch_workers);
   return true;
 }
 
@@ -791,28 +793,31 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  VertexShaderUid vs_uid = GetVertexShaderUid();
-  if (vs_uid != m_current_pipeline_config.vs_uid)
   {
-    m_current_pipeline_config.vs_uid = vs_uid;
-    m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
-    m_pipeline_config_changed = true;
-  }
+    FrontendProfiler::ScopedTimer timer(FrontendProfiler::Section::ShaderUid);
+    VertexShaderUid vs_uid = GetVertexShaderUid();
+    if (vs_uid != m_current_pipeline_config.vs_uid)
+    {
+      m_current_pipeline_config.vs_uid = vs_uid;
+      m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
+      m_pipeline_config_changed = true;
+    }
 
-  PixelShaderUid ps_uid = GetPixelShaderUid();
-  if (ps_uid != m_current_pipeline_config.ps_uid)
-  {
-    m_current_pipeline_config.ps_uid = ps_uid;
-    m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
-    m_pipeline_config_changed = true;
-  }
+    PixelShaderUid ps_uid = GetPixelShaderUid();
+    if (ps_uid != m_current_pipeline_config.ps_uid)
+    {
+      m_current_pipeline_config.ps_uid = ps_uid;
+      m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
+      m_pipeline_config_changed = true;
+    }
 
-  GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
-  if (gs_uid != m_current_pipeline_config.gs_uid)
-  {
-    m_current_pipeline_config.gs_uid = gs_uid;
-    m_current_uber_pipeline_config.gs_uid = gs_uid;
-    m_pipeline_config_changed = true;
+    GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
+    if (gs_uid != m_current_pipeline_config.gs_uid)
+    {
+      m_current_pipeline_config.gs_uid = gs_uid;
+      m_current_uber_pipeline_config.gs_uid = gs_uid;
+      m_pipeline_config_changed = true;
+    }
   }
 
   if (m_rasterization_state_changed)
@@ -915,7 +920,7 @@ void VertexManagerBase::UpdatePipelineObject()
 void VertexManagerBase::OnConfigChange()
 {
   // Reload index generator function tables in case VS expand config changed
-  m_index_generator.Init();
+  m_index_generator.Init(&m_batch_workers);
 }
 
 void VertexManagerBase::OnDraw()
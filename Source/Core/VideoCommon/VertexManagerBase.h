@@ -214,6 +214,8 @@ protected:
   bool m_blending_state_changed = true;
   bool m_cull_all = false;
 
+  // Helps the index generator and CPU culling with large batches
+  BatchWorkerPool m_batch_workers;
   IndexGenerator m_index_generator;
   CPUCull m_cpu_cull;
 
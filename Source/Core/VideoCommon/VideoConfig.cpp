@@ -153,6 +153,7 @@ void VideoConfig::Refresh()
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -279,6 +280,15 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return 1;
 }
 
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads >= 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+
+  // Automatic number. Leave a core for the CPU thread, the GPU thread draws too.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 1, 1, 16));
+}
+
 void CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
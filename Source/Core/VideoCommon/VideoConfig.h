@@ -265,6 +265,11 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of threads the software renderer draws with.
+  // 0 and 1 draw on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 0;
+
   // Loading custom drivers on Android
   std::string customDriverLibraryName;
 
@@ -371,6 +376,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
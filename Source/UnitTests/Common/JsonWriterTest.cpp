@@ -0,0 +1,113 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/JsonWriter.h"
+
+TEST(JsonWriter, EmptyContainers)
+{
+  Common::JsonWriter writer;
+  writer.BeginObject();
+  writer.BeginArray("a");
+  writer.EndArray();
+  writer.BeginObject("o");
+  writer.EndObject();
+  writer.EndObject();
+
+  EXPECT_EQ("{\n  \"a\": [],\n  \"o\": {}\n}\n", writer.GetString());
+}
+
+TEST(JsonWriter, NestedLayout)
+{
+  Common::JsonWriter writer;
+  writer.BeginObject();
+  writer.Field("Name", "Mario");
+  writer.BeginArray("Values");
+  writer.Value(1);
+  writer.Value(2);
+  writer.EndArray();
+  writer.EndObject();
+
+  EXPECT_EQ("{\n"
+            "  \"Name\": \"Mario\",\n"
+            "  \"Values\": [\n"
+            "    1,\n"
+            "    2\n"
+            "  ]\n"
+            "}\n",
+            writer.GetString());
+}
+
+TEST(JsonWriter, Numbers)
+{
+  Common::JsonWriter writer;
+  writer.BeginArray();
+  writer.Value(u8{200});
+  writer.Value(s8{-5});
+  writer.Value(u16{65535});
+  writer.Value(u32{0xFFFFFFFF});
+  writer.Value(0.5f);
+  writer.Value(std::numeric_limits<float>::quiet_NaN());
+  writer.Value(std::numeric_limits<float>::infinity());
+  writer.EndArray();
+
+  picojson::value value;
+  ASSERT_TRUE(picojson::parse(value, writer.GetString()).empty());
+  const picojson::array& array = value.get<picojson::array>();
+  ASSERT_EQ(7u, array.size());
+  EXPECT_EQ(200, array[0].get<double>());
+  EXPECT_EQ(-5, array[1].get<double>());
+  EXPECT_EQ(65535, array[2].get<double>());
+  EXPECT_EQ(4294967295.0, array[3].get<double>());
+  EXPECT_EQ(0.5, array[4].get<double>());
+  EXPECT_TRUE(array[5].is<picojson::null>());
+  EXPECT_TRUE(array[6].is<picojson::null>());
+}
+
+TEST(JsonWriter, EscapesStrings)
+{
+  Common::JsonWriter writer;
+  writer.BeginObject();
+  writer.Field("Quote \"Key\"", "back\\slash\nnew line\x01");
+  writer.EndObject();
+
+  picojson::value value;
+  ASSERT_TRUE(picojson::parse(value, writer.GetString()).empty());
+  EXPECT_EQ("back\\slash\nnew line\x01",
+            value.get("Quote \"Key\"").get<std::string>());
+}
+
+TEST(JsonWriter, RawValues)
+{
+  Common::JsonWriter writer;
+  writer.BeginObject();
+  writer.RawField("Decoded", "\"Mario\"");
+  writer.RawField("Raw", "0");
+  writer.EndObject();
+
+  EXPECT_EQ("{\n  \"Decoded\": \"Mario\",\n  \"Raw\": 0\n}\n", writer.GetString());
+}
+
+TEST(JsonWriter, ResetKeepsCapacity)
+{
+  Common::JsonWriter writer(4096);
+  writer.BeginObject();
+  writer.Field("Key", "Value");
+  writer.EndObject();
+
+  const size_t capacity = writer.GetString().capacity();
+  writer.Reset();
+  EXPECT_TRUE(writer.GetString().empty());
+  EXPECT_EQ(capacity, writer.GetString().capacity());
+
+  writer.BeginArray();
+  writer.EndArray();
+  EXPECT_EQ("[]\n", writer.GetString());
+}
@@ -0,0 +1,148 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "AudioCommon/Mixer.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+
+namespace
+{
+constexpr u32 OUTPUT_RATE = 48000;
+constexpr u32 DMA_RATE = 32000;
+// The audio backend asks for 512 frames at a time, the DSP pushes 5ms of audio at a time
+constexpr u32 OUTPUT_FRAMES = 512;
+constexpr u32 DMA_FRAMES = DMA_RATE / 200;
+constexpr s16 LEFT_VALUE = 1000;
+constexpr s16 RIGHT_VALUE = -2000;
+
+struct LatencyResult
+{
+  double mean_ms = 0;
+  double jitter_ms = 0;
+  u64 underruns = 0;
+  u32 target_ms = 0;
+  bool output_matches_input = true;
+};
+
+// Plays the DMA stream of an emulated console whose clock is drift times as fast as the host's,
+// and whose pushes are late by up to jitter_ms. Every stall_interval_s the emulation stalls for
+// stall_ms and then catches up. The buffered latency and underruns are measured after warmup_s.
+LatencyResult Simulate(Mixer& mixer, double seconds, double warmup_s, double drift,
+                       double jitter_ms, double stall_interval_s = 0, double stall_ms = 0)
+{
+  std::mt19937 rng(0x4D495852);
+  std::uniform_real_distribution<double> jitter(0.0, jitter_ms / 1000.0);
+
+  std::array<short, DMA_FRAMES * 2> dma_samples;
+  for (u32 i = 0; i < DMA_FRAMES; ++i)
+  {
+    dma_samples[i * 2] = Common::swap16(LEFT_VALUE);
+    dma_samples[i * 2 + 1] = Common::swap16(RIGHT_VALUE);
+  }
+  std::vector<short> output(OUTPUT_FRAMES * 2);
+
+  const double push_interval = DMA_FRAMES / (DMA_RATE * drift);
+  const double mix_interval = OUTPUT_FRAMES / static_cast<double>(OUTPUT_RATE);
+  double next_push = 0;
+  double last_push = 0;
+  double next_mix = mix_interval;
+  u64 pushes = 0;
+
+  LatencyResult result;
+  u64 warmup_underruns = 0;
+  std::vector<double> latencies;
+  while (next_mix < seconds)
+  {
+    if (next_push <= next_mix)
+    {
+      mixer.PushSamples(dma_samples.data(), DMA_FRAMES);
+      ++pushes;
+
+      // Emulation is sequential, so a late push delays the ones after it
+      double scheduled = pushes * push_interval + jitter(rng);
+      if (stall_interval_s > 0 && std::fmod(scheduled, stall_interval_s) < stall_ms / 1000.0)
+        scheduled += stall_ms / 1000.0 - std::fmod(scheduled, stall_interval_s);
+      last_push = std::max(last_push, scheduled);
+      next_push = last_push;
+      continue;
+    }
+
+    // The latency is measured when the backend asks for audio, like the mixer does
+    const u32 buffered_ms = mixer.GetDMAStatistics().buffered_ms;
+    mixer.Mix(output.data(), OUTPUT_FRAMES);
+    next_mix += mix_interval;
+
+    const Mixer::FifoStatistics statistics = mixer.GetDMAStatistics();
+    if (next_mix < warmup_s)
+    {
+      warmup_underruns = statistics.underruns;
+      continue;
+    }
+
+    latencies.push_back(buffered_ms);
+    result.underruns = statistics.underruns - warmup_underruns;
+    result.target_ms = statistics.target_ms;
+    for (u32 i = 0; i < OUTPUT_FRAMES; ++i)
+    {
+      if (output[i * 2] != RIGHT_VALUE || output[i * 2 + 1] != LEFT_VALUE)
+        result.output_matches_input = false;
+    }
+  }
+
+  for (double latency : latencies)
+    result.mean_ms += latency / latencies.size();
+  for (double latency : latencies)
+    result.jitter_ms += (latency - result.mean_ms) * (latency - result.mean_ms) / latencies.size();
+  result.jitter_ms = std::sqrt(result.jitter_ms);
+  return result;
+}
+
+class AudioMixerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    Config::SetCurrent(Config::MAIN_AUDIO_BUFFER_DEPTH, 40);
+  }
+  void TearDown() override { Config::Shutdown(); }
+};
+}  // namespace
+
+TEST_F(AudioMixerTest, LatencyConvergesToBufferDepth)
+{
+  for (double drift : {1.0, 1.001, 0.999, 1.003, 0.997})
+  {
+    Mixer mixer(OUTPUT_RATE);
+    const LatencyResult result = Simulate(mixer, 90, 30, drift, 3);
+
+    EXPECT_EQ(40u, result.target_ms) << "drift " << drift;
+    EXPECT_NEAR(40.0, result.mean_ms, 3.0) << "drift " << drift;
+    EXPECT_LT(result.jitter_ms, 5.0) << "drift " << drift;
+    EXPECT_EQ(0u, result.underruns) << "drift " << drift;
+    EXPECT_TRUE(result.output_matches_input) << "drift " << drift;
+  }
+}
+
+TEST_F(AudioMixerTest, UnderrunsGrowBufferDepth)
+{
+  // 20ms of buffer can't cover the 40ms stalls, so underruns have to make the buffer deeper
+  Config::SetCurrent(Config::MAIN_AUDIO_BUFFER_DEPTH, 20);
+  Mixer mixer(OUTPUT_RATE);
+  const LatencyResult early = Simulate(mixer, 10, 0, 1.0, 3, 0.5, 40);
+  EXPECT_GT(early.underruns, 0u);
+
+  const LatencyResult late = Simulate(mixer, 20, 5, 1.0, 3, 0.5, 40);
+  EXPECT_GT(late.target_ms, 20u);
+  EXPECT_LT(late.underruns, early.underruns);
+}
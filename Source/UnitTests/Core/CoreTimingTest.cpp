@@ -3,9 +3,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -401,3 +404,103 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, EventQueueOrder)
+{
+  std::array<CoreTiming::EventType, 4> types;
+  CoreTiming::EventQueue queue;
+  std::vector<CoreTiming::Event> expected;
+  std::mt19937_64 rng(1234);
+  u64 fifo_order = 0;
+  s64 now = -5000;
+
+  // Spread the events over every level of the wheel, past its end, and into the past
+  const auto push = [&] {
+    const int bits = std::uniform_int_distribution<int>(0, 40)(rng);
+    const s64 delay = static_cast<s64>(rng() & ((u64{1} << bits) - 1)) - 100;
+    const CoreTiming::Event event{now + delay, fifo_order++, rng(), &types[rng() % types.size()]};
+    queue.Push(event);
+    expected.push_back(event);
+  };
+  const auto sort_expected = [&] {
+    std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+      return std::tie(a.time, a.fifo_order) < std::tie(b.time, b.fifo_order);
+    });
+  };
+
+  for (int round = 0; round < 20000; ++round)
+  {
+    const u64 action = rng() % 16;
+    if (action < 9 || expected.empty())
+    {
+      push();
+    }
+    else if (action < 15)
+    {
+      sort_expected();
+      const CoreTiming::Event& front = queue.Front();
+      EXPECT_EQ(expected.front().time, front.time);
+      EXPECT_EQ(expected.front().fifo_order, front.fifo_order);
+      now = std::max(now, front.time);
+      queue.PopFront();
+      expected.erase(expected.begin());
+    }
+    else
+    {
+      CoreTiming::EventType* type = &types[rng() % types.size()];
+      const size_t count = std::erase_if(expected, [&](const auto& e) { return e.type == type; });
+      EXPECT_EQ(count, queue.RemoveAll(type));
+    }
+    ASSERT_EQ(expected.size(), queue.Size());
+  }
+
+  sort_expected();
+  const std::vector<CoreTiming::Event> events = queue.GetSortedEvents();
+  ASSERT_EQ(expected.size(), events.size());
+  for (size_t i = 0; i < events.size(); ++i)
+    EXPECT_EQ(expected[i].fifo_order, events[i].fifo_order);
+
+  queue.Clear();
+  EXPECT_TRUE(queue.IsEmpty());
+  for (const CoreTiming::EventType& type : types)
+    EXPECT_EQ(UINT32_MAX, type.last_queued_event);
+}
+
+TEST(CoreTiming, EventStatistics)
+{
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+
+  CoreTiming::EventType* cb_a = core_timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = core_timing.RegisterEvent("callbackB", CallbackTemplate<1>);
+
+  // Enter slice 0
+  core_timing.Advance();
+  core_timing.SampleEventStatistics();
+
+  core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
+  core_timing.ScheduleEvent(200, cb_b, CB_IDS[1]);
+  core_timing.ScheduleEvent(300, cb_b, CB_IDS[1]);
+  core_timing.RemoveEvent(cb_b);
+  AdvanceAndCheck(system, 0, MAX_SLICE_LENGTH);
+
+  std::vector<CoreTiming::EventStatistics> statistics = core_timing.SampleEventStatistics();
+  std::sort(statistics.begin(), statistics.end(),
+            [](const auto& a, const auto& b) { return a.name < b.name; });
+  ASSERT_EQ(2u, statistics.size());
+  EXPECT_EQ("callbackA", statistics[0].name);
+  EXPECT_EQ(1u, statistics[0].schedule_count);
+  EXPECT_EQ(0u, statistics[0].remove_count);
+  EXPECT_EQ(1u, statistics[0].callback_count);
+  EXPECT_EQ("callbackB", statistics[1].name);
+  EXPECT_EQ(2u, statistics[1].schedule_count);
+  EXPECT_EQ(2u, statistics[1].remove_count);
+  EXPECT_EQ(0u, statistics[1].callback_count);
+
+  // Only what happened since the previous sample is counted
+  EXPECT_TRUE(core_timing.SampleEventStatistics().empty());
+}
@@ -0,0 +1,195 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixer.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+// The resampler as it was before it was split into reading and filtering, which reads and
+// filters one sample at a time
+u32 ReferenceResample(const std::vector<s16>& stream, u32* read_count, s16* output, u32 count,
+                      s16* last_samples, u32 curr_pos, u32 ratio, const s16* coeffs)
+{
+  s16 temp[4];
+  u32 idx = 0;
+  for (u32 i = 0; i < 4; ++i)
+    temp[idx++ & 3] = last_samples[i];
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    while (curr_pos >= 0x10000)
+    {
+      temp[idx++ & 3] = stream[(*read_count)++];
+      curr_pos -= 0x10000;
+    }
+
+    const s32 t0 = temp[idx++ & 3];
+    const s32 t1 = temp[idx++ & 3];
+    const s32 t2 = temp[idx++ & 3];
+    const s32 t3 = temp[idx++ & 3];
+    if (coeffs)
+    {
+      const s16* c = &coeffs[((curr_pos & 0xFFFF) >> 9) << 2];
+      const s64 samp = (s64{t0} * c[0] + s64{t1} * c[1] + s64{t2} * c[2] + s64{t3} * c[3]) >> 15;
+      output[i] = MathUtil::SaturatingCast<s16>(samp);
+    }
+    else
+    {
+      const u16 curr_frac = curr_pos & 0xFFFF;
+      const u16 inv_curr_frac = -curr_frac;
+      output[i] = curr_frac ? static_cast<s16>((t0 * inv_curr_frac + t1 * curr_frac) >> 16) : t0;
+    }
+  }
+
+  for (u32 i = 4; i > 0; --i)
+    last_samples[i - 1] = temp[--idx & 3];
+  return curr_pos;
+}
+
+// The parameters of one voice of a PB list
+struct Voice
+{
+  u32 count;
+  u32 ratio;
+  u32 curr_pos;
+  std::array<s16, 4> last_samples;
+  u16 volume;
+  u16 volume_delta;
+};
+
+class AXMixerTest : public testing::Test
+{
+protected:
+  s16 RandomSample()
+  {
+    // Favour the extremes, where saturation and overflow happen
+    switch (m_rng() % 8)
+    {
+    case 0:
+      return -32768;
+    case 1:
+      return 32767;
+    default:
+      return static_cast<s16>(m_rng());
+    }
+  }
+
+  Voice RandomVoice()
+  {
+    static constexpr std::array<u32, 6> COUNTS = {32, 96, 18, 6, 5, 1};
+    // Common sample rate ratios, and ones high enough to make the resampler flush its buffer
+    static constexpr std::array<u32, 6> RATIOS = {0x10000, 0x8000, 0x5555, 0x15F90, 0x55555,
+                                                  0x123456};
+    Voice voice;
+    voice.count = COUNTS[m_rng() % COUNTS.size()];
+    voice.ratio = m_rng() % 2 ? RATIOS[m_rng() % RATIOS.size()] : m_rng() % 0x50000;
+    voice.curr_pos = m_rng() % 0x10000;
+    for (s16& sample : voice.last_samples)
+      sample = RandomSample();
+    voice.volume = static_cast<u16>(m_rng());
+    voice.volume_delta = m_rng() % 2 ? 0 : static_cast<u16>(m_rng());
+    return voice;
+  }
+
+  std::vector<s16> RandomStream(u32 size)
+  {
+    std::vector<s16> stream(size);
+    std::generate(stream.begin(), stream.end(), [this] { return RandomSample(); });
+    return stream;
+  }
+
+  std::mt19937 m_rng{0x41584D58};
+};
+}  // namespace
+
+TEST_F(AXMixerTest, ResampleMatchesReference)
+{
+  // Coefficient tables with the extreme values the madd overflow handling has to get right
+  std::vector<s16> coeffs = RandomStream(0x800);
+  std::fill_n(coeffs.begin(), 8, -32768);
+
+  for (int round = 0; round < 3000; ++round)
+  {
+    const Voice voice = RandomVoice();
+    const bool polyphase = round % 2 == 0;
+    const s16* voice_coeffs = polyphase ? &coeffs[(m_rng() % 4) * 0x200] : nullptr;
+    const std::vector<s16> stream = RandomStream(voice.count * (voice.ratio / 0x10000 + 1) + 1);
+
+    std::array<s16, AXMixer::MAX_OUTPUT_SAMPLES> expected;
+    std::array<s16, 4> expected_last = voice.last_samples;
+    u32 expected_reads = 0;
+    const u32 expected_pos =
+        ReferenceResample(stream, &expected_reads, expected.data(), voice.count,
+                          expected_last.data(), voice.curr_pos, voice.ratio, voice_coeffs);
+
+    for (auto set : {AXMixer::InstructionSet::Scalar, AXMixer::InstructionSet::SSE41})
+    {
+      if (!AXMixer::IsSupported(set))
+        continue;
+
+      std::array<s16, AXMixer::MAX_OUTPUT_SAMPLES> output;
+      std::array<s16, 4> last = voice.last_samples;
+      u32 reads = 0;
+      const u32 pos = AXMixer::Resample(
+          AXMixer::GetFunctions(set), [&](u32 i) { return stream[reads++]; }, output.data(),
+          voice.count, last.data(), voice.curr_pos, voice.ratio, voice_coeffs);
+
+      const auto end = output.begin() + voice.count;
+      EXPECT_TRUE(std::equal(output.begin(), end, expected.begin()))
+          << "round " << round << " instruction set " << static_cast<int>(set);
+      EXPECT_EQ(expected_last, last);
+      EXPECT_EQ(expected_pos, pos);
+      EXPECT_EQ(expected_reads, reads);
+    }
+  }
+}
+
+TEST_F(AXMixerTest, VolumeAndMixMatchScalar)
+{
+  if (!AXMixer::IsSupported(AXMixer::InstructionSet::SSE41))
+    GTEST_SKIP() << "No SIMD implementation on this CPU";
+
+  const AXMixer::Functions& scalar = AXMixer::GetFunctions(AXMixer::InstructionSet::Scalar);
+  const AXMixer::Functions& simd = AXMixer::GetFunctions(AXMixer::InstructionSet::SSE41);
+
+  for (int round = 0; round < 3000; ++round)
+  {
+    const Voice voice = RandomVoice();
+    const bool signed_volume = round % 2 == 0;
+    const std::vector<s16> input = RandomStream(voice.count);
+
+    std::vector<s16> scalar_samples = input;
+    std::vector<s16> simd_samples = input;
+    EXPECT_EQ(scalar.apply_volume(scalar_samples.data(), voice.count, voice.volume,
+                                  voice.volume_delta, signed_volume),
+              simd.apply_volume(simd_samples.data(), voice.count, voice.volume,
+                                voice.volume_delta, signed_volume));
+    EXPECT_EQ(scalar_samples, simd_samples) << "round " << round;
+
+    std::vector<int> scalar_bus(voice.count, static_cast<int>(m_rng()));
+    std::vector<int> simd_bus = scalar_bus;
+    u16 scalar_volume = voice.volume;
+    u16 simd_volume = voice.volume;
+    s16 scalar_dpop = 0;
+    s16 simd_dpop = 0;
+    scalar.mix_add(scalar_bus.data(), input.data(), voice.count, &scalar_volume,
+                   voice.volume_delta, &scalar_dpop);
+    simd.mix_add(simd_bus.data(), input.data(), voice.count, &simd_volume, voice.volume_delta,
+                 &simd_dpop);
+    EXPECT_EQ(scalar_bus, simd_bus) << "round " << round;
+    EXPECT_EQ(scalar_volume, simd_volume);
+    EXPECT_EQ(scalar_dpop, simd_dpop);
+  }
+}
@@ -0,0 +1,182 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonPaths.h"
+#include "Common/Config/Config.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/NetplaySettings.h"
+#include "Core/NetPlayDesyncDetector.h"
+#include "UICommon/UICommon.h"
+
+using NetPlay::DesyncDetector;
+
+namespace
+{
+constexpr u32 RAM_SIZE = 0x2000;
+constexpr char REGIONS[] = "First:0x80000100:0x400; Second:0x80001000:0x300";
+
+// Two players connected through a fake server, which forwards each message to the other player
+// tagged with the sender, like NetPlayServer does.
+class DesyncDetectorTest : public testing::Test
+{
+protected:
+  struct Player
+  {
+    NetPlay::PlayerId pid;
+    std::vector<u8> ram = std::vector<u8>(RAM_SIZE);
+    std::unique_ptr<DesyncDetector> detector;
+    std::optional<u64> desync_frame;
+  };
+
+  DesyncDetectorTest() : m_profile_path(File::CreateTempDir())
+  {
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+
+    for (NetPlay::PlayerId pid : {1, 2})
+    {
+      Player& player = m_players[pid - 1];
+      player.pid = pid;
+      player.detector = std::make_unique<DesyncDetector>(
+          *DesyncDetector::ParseRegions(REGIONS),
+          [this, pid](sf::Packet&& packet) { m_queue.emplace_back(pid, std::move(packet)); },
+          [&player](u64 frame, NetPlay::PlayerId) { player.desync_frame = frame; });
+      for (size_t i = 0; i < player.ram.size(); ++i)
+        player.ram[i] = static_cast<u8>(i * 7);
+    }
+  }
+
+  ~DesyncDetectorTest() override
+  {
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void RunFrames(u64 count)
+  {
+    for (u64 i = 0; i < count; ++i, ++m_frame)
+    {
+      for (Player& player : m_players)
+        player.detector->OnFrame(player.ram, m_frame);
+      Deliver();
+    }
+  }
+
+  void Deliver()
+  {
+    while (!m_queue.empty())
+    {
+      auto [from, packet] = std::move(m_queue.front());
+      m_queue.pop_front();
+
+      const u8* data = static_cast<const u8*>(packet.getData());
+      const auto mid = static_cast<NetPlay::MessageID>(data[0]);
+      sf::Packet body;
+      body.append(data + 1, packet.getDataSize() - 1);
+
+      DesyncDetector& to = *m_players[from == 1 ? 1 : 0].detector;
+      switch (mid)
+      {
+      case NetPlay::MessageID::DesyncDigests:
+        to.OnDigests(from, body);
+        break;
+      case NetPlay::MessageID::DesyncHashes:
+        to.OnHashes(from, body);
+        break;
+      case NetPlay::MessageID::DesyncBlocks:
+        to.OnBlocks(from, body);
+        break;
+      default:
+        ADD_FAILURE() << "Unexpected message " << static_cast<int>(mid);
+      }
+    }
+  }
+
+  std::vector<std::string> GetDumps() const
+  {
+    return Common::DoFileSearch({File::GetUserPath(D_DUMP_IDX) + "Desync"}, {".txt"});
+  }
+
+  std::string m_profile_path;
+  std::array<Player, 2> m_players;
+  std::deque<std::pair<NetPlay::PlayerId, sf::Packet>> m_queue;
+  u64 m_frame = DesyncDetector::FIRST_FRAME;
+};
+}  // namespace
+
+TEST(DesyncDetector, ParseRegions)
+{
+  const auto regions = DesyncDetector::ParseRegions(REGIONS);
+  ASSERT_TRUE(regions.has_value());
+  ASSERT_EQ(2u, regions->size());
+  EXPECT_EQ("First", (*regions)[0].name);
+  EXPECT_EQ(0x80000100u, (*regions)[0].address);
+  EXPECT_EQ(0x400u, (*regions)[0].size);
+  EXPECT_EQ("Second", (*regions)[1].name);
+
+  EXPECT_FALSE(DesyncDetector::ParseRegions("Missing size:0x80000000").has_value());
+  EXPECT_FALSE(DesyncDetector::ParseRegions("Bad:address:0x10").has_value());
+  EXPECT_FALSE(DesyncDetector::ParseRegions("Empty:0x80000000:0").has_value());
+
+  // The end of the region would wrap around in 32 bits
+  EXPECT_FALSE(DesyncDetector::ParseRegions("Wrap:0x81000000:0xFF000010").has_value());
+  EXPECT_FALSE(DesyncDetector::ParseRegions("Past MEM1:0x83FFFF00:0x200").has_value());
+  EXPECT_TRUE(DesyncDetector::ParseRegions("End of MEM1:0x83FFFF00:0x100").has_value());
+  EXPECT_FALSE(
+      DesyncDetector::ParseRegions("A:0x80000000:0x30000;B:0x80100000:0x10001").has_value());
+}
+
+TEST_F(DesyncDetectorTest, MatchingStateIsNotReported)
+{
+  RunFrames(DesyncDetector::DIGESTS_PER_PACKET * 5);
+
+  EXPECT_FALSE(m_players[0].desync_frame.has_value());
+  EXPECT_FALSE(m_players[1].desync_frame.has_value());
+  EXPECT_TRUE(GetDumps().empty());
+}
+
+TEST_F(DesyncDetectorTest, ChangesOutsideRegionsAreIgnored)
+{
+  RunFrames(DesyncDetector::DIGESTS_PER_PACKET);
+  m_players[1].ram[0x800] ^= 0xFF;
+  RunFrames(DesyncDetector::DIGESTS_PER_PACKET * 2);
+
+  EXPECT_FALSE(m_players[0].desync_frame.has_value());
+  EXPECT_FALSE(m_players[1].desync_frame.has_value());
+}
+
+TEST_F(DesyncDetectorTest, DesyncIsReportedAndDumped)
+{
+  RunFrames(DesyncDetector::DIGESTS_PER_PACKET + 3);
+  const u64 desync_frame = m_frame;
+  m_players[1].ram[0x1123] ^= 0xFF;
+  RunFrames(DesyncDetector::DIGESTS_PER_PACKET * 3);
+
+  ASSERT_TRUE(m_players[0].desync_frame.has_value());
+  ASSERT_TRUE(m_players[1].desync_frame.has_value());
+  EXPECT_EQ(desync_frame, *m_players[0].desync_frame);
+  EXPECT_EQ(desync_frame, *m_players[1].desync_frame);
+
+  // Each side dumps its block next to the other player's
+  const std::vector<std::string> dumps = GetDumps();
+  ASSERT_EQ(2u, dumps.size());
+  for (const std::string& path : dumps)
+  {
+    std::string dump;
+    ASSERT_TRUE(File::ReadFileToString(path, dump));
+    EXPECT_NE(std::string::npos, dump.find("[Second] 80001100-800011FF"));
+    EXPECT_NE(std::string::npos, dump.find("80001120  local"));
+    EXPECT_EQ(std::string::npos, dump.find("[First]"));
+  }
+}
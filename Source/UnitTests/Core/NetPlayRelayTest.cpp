@@ -0,0 +1,263 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+
+#include "Common/CommonTypes.h"
+#include "Common/SFMLHelper.h"
+#include "Core/NetPlayProto.h"
+#include "Core/NetPlayRelay.h"
+
+using NetPlay::MessageID;
+using NetPlay::RelayLog;
+
+namespace
+{
+MessageID GetMessageID(const sf::Packet& packet)
+{
+  return *static_cast<const MessageID*>(packet.getData());
+}
+
+sf::Packet MakePlayerMessage(MessageID mid, NetPlay::PlayerId pid)
+{
+  sf::Packet packet;
+  packet << mid << pid;
+  return packet;
+}
+
+sf::Packet MakePadMapping(std::array<NetPlay::PlayerId, 4> mapping)
+{
+  sf::Packet packet;
+  packet << MessageID::PadMapping;
+  for (NetPlay::PlayerId pid : mapping)
+    packet << pid;
+  return packet;
+}
+
+sf::Packet MakeGBAConfig(std::array<bool, 4> enabled)
+{
+  sf::Packet packet;
+  packet << MessageID::GBAConfig;
+  for (bool gba : enabled)
+  {
+    packet << gba << false << std::string();
+    for (int i = 0; i < 20; ++i)
+      packet << u8{0};
+  }
+  return packet;
+}
+
+// One input for each of the pads, with its index in the pad's inputs as the button
+sf::Packet MakePadData(std::initializer_list<NetPlay::PadIndex> pads,
+                       std::array<u16, 4>& next_input)
+{
+  sf::Packet packet;
+  packet << MessageID::PadData;
+  for (NetPlay::PadIndex pad : pads)
+  {
+    packet << pad << next_input[pad]++;
+    // Analog values and whether the pad is connected, not sent for GBAs
+    if (pad != 3)
+    {
+      for (int i = 0; i < 8; ++i)
+        packet << u8{0x80};
+      packet << true;
+    }
+  }
+  return packet;
+}
+
+sf::Packet MakeKeyframe(std::array<u64, 4> used)
+{
+  sf::Packet packet;
+  packet << MessageID::SpectatorKeyframe;
+  for (u64 count : used)
+    packet << sf::Uint64{count};
+  packet << u32{4};
+  packet << u8{1} << u8{2} << u8{3} << u8{4};
+  return packet;
+}
+
+// Plays the game messages like a spectator: loads the keyframe, then returns the first input of
+// each pad it uses after skipping the ones the keyframe already used.
+std::array<int, 4> FirstInputsAfterKeyframe(std::vector<sf::Packet> messages)
+{
+  std::array<u64, 4> skip{};
+  std::array<int, 4> first{-1, -1, -1, -1};
+
+  for (sf::Packet& packet : messages)
+  {
+    MessageID mid;
+    packet >> mid;
+    if (mid == MessageID::SpectatorKeyframe)
+    {
+      for (u64& count : skip)
+        count = Common::PacketReadU64(packet);
+      u32 size;
+      packet >> size;
+      EXPECT_EQ(4u, size);
+      continue;
+    }
+
+    EXPECT_EQ(MessageID::PadData, mid);
+    while (!packet.endOfPacket())
+    {
+      NetPlay::PadIndex pad;
+      u16 button;
+      packet >> pad >> button;
+      if (pad != 3)
+      {
+        u8 value;
+        bool connected;
+        for (int i = 0; i < 8; ++i)
+          packet >> value;
+        packet >> connected;
+      }
+
+      if (skip[pad] != 0)
+        --skip[pad];
+      else if (first[pad] < 0)
+        first[pad] = button;
+    }
+  }
+  return first;
+}
+
+void StartGame(RelayLog& log)
+{
+  sf::Packet start;
+  start << MessageID::StartGame;
+  EXPECT_EQ(RelayLog::Kind::Session, log.Add(start));
+  EXPECT_TRUE(log.IsGameRunning());
+}
+}  // namespace
+
+TEST(RelayLog, KeepsCurrentSession)
+{
+  RelayLog log;
+  log.Add(MakePlayerMessage(MessageID::PlayerJoin, 1));
+  log.Add(MakePlayerMessage(MessageID::PlayerJoin, 2));
+  log.Add(MakePadMapping({1, 2, 0, 0}));
+  log.Add(MakePlayerMessage(MessageID::GameStatus, 2));
+  log.Add(MakePlayerMessage(MessageID::PlayerLeave, 2));
+  log.Add(MakePadMapping({1, 0, 0, 0}));
+
+  sf::Packet chat;
+  chat << MessageID::ChatMessage << NetPlay::PlayerId{1} << std::string("hi");
+  EXPECT_EQ(RelayLog::Kind::Live, log.Add(chat));
+
+  sf::Packet ping;
+  ping << MessageID::Ping << u32{1};
+  EXPECT_EQ(RelayLog::Kind::Drop, log.Add(ping));
+
+  // Player 2 left, so only the join of player 1 and the last pad mapping remain
+  std::vector<sf::Packet> messages = log.GetSessionMessages();
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ(MessageID::PlayerJoin, GetMessageID(messages[0]));
+  ASSERT_EQ(MessageID::PadMapping, GetMessageID(messages[1]));
+  MessageID mid;
+  std::array<NetPlay::PlayerId, 4> mapping;
+  messages[1] >> mid >> mapping[0] >> mapping[1] >> mapping[2] >> mapping[3];
+  EXPECT_EQ((std::array<NetPlay::PlayerId, 4>{1, 0, 0, 0}), mapping);
+}
+
+TEST(RelayLog, DoesNotKeepRioKeys)
+{
+  RelayLog log;
+  sf::Packet join;
+  join << MessageID::PlayerJoin << NetPlay::PlayerId{1} << std::string("Player")
+       << std::string("rio-key") << std::string("revision");
+  EXPECT_EQ(RelayLog::Kind::Session, log.Add(join));
+
+  std::vector<sf::Packet> messages = log.GetSessionMessages();
+  ASSERT_EQ(1u, messages.size());
+  MessageID mid;
+  NetPlay::PlayerId pid;
+  std::string name, rio_key, revision;
+  messages[0] >> mid >> pid >> name >> rio_key >> revision;
+  ASSERT_TRUE(messages[0]);
+  EXPECT_EQ(MessageID::PlayerJoin, mid);
+  EXPECT_EQ(1, pid);
+  EXPECT_EQ("Player", name);
+  EXPECT_EQ("", rio_key);
+  EXPECT_EQ("revision", revision);
+}
+
+TEST(RelayLog, KeepsSetupOfRunningGame)
+{
+  RelayLog log;
+
+  sf::Packet codes;
+  codes << MessageID::SyncCodes << NetPlay::SyncCodeID::Notify;
+  log.Add(codes);
+  // An aborted start is followed by a new synchronization
+  log.Add(codes);
+  StartGame(log);
+  EXPECT_EQ(2u, log.GetSessionMessages().size());
+
+  std::array<u16, 4> next_input{};
+  EXPECT_EQ(RelayLog::Kind::Game, log.Add(MakePadData({0}, next_input)));
+  EXPECT_EQ(1u, log.GetGameMessageCount());
+
+  sf::Packet stop;
+  stop << MessageID::StopGame;
+  EXPECT_EQ(RelayLog::Kind::Session, log.Add(stop));
+  EXPECT_FALSE(log.IsGameRunning());
+  EXPECT_TRUE(log.GetSessionMessages().empty());
+  EXPECT_TRUE(log.GetGameMessages().empty());
+
+  // Inputs that arrive after the game stopped are not for anyone
+  EXPECT_EQ(RelayLog::Kind::Drop, log.Add(MakePadData({0}, next_input)));
+}
+
+TEST(RelayLog, KeyframeDropsUsedInputs)
+{
+  RelayLog log;
+  log.Add(MakeGBAConfig({false, false, false, true}));
+  StartGame(log);
+
+  std::array<u16, 4> next_input{};
+  for (int i = 0; i < 10; ++i)
+  {
+    log.Add(MakePadData({0, 3}, next_input));
+    // Pad 1 lags behind
+    if (i % 2 == 0)
+      log.Add(MakePadData({1}, next_input));
+  }
+
+  log.SetKeyframe(MakeKeyframe({6, 3, 0, 6}));
+  std::vector<sf::Packet> messages = log.GetGameMessages();
+  ASSERT_FALSE(messages.empty());
+  EXPECT_EQ(MessageID::SpectatorKeyframe, GetMessageID(messages.front()));
+  EXPECT_LT(messages.size(), 16u);
+
+  const std::array<int, 4> first = FirstInputsAfterKeyframe(messages);
+  EXPECT_EQ(6, first[0]);
+  EXPECT_EQ(3, first[1]);
+  EXPECT_EQ(-1, first[2]);
+  EXPECT_EQ(6, first[3]);
+}
+
+TEST(RelayLog, KeyframeAheadOfInputs)
+{
+  RelayLog log;
+  StartGame(log);
+
+  // The keyframe comes on another ENet channel and can overtake the inputs it used
+  std::array<u16, 4> next_input{};
+  log.Add(MakePadData({0}, next_input));
+  log.SetKeyframe(MakeKeyframe({3, 0, 0, 0}));
+  EXPECT_EQ(0u, log.GetGameMessageCount());
+
+  for (int i = 0; i < 4; ++i)
+    log.Add(MakePadData({0}, next_input));
+
+  EXPECT_EQ(3, FirstInputsAfterKeyframe(log.GetGameMessages())[0]);
+}
@@ -0,0 +1,299 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <deque>
+#include <map>
+#include <optional>
+#include <random>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRollback.h"
+#include "InputCommon/GCPadStatus.h"
+
+using NetPlay::RollbackSession;
+
+namespace
+{
+constexpr u32 MAX_FRAMES = 8;
+constexpr u64 TEST_FRAMES = 600;
+
+GCPadStatus MakeInput(u16 button)
+{
+  GCPadStatus status;
+  status.button = button;
+  return status;
+}
+
+// The input a player holds on a frame. Changes every few frames, so predictions are sometimes wrong.
+GCPadStatus PlayerInput(int pad, u64 frame)
+{
+  return MakeInput(static_cast<u16>(((frame / (5 + pad * 2)) * 0x9E37 + pad) & 0xFFF));
+}
+
+// A stand-in for the emulated game: every frame mixes both pads' inputs into the state, so any
+// wrong input leaves a trace in all later states.
+u64 StepGame(u64 state, const GCPadStatus& pad0, const GCPadStatus& pad1)
+{
+  state ^= pad0.button + (static_cast<u64>(pad1.button) << 16);
+  state *= 0x100000001B3;
+  return state ^ (state >> 29);
+}
+
+// Two players in rollback mode, each playing one pad, connected through a link that delays every
+// input by a random latency. Like the ENet channel NetPlay uses, the link keeps inputs in order.
+class RollbackLoopbackTest : public testing::Test
+{
+protected:
+  struct Packet
+  {
+    u64 arrival_tick;
+    GCPadStatus input;
+  };
+
+  struct Player
+  {
+    Player(int pad_) : pad(pad_), session(MAX_FRAMES, {true, true, false, false}) {}
+
+    int pad;
+    RollbackSession session;
+    u64 state = 0;
+    // The state after each frame, like the per-frame savestates
+    std::map<u64, u64> states;
+    // Inputs on their way to this player
+    std::deque<Packet> link;
+    u64 received = 0;
+    u64 rollbacks = 0;
+    u64 resimulated_frames = 0;
+    u64 stalled_ticks = 0;
+  };
+
+  void SetLink(u64 latency, u64 jitter)
+  {
+    m_latency = latency;
+    m_jitter = jitter;
+  }
+
+  void Send(Player& to, const GCPadStatus& input)
+  {
+    std::uniform_int_distribution<u64> jitter(0, m_jitter);
+    u64 arrival = m_tick + m_latency + jitter(m_rng);
+    if (!to.link.empty())
+      arrival = std::max(arrival, to.link.back().arrival_tick);
+    to.link.push_back({arrival, input});
+  }
+
+  void Receive(Player& player)
+  {
+    const int remote_pad = 1 - player.pad;
+    while (!player.link.empty() && player.link.front().arrival_tick <= m_tick)
+    {
+      player.session.AddInput(remote_pad, player.link.front().input);
+      player.link.pop_front();
+      ++player.received;
+    }
+  }
+
+  // Same order as NetPlayClient: run the frame, end it, then either roll back or save the state.
+  void RunFrame(Player& player)
+  {
+    RollbackSession& session = player.session;
+    player.state = StepGame(player.state, session.GetInput(0), session.GetInput(1));
+    session.EndFrame();
+
+    if (const std::optional<u64> frame = session.TakeRollback())
+    {
+      ++player.rollbacks;
+      ASSERT_GE(*frame, 1u);
+      ASSERT_TRUE(player.states.contains(*frame - 1));
+      player.state = player.states[*frame - 1];
+      while (session.IsResimulating())
+      {
+        ++player.resimulated_frames;
+        RunFrame(player);
+      }
+    }
+    else
+    {
+      player.states[session.GetFrame() - 1] = player.state;
+    }
+  }
+
+  // One real frame of time for both players.
+  void Tick()
+  {
+    for (Player& player : m_players)
+    {
+      Player& other = m_players[1 - player.pad];
+      RollbackSession& session = player.session;
+      Receive(player);
+
+      if (session.GetFrame() >= TEST_FRAMES + MAX_FRAMES)
+        continue;
+
+      if (!session.HasInput(player.pad))
+      {
+        const GCPadStatus input = PlayerInput(player.pad, session.GetFrame());
+        session.AddInput(player.pad, input);
+        Send(other, input);
+      }
+
+      const int remote_pad = 1 - player.pad;
+      if (!session.HasInput(remote_pad) && !session.CanPredict(remote_pad))
+      {
+        ++player.stalled_ticks;
+        continue;
+      }
+
+      // Never more than MAX_FRAMES ahead of the last input received
+      EXPECT_LE(session.GetFrame(), player.received + MAX_FRAMES);
+      RunFrame(player);
+    }
+    ++m_tick;
+  }
+
+  void Run()
+  {
+    while (m_tick < 100000 &&
+           (m_players[0].session.GetFrame() < TEST_FRAMES + MAX_FRAMES ||
+            m_players[1].session.GetFrame() < TEST_FRAMES + MAX_FRAMES ||
+            !m_players[0].link.empty() || !m_players[1].link.empty()))
+    {
+      Tick();
+    }
+    // Roll back anything the last inputs revealed
+    for (Player& player : m_players)
+      RunFrame(player);
+  }
+
+  static u64 ExpectedState(u64 frame)
+  {
+    u64 state = 0;
+    for (u64 i = 0; i <= frame; ++i)
+      state = StepGame(state, PlayerInput(0, i), PlayerInput(1, i));
+    return state;
+  }
+
+  std::array<Player, 2> m_players{Player(0), Player(1)};
+  std::mt19937 m_rng{1234};
+  u64 m_tick = 0;
+  u64 m_latency = 0;
+  u64 m_jitter = 0;
+};
+}  // namespace
+
+TEST(RollbackSession, PredictsLastInput)
+{
+  RollbackSession session(4, {true, true, false, false});
+
+  EXPECT_FALSE(session.HasInput(1));
+  EXPECT_FALSE(session.CanPredict(1));
+
+  session.AddInput(0, MakeInput(1));
+  session.AddInput(1, MakeInput(2));
+  EXPECT_EQ(2, session.GetInput(1).button);
+  session.EndFrame();
+
+  // Frame 1 runs with the input of frame 0
+  session.AddInput(0, MakeInput(1));
+  EXPECT_FALSE(session.HasInput(1));
+  EXPECT_TRUE(session.CanPredict(1));
+  EXPECT_EQ(2, session.GetInput(1).button);
+  session.EndFrame();
+
+  session.AddInput(1, MakeInput(2));
+  EXPECT_FALSE(session.TakeRollback().has_value());
+  EXPECT_FALSE(session.IsResimulating());
+}
+
+TEST(RollbackSession, RollsBackToFirstMisprediction)
+{
+  RollbackSession session(4, {true, true, false, false});
+
+  session.AddInput(1, MakeInput(2));
+  for (int i = 0; i < 4; ++i)
+  {
+    session.AddInput(0, MakeInput(1));
+    session.GetInput(1);
+    session.EndFrame();
+  }
+  EXPECT_EQ(4u, session.GetFrame());
+
+  // Frame 1 was right, frame 2 was not
+  session.AddInput(1, MakeInput(2));
+  session.AddInput(1, MakeInput(3));
+  session.AddInput(1, MakeInput(3));
+
+  const std::optional<u64> frame = session.TakeRollback();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(2u, *frame);
+  EXPECT_EQ(2u, session.GetFrame());
+  EXPECT_TRUE(session.IsResimulating());
+
+  // The frames are replayed with the real inputs, and the local ones that were used before
+  EXPECT_TRUE(session.HasInput(0));
+  EXPECT_EQ(1, session.GetInput(0).button);
+  EXPECT_EQ(3, session.GetInput(1).button);
+  session.EndFrame();
+  EXPECT_EQ(3, session.GetInput(1).button);
+  session.EndFrame();
+  EXPECT_FALSE(session.IsResimulating());
+  EXPECT_FALSE(session.TakeRollback().has_value());
+}
+
+TEST(RollbackSession, StopsPredictingAfterMaxFrames)
+{
+  RollbackSession session(2, {true, true, false, false});
+
+  session.AddInput(1, MakeInput(0));
+  for (int i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(session.HasInput(1) || session.CanPredict(1));
+    session.GetInput(1);
+    session.EndFrame();
+  }
+  EXPECT_FALSE(session.CanPredict(1));
+
+  session.AddInput(1, MakeInput(0));
+  EXPECT_TRUE(session.CanPredict(1));
+}
+
+TEST_F(RollbackLoopbackTest, SameTick)
+{
+  SetLink(0, 0);
+  Run();
+
+  // Player 0 waits for the first input of player 1 and is one frame behind from then on, so its
+  // inputs always arrive in time and only player 1 has to predict
+  EXPECT_EQ(0u, m_players[0].rollbacks);
+  EXPECT_GT(m_players[1].rollbacks, 0u);
+  for (const Player& player : m_players)
+    EXPECT_EQ(ExpectedState(TEST_FRAMES), player.states.at(TEST_FRAMES));
+}
+
+TEST_F(RollbackLoopbackTest, LatencyAndJitter)
+{
+  SetLink(3, 4);
+  Run();
+
+  for (const Player& player : m_players)
+  {
+    EXPECT_GT(player.rollbacks, 0u);
+    EXPECT_GT(player.resimulated_frames, player.rollbacks);
+    EXPECT_EQ(ExpectedState(TEST_FRAMES), player.states.at(TEST_FRAMES));
+  }
+}
+
+TEST_F(RollbackLoopbackTest, LatencyOverMaxFramesStalls)
+{
+  SetLink(MAX_FRAMES + 4, 2);
+  Run();
+
+  for (const Player& player : m_players)
+  {
+    EXPECT_GT(player.stalled_ticks, 0u);
+    EXPECT_EQ(ExpectedState(TEST_FRAMES), player.states.at(TEST_FRAMES));
+  }
+}
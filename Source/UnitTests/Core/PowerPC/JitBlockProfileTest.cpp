@@ -0,0 +1,95 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
+
+namespace
+{
+class JitBlockProfileTest : public testing::Test
+{
+protected:
+  JitBlockProfileTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/profile.bin")
+  {
+  }
+  ~JitBlockProfileTest() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(JitBlockProfileTest, HotBlocksTakeMostCycles)
+{
+  JitBlockProfile profile;
+  profile.AddRuns(0x80001000, 1000, 70000);
+  profile.AddRuns(0x80002000, 500, 25000);
+  profile.AddRuns(0x80003000, 10, 4000);
+  profile.AddRuns(0x80004000, 1, 1000);
+  profile.UpdateHotBlocks();
+
+  EXPECT_EQ(2u, profile.GetHotBlockCount());
+  EXPECT_TRUE(profile.IsHot(0x80001000));
+  EXPECT_TRUE(profile.IsHot(0x80002000));
+  EXPECT_FALSE(profile.IsHot(0x80003000));
+  EXPECT_FALSE(profile.IsHot(0x80004000));
+}
+
+TEST_F(JitBlockProfileTest, LoadHalvesCounts)
+{
+  JitBlockProfile recorded;
+  recorded.AddRuns(0x80001000, 1000, 70000);
+  recorded.AddRuns(0x80002000, 500, 30000);
+  ASSERT_TRUE(recorded.Save(m_path, 1));
+
+  // The counts of this session outweigh the halved ones of the last session
+  JitBlockProfile profile;
+  ASSERT_TRUE(profile.Load(m_path, 1));
+  EXPECT_EQ(2u, profile.GetBlockCount());
+  EXPECT_TRUE(profile.IsHot(0x80001000));
+  profile.AddRuns(0x80002000, 10000, 500000);
+  profile.UpdateHotBlocks();
+  ASSERT_TRUE(profile.Save(m_path, 1));
+
+  ASSERT_TRUE(profile.Load(m_path, 1));
+  EXPECT_EQ(1u, profile.GetHotBlockCount());
+  EXPECT_TRUE(profile.IsHot(0x80002000));
+}
+
+TEST_F(JitBlockProfileTest, RejectsOtherRevision)
+{
+  JitBlockProfile recorded;
+  recorded.AddRuns(0x80001000, 1000, 70000);
+  ASSERT_TRUE(recorded.Save(m_path, 0));
+
+  JitBlockProfile profile;
+  EXPECT_FALSE(profile.Load(m_path, 1));
+  EXPECT_EQ(0u, profile.GetBlockCount());
+  EXPECT_FALSE(profile.HasHotBlocks());
+
+  EXPECT_FALSE(profile.Load(m_directory + "/missing.bin", 0));
+}
+
+TEST_F(JitBlockProfileTest, RejectsBlockCountLargerThanFile)
+{
+  JitBlockProfile recorded;
+  recorded.AddRuns(0x80001000, 1000, 70000);
+  ASSERT_TRUE(recorded.Save(m_path, 0));
+
+  // The block count follows the magic and the version
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_path, data));
+  const u32 block_count = 0xFFFFFFFF;
+  std::memcpy(&data[8], &block_count, sizeof(block_count));
+  ASSERT_TRUE(File::WriteStringToFile(m_path, data));
+
+  JitBlockProfile profile;
+  EXPECT_FALSE(profile.Load(m_path, 0));
+  EXPECT_EQ(0u, profile.GetBlockCount());
+}
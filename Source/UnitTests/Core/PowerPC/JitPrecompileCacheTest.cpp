@@ -0,0 +1,92 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "Common/FileUtil.h"
+#include "Core/PowerPC/JitCommon/JitPrecompileCache.h"
+
+namespace
+{
+class JitPrecompileCacheTest : public testing::Test
+{
+protected:
+  JitPrecompileCacheTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/blocks.bin")
+  {
+  }
+  ~JitPrecompileCacheTest() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_path;
+};
+
+JitPrecompileCache::Block MakeBlock(u32 address, u64 code_hash)
+{
+  JitPrecompileCache::Block block;
+  block.effective_address = address | 0x80000000;
+  block.physical_address = address;
+  block.feature_flags = 3;
+  block.code_hash = code_hash;
+  block.code_ranges = JitPrecompileCache::GetCodeRanges({address, address + 4, address + 8});
+  return block;
+}
+}  // namespace
+
+TEST(JitPrecompileCache, CodeRangesMergeConsecutiveInstructions)
+{
+  const std::set<u32> addresses{0x1000, 0x1004, 0x1008, 0x2000, 0x2004, 0x100c};
+  const JitPrecompileCache::CodeRanges ranges = JitPrecompileCache::GetCodeRanges(addresses);
+
+  ASSERT_EQ(2u, ranges.size());
+  EXPECT_EQ(0x1000u, ranges[0].physical_address);
+  EXPECT_EQ(4u, ranges[0].instruction_count);
+  EXPECT_EQ(0x2000u, ranges[1].physical_address);
+  EXPECT_EQ(2u, ranges[1].instruction_count);
+}
+
+TEST_F(JitPrecompileCacheTest, SaveAndLoad)
+{
+  JitPrecompileCache recorded;
+  recorded.Record(MakeBlock(0x1000, 1));
+  JitPrecompileCache::Block speculative = MakeBlock(0x2000, 2);
+  speculative.speculative = true;
+  recorded.Record(speculative);
+  // Recompiled after the game changed the code
+  recorded.Record(MakeBlock(0x1000, 3));
+  EXPECT_TRUE(recorded.HasChanged());
+  ASSERT_TRUE(recorded.Save(m_path, 1, 0x1234));
+
+  JitPrecompileCache cache;
+  ASSERT_TRUE(cache.Load(m_path, 1, 0x1234));
+  EXPECT_FALSE(cache.HasChanged());
+  ASSERT_EQ(2u, cache.GetBlocks().size());
+
+  const JitPrecompileCache::Block& first = cache.GetBlocks()[0];
+  EXPECT_EQ(0x80001000u, first.effective_address);
+  EXPECT_EQ(0x1000u, first.physical_address);
+  EXPECT_EQ(3u, first.feature_flags);
+  EXPECT_EQ(3u, first.code_hash);
+  EXPECT_FALSE(first.speculative);
+  ASSERT_EQ(1u, first.code_ranges.size());
+  EXPECT_EQ(0x1000u, first.code_ranges[0].physical_address);
+  EXPECT_EQ(3u, first.code_ranges[0].instruction_count);
+
+  EXPECT_TRUE(cache.GetBlocks()[1].speculative);
+}
+
+TEST_F(JitPrecompileCacheTest, RejectsOtherConfiguration)
+{
+  JitPrecompileCache recorded;
+  recorded.Record(MakeBlock(0x1000, 1));
+  ASSERT_TRUE(recorded.Save(m_path, 0, 0x1234));
+
+  JitPrecompileCache cache;
+  EXPECT_FALSE(cache.Load(m_path, 0, 0x4321));
+  EXPECT_TRUE(cache.GetBlocks().empty());
+  EXPECT_FALSE(cache.Load(m_path, 1, 0x1234));
+  EXPECT_TRUE(cache.GetBlocks().empty());
+  EXPECT_FALSE(cache.Load(m_directory + "/missing.bin", 0, 0x1234));
+}
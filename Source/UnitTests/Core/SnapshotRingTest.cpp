@@ -0,0 +1,218 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/DirtyPageBitmap.h"
+#include "Core/SnapshotRing.h"
+
+using State::SnapshotRing;
+
+namespace
+{
+constexpr u32 PAGE_SIZE = SnapshotRing::PAGE_SIZE;
+
+// A memory whose size is checked before anything is loaded, like State::DoState does, and some
+// state besides. Writes to the memory are tracked unless track_writes is false.
+struct FakeMachine
+{
+  std::vector<u8> mem1;
+  std::vector<u32> registers = std::vector<u32>(4);
+  Common::DirtyPageBitmap dirty_pages;
+  bool track_writes = true;
+
+  explicit FakeMachine(size_t mem1_size = 16 * PAGE_SIZE + 100) : mem1(mem1_size)
+  {
+    std::iota(mem1.begin(), mem1.end(), u8(0));
+    dirty_pages.Init(static_cast<u32>(mem1_size));
+  }
+
+  void Write(u32 offset, u8 value)
+  {
+    mem1[offset] = value;
+    dirty_pages.MarkDirty(offset, 1);
+  }
+
+  void DoState(PointerWrap& p)
+  {
+    u32 mem1_size = static_cast<u32>(mem1.size());
+    p.Do(mem1_size);
+    if (mem1_size != mem1.size())
+    {
+      p.SetMeasureMode();
+      return;
+    }
+
+    p.DoMemoryBlock(mem1.data(), mem1_size, track_writes ? &dirty_pages : nullptr);
+    p.Do(registers);
+  }
+
+  SnapshotRing::Serializer Serializer()
+  {
+    return [this](PointerWrap& p) { DoState(p); };
+  }
+};
+}  // namespace
+
+TEST(SnapshotRing, RoundTrip)
+{
+  FakeMachine machine;
+  SnapshotRing ring(4);
+  EXPECT_FALSE(ring.HasState(0));
+  EXPECT_FALSE(ring.Load(0, machine.Serializer()));
+
+  ring.Save(0, machine.Serializer());
+  EXPECT_TRUE(ring.HasState(0));
+  const std::vector<u8> saved_mem1 = machine.mem1;
+  const std::vector<u32> saved_registers = machine.registers;
+
+  machine.Write(5, machine.mem1[5] ^ 0xFF);
+  machine.Write(static_cast<u32>(machine.mem1.size() - 1), 0xAA);
+  machine.registers = {1, 2, 3, 4, 5};
+  ring.Save(1, machine.Serializer());
+  const std::vector<u8> modified_mem1 = machine.mem1;
+  const std::vector<u32> modified_registers = machine.registers;
+
+  ASSERT_TRUE(ring.Load(0, machine.Serializer()));
+  EXPECT_EQ(saved_mem1, machine.mem1);
+  EXPECT_EQ(saved_registers, machine.registers);
+
+  ASSERT_TRUE(ring.Load(1, machine.Serializer()));
+  EXPECT_EQ(modified_mem1, machine.mem1);
+  EXPECT_EQ(modified_registers, machine.registers);
+
+  ring.Clear();
+  EXPECT_FALSE(ring.HasState(1));
+}
+
+TEST(SnapshotRing, CopiesOnlyWrittenPages)
+{
+  FakeMachine machine;
+  SnapshotRing ring(3);
+  const size_t page_count = 17;
+
+  // Nothing is known about the memory yet
+  ring.Save(0, machine.Serializer());
+  EXPECT_EQ(page_count, ring.GetStats().pages_copied);
+  EXPECT_EQ(page_count, ring.GetStats().pages_total);
+
+  machine.Write(3 * PAGE_SIZE, 1);
+  machine.Write(3 * PAGE_SIZE + 1, 2);
+  machine.Write(16 * PAGE_SIZE + 99, 3);
+  ring.Save(1, machine.Serializer());
+  EXPECT_EQ(2u, ring.GetStats().pages_copied);
+  const std::vector<u8> saved_mem1 = machine.mem1;
+
+  ring.Save(2, machine.Serializer());
+  EXPECT_EQ(0u, ring.GetStats().pages_copied);
+
+  // Back to the first state, and to the second one, which only differ in two pages
+  ASSERT_TRUE(ring.Load(0, machine.Serializer()));
+  EXPECT_EQ(2u, ring.GetStats().pages_copied);
+  machine.Write(7 * PAGE_SIZE, 4);
+  ASSERT_TRUE(ring.Load(1, machine.Serializer()));
+  EXPECT_EQ(3u, ring.GetStats().pages_copied);
+  EXPECT_EQ(saved_mem1, machine.mem1);
+
+  // Loading doesn't count as writing
+  ring.Save(0, machine.Serializer());
+  EXPECT_EQ(0u, ring.GetStats().pages_copied);
+}
+
+TEST(SnapshotRing, CopiesUntrackedMemoryWhole)
+{
+  FakeMachine machine;
+  machine.track_writes = false;
+  SnapshotRing ring(2);
+  ring.Save(0, machine.Serializer());
+  const std::vector<u8> saved_mem1 = machine.mem1;
+
+  machine.mem1[PAGE_SIZE] ^= 0xFF;
+  ring.Save(1, machine.Serializer());
+  EXPECT_EQ(17u, ring.GetStats().pages_copied);
+
+  ASSERT_TRUE(ring.Load(0, machine.Serializer()));
+  EXPECT_EQ(17u, ring.GetStats().pages_copied);
+  EXPECT_EQ(saved_mem1, machine.mem1);
+}
+
+TEST(SnapshotRing, CopiesWholeAfterTrackingRestarted)
+{
+  FakeMachine machine;
+  SnapshotRing ring(2);
+  ring.Save(0, machine.Serializer());
+
+  // Someone else took the dirty pages, so the writes before are lost to the ring
+  machine.Write(PAGE_SIZE, 1);
+  machine.dirty_pages.StartTracking();
+  ring.Save(1, machine.Serializer());
+  EXPECT_EQ(17u, ring.GetStats().pages_copied);
+
+  // The full copy shares no pages with the first state
+  ASSERT_TRUE(ring.Load(0, machine.Serializer()));
+  EXPECT_EQ(17u, ring.GetStats().pages_copied);
+  EXPECT_EQ(u8(PAGE_SIZE), machine.mem1[PAGE_SIZE]);
+}
+
+TEST(SnapshotRing, ReusesPagesAndBuffers)
+{
+  FakeMachine machine;
+  SnapshotRing ring(2);
+  // A save stores the new version of a page before it releases the one of the slot
+  for (int i = 0; i < 3; ++i)
+  {
+    machine.Write(i, 1);
+    ring.Save(i % 2, machine.Serializer());
+  }
+  const size_t memory_usage = ring.GetMemoryUsage();
+  EXPECT_GE(memory_usage, machine.mem1.size());
+  EXPECT_LT(memory_usage, 2 * machine.mem1.size());
+
+  for (int i = 0; i < 8; ++i)
+  {
+    machine.Write(i, 2);
+    ring.Save(i % 2, machine.Serializer());
+  }
+  EXPECT_EQ(memory_usage, ring.GetMemoryUsage());
+}
+
+TEST(SnapshotRing, GrowingState)
+{
+  FakeMachine machine;
+  SnapshotRing ring(2);
+  ring.Save(0, machine.Serializer());
+
+  // Does not fit in the buffer of the previous save anymore
+  machine.registers.resize(4096, 0x12345678);
+  machine.Write(PAGE_SIZE, 1);
+  ring.Save(0, machine.Serializer());
+  EXPECT_EQ(1u, ring.GetStats().pages_copied);
+  const std::vector<u8> saved_mem1 = machine.mem1;
+  const std::vector<u32> saved_registers = machine.registers;
+
+  machine.registers.clear();
+  machine.Write(PAGE_SIZE, 2);
+  ASSERT_TRUE(ring.Load(0, machine.Serializer()));
+  EXPECT_EQ(saved_registers, machine.registers);
+  EXPECT_EQ(saved_mem1, machine.mem1);
+}
+
+TEST(SnapshotRing, RejectsStateOfAnotherMachine)
+{
+  FakeMachine machine;
+  SnapshotRing ring(2);
+  ring.Save(0, machine.Serializer());
+
+  FakeMachine other(0x20000);
+  other.registers = {9, 9};
+  const std::vector<u8> untouched_mem1 = other.mem1;
+  const std::vector<u32> untouched_registers = other.registers;
+  EXPECT_FALSE(ring.Load(0, other.Serializer()));
+  EXPECT_EQ(untouched_mem1, other.mem1);
+  EXPECT_EQ(untouched_registers, other.registers);
+}
@@ -0,0 +1,174 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/MSB_StatLog.h"
+#include "Core/MSB_StatTracker.h"
+
+namespace
+{
+class StatLogTest : public testing::Test
+{
+protected:
+  StatLogTest()
+      : m_directory(File::CreateTempDir()),
+        m_path(m_directory + "/game" + StatLog::FILE_EXTENSION)
+  {
+  }
+  ~StatLogTest() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_path;
+};
+
+void FillGame(StatTracker& tracker)
+{
+  StatTracker::GameInfo& info = tracker.m_game_info;
+  info.game_id = 0x12345678;
+  info.start_unix_date_time = "1700000000";
+  info.end_unix_date_time = "1700003600";
+  info.team0_port = 0;
+  info.team1_port = 1;
+  info.away_port = 0;
+  info.home_port = 1;
+  info.team0_player.username = "Away";
+  info.team0_player.userid = "away-id";
+  info.team1_player.username = "Home";
+  info.team1_player.userid = "home-id";
+  info.away_score = 3;
+  info.home_score = 2;
+  info.stadium = 1;
+  info.innings_selected = 9;
+  info.innings_played = 9;
+  info.netplay = true;
+  info.tag_set_id = 7;
+  info.version = "test";
+
+  for (auto& team : info.character_summaries)
+  {
+    for (StatTracker::CharacterSummary& summary : team)
+      summary = {};
+  }
+  info.character_summaries[0][0].char_id = 0x12;
+  info.character_summaries[0][0].end_game_offensive_stats.hits = 2;
+  info.character_summaries[1][3].end_game_defensive_stats.pitches_thrown = 90;
+  tracker.m_fielder_tracker[1].fielder_map[3].pitch_count_by_position[0] = 90;
+
+  StatTracker::Event& event = info.events[0];
+  event = {};
+  event.event_num = 0;
+  event.inning = 1;
+  event.outs = 1;
+  event.rbi = 1;
+  event.num_outs_during_play.set_value(1);
+
+  StatTracker::Runner runner{};
+  runner.roster_loc = 4;
+  runner.initial_base = 1;
+  runner.result_base = 3;
+  event.runner_1 = runner;
+
+  StatTracker::Pitch& pitch = event.pitch.emplace();
+  pitch.pitch_type = 2;
+  pitch.pitch_result = 6;
+  pitch.charge_up.set_value(0x3F000000);
+  pitch.pitch_curve = {{0x3F800000}, {0x40000000}, {0x40400000}};
+
+  StatTracker::Contact& contact = pitch.contact.emplace();
+  contact.power.set_value(120);
+  contact.ball_x_pos.set_value(0x42C80000);
+  contact.ball_hang_time.set_value(45);
+  contact.primary_contact_result = 2;
+  contact.secondary_contact_result = 8;
+
+  StatTracker::Fielder fielder{};
+  fielder.fielder_roster_loc = 6;
+  fielder.fielder_pos = 7;
+  fielder.fielder_x_pos = 0x41200000;
+  contact.first_fielder = fielder;
+}
+}  // namespace
+
+TEST_F(StatLogTest, RoundTripMatchesJson)
+{
+  auto original = std::make_unique<StatTracker>();
+  FillGame(*original);
+  ASSERT_TRUE(StatLog::Write(m_path, *original));
+
+  auto restored = std::make_unique<StatTracker>();
+  ASSERT_TRUE(StatLog::Read(m_path, *restored));
+
+  // Logs only keep a hash of the rio keys
+  EXPECT_NE("away-id", restored->m_game_info.team0_player.userid);
+  EXPECT_NE("home-id", restored->m_game_info.team1_player.userid);
+  EXPECT_NE(restored->m_game_info.team0_player.userid,
+            restored->m_game_info.team1_player.userid);
+  original->m_game_info.team0_player.userid = restored->m_game_info.team0_player.userid;
+  original->m_game_info.team1_player.userid = restored->m_game_info.team1_player.userid;
+
+  const StatTracker::StatJSONs expected = original->getStatJSONs();
+  const StatTracker::StatJSONs actual = restored->getStatJSONs();
+  EXPECT_EQ(expected.full, actual.full);
+  EXPECT_EQ(expected.decoded, actual.decoded);
+  EXPECT_EQ(3u, restored->m_game_info.events.at(0).pitch->pitch_curve.size());
+}
+
+TEST_F(StatLogTest, RejectsOtherFiles)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_path, "{\"GameID\": 1}"));
+
+  auto tracker = std::make_unique<StatTracker>();
+  EXPECT_FALSE(StatLog::Read(m_path, *tracker));
+}
+
+TEST_F(StatLogTest, RejectsTruncatedLog)
+{
+  auto original = std::make_unique<StatTracker>();
+  FillGame(*original);
+  ASSERT_TRUE(StatLog::Write(m_path, *original));
+
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_path, data));
+  data.resize(data.size() - 10);
+  ASSERT_TRUE(File::WriteStringToFile(m_path, data));
+
+  auto tracker = std::make_unique<StatTracker>();
+  EXPECT_FALSE(StatLog::Read(m_path, *tracker));
+}
+
+TEST_F(StatLogTest, DoesNotStoreRioKeys)
+{
+  auto tracker = std::make_unique<StatTracker>();
+  FillGame(*tracker);
+  ASSERT_TRUE(StatLog::Write(m_path, *tracker));
+
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_path, data));
+  EXPECT_EQ(std::string::npos, data.find("away-id"));
+  EXPECT_EQ(std::string::npos, data.find("home-id"));
+  EXPECT_NE(std::string::npos, data.find("Away"));
+}
+
+TEST_F(StatLogTest, RejectsRowCountsLargerThanTheBlock)
+{
+  auto tracker = std::make_unique<StatTracker>();
+  FillGame(*tracker);
+  ASSERT_TRUE(StatLog::Write(m_path, *tracker));
+
+  // The row count of the first block, after the file header and the block id
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_path, data));
+  const u32 num_rows = 0xFFFFFFFF;
+  std::memcpy(&data[16], &num_rows, sizeof(num_rows));
+  ASSERT_TRUE(File::WriteStringToFile(m_path, data));
+
+  tracker = std::make_unique<StatTracker>();
+  EXPECT_FALSE(StatLog::Read(m_path, *tracker));
+}
@@ -0,0 +1,92 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BatchWorkerPool.h"
+#include "VideoCommon/CPUCull.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u32 CHUNK = CPUCull::CHUNK_VERTICES;
+
+// Vertices right of the view, so that only the triangles using the vertex at `visible` can be
+// visible. The random positions give those triangles either winding.
+std::vector<CPUCull::TransformedVertex> MakeVertices(u32 count, u32 visible, std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> outside(1.5f, 4.0f);
+  std::uniform_real_distribution<float> inside(-0.5f, 0.5f);
+  std::vector<CPUCull::TransformedVertex> vertices(count);
+  for (u32 i = 0; i < count; i++)
+    vertices[i] = {i == visible ? inside(rng) : outside(rng), inside(rng), 0.5f, 1.0f};
+  return vertices;
+}
+
+// The positions of the visible vertex: none, the ends of the batch and around the chunk borders
+std::vector<u32> VisiblePositions(u32 count)
+{
+  std::vector<u32> positions = {count, 0, 1, count - 1, count - 2, count - 3};
+  for (u32 border = CHUNK; border < count; border += CHUNK)
+  {
+    for (u32 position = border - 3; position <= border + 2; position++)
+      positions.push_back(position);
+  }
+  std::erase_if(positions, [count](u32 position) { return position > count; });
+  return positions;
+}
+}  // namespace
+
+TEST(CPUCull, ParallelMatchesSerial)
+{
+  BatchWorkerPool workers;
+  workers.Start(3);
+  CPUCull serial;
+  serial.Init(nullptr);
+  CPUCull parallel;
+  parallel.Init(&workers);
+
+  std::mt19937 rng(4321);
+  u32 visible_batches = 0;
+  for (u32 count : {CHUNK - 1, CHUNK, CHUNK + 1, CHUNK + 2, 2 * CHUNK - 1, 2 * CHUNK,
+                    2 * CHUNK + 1, 2 * CHUNK + 2, 3 * CHUNK + 3})
+  {
+    for (u32 visible : VisiblePositions(count))
+    {
+      // A few tries, for both windings of the visible triangles
+      for (int i = 0; i < 4; i++)
+      {
+        const std::vector<CPUCull::TransformedVertex> vertices = MakeVertices(count, visible, rng);
+        for (Primitive primitive :
+             {Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_QUADS_2, Primitive::GX_DRAW_TRIANGLES,
+              Primitive::GX_DRAW_TRIANGLE_STRIP, Primitive::GX_DRAW_TRIANGLE_FAN})
+        {
+          for (CullMode mode : {CullMode::None, CullMode::Back, CullMode::Front, CullMode::All})
+          {
+            const bool expected =
+                serial.AreAllTransformedVerticesCulled(vertices.data(), count, primitive, mode);
+            ASSERT_EQ(expected, parallel.AreAllTransformedVerticesCulledParallel(
+                                    vertices.data(), count, primitive, mode))
+                << "primitive " << static_cast<int>(primitive) << ", cull mode "
+                << static_cast<int>(mode) << ", " << count << " vertices, vertex " << visible
+                << " visible";
+            if (visible == count)
+              EXPECT_TRUE(expected);
+            else if (!expected)
+              visible_batches++;
+          }
+        }
+      }
+    }
+  }
+
+  // Most batches with a visible vertex aren't culled
+  EXPECT_GT(visible_batches, 1000u);
+}
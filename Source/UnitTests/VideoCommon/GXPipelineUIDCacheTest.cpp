@@ -0,0 +1,107 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/GXPipelineUIDCache.h"
+
+using VideoCommon::SerializedGXPipelineUid;
+
+namespace VideoCommon
+{
+// Found by argument dependent lookup when comparing vectors of UIDs
+static bool operator==(const SerializedGXPipelineUid& a, const SerializedGXPipelineUid& b)
+{
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+}  // namespace VideoCommon
+
+namespace
+{
+SerializedGXPipelineUid MakeUid(u32 seed)
+{
+  SerializedGXPipelineUid uid;
+  std::memset(&uid, 0, sizeof(uid));
+  uid.rasterization_state_bits = seed;
+  uid.blending_state_bits = seed * 7;
+  return uid;
+}
+
+class GXPipelineUIDCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override { m_directory = File::CreateTempDir(); }
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string GetPath(const std::string& name) const { return m_directory + "/" + name; }
+
+  std::string m_directory;
+};
+}  // namespace
+
+TEST_F(GXPipelineUIDCacheTest, RoundTrip)
+{
+  const std::vector<SerializedGXPipelineUid> uids{MakeUid(1), MakeUid(2), MakeUid(3)};
+  ASSERT_TRUE(VideoCommon::WriteGXPipelineUIDCache(GetPath("a.uidcache"), uids));
+
+  const auto read = VideoCommon::ReadGXPipelineUIDCache(GetPath("a.uidcache"));
+  ASSERT_TRUE(read.has_value());
+  EXPECT_EQ(*read, uids);
+
+  ASSERT_TRUE(VideoCommon::WriteGXPipelineUIDCache(GetPath("empty.uidcache"), {}));
+  const auto empty = VideoCommon::ReadGXPipelineUIDCache(GetPath("empty.uidcache"));
+  ASSERT_TRUE(empty.has_value());
+  EXPECT_TRUE(empty->empty());
+}
+
+TEST_F(GXPipelineUIDCacheTest, RejectsMissingAndOtherVersions)
+{
+  EXPECT_FALSE(VideoCommon::ReadGXPipelineUIDCache(GetPath("missing.uidcache")).has_value());
+
+  const u32 header[] = {VideoCommon::GX_PIPELINE_UID_CACHE_MAGIC,
+                        VideoCommon::GX_PIPELINE_UID_VERSION + 1};
+  const SerializedGXPipelineUid uid = MakeUid(1);
+  {
+    File::IOFile file(GetPath("old.uidcache"), "wb");
+    ASSERT_TRUE(file.WriteArray(header, 2) && file.WriteArray(&uid, 1));
+  }
+  EXPECT_FALSE(VideoCommon::ReadGXPipelineUIDCache(GetPath("old.uidcache")).has_value());
+}
+
+TEST_F(GXPipelineUIDCacheTest, IgnoresPartialLastUid)
+{
+  const std::vector<SerializedGXPipelineUid> uids{MakeUid(1), MakeUid(2)};
+  ASSERT_TRUE(VideoCommon::WriteGXPipelineUIDCache(GetPath("a.uidcache"), uids));
+  {
+    // Like a crash while appending a UID
+    File::IOFile file(GetPath("a.uidcache"), "ab");
+    const SerializedGXPipelineUid uid = MakeUid(3);
+    ASSERT_TRUE(file.WriteBytes(&uid, sizeof(uid) / 2));
+  }
+
+  const auto read = VideoCommon::ReadGXPipelineUIDCache(GetPath("a.uidcache"));
+  ASSERT_TRUE(read.has_value());
+  EXPECT_EQ(*read, uids);
+}
+
+TEST_F(GXPipelineUIDCacheTest, MergeDeduplicatesInOrder)
+{
+  std::vector<SerializedGXPipelineUid> merged;
+  const std::vector<SerializedGXPipelineUid> first{MakeUid(3), MakeUid(1), MakeUid(3)};
+  const std::vector<SerializedGXPipelineUid> second{MakeUid(2), MakeUid(1), MakeUid(4)};
+
+  EXPECT_EQ(VideoCommon::MergeGXPipelineUIDs(&merged, first), 2u);
+  EXPECT_EQ(VideoCommon::MergeGXPipelineUIDs(&merged, second), 2u);
+  EXPECT_EQ(VideoCommon::MergeGXPipelineUIDs(&merged, second), 0u);
+
+  const std::vector<SerializedGXPipelineUid> expected{MakeUid(3), MakeUid(1), MakeUid(2),
+                                                      MakeUid(4)};
+  EXPECT_EQ(merged, expected);
+}
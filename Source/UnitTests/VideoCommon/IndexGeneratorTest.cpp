@@ -0,0 +1,65 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BatchWorkerPool.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+static std::vector<u16> GenerateIndices(BatchWorkerPool* workers, Primitive primitive,
+                                        const std::vector<u32>& batches)
+{
+  std::vector<u16> indices(0x40000, 0);
+  IndexGenerator generator;
+  generator.Init(workers);
+  generator.Start(indices.data());
+  for (u32 num_vertices : batches)
+    generator.AddIndices(primitive, num_vertices);
+
+  indices.resize(generator.GetIndexLen());
+  return indices;
+}
+
+class IndexGeneratorTest : public testing::TestWithParam<bool>
+{
+protected:
+  void SetUp() override { g_Config.backend_info.bSupportsPrimitiveRestart = GetParam(); }
+};
+
+TEST_P(IndexGeneratorTest, BatchWorkersMatchSerial)
+{
+  BatchWorkerPool workers;
+  workers.Start(3);
+
+  // Batches which don't end on a primitive boundary, behind a small one so the base index isn't 0
+  const std::vector<u32> batches = {6, 9601, 20000, 12003};
+  for (Primitive primitive : {Primitive::GX_DRAW_TRIANGLES, Primitive::GX_DRAW_QUADS,
+                              Primitive::GX_DRAW_TRIANGLE_STRIP, Primitive::GX_DRAW_TRIANGLE_FAN})
+  {
+    EXPECT_EQ(GenerateIndices(nullptr, primitive, batches),
+              GenerateIndices(&workers, primitive, batches))
+        << "primitive " << static_cast<int>(primitive);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(PrimitiveRestart, IndexGeneratorTest, testing::Bool());
+
+TEST(BatchWorkerPool, RunsEveryChunkOnce)
+{
+  BatchWorkerPool workers;
+  workers.Start(2);
+
+  for (u32 num_chunks : {0u, 1u, 7u, 100u})
+  {
+    std::vector<u32> runs(num_chunks, 0);
+    workers.Run(num_chunks, [&](u32 chunk) { ++runs[chunk]; });
+    EXPECT_EQ(std::vector<u32>(num_chunks, 1), runs);
+  }
+}
@@ -0,0 +1,185 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+struct Output
+{
+  std::vector<u32> colors;
+  std::vector<u32> depths;
+  std::array<u16, 4> bbox{};
+  int rasterized_pixels = 0;
+  int tev_pixels_in = 0;
+  int tev_pixels_out = 0;
+
+  bool operator==(const Output&) const = default;
+};
+
+class SWRasterizerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::memset(&bpmem, 0, sizeof(bpmem));
+    bpmem.genMode.numcolchans = 1;
+    bpmem.genMode.numtevstages = 0;
+    bpmem.tevorders[0].colorchan_even = RasColorChan::Color0;
+    bpmem.combiners[0].colorC.d = TevColorArg::RasColor;
+    bpmem.combiners[0].alphaC.d = TevAlphaArg::RasAlpha;
+    bpmem.alpha_test.comp0 = CompareMode::Always;
+    bpmem.alpha_test.comp1 = CompareMode::Always;
+    bpmem.blendmode.colorupdate = true;
+    bpmem.blendmode.alphaupdate = true;
+    bpmem.zmode.testenable = true;
+    bpmem.zmode.func = CompareMode::LEqual;
+    bpmem.zmode.updateenable = true;
+    bpmem.zcontrol.pixel_format = PixelFormat::RGBA6_Z24;
+
+    // The whole EFB, without offset
+    bpmem.scissorTL.x = 0;
+    bpmem.scissorTL.y = 0;
+    bpmem.scissorBR.x = EFB_WIDTH - 1;
+    bpmem.scissorBR.y = EFB_HEIGHT - 1;
+    Rasterizer::ScissorChanged();
+  }
+
+  void TearDown() override { Rasterizer::Shutdown(); }
+
+  // Draws overlapping triangles with the given number of threads
+  static Output Draw(int threads)
+  {
+    g_ActiveConfig.iSWRasterizerThreads = threads;
+    Rasterizer::Init();
+
+    u8 clear_color[4] = {};
+    for (u16 y = 0; y < EFB_HEIGHT; y++)
+    {
+      for (u16 x = 0; x < EFB_WIDTH; x++)
+      {
+        EfbInterface::SetColor(x, y, clear_color);
+        EfbInterface::SetDepth(x, y, 0xFFFFFF);
+      }
+    }
+    for (int i = 0; i < 4; i++)
+      BBoxManager::SetCoordinate(static_cast<BBoxManager::Coordinate>(i), i % 2 ? 0 : 0xFFFF);
+    g_stats.this_frame = {};
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> x_dist(-32.0f, EFB_WIDTH + 32.0f);
+    std::uniform_real_distribution<float> y_dist(-32.0f, EFB_HEIGHT + 32.0f);
+    std::uniform_real_distribution<float> z_dist(0.0f, 16777215.0f);
+    std::uniform_real_distribution<float> w_dist(0.5f, 4.0f);
+    std::uniform_real_distribution<float> color_dist(0.0f, 255.0f);
+
+    for (int i = 0; i < 300; i++)
+    {
+      OutputVertexData vertices[3]{};
+      for (OutputVertexData& vertex : vertices)
+      {
+        vertex.screenPosition = {x_dist(rng), y_dist(rng), z_dist(rng)};
+        vertex.projectedPosition.w = w_dist(rng);
+        for (int comp = 0; comp < 4; comp++)
+          vertex.color[0][comp] = static_cast<u8>(color_dist(rng));
+      }
+      // Both windings, as the clipper only passes front faces in the order that draws them
+      if (i % 2)
+        Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[1], &vertices[2]);
+      else
+        Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[2], &vertices[1]);
+    }
+    Rasterizer::Flush();
+
+    Output output;
+    for (u16 y = 0; y < EFB_HEIGHT; y++)
+    {
+      for (u16 x = 0; x < EFB_WIDTH; x++)
+      {
+        output.colors.push_back(EfbInterface::GetColor(x, y));
+        output.depths.push_back(EfbInterface::GetDepth(x, y));
+      }
+    }
+    for (int i = 0; i < 4; i++)
+      output.bbox[i] = BBoxManager::GetCoordinate(static_cast<BBoxManager::Coordinate>(i));
+    output.rasterized_pixels = g_stats.this_frame.rasterized_pixels;
+    output.tev_pixels_in = g_stats.this_frame.tev_pixels_in;
+    output.tev_pixels_out = g_stats.this_frame.tev_pixels_out;
+    return output;
+  }
+};
+}  // namespace
+
+TEST_F(SWRasterizerTest, ThreadsMatchSerialLateZ)
+{
+  const Output serial = Draw(1);
+  EXPECT_GT(serial.tev_pixels_out, 0);
+  EXPECT_EQ(serial, Draw(4));
+}
+
+TEST_F(SWRasterizerTest, ThreadsMatchSerialEarlyZBlend)
+{
+  bpmem.zcontrol.early_ztest = true;
+  bpmem.blendmode.blendenable = true;
+  bpmem.blendmode.srcfactor = SrcBlendFactor::SrcAlpha;
+  bpmem.blendmode.dstfactor = DstBlendFactor::InvSrcAlpha;
+
+  const Output serial = Draw(1);
+  EXPECT_GT(serial.tev_pixels_out, 0);
+  EXPECT_EQ(serial, Draw(3));
+}
+
+TEST_F(SWRasterizerTest, MarksDrawnTilesDirty)
+{
+  using Rasterizer::TILE_SIZE;
+
+  // Tiles 1 and 2 across, 1 and 2 down
+  const Rasterizer::TileMask expected =
+      Rasterizer::GetTiles(TILE_SIZE + 8, TILE_SIZE + 8, 3 * TILE_SIZE - 8, 3 * TILE_SIZE - 8);
+  EXPECT_EQ(4u, expected.count());
+
+  for (int threads : {1, 4})
+  {
+    g_ActiveConfig.iSWRasterizerThreads = threads;
+    Rasterizer::Init();
+    EXPECT_TRUE(Rasterizer::TakeDirtyTiles().all());
+    EXPECT_TRUE(Rasterizer::TakeDirtyTiles().none());
+
+    OutputVertexData vertices[3]{};
+    vertices[0].screenPosition = {TILE_SIZE + 8.0f, TILE_SIZE + 8.0f, 0.0f};
+    vertices[1].screenPosition = {3 * TILE_SIZE - 8.0f, TILE_SIZE + 8.0f, 0.0f};
+    vertices[2].screenPosition = {TILE_SIZE + 8.0f, 3 * TILE_SIZE - 8.0f, 0.0f};
+    for (OutputVertexData& vertex : vertices)
+      vertex.projectedPosition.w = 1.0f;
+    Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[1], &vertices[2]);
+    Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[2], &vertices[1]);
+    Rasterizer::Flush();
+
+    EXPECT_EQ(expected, Rasterizer::TakeDirtyTiles()) << threads << " threads";
+    Rasterizer::Shutdown();
+  }
+
+  // Clipped to the EFB
+  Rasterizer::TileMask corners;
+  corners.set(0);
+  corners.set(Rasterizer::TILES_X * Rasterizer::TILES_Y - 1);
+  EXPECT_EQ(corners, Rasterizer::GetTiles(-8, -8, 1, 1) |
+                         Rasterizer::GetTiles(EFB_WIDTH - 1, EFB_HEIGHT - 1, EFB_WIDTH + 8,
+                                              EFB_HEIGHT + 8));
+  EXPECT_TRUE(Rasterizer::GetTiles(8, 8, 8, 16).none());
+}
@@ -0,0 +1,364 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TevCombiner.h"
+#include "VideoCommon/BPMemory.h"
+
+using TevCombiner::InstructionSet;
+
+namespace
+{
+constexpr InstructionSet INSTRUCTION_SETS[] = {InstructionSet::SSE41, InstructionSet::AVX2};
+
+constexpr s32 BIAS[] = {0, 128, -128};
+constexpr int SCALE_LEFT[] = {0, 1, 2, 0};
+constexpr int SCALE_RIGHT[] = {0, 0, 0, 1};
+
+// The combiners as the Tev computed them before they were vectorized
+s32 ReferenceColor(const TevStageCombiner::ColorCombiner& cc, s32 a, s32 b, s32 c, s32 d)
+{
+  const int scale = static_cast<int>(cc.scale.Value());
+  c = c + (c >> 7);
+
+  s32 temp = a * (256 - c) + (b * c);
+  temp <<= SCALE_LEFT[scale];
+  temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
+  temp >>= 8;
+  temp = cc.op == TevOp::Sub ? -temp : temp;
+
+  s32 result = ((d + BIAS[static_cast<int>(cc.bias.Value())]) << SCALE_LEFT[scale]) + temp;
+  result = result >> SCALE_RIGHT[scale];
+  return cc.clamp ? std::clamp(result, 0, 255) : std::clamp(result, -1024, 1023);
+}
+
+s32 ReferenceAlpha(const TevStageCombiner::AlphaCombiner& ac, s32 a, s32 b, s32 c, s32 d)
+{
+  const int scale = static_cast<int>(ac.scale.Value());
+  c = c + (c >> 7);
+
+  s32 temp = a * (256 - c) + (b * c);
+  temp <<= SCALE_LEFT[scale];
+  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
+  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+
+  s32 result = ((d + BIAS[static_cast<int>(ac.bias.Value())]) << SCALE_LEFT[scale]) + temp;
+  result = result >> SCALE_RIGHT[scale];
+  return ac.clamp ? std::clamp(result, 0, 255) : std::clamp(result, -1024, 1023);
+}
+
+// All settings of the combiners which do not use compare mode
+std::vector<std::pair<TevStageCombiner::ColorCombiner, TevStageCombiner::AlphaCombiner>>
+AllCombiners()
+{
+  std::vector<std::pair<TevStageCombiner::ColorCombiner, TevStageCombiner::AlphaCombiner>> result;
+  for (u32 scale = 0; scale < 4; scale++)
+  {
+    for (u32 bias = 0; bias < 3; bias++)
+    {
+      for (u32 op = 0; op < 2; op++)
+      {
+        for (u32 clamp = 0; clamp < 2; clamp++)
+        {
+          TevStageCombiner::ColorCombiner cc{};
+          cc.scale = static_cast<TevScale>(scale);
+          cc.bias = static_cast<TevBias>(bias);
+          cc.op = static_cast<TevOp>(op);
+          cc.clamp = clamp != 0;
+
+          // Pair every color setting with a different alpha setting
+          TevStageCombiner::AlphaCombiner ac{};
+          ac.scale = static_cast<TevScale>(3 - scale);
+          ac.bias = static_cast<TevBias>((bias + 1) % 3);
+          ac.op = static_cast<TevOp>(op);
+          ac.clamp = clamp == 0;
+          result.emplace_back(cc, ac);
+
+          ac.scale = static_cast<TevScale>(scale);
+          ac.bias = static_cast<TevBias>(bias);
+          ac.op = static_cast<TevOp>(1 - op);
+          ac.clamp = clamp != 0;
+          result.emplace_back(cc, ac);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+// Random inputs in the ranges of the Tev's input registers, with their extremes
+std::vector<TevCombiner::Inputs> MakeInputs()
+{
+  static constexpr s32 EDGES_8[] = {0, 1, 127, 128, 129, 254, 255};
+  static constexpr s32 EDGES_11[] = {-1024, -1023, -129, -1, 0, 1, 255, 256, 1022, 1023};
+
+  std::vector<TevCombiner::Inputs> result;
+  std::mt19937 rng(5678);
+  std::uniform_int_distribution<s32> dist_8(0, 255);
+  std::uniform_int_distribution<s32> dist_11(-1024, 1023);
+  std::uniform_int_distribution<size_t> edge_8(0, std::size(EDGES_8) - 1);
+  std::uniform_int_distribution<size_t> edge_11(0, std::size(EDGES_11) - 1);
+
+  for (int i = 0; i < 2000; i++)
+  {
+    const bool edges = i % 2 != 0;
+    TevCombiner::Inputs inputs;
+    for (int lane = 0; lane < 4; lane++)
+    {
+      inputs.a[lane] = edges ? EDGES_8[edge_8(rng)] : dist_8(rng);
+      inputs.b[lane] = edges ? EDGES_8[edge_8(rng)] : dist_8(rng);
+      inputs.c[lane] = edges ? EDGES_8[edge_8(rng)] : dist_8(rng);
+      inputs.d[lane] = edges ? EDGES_11[edge_11(rng)] : dist_11(rng);
+    }
+    result.push_back(inputs);
+  }
+  return result;
+}
+
+std::string Name(InstructionSet set)
+{
+  return set == InstructionSet::AVX2 ? "AVX2" : set == InstructionSet::SSE41 ? "SSE4.1" : "Scalar";
+}
+
+template <typename F>
+void Benchmark(const char* name, F&& kernel)
+{
+  constexpr int ITERATIONS = 10000000;
+  for (InstructionSet set :
+       {InstructionSet::Scalar, InstructionSet::SSE41, InstructionSet::AVX2})
+  {
+    if (!TevCombiner::IsSupported(set))
+      continue;
+
+    const TevCombiner::Functions& functions = TevCombiner::GetFunctions(set);
+    const auto start = std::chrono::steady_clock::now();
+    kernel(functions, ITERATIONS);
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fmt::print("{} {}: {:.2f} ns per pixel\n", name, Name(set), elapsed.count() / ITERATIONS);
+  }
+}
+}  // namespace
+
+TEST(SWTevCombiner, ScalarMatchesTev)
+{
+  const std::vector<TevCombiner::Inputs> all_inputs = MakeInputs();
+  const TevCombiner::Functions& functions = TevCombiner::GetFunctions(InstructionSet::Scalar);
+
+  for (const auto& [cc, ac] : AllCombiners())
+  {
+    const TevCombiner::Params params = TevCombiner::MakeParams(cc, ac);
+    for (const TevCombiner::Inputs& inputs : all_inputs)
+    {
+      s32 output[4];
+      functions.combine(inputs, params, output);
+
+      ASSERT_EQ(ReferenceAlpha(ac, inputs.a[0], inputs.b[0], inputs.c[0], inputs.d[0]), output[0])
+          << "alpha combiner " << ac.hex;
+      for (int lane = 1; lane < 4; lane++)
+      {
+        ASSERT_EQ(ReferenceColor(cc, inputs.a[lane], inputs.b[lane], inputs.c[lane],
+                                 inputs.d[lane]),
+                  output[lane])
+            << "color combiner " << cc.hex;
+      }
+    }
+  }
+}
+
+TEST(SWTevCombiner, CombineMatchesScalar)
+{
+  const std::vector<TevCombiner::Inputs> all_inputs = MakeInputs();
+  const TevCombiner::Functions& scalar = TevCombiner::GetFunctions(InstructionSet::Scalar);
+
+  for (InstructionSet set : INSTRUCTION_SETS)
+  {
+    if (!TevCombiner::IsSupported(set))
+      continue;
+
+    const TevCombiner::Functions& functions = TevCombiner::GetFunctions(set);
+    for (const auto& [cc, ac] : AllCombiners())
+    {
+      const TevCombiner::Params params = TevCombiner::MakeParams(cc, ac);
+      for (const TevCombiner::Inputs& inputs : all_inputs)
+      {
+        s32 expected[4];
+        s32 output[4];
+        scalar.combine(inputs, params, expected);
+        functions.combine(inputs, params, output);
+        ASSERT_TRUE(std::equal(expected, expected + 4, output))
+            << Name(set) << " with combiners " << cc.hex << ", " << ac.hex;
+      }
+    }
+  }
+}
+
+TEST(SWTevCombiner, FiltersMatchScalar)
+{
+  const TevCombiner::Functions& scalar = TevCombiner::GetFunctions(InstructionSet::Scalar);
+  std::mt19937 rng(91011);
+  std::uniform_int_distribution<u32> byte(0, 255);
+
+  for (InstructionSet set : INSTRUCTION_SETS)
+  {
+    if (!TevCombiner::IsSupported(set))
+      continue;
+
+    const TevCombiner::Functions& functions = TevCombiner::GetFunctions(set);
+    for (int i = 0; i < 1000; i++)
+    {
+      u8 texels[4][4];
+      for (auto& texel : texels)
+      {
+        for (u8& channel : texel)
+          channel = static_cast<u8>(i % 2 ? byte(rng) | 0xF0 : byte(rng));
+      }
+
+      for (u32 fract_s = 0; fract_s < 128; fract_s += 9)
+      {
+        for (u32 fract_t = 0; fract_t < 128; fract_t += 11)
+        {
+          u8 expected[4];
+          u8 sample[4];
+          scalar.bilinear(texels, fract_s, fract_t, expected);
+          functions.bilinear(texels, fract_s, fract_t, sample);
+          ASSERT_TRUE(std::equal(expected, expected + 4, sample)) << Name(set) << " bilinear";
+        }
+      }
+
+      for (u32 fract = 0; fract <= 16; fract++)
+      {
+        u8 expected[4];
+        u8 sample[4];
+        scalar.lerp(texels[0], texels[3], fract, expected);
+        functions.lerp(texels[0], texels[3], fract, sample);
+        ASSERT_TRUE(std::equal(expected, expected + 4, sample)) << Name(set) << " lerp";
+      }
+    }
+  }
+}
+
+// Microbenchmark of the kernels, run with --gtest_also_run_disabled_tests
+TEST(SWTevCombiner, DISABLED_Benchmark)
+{
+  const std::vector<TevCombiner::Inputs> all_inputs = MakeInputs();
+  const auto [cc, ac] = AllCombiners()[5];
+  const TevCombiner::Params params = TevCombiner::MakeParams(cc, ac);
+
+  Benchmark("combine", [&](const TevCombiner::Functions& functions, int iterations) {
+    s32 sum = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+      s32 output[4];
+      functions.combine(all_inputs[i % all_inputs.size()], params, output);
+      sum += output[0] + output[3];
+    }
+    EXPECT_NE(sum, 1);
+  });
+
+  u8 texels[4][4] = {{1, 2, 3, 4}, {50, 60, 70, 80}, {200, 10, 20, 30}, {255, 255, 0, 128}};
+  Benchmark("bilinear", [&](const TevCombiner::Functions& functions, int iterations) {
+    u32 sum = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+      u8 sample[4];
+      functions.bilinear(texels, i & 0x7F, (i >> 7) & 0x7F, sample);
+      sum += sample[0] + sample[3];
+    }
+    EXPECT_NE(sum, 1u);
+  });
+
+  Benchmark("lerp", [&](const TevCombiner::Functions& functions, int iterations) {
+    u32 sum = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+      u8 sample[4];
+      functions.lerp(texels[i & 3], texels[(i >> 2) & 3], i & 0xF, sample);
+      sum += sample[0] + sample[3];
+    }
+    EXPECT_NE(sum, 1u);
+  });
+}
+
+// A whole stage the way the Tev draws it: the inputs come from 16 bit registers and the result goes
+// back to one. Compares the SIMD combiners to combining the channels one by one inline, which the
+// Tev does without SIMD. Run with --gtest_also_run_disabled_tests
+TEST(SWTevCombiner, DISABLED_StageBenchmark)
+{
+  constexpr int ITERATIONS = 10000000;
+  const auto [cc, ac] = AllCombiners()[5];
+  const TevCombiner::Params params = TevCombiner::MakeParams(cc, ac);
+
+  // Four registers of alpha, blue, green and red, and the registers each stage reads
+  std::mt19937 rng(1213);
+  s16 initial[4][4];
+  for (auto& reg : initial)
+  {
+    for (s16& channel : reg)
+      channel = static_cast<s16>(rng() % 256);
+  }
+  std::vector<std::array<u8, 5>> stages(4096);
+  for (auto& stage : stages)
+  {
+    for (u8& reg : stage)
+      reg = static_cast<u8>(rng() % 4);
+  }
+
+  const auto time = [&](const char* name, auto&& combine) {
+    s16 regs[4][4];
+    std::memcpy(regs, initial, sizeof(regs));
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+      const auto& [a, b, c, d, dest] = stages[i % stages.size()];
+      combine(regs[a], regs[b], regs[c], regs[d], regs[dest]);
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fmt::print("stage {}: {:.2f} ns\n", name, elapsed.count() / ITERATIONS);
+    EXPECT_NE(regs[0][0], -2000);
+  };
+
+  time("per channel", [&](const s16* a, const s16* b, const s16* c, const s16* d, s16* dest) {
+    dest[0] = static_cast<s16>(ReferenceAlpha(ac, a[0] & 0xFF, b[0] & 0xFF, c[0] & 0xFF, d[0]));
+    for (int lane = 1; lane < 4; lane++)
+    {
+      dest[lane] = static_cast<s16>(
+          ReferenceColor(cc, a[lane] & 0xFF, b[lane] & 0xFF, c[lane] & 0xFF, d[lane]));
+    }
+  });
+
+  for (InstructionSet set : INSTRUCTION_SETS)
+  {
+    if (!TevCombiner::IsSupported(set))
+      continue;
+
+    const TevCombiner::CombineFunction combine = TevCombiner::GetFunctions(set).combine;
+    time(Name(set).c_str(),
+         [&](const s16* a, const s16* b, const s16* c, const s16* d, s16* dest) {
+           TevCombiner::Inputs lanes;
+           for (int lane = 0; lane < 4; lane++)
+           {
+             lanes.a[lane] = a[lane] & 0xFF;
+             lanes.b[lane] = b[lane] & 0xFF;
+             lanes.c[lane] = c[lane] & 0xFF;
+             lanes.d[lane] = d[lane];
+           }
+           s32 result[4];
+           combine(lanes, params, result);
+           for (int lane = 0; lane < 4; lane++)
+             dest[lane] = static_cast<s16>(result[lane]);
+         });
+  }
+}
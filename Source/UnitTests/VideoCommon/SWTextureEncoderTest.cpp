@@ -0,0 +1,101 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <iterator>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TextureEncoder.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/VideoCommon.h"
+
+using TextureEncoder::InstructionSet;
+
+namespace
+{
+constexpr PixelFormat EFB_FORMATS[] = {PixelFormat::RGBA6_Z24, PixelFormat::RGB8_Z24,
+                                       PixelFormat::RGB565_Z16, PixelFormat::Z24};
+
+// The formats with SSSE3 encoders, followed by some which always use the scalar ones
+constexpr EFBCopyFormat COLOR_COPY_FORMATS[] = {EFBCopyFormat::RGBA8, EFBCopyFormat::RGB565,
+                                                EFBCopyFormat::R8,    EFBCopyFormat::R8_0x1,
+                                                EFBCopyFormat::RA8,   EFBCopyFormat::RGB5A3};
+// Depth can only be copied to some of the formats
+constexpr EFBCopyFormat DEPTH_COPY_FORMATS[] = {EFBCopyFormat::RGBA8, EFBCopyFormat::R8,
+                                                EFBCopyFormat::R8_0x1, EFBCopyFormat::G8};
+
+// Copy sizes around the 4 and 8 pixel block sizes, up to a copy as wide as the EFB
+constexpr u32 WIDTHS[] = {1, 3, 4, 7, 8, 9, 33, 64, EFB_WIDTH};
+constexpr u32 HEIGHTS[] = {1, 4, 5, 8, 31};
+
+// The destination stride of the widest copy, in 32 byte units
+constexpr u32 DEST_STRIDE = EFB_WIDTH * 4 * 4 / 32;
+// The blocks of the tested formats are 4 pixels high, and half scale copies read twice the rows
+constexpr u32 MAX_BLOCK_ROWS = HEIGHTS[std::size(HEIGHTS) - 1] / 4 + 1;
+constexpr u32 MAX_SOURCE_ROWS = MAX_BLOCK_ROWS * 4 * 2;
+
+std::vector<u8> Encode(const u8* src, PixelFormat efb_format, EFBCopyFormat copy_format, bool yuv,
+                       bool scale_by_half, InstructionSet set)
+{
+  // Anything the encoders don't write stays the same for both
+  std::vector<u8> dst(DEST_STRIDE * 32 * MAX_BLOCK_ROWS, 0xcd);
+  TextureEncoder::EncodeEfbCopy(dst.data(), src, efb_format, copy_format, yuv, scale_by_half,
+                                set);
+  return dst;
+}
+}  // namespace
+
+TEST(SWTextureEncoder, SSSE3MatchesScalar)
+{
+  if (!TextureEncoder::IsSupported(InstructionSet::SSSE3))
+    GTEST_SKIP() << "SSSE3 is not supported";
+
+  // Random data in the EFB layout, with the copies starting at an odd position
+  std::mt19937 rng(1234);
+  std::vector<u8> efb(EFB_WIDTH * 3 * (MAX_SOURCE_ROWS + 2));
+  for (u8& byte : efb)
+    byte = static_cast<u8>(rng());
+  const u8* const src = &efb[(EFB_WIDTH + 1) * 3];
+
+  bpmem.copyDestStride = DEST_STRIDE;
+  for (const u32 width : WIDTHS)
+  {
+    for (const u32 height : HEIGHTS)
+    {
+      // Half scale copies read two pixels per pixel
+      for (const bool scale_by_half : {false, true})
+      {
+        const u32 src_width = scale_by_half ? width * 2 : width;
+        if (src_width > EFB_WIDTH)
+          continue;
+
+        bpmem.triggerEFBCopy.half_scale = scale_by_half;
+        bpmem.copyTexSrcWH.x = src_width - 1;
+        bpmem.copyTexSrcWH.y = (scale_by_half ? height * 2 : height) - 1;
+        for (const PixelFormat efb_format : EFB_FORMATS)
+        {
+          std::span<const EFBCopyFormat> copy_formats = COLOR_COPY_FORMATS;
+          if (efb_format == PixelFormat::Z24)
+            copy_formats = DEPTH_COPY_FORMATS;
+          for (const EFBCopyFormat copy_format : copy_formats)
+          {
+            for (const bool yuv : {false, true})
+            {
+              EXPECT_EQ(Encode(src, efb_format, copy_format, yuv, scale_by_half,
+                               InstructionSet::Scalar),
+                        Encode(src, efb_format, copy_format, yuv, scale_by_half,
+                               InstructionSet::SSSE3))
+                  << "EFB format " << static_cast<int>(efb_format) << ", copy format "
+                  << static_cast<int>(copy_format) << ", yuv " << yuv << ", half scale "
+                  << scale_by_half << ", " << width << "x" << height;
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,576 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/SlabAllocator.h"
+#include "VideoCommon/TextureCacheIndex.h"
+#include "VideoCommon/TextureCacheTrace.h"
+
+using VideoCommon::TextureCacheTraceRecord;
+using Op = TextureCacheTraceRecord::Op;
+
+namespace
+{
+struct Entry
+{
+  u32 address = 0;
+  u32 size = 0;
+  std::optional<u64> hash_key;
+};
+
+using EntryPtr = std::shared_ptr<Entry>;
+
+bool Overlaps(const Entry& entry, u32 address, u32 size)
+{
+  return entry.address < address + size && entry.address + entry.size > address;
+}
+
+template <typename Range>
+std::vector<EntryPtr> ToVector(Range&& range)
+{
+  std::vector<EntryPtr> result;
+  for (const EntryPtr& entry : range)
+    result.push_back(entry);
+  return result;
+}
+
+// The indices as the texture cache had them before, for comparison. The lookups visit the
+// entries in place, as the texture cache walked the multimaps with iterators.
+struct MultimapIndices
+{
+  std::multimap<u32, EntryPtr> by_address;
+  std::multimap<u64, EntryPtr> by_hash;
+
+  template <typename Function>
+  void Find(u32 address, Function function) const
+  {
+    const auto range = by_address.equal_range(address);
+    for (auto iter = range.first; iter != range.second; ++iter)
+      function(iter->second);
+  }
+
+  template <typename Function>
+  void FindOverlapping(u32 address, u32 size, Function function) const
+  {
+    constexpr u32 max_texture_size = 1024 * 1024 * 4;
+    const u32 lower_addr = address > max_texture_size ? address - max_texture_size : 0;
+
+    const auto end = by_address.upper_bound(address + size);
+    for (auto iter = by_address.lower_bound(lower_addr); iter != end; ++iter)
+    {
+      if (Overlaps(*iter->second, address, size))
+        function(iter->second);
+    }
+  }
+
+  template <typename Function>
+  void FindHash(u64 hash, Function function) const
+  {
+    const auto range = by_hash.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; ++iter)
+      function(iter->second);
+  }
+
+  std::vector<EntryPtr> Find(u32 address) const
+  {
+    std::vector<EntryPtr> result;
+    Find(address, [&result](const EntryPtr& entry) { result.push_back(entry); });
+    return result;
+  }
+
+  std::vector<EntryPtr> FindOverlapping(u32 address, u32 size) const
+  {
+    std::vector<EntryPtr> result;
+    FindOverlapping(address, size, [&result](const EntryPtr& entry) { result.push_back(entry); });
+    return result;
+  }
+
+  std::vector<EntryPtr> FindHash(u64 hash) const
+  {
+    std::vector<EntryPtr> result;
+    FindHash(hash, [&result](const EntryPtr& entry) { result.push_back(entry); });
+    return result;
+  }
+
+  void Erase(const Entry* entry)
+  {
+    const auto range = by_address.equal_range(entry->address);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->second.get() == entry)
+      {
+        by_address.erase(iter);
+        return;
+      }
+    }
+  }
+
+  void EraseHash(const Entry* entry)
+  {
+    const auto range = by_hash.equal_range(*entry->hash_key);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->second.get() == entry)
+      {
+        by_hash.erase(iter);
+        return;
+      }
+    }
+  }
+};
+
+// Replays a trace on the old or the new indices, and returns a checksum of the lookups
+template <bool UseNewIndices>
+u64 Replay(const std::vector<TextureCacheTraceRecord>& trace)
+{
+  VideoCommon::TextureAddressIndex<Entry> by_address;
+  VideoCommon::TextureHashIndex<Entry> by_hash;
+  MultimapIndices multimaps;
+  Common::SlabAllocator<Entry> allocator;
+
+  std::vector<EntryPtr> entries;
+  u64 checksum = 0;
+  const auto add_result = [&checksum](const EntryPtr& entry) {
+    checksum = checksum * 31 + entry->address + 1;
+  };
+
+  for (const TextureCacheTraceRecord& record : trace)
+  {
+    if (record.entry >= entries.size() && record.op == Op::Insert)
+      entries.resize(record.entry + 1);
+    EntryPtr* entry = record.entry < entries.size() ? &entries[record.entry] : nullptr;
+
+    switch (record.op)
+    {
+    case Op::Clear:
+      by_address.Clear();
+      by_hash.Clear();
+      multimaps = {};
+      entries.clear();
+      break;
+    case Op::Insert:
+      if constexpr (UseNewIndices)
+        *entry = std::allocate_shared<Entry>(allocator, Entry{record.address, record.size});
+      else
+        *entry = std::make_shared<Entry>(Entry{record.address, record.size});
+
+      if constexpr (UseNewIndices)
+        by_address.Insert(record.address, record.size, *entry);
+      else
+        multimaps.by_address.emplace(record.address, *entry);
+      break;
+    case Op::Erase:
+      if (!entry || !*entry)
+        break;
+      if constexpr (UseNewIndices)
+        by_address.Erase((*entry)->address, entry->get());
+      else
+        multimaps.Erase(entry->get());
+      if (!(*entry)->hash_key)
+        entry->reset();
+      break;
+    case Op::InsertHash:
+      if (!entry || !*entry)
+        break;
+      (*entry)->hash_key = record.hash;
+      if constexpr (UseNewIndices)
+        by_hash.Insert(record.hash, *entry);
+      else
+        multimaps.by_hash.emplace(record.hash, *entry);
+      break;
+    case Op::EraseHash:
+      if (!entry || !*entry || !(*entry)->hash_key)
+        break;
+      if constexpr (UseNewIndices)
+        by_hash.Erase(*(*entry)->hash_key, entry->get());
+      else
+        multimaps.EraseHash(entry->get());
+      (*entry)->hash_key.reset();
+      break;
+    case Op::Find:
+      if constexpr (UseNewIndices)
+      {
+        for (const EntryPtr& result : by_address.Find(record.address))
+          add_result(result);
+      }
+      else
+      {
+        multimaps.Find(record.address, add_result);
+      }
+      break;
+    case Op::FindOverlapping:
+      if constexpr (UseNewIndices)
+      {
+        for (const EntryPtr& result : by_address.FindOverlapping(record.address, record.size))
+          add_result(result);
+      }
+      else
+      {
+        multimaps.FindOverlapping(record.address, record.size, add_result);
+      }
+      break;
+    case Op::FindHash:
+      if constexpr (UseNewIndices)
+      {
+        for (const EntryPtr& result : by_hash.Find(record.hash))
+          add_result(result);
+      }
+      else
+      {
+        multimaps.FindHash(record.hash, add_result);
+      }
+      break;
+    }
+  }
+  return checksum;
+}
+
+// A trace shaped like a frame of a game doing many EFB copies: the copies land on a few buffers
+// and invalidate the textures they overlap, while the same textures are looked up over and over.
+std::vector<TextureCacheTraceRecord> MakeSyntheticTrace(int frames, int textures = 2000)
+{
+  std::vector<TextureCacheTraceRecord> trace;
+  std::mt19937 rng(1357);
+  u64 next_entry = 0;
+
+  struct Live
+  {
+    u64 id;
+    u32 address;
+    u32 size;
+    std::optional<u64> hash;
+  };
+  std::vector<Live> live;
+
+  const auto insert = [&](u32 address, u32 size, std::optional<u64> hash) {
+    const u64 id = next_entry++;
+    trace.push_back({Op::Insert, address, size, 0, 0, id});
+    if (hash)
+      trace.push_back({Op::InsertHash, 0, 0, 0, *hash, id});
+    live.push_back({id, address, size, hash});
+  };
+  const auto erase = [&](size_t index) {
+    const Live& entry = live[index];
+    trace.push_back({Op::Erase, 0, 0, 0, 0, entry.id});
+    if (entry.hash)
+      trace.push_back({Op::EraseHash, 0, 0, 0, 0, entry.id});
+    live.erase(live.begin() + index);
+  };
+
+  // Static textures, loaded once
+  std::uniform_int_distribution<u32> texture_address(0x00100000, 0x01700000);
+  std::uniform_int_distribution<u32> texture_size(1, 64);
+  for (int i = 0; i < textures; i++)
+    insert(texture_address(rng) & ~31u, texture_size(rng) * 1024, rng() % 500);
+
+  for (int frame = 0; frame < frames; frame++)
+  {
+    for (int copy = 0; copy < 40; copy++)
+    {
+      const u32 address = 0x01780000 + (copy % 8) * 0x40000;
+      const u32 size = 0x20000 >> (copy % 3);
+      trace.push_back({Op::FindOverlapping, address, size, 0, 0, 0});
+      for (size_t i = live.size(); i-- > 0;)
+      {
+        if (live[i].address < address + size && live[i].address + live[i].size > address)
+          erase(i);
+      }
+      insert(address, size, std::nullopt);
+    }
+
+    for (int lookup = 0; lookup < 400; lookup++)
+    {
+      const Live& entry = live[rng() % live.size()];
+      trace.push_back({Op::Find, entry.address, 0, 0, 0, 0});
+      if (entry.hash)
+        trace.push_back({Op::FindHash, 0, 0, 0, *entry.hash, 0});
+    }
+  }
+  return trace;
+}
+}  // namespace
+
+TEST(TextureCacheIndex, AddressIndexMatchesMultimap)
+{
+  VideoCommon::TextureAddressIndex<Entry> index;
+  MultimapIndices reference;
+  std::vector<EntryPtr> entries;
+
+  std::mt19937 rng(2468);
+  std::uniform_int_distribution<u32> address(0, 0x10000);
+  std::uniform_int_distribution<u32> size(0, 0x2000);
+
+  for (int i = 0; i < 5000; i++)
+  {
+    const u32 op = rng() % 8;
+    if (op < 4 || entries.empty())
+    {
+      // Several entries at the same address, to check their order
+      const u32 entry_address = address(rng) & ~0xFFFu;
+      auto entry = std::make_shared<Entry>(Entry{entry_address, size(rng)});
+      index.Insert(entry->address, entry->size, entry);
+      reference.by_address.emplace(entry->address, entry);
+      entries.push_back(entry);
+    }
+    else if (op < 6)
+    {
+      const size_t victim = rng() % entries.size();
+      EXPECT_TRUE(index.Erase(entries[victim]->address, entries[victim].get()));
+      reference.Erase(entries[victim].get());
+      EXPECT_FALSE(index.Erase(entries[victim]->address, entries[victim].get()));
+      entries.erase(entries.begin() + victim);
+    }
+    else
+    {
+      const u32 query_address = address(rng);
+      const u32 query_size = size(rng) + 1;
+      ASSERT_EQ(reference.FindOverlapping(query_address, query_size),
+                ToVector(index.FindOverlapping(query_address, query_size)));
+      ASSERT_EQ(reference.Find(query_address & ~0xFFFu),
+                ToVector(index.Find(query_address & ~0xFFFu)));
+    }
+    ASSERT_EQ(reference.by_address.size(), index.size());
+  }
+
+  // Erasing most entries compacts the index
+  while (entries.size() > 100)
+  {
+    const size_t victim = rng() % entries.size();
+    EXPECT_TRUE(index.Erase(entries[victim]->address, entries[victim].get()));
+    reference.Erase(entries[victim].get());
+    entries.erase(entries.begin() + victim);
+    ASSERT_EQ(reference.FindOverlapping(0, 0x20000), ToVector(index.FindOverlapping(0, 0x20000)));
+  }
+
+  // Removing every other entry keeps the rest in order
+  std::vector<EntryPtr> expected;
+  bool remove = true;
+  for (const auto& [entry_address, entry] : reference.by_address)
+  {
+    if (!remove)
+      expected.push_back(entry);
+    remove = !remove;
+  }
+
+  remove = false;
+  index.EraseIf([&remove](const EntryPtr&) { return remove = !remove; });
+  std::vector<EntryPtr> remaining;
+  index.ForEach([&remaining](u32 entry_address, const EntryPtr& entry) {
+    EXPECT_EQ(entry->address, entry_address);
+    remaining.push_back(entry);
+  });
+  EXPECT_EQ(expected, remaining);
+  EXPECT_EQ(expected.size(), index.size());
+}
+
+TEST(TextureCacheIndex, HashIndexMatchesMultimap)
+{
+  VideoCommon::TextureHashIndex<Entry> index;
+  MultimapIndices reference;
+  std::vector<EntryPtr> entries;
+
+  std::mt19937_64 rng(3579);
+  for (int i = 0; i < 20000; i++)
+  {
+    // Few distinct hashes, so many entries share one
+    const u64 hash = (rng() % 300) << 40;
+    if (rng() % 3 != 0 || entries.empty())
+    {
+      auto entry = std::make_shared<Entry>();
+      entry->hash_key = hash;
+      index.Insert(hash, entry);
+      reference.by_hash.emplace(hash, entry);
+      entries.push_back(entry);
+    }
+    else
+    {
+      const size_t victim = rng() % entries.size();
+      EXPECT_TRUE(index.Erase(*entries[victim]->hash_key, entries[victim].get()));
+      reference.EraseHash(entries[victim].get());
+      entries.erase(entries.begin() + victim);
+    }
+    ASSERT_EQ(reference.FindHash(hash), ToVector(index.Find(hash)));
+    ASSERT_EQ(reference.by_hash.size(), index.size());
+  }
+
+  size_t count = 0;
+  index.ForEach([&count](u64 hash, const EntryPtr& entry) {
+    EXPECT_EQ(*entry->hash_key, hash);
+    ++count;
+  });
+  EXPECT_EQ(entries.size(), count);
+}
+
+TEST(TextureCacheIndex, ChangesDuringLookupAreDeferred)
+{
+  VideoCommon::TextureAddressIndex<Entry> by_address;
+  VideoCommon::TextureHashIndex<Entry> by_hash;
+  std::vector<EntryPtr> entries;
+  for (u32 i = 0; i < 300; i++)
+  {
+    entries.push_back(std::make_shared<Entry>(Entry{0x1000 + (i % 30) * 0x100, 0x200, i % 3}));
+    by_address.Insert(entries.back()->address, entries.back()->size, entries.back());
+    by_hash.Insert(*entries.back()->hash_key, entries.back());
+  }
+
+  // Every entry visited erases itself and the next overlapping entry, and adds a new one. The
+  // erased entries stay alive until the loop is done, and the new ones aren't found by it.
+  std::vector<EntryPtr> added;
+  std::vector<std::weak_ptr<Entry>> erased;
+  const auto erase = [&](const EntryPtr& entry) {
+    erased.push_back(entry);
+    EXPECT_TRUE(by_address.Erase(entry->address, entry.get()));
+    EXPECT_FALSE(by_address.Erase(entry->address, entry.get()));
+    EXPECT_TRUE(by_hash.Erase(*entry->hash_key, entry.get()));
+    entries.erase(std::find(entries.begin(), entries.end(), entry));
+  };
+  size_t visited = 0;
+  for (const EntryPtr& entry : by_address.FindOverlapping(0x1800, 0x100))
+  {
+    EXPECT_TRUE(Overlaps(*entry, 0x1800, 0x100));
+    EXPECT_EQ(0x200u, entry->size);
+    ++visited;
+
+    const u32 address = entry->address;
+    erase(entry);
+    for (const EntryPtr& other : by_address.Find(address))
+    {
+      erase(other);
+      break;
+    }
+
+    added.push_back(std::make_shared<Entry>(Entry{0x1800, 0x400}));
+    by_address.Insert(0x1800, 0x400, added.back());
+    EXPECT_EQ(address, entry->address);
+  }
+  EXPECT_EQ(10u, visited);
+  EXPECT_EQ(entries.size() + added.size(), by_address.size());
+  for (const std::weak_ptr<Entry>& entry : erased)
+    EXPECT_TRUE(entry.expired());
+
+  // The new entries come after the ones which were already at the address
+  const std::vector<EntryPtr> found = ToVector(by_address.Find(0x1800));
+  ASSERT_GE(found.size(), added.size());
+  EXPECT_TRUE(std::equal(added.begin(), added.end(), found.end() - added.size()));
+
+  // The same for the hash index
+  std::vector<EntryPtr> hash_added;
+  for (const EntryPtr& entry : by_hash.Find(1))
+  {
+    EXPECT_EQ(1u, *entry->hash_key);
+    EXPECT_TRUE(by_hash.Erase(1, entry.get()));
+    hash_added.push_back(std::make_shared<Entry>(Entry{0, 0, 1}));
+    by_hash.Insert(1, hash_added.back());
+  }
+  EXPECT_EQ(hash_added, ToVector(by_hash.Find(1)));
+  EXPECT_EQ(entries.size(), by_hash.size());
+}
+
+TEST(TextureCacheIndex, SlabAllocatorReusesBlocks)
+{
+  Common::SlabAllocator<Entry> allocator;
+  std::vector<EntryPtr> entries;
+  for (int round = 0; round < 10; round++)
+  {
+    for (int i = 0; i < 1000; i++)
+      entries.push_back(std::allocate_shared<Entry>(allocator, Entry{static_cast<u32>(i)}));
+    for (int i = 0; i < 1000; i++)
+      EXPECT_EQ(static_cast<u32>(i), entries[i]->address);
+    entries.clear();
+  }
+  EXPECT_EQ(4u, allocator.GetPool()->GetSlabCount());
+}
+
+TEST(TextureCacheIndex, TraceRoundTrip)
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/TextureCache.trace";
+  {
+    VideoCommon::TextureCacheTraceWriter writer(path);
+    ASSERT_TRUE(writer.IsOpen());
+
+    int a, b;
+    writer.Insert(&a, 0x1000, 0x200);
+    writer.Insert(&b, 0x1100, 0x200);
+    writer.InsertHash(&b, 1234);
+    writer.FindOverlapping(0x1180, 0x10);
+    writer.Erase(&b);
+    writer.EraseHash(&b);
+    // The memory of an erased entry is reused
+    writer.Insert(&b, 0x3000, 0x40);
+  }
+
+  const auto trace = VideoCommon::LoadTextureCacheTrace(path);
+  File::DeleteDirRecursively(directory);
+  ASSERT_TRUE(trace.has_value());
+  ASSERT_EQ(7u, trace->size());
+  EXPECT_EQ(Op::InsertHash, (*trace)[2].op);
+  EXPECT_EQ(1234u, (*trace)[2].hash);
+  EXPECT_EQ(1u, (*trace)[2].entry);
+  EXPECT_EQ(0x1180u, (*trace)[3].address);
+  EXPECT_EQ(1u, (*trace)[5].entry);
+  EXPECT_EQ(2u, (*trace)[6].entry);
+
+  // Both index implementations find the same entries
+  EXPECT_EQ(Replay<false>(*trace), Replay<true>(*trace));
+}
+
+TEST(TextureCacheIndex, SyntheticTraceMatchesMultimap)
+{
+  const std::vector<TextureCacheTraceRecord> trace = MakeSyntheticTrace(20);
+  EXPECT_EQ(Replay<false>(trace), Replay<true>(trace));
+}
+
+// Benchmark of the indices, run with --gtest_also_run_disabled_tests. Set
+// DOLPHIN_TEXTURE_CACHE_TRACE to a trace recorded with the DumpTextureCacheTrace graphics setting
+// while playing a FIFO log, or a synthetic trace is used.
+TEST(TextureCacheIndex, DISABLED_ReplayBenchmark)
+{
+  std::vector<TextureCacheTraceRecord> trace;
+  if (const char* path = std::getenv("DOLPHIN_TEXTURE_CACHE_TRACE"))
+  {
+    auto loaded = VideoCommon::LoadTextureCacheTrace(path);
+    ASSERT_TRUE(loaded.has_value()) << "Failed to load " << path;
+    trace = std::move(*loaded);
+  }
+  else
+  {
+    trace = MakeSyntheticTrace(600);
+  }
+
+  const auto time = [&trace](const char* name, auto replay) {
+    const auto start = std::chrono::steady_clock::now();
+    const u64 checksum = replay(trace);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    fmt::print("{}: {:.1f} ms for {} operations\n", name, elapsed.count(), trace.size());
+    return checksum;
+  };
+
+  const u64 old_checksum = time("multimap", Replay<false>);
+  const u64 new_checksum = time("flat index", Replay<true>);
+  EXPECT_EQ(old_checksum, new_checksum);
+
+  // The cost of inserting and erasing grows with the number of textures in the cache
+  if (!std::getenv("DOLPHIN_TEXTURE_CACHE_TRACE"))
+  {
+    trace = MakeSyntheticTrace(600, 20000);
+    const u64 large_old_checksum = time("multimap, 20000 textures", Replay<false>);
+    const u64 large_new_checksum = time("flat index, 20000 textures", Replay<true>);
+    EXPECT_EQ(large_old_checksum, large_new_checksum);
+  }
+}
@@ -0,0 +1,280 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+
+using VideoCommon::CustomTextureData;
+using VideoCommon::TexturePackArchive;
+using VideoCommon::TexturePackArchiveWriter;
+using VideoCommon::TexturePackHeader;
+using VideoCommon::TexturePackLevel;
+
+namespace
+{
+// A mip chain of RGBA8 levels, which compress well
+CustomTextureData::ArraySlice MakeRGBA8Slice(u32 width, u32 height, u8 seed)
+{
+  CustomTextureData::ArraySlice slice;
+  for (; width != 0 && height != 0; width /= 2, height /= 2)
+  {
+    CustomTextureData::ArraySlice::Level& level = slice.m_levels.emplace_back();
+    level.format = AbstractTextureFormat::RGBA8;
+    level.width = width;
+    level.height = height;
+    level.row_length = width;
+    level.data.resize(width * height * 4);
+    for (size_t i = 0; i < level.data.size(); ++i)
+      level.data[i] = static_cast<u8>(seed + i / 64);
+  }
+  return slice;
+}
+
+// A DXT1 level of random blocks, which don't compress and are stored as they are
+CustomTextureData::ArraySlice MakeDXT1Slice(u32 width, u32 height)
+{
+  std::mt19937 rng(width * height);
+  CustomTextureData::ArraySlice slice;
+  CustomTextureData::ArraySlice::Level& level = slice.m_levels.emplace_back();
+  level.format = AbstractTextureFormat::DXT1;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  level.data.resize((width / 4) * (height / 4) * 8);
+  for (u8& byte : level.data)
+    byte = static_cast<u8>(rng());
+  return slice;
+}
+
+void ExpectSameLevels(const CustomTextureData::ArraySlice& expected,
+                      const CustomTextureData::ArraySlice& actual)
+{
+  ASSERT_EQ(expected.m_levels.size(), actual.m_levels.size());
+  for (size_t i = 0; i < expected.m_levels.size(); ++i)
+  {
+    EXPECT_EQ(expected.m_levels[i].format, actual.m_levels[i].format);
+    EXPECT_EQ(expected.m_levels[i].width, actual.m_levels[i].width);
+    EXPECT_EQ(expected.m_levels[i].height, actual.m_levels[i].height);
+    EXPECT_EQ(expected.m_levels[i].row_length, actual.m_levels[i].row_length);
+    EXPECT_EQ(expected.m_levels[i].data, actual.m_levels[i].data);
+  }
+}
+
+class TexturePackArchiveTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_path = m_directory + "/pack" + std::string(TexturePackArchive::EXTENSION);
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  // Writes a pack with a compressed texture of several levels and an uncompressed one
+  void WritePack()
+  {
+    TexturePackArchiveWriter writer(m_path);
+    ASSERT_TRUE(writer.IsOpen());
+    ASSERT_TRUE(writer.AddTexture("tex1_64x32_b", true, m_rgba8));
+    ASSERT_TRUE(writer.AddTexture("tex1_16x16_a", false, m_dxt1));
+    ASSERT_TRUE(writer.Finish());
+  }
+
+  std::string ReadPack() const
+  {
+    std::string data;
+    EXPECT_TRUE(File::ReadFileToString(m_path, data));
+    return data;
+  }
+
+  TexturePackHeader ReadHeader(const std::string& data) const
+  {
+    TexturePackHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    return header;
+  }
+
+  // Changes one field of the first level of the texture which sorts first
+  template <typename Function>
+  void CorruptFirstLevel(Function function)
+  {
+    std::string data = ReadPack();
+    const TexturePackHeader header = ReadHeader(data);
+    TexturePackLevel level;
+    std::memcpy(&level, &data[header.levels_offset], sizeof(level));
+    function(&level);
+    std::memcpy(&data[header.levels_offset], &level, sizeof(level));
+    ASSERT_TRUE(File::WriteStringToFile(m_path, data));
+  }
+
+  std::string m_directory;
+  std::string m_path;
+  CustomTextureData::ArraySlice m_rgba8 = MakeRGBA8Slice(64, 32, 7);
+  CustomTextureData::ArraySlice m_dxt1 = MakeDXT1Slice(16, 16);
+};
+}  // namespace
+
+TEST_F(TexturePackArchiveTest, RoundTrip)
+{
+  WritePack();
+  const auto archive = TexturePackArchive::Open(m_path);
+  ASSERT_NE(nullptr, archive);
+  ASSERT_EQ(2u, archive->GetTextureCount());
+
+  // The textures are sorted by name
+  EXPECT_EQ("tex1_16x16_a", archive->GetTextureName(0));
+  EXPECT_EQ("tex1_64x32_b", archive->GetTextureName(1));
+  EXPECT_EQ(0u, archive->FindTexture("tex1_16x16_a"));
+  EXPECT_EQ(1u, archive->FindTexture("tex1_64x32_b"));
+  EXPECT_FALSE(archive->FindTexture("tex1_64x32_c").has_value());
+  EXPECT_FALSE(archive->FindTexture("").has_value());
+  EXPECT_FALSE(archive->HasArbitraryMipmaps(0));
+  EXPECT_TRUE(archive->HasArbitraryMipmaps(1));
+
+  CustomTextureData::ArraySlice slice;
+  ASSERT_TRUE(archive->LoadTexture(0, &slice));
+  ExpectSameLevels(m_dxt1, slice);
+  ASSERT_TRUE(archive->LoadTexture(1, &slice));
+  ExpectSameLevels(m_rgba8, slice);
+
+  // The RGBA8 levels are stored compressed
+  EXPECT_LT(File::GetSize(m_path), m_rgba8.m_levels[0].data.size());
+}
+
+TEST_F(TexturePackArchiveTest, EmptyPack)
+{
+  TexturePackArchiveWriter writer(m_path);
+  ASSERT_TRUE(writer.Finish());
+
+  const auto archive = TexturePackArchive::Open(m_path);
+  ASSERT_NE(nullptr, archive);
+  EXPECT_EQ(0u, archive->GetTextureCount());
+  EXPECT_FALSE(archive->FindTexture("tex1_16x16_a").has_value());
+}
+
+TEST_F(TexturePackArchiveTest, WriterRejectsInvalidTextures)
+{
+  TexturePackArchiveWriter writer(m_path);
+  EXPECT_FALSE(writer.AddTexture("no_levels", false, {}));
+
+  CustomTextureData::ArraySlice slice = MakeRGBA8Slice(8, 8, 1);
+  slice.m_levels[1].data.pop_back();
+  EXPECT_FALSE(writer.AddTexture("short_level", false, slice));
+
+  slice = MakeRGBA8Slice(8, 8, 1);
+  slice.m_levels[0].row_length = 4;
+  EXPECT_FALSE(writer.AddTexture("short_rows", false, slice));
+
+  slice = MakeRGBA8Slice(8, 8, 1);
+  slice.m_levels[0].format = AbstractTextureFormat::Undefined;
+  EXPECT_FALSE(writer.AddTexture("bad_format", false, slice));
+
+  // A rejected texture doesn't leave anything in the pack
+  ASSERT_TRUE(writer.AddTexture("valid", false, MakeRGBA8Slice(8, 8, 1)));
+  ASSERT_TRUE(writer.AddTexture("valid", false, MakeRGBA8Slice(4, 4, 2)));
+  EXPECT_FALSE(writer.Finish());
+}
+
+TEST_F(TexturePackArchiveTest, RejectsTruncatedOrForeignFiles)
+{
+  WritePack();
+  const std::string data = ReadPack();
+
+  ASSERT_TRUE(File::WriteStringToFile(m_path, data.substr(0, sizeof(TexturePackHeader) - 1)));
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+
+  // The index is at the end of the file
+  ASSERT_TRUE(File::WriteStringToFile(m_path, data.substr(0, data.size() - 8)));
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+
+  std::string foreign = data;
+  foreign[0] ^= 1;
+  ASSERT_TRUE(File::WriteStringToFile(m_path, foreign));
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_directory + "/missing.dtp"));
+}
+
+TEST_F(TexturePackArchiveTest, RejectsLevelsWhichDontMatchTheirData)
+{
+  const auto expect_rejected = [this](auto function) {
+    WritePack();
+    CorruptFirstLevel(function);
+    EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+  };
+
+  // A size too small for the dimensions, as if the level could be uploaded from a short buffer
+  expect_rejected([](TexturePackLevel* level) {
+    level->size -= 8;
+    level->compressed_size -= 8;
+  });
+  expect_rejected([](TexturePackLevel* level) { level->height *= 2; });
+  expect_rejected([](TexturePackLevel* level) { level->width = level->row_length + 4; });
+  expect_rejected([](TexturePackLevel* level) { level->width = 0; });
+  expect_rejected([](TexturePackLevel* level) { level->row_length = 0x80000000; });
+  expect_rejected([](TexturePackLevel* level) { level->format = AbstractTextureFormat::RGBA8; });
+  expect_rejected(
+      [](TexturePackLevel* level) { level->format = AbstractTextureFormat::Undefined; });
+  expect_rejected([](TexturePackLevel* level) { level->offset = 0xFFFFFFFFFFFFFFF8; });
+  expect_rejected([](TexturePackLevel* level) { level->offset += 1; });
+  expect_rejected([](TexturePackLevel* level) { level->compressed_size = level->size + 8; });
+}
+
+TEST_F(TexturePackArchiveTest, RejectsInvalidTextureEntries)
+{
+  WritePack();
+  std::string data = ReadPack();
+  const TexturePackHeader header = ReadHeader(data);
+
+  // Swapping the names makes them unsorted
+  std::string swapped = data;
+  std::memcpy(&swapped[header.textures_offset], &data[header.textures_offset + 16], 16);
+  std::memcpy(&swapped[header.textures_offset + 16], &data[header.textures_offset], 16);
+  ASSERT_TRUE(File::WriteStringToFile(m_path, swapped));
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+
+  // Levels past the end of the level table
+  std::string levels = data;
+  const u16 level_count = 100;
+  std::memcpy(&levels[header.textures_offset + 12], &level_count, sizeof(level_count));
+  ASSERT_TRUE(File::WriteStringToFile(m_path, levels));
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+
+  // A name past the end of the names
+  std::string name = data;
+  const u32 name_length = 1000;
+  std::memcpy(&name[header.textures_offset + 4], &name_length, sizeof(name_length));
+  ASSERT_TRUE(File::WriteStringToFile(m_path, name));
+  EXPECT_EQ(nullptr, TexturePackArchive::Open(m_path));
+}
+
+TEST_F(TexturePackArchiveTest, FailsToLoadCorruptedData)
+{
+  WritePack();
+  std::string data = ReadPack();
+  const TexturePackHeader header = ReadHeader(data);
+
+  // The second texture's first level is the compressed RGBA8 one
+  TexturePackLevel level;
+  std::memcpy(&level, &data[header.levels_offset + sizeof(level)], sizeof(level));
+  ASSERT_LT(level.compressed_size, level.size);
+  for (u32 i = 0; i < level.compressed_size; ++i)
+    data[level.offset + i] = static_cast<char>(0xFF);
+  ASSERT_TRUE(File::WriteStringToFile(m_path, data));
+
+  // The index is still valid, so the pack opens, but the texture doesn't load
+  const auto archive = TexturePackArchive::Open(m_path);
+  ASSERT_NE(nullptr, archive);
+  CustomTextureData::ArraySlice slice;
+  EXPECT_TRUE(archive->LoadTexture(0, &slice));
+  EXPECT_FALSE(archive->LoadTexture(1, &slice));
+}